@@ -61,6 +61,9 @@ void ezEngineProcessGameApplication::AfterCoreSystemsStartup()
 
   ezTaskSystem::SetTargetFrameTime(ezTime::Seconds(1.0 / 20.0));
 
+  // the editor requests reloads after every asset transform, only look at the files that actually changed
+  ezResourceManager::SetFileWatchingEnabled(true);
+
   ConnectToHost();
 }
 
@@ -284,7 +287,10 @@ void ezEngineProcessGameApplication::EventHandlerIPC(const ezEngineProcessCommun
       m_PlatformProfile.m_sName = pMsg->m_sPayload;
       Init_PlatformProfile_LoadForRuntime();
 
+      // resources are redirected to different files now, which the directory watchers don't report as changed
+      ezResourceManager::SetFileWatchingEnabled(false);
       ezResourceManager::ReloadAllResources(false);
+      ezResourceManager::SetFileWatchingEnabled(true);
       ezRenderWorld::DeleteAllCachedRenderData();
     }
     else if (pMsg->m_sWhatToDo == "ReloadAssetLUT")
@@ -416,7 +416,7 @@ EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezCVarMsgToEditor, 1, ezRTTIDefaultAllocator<ezC
 }
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 
-EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezEditorEngineSyncObjectMsg, 1, ezRTTIDefaultAllocator<ezEditorEngineSyncObjectMsg>)
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezEditorEngineSyncObjectMsg, 2, ezRTTIDefaultAllocator<ezEditorEngineSyncObjectMsg>)
 {
   EZ_BEGIN_PROPERTIES
   {
@@ -12,7 +12,9 @@
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Serialization/BinarySerializer.h>
 #include <Foundation/Serialization/ReflectionSerializer.h>
+#include <Foundation/Serialization/RttiConverter.h>
 #include <Foundation/Time/Stopwatch.h>
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/Utilities/Progress.h>
@@ -20,7 +22,7 @@
 #include <atomic>
 
 #define EZ_CURATOR_CACHE_VERSION 2
-#define EZ_CURATOR_CACHE_FILE_VERSION 6
+#define EZ_CURATOR_CACHE_FILE_VERSION 7
 
 EZ_IMPLEMENT_SINGLETON(ezAssetCurator);
 
@@ -1674,12 +1676,85 @@ void ezAssetCurator::IterateDataDirectory(const char* szDataDir, ezSet<ezString>
   }
 }
 
+static void ReadCachedAssetSet(const ezAbstractGraphBinaryView& view, const ezAbstractGraphBinaryView::Node& node, const char* szName, ezSet<ezString>& out_set)
+{
+  const ezUInt32 uiProperty = view.FindProperty(node, szName);
+  if (uiProperty == ezInvalidIndex || view.GetProperty(uiProperty).m_uiStringValue != ezInvalidIndex)
+    return;
+
+  const ezVariant& value = view.GetNonStringPropertyValue(uiProperty);
+  if (!value.IsA<ezVariantArray>())
+    return;
+
+  for (const ezVariant& item : value.Get<ezVariantArray>())
+  {
+    if (item.IsA<ezString>())
+      out_set.Insert(item.Get<ezString>());
+  }
+}
+
+/// \brief Reads an asset info that was written to the cache with ezReflectionSerializer::WriteObjectToBinary.
+///
+/// ezAssetDocumentInfo has set properties, so it is always written as an abstract object graph. Its own properties are read from the view
+/// directly, only infos with meta data objects or of an older type version are converted through an ezAbstractObjectGraph.
+static ezUniquePtr<ezAssetDocumentInfo> ReadCachedAssetInfo(ezStreamReader& stream, ezAbstractGraphBinaryView& view)
+{
+  if (view.Read(stream).Failed())
+    return nullptr;
+
+  const ezRTTI* pType = ezGetStaticRTTI<ezAssetDocumentInfo>();
+  const ezAbstractGraphBinaryView::Node* pRoot = view.GetNodeByName("root");
+  if (pRoot == nullptr || view.GetString(pRoot->m_uiType) != pType->GetTypeName())
+    return nullptr;
+
+  ezUniquePtr<ezAssetDocumentInfo> pInfo = EZ_DEFAULT_NEW(ezAssetDocumentInfo);
+
+  const ezUInt32 uiMetaInfo = view.FindProperty(*pRoot, "MetaInfo");
+  const bool bHasMetaInfo = uiMetaInfo != ezInvalidIndex && view.GetProperty(uiMetaInfo).m_uiStringValue == ezInvalidIndex &&
+                            view.GetNonStringPropertyValue(uiMetaInfo).IsA<ezVariantArray>() &&
+                            !view.GetNonStringPropertyValue(uiMetaInfo).Get<ezVariantArray>().IsEmpty();
+
+  if (bHasMetaInfo || pRoot->m_uiTypeVersion != pType->GetTypeVersion())
+  {
+    ezAbstractObjectGraph graph;
+    view.CreateGraph(&graph);
+
+    ezRttiConverterContext context;
+    ezRttiConverterReader convRead(&graph, &context);
+    convRead.ApplyPropertiesToObject(graph.GetNodeByName("root"), pType, pInfo.Borrow());
+    return pInfo;
+  }
+
+  const ezUInt32 uiDocumentID = view.FindProperty(*pRoot, "DocumentID");
+  if (uiDocumentID != ezInvalidIndex)
+    pInfo->m_DocumentID = view.GetPropertyValue(uiDocumentID).ConvertTo<ezUuid>();
+
+  const ezUInt32 uiHash = view.FindProperty(*pRoot, "Hash");
+  if (uiHash != ezInvalidIndex)
+    pInfo->m_uiSettingsHash = view.GetPropertyValue(uiHash).ConvertTo<ezUInt64>();
+
+  const ezUInt32 uiAssetType = view.FindProperty(*pRoot, "AssetType");
+  if (uiAssetType != ezInvalidIndex && view.GetProperty(uiAssetType).m_uiStringValue != ezInvalidIndex)
+    pInfo->SetAssetsDocumentTypeName(view.GetString(view.GetProperty(uiAssetType).m_uiStringValue).GetStartPointer());
+
+  ReadCachedAssetSet(view, *pRoot, "Dependencies", pInfo->m_AssetTransformDependencies);
+  ReadCachedAssetSet(view, *pRoot, "References", pInfo->m_RuntimeDependencies);
+  ReadCachedAssetSet(view, *pRoot, "Outputs", pInfo->m_Outputs);
+
+  return pInfo;
+}
+
 void ezAssetCurator::LoadCaches()
 {
   EZ_PROFILE_SCOPE("LoadCaches");
   EZ_LOCK(m_CuratorMutex);
 
   ezStopwatch sw;
+  ezUInt64 uiCacheSize = 0;
+
+  // reused for all assets, so its arrays and lookup tables are only allocated for the first few
+  ezAbstractGraphBinaryView view;
+
   for (const auto& dd : m_FileSystemConfig.m_DataDirs)
   {
     ezStringBuilder sDataDir;
@@ -1691,6 +1766,8 @@ void ezAssetCurator::LoadCaches()
     ezFileReader reader;
     if (reader.Open(sCacheFile).Succeeded())
     {
+      uiCacheSize += reader.GetFileSize();
+
       ezUInt32 uiCuratorCacheVersion = 0;
       ezUInt32 uiFileVersion = 0;
       ezUInt32 uiAssetCount = 0;
@@ -1730,6 +1807,7 @@ void ezAssetCurator::LoadCaches()
         continue;
 
       const ezRTTI* pFileStatusType = ezGetStaticRTTI<ezFileStatus>();
+      bool bValidCache = true;
       {
         EZ_PROFILE_SCOPE("Assets");
         for (ezUInt32 i = 0; i < uiAssetCount; i++)
@@ -1737,16 +1815,26 @@ void ezAssetCurator::LoadCaches()
           ezString sPath;
           reader >> sPath;
 
-          const ezRTTI* pType = nullptr;
-          ezAssetDocumentInfo* pEntry = static_cast<ezAssetDocumentInfo*>(ezReflectionSerializer::ReadObjectFromBinary(reader, pType));
-          EZ_ASSERT_DEBUG(pEntry != nullptr && pType == ezGetStaticRTTI<ezAssetDocumentInfo>(), "Failed to deserialize ezAssetDocumentInfo!");
-          m_CachedAssets.Insert(sPath, ezUniquePtr<ezAssetDocumentInfo>(pEntry, ezFoundation::GetDefaultAllocator()));
+          ezUniquePtr<ezAssetDocumentInfo> pEntry = ReadCachedAssetInfo(reader, view);
+          if (pEntry == nullptr)
+          {
+            bValidCache = false;
+            break;
+          }
+
+          m_CachedAssets.Insert(sPath, std::move(pEntry));
 
           ezFileStatus stat;
           reader >> stat;
           m_CachedFiles.Insert(std::move(sPath), stat);
         }
       }
+
+      if (!bValidCache)
+      {
+        ezLog::Warning("Asset curator cache '{0}' is invalid and is only read partially.", sCacheFile);
+        continue;
+      }
       {
         EZ_PROFILE_SCOPE("Files");
         for (ezUInt32 i = 0; i < uiFileCount; i++)
@@ -1761,7 +1849,7 @@ void ezAssetCurator::LoadCaches()
     }
   }
 
-  ezLog::Debug("Asset Curator LoadCaches: {0} ms", ezArgF(sw.GetRunningTotal().GetMilliseconds(), 3));
+  ezLog::Debug("Asset Curator LoadCaches: {0} ms, {1} KB", ezArgF(sw.GetRunningTotal().GetMilliseconds(), 3), uiCacheSize / 1024);
 }
 
 void ezAssetCurator::SaveCaches()
@@ -112,6 +112,9 @@ ezStatus ezProcGenGraphAssetDocument::WriteAsset(ezStreamWriter& stream, const e
       return ezStatus("Compilation failed");
     }
 
+    ezLog::Dev("Compiled output '{0}': {1} instructions ({2} before optimization)",
+      pOutputNode->GetTypeAccessor().GetValue("Name").ConvertTo<ezString>(), byteCode.GetNumInstructions(), compiler.GetNumUnoptimizedInstructions());
+
     byteCode.Save(chunk);
 
     return ezStatus(EZ_SUCCESS);
@@ -40,6 +40,14 @@ void ezPrefabResource::InstantiatePrefab(ezWorld& world, const ezTransform& root
   }
 }
 
+void ezPrefabResource::InstantiatePrefabs(ezWorld& world, ezArrayPtr<const ezTransform> rootTransforms, ezGameObjectHandle hParent, ezDynamicArray<ezGameObject*>* out_CreatedRootObjects, const ezUInt16* pOverrideTeamID, bool bForceDynamic)
+{
+  if (GetLoadingState() != ezResourceState::Loaded)
+    return;
+
+  m_WorldReader.InstantiatePrefabs(world, rootTransforms, hParent, out_CreatedRootObjects, pOverrideTeamID, bForceDynamic);
+}
+
 void ezPrefabResource::ApplyExposedParameterValues(const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, const ezHybridArray<ezGameObject*, 8>& createdChildObjects, const ezHybridArray<ezGameObject*, 8>& createdRootObjects) const
 {
   const ezUInt32 uiNumParamDescs = m_PrefabParamDescs.GetCount();
@@ -37,6 +37,13 @@ public:
   /// \brief Creates an instance of this prefab in the given world.
   void InstantiatePrefab(ezWorld& world, const ezTransform& rootTransform, ezGameObjectHandle hParent, ezHybridArray<ezGameObject*, 8>* out_CreatedRootObjects, const ezUInt16* pOverrideTeamID, const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, bool bForceDynamic);
 
+  /// \brief Creates one instance of this prefab per root transform in the given world.
+  ///
+  /// This is considerably faster than calling InstantiatePrefab() in a loop when many instances of the same prefab are needed at once.
+  /// The created root objects of all instances are appended to \a out_CreatedRootObjects in order,
+  /// i.e. every instance contributes the same number of root objects.
+  void InstantiatePrefabs(ezWorld& world, ezArrayPtr<const ezTransform> rootTransforms, ezGameObjectHandle hParent, ezDynamicArray<ezGameObject*>* out_CreatedRootObjects, const ezUInt16* pOverrideTeamID, bool bForceDynamic);
+
   void ApplyExposedParameterValues(const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, const ezHybridArray<ezGameObject*, 8>& createdChildObjects, const ezHybridArray<ezGameObject*, 8>& createdRootObjects) const;
 
 private:
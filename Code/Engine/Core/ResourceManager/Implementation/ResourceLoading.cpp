@@ -2,6 +2,8 @@
 
 #include <Core/ResourceManager/Implementation/ResourceManagerState.h>
 #include <Core/ResourceManager/ResourceManager.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/OSFile.h>
 #include <Foundation/Profiling/Profiling.h>
 
 ezTypelessResourceHandle ezResourceManager::LoadResourceByType(const ezRTTI* pResourceType, const char* szResourceID)
@@ -351,14 +353,51 @@ ezUInt32 ezResourceManager::ReloadResourcesOfType(const ezRTTI* pType, bool bFor
   EZ_LOCK(s_ResourceMutex);
   EZ_LOG_BLOCK("ezResourceManager::ReloadResourcesOfType", pType->GetTypeName());
 
+  bool bOnlyChangedFiles = false;
+  if (!bForce && s_State->s_bFileWatchingEnabled)
+  {
+    bOnlyChangedFiles = UpdateDirectoryWatchers() || s_State->s_TypesCheckedSinceMissedChanges.Contains(pType);
+  }
+
   ezUInt32 count = 0;
 
   LoadedResources& lr = s_State->s_LoadedResources[pType];
 
   for (auto it = lr.m_Resources.GetIterator(); it.IsValid(); ++it)
   {
+    if (bOnlyChangedFiles && IsUnchangedWatchedFile(it.Value()))
+      continue;
+
     if (ReloadResource(it.Value(), bForce))
       ++count;
+
+    // the change was handled, all other collected changes are kept until ReloadAllResources is called, other types might need them
+    if (bOnlyChangedFiles && !it.Value()->GetLoadedFilePath().IsEmpty())
+    {
+      s_State->s_ChangedFiles.Remove(it.Value()->GetLoadedFilePath());
+    }
+  }
+
+  // a full check of this type covers all missed changes for it, once every type was checked the watchers can be trusted again
+  if (!bOnlyChangedFiles && s_State->s_bMissedFileChanges)
+  {
+    s_State->s_TypesCheckedSinceMissedChanges.Insert(pType);
+
+    bool bAllTypesChecked = true;
+    for (auto itType = s_State->s_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
+    {
+      if (!itType.Value().m_Resources.IsEmpty() && !s_State->s_TypesCheckedSinceMissedChanges.Contains(itType.Key()))
+      {
+        bAllTypesChecked = false;
+        break;
+      }
+    }
+
+    if (bAllTypesChecked)
+    {
+      s_State->s_bMissedFileChanges = false;
+      s_State->s_TypesCheckedSinceMissedChanges.Clear();
+    }
   }
 
   return count;
@@ -369,17 +408,27 @@ ezUInt32 ezResourceManager::ReloadAllResources(bool bForce)
   EZ_LOCK(s_ResourceMutex);
   EZ_LOG_BLOCK("ezResourceManager::ReloadAllResources");
 
+  const bool bOnlyChangedFiles = !bForce && s_State->s_bFileWatchingEnabled && UpdateDirectoryWatchers();
+
   ezUInt32 count = 0;
 
   for (auto itType = s_State->s_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
   {
     for (auto it = itType.Value().m_Resources.GetIterator(); it.IsValid(); ++it)
     {
+      if (bOnlyChangedFiles && IsUnchangedWatchedFile(it.Value()))
+        continue;
+
       if (ReloadResource(it.Value(), bForce))
         ++count;
     }
   }
 
+  s_State->s_ChangedFiles.Clear();
+  s_State->s_RemovedPaths.Clear();
+  s_State->s_bMissedFileChanges = false;
+  s_State->s_TypesCheckedSinceMissedChanges.Clear();
+
   if (count > 0)
   {
     ezResourceManagerEvent e;
@@ -391,6 +440,182 @@ ezUInt32 ezResourceManager::ReloadAllResources(bool bForce)
   return count;
 }
 
+void ezResourceManager::SetFileWatchingEnabled(bool bEnable)
+{
+  EZ_LOCK(s_ResourceMutex);
+
+  if (s_State->s_bFileWatchingEnabled == bEnable)
+    return;
+
+  s_State->s_bFileWatchingEnabled = bEnable;
+  s_State->s_WatchedDirectories.Clear();
+  s_State->s_ChangedFiles.Clear();
+  s_State->s_RemovedPaths.Clear();
+
+  // start watching right away, changes that happen before the next reload must not be missed
+  if (bEnable)
+    UpdateDirectoryWatchers();
+}
+
+bool ezResourceManager::IsFileWatchingEnabled()
+{
+  return s_State->s_bFileWatchingEnabled;
+}
+
+void ezResourceManager::SetFileReadBatchSize(ezUInt32 uiNumResources)
+{
+  EZ_LOCK(s_ResourceMutex);
+  s_State->s_uiFileReadBatchSize = ezMath::Clamp(uiNumResources, 1u, 64u);
+}
+
+ezUInt32 ezResourceManager::GetFileReadBatchSize()
+{
+  return s_State->s_uiFileReadBatchSize;
+}
+
+bool ezResourceManager::UpdateDirectoryWatchers()
+{
+  EZ_PROFILE_SCOPE("UpdateDirectoryWatchers");
+
+  auto& watchedDirs = s_State->s_WatchedDirectories;
+
+  // previous full checks don't cover changes that are missed now
+  auto MarkMissedFileChanges = []() {
+    s_State->s_bMissedFileChanges = true;
+    s_State->s_TypesCheckedSinceMissedChanges.Clear();
+  };
+
+  // keep the watchers in sync with the mounted data directories
+  {
+    ezHybridArray<ezString, 16> dataDirs;
+
+    {
+      EZ_LOCK(ezFileSystem::GetMutex());
+
+      ezStringBuilder sPath;
+      for (ezUInt32 i = 0; i < ezFileSystem::GetNumDataDirectories(); ++i)
+      {
+        sPath = ezFileSystem::GetDataDirectory(i)->GetRedirectedDataDirectoryPath();
+        NormalizeWatchedFilePath(sPath);
+        sPath.Trim("", "/");
+
+        // archives are files and never change, the empty data directory for absolute paths must not be watched either
+        if (sPath.IsEmpty() || !ezOSFile::ExistsDirectory(sPath))
+          continue;
+
+        sPath.Append("/");
+
+        if (!dataDirs.Contains(sPath))
+          dataDirs.PushBack(sPath);
+      }
+    }
+
+    for (ezUInt32 i = watchedDirs.GetCount(); i-- > 0;)
+    {
+      if (!dataDirs.RemoveAndSwap(watchedDirs[i].m_sPath))
+      {
+        watchedDirs.RemoveAtAndSwap(i);
+      }
+    }
+
+    for (const ezString& sDataDir : dataDirs)
+    {
+      auto& watchedDir = watchedDirs.ExpandAndGetRef();
+      watchedDir.m_sPath = sDataDir;
+      watchedDir.m_pWatcher = EZ_DEFAULT_NEW(ezDirectoryWatcher);
+
+      // everything that changed in this directory before now is unknown
+      MarkMissedFileChanges();
+
+      // on failure the watcher stays closed and the resources in this directory are checked individually
+      if (watchedDir.m_pWatcher->OpenDirectory(sDataDir, ezDirectoryWatcher::Watch::Writes | ezDirectoryWatcher::Watch::Creates |
+                                                            ezDirectoryWatcher::Watch::Renames | ezDirectoryWatcher::Watch::Subdirectories)
+            .Failed())
+      {
+        ezLog::Dev("Data directory '{0}' can't be watched for changes", sDataDir);
+      }
+    }
+  }
+
+  ezStringBuilder sChangedFile;
+
+  for (auto& watchedDir : watchedDirs)
+  {
+    if (ezStringUtils::IsNullOrEmpty(watchedDir.m_pWatcher->GetDirectory()))
+      continue;
+
+    watchedDir.m_pWatcher->EnumerateChanges([&](const char* szFile, ezDirectoryWatcherAction action) {
+      sChangedFile = watchedDir.m_sPath;
+      sChangedFile.AppendPath(szFile);
+      NormalizeWatchedFilePath(sChangedFile);
+
+      s_State->s_ChangedFiles.Insert(sChangedFile);
+
+      if (action == ezDirectoryWatcherAction::Removed || action == ezDirectoryWatcherAction::RenamedOldName)
+      {
+        sChangedFile.Append("/");
+        s_State->s_RemovedPaths.PushBack(sChangedFile);
+      }
+    });
+
+    // the OS dropped events, every file in this directory might have changed
+    if (watchedDir.m_pWatcher->HasMissedChanges())
+    {
+      MarkMissedFileChanges();
+    }
+  }
+
+  // if only ReloadResourcesOfType is used, unrelated changes pile up, at some point a full check is cheaper
+  if (s_State->s_ChangedFiles.GetCount() + s_State->s_RemovedPaths.GetCount() > 16 * 1024)
+  {
+    s_State->s_ChangedFiles.Clear();
+    s_State->s_RemovedPaths.Clear();
+    MarkMissedFileChanges();
+  }
+
+  return !s_State->s_bMissedFileChanges;
+}
+
+bool ezResourceManager::IsUnchangedWatchedFile(const ezResource* pResource)
+{
+  const ezString& sFile = pResource->GetLoadedFilePath();
+
+  if (sFile.IsEmpty())
+    return false;
+
+  for (const auto& watchedDir : s_State->s_WatchedDirectories)
+  {
+    if (sFile.StartsWith(watchedDir.m_sPath))
+    {
+      if (ezStringUtils::IsNullOrEmpty(watchedDir.m_pWatcher->GetDirectory()))
+        return false;
+
+      if (s_State->s_ChangedFiles.Contains(sFile))
+        return false;
+
+      // the file might have been inside a directory that was removed or renamed
+      for (const ezString& sRemovedPath : s_State->s_RemovedPaths)
+      {
+        if (sFile.StartsWith(sRemovedPath))
+          return false;
+      }
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void ezResourceManager::NormalizeWatchedFilePath(ezStringBuilder& sPath)
+{
+  sPath.MakeCleanPath();
+
+#if EZ_ENABLED(EZ_SUPPORTS_CASE_INSENSITIVE_PATHS)
+  sPath.ToLower();
+#endif
+}
+
 void ezResourceManager::UpdateResourceWithCustomLoader(const ezTypelessResourceHandle& hResource, ezUniquePtr<ezResourceTypeLoader>&& loader)
 {
   EZ_LOCK(s_ResourceMutex);
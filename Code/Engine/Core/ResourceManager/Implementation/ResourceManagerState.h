@@ -4,6 +4,8 @@
 EZ_CORE_INTERNAL_HEADER
 
 #include <Core/ResourceManager/ResourceManager.h>
+#include <Foundation/Containers/HashSet.h>
+#include <Foundation/IO/DirectoryWatcher.h>
 
 class ezResourceManagerState
 {
@@ -56,6 +58,7 @@ private:
   ezHashTable<const ezRTTI*, ezResourceManager::LoadedResources> s_LoadedResources;
 
   bool s_bAllowLaunchDataLoadTask = true;
+  ezUInt32 s_uiFileReadBatchSize = 32;
   bool s_bShutdown = false;
 
   ezHybridArray<TaskDataUpdateContent, 24> s_WorkerTasksUpdateContent;
@@ -92,6 +95,22 @@ private:
   ezMap<ezString, const ezRTTI*> s_AssetToResourceType;
 
 
+  // File watching
+
+  struct WatchedDirectory
+  {
+    ezString m_sPath; ///< Normalized, with a trailing slash
+    ezUniquePtr<ezDirectoryWatcher> m_pWatcher;
+  };
+
+  bool s_bFileWatchingEnabled = false;
+  bool s_bMissedFileChanges = false;
+  ezHashSet<const ezRTTI*> s_TypesCheckedSinceMissedChanges; ///< Types that were fully checked by ReloadResourcesOfType() after changes were missed
+  ezHybridArray<WatchedDirectory, 8> s_WatchedDirectories;
+  ezHashSet<ezString> s_ChangedFiles;
+  ezDynamicArray<ezString> s_RemovedPaths; ///< Removed or renamed files and directories, everything inside a removed directory changed as well
+
+
   // Export mode
 
   bool s_bExportMode = false;
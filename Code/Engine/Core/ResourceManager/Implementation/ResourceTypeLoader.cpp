@@ -3,15 +3,72 @@
 #include <Core/ResourceManager/Resource.h>
 #include <Core/ResourceManager/ResourceTypeLoader.h>
 #include <Foundation/Containers/Blob.h>
+#include <Foundation/IO/AsyncFileReader.h>
+#include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/MemoryStream.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Profiling/Profiling.h>
 
+namespace
+{
+  /// Returns the header that ezResourceLoaderFromFile writes in front of the file content, followed by the content, which is read from
+  /// another stream without copying it first.
+  class FileResourceStreamReader : public ezStreamReader
+  {
+  public:
+    void Reset(ezArrayPtr<const ezUInt8> header, ezStreamReader* pContent)
+    {
+      m_Header.Reset(header.GetPtr(), header.GetCount());
+      m_pContent = pContent;
+    }
+
+    virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override
+    {
+      const ezUInt64 uiHeaderBytes = m_Header.ReadBytes(pReadBuffer, uiBytesToRead);
+
+      if (uiHeaderBytes == uiBytesToRead)
+        return uiHeaderBytes;
+
+      return uiHeaderBytes + m_pContent->ReadBytes(static_cast<ezUInt8*>(pReadBuffer) + uiHeaderBytes, uiBytesToRead - uiHeaderBytes);
+    }
+
+    virtual ezUInt64 SkipBytes(ezUInt64 uiBytesToSkip) override
+    {
+      const ezUInt64 uiHeaderBytes = m_Header.SkipBytes(uiBytesToSkip);
+
+      if (uiHeaderBytes == uiBytesToSkip)
+        return uiHeaderBytes;
+
+      return uiHeaderBytes + m_pContent->SkipBytes(uiBytesToSkip - uiHeaderBytes);
+    }
+
+    virtual bool GetRemainingContiguousData(ezArrayPtr<const ezUInt8>& out_Data) const override
+    {
+      // only the file content can be accessed in place
+      if (m_Header.GetReadPosition() < m_Header.GetByteCount())
+        return false;
+
+      return m_pContent->GetRemainingContiguousData(out_Data);
+    }
+
+  private:
+    ezRawMemoryStreamReader m_Header;
+    ezStreamReader* m_pContent = nullptr;
+  };
+} // namespace
+
 struct FileResourceLoadData
 {
   ezBlob m_Storage;
   ezRawMemoryStreamReader m_Reader;
+
+  // Used instead of m_Reader when the file content does not need to be copied into m_Storage,
+  // either because the data directory has it in memory (m_File) or because it was already read (m_FileContent).
+  ezFileReader m_File;
+  ezDynamicArray<ezUInt8> m_FileContent;
+  ezRawMemoryStreamReader m_FileContentReader;
+  FileResourceStreamReader m_InPlaceReader;
 };
 
 ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pResource)
@@ -20,11 +77,17 @@ ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pR
 
   ezResourceLoadData res;
 
-  ezFileReader File;
+  FileResourceLoadData* pData = EZ_DEFAULT_NEW(FileResourceLoadData);
+  ezFileReader& File = pData->m_File;
+
   if (File.Open(pResource->GetResourceID().GetData()).Failed())
+  {
+    EZ_DEFAULT_DELETE(pData);
     return res;
+  }
 
   res.m_sResourceDescription = File.GetFilePathRelative().GetData();
+  res.m_sLoadedFilePath = File.GetFilePathAbsolute().GetData();
 
 #if EZ_ENABLED(EZ_SUPPORTS_FILE_STATS)
   ezFileStats stat;
@@ -35,9 +98,11 @@ ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pR
 
 #endif
 
-  FileResourceLoadData* pData = EZ_DEFAULT_NEW(FileResourceLoadData);
+  // e.g. memory mapped files can be parsed by the resource directly
+  ezArrayPtr<const ezUInt8> fileData;
+  const bool bReadInPlace = File.GetRemainingContiguousData(fileData);
 
-  const ezUInt64 uiFileSize = File.GetFileSize();
+  const ezUInt64 uiFileSize = bReadInPlace ? 0 : File.GetFileSize();
 
   const ezUInt64 uiBlobCapacity = uiFileSize + File.GetFilePathAbsolute().GetElementCount() + 8; // +8 for the string overhead
   pData->m_Storage.SetCountUninitialized(uiBlobCapacity);
@@ -51,10 +116,21 @@ ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pR
 
   const ezUInt64 uiOffset = w.GetNumWrittenBytes();
 
-  File.ReadBytes(pBlobPtr + uiOffset, uiFileSize);
+  if (bReadInPlace)
+  {
+    // the file stays open until CloseDataStream(), but if the resource only reads the stream, the mapping is released once it reached the end
+    pData->m_InPlaceReader.Reset(ezArrayPtr<const ezUInt8>(pBlobPtr, static_cast<ezUInt32>(uiOffset)), &File);
+    res.m_pDataStream = &pData->m_InPlaceReader;
+  }
+  else
+  {
+    File.ReadBytes(pBlobPtr + uiOffset, uiFileSize);
+    File.Close();
+
+    pData->m_Reader.Reset(pBlobPtr, w.GetNumWrittenBytes() + uiFileSize);
+    res.m_pDataStream = &pData->m_Reader;
+  }
 
-  pData->m_Reader.Reset(pBlobPtr, w.GetNumWrittenBytes() + uiFileSize);
-  res.m_pDataStream = &pData->m_Reader;
   res.m_pCustomLoaderData = pData;
 
   return res;
@@ -67,6 +143,55 @@ void ezResourceLoaderFromFile::CloseDataStream(const ezResource* pResource, cons
   EZ_DEFAULT_DELETE(pData);
 }
 
+bool ezResourceLoaderFromFile::GetFileToRead(const ezResource* pResource, ezAsyncFileRead& out_Request) const
+{
+  out_Request.m_sFile = pResource->GetResourceID();
+
+  // memory mapped files are parsed in place, reading them ahead of time would only add a copy, OpenDataStreamFromFile() maps them instead
+  out_Request.m_uiMaxFileSize = ezDataDirectory::FolderType::GetMinMemoryMappedFileSize() - 1;
+  return true;
+}
+
+ezResourceLoadData ezResourceLoaderFromFile::OpenDataStreamFromFile(const ezResource* pResource, ezAsyncFileRead& file)
+{
+  EZ_PROFILE_SCOPE("ReadResourceFile");
+
+  if (file.m_bExceededMaxFileSize)
+    return OpenDataStream(pResource);
+
+  ezResourceLoadData res;
+
+  if (file.m_Result.Failed())
+    return res;
+
+  // the reader already knows where it found the file, no need to search the data directories again
+  res.m_sResourceDescription = file.m_sDataDirRelativePath;
+  res.m_sLoadedFilePath = file.m_sAbsolutePath;
+  res.m_LoadedFileModificationDate = file.m_LastModificationTime;
+
+  FileResourceLoadData* pData = EZ_DEFAULT_NEW(FileResourceLoadData);
+
+  // take over the buffer, instead of copying it
+  pData->m_FileContent.Swap(file.m_Data);
+  pData->m_FileContentReader.Reset(pData->m_FileContent);
+
+  const ezUInt64 uiBlobCapacity = file.m_sAbsolutePath.GetElementCount() + 8; // +8 for the string overhead
+  pData->m_Storage.SetCountUninitialized(uiBlobCapacity);
+
+  ezUInt8* pBlobPtr = pData->m_Storage.GetBlobPtr<ezUInt8>().GetPtr();
+
+  ezRawMemoryStreamWriter w(pBlobPtr, uiBlobCapacity);
+
+  // same layout as OpenDataStream()
+  w << file.m_sAbsolutePath;
+
+  pData->m_InPlaceReader.Reset(ezArrayPtr<const ezUInt8>(pBlobPtr, static_cast<ezUInt32>(w.GetNumWrittenBytes())), &pData->m_FileContentReader);
+  res.m_pDataStream = &pData->m_InPlaceReader;
+  res.m_pCustomLoaderData = pData;
+
+  return res;
+}
+
 bool ezResourceLoaderFromFile::IsResourceOutdated(const ezResource* pResource) const
 {
   // if we cannot find the target file, there is no point in trying to reload it -> claim it's up to date
@@ -2,6 +2,7 @@
 
 #include <Core/ResourceManager/Implementation/ResourceManagerState.h>
 #include <Core/ResourceManager/ResourceManager.h>
+#include <Foundation/IO/AsyncFileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/Profiling/Profiling.h>
 
@@ -12,9 +13,7 @@ void ezResourceManagerWorkerDataLoad::Execute()
 {
   EZ_PROFILE_SCOPE("LoadResourceFromDisk");
 
-  ezResource* pResourceToLoad = nullptr;
-  ezResourceTypeLoader* pLoader = nullptr;
-  ezUniquePtr<ezResourceTypeLoader> pCustomLoader;
+  ezHybridArray<ResourceToLoad, 32> resourcesToLoad;
 
   {
     EZ_LOCK(ezResourceManager::s_ResourceMutex);
@@ -27,31 +26,77 @@ void ezResourceManagerWorkerDataLoad::Execute()
 
     ezResourceManager::UpdateLoadingDeadlines();
 
-    auto it = ezResourceManager::s_State->s_LoadingQueue.PeekFront();
-    pResourceToLoad = it.m_pResource;
-    ezResourceManager::s_State->s_LoadingQueue.PopFront();
+    const ezUInt32 uiBatchSize = ezMath::Max(1u, ezResourceManager::s_State->s_uiFileReadBatchSize);
 
-    if (pResourceToLoad->m_Flags.IsSet(ezResourceFlags::HasCustomDataLoader))
+    // take the resources with the highest priority, such that their files can be read at the same time
+    while (!ezResourceManager::s_State->s_LoadingQueue.IsEmpty() && resourcesToLoad.GetCount() < uiBatchSize)
     {
-      pCustomLoader = std::move(ezResourceManager::s_State->s_CustomLoaders[pResourceToLoad]);
-      pLoader = pCustomLoader.Borrow();
-      pResourceToLoad->m_Flags.Remove(ezResourceFlags::HasCustomDataLoader);
-      pResourceToLoad->m_Flags.Add(ezResourceFlags::PreventFileReload);
+      ResourceToLoad& toLoad = resourcesToLoad.ExpandAndGetRef();
+
+      toLoad.m_pResource = ezResourceManager::s_State->s_LoadingQueue.PeekFront().m_pResource;
+      ezResourceManager::s_State->s_LoadingQueue.PopFront();
+
+      if (toLoad.m_pResource->m_Flags.IsSet(ezResourceFlags::HasCustomDataLoader))
+      {
+        toLoad.m_pCustomLoader = std::move(ezResourceManager::s_State->s_CustomLoaders[toLoad.m_pResource]);
+        toLoad.m_pLoader = toLoad.m_pCustomLoader.Borrow();
+        toLoad.m_pResource->m_Flags.Remove(ezResourceFlags::HasCustomDataLoader);
+        toLoad.m_pResource->m_Flags.Add(ezResourceFlags::PreventFileReload);
+      }
     }
   }
 
-  if (pLoader == nullptr)
-    pLoader = ezResourceManager::GetResourceTypeLoader(pResourceToLoad->GetDynamicRTTI());
+  ezDynamicArray<ezAsyncFileRead> fileReads;
+  fileReads.Reserve(resourcesToLoad.GetCount());
 
-  if (pLoader == nullptr)
-    pLoader = pResourceToLoad->GetDefaultResourceTypeLoader();
+  for (ResourceToLoad& toLoad : resourcesToLoad)
+  {
+    if (toLoad.m_pLoader == nullptr)
+      toLoad.m_pLoader = ezResourceManager::GetResourceTypeLoader(toLoad.m_pResource->GetDynamicRTTI());
+
+    if (toLoad.m_pLoader == nullptr)
+      toLoad.m_pLoader = toLoad.m_pResource->GetDefaultResourceTypeLoader();
+
+    EZ_ASSERT_DEV(toLoad.m_pLoader != nullptr, "No Loader function available for Resource Type '{0}'", toLoad.m_pResource->GetDynamicRTTI()->GetTypeName());
+
+    ezAsyncFileRead& fileRead = fileReads.ExpandAndGetRef();
+
+    if (resourcesToLoad.GetCount() > 1 && toLoad.m_pLoader->GetFileToRead(toLoad.m_pResource, fileRead))
+    {
+      fileRead.m_pUserData = &toLoad;
+      fileRead.m_OnFinished = &ezResourceManagerWorkerDataLoad::OnFileRead;
+    }
+    else
+    {
+      fileReads.PopBack();
 
-  EZ_ASSERT_DEV(pLoader != nullptr, "No Loader function available for Resource Type '{0}'", pResourceToLoad->GetDynamicRTTI()->GetTypeName());
+      LaunchUpdateContent(toLoad, toLoad.m_pLoader->OpenDataStream(toLoad.m_pResource));
+    }
+  }
 
-  ezResourceLoadData LoaderData = pLoader->OpenDataStream(pResourceToLoad);
+  if (!fileReads.IsEmpty())
+  {
+    ezTaskSystem::WaitForGroup(ezAsyncFileReader::ReadFiles(fileReads));
+  }
+
+  EZ_LOCK(ezResourceManager::s_ResourceMutex);
 
+  // restart the next loading task (this one is about to finish)
+  ezResourceManager::s_State->s_bAllowLaunchDataLoadTask = true;
+  ezResourceManager::RunWorkerTask(nullptr);
+}
+
+void ezResourceManagerWorkerDataLoad::OnFileRead(ezAsyncFileRead& fileRead)
+{
+  ResourceToLoad& toLoad = *static_cast<ResourceToLoad*>(fileRead.m_pUserData);
+
+  LaunchUpdateContent(toLoad, toLoad.m_pLoader->OpenDataStreamFromFile(toLoad.m_pResource, fileRead));
+}
+
+void ezResourceManagerWorkerDataLoad::LaunchUpdateContent(ResourceToLoad& toLoad, const ezResourceLoadData& loaderData)
+{
   // we need this info later to do some work in a lock, all the directly following code is outside the lock
-  const bool bResourceIsLoadedOnMainThread = pResourceToLoad->GetBaseResourceFlags().IsAnySet(ezResourceFlags::UpdateOnMainThread);
+  const bool bResourceIsLoadedOnMainThread = toLoad.m_pResource->GetBaseResourceFlags().IsAnySet(ezResourceFlags::UpdateOnMainThread);
 
   ezSharedPtr<ezResourceManagerWorkerUpdateContent> pUpdateContentTask;
   ezTaskGroupID* pUpdateContentGroup = nullptr;
@@ -90,20 +135,14 @@ void ezResourceManagerWorkerDataLoad::Execute()
 
   // set up the data load task and launch it
   {
-    pUpdateContentTask->m_LoaderData = LoaderData;
-    pUpdateContentTask->m_pLoader = pLoader;
-    pUpdateContentTask->m_pCustomLoader = std::move(pCustomLoader);
-    pUpdateContentTask->m_pResourceToLoad = pResourceToLoad;
+    pUpdateContentTask->m_LoaderData = loaderData;
+    pUpdateContentTask->m_pLoader = toLoad.m_pLoader;
+    pUpdateContentTask->m_pCustomLoader = std::move(toLoad.m_pCustomLoader);
+    pUpdateContentTask->m_pResourceToLoad = toLoad.m_pResource;
 
     // schedule the task to run, either on the main thread or on some other thread
     *pUpdateContentGroup = ezTaskSystem::StartSingleTask(
       pUpdateContentTask, bResourceIsLoadedOnMainThread ? ezTaskPriority::SomeFrameMainThread : ezTaskPriority::LateNextFrame);
-
-    // restart the next loading task (this one is about to finish)
-    ezResourceManager::s_State->s_bAllowLaunchDataLoadTask = true;
-    ezResourceManager::RunWorkerTask(nullptr);
-
-    pCustomLoader.Clear();
   }
 }
 
@@ -130,6 +169,15 @@ void ezResourceManagerWorkerUpdateContent::Execute()
   if (m_LoaderData.m_LoadedFileModificationDate.IsValid())
     m_pResourceToLoad->m_LoadedFileModificationTime = m_LoaderData.m_LoadedFileModificationDate;
 
+  // always overwrite the path, a loader that does not report it must not inherit the one of a previous loader
+  {
+    ezStringBuilder sLoadedFilePath = m_LoaderData.m_sLoadedFilePath;
+    if (!sLoadedFilePath.IsEmpty())
+      ezResourceManager::NormalizeWatchedFilePath(sLoadedFilePath);
+
+    m_pResourceToLoad->m_sLoadedFilePath = sLoadedFilePath;
+  }
+
   EZ_ASSERT_DEV(m_pResourceToLoad->GetLoadingState() != ezResourceState::Unloaded, "The resource should have changed its loading state.");
 
   // Update Memory Usage
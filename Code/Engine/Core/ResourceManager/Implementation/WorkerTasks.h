@@ -17,7 +17,17 @@ private:
 
   ezResourceManagerWorkerDataLoad();
 
+  struct ResourceToLoad
+  {
+    ezResource* m_pResource = nullptr;
+    ezResourceTypeLoader* m_pLoader = nullptr;
+    ezUniquePtr<ezResourceTypeLoader> m_pCustomLoader;
+  };
+
   virtual void Execute() override;
+
+  static void OnFileRead(ezAsyncFileRead& fileRead);
+  static void LaunchUpdateContent(ResourceToLoad& toLoad, const ezResourceLoadData& loaderData);
 };
 
 /// \brief [internal] Worker task for uploading resource data.
@@ -108,6 +108,11 @@ public:
   /// The date may be invalid, if it cannot be retrieved or the resource was created and not loaded.
   EZ_ALWAYS_INLINE const ezTimestamp& GetLoadedFileModificationTime() const { return m_LoadedFileModificationTime; }
 
+  /// \brief Returns the absolute path of the file from which this resource was loaded.
+  ///
+  /// The path is empty, if the resource type loader does not report it or the resource was created and not loaded.
+  EZ_ALWAYS_INLINE const ezString& GetLoadedFilePath() const { return m_sLoadedFilePath; }
+
   /// \brief Returns the current value of the resource change counter.
   /// Can be used to detect whether the resource has changed since using it last time.
   ///
@@ -228,6 +233,7 @@ private:
   ezTime m_LastAcquire;
   ezResourcePriority m_Priority = ezResourcePriority::Medium;
   ezTimestamp m_LoadedFileModificationTime;
+  ezString m_sLoadedFilePath;
 
 private:
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
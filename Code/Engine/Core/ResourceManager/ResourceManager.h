@@ -123,6 +123,34 @@ public:
   template <typename ResourceType>
   static bool ReloadResource(const ezTypedResourceHandle<ResourceType>& hResource, bool bForce);
 
+  /// \brief Enables or disables watching the folder data directories for file changes.
+  ///
+  /// While enabled, ReloadAllResources() and ReloadResourcesOfType() only check resources whose file was reported as changed since the last
+  /// call, instead of querying the file stats of every loaded resource. Resources whose loader does not report the loaded file path
+  /// (see ezResourceLoadData::m_sLoadedFilePath) or whose file is not inside a watched directory are still checked individually.
+  ///
+  /// If the watchers missed changes, e.g. because the OS dropped events, every resource is checked again. After ReloadResourcesOfType()
+  /// did that for all types with loaded resources, or after one call to ReloadAllResources(), only changed files are checked again.
+  ///
+  /// A file that starts to shadow the loaded file from a data directory with higher priority is not detected in this mode.
+  static void SetFileWatchingEnabled(bool bEnable);
+
+  /// \brief Returns whether SetFileWatchingEnabled() was enabled.
+  static bool IsFileWatchingEnabled();
+
+  /// \brief Sets how many resources are taken from the loading queue at once, such that their files can be read at the same time.
+  ///
+  /// The files are read through ezAsyncFileReader, which uses io_uring on Linux. Only resources whose loader implements
+  /// ezResourceTypeLoader::GetFileToRead() are read in batches. A batch size of 1 reads every file individually.
+  ///
+  /// Resources that get queued while a batch is read have to wait for the entire batch, even if they have a higher priority. The default
+  /// of 32 keeps that delay short, while still keeping many reads in flight at once. The batch size is capped at 64, which
+  /// is the maximum number of reads that ezAsyncFileReader keeps in flight, larger batches would only add latency.
+  static void SetFileReadBatchSize(ezUInt32 uiNumResources);
+
+  /// \brief Returns the value set through SetFileReadBatchSize().
+  static ezUInt32 GetFileReadBatchSize();
+
   /// \brief Calls ReloadResource() on the given resource, but makes sure that the reload happens with the given custom loader.
   ///
   /// Use this e.g. with a ezResourceLoaderFromMemory to replace an existing resource with new data that was created on-the-fly.
@@ -439,6 +467,10 @@ private:
   static void UpdateLoadingDeadlines();
   static void ReverseBubbleSortStep(ezDeque<LoadingInfo>& data);
   static bool ReloadResource(ezResource* pResource, bool bForce);
+  /// Returns false, if changes might have been missed since the last full check, because a directory has just started to be watched.
+  static bool UpdateDirectoryWatchers();
+  static bool IsUnchangedWatchedFile(const ezResource* pResource);
+  static void NormalizeWatchedFilePath(ezStringBuilder& sPath);
 
   static void SetupWorkerTasks();
   static ezTime GetLastFrameUpdate();
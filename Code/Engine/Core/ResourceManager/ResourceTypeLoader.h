@@ -5,6 +5,8 @@
 #include <Foundation/IO/Stream.h>
 #include <Foundation/Time/Timestamp.h>
 
+struct ezAsyncFileRead;
+
 /// \brief Data returned by ezResourceTypeLoader implementations.
 struct EZ_CORE_DLL ezResourceLoadData
 {
@@ -14,6 +16,11 @@ struct EZ_CORE_DLL ezResourceLoadData
   /// Used to keep track when the loaded file was modified last and thus when reloading of the resource might be necessary.
   ezTimestamp m_LoadedFileModificationDate;
 
+  /// Absolute path of the file from which the data was read, if any. Allows ezResourceManager to skip checking the resource for changes,
+  /// as long as file watching is enabled and this file was not reported as modified. Only fill this out, if IsResourceOutdated() depends on
+  /// nothing but this one file.
+  ezString m_sLoadedFilePath;
+
   /// All loaded data should be stored in a memory stream. This stream reader allows the resource to read the memory stream.
   ezStreamReader* m_pDataStream = nullptr;
 
@@ -49,6 +56,18 @@ public:
   /// Call ezResource::GetLoadedFileModificationTime() to query the file modification time that was returned
   /// through ezResourceLoadData::m_LoadedFileModificationDate.
   virtual bool IsResourceOutdated(const ezResource* pResource) const { return false; }
+
+  /// \brief Override this to allow ezResourceManager to read the file of the resource together with the files of other resources.
+  ///
+  /// If this returns true, \a out_Request describes the file that OpenDataStream() would read entirely and OpenDataStreamFromFile() is
+  /// called with its content instead of OpenDataStream(). This should not access the file, that is the job of ezAsyncFileReader.
+  virtual bool GetFileToRead(const ezResource* pResource, ezAsyncFileRead& out_Request) const { return false; }
+
+  /// \brief Same as OpenDataStream(), but the file returned by GetFileToRead() has already been read into \a file.
+  ///
+  /// \a file may have failed to be read, see ezAsyncFileRead::m_Result. This is called on an arbitrary thread and may run in parallel
+  /// for different resources.
+  virtual ezResourceLoadData OpenDataStreamFromFile(const ezResource* pResource, ezAsyncFileRead& file) { return OpenDataStream(pResource); }
 };
 
 /// \brief A default implementation of ezResourceTypeLoader for standard file loading.
@@ -62,6 +81,8 @@ public:
   virtual ezResourceLoadData OpenDataStream(const ezResource* pResource) override;
   virtual void CloseDataStream(const ezResource* pResource, const ezResourceLoadData& LoaderData) override;
   virtual bool IsResourceOutdated(const ezResource* pResource) const override;
+  virtual bool GetFileToRead(const ezResource* pResource, ezAsyncFileRead& out_Request) const override;
+  virtual ezResourceLoadData OpenDataStreamFromFile(const ezResource* pResource, ezAsyncFileRead& file) override;
 };
 
 
@@ -852,6 +852,7 @@ void ezWorld::ProcessQueuedMessages(ezObjectMsgQueueType::Enum queueType)
   // regular messages
   {
     ezInternal::WorldData::MessageQueue& queue = m_Data.m_MessageQueues[queueType];
+    queue.Merge();
     queue.Sort(MessageComparer());
 
     for (ezUInt32 i = 0; i < queue.GetCount(); ++i)
@@ -859,6 +860,12 @@ void ezWorld::ProcessQueuedMessages(ezObjectMsgQueueType::Enum queueType)
       ProcessQueuedMessage(queue[i]);
 
       // no need to deallocate these messages, they are allocated through a frame allocator
+
+      // messages that were posted to this queue in the meantime are processed in the same pass
+      if (i + 1 == queue.GetCount())
+      {
+        queue.Merge();
+      }
     }
 
     queue.Clear();
@@ -867,16 +874,24 @@ void ezWorld::ProcessQueuedMessages(ezObjectMsgQueueType::Enum queueType)
   // timed messages
   {
     ezInternal::WorldData::MessageQueue& queue = m_Data.m_TimedMessageQueues[queueType];
+    queue.Merge();
     queue.Sort(MessageComparer());
 
     const ezTime now = m_Data.m_Clock.GetAccumulatedTime();
 
-    while (!queue.IsEmpty())
+    while (true)
     {
-      auto& entry = queue.Peek();
-      if (entry.m_MetaData.m_Due > now)
-        break;
+      if (queue.IsEmpty() || queue.Peek().m_MetaData.m_Due > now)
+      {
+        // messages that were posted to this queue in the meantime are sorted in and processed in the same pass, if they are already due
+        if (!queue.Merge())
+          break;
 
+        queue.Sort(MessageComparer());
+        continue;
+      }
+
+      auto& entry = queue.Peek();
       ProcessQueuedMessage(entry);
 
       EZ_DELETE(&m_Data.m_Allocator, entry.m_pMessage);
@@ -141,6 +141,8 @@ namespace ezInternal
 
       {
         MessageQueue& queue = m_TimedMessageQueues[i];
+        queue.Merge();
+
         while (!queue.IsEmpty())
         {
           MessageQueue::Entry& entry = queue.Peek();
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <Foundation/Communication/MessageQueue.h>
+#include <Foundation/Communication/MultiProducerMessageQueue.h>
 #include <Foundation/Containers/HashTable.h>
 #include <Foundation/Math/Random.h>
 #include <Foundation/Memory/FrameAllocator.h>
@@ -228,7 +228,7 @@ namespace ezInternal
       ezTime m_Due;
     };
 
-    typedef ezMessageQueue<QueuedMsgMetaData, ezLocalAllocatorWrapper> MessageQueue;
+    typedef ezMultiProducerMessageQueue<QueuedMsgMetaData, ezLocalAllocatorWrapper> MessageQueue;
     mutable MessageQueue m_MessageQueues[ezObjectMsgQueueType::COUNT];
     mutable MessageQueue m_TimedMessageQueues[ezObjectMsgQueueType::COUNT];
 
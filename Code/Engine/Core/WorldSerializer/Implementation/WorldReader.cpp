@@ -1,10 +1,30 @@
 #include <CorePCH.h>
 
 #include <Core/WorldSerializer/WorldReader.h>
+#include <Foundation/Configuration/CVar.h>
 #include <Foundation/IO/StringDeduplicationContext.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/Utilities/Progress.h>
 
+// clang-format off
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezParallelDeserializationAttribute, 1, ezRTTIDefaultAllocator<ezParallelDeserializationAttribute>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+ezCVarBool CVarParallelDeserialization("g_ParallelWorldDeserialization", true, ezCVarFlags::Default, "Deserializes the components of different types in parallel when instantiating large worlds");
+
+namespace
+{
+  /// Below this number of components the overhead of starting tasks outweighs the gain of parallel deserialization.
+  constexpr ezUInt64 s_uiMinComponentsForParallelDeserialization = 512;
+
+  /// Set while a component type is deserialized from its own stream, see ezWorldReader::GetStream().
+  thread_local const ezWorldReader* s_pTypeStreamOwner = nullptr;
+  thread_local ezStreamReader* s_pTypeStream = nullptr;
+  thread_local ezUInt32 s_uiTypeStreamInstance = 0;
+} // namespace
+
 ezWorldReader::FindComponentTypeCallback ezWorldReader::s_FindComponentTypeCallback;
 
 ezWorldReader::ezWorldReader() = default;
@@ -50,6 +70,7 @@ ezResult ezWorldReader::ReadWorldDescription(ezStreamReader& stream)
 
   m_RootObjectsToCreate.Reserve(uiNumRootObjects);
   m_ChildObjectsToCreate.Reserve(uiNumChildObjects);
+  m_RootObjectLocalTransforms.Clear();
 
   m_IndexToGameObjectHandle.SetCountUninitialized(uiNumRootObjects + uiNumChildObjects + 1);
 
@@ -88,12 +109,196 @@ ezUniquePtr<ezWorldReader::InstantiationContextBase> ezWorldReader::InstantiateP
   return Instantiate(world, true, rootTransform, hParent, out_CreatedRootObjects, out_CreatedChildObjects, pOverrideTeamID, bForceDynamic, maxStepTime, pProgress);
 }
 
+void ezWorldReader::InstantiatePrefabs(ezWorld& world, ezArrayPtr<const ezTransform> rootTransforms, ezGameObjectHandle hParent, ezDynamicArray<ezGameObject*>* out_CreatedRootObjects, const ezUInt16* pOverrideTeamID, bool bForceDynamic)
+{
+  if (rootTransforms.IsEmpty())
+    return;
+
+  EZ_PROFILE_SCOPE("ezWorldReader::InstantiatePrefabs");
+
+  EZ_LOCK(world.GetWriteMarker());
+
+  m_pWorld = &world;
+  ResolveComponentManagers();
+
+  if (m_RootObjectLocalTransforms.IsEmpty())
+  {
+    m_RootObjectLocalTransforms.Reserve(m_RootObjectsToCreate.GetCount());
+
+    for (const auto& godesc : m_RootObjectsToCreate)
+    {
+      m_RootObjectLocalTransforms.PushBack(ezTransform(godesc.m_Desc.m_LocalPosition, godesc.m_Desc.m_LocalRotation, godesc.m_Desc.m_LocalScaling));
+    }
+  }
+
+  const ezUInt32 uiNumInstances = rootTransforms.GetCount();
+  const ezUInt32 uiObjectStride = GetObjectHandleStride();
+
+  m_LastInstantiationStats = InstantiationStats();
+  ezTime tPhaseStart = ezTime::Now();
+  auto EndPhase = [&tPhaseStart](ezTime& out_Duration) {
+    const ezTime tNow = ezTime::Now();
+    out_Duration = tNow - tPhaseStart;
+    tPhaseStart = tNow;
+  };
+
+  m_IndexToGameObjectHandle.Clear();
+  m_IndexToGameObjectHandle.SetCount(uiNumInstances * uiObjectStride);
+
+  if (out_CreatedRootObjects != nullptr)
+  {
+    out_CreatedRootObjects->Reserve(out_CreatedRootObjects->GetCount() + uiNumInstances * m_RootObjectsToCreate.GetCount());
+  }
+
+  {
+    EZ_PROFILE_SCOPE("ezWorldReader::CreateGameObjects");
+
+    for (ezUInt32 uiInstance = 0; uiInstance < uiNumInstances; ++uiInstance)
+    {
+      ezGameObjectHandle* pIndexToGameObjectHandle = m_IndexToGameObjectHandle.GetData() + uiInstance * uiObjectStride;
+      ezUInt32 uiHandleIdx = 1;
+
+      auto CreateObject = [&](const GameObjectToCreate& godesc, ezGameObjectDesc& desc) {
+        desc.m_bDynamic |= bForceDynamic;
+
+        if (pOverrideTeamID != nullptr)
+        {
+          desc.m_uiTeamID = *pOverrideTeamID;
+        }
+
+        ezGameObject* pObject = nullptr;
+        pIndexToGameObjectHandle[uiHandleIdx++] = world.CreateObject(desc, pObject);
+
+        if (!godesc.m_sGlobalKey.IsEmpty())
+        {
+          pObject->SetGlobalKey(godesc.m_sGlobalKey);
+        }
+
+        return pObject;
+      };
+
+      for (ezUInt32 i = 0; i < m_RootObjectsToCreate.GetCount(); ++i)
+      {
+        ezGameObjectDesc desc = m_RootObjectsToCreate[i].m_Desc; // make a copy
+        desc.m_hParent = hParent;
+
+        ezTransform tFinal;
+        tFinal.SetGlobalTransform(rootTransforms[uiInstance], m_RootObjectLocalTransforms[i]);
+
+        desc.m_LocalPosition = tFinal.m_vPosition;
+        desc.m_LocalRotation = tFinal.m_qRotation;
+        desc.m_LocalScaling = tFinal.m_vScale;
+
+        ezGameObject* pObject = CreateObject(m_RootObjectsToCreate[i], desc);
+
+        if (out_CreatedRootObjects != nullptr)
+        {
+          out_CreatedRootObjects->PushBack(pObject);
+        }
+      }
+
+      for (const auto& godesc : m_ChildObjectsToCreate)
+      {
+        ezGameObjectDesc desc = godesc.m_Desc; // make a copy
+        desc.m_hParent = pIndexToGameObjectHandle[godesc.m_uiParentHandleIdx];
+
+        CreateObject(godesc, desc);
+      }
+    }
+
+    EndPhase(m_LastInstantiationStats.m_CreateObjects);
+  }
+
+  {
+    EZ_PROFILE_SCOPE("ezWorldReader::CreateComponents");
+
+    for (auto& compTypeInfo : m_ComponentTypes)
+    {
+      const ezUInt32 uiComponentStride = compTypeInfo.m_uiNumComponents + 1;
+
+      compTypeInfo.m_ComponentIndexToHandle.Clear();
+      compTypeInfo.m_ComponentIndexToHandle.SetCount(uiNumInstances * uiComponentStride);
+
+      // will be the case for all abstract component types
+      if (compTypeInfo.m_pManager == nullptr)
+        continue;
+
+      const ComponentToCreate* pComponentsToCreate = m_ComponentsToCreate.GetData() + compTypeInfo.m_uiFirstComponentToCreate;
+
+      for (ezUInt32 uiInstance = 0; uiInstance < uiNumInstances; ++uiInstance)
+      {
+        const ezGameObjectHandle* pIndexToGameObjectHandle = m_IndexToGameObjectHandle.GetData() + uiInstance * uiObjectStride;
+        ezComponentHandle* pIndexToComponentHandle = compTypeInfo.m_ComponentIndexToHandle.GetData() + uiInstance * uiComponentStride;
+
+        for (ezUInt32 i = 0; i < compTypeInfo.m_uiNumComponents; ++i)
+        {
+          ezGameObject* pOwnerObject = nullptr;
+          world.TryGetObject(pIndexToGameObjectHandle[pComponentsToCreate[i].m_uiOwnerObjectIdx], pOwnerObject);
+
+          pIndexToComponentHandle[i + 1] = CreateComponent(compTypeInfo.m_pManager, pOwnerObject, pComponentsToCreate[i]);
+        }
+      }
+    }
+
+    EndPhase(m_LastInstantiationStats.m_CreateComponents);
+  }
+
+  if (m_ComponentDataStream.GetStorageSize() > 0)
+  {
+    EZ_PROFILE_SCOPE("ezWorldReader::DeserializeComponents");
+
+    if (CVarParallelDeserialization && m_uiTotalNumComponents * uiNumInstances >= s_uiMinComponentsForParallelDeserialization)
+    {
+      m_LastInstantiationStats.m_bParallelDeserialization = true;
+      DeserializeComponentsParallel(uiNumInstances);
+    }
+    else
+    {
+      for (ezUInt32 uiTypeIdx = 0; uiTypeIdx < m_ComponentTypes.GetCount(); ++uiTypeIdx)
+      {
+        if (m_ComponentTypes[uiTypeIdx].m_pManager != nullptr)
+        {
+          DeserializeComponentsOfType(uiTypeIdx, uiNumInstances);
+        }
+      }
+    }
+
+    EndPhase(m_LastInstantiationStats.m_DeserializeComponents);
+  }
+
+  {
+    EZ_PROFILE_SCOPE("ezWorldReader::InitComponents");
+
+    for (auto& compTypeInfo : m_ComponentTypes)
+    {
+      if (compTypeInfo.m_pManager == nullptr)
+        continue;
+
+      for (const ezComponentHandle& hComponent : compTypeInfo.m_ComponentIndexToHandle)
+      {
+        ezComponent* pComponent = nullptr;
+        if (compTypeInfo.m_pManager->TryGetComponent(hComponent, pComponent))
+        {
+          compTypeInfo.m_pManager->InitializeComponent(pComponent);
+        }
+      }
+    }
+
+    EndPhase(m_LastInstantiationStats.m_InitComponents);
+  }
+}
+
+ezStreamReader& ezWorldReader::GetStream() const
+{
+  return s_pTypeStreamOwner == this ? *s_pTypeStream : *m_pStream;
+}
+
 ezGameObjectHandle ezWorldReader::ReadGameObjectHandle()
 {
   ezUInt32 idx = 0;
-  *m_pStream >> idx;
+  GetStream() >> idx;
 
-  return m_IndexToGameObjectHandle[idx];
+  return m_IndexToGameObjectHandle[GetCurrentInstanceIndex() * GetObjectHandleStride() + idx];
 }
 
 void ezWorldReader::ReadComponentHandle(ezComponentHandle& out_hComponent)
@@ -101,17 +306,20 @@ void ezWorldReader::ReadComponentHandle(ezComponentHandle& out_hComponent)
   ezUInt16 uiTypeIndex = 0;
   ezUInt32 uiIndex = 0;
 
-  *m_pStream >> uiTypeIndex;
-  *m_pStream >> uiIndex;
+  ezStreamReader& s = GetStream();
+  s >> uiTypeIndex;
+  s >> uiIndex;
 
   out_hComponent.Invalidate();
 
   if (uiTypeIndex < m_ComponentTypes.GetCount())
   {
-    auto& indexToHandle = m_ComponentTypes[uiTypeIndex].m_ComponentIndexToHandle;
-    if (uiIndex < indexToHandle.GetCount())
+    const auto& compTypeInfo = m_ComponentTypes[uiTypeIndex];
+    const ezUInt32 uiHandleIdx = GetCurrentInstanceIndex() * (compTypeInfo.m_uiNumComponents + 1) + uiIndex;
+
+    if (uiIndex <= compTypeInfo.m_uiNumComponents && uiHandleIdx < compTypeInfo.m_ComponentIndexToHandle.GetCount())
     {
-      out_hComponent = indexToHandle[uiIndex];
+      out_hComponent = compTypeInfo.m_ComponentIndexToHandle[uiHandleIdx];
     }
   }
 }
@@ -135,14 +343,17 @@ void ezWorldReader::ClearAndCompact()
   m_ChildObjectsToCreate.Clear();
   m_ChildObjectsToCreate.Compact();
 
+  m_RootObjectLocalTransforms.Clear();
+  m_RootObjectLocalTransforms.Compact();
+
   m_ComponentTypes.Clear();
   m_ComponentTypes.Compact();
 
   m_ComponentTypeVersions.Clear();
   m_ComponentTypeVersions.Compact();
 
-  m_ComponentCreationStream.Clear();
-  m_ComponentCreationStream.Compact();
+  m_ComponentsToCreate.Clear();
+  m_ComponentsToCreate.Compact();
 
   m_ComponentDataStream.Clear();
   m_ComponentDataStream.Compact();
@@ -150,7 +361,7 @@ void ezWorldReader::ClearAndCompact()
 
 ezUInt64 ezWorldReader::GetHeapMemoryUsage() const
 {
-  return m_IndexToGameObjectHandle.GetHeapMemoryUsage() + m_RootObjectsToCreate.GetHeapMemoryUsage() + m_ChildObjectsToCreate.GetHeapMemoryUsage() + m_ComponentTypes.GetHeapMemoryUsage() + m_ComponentTypeVersions.GetHeapMemoryUsage() + m_ComponentCreationStream.GetHeapMemoryUsage() +
+  return m_IndexToGameObjectHandle.GetHeapMemoryUsage() + m_RootObjectsToCreate.GetHeapMemoryUsage() + m_ChildObjectsToCreate.GetHeapMemoryUsage() + m_RootObjectLocalTransforms.GetHeapMemoryUsage() + m_ComponentTypes.GetHeapMemoryUsage() + m_ComponentTypeVersions.GetHeapMemoryUsage() + m_ComponentsToCreate.GetHeapMemoryUsage() +
          m_ComponentDataStream.GetHeapMemoryUsage();
 }
 
@@ -218,6 +429,7 @@ void ezWorldReader::ReadComponentTypeInfo(ezUInt32 uiComponentTypeIdx)
   }
 
   m_ComponentTypes[uiComponentTypeIdx].m_pRtti = pRtti;
+  m_ComponentTypes[uiComponentTypeIdx].m_bDeserializeInParallel = pRtti != nullptr && pRtti->GetAttributeByType<ezParallelDeserializationAttribute>() != nullptr;
   m_ComponentTypeVersions[pRtti] = uiRttiVersion;
 }
 
@@ -245,6 +457,11 @@ void ezWorldReader::ReadComponentDataToMemStream()
 
           m_uiTotalNumComponents += compTypeInfo.m_uiNumComponents;
         }
+        else
+        {
+          compTypeInfo.m_uiDataOffset = writer.GetWritePosition();
+          compTypeInfo.m_uiDataSize = uiAllComponentsSize;
+        }
 
         while (uiAllComponentsSize > 0)
         {
@@ -259,8 +476,11 @@ void ezWorldReader::ReadComponentDataToMemStream()
   };
 
   {
-    ezMemoryStreamWriter writer(&m_ComponentCreationStream);
+    ezMemoryStreamStorage creationStream;
+    ezMemoryStreamWriter writer(&creationStream);
     WriteToMemStream(writer, true);
+
+    DecodeComponentCreationData(creationStream);
   }
 
   {
@@ -269,14 +489,158 @@ void ezWorldReader::ReadComponentDataToMemStream()
   }
 }
 
+void ezWorldReader::DecodeComponentCreationData(ezMemoryStreamStorage& storage)
+{
+  ezMemoryStreamReader reader(&storage);
+
+  m_ComponentsToCreate.Clear();
+  m_ComponentsToCreate.Reserve(static_cast<ezUInt32>(m_uiTotalNumComponents));
+
+  for (auto& compTypeInfo : m_ComponentTypes)
+  {
+    compTypeInfo.m_uiFirstComponentToCreate = m_ComponentsToCreate.GetCount();
+
+    if (compTypeInfo.m_pRtti == nullptr)
+      continue;
+
+    for (ezUInt32 i = 0; i < compTypeInfo.m_uiNumComponents; ++i)
+    {
+      ComponentToCreate& componentToCreate = m_ComponentsToCreate.ExpandAndGetRef();
+
+      reader >> componentToCreate.m_uiOwnerObjectIdx;
+
+      ezUInt32 uiComponentIdx = 0;
+      reader >> uiComponentIdx;
+      EZ_ASSERT_DEBUG(uiComponentIdx == i + 1, "Component index doesn't match");
+
+      reader >> componentToCreate.m_bActive;
+      reader >> componentToCreate.m_uiUserFlags;
+    }
+  }
+}
+
+void ezWorldReader::ResolveComponentManagers()
+{
+  for (auto& compTypeInfo : m_ComponentTypes)
+  {
+    compTypeInfo.m_pManager = nullptr;
+
+    // will be the case for all abstract component types
+    if (compTypeInfo.m_pRtti == nullptr || compTypeInfo.m_uiNumComponents == 0)
+      continue;
+
+    compTypeInfo.m_pManager = m_pWorld->GetOrCreateManagerForComponentType(compTypeInfo.m_pRtti);
+    EZ_ASSERT_DEV(compTypeInfo.m_pManager != nullptr, "Cannot create components of type '{0}', manager is not available.", compTypeInfo.m_pRtti->GetTypeName());
+  }
+}
+
+ezUInt32 ezWorldReader::GetCurrentInstanceIndex() const
+{
+  return s_pTypeStreamOwner == this ? s_uiTypeStreamInstance : 0;
+}
+
+ezComponentHandle ezWorldReader::CreateComponent(ezComponentManagerBase* pManager, ezGameObject* pOwnerObject, const ComponentToCreate& componentToCreate)
+{
+  EZ_ASSERT_DEBUG(pOwnerObject != nullptr, "Owner object must be not null");
+
+  ezComponent* pComponent = nullptr;
+  auto hComponent = pManager->CreateComponentNoInit(pOwnerObject, pComponent);
+
+  pComponent->SetActiveFlag(componentToCreate.m_bActive);
+
+  const ezUInt8 userFlags = componentToCreate.m_uiUserFlags;
+  for (ezUInt8 j = 0; j < 8; ++j)
+  {
+    pComponent->SetUserFlag(j, (userFlags & EZ_BIT(j)) != 0);
+  }
+
+  return hComponent;
+}
+
+void ezWorldReader::DeserializeComponentsOfType(ezUInt32 uiComponentTypeIdx, ezUInt32 uiNumInstances)
+{
+  auto& compTypeInfo = m_ComponentTypes[uiComponentTypeIdx];
+
+  EZ_PROFILE_SCOPE(compTypeInfo.m_pRtti->GetTypeName());
+
+  const ezWorldReader* pPrevOwner = s_pTypeStreamOwner;
+  ezStreamReader* pPrevStream = s_pTypeStream;
+  const ezUInt32 uiPrevInstance = s_uiTypeStreamInstance;
+  s_pTypeStreamOwner = this;
+
+  // the string deduplication context is thread local, worker threads have to activate it themselves
+  const bool bActivateStringDedup = ezStringDeduplicationReadContext::GetContext() == nullptr;
+  if (bActivateStringDedup)
+  {
+    m_pStringDedupReadContext->SetActive(true);
+  }
+
+  EZ_SCOPE_EXIT(s_pTypeStreamOwner = pPrevOwner; s_pTypeStream = pPrevStream; s_uiTypeStreamInstance = uiPrevInstance; if (bActivateStringDedup) { m_pStringDedupReadContext->SetActive(false); });
+
+  // don't go through the world here, it may only be accessed for writing from the main thread
+  ezComponentManagerBase* pManager = compTypeInfo.m_pManager;
+  const ezUInt32 uiComponentStride = compTypeInfo.m_uiNumComponents + 1;
+
+  // every instance replays the same data, only the handle remap table differs
+  for (ezUInt32 uiInstance = 0; uiInstance < uiNumInstances; ++uiInstance)
+  {
+    ezRawMemoryStreamReader reader(m_ComponentDataStream.GetData() + compTypeInfo.m_uiDataOffset, compTypeInfo.m_uiDataSize);
+    s_pTypeStream = &reader;
+    s_uiTypeStreamInstance = uiInstance;
+
+    const ezComponentHandle* pIndexToComponentHandle = compTypeInfo.m_ComponentIndexToHandle.GetData() + uiInstance * uiComponentStride;
+
+    for (ezUInt32 i = 1; i < uiComponentStride; ++i)
+    {
+      ezComponent* pComponent = nullptr;
+      if (pManager->TryGetComponent(pIndexToComponentHandle[i], pComponent))
+      {
+        pComponent->DeserializeComponent(*this);
+      }
+    }
+  }
+}
+
+void ezWorldReader::DeserializeComponentsParallel(ezUInt32 uiNumInstances)
+{
+  ezHybridArray<ezUInt32, 64> parallelTypes;
+  ezHybridArray<ezUInt32, 16> mainThreadTypes;
+
+  for (ezUInt32 uiTypeIdx = 0; uiTypeIdx < m_ComponentTypes.GetCount(); ++uiTypeIdx)
+  {
+    const auto& compTypeInfo = m_ComponentTypes[uiTypeIdx];
+    if (compTypeInfo.m_pManager == nullptr)
+      continue;
+
+    if (compTypeInfo.m_bDeserializeInParallel)
+      parallelTypes.PushBack(uiTypeIdx);
+    else
+      mainThreadTypes.PushBack(uiTypeIdx);
+  }
+
+  // components of different types don't touch each other during deserialization, so every type is one task item
+  ezParallelForParams params;
+  params.uiMaxTasksPerThread = 4; // the number of components per type varies a lot
+
+  ezTaskSystem::ParallelForSingle(
+    parallelTypes.GetArrayPtr(), [this, uiNumInstances](ezUInt32 uiTypeIdx) { DeserializeComponentsOfType(uiTypeIdx, uiNumInstances); }, "DeserializeComponents", params);
+
+  for (ezUInt32 uiTypeIdx : mainThreadTypes)
+  {
+    DeserializeComponentsOfType(uiTypeIdx, uiNumInstances);
+  }
+}
+
 void ezWorldReader::ClearHandles()
 {
   m_IndexToGameObjectHandle.Clear();
+  m_IndexToGameObjectHandle.Reserve(m_RootObjectsToCreate.GetCount() + m_ChildObjectsToCreate.GetCount() + 1);
   m_IndexToGameObjectHandle.PushBack(ezGameObjectHandle());
 
   for (auto& compTypeInfo : m_ComponentTypes)
   {
     compTypeInfo.m_ComponentIndexToHandle.Clear();
+    compTypeInfo.m_ComponentIndexToHandle.Reserve(compTypeInfo.m_uiNumComponents + 1);
     compTypeInfo.m_ComponentIndexToHandle.PushBack(ezComponentHandle());
   }
 }
@@ -286,6 +650,11 @@ ezUniquePtr<ezWorldReader::InstantiationContextBase> ezWorldReader::Instantiate(
 {
   m_pWorld = &world;
 
+  {
+    EZ_LOCK(world.GetWriteMarker());
+    ResolveComponentManagers();
+  }
+
   ClearHandles();
 
   if (maxStepTime <= ezTime::Zero())
@@ -314,6 +683,10 @@ ezWorldReader::InstantiationContext::InstantiationContext(ezWorldReader& worldRe
   , m_MaxStepTime(maxStepTime.IsPositive() ? maxStepTime : ezTime::Hours(10000))
 {
   m_Phase = Phase::CreateRootObjects;
+  m_PhaseStartTime = ezTime::Now();
+
+  // time sliced instantiation deserializes the components one by one, to be able to stop at any point
+  m_bParallelDeserialization = !maxStepTime.IsPositive() && CVarParallelDeserialization && worldReader.m_uiTotalNumComponents >= s_uiMinComponentsForParallelDeserialization;
 
   if (maxStepTime.IsPositive())
   {
@@ -351,7 +724,10 @@ bool ezWorldReader::InstantiationContext::Step()
 
   EZ_LOCK(m_WorldReader.m_pWorld->GetWriteMarker());
 
-  ezTime endTime = ezTime::Now() + m_MaxStepTime;
+  m_PhaseStartTime = ezTime::Now();
+  EZ_SCOPE_EXIT(if (m_Phase != Phase::Invalid) { m_PhaseDurations[m_Phase] += ezTime::Now() - m_PhaseStartTime; });
+
+  ezTime endTime = m_PhaseStartTime + m_MaxStepTime;
 
   if (m_Phase == Phase::CreateRootObjects)
   {
@@ -366,8 +742,7 @@ bool ezWorldReader::InstantiationContext::Step()
         return false;
     }
 
-    m_Phase = Phase::CreateChildObjects;
-    BeginNextProgressStep("CreateChildObjects");
+    BeginNextPhase(Phase::CreateChildObjects, "CreateChildObjects");
   }
 
   if (m_Phase == Phase::CreateChildObjects)
@@ -375,29 +750,16 @@ bool ezWorldReader::InstantiationContext::Step()
     if (!CreateGameObjects<false>(m_WorldReader.m_ChildObjectsToCreate, ezGameObjectHandle(), m_pCreatedChildObjects, endTime))
       return false;
 
-    m_CurrentReader.SetStorage(&m_WorldReader.m_ComponentCreationStream);
-    m_Phase = Phase::CreateComponents;
-    BeginNextProgressStep("CreateComponents");
+    BeginNextPhase(Phase::CreateComponents, "CreateComponents");
   }
 
   if (m_Phase == Phase::CreateComponents)
   {
-    if (m_WorldReader.m_ComponentCreationStream.GetStorageSize() > 0)
-    {
-      m_WorldReader.m_pStringDedupReadContext->SetActive(true);
-
-      ezStreamReader* pPrevReader = m_WorldReader.m_pStream;
-      m_WorldReader.m_pStream = &m_CurrentReader;
-
-      EZ_SCOPE_EXIT(m_WorldReader.m_pStream = pPrevReader; m_WorldReader.m_pStringDedupReadContext->SetActive(false););
-
-      if (!CreateComponents(endTime))
-        return false;
-    }
+    if (!CreateComponents(endTime))
+      return false;
 
     m_CurrentReader.SetStorage(&m_WorldReader.m_ComponentDataStream);
-    m_Phase = Phase::DeserializeComponents;
-    BeginNextProgressStep("DeserializeComponents");
+    BeginNextPhase(Phase::DeserializeComponents, "DeserializeComponents");
   }
 
   if (m_Phase == Phase::DeserializeComponents)
@@ -416,8 +778,7 @@ bool ezWorldReader::InstantiationContext::Step()
     }
 
     m_CurrentReader.SetStorage(nullptr);
-    m_Phase = Phase::AddComponentsToBatch;
-    BeginNextProgressStep("AddComponentsToBatch");
+    BeginNextPhase(Phase::AddComponentsToBatch, "AddComponentsToBatch");
   }
 
   if (m_Phase == Phase::AddComponentsToBatch)
@@ -425,8 +786,7 @@ bool ezWorldReader::InstantiationContext::Step()
     if (!AddComponentsToBatch(endTime))
       return false;
 
-    m_Phase = Phase::InitComponents;
-    BeginNextProgressStep("InitComponents");
+    BeginNextPhase(Phase::InitComponents, "InitComponents");
   }
 
   if (m_Phase == Phase::InitComponents)
@@ -441,6 +801,9 @@ bool ezWorldReader::InstantiationContext::Step()
       }
     }
 
+    m_PhaseDurations[m_Phase] += ezTime::Now() - m_PhaseStartTime;
+    ReportPhaseDurations();
+
     m_Phase = Phase::Invalid;
     m_pSubProgressRange = nullptr;
     m_pOverallProgressRange = nullptr;
@@ -522,49 +885,28 @@ bool ezWorldReader::InstantiationContext::CreateComponents(ezTime endTime)
 {
   EZ_PROFILE_SCOPE("ezWorldReader::CreateComponents");
 
-  ezStreamReader& s = *m_WorldReader.m_pStream;
+  ezWorld* pWorld = m_WorldReader.m_pWorld;
+  const ezGameObjectHandle* pIndexToGameObjectHandle = m_WorldReader.m_IndexToGameObjectHandle.GetData();
 
   for (; m_uiCurrentComponentTypeIndex < m_WorldReader.m_ComponentTypes.GetCount(); ++m_uiCurrentComponentTypeIndex)
   {
     auto& compTypeInfo = m_WorldReader.m_ComponentTypes[m_uiCurrentComponentTypeIndex];
 
     // will be the case for all abstract component types
-    if (compTypeInfo.m_pRtti == nullptr || compTypeInfo.m_uiNumComponents == 0)
+    if (compTypeInfo.m_pManager == nullptr)
       continue;
 
-    ezComponentManagerBase* pManager = m_WorldReader.m_pWorld->GetOrCreateManagerForComponentType(compTypeInfo.m_pRtti);
-    EZ_ASSERT_DEV(pManager != nullptr, "Cannot create components of type '{0}', manager is not available.", compTypeInfo.m_pRtti->GetTypeName());
+    ezComponentManagerBase* pManager = compTypeInfo.m_pManager;
+    const ComponentToCreate* pComponentsToCreate = m_WorldReader.m_ComponentsToCreate.GetData() + compTypeInfo.m_uiFirstComponentToCreate;
 
     while (m_uiCurrentIndex < compTypeInfo.m_uiNumComponents)
     {
-      const ezGameObjectHandle hOwner = m_WorldReader.ReadGameObjectHandle();
-
-      ezUInt32 uiComponentIdx = 0;
-      s >> uiComponentIdx;
-
-      bool bActive = true;
-      s >> bActive;
-
-      ezUInt8 userFlags = 0;
-      s >> userFlags;
+      const ComponentToCreate& componentToCreate = pComponentsToCreate[m_uiCurrentIndex];
 
       ezGameObject* pOwnerObject = nullptr;
-      m_WorldReader.m_pWorld->TryGetObject(hOwner, pOwnerObject);
+      pWorld->TryGetObject(pIndexToGameObjectHandle[componentToCreate.m_uiOwnerObjectIdx], pOwnerObject);
 
-      EZ_ASSERT_DEBUG(pOwnerObject != nullptr, "Owner object must be not null");
-
-      ezComponent* pComponent = nullptr;
-      auto hComponent = pManager->CreateComponentNoInit(pOwnerObject, pComponent);
-
-      pComponent->SetActiveFlag(bActive);
-
-      for (ezUInt8 j = 0; j < 8; ++j)
-      {
-        pComponent->SetUserFlag(j, (userFlags & EZ_BIT(j)) != 0);
-      }
-
-      EZ_ASSERT_DEBUG(uiComponentIdx == compTypeInfo.m_ComponentIndexToHandle.GetCount(), "Component index doesn't match");
-      compTypeInfo.m_ComponentIndexToHandle.PushBack(hComponent);
+      compTypeInfo.m_ComponentIndexToHandle.PushBack(CreateComponent(pManager, pOwnerObject, componentToCreate));
 
       ++m_uiCurrentIndex;
       ++m_uiCurrentNumComponentsProcessed;
@@ -591,6 +933,12 @@ bool ezWorldReader::InstantiationContext::DeserializeComponents(ezTime endTime)
 {
   EZ_PROFILE_SCOPE("ezWorldReader::DeserializeComponents");
 
+  if (m_bParallelDeserialization)
+  {
+    m_WorldReader.DeserializeComponentsParallel(1);
+    return true;
+  }
+
   ezStreamReader& s = *m_WorldReader.m_pStream;
 
   for (; m_uiCurrentComponentTypeIndex < m_WorldReader.m_ComponentTypes.GetCount(); ++m_uiCurrentComponentTypeIndex)
@@ -685,6 +1033,16 @@ bool ezWorldReader::InstantiationContext::AddComponentsToBatch(ezTime endTime)
   return true;
 }
 
+void ezWorldReader::InstantiationContext::BeginNextPhase(Phase::Enum phase, const char* szName)
+{
+  const ezTime tNow = ezTime::Now();
+  m_PhaseDurations[m_Phase] += tNow - m_PhaseStartTime;
+  m_PhaseStartTime = tNow;
+
+  m_Phase = phase;
+  BeginNextProgressStep(szName);
+}
+
 void ezWorldReader::InstantiationContext::BeginNextProgressStep(const char* szName)
 {
   if (m_pOverallProgressRange != nullptr)
@@ -695,6 +1053,29 @@ void ezWorldReader::InstantiationContext::BeginNextProgressStep(const char* szNa
   }
 }
 
+void ezWorldReader::InstantiationContext::ReportPhaseDurations()
+{
+  InstantiationStats& stats = m_WorldReader.m_LastInstantiationStats;
+  stats.m_CreateObjects = m_PhaseDurations[Phase::CreateRootObjects] + m_PhaseDurations[Phase::CreateChildObjects];
+  stats.m_CreateComponents = m_PhaseDurations[Phase::CreateComponents];
+  stats.m_DeserializeComponents = m_PhaseDurations[Phase::DeserializeComponents];
+  stats.m_InitComponents = m_PhaseDurations[Phase::AddComponentsToBatch] + m_PhaseDurations[Phase::InitComponents];
+  stats.m_bParallelDeserialization = m_bParallelDeserialization;
+
+  // only worth logging for instantiations that are tracked with a progress bar, i.e. level loading
+  if (m_pOverallProgressRange == nullptr)
+    return;
+
+  ezLog::Dev("World instantiation: CreateRootObjects {}ms, CreateChildObjects {}ms, CreateComponents {}ms, DeserializeComponents {}ms ({}), AddComponentsToBatch {}ms, InitComponents {}ms",
+    ezArgF(m_PhaseDurations[Phase::CreateRootObjects].GetMilliseconds(), 2),
+    ezArgF(m_PhaseDurations[Phase::CreateChildObjects].GetMilliseconds(), 2),
+    ezArgF(m_PhaseDurations[Phase::CreateComponents].GetMilliseconds(), 2),
+    ezArgF(m_PhaseDurations[Phase::DeserializeComponents].GetMilliseconds(), 2),
+    m_bParallelDeserialization ? "parallel" : "serial",
+    ezArgF(m_PhaseDurations[Phase::AddComponentsToBatch].GetMilliseconds(), 2),
+    ezArgF(m_PhaseDurations[Phase::InitComponents].GetMilliseconds(), 2));
+}
+
 void ezWorldReader::InstantiationContext::SetSubProgressCompletion(double fCompletion)
 {
   if (m_pSubProgressRange != nullptr)
@@ -3,12 +3,25 @@
 #include <Core/World/World.h>
 #include <Foundation/IO/MemoryStream.h>
 #include <Foundation/IO/Stream.h>
+#include <Foundation/Reflection/Reflection.h>
 #include <Foundation/Types/UniquePtr.h>
 
 class ezStringDeduplicationReadContext;
 class ezProgress;
 class ezProgressRange;
 
+/// \brief Add this attribute to a component type to allow deserializing all components of that type on a worker thread.
+///
+/// When instantiating large worlds, ezWorldReader deserializes the components of all types that carry this attribute in parallel,
+/// one task per type. All other types are deserialized on the main thread.
+/// Only add this attribute if DeserializeComponent() exclusively reads from the stream and writes to the component itself,
+/// i.e. it doesn't touch the world, other components or any other shared state.
+/// The attribute is inherited by all derived component types, so those have to obey the same rule.
+class EZ_CORE_DLL ezParallelDeserializationAttribute : public ezPropertyAttribute
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezParallelDeserializationAttribute, ezPropertyAttribute);
+};
+
 /// \brief Reads a world description from a stream. Allows to instantiate that world multiple times
 ///        in different locations and different ezWorld's.
 ///
@@ -80,8 +93,22 @@ public:
     ezHybridArray<ezGameObject*, 8>* out_CreatedRootObjects, ezHybridArray<ezGameObject*, 8>* out_CreatedChildObjects,
     const ezUInt16* pOverrideTeamID, bool bForceDynamic, ezTime maxStepTime = ezTime::Zero(), ezProgress* pProgress = nullptr);
 
+  /// \brief Creates one instance of the world that was previously read by ReadWorldDescription() for every given root transform.
+  ///
+  /// This is equivalent to calling InstantiatePrefab() once per transform, but every instantiation phase runs for all instances at once.
+  /// The decoded prefab (object descriptions, component creation data and the serialized data of each component type) is used
+  /// as a template and every instance only gets its own handle remap table. The component data of each type is replayed for all instances in a row.
+  /// Use this when the same prefab needs to be spawned many times in one frame, e.g. for procedural placement.
+  ///
+  /// \param out_CreatedRootObjects If this is valid, the pointers to the created root objects of all instances are appended to this array.
+  void InstantiatePrefabs(ezWorld& world, ezArrayPtr<const ezTransform> rootTransforms, ezGameObjectHandle hParent,
+    ezDynamicArray<ezGameObject*>* out_CreatedRootObjects, const ezUInt16* pOverrideTeamID, bool bForceDynamic);
+
   /// \brief Gives access to the stream of data. Use this inside component deserialization functions to read data.
-  ezStreamReader& GetStream() const { return *m_pStream; }
+  ///
+  /// During parallel deserialization every component type is read from its own stream, so always fetch the stream
+  /// inside DeserializeComponent() and never cache it across components.
+  ezStreamReader& GetStream() const;
 
   /// \brief Used during component deserialization to read a handle to a game object.
   ezGameObjectHandle ReadGameObjectHandle();
@@ -115,6 +142,19 @@ public:
   ezUInt32 GetRootObjectCount() const;
   ezUInt32 GetChildObjectCount() const;
 
+  /// \brief The time spent in the individual phases of the last completed instantiation.
+  struct InstantiationStats
+  {
+    ezTime m_CreateObjects;
+    ezTime m_CreateComponents;
+    ezTime m_DeserializeComponents;
+    ezTime m_InitComponents; ///< For time sliced instantiation this includes the time until the init batch is completed.
+    bool m_bParallelDeserialization = false;
+  };
+
+  /// \brief Returns the phase timings of the last instantiation that ran to completion.
+  const InstantiationStats& GetLastInstantiationStats() const { return m_LastInstantiationStats; }
+
 private:
   struct GameObjectToCreate
   {
@@ -126,7 +166,13 @@ private:
   void ReadGameObjectDesc(GameObjectToCreate& godesc);
   void ReadComponentTypeInfo(ezUInt32 uiComponentTypeIdx);
   void ReadComponentDataToMemStream();
+  void DecodeComponentCreationData(ezMemoryStreamStorage& storage);
+  void ResolveComponentManagers();
   void ClearHandles();
+  void DeserializeComponentsOfType(ezUInt32 uiComponentTypeIdx, ezUInt32 uiNumInstances);
+  void DeserializeComponentsParallel(ezUInt32 uiNumInstances);
+  ezUInt32 GetCurrentInstanceIndex() const;
+  ezUInt32 GetObjectHandleStride() const { return m_RootObjectsToCreate.GetCount() + m_ChildObjectsToCreate.GetCount() + 1; }
   ezUniquePtr<InstantiationContextBase> Instantiate(ezWorld& world, bool bUseTransform, const ezTransform& rootTransform, ezGameObjectHandle hParent,
     ezHybridArray<ezGameObject*, 8>* out_CreatedRootObjects, ezHybridArray<ezGameObject*, 8>* out_CreatedChildObjects,
     const ezUInt16* pOverrideTeamID, bool bForceDynamic, ezTime maxStepTime, ezProgress* pProgress);
@@ -139,19 +185,36 @@ private:
 
   ezDynamicArray<GameObjectToCreate> m_RootObjectsToCreate;
   ezDynamicArray<GameObjectToCreate> m_ChildObjectsToCreate;
+  ezDynamicArray<ezTransform> m_RootObjectLocalTransforms; ///< Built on first use by InstantiatePrefabs()
 
   struct ComponentTypeInfo
   {
     const ezRTTI* m_pRtti = nullptr;
-    ezDynamicArray<ezComponentHandle> m_ComponentIndexToHandle;
+    ezComponentManagerBase* m_pManager = nullptr; ///< Only valid for m_pWorld during instantiation.
+    ezDynamicArray<ezComponentHandle> m_ComponentIndexToHandle; ///< m_uiNumComponents + 1 entries per instance, the first one of each instance is invalid
     ezUInt32 m_uiNumComponents = 0;
+    ezUInt32 m_uiFirstComponentToCreate = 0; ///< Index into m_ComponentsToCreate
+    ezUInt32 m_uiDataOffset = 0;             ///< Start of the serialized component data of this type in m_ComponentDataStream
+    ezUInt32 m_uiDataSize = 0;
+    bool m_bDeserializeInParallel = false;
   };
 
+  /// The component creation data, decoded once in ReadWorldDescription() so that every instantiation can replay it without stream reads.
+  struct ComponentToCreate
+  {
+    ezUInt32 m_uiOwnerObjectIdx = 0;
+    bool m_bActive = true;
+    ezUInt8 m_uiUserFlags = 0;
+  };
+
+  static ezComponentHandle CreateComponent(ezComponentManagerBase* pManager, ezGameObject* pOwnerObject, const ComponentToCreate& componentToCreate);
+
   ezDynamicArray<ComponentTypeInfo> m_ComponentTypes;
   ezHashTable<const ezRTTI*, ezUInt32> m_ComponentTypeVersions;
-  ezMemoryStreamStorage m_ComponentCreationStream;
+  ezDynamicArray<ComponentToCreate> m_ComponentsToCreate;
   ezMemoryStreamStorage m_ComponentDataStream;
   ezUInt64 m_uiTotalNumComponents = 0;
+  InstantiationStats m_LastInstantiationStats;
 
   ezUniquePtr<ezStringDeduplicationReadContext> m_pStringDedupReadContext;
 
@@ -175,7 +238,25 @@ private:
     bool AddComponentsToBatch(ezTime endTime);
 
   private:
+    struct Phase
+    {
+      enum Enum
+      {
+        Invalid = -1,
+        CreateRootObjects,
+        CreateChildObjects,
+        CreateComponents,
+        DeserializeComponents,
+        AddComponentsToBatch,
+        InitComponents,
+
+        Count
+      };
+    };
+
+    void BeginNextPhase(Phase::Enum phase, const char* szName);
     void BeginNextProgressStep(const char* szName);
+    void ReportPhaseDurations();
     void SetSubProgressCompletion(double fCompletion);
 
     friend class ezWorldReader;
@@ -192,23 +273,10 @@ private:
     ezComponentInitBatchHandle m_hComponentInitBatch;
 
     // Current state
-    struct Phase
-    {
-      enum Enum
-      {
-        Invalid = -1,
-        CreateRootObjects,
-        CreateChildObjects,
-        CreateComponents,
-        DeserializeComponents,
-        AddComponentsToBatch,
-        InitComponents,
-
-        Count
-      };
-    };
-
     Phase::Enum m_Phase = Phase::Invalid;
+    bool m_bParallelDeserialization = false;
+    ezTime m_PhaseStartTime;
+    ezTime m_PhaseDurations[Phase::Count];
     ezUInt32 m_uiCurrentIndex = 0; // object or component
     ezUInt32 m_uiCurrentComponentTypeIndex = 0;
     ezUInt64 m_uiCurrentNumComponentsProcessed = 0;
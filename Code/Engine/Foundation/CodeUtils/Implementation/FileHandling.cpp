@@ -11,6 +11,12 @@ ezMap<ezString, ezTokenizedFileCache::FileData>::ConstIterator ezTokenizedFileCa
 {
   EZ_LOCK(m_Mutex);
   auto it = m_Cache.Find(sFileName);
+
+  if (it.IsValid())
+    ++m_uiCacheHits;
+  else
+    ++m_uiCacheMisses;
+
   return it;
 }
 
@@ -26,6 +32,18 @@ void ezTokenizedFileCache::Clear()
   m_Cache.Clear();
 }
 
+ezUInt32 ezTokenizedFileCache::GetNumCacheHits() const
+{
+  EZ_LOCK(m_Mutex);
+  return m_uiCacheHits;
+}
+
+ezUInt32 ezTokenizedFileCache::GetNumCacheMisses() const
+{
+  EZ_LOCK(m_Mutex);
+  return m_uiCacheMisses;
+}
+
 void ezTokenizedFileCache::SkipWhitespace(ezDeque<ezToken>& Tokens, ezUInt32& uiCurToken)
 {
   while (uiCurToken < Tokens.GetCount() && (Tokens[uiCurToken].m_iType == ezTokenType::BlockComment || Tokens[uiCurToken].m_iType == ezTokenType::LineComment || Tokens[uiCurToken].m_iType == ezTokenType::Newline || Tokens[uiCurToken].m_iType == ezTokenType::Whitespace))
@@ -36,7 +54,14 @@ const ezTokenizer* ezTokenizedFileCache::Tokenize(const ezString& sFileName, ezA
 {
   EZ_LOCK(m_Mutex);
 
-  auto& data = m_Cache[sFileName];
+  bool bExisted = false;
+  auto it = m_Cache.FindOrAdd(sFileName, &bExisted);
+
+  // another preprocessor tokenized the same file while this one was reading it
+  if (bExisted && it.Value().m_Timestamp.Compare(FileTimeStamp, ezTimestamp::CompareMode::Identical))
+    return &it.Value().m_Tokens;
+
+  auto& data = it.Value();
 
   data.m_Timestamp = FileTimeStamp;
   ezTokenizer* pTokenizer = &data.m_Tokens;
@@ -12,6 +12,8 @@
 
 /// \brief This object caches files in a tokenized state. It can be shared among ezPreprocessor instances to improve performance when
 /// they access the same files.
+///
+/// All functions are thread-safe, so one cache can also be shared by preprocessors that run concurrently.
 class EZ_FOUNDATION_DLL ezTokenizedFileCache
 {
 public:
@@ -34,13 +36,24 @@ public:
   ///
   //// The file content is tokenized first and all #line directives are evaluated, to update the line number and file origin for each token.
   /// Any errors are written to the given log.
+  ///
+  /// If another thread already stored the same file with the same timestamp in the meantime, the existing data is returned instead, because
+  /// other preprocessors may already reference its tokens.
   const ezTokenizer* Tokenize(const ezString& sFileName, ezArrayPtr<const ezUInt8> FileContent, const ezTimestamp& FileTimeStamp, ezLogInterface* pLog);
 
+  /// \brief Returns how many lookups found the file in the cache.
+  ezUInt32 GetNumCacheHits() const;
+
+  /// \brief Returns how many lookups did not find the file in the cache, i.e. how often a file had to be read and tokenized.
+  ezUInt32 GetNumCacheMisses() const;
+
 private:
   void SkipWhitespace(ezDeque<ezToken>& Tokens, ezUInt32& uiCurToken);
 
   mutable ezMutex m_Mutex;
   ezMap<ezString, FileData> m_Cache;
+  mutable ezUInt32 m_uiCacheHits = 0;
+  mutable ezUInt32 m_uiCacheMisses = 0;
 };
 
 /// \brief ezPreprocessor implements a standard C preprocessor. It can be used to pre-process files to get the output after macro expansion and #ifdef
@@ -165,6 +178,9 @@ public:
   /// Files #included in "" will be appended as relative paths to the path of the file they appeared in.
   void SetFileLocatorFunction(FileLocatorCB LocateAbsFileCB);
 
+  /// \brief The default file locator. Custom file locators can forward to it, e.g. when they only want to observe which files are included.
+  static ezResult DefaultFileLocator(const char* szCurAbsoluteFile, const char* szIncludeFile, ezPreprocessor::IncludeType IncType, ezStringBuilder& out_sAbsoluteFilePath);
+
   /// \brief Adds a #define to the preprocessor, even before any file is processed.
   ///
   /// This allows to have global macros that are always defined for all processed files, such as the current platform etc.
@@ -257,7 +273,6 @@ private:
 
 private: // *** File Handling ***
   ezResult OpenFile(const char* szFile, const ezTokenizer** pTokenizer);
-  static ezResult DefaultFileLocator(const char* szCurAbsoluteFile, const char* szIncludeFile, ezPreprocessor::IncludeType IncType, ezStringBuilder& out_sAbsoluteFilePath);
   static ezResult DefaultFileOpen(const char* szAbsoluteFile, ezDynamicArray<ezUInt8>& FileContent, ezTimestamp& out_FileModification);
 
   FileOpenCB m_FileOpenCallback;
@@ -149,8 +149,13 @@ void ezIpcChannel::ReceiveMessageData(ezArrayPtr<const ezUInt8> data)
 
     // Read and verify header
     ezUInt32 uiMagic = *reinterpret_cast<const ezUInt32*>(m_MessageAccumulator.GetData());
-    EZ_IGNORE_UNUSED(uiMagic);
-    EZ_ASSERT_DEBUG(uiMagic == MAGIC_VALUE, "Message received with wrong magic value.");
+    if (uiMagic != MAGIC_VALUE)
+    {
+      // the other process was built with a different message format, nothing it sends can be read
+      ezLog::Error("Message received with wrong magic value.");
+      m_MessageAccumulator.Clear();
+      return;
+    }
     ezUInt32 uiMessageSize = *reinterpret_cast<const ezUInt32*>(m_MessageAccumulator.GetData() + 4);
     EZ_ASSERT_DEBUG(uiMessageSize < MAX_MESSAGE_SIZE, "Message too big: {0}! Either the stream got corrupted or you need to increase MAX_MESSAGE_SIZE.", uiMessageSize);
     if (uiMessageSize > remainingData.GetCount() + m_MessageAccumulator.GetCount())
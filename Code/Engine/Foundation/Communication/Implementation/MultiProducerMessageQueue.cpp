@@ -0,0 +1,64 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Communication/MultiProducerMessageQueue.h>
+#include <Foundation/Math/Math.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Mutex.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiNumTrackedIndices = 32;
+
+  ezMutex s_ProducerIndexMutex;
+  ezUInt32 s_uiUsedProducerIndices = 0;
+  ezUInt32 s_uiNextOverflowIndex = s_uiNumTrackedIndices;
+
+  /// Hands the index back when the thread exits, such that the next new thread gets a low index again.
+  struct ezProducerIndexOwner
+  {
+    ~ezProducerIndexOwner()
+    {
+      if (m_uiIndex < s_uiNumTrackedIndices)
+      {
+        EZ_LOCK(s_ProducerIndexMutex);
+        s_uiUsedProducerIndices &= ~(1u << m_uiIndex);
+      }
+    }
+
+    ezUInt32 m_uiIndex = ezInvalidIndex;
+  };
+
+  thread_local ezProducerIndexOwner tl_ProducerIndex;
+
+  ezUInt32 AcquireProducerIndex()
+  {
+    EZ_LOCK(s_ProducerIndexMutex);
+
+    ezUInt32 uiIndex;
+    if (s_uiUsedProducerIndices != 0xFFFFFFFF)
+    {
+      uiIndex = ezMath::FirstBitLow(~s_uiUsedProducerIndices);
+      s_uiUsedProducerIndices |= 1u << uiIndex;
+    }
+    else
+    {
+      // more threads than tracked indices, these will share slots with other threads
+      uiIndex = s_uiNextOverflowIndex++;
+    }
+
+    tl_ProducerIndex.m_uiIndex = uiIndex;
+    return uiIndex;
+  }
+} // namespace
+
+// static
+ezUInt32 ezInternal::ezMessageQueueProducerIndex::GetForCurrentThread()
+{
+  const ezUInt32 uiIndex = tl_ProducerIndex.m_uiIndex;
+  if (uiIndex != ezInvalidIndex)
+    return uiIndex;
+
+  return AcquireProducerIndex();
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Communication_Implementation_MultiProducerMessageQueue);
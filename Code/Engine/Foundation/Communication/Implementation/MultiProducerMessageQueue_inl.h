@@ -0,0 +1,172 @@
+
+template <typename MD, typename A>
+ezMultiProducerMessageQueue<MD, A>::ezMultiProducerMessageQueue()
+  : m_pAllocator(A::GetAllocator())
+  , m_Queue(A::GetAllocator())
+{
+}
+
+template <typename MD, typename A>
+ezMultiProducerMessageQueue<MD, A>::ezMultiProducerMessageQueue(ezAllocatorBase* pAllocator)
+  : m_pAllocator(pAllocator)
+  , m_Queue(pAllocator)
+{
+}
+
+template <typename MD, typename A>
+ezMultiProducerMessageQueue<MD, A>::~ezMultiProducerMessageQueue()
+{
+  Clear();
+
+  for (ProducerSlot& slot : m_Slots)
+  {
+    ResetSlot(slot);
+    EZ_DELETE(m_pAllocator, slot.m_pFirstChunk);
+  }
+}
+
+template <typename MD, typename A>
+void ezMultiProducerMessageQueue<MD, A>::Enqueue(ezMessage* pMessage, const MD& metaData)
+{
+  ProducerSlot& slot = m_Slots[ezInternal::ezMessageQueueProducerIndex::GetForCurrentThread() % MaxProducerSlots];
+
+  LockSlot(slot);
+
+  Chunk* pChunk = slot.m_pLastChunk;
+  if (pChunk == nullptr || pChunk->m_uiCount == EntriesPerChunk)
+  {
+    Chunk* pNewChunk = EZ_NEW(m_pAllocator, Chunk);
+
+    if (pChunk != nullptr)
+    {
+      pChunk->m_pNext = pNewChunk;
+    }
+    else
+    {
+      slot.m_pFirstChunk = pNewChunk;
+    }
+
+    slot.m_pLastChunk = pNewChunk;
+    pChunk = pNewChunk;
+  }
+
+  Entry& entry = pChunk->m_Entries[pChunk->m_uiCount];
+  entry.m_pMessage = pMessage;
+  entry.m_MetaData = metaData;
+  entry.m_uiMessageHash = 0;
+
+  ++pChunk->m_uiCount;
+
+  UnlockSlot(slot);
+}
+
+template <typename MD, typename A>
+bool ezMultiProducerMessageQueue<MD, A>::Merge()
+{
+  const ezUInt32 uiOldCount = m_Queue.GetCount();
+
+  for (ProducerSlot& slot : m_Slots)
+  {
+    LockSlot(slot);
+
+    for (const Chunk* pChunk = slot.m_pFirstChunk; pChunk != nullptr; pChunk = pChunk->m_pNext)
+    {
+      for (ezUInt32 i = 0; i < pChunk->m_uiCount; ++i)
+      {
+        m_Queue.PushBack(pChunk->m_Entries[i]);
+      }
+    }
+
+    ResetSlot(slot);
+
+    UnlockSlot(slot);
+  }
+
+  return m_Queue.GetCount() != uiOldCount;
+}
+
+template <typename MD, typename A>
+EZ_ALWAYS_INLINE typename ezMultiProducerMessageQueue<MD, A>::Entry& ezMultiProducerMessageQueue<MD, A>::operator[](ezUInt32 uiIndex)
+{
+  return m_Queue[uiIndex];
+}
+
+template <typename MD, typename A>
+EZ_ALWAYS_INLINE const typename ezMultiProducerMessageQueue<MD, A>::Entry& ezMultiProducerMessageQueue<MD, A>::operator[](ezUInt32 uiIndex) const
+{
+  return m_Queue[uiIndex];
+}
+
+template <typename MD, typename A>
+EZ_ALWAYS_INLINE ezUInt32 ezMultiProducerMessageQueue<MD, A>::GetCount() const
+{
+  return m_Queue.GetCount();
+}
+
+template <typename MD, typename A>
+EZ_ALWAYS_INLINE bool ezMultiProducerMessageQueue<MD, A>::IsEmpty() const
+{
+  return m_Queue.IsEmpty();
+}
+
+template <typename MD, typename A>
+void ezMultiProducerMessageQueue<MD, A>::Clear()
+{
+  m_Queue.Clear();
+}
+
+template <typename MD, typename A>
+EZ_ALWAYS_INLINE typename ezMultiProducerMessageQueue<MD, A>::Entry& ezMultiProducerMessageQueue<MD, A>::Peek()
+{
+  return m_Queue.PeekFront();
+}
+
+template <typename MD, typename A>
+EZ_ALWAYS_INLINE void ezMultiProducerMessageQueue<MD, A>::Dequeue()
+{
+  m_Queue.PopFront();
+}
+
+template <typename MD, typename A>
+template <typename Comparer>
+EZ_ALWAYS_INLINE void ezMultiProducerMessageQueue<MD, A>::Sort(const Comparer& comparer)
+{
+  m_Queue.Sort(comparer);
+}
+
+template <typename MD, typename A>
+EZ_FORCE_INLINE void ezMultiProducerMessageQueue<MD, A>::LockSlot(ProducerSlot& slot)
+{
+  // only contended while the queue is merged or if more than MaxProducerSlots threads enqueue at the same time
+  while (!slot.m_iLock.TestAndSet(0, 1))
+  {
+    ezThreadUtils::YieldHardwareThread();
+  }
+}
+
+template <typename MD, typename A>
+EZ_FORCE_INLINE void ezMultiProducerMessageQueue<MD, A>::UnlockSlot(ProducerSlot& slot)
+{
+  // unlike Set(), this is a full barrier on all platforms, so the entries are visible before the slot is unlocked
+  slot.m_iLock.TestAndSet(1, 0);
+}
+
+template <typename MD, typename A>
+void ezMultiProducerMessageQueue<MD, A>::ResetSlot(ProducerSlot& slot)
+{
+  Chunk* pFirstChunk = slot.m_pFirstChunk;
+  if (pFirstChunk == nullptr)
+    return;
+
+  Chunk* pChunk = pFirstChunk->m_pNext;
+  while (pChunk != nullptr)
+  {
+    Chunk* pNextChunk = pChunk->m_pNext;
+    EZ_DELETE(m_pAllocator, pChunk);
+    pChunk = pNextChunk;
+  }
+
+  pFirstChunk->m_pNext = nullptr;
+  pFirstChunk->m_uiCount = 0;
+  slot.m_pLastChunk = pFirstChunk;
+}
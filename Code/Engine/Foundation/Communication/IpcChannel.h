@@ -104,7 +104,7 @@ protected:
   enum Constants : ezUInt32
   {
     HEADER_SIZE = 8,                     ///< Magic value and size ezUint32
-    MAGIC_VALUE = 'USED',                ///< Magic value
+    MAGIC_VALUE = 'USE2',                ///< Magic value, changed whenever the serialized message format changes
     MAX_MESSAGE_SIZE = 1024 * 1024 * 16, ///< Arbitrary message size limit
   };
 
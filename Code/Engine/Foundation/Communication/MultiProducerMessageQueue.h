@@ -0,0 +1,110 @@
+#pragma once
+
+#include <Foundation/Communication/MessageQueue.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+namespace ezInternal
+{
+  struct EZ_FOUNDATION_DLL ezMessageQueueProducerIndex
+  {
+    /// \brief Returns a small index that is unique among all running threads. The indices of exited threads are reused.
+    static ezUInt32 GetForCurrentThread();
+  };
+} // namespace ezInternal
+
+/// \brief Message queue that many threads can enqueue to at the same time without contending on a shared mutex.
+///
+/// Every thread appends its entries to chunks in its own producer slot. The slot is guarded by a spin lock that is only taken by
+/// this thread, except while Merge() moves the pending entries of all slots into a deque. All other methods only see merged
+/// entries and are not thread safe, just like the corresponding methods of ezMessageQueueBase.
+/// Only the first chunk of each slot is kept after a merge, so the memory on the producer side is bounded by MaxProducerSlots chunks.
+/// The order of the entries after a merge depends on thread timing, sort the queue to get a deterministic order.
+/// Lifetime of the enqueued messages needs to be managed by the user.
+/// \see ezMessageQueue
+template <typename MetaDataType, typename AllocatorWrapper = ezDefaultAllocatorWrapper>
+class ezMultiProducerMessageQueue
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezMultiProducerMessageQueue);
+
+public:
+  typedef typename ezMessageQueueBase<MetaDataType>::Entry Entry;
+
+  enum
+  {
+    MaxProducerSlots = 32, ///< Threads with a higher producer index share slots.
+    EntriesPerChunk = 128
+  };
+
+  /// \brief No memory is allocated during construction.
+  ezMultiProducerMessageQueue();
+
+  /// \brief No memory is allocated during construction.
+  ezMultiProducerMessageQueue(ezAllocatorBase* pAllocator);
+
+  /// \brief Destructor.
+  ~ezMultiProducerMessageQueue();
+
+  /// \brief Enqueues the given message and meta-data. This method is thread safe.
+  void Enqueue(ezMessage* pMessage, const MetaDataType& metaData); // [tested]
+
+  /// \brief Appends all entries that were enqueued since the last merge to the queue. Returns true if there were any.
+  ///
+  /// This method is thread safe with respect to Enqueue, but must not be called concurrently with any of the other methods.
+  bool Merge(); // [tested]
+
+  /// \brief Returns the merged element at the given index. Not thread safe.
+  Entry& operator[](ezUInt32 uiIndex); // [tested]
+
+  /// \brief Returns the merged element at the given index. Not thread safe.
+  const Entry& operator[](ezUInt32 uiIndex) const;
+
+  /// \brief Returns the number of merged elements in the queue.
+  ezUInt32 GetCount() const; // [tested]
+
+  /// \brief Returns true, if the queue does not contain any merged elements.
+  bool IsEmpty() const;
+
+  /// \brief Removes all merged elements. Elements that were enqueued after the last merge are kept. Does not deallocate any data.
+  void Clear();
+
+  /// \brief Returns the first merged element in the queue. Not thread safe.
+  Entry& Peek();
+
+  /// \brief Removes the first merged element from the queue. Not thread safe.
+  void Dequeue();
+
+  /// \brief Sorts the merged elements with explicit comparer. Not thread safe.
+  template <typename Comparer>
+  void Sort(const Comparer& comparer); // [tested]
+
+private:
+  struct Chunk
+  {
+    Chunk* m_pNext = nullptr;
+    ezUInt32 m_uiCount = 0;
+    Entry m_Entries[EntriesPerChunk];
+  };
+
+  struct ProducerSlot
+  {
+    Chunk* m_pFirstChunk = nullptr;
+    Chunk* m_pLastChunk = nullptr;
+    ezAtomicInteger32 m_iLock;
+
+    // keeps the slots of different threads on separate cache lines, regardless of the alignment of the queue
+    ezUInt8 m_Padding[128 - 2 * sizeof(void*) - sizeof(ezAtomicInteger32)];
+  };
+
+  void LockSlot(ProducerSlot& slot);
+  void UnlockSlot(ProducerSlot& slot);
+
+  /// \brief Empties the first chunk of the slot and frees all others. The slot must be locked.
+  void ResetSlot(ProducerSlot& slot);
+
+  ezAllocatorBase* m_pAllocator;
+  ezDeque<Entry, ezNullAllocatorWrapper> m_Queue;
+  ProducerSlot m_Slots[MaxProducerSlots];
+};
+
+#include <Foundation/Communication/Implementation/MultiProducerMessageQueue_inl.h>
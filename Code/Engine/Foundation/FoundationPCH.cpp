@@ -41,6 +41,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_Message);
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_MessageLoop);
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_Mobile_MessageLoop_mobile);
+  EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_MultiProducerMessageQueue);
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_RemoteInterface);
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_RemoteInterfaceEnet);
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_RemoteMessage);
@@ -70,6 +71,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_IO_FileSystem_Implementation_FileReader);
   EZ_STATICLINK_REFERENCE(Foundation_IO_FileSystem_Implementation_FileSystem);
   EZ_STATICLINK_REFERENCE(Foundation_IO_FileSystem_Implementation_FileWriter);
+  EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_AsyncFileReader);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_ChunkStream);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_CompressedStreamZlib);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_CompressedStreamZstd);
@@ -77,6 +79,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_DependencyFile);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_DirectoryWatcher);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_JSONParser);
+  EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_JSONPullParser);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_JSONReader);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_JSONWriter);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_MemoryMappedFile);
@@ -112,6 +115,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Implementation_MemoryUtils);
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Implementation_PageAllocator);
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Policies_GuardedAllocation);
+  EZ_STATICLINK_REFERENCE(Foundation_Memory_Policies_ThreadCachingHeapAllocation);
   EZ_STATICLINK_REFERENCE(Foundation_Profiling_Implementation_Profiling);
   EZ_STATICLINK_REFERENCE(Foundation_Reflection_Implementation_PropertyAttributes);
   EZ_STATICLINK_REFERENCE(Foundation_Reflection_Implementation_PropertyPath);
@@ -180,6 +184,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_ConversionUtils);
   EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_DGMLWriter);
   EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_GraphicsUtils);
+  EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_Metrics);
   EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_Progress);
   EZ_STATICLINK_REFERENCE(Foundation_Utilities_Implementation_Stats);
 }
@@ -68,6 +68,7 @@ namespace ezDataDirectory
 
     virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
     virtual ezUInt64 GetFileSize() const override;
+    virtual bool GetRemainingContiguousData(ezArrayPtr<const ezUInt8>& out_Data) const override;
 
   protected:
     virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
@@ -90,6 +91,7 @@ namespace ezDataDirectory
     ~ArchiveReaderZstd();
 
     virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
+    virtual bool GetRemainingContiguousData(ezArrayPtr<const ezUInt8>& out_Data) const override { return false; }
 
   protected:
     virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
@@ -110,6 +112,7 @@ namespace ezDataDirectory
     ~ArchiveReaderZip();
 
     virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
+    virtual bool GetRemainingContiguousData(ezArrayPtr<const ezUInt8>& out_Data) const override { return false; }
 
   protected:
     virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
@@ -267,6 +267,12 @@ ezUInt64 ezDataDirectory::ArchiveReaderUncompressed::Read(void* pBuffer, ezUInt6
   return m_MemStreamReader.ReadBytes(pBuffer, uiBytes);
 }
 
+bool ezDataDirectory::ArchiveReaderUncompressed::GetRemainingContiguousData(ezArrayPtr<const ezUInt8>& out_Data) const
+{
+  // the archive is memory mapped, uncompressed entries can be accessed in place
+  return m_MemStreamReader.GetRemainingContiguousData(out_Data);
+}
+
 ezUInt64 ezDataDirectory::ArchiveReaderUncompressed::GetFileSize() const
 {
   return m_uiUncompressedSize;
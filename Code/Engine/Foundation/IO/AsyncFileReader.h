@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Strings/String.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Timestamp.h>
+#include <Foundation/Types/Delegate.h>
+
+/// \brief Describes one file that is read by ezAsyncFileReader and receives the result.
+struct EZ_FOUNDATION_DLL ezAsyncFileRead
+{
+  /// \brief The file to read. Relative, rooted and absolute paths are resolved through ezFileSystem.
+  ezString m_sFile;
+
+  /// \brief Called as soon as this file was read or failed to be read. Executed on a task system worker thread.
+  ///
+  /// Each callback runs on its own task, so callbacks of different files may run in parallel and don't delay the remaining reads.
+  ezDelegate<void(ezAsyncFileRead&)> m_OnFinished;
+
+  /// \brief Custom data for m_OnFinished.
+  void* m_pUserData = nullptr;
+
+  /// \brief Files that are larger than this are not read, see m_bExceededMaxFileSize. Files larger than 4 GB are never read.
+  ezUInt64 m_uiMaxFileSize = ezMath::MaxValue<ezUInt32>();
+
+  /// \brief Whether the file was read successfully. Only valid once the read is finished.
+  ezResult m_Result = EZ_FAILURE;
+
+  /// \brief Set, if the file exists, but was not read because it is larger than m_uiMaxFileSize. m_Result is EZ_FAILURE in this case.
+  bool m_bExceededMaxFileSize = false;
+
+  /// \brief The absolute path of the file that was read.
+  ezString m_sAbsolutePath;
+
+  /// \brief The path of the file relative to the data directory that it was found in, same as ezFileSystem::ResolvePath() would return.
+  ezString m_sDataDirRelativePath;
+
+  /// \brief The modification time of the file. Invalid on platforms that don't support file stats.
+  ezTimestamp m_LastModificationTime;
+
+  /// \brief The entire content of the file.
+  ezDynamicArray<ezUInt8> m_Data;
+};
+
+/// \brief Reads many files at once in the background.
+///
+/// On Linux the reads are submitted through io_uring, such that many of them are in flight at the same time, while a single task waits for
+/// them to complete. On other platforms, or when io_uring is not available, the files are read in parallel by several long running tasks.
+/// Files that can't be opened directly by the OS, e.g. files inside archive data directories, are always read through ezFileReader.
+class EZ_FOUNDATION_DLL ezAsyncFileReader
+{
+public:
+  /// \brief Starts reading all files in \a requests. The array must stay valid until the returned task group is finished.
+  ///
+  /// The task group finishes once all files were read and all ezAsyncFileRead::m_OnFinished callbacks have returned.
+  static ezTaskGroupID ReadFiles(ezArrayPtr<ezAsyncFileRead> requests, ezOnTaskGroupFinishedCallback onAllFinished = ezOnTaskGroupFinishedCallback());
+
+  /// \brief Returns whether an asynchronous API of the OS (i.e. io_uring) is used for reading files.
+  static bool IsUsingNativeAsyncIO();
+
+  /// \brief Allows to disable the asynchronous API of the OS and always read through the task system, e.g. to compare performance.
+  static void SetNativeAsyncIOEnabled(bool bEnable);
+};
@@ -74,8 +74,15 @@ public:
   /// \note There might be multiple changes on the same file reported.
   void EnumerateChanges(EnumerateChangesFunction func);
 
+  /// \brief
+  ///   Returns true, if the last call to EnumerateChanges() could not report all changes, e.g. because the event queue of the OS overflowed.
+  ///
+  /// The caller then has to rescan the watched directory itself. Changes that happen afterwards are reported again.
+  bool HasMissedChanges() const { return m_bMissedChanges; }
+
 private:
   ezString m_sDirectoryPath;
+  bool m_bMissedChanges = false;
   ezDirectoryWatcherImpl* m_pImpl = nullptr;
 };
 
@@ -2,9 +2,12 @@
 
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Containers/Map.h>
+#include <Foundation/IO/DirectoryWatcher.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/Implementation/DataDirType.h>
+#include <Foundation/IO/MemoryMappedFile.h>
 #include <Foundation/IO/OSFile.h>
+#include <Foundation/Types/UniquePtr.h>
 
 namespace ezDataDirectory
 {
@@ -34,11 +37,43 @@ namespace ezDataDirectory
     /// access.
     static ezString s_sRedirectionPrefix;
 
+    /// If enabled, folder data directories that are mounted afterwards build an index of all the files and folders they contain.
+    ///
+    /// The index is shared by all data directories and maps every relative path to the data directories that contain it, so ezFileSystem
+    /// finds the data directory that owns a file with a single lookup instead of asking every mounted data directory, and without locking
+    /// the file system mutex. Changes made through the file system are applied to the index directly, all other
+    /// changes (e.g. by other processes) are picked up through an ezDirectoryWatcher.
+    /// Paths that leave the data directory (starting with '../') and absolute paths are not covered by the index and looked up on disk as usual.
+    /// On platforms without file iterators or without a working directory watcher this setting is ignored.
+    static bool s_bEnableFileIndex;
+
+    /// If enabled, files that are opened for reading afterwards are memory mapped, unless they are small or opened for exclusive access.
+    ///
+    /// ezFileReader then reads directly from the mapping instead of through its cache and exposes the data through
+    /// ezStreamReader::GetRemainingContiguousData(), such that it can be parsed in place. Files must not be truncated by other processes while
+    /// they are mapped. On platforms without memory mapped files this setting is ignored.
+    static bool s_bMemoryMapFiles;
+
+    /// \brief Returns whether a file of the given size gets memory mapped when it is opened for shared reading. See s_bMemoryMapFiles.
+    static bool IsMemoryMappedFileSize(ezUInt64 uiFileSize);
+
+    /// \brief Returns the size from which on files get memory mapped, or ezMath::MaxValue<ezUInt64>() if no files get memory mapped.
+    static ezUInt64 GetMinMemoryMappedFileSize();
+
     /// \brief When s_sRedirectionFile and s_sRedirectionPrefix are used to enable file redirection, this will reload those config files.
     virtual void ReloadExternalConfigs() override;
 
     virtual const ezString128& GetRedirectedDataDirectoryPath() const override { return m_sRedirectedDataDirPath; }
 
+    /// \brief Returns whether this data directory keeps an index of its files. See s_bEnableFileIndex.
+    bool HasFileIndex() const { return m_pFileIndexWatcher != nullptr; }
+
+    /// \brief Looks up which indexed data directories contain the given relative file or folder path.
+    ///
+    /// Returns false if the index can't answer this, because no data directory is indexed or the path is absolute or leaves the data directory.
+    /// Otherwise \a out_DataDirs contains all indexed data directories that contain the path, which may be none.
+    static bool FindInFileIndex(ezStringView sFile, ezHybridArray<const ezDataDirectoryType*, 4>& out_DataDirs);
+
   protected:
     // The implementations of the abstract functions.
 
@@ -50,6 +85,7 @@ namespace ezDataDirectory
     virtual void DeleteFile(const char* szFile) override;
     virtual bool ExistsFile(const char* szFile, bool bOneSpecificDataDir) override;
     virtual ezResult GetFileStats(const char* szFileOrFolder, bool bOneSpecificDataDir, ezFileStats& out_Stats) override;
+    virtual bool IsFileIndexed() const override;
     virtual FolderReader* CreateFolderReader() const;
     virtual FolderWriter* CreateFolderWriter() const;
 
@@ -61,6 +97,19 @@ namespace ezDataDirectory
 
     void LoadRedirectionFile();
 
+    /// \brief Returns false if the file index is active and does not contain the given file or folder. Returns true otherwise.
+    ///
+    /// Misses are cached, the directory watchers are only polled again for the same file after a short delay.
+    bool MightContainFile(const char* szFile);
+
+    void BuildFileIndex();
+    void UpdateFileIndex();
+    ezUInt32 AddToFileIndex(const char* szRelativePath, bool bScanFolder);
+    void RemoveFromFileIndex(const char* szRelativePath);
+    void ClearFileIndex();
+    static bool NormalizeFileIndexPath(ezStringBuilder& sPath);
+    static const ezHybridArray<FolderType*, 2>* LookupFileIndex(const ezStringBuilder& sPath, const FolderType* pDataDir);
+
     mutable ezMutex m_ReaderWriterMutex; ///< Locks m_Readers / m_Writers as well as the m_bIsInUse flag of each reader / writer.
     ezHybridArray<ezDataDirectory::FolderReader*, 4> m_Readers;
     ezHybridArray<ezDataDirectory::FolderWriter*, 4> m_Writers;
@@ -68,6 +117,9 @@ namespace ezDataDirectory
     mutable ezMutex m_RedirectionMutex;
     ezMap<ezString, ezString> m_FileRedirection;
     ezString128 m_sRedirectedDataDirPath;
+
+    ezUniquePtr<ezDirectoryWatcher> m_pFileIndexWatcher; ///< Only polled while the global file index is locked.
+    bool m_bHasRedirections = false;                      ///< Redirected files are not in the index under the name they are opened with.
   };
 
 
@@ -85,15 +137,22 @@ namespace ezDataDirectory
 
     virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
     virtual ezUInt64 GetFileSize() const override;
+    virtual bool GetRemainingContiguousData(ezArrayPtr<const ezUInt8>& out_Data) const override;
+    virtual void ReleaseContiguousData() override;
+    virtual const ezOSFile* GetOSFile() const override { return &m_File; }
 
   protected:
     virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
     virtual void InternalClose() override;
 
+    bool IsMapped() const { return m_MappedFile.GetMode() != ezMemoryMappedFile::Mode::None; }
+
     friend class FolderType;
 
     bool m_bIsInUse;
     ezOSFile m_File;
+    ezMemoryMappedFile m_MappedFile; ///< Only used when FolderType::s_bMemoryMapFiles is enabled.
+    ezUInt64 m_uiMappedReadPosition = 0;
   };
 
   /// \brief Handles writing to ordinary files.
@@ -7,6 +7,9 @@
 /// \brief The default class to use to read data from a file, implements the ezStreamReader interface.
 ///
 /// This file reader buffers reads up to a certain amount of bytes (configurable).
+/// If the data directory keeps the whole file in memory (e.g. memory mapped, see ezDataDirectory::FolderType::s_bMemoryMapFiles), no cache
+/// is allocated and all reads are served from that memory directly, which can also be accessed through GetRemainingContiguousData().
+/// Unless GetRemainingContiguousData() was used, that memory is released as soon as the file was read to the end.
 /// It closes the file automatically once it goes out of scope.
 class EZ_FOUNDATION_DLL ezFileReader : public ezFileReaderBase
 {
@@ -37,9 +40,23 @@ public:
   /// \brief Attempts to read the given number of bytes into the buffer. Returns the actual number of bytes read.
   virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override;
 
+  /// \brief Skips bytes without copying them, if the file is held in memory. Otherwise reads through the cache.
+  virtual ezUInt64 SkipBytes(ezUInt64 uiBytesToSkip) override;
+
+  /// \brief Returns the rest of the file, if the data directory keeps the file in memory. The memory stays valid until the reader is closed.
+  virtual bool GetRemainingContiguousData(ezArrayPtr<const ezUInt8>& out_Data) const override;
+
 private:
+  void ReleaseFileDataAtEnd();
+
   ezUInt64 m_uiBytesCached;
   ezUInt64 m_uiCacheReadPosition;
   ezDynamicArray<ezUInt8> m_Cache;
   bool m_bEOF;
+
+  /// If set, this is the whole file content and it is used instead of m_Cache. m_uiBytesCached is its size.
+  const ezUInt8* m_pFileData = nullptr;
+
+  /// Set once m_pFileData was handed out through GetRemainingContiguousData(), it then has to stay valid until Close().
+  mutable bool m_bFileDataReferenced = false;
 };
@@ -4,6 +4,7 @@
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Containers/Map.h>
 #include <Foundation/IO/FileSystem/Implementation/DataDirType.h>
+#include <Foundation/Threading/ConditionVariable.h>
 #include <Foundation/Threading/Mutex.h>
 
 /// \brief The ezFileSystem provides high-level functionality to manage files in a virtual file system.
@@ -35,6 +36,8 @@
 ///
 /// All operations that go through the ezFileSystem are protected by a mutex, which means that opening, closing, deleting
 /// files, as well as adding or removing data directories etc. will be synchronized and cannot happen in parallel.
+/// The exception are pure lookups (ExistsFile(), GetFileStats() and ResolvePath() with rooted or absolute paths), which only
+/// synchronize with adding and removing data directories and otherwise run in parallel.
 /// Reading/writing file streams can happen in parallel, only the administrative tasks need to be protected.
 /// File events are broadcast as they occur, that means they will be executed on whichever thread triggered them.
 /// Since they are executed from within the filesystem mutex, they cannot occur in parallel.
@@ -300,16 +303,38 @@ private:
 
     ezEvent<const FileEvent&, ezMutex> m_Event;
     ezMutex m_FsMutex;
+
+    ezConditionVariable m_DataDirLock; ///< Protects the following members and wakes up threads waiting for DataDirReadLock / DataDirWriteLock.
+    ezUInt32 m_uiDataDirReaders = 0;   ///< Number of DataDirReadLock's that are currently held.
+    ezUInt32 m_uiDataDirWriters = 0;   ///< Recursion depth of the DataDirWriteLock held by m_DataDirWriterThread.
+    ezThreadID m_DataDirWriterThread = {};
   };
 
+  /// \brief Shared lock for lookups in the data directories, which does not lock m_FsMutex.
+  ///
+  /// Waits while data directories are added or removed by another thread. Must not be held while locking m_FsMutex or adding
+  /// or removing data directories, as that would dead-lock with DataDirWriteLock.
+  class DataDirReadLock;
+
+  /// \brief Exclusive lock for adding and removing data directories. Locks m_FsMutex and waits until all DataDirReadLock's are released.
+  class DataDirWriteLock;
+
   /// \brief Returns a list of data directory categories that were embedded in the path.
   static const char* ExtractRootName(const char* szPath, ezString& rootName);
 
   /// \brief Returns the given path relative to its data directory. The path must be inside the given data directory.
+  ///
+  /// The caller must hold either m_FsMutex or a DataDirReadLock.
   static const char* GetDataDirRelativePath(const char* szPath, ezUInt32 uiDataDir);
 
+  /// \brief The caller must hold either m_FsMutex or a DataDirReadLock.
   static DataDirectory* GetDataDirForRoot(const ezString& sRoot);
 
+  /// \brief Returns true, if the global file index knows that the file is not inside the given data directory.
+  ///
+  /// \a indexedDataDirs is the result of ezDataDirectory::FolderType::FindInFileIndex(), \a bUseFileIndex its return value.
+  static bool IsExcludedByFileIndex(const ezDataDirectoryType* pDataDir, bool bUseFileIndex, const ezHybridArray<const ezDataDirectoryType*, 4>& indexedDataDirs);
+
   static void CleanUpRootName(ezStringBuilder& sRoot);
 
   static ezString s_sSdkRootDir;
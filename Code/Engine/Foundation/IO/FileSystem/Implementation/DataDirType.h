@@ -1,12 +1,14 @@
 #pragma once
 
 #include <Foundation/Basics.h>
+#include <Foundation/Types/ArrayPtr.h>
 #include <Foundation/IO/FileEnums.h>
 #include <Foundation/Strings/String.h>
 
 class ezDataDirectoryReaderWriterBase;
 class ezDataDirectoryReader;
 class ezDataDirectoryWriter;
+class ezOSFile;
 struct ezFileStats;
 
 /// \brief The base class for all data directory types.
@@ -82,6 +84,12 @@ protected:
   /// Called by ezFileSystem::ResolveAssetRedirection
   virtual bool ResolveAssetRedirection(const char* szPathOrAssetGuid, ezStringBuilder& out_sRedirection) { return false; }
 
+  /// \brief Returns true if this data directory is listed in the global file index of ezDataDirectory::FolderType for every file it contains.
+  ///
+  /// ezFileSystem then skips this data directory for all relative paths that the index doesn't list for it, without calling into it.
+  /// Data directories that return true must be safe to be accessed from multiple threads at the same time.
+  virtual bool IsFileIndexed() const { return false; }
+
 protected:
   friend class ezDataDirectoryReaderWriterBase;
 
@@ -163,6 +171,20 @@ public:
   }
 
   virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) = 0;
+
+  /// \brief Returns a view of the part of the file that has not been read yet, if the reader has it in memory, e.g. because the file is
+  /// memory mapped. Returns false otherwise.
+  ///
+  /// The view stays valid until the reader is closed or ReleaseContiguousData() is called. It does not change the read position.
+  virtual bool GetRemainingContiguousData(ezArrayPtr<const ezUInt8>& out_Data) const { return false; }
+
+  /// \brief Called once the memory returned by GetRemainingContiguousData() is not needed anymore, e.g. to unmap the file early. The file
+  /// is read to the end at that point.
+  virtual void ReleaseContiguousData() {}
+
+  /// \brief Returns the OS file that is read from, if this reader reads an ordinary file. Returns nullptr otherwise, e.g. for files inside of
+  /// archives.
+  virtual const ezOSFile* GetOSFile() const { return nullptr; }
 };
 
 /// \brief A base class for writers that handle writing to a (virtual) file inside a data directory.
@@ -1,8 +1,12 @@
 #include <FoundationPCH.h>
 
 #include <Foundation/Configuration/Startup.h>
+#include <Foundation/Containers/HashSet.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/IO/DirectoryWatcher.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Time/Time.h>
 
 // clang-format off
 EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, FolderDataDirectory)
@@ -21,20 +25,120 @@ EZ_END_SUBSYSTEM_DECLARATION;
 
 namespace ezDataDirectory
 {
+  namespace
+  {
+    /// The file index of all indexed data directories. A single table, so that a lookup through all data directories is one hash lookup.
+    struct GlobalFileIndex
+    {
+      ezMutex m_Mutex;
+      ezHashTable<ezString, ezHybridArray<FolderType*, 2>> m_Files; ///< Normalized relative path -> all indexed data directories that contain it
+      ezHashSet<ezString> m_MissingFiles;                           ///< Files that were looked up, but are not in the index. Cleared whenever something is added to the index.
+      ezHybridArray<FolderType*, 8> m_IndexedDirs;
+      ezTime m_LastUpdate;
+    };
+
+    GlobalFileIndex& GetGlobalFileIndex()
+    {
+      static GlobalFileIndex s_Index;
+      return s_Index;
+    }
+  } // namespace
+
   ezString FolderType::s_sRedirectionFile;
   ezString FolderType::s_sRedirectionPrefix;
+  bool FolderType::s_bEnableFileIndex = false;
+  bool FolderType::s_bMemoryMapFiles = false;
+
+  // for smaller files setting up the mapping costs more than reading them
+  static constexpr ezUInt64 s_uiMinMemoryMappedFileSize = 64 * 1024;
+
+  bool FolderType::IsMemoryMappedFileSize(ezUInt64 uiFileSize)
+  {
+    return uiFileSize >= GetMinMemoryMappedFileSize();
+  }
+
+  ezUInt64 FolderType::GetMinMemoryMappedFileSize()
+  {
+#if EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE)
+    if (s_bMemoryMapFiles)
+      return s_uiMinMemoryMappedFileSize;
+#endif
+
+    return ezMath::MaxValue<ezUInt64>();
+  }
 
   ezResult FolderReader::InternalOpen(ezFileShareMode::Enum FileShareMode)
   {
     ezStringBuilder sPath = ((ezDataDirectory::FolderType*)GetDataDirectory())->GetRedirectedDataDirectoryPath();
     sPath.AppendPath(GetFilePath().GetData());
 
-    return m_File.Open(sPath.GetData(), ezFileOpenMode::Read, FileShareMode);
+    if (m_File.Open(sPath.GetData(), ezFileOpenMode::Read, FileShareMode).Failed())
+      return EZ_FAILURE;
+
+#if EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE)
+    if (FileShareMode != ezFileShareMode::Exclusive && FolderType::IsMemoryMappedFileSize(m_File.GetFileSize()))
+    {
+      m_uiMappedReadPosition = 0;
+
+      // if mapping fails, the file is simply read through m_File
+      m_MappedFile.Open(sPath, ezMemoryMappedFile::Mode::ReadOnly).IgnoreResult();
+    }
+#endif
+
+    return EZ_SUCCESS;
   }
 
-  void FolderReader::InternalClose() { m_File.Close(); }
+  void FolderReader::InternalClose()
+  {
+    m_MappedFile.Close();
+    m_File.Close();
+  }
+
+  ezUInt64 FolderReader::Read(void* pBuffer, ezUInt64 uiBytes)
+  {
+    if (!IsMapped())
+      return m_File.Read(pBuffer, uiBytes);
+
+    const ezUInt64 uiBytesToCopy = ezMath::Min(uiBytes, m_MappedFile.GetFileSize() - m_uiMappedReadPosition);
+
+    if (uiBytesToCopy > 0)
+    {
+      ezMemoryUtils::Copy(static_cast<ezUInt8*>(pBuffer), static_cast<const ezUInt8*>(m_MappedFile.GetReadPointer(m_uiMappedReadPosition)), static_cast<size_t>(uiBytesToCopy));
+      m_uiMappedReadPosition += uiBytesToCopy;
+    }
+
+    return uiBytesToCopy;
+  }
+
+  void FolderReader::ReleaseContiguousData()
+  {
+    if (!IsMapped())
+      return;
+
+    m_MappedFile.Close();
+
+    // all further reads go through the file, which has to continue at the end
+    m_File.SetFilePosition(0, ezFileSeekMode::FromEnd);
+  }
+
+  bool FolderReader::GetRemainingContiguousData(ezArrayPtr<const ezUInt8>& out_Data) const
+  {
+    if (!IsMapped())
+      return false;
+
+    const ezUInt64 uiRemaining = m_MappedFile.GetFileSize() - m_uiMappedReadPosition;
+
+    // ezArrayPtr can't address more than that
+    if (uiRemaining > ezMath::MaxValue<ezUInt32>())
+      return false;
+
+    if (uiRemaining == 0)
+      out_Data = ezArrayPtr<const ezUInt8>();
+    else
+      out_Data = ezArrayPtr<const ezUInt8>(static_cast<const ezUInt8*>(m_MappedFile.GetReadPointer(m_uiMappedReadPosition)), static_cast<ezUInt32>(uiRemaining));
 
-  ezUInt64 FolderReader::Read(void* pBuffer, ezUInt64 uiBytes) { return m_File.Read(pBuffer, uiBytes); }
+    return true;
+  }
 
   ezUInt64 FolderReader::GetFileSize() const { return m_File.GetFileSize(); }
 
@@ -87,10 +191,25 @@ namespace ezDataDirectory
     sPath.AppendPath(szFile);
 
     ezOSFile::DeleteFile(sPath.GetData()).IgnoreResult();
+
+    if (HasFileIndex())
+    {
+      EZ_LOCK(GetGlobalFileIndex().m_Mutex);
+      RemoveFromFileIndex(szFile);
+    }
   }
 
   FolderType::~FolderType()
   {
+    if (HasFileIndex())
+    {
+      GlobalFileIndex& index = GetGlobalFileIndex();
+      EZ_LOCK(index.m_Mutex);
+
+      index.m_IndexedDirs.RemoveAndSwap(this);
+      ClearFileIndex();
+    }
+
     EZ_LOCK(m_ReaderWriterMutex);
     for (ezUInt32 i = 0; i < m_Readers.GetCount(); ++i)
       EZ_DEFAULT_DELETE(m_Readers[i]);
@@ -101,10 +220,268 @@ namespace ezDataDirectory
 
   void FolderType::ReloadExternalConfigs() { LoadRedirectionFile(); }
 
+  bool FolderType::NormalizeFileIndexPath(ezStringBuilder& sPath)
+  {
+    sPath.MakeCleanPath();
+    sPath.Trim("/");
+
+#if EZ_ENABLED(EZ_SUPPORTS_CASE_INSENSITIVE_PATHS)
+    sPath.ToLower();
+#endif
+
+    // paths that leave the data directory are valid, but never in the index
+    return sPath != ".." && !sPath.StartsWith("../");
+  }
+
+  void FolderType::BuildFileIndex()
+  {
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS)
+    // start watching before the folder is scanned, so that no change in between gets lost
+    ezUniquePtr<ezDirectoryWatcher> pWatcher = EZ_DEFAULT_NEW(ezDirectoryWatcher);
+    if (pWatcher->OpenDirectory(ezString(m_sRedirectedDataDirPath.GetView()), ezDirectoryWatcher::Watch::Creates | ezDirectoryWatcher::Watch::Renames | ezDirectoryWatcher::Watch::Subdirectories).Failed())
+    {
+      ezLog::Warning("Can't watch data directory '{0}', the file index is disabled for it.", m_sRedirectedDataDirPath.GetView());
+      return;
+    }
+
+    GlobalFileIndex& index = GetGlobalFileIndex();
+    EZ_LOCK(index.m_Mutex);
+
+    m_pFileIndexWatcher = std::move(pWatcher);
+    index.m_IndexedDirs.PushBack(this);
+    const ezUInt32 uiNumEntries = AddToFileIndex("", true);
+
+    ezLog::Debug("Indexed {0} files and folders in data directory '{1}'", uiNumEntries, m_sRedirectedDataDirPath.GetView());
+#endif
+  }
+
+  void FolderType::UpdateFileIndex()
+  {
+    m_pFileIndexWatcher->EnumerateChanges([this](const char* szFilename, ezDirectoryWatcherAction action) {
+      switch (action)
+      {
+        case ezDirectoryWatcherAction::Added:
+        case ezDirectoryWatcherAction::RenamedNewName:
+          // folders that are moved into the data directory don't report their content
+          AddToFileIndex(szFilename, true);
+          break;
+
+        case ezDirectoryWatcherAction::Removed:
+        case ezDirectoryWatcherAction::RenamedOldName:
+          RemoveFromFileIndex(szFilename);
+          break;
+
+        default:
+          break;
+      }
+    });
+
+    if (m_pFileIndexWatcher->HasMissedChanges())
+    {
+      ezLog::Debug("Lost track of changes in data directory '{0}', rebuilding its file index.", m_sRedirectedDataDirPath.GetView());
+
+      ClearFileIndex();
+      AddToFileIndex("", true);
+    }
+  }
+
+  ezUInt32 FolderType::AddToFileIndex(const char* szRelativePath, bool bScanFolder)
+  {
+    GlobalFileIndex& index = GetGlobalFileIndex();
+    ezUInt32 uiNumAdded = 0;
+
+    auto Insert = [&](const ezStringBuilder& sPath) {
+      auto& dataDirs = index.m_Files[sPath];
+      if (dataDirs.Contains(this))
+        return false;
+
+      dataDirs.PushBack(this);
+      ++uiNumAdded;
+      return true;
+    };
+
+    ezStringBuilder sPath = szRelativePath;
+    if (!NormalizeFileIndexPath(sPath))
+      return 0;
+
+    // anything that was missing so far might be (inside of) the new file or folder
+    index.m_MissingFiles.Clear();
+
+    // all parent folders exist as well
+    while (!sPath.IsEmpty())
+    {
+      if (!Insert(sPath))
+        break;
+
+      sPath.PathParentDirectory();
+      sPath.Trim("", "/");
+    }
+
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS)
+    if (!bScanFolder)
+      return uiNumAdded;
+
+    ezStringBuilder sFolder = m_sRedirectedDataDirPath;
+    sFolder.AppendPath(szRelativePath);
+
+    if (!ezOSFile::ExistsDirectory(sFolder))
+      return uiNumAdded;
+
+    ezStringBuilder sFullPath;
+    ezFileSystemIterator iterator;
+    for (iterator.StartSearch(sFolder, ezFileSystemIteratorFlags::ReportFilesAndFoldersRecursive); iterator.IsValid(); iterator.Next())
+    {
+      sFullPath = iterator.GetCurrentPath();
+      sFullPath.AppendPath(iterator.GetStats().m_sName);
+
+      if (sFullPath.MakeRelativeTo(m_sRedirectedDataDirPath).Failed())
+        continue;
+
+      if (NormalizeFileIndexPath(sFullPath))
+      {
+        Insert(sFullPath);
+      }
+    }
+#endif
+
+    return uiNumAdded;
+  }
+
+  void FolderType::RemoveFromFileIndex(const char* szRelativePath)
+  {
+    GlobalFileIndex& index = GetGlobalFileIndex();
+
+    ezStringBuilder sPath = szRelativePath;
+    if (!NormalizeFileIndexPath(sPath))
+      return;
+
+    auto itEntry = index.m_Files.Find(sPath);
+    if (!itEntry.IsValid() || !itEntry.Value().RemoveAndSwap(this))
+      return;
+
+    if (itEntry.Value().IsEmpty())
+    {
+      index.m_Files.Remove(itEntry);
+    }
+
+    // if it was a folder, everything inside it is gone as well
+    sPath.Append("/");
+
+    for (auto it = index.m_Files.GetIterator(); it.IsValid();)
+    {
+      if (it.Key().StartsWith(sPath) && it.Value().RemoveAndSwap(this) && it.Value().IsEmpty())
+        it = index.m_Files.Remove(it);
+      else
+        ++it;
+    }
+  }
+
+  void FolderType::ClearFileIndex()
+  {
+    GlobalFileIndex& index = GetGlobalFileIndex();
+
+    for (auto it = index.m_Files.GetIterator(); it.IsValid();)
+    {
+      if (it.Value().RemoveAndSwap(this) && it.Value().IsEmpty())
+        it = index.m_Files.Remove(it);
+      else
+        ++it;
+    }
+  }
+
+  const ezHybridArray<FolderType*, 2>* FolderType::LookupFileIndex(const ezStringBuilder& sPath, const FolderType* pDataDir)
+  {
+    GlobalFileIndex& index = GetGlobalFileIndex();
+
+    auto Lookup = [&]() -> const ezHybridArray<FolderType*, 2>* {
+      const ezHybridArray<FolderType*, 2>* pDataDirs = index.m_Files.GetValue(sPath);
+      if (pDataDirs != nullptr && (pDataDir == nullptr || pDataDirs->Contains(const_cast<FolderType*>(pDataDir))))
+        return pDataDirs;
+
+      return nullptr;
+    };
+
+    if (auto pDataDirs = Lookup())
+      return pDataDirs;
+
+    // files that were already missing are only checked again once the watchers may have something new to report
+    const ezTime tNow = ezTime::Now();
+    if (tNow - index.m_LastUpdate < ezTime::Milliseconds(50) && (pDataDir != nullptr || index.m_MissingFiles.Contains(sPath)))
+      return nullptr;
+
+    // the file might have been created very recently, e.g. by another process
+    // polling the watchers is still a lot cheaper than trying to open the file
+    index.m_LastUpdate = tNow;
+    for (FolderType* pIndexedDir : index.m_IndexedDirs)
+    {
+      pIndexedDir->UpdateFileIndex();
+    }
+
+    if (auto pDataDirs = Lookup())
+      return pDataDirs;
+
+    // don't let the cache grow without bounds, when lots of different files are probed
+    if (index.m_MissingFiles.GetCount() >= 16 * 1024)
+      index.m_MissingFiles.Clear();
+
+    if (!index.m_Files.Contains(sPath))
+      index.m_MissingFiles.Insert(sPath);
+
+    return nullptr;
+  }
+
+  bool FolderType::FindInFileIndex(ezStringView sFile, ezHybridArray<const ezDataDirectoryType*, 4>& out_DataDirs)
+  {
+    out_DataDirs.Clear();
+
+    ezStringBuilder sPath = sFile;
+    if (ezPathUtils::IsAbsolutePath(sPath))
+      return false;
+
+    if (!NormalizeFileIndexPath(sPath))
+      return false;
+
+    GlobalFileIndex& index = GetGlobalFileIndex();
+    EZ_LOCK(index.m_Mutex);
+
+    if (index.m_IndexedDirs.IsEmpty())
+      return false;
+
+    if (const ezHybridArray<FolderType*, 2>* pDataDirs = LookupFileIndex(sPath, nullptr))
+    {
+      for (FolderType* pDataDir : *pDataDirs)
+      {
+        out_DataDirs.PushBack(pDataDir);
+      }
+    }
+
+    return true;
+  }
+
+  bool FolderType::IsFileIndexed() const
+  {
+    return HasFileIndex() && !m_bHasRedirections;
+  }
+
+  bool FolderType::MightContainFile(const char* szFile)
+  {
+    // absolute paths are not relative to this data directory and thus not in the index
+    if (!HasFileIndex() || ezPathUtils::IsAbsolutePath(szFile))
+      return true;
+
+    ezStringBuilder sPath = szFile;
+    if (!NormalizeFileIndexPath(sPath))
+      return true;
+
+    EZ_LOCK(GetGlobalFileIndex().m_Mutex);
+    return LookupFileIndex(sPath, this) != nullptr;
+  }
+
   void FolderType::LoadRedirectionFile()
   {
     EZ_LOCK(m_RedirectionMutex);
     m_FileRedirection.Clear();
+    m_bHasRedirections = false;
 
     if (!s_sRedirectionFile.IsEmpty())
     {
@@ -151,6 +528,8 @@ namespace ezDataDirectory
           szLineStart = szLineEnd + 1;
         }
 
+        m_bHasRedirections = !m_FileRedirection.IsEmpty();
+
         // ezLog::Debug("Redirection file contains {0} entries", m_FileRedirection.GetCount());
       }
       // else
@@ -164,6 +543,9 @@ namespace ezDataDirectory
     ezStringBuilder sRedirectedAsset;
     ResolveAssetRedirection(szFile, sRedirectedAsset);
 
+    if (!MightContainFile(sRedirectedAsset))
+      return false;
+
     ezStringBuilder sPath = GetRedirectedDataDirectoryPath();
     sPath.AppendPath(sRedirectedAsset);
     return ezOSFile::ExistsFile(sPath);
@@ -174,6 +556,9 @@ namespace ezDataDirectory
     ezStringBuilder sRedirectedAsset;
     ResolveAssetRedirection(szFileOrFolder, sRedirectedAsset);
 
+    if (!MightContainFile(sRedirectedAsset))
+      return EZ_FAILURE;
+
     ezStringBuilder sPath = GetRedirectedDataDirectoryPath();
 
     if (ezPathUtils::IsAbsolutePath(sRedirectedAsset))
@@ -211,6 +596,11 @@ namespace ezDataDirectory
     if (!ezOSFile::ExistsDirectory(m_sRedirectedDataDirPath))
       return EZ_FAILURE;
 
+    if (s_bEnableFileIndex)
+    {
+      BuildFileIndex();
+    }
+
     ReloadExternalConfigs();
 
     return EZ_SUCCESS;
@@ -244,6 +634,9 @@ namespace ezDataDirectory
     if (ezConversionUtils::IsStringUuid(sFileToOpen))
       return nullptr;
 
+    if (!MightContainFile(sFileToOpen))
+      return nullptr;
+
     FolderReader* pReader = nullptr;
     {
       EZ_LOCK(m_ReaderWriterMutex);
@@ -329,6 +722,12 @@ namespace ezDataDirectory
       return nullptr;
     }
 
+    if (HasFileIndex())
+    {
+      EZ_LOCK(GetGlobalFileIndex().m_Mutex);
+      AddToFileIndex(szFile, false);
+    }
+
     // if it succeeds, we return the reader
     return pWriter;
   }
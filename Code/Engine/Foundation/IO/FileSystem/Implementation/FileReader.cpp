@@ -14,6 +14,20 @@ ezResult ezFileReader::Open(const char* szFile, ezUInt32 uiCacheSize /*= 1024 *
   if (!m_pDataDirReader)
     return EZ_FAILURE;
 
+  ezArrayPtr<const ezUInt8> fileData;
+  if (m_pDataDirReader->GetRemainingContiguousData(fileData))
+  {
+    // read directly from the memory of the data directory, no need for the cache
+    m_pFileData = fileData.GetPtr();
+    m_bFileDataReferenced = false;
+    m_uiCacheReadPosition = 0;
+    m_uiBytesCached = fileData.GetCount();
+    m_bEOF = m_uiBytesCached > 0 ? false : true;
+
+    return EZ_SUCCESS;
+  }
+
+  m_pFileData = nullptr;
   m_Cache.SetCountUninitialized(uiCacheSize);
 
   m_uiCacheReadPosition = 0;
@@ -29,6 +43,7 @@ void ezFileReader::Close()
     m_pDataDirReader->Close();
 
   m_pDataDirReader = nullptr;
+  m_pFileData = nullptr;
   m_bEOF = true;
 }
 
@@ -38,6 +53,18 @@ ezUInt64 ezFileReader::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
   if (m_bEOF)
     return 0;
 
+  if (m_pFileData != nullptr)
+  {
+    const ezUInt64 uiBytes = ezMath::Min(uiBytesToRead, m_uiBytesCached - m_uiCacheReadPosition);
+    ezMemoryUtils::Copy(static_cast<ezUInt8*>(pReadBuffer), m_pFileData + m_uiCacheReadPosition, static_cast<size_t>(uiBytes));
+
+    m_uiCacheReadPosition += uiBytes;
+    m_bEOF = m_uiCacheReadPosition >= m_uiBytesCached;
+
+    ReleaseFileDataAtEnd();
+    return uiBytes;
+  }
+
   ezUInt64 uiBufferPosition = 0; // how much was read, yet
   ezUInt8* pBuffer = (ezUInt8*)pReadBuffer;
 
@@ -83,6 +110,42 @@ ezUInt64 ezFileReader::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
   return uiBufferPosition;
 }
 
+ezUInt64 ezFileReader::SkipBytes(ezUInt64 uiBytesToSkip)
+{
+  EZ_ASSERT_DEV(m_pDataDirReader != nullptr, "The file has not been opened (successfully).");
+
+  if (m_pFileData == nullptr)
+    return ezStreamReader::SkipBytes(uiBytesToSkip);
+
+  const ezUInt64 uiBytes = ezMath::Min(uiBytesToSkip, m_uiBytesCached - m_uiCacheReadPosition);
 
+  m_uiCacheReadPosition += uiBytes;
+  m_bEOF = m_uiCacheReadPosition >= m_uiBytesCached;
+
+  ReleaseFileDataAtEnd();
+  return uiBytes;
+}
+
+bool ezFileReader::GetRemainingContiguousData(ezArrayPtr<const ezUInt8>& out_Data) const
+{
+  if (m_pFileData == nullptr)
+    return false;
+
+  out_Data = ezArrayPtr<const ezUInt8>(m_pFileData + m_uiCacheReadPosition, static_cast<ezUInt32>(m_uiBytesCached - m_uiCacheReadPosition));
+  m_bFileDataReferenced = true;
+  return true;
+}
+
+void ezFileReader::ReleaseFileDataAtEnd()
+{
+  if (!m_bEOF || m_bFileDataReferenced)
+    return;
+
+  // e.g. streamed readers don't need the file to stay mapped while the data they parsed is processed further
+  m_pFileData = nullptr;
+  m_uiBytesCached = 0;
+  m_uiCacheReadPosition = 0;
+  m_pDataDirReader->ReleaseContiguousData();
+}
 
 EZ_STATICLINK_FILE(Foundation, Foundation_IO_FileSystem_Implementation_FileReader);
@@ -1,9 +1,11 @@
 #include <FoundationPCH.h>
 
 #include <Foundation/Configuration/Startup.h>
+#include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/ThreadUtils.h>
 
 // clang-format off
 EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, FileSystem)
@@ -25,6 +27,87 @@ ezFileSystem::FileSystemData* ezFileSystem::s_Data = nullptr;
 ezString ezFileSystem::s_sSdkRootDir;
 ezMap<ezString, ezString> ezFileSystem::s_SpecialDirectories;
 
+class ezFileSystem::DataDirReadLock
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(DataDirReadLock);
+
+public:
+  DataDirReadLock()
+  {
+    EZ_LOCK(s_Data->m_DataDirLock);
+
+    // the thread that modifies the data directories may look up files as well (e.g. in an event handler)
+    if (s_Data->m_uiDataDirWriters > 0 && s_Data->m_DataDirWriterThread == ezThreadUtils::GetCurrentThreadID())
+    {
+      m_bHeldByWriter = true;
+      return;
+    }
+
+    while (s_Data->m_uiDataDirWriters > 0)
+    {
+      s_Data->m_DataDirLock.UnlockWaitForSignalAndLock();
+    }
+
+    ++s_Data->m_uiDataDirReaders;
+  }
+
+  ~DataDirReadLock()
+  {
+    if (m_bHeldByWriter)
+      return;
+
+    EZ_LOCK(s_Data->m_DataDirLock);
+
+    if (--s_Data->m_uiDataDirReaders == 0)
+    {
+      s_Data->m_DataDirLock.SignalAll();
+    }
+  }
+
+private:
+  bool m_bHeldByWriter = false;
+};
+
+class ezFileSystem::DataDirWriteLock
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(DataDirWriteLock);
+
+public:
+  DataDirWriteLock()
+  {
+    // only one thread at a time can get here, the others wait for the mutex
+    s_Data->m_FsMutex.Lock();
+
+    EZ_LOCK(s_Data->m_DataDirLock);
+
+    if (s_Data->m_uiDataDirWriters == 0)
+    {
+      while (s_Data->m_uiDataDirReaders > 0)
+      {
+        s_Data->m_DataDirLock.UnlockWaitForSignalAndLock();
+      }
+
+      s_Data->m_DataDirWriterThread = ezThreadUtils::GetCurrentThreadID();
+    }
+
+    ++s_Data->m_uiDataDirWriters;
+  }
+
+  ~DataDirWriteLock()
+  {
+    {
+      EZ_LOCK(s_Data->m_DataDirLock);
+
+      if (--s_Data->m_uiDataDirWriters == 0)
+      {
+        s_Data->m_DataDirLock.SignalAll();
+      }
+    }
+
+    s_Data->m_FsMutex.Unlock();
+  }
+};
+
 
 void ezFileSystem::RegisterDataDirectoryFactory(ezDataDirFactory Factory, float fPriority /*= 0*/)
 {
@@ -86,7 +169,7 @@ ezResult ezFileSystem::AddDataDirectory(const char* szDataDirectory, const char*
   ezStringBuilder sCleanRootName = szRootName;
   CleanUpRootName(sCleanRootName);
 
-  EZ_LOCK(s_Data->m_FsMutex);
+  DataDirWriteLock lock;
 
   bool failed = false;
   if (FindDataDirectoryWithRoot(sCleanRootName) != nullptr)
@@ -148,7 +231,7 @@ bool ezFileSystem::RemoveDataDirectory(const char* szRootName)
   ezStringBuilder sCleanRootName = szRootName;
   CleanUpRootName(sCleanRootName);
 
-  EZ_LOCK(s_Data->m_FsMutex);
+  DataDirWriteLock lock;
 
   for (ezUInt32 i = 0; i < s_Data->m_DataDirectories.GetCount();)
   {
@@ -180,7 +263,7 @@ ezUInt32 ezFileSystem::RemoveDataDirectoryGroup(const char* szGroup)
 {
   EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
 
-  EZ_LOCK(s_Data->m_FsMutex);
+  DataDirWriteLock lock;
 
   ezUInt32 uiRemoved = 0;
 
@@ -214,7 +297,7 @@ void ezFileSystem::ClearAllDataDirectories()
 {
   EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
 
-  EZ_LOCK(s_Data->m_FsMutex);
+  DataDirWriteLock lock;
 
   for (ezInt32 i = s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
   {
@@ -268,8 +351,6 @@ ezDataDirectoryType* ezFileSystem::GetDataDirectory(ezUInt32 uiDataDirIndex)
 
 const char* ezFileSystem::GetDataDirRelativePath(const char* szPath, ezUInt32 uiDataDir)
 {
-  EZ_LOCK(s_Data->m_FsMutex);
-
   // if an absolute path is given, this will check whether the absolute path would fall into this data directory
   // if yes, the prefix path is removed and then only the relative path is given to the data directory type
   // otherwise the data directory would prepend its own path and thus create an invalid path to work with
@@ -310,8 +391,6 @@ const char* ezFileSystem::GetDataDirRelativePath(const char* szPath, ezUInt32 ui
 
 ezFileSystem::DataDirectory* ezFileSystem::GetDataDirForRoot(const ezString& sRoot)
 {
-  EZ_LOCK(s_Data->m_FsMutex);
-
   for (ezInt32 i = (ezInt32)s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
   {
     if (s_Data->m_DataDirectories[i].m_sRootName == sRoot)
@@ -377,13 +456,19 @@ bool ezFileSystem::ExistsFile(const char* szFile)
 
   const bool bOneSpecificDataDir = !sRootName.IsEmpty();
 
-  EZ_LOCK(s_Data->m_FsMutex);
+  ezHybridArray<const ezDataDirectoryType*, 4> indexedDataDirs;
+  const bool bUseFileIndex = ezDataDirectory::FolderType::FindInFileIndex(szFile, indexedDataDirs);
+
+  DataDirReadLock lock;
 
   for (ezInt32 i = (ezInt32)s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
   {
     if (!sRootName.IsEmpty() && s_Data->m_DataDirectories[i].m_sRootName != sRootName)
       continue;
 
+    if (IsExcludedByFileIndex(s_Data->m_DataDirectories[i].m_pDataDirectory, bUseFileIndex, indexedDataDirs))
+      continue;
+
     const char* szRelPath = GetDataDirRelativePath(szFile, i);
 
     if (s_Data->m_DataDirectories[i].m_pDataDirectory->ExistsFile(szRelPath, bOneSpecificDataDir))
@@ -398,18 +483,24 @@ ezResult ezFileSystem::GetFileStats(const char* szFileOrFolder, ezFileStats& out
 {
   EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
 
-  EZ_LOCK(s_Data->m_FsMutex);
-
   ezString sRootName;
   szFileOrFolder = ExtractRootName(szFileOrFolder, sRootName);
 
   const bool bOneSpecificDataDir = !sRootName.IsEmpty();
 
+  ezHybridArray<const ezDataDirectoryType*, 4> indexedDataDirs;
+  const bool bUseFileIndex = ezDataDirectory::FolderType::FindInFileIndex(szFileOrFolder, indexedDataDirs);
+
+  DataDirReadLock lock;
+
   for (ezInt32 i = (ezInt32)s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
   {
     if (!sRootName.IsEmpty() && s_Data->m_DataDirectories[i].m_sRootName != sRootName)
       continue;
 
+    if (IsExcludedByFileIndex(s_Data->m_DataDirectories[i].m_pDataDirectory, bUseFileIndex, indexedDataDirs))
+      continue;
+
     const char* szRelPath = GetDataDirRelativePath(szFileOrFolder, i);
 
     if (s_Data->m_DataDirectories[i].m_pDataDirectory->GetFileStats(szRelPath, bOneSpecificDataDir, out_Stats).Succeeded())
@@ -453,8 +544,6 @@ ezDataDirectoryReader* ezFileSystem::GetFileReader(const char* szFile, ezFileSha
   if (ezStringUtils::IsNullOrEmpty(szFile))
     return nullptr;
 
-  EZ_LOCK(s_Data->m_FsMutex);
-
   ezString sRootName;
   szFile = ExtractRootName(szFile, sRootName);
 
@@ -464,44 +553,92 @@ ezDataDirectoryReader* ezFileSystem::GetFileReader(const char* szFile, ezFileSha
 
   const bool bOneSpecificDataDir = !sRootName.IsEmpty();
 
-  // the last added data directory has the highest priority
-  for (ezInt32 i = (ezInt32)s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
-  {
-    // if a root is used, ignore all directories that do not have the same root name
-    if (bOneSpecificDataDir && s_Data->m_DataDirectories[i].m_sRootName != sRootName)
-      continue;
+  // a single lookup in the global file index tells which of the indexed data directories contain the file
+  ezHybridArray<const ezDataDirectoryType*, 4> indexedDataDirs;
+  const bool bUseFileIndex = ezDataDirectory::FolderType::FindInFileIndex(sPath, indexedDataDirs);
 
-    const char* szRelPath = GetDataDirRelativePath(sPath, i);
-
-    if (bAllowFileEvents)
+  auto OpenFile = [&]() -> ezDataDirectoryReader* {
+    // the last added data directory has the highest priority
+    for (ezInt32 i = (ezInt32)s_Data->m_DataDirectories.GetCount() - 1; i >= 0; --i)
     {
-      // Broadcast that we now try to open this file
-      // Could be useful to check this file out before it is accessed
-      FileEvent fe;
-      fe.m_EventType = FileEventType::OpenFileAttempt;
-      fe.m_szFileOrDirectory = szRelPath;
-      fe.m_szOther = sRootName;
-      fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
-      s_Data->m_Event.Broadcast(fe);
+      // if a root is used, ignore all directories that do not have the same root name
+      if (bOneSpecificDataDir && s_Data->m_DataDirectories[i].m_sRootName != sRootName)
+        continue;
+
+      if (IsExcludedByFileIndex(s_Data->m_DataDirectories[i].m_pDataDirectory, bUseFileIndex, indexedDataDirs))
+        continue;
+
+      const char* szRelPath = GetDataDirRelativePath(sPath, i);
+
+      if (bAllowFileEvents)
+      {
+        // Broadcast that we now try to open this file
+        // Could be useful to check this file out before it is accessed
+        FileEvent fe;
+        fe.m_EventType = FileEventType::OpenFileAttempt;
+        fe.m_szFileOrDirectory = szRelPath;
+        fe.m_szOther = sRootName;
+        fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
+        s_Data->m_Event.Broadcast(fe);
+      }
+
+      // Let the data directory try to open the file.
+      ezDataDirectoryReader* pReader = s_Data->m_DataDirectories[i].m_pDataDirectory->OpenFileToRead(szRelPath, FileShareMode, bOneSpecificDataDir);
+
+      if (bAllowFileEvents && pReader != nullptr)
+      {
+        // Broadcast that this file has been opened.
+        FileEvent fe;
+        fe.m_EventType = FileEventType::OpenFileSucceeded;
+        fe.m_szFileOrDirectory = szRelPath;
+        fe.m_szOther = sRootName;
+        fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
+        s_Data->m_Event.Broadcast(fe);
+
+        return pReader;
+      }
     }
 
-    // Let the data directory try to open the file.
-    ezDataDirectoryReader* pReader = s_Data->m_DataDirectories[i].m_pDataDirectory->OpenFileToRead(szRelPath, FileShareMode, bOneSpecificDataDir);
+    return nullptr;
+  };
+
+  ezDataDirectoryReader* pReader = nullptr;
+  bool bSearched = false;
+
+  if (bUseFileIndex)
+  {
+    DataDirReadLock lock;
 
-    if (bAllowFileEvents && pReader != nullptr)
+    // if all data directories that might contain the file are indexed, they don't need the file system mutex
+    bool bAllIndexed = true;
+    for (const DataDirectory& dd : s_Data->m_DataDirectories)
     {
-      // Broadcast that this file has been opened.
-      FileEvent fe;
-      fe.m_EventType = FileEventType::OpenFileSucceeded;
-      fe.m_szFileOrDirectory = szRelPath;
-      fe.m_szOther = sRootName;
-      fe.m_pDataDir = s_Data->m_DataDirectories[i].m_pDataDirectory;
-      s_Data->m_Event.Broadcast(fe);
+      if (bOneSpecificDataDir && dd.m_sRootName != sRootName)
+        continue;
 
-      return pReader;
+      if (!dd.m_pDataDirectory->IsFileIndexed())
+      {
+        bAllIndexed = false;
+        break;
+      }
+    }
+
+    if (bAllIndexed)
+    {
+      pReader = OpenFile();
+      bSearched = true;
     }
   }
 
+  if (!bSearched)
+  {
+    EZ_LOCK(s_Data->m_FsMutex);
+    pReader = OpenFile();
+  }
+
+  if (pReader != nullptr)
+    return pReader;
+
   if (bAllowFileEvents)
   {
     // Broadcast that opening this file failed.
@@ -514,6 +651,12 @@ ezDataDirectoryReader* ezFileSystem::GetFileReader(const char* szFile, ezFileSha
   return nullptr;
 }
 
+bool ezFileSystem::IsExcludedByFileIndex(const ezDataDirectoryType* pDataDir, bool bUseFileIndex, const ezHybridArray<const ezDataDirectoryType*, 4>& indexedDataDirs)
+{
+  // data directories that redirect files or aren't indexed have to be asked
+  return bUseFileIndex && pDataDir->IsFileIndexed() && !indexedDataDirs.Contains(pDataDir);
+}
+
 ezDataDirectoryWriter* ezFileSystem::GetFileWriter(const char* szFile, ezFileShareMode::Enum FileShareMode, bool bAllowFileEvents)
 {
   EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
@@ -594,12 +737,12 @@ ezResult ezFileSystem::ResolvePath(const char* szPath, ezStringBuilder* out_sAbs
 {
   EZ_ASSERT_DEV(s_Data != nullptr, "FileSystem is not initialized.");
 
-  EZ_LOCK(s_Data->m_FsMutex);
-
   ezStringBuilder absPath, relPath;
 
   if (ezStringUtils::StartsWith(szPath, ":"))
   {
+    DataDirReadLock lock;
+
     // writing is only allowed using rooted paths
     ezString sRootName;
     ExtractRootName(szPath, sRootName);
@@ -622,6 +765,8 @@ ezResult ezFileSystem::ResolvePath(const char* szPath, ezStringBuilder* out_sAbs
     absPath = szPath;
     absPath.MakeCleanPath();
 
+    DataDirReadLock lock;
+
     for (ezUInt32 dd = s_Data->m_DataDirectories.GetCount(); dd > 0; --dd)
     {
       auto& dir = s_Data->m_DataDirectories[dd - 1];
@@ -649,6 +794,7 @@ ezResult ezFileSystem::ResolvePath(const char* szPath, ezStringBuilder* out_sAbs
   else
   {
     // try to get a reader -> if we get one, the file does indeed exist
+    // this must not happen within a DataDirReadLock, since GetFileReader locks the file system mutex
     ezDataDirectoryReader* pReader = ezFileSystem::GetFileReader(szPath, ezFileShareMode::SharedReads, true);
 
     if (!pReader)
@@ -0,0 +1,268 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/IO/AsyncFileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/FileSystem/Implementation/FileReaderWriterBase.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Types/RefCounted.h>
+
+namespace ezAsyncFileReaderDetail
+{
+  static bool s_bNativeAsyncIOEnabled = true;
+
+  /// Opens a file through the file system, such that its path only has to be resolved once, and gives access to the OS file.
+  class FileHandleReader : public ezFileReaderBase
+  {
+  public:
+    ~FileHandleReader() { Close(); }
+
+    ezResult Open(const char* szFile)
+    {
+      m_pDataDirReader = GetFileReader(szFile, ezFileShareMode::SharedReads, true);
+      return m_pDataDirReader != nullptr ? EZ_SUCCESS : EZ_FAILURE;
+    }
+
+    void Close()
+    {
+      if (m_pDataDirReader)
+        m_pDataDirReader->Close();
+
+      m_pDataDirReader = nullptr;
+    }
+
+    /// Returns nullptr, if the file is not an ordinary file on disk, e.g. inside of an archive.
+    const ezOSFile* GetOSFile() const { return m_pDataDirReader->GetOSFile(); }
+
+    virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override { return m_pDataDirReader->Read(pReadBuffer, uiBytesToRead); }
+  };
+
+  /// Opens the file and fills out everything about it, except for its content. Returns false, if the file should not be read.
+  static bool OpenFile(FileHandleReader& file, ezAsyncFileRead& request)
+  {
+    request.m_Result = EZ_FAILURE;
+    request.m_bExceededMaxFileSize = false;
+    request.m_Data.Clear();
+
+    if (file.Open(request.m_sFile).Failed())
+      return false;
+
+    const ezUInt64 uiFileSize = file.GetFileSize();
+    if (uiFileSize > ezMath::Min<ezUInt64>(request.m_uiMaxFileSize, ezMath::MaxValue<ezUInt32>()))
+    {
+      request.m_bExceededMaxFileSize = true;
+      return false;
+    }
+
+    request.m_sAbsolutePath = file.GetFilePathAbsolute().GetView();
+    request.m_sDataDirRelativePath = file.GetFilePathRelative().GetView();
+    request.m_LastModificationTime = ezTimestamp();
+
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_STATS)
+    // files on disk don't need to be searched in all data directories again
+    ezFileStats stats;
+    const ezResult statsResult = file.GetOSFile() != nullptr ? ezOSFile::GetFileStats(request.m_sAbsolutePath, stats) : ezFileSystem::GetFileStats(request.m_sFile, stats);
+    if (statsResult.Succeeded())
+    {
+      request.m_LastModificationTime = stats.m_LastModificationTime;
+    }
+#endif
+
+    request.m_Data.SetCountUninitialized(static_cast<ezUInt32>(uiFileSize));
+    return true;
+  }
+
+  /// Reads the entire file through the file system, which works for all data directory types.
+  static void ReadFileBlocking(ezAsyncFileRead& request)
+  {
+    FileHandleReader file;
+    if (!OpenFile(file, request))
+      return;
+
+    if (file.ReadBytes(request.m_Data.GetData(), request.m_Data.GetCount()) == request.m_Data.GetCount())
+    {
+      request.m_Result = EZ_SUCCESS;
+    }
+  }
+
+  static void FinishRequest(ezAsyncFileRead& request)
+  {
+    if (request.m_Result.Failed())
+    {
+      request.m_Data.Clear();
+    }
+
+    if (request.m_OnFinished.IsValid())
+    {
+      request.m_OnFinished(request);
+    }
+  }
+
+  class FinishRequestTask final : public ezTask
+  {
+  public:
+    FinishRequestTask(ezAsyncFileRead& request)
+      : m_Request(request)
+    {
+      ConfigureTask("Finish File Read", ezTaskNesting::Maybe);
+    }
+
+  private:
+    virtual void Execute() override { FinishRequest(m_Request); }
+
+    ezAsyncFileRead& m_Request;
+  };
+
+  /// Runs FinishRequest() of every request on its own task, such that a single thread that does all the I/O doesn't have to run all
+  /// callbacks one after the other.
+  class RequestFinisher
+  {
+    EZ_DISALLOW_COPY_AND_ASSIGN(RequestFinisher);
+
+  public:
+    RequestFinisher() = default;
+    ~RequestFinisher() { WaitForAll(); }
+
+    void Finish(ezAsyncFileRead& request)
+    {
+      if (!request.m_OnFinished.IsValid())
+      {
+        FinishRequest(request);
+        return;
+      }
+
+      m_Groups.PushBack(ezTaskSystem::StartSingleTask(EZ_DEFAULT_NEW(FinishRequestTask, request), ezTaskPriority::LongRunning));
+    }
+
+    void WaitForAll()
+    {
+      for (const ezTaskGroupID& group : m_Groups)
+      {
+        ezTaskSystem::WaitForGroup(group);
+      }
+
+      m_Groups.Clear();
+    }
+
+  private:
+    ezHybridArray<ezTaskGroupID, 64> m_Groups;
+  };
+} // namespace ezAsyncFileReaderDetail
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+#  include <Foundation/IO/Implementation/Linux/AsyncFileReader_linux.h>
+#else
+
+// there is no asynchronous file API in use on this platform, all files are read through the task system
+struct ezAsyncFileReaderImpl
+{
+  static bool IsSupported() { return false; }
+  static void ReadFiles(ezArrayPtr<ezAsyncFileRead> requests, ezAsyncFileReaderDetail::RequestFinisher& finisher) {}
+};
+
+#endif
+
+namespace
+{
+  /// Shared by all tasks that read files through the task system, each task takes the next file that nobody is reading yet.
+  struct ezAsyncFileReadQueue : public ezRefCounted
+  {
+    ezArrayPtr<ezAsyncFileRead> m_Requests;
+    ezAtomicInteger32 m_iNextRequest;
+  };
+
+  class ezAsyncFileReadTask final : public ezTask
+  {
+  public:
+    ezAsyncFileReadTask(const ezSharedPtr<ezAsyncFileReadQueue>& pQueue)
+      : m_pQueue(pQueue)
+    {
+      ConfigureTask("Read Files", ezTaskNesting::Never);
+    }
+
+  private:
+    virtual void Execute() override
+    {
+      EZ_PROFILE_SCOPE("ReadFiles");
+
+      while (true)
+      {
+        const ezUInt32 uiRequest = static_cast<ezUInt32>(m_pQueue->m_iNextRequest.PostIncrement());
+        if (uiRequest >= m_pQueue->m_Requests.GetCount())
+          break;
+
+        ezAsyncFileRead& request = m_pQueue->m_Requests[uiRequest];
+        ezAsyncFileReaderDetail::ReadFileBlocking(request);
+        ezAsyncFileReaderDetail::FinishRequest(request);
+      }
+    }
+
+    ezSharedPtr<ezAsyncFileReadQueue> m_pQueue;
+  };
+
+  class ezAsyncFileReadNativeTask final : public ezTask
+  {
+  public:
+    ezAsyncFileReadNativeTask(ezArrayPtr<ezAsyncFileRead> requests)
+      : m_Requests(requests)
+    {
+      // waits for the tasks that run the callbacks
+      ConfigureTask("Read Files (native)", ezTaskNesting::Maybe);
+    }
+
+  private:
+    virtual void Execute() override
+    {
+      EZ_PROFILE_SCOPE("ReadFiles");
+
+      ezAsyncFileReaderDetail::RequestFinisher finisher;
+      ezAsyncFileReaderImpl::ReadFiles(m_Requests, finisher);
+      finisher.WaitForAll();
+    }
+
+    ezArrayPtr<ezAsyncFileRead> m_Requests;
+  };
+} // namespace
+
+// static
+ezTaskGroupID ezAsyncFileReader::ReadFiles(ezArrayPtr<ezAsyncFileRead> requests, ezOnTaskGroupFinishedCallback onAllFinished)
+{
+  ezTaskGroupID group = ezTaskSystem::CreateTaskGroup(ezTaskPriority::LongRunning, onAllFinished);
+
+  if (IsUsingNativeAsyncIO())
+  {
+    // a single task keeps all reads in flight
+    ezTaskSystem::AddTaskToGroup(group, EZ_DEFAULT_NEW(ezAsyncFileReadNativeTask, requests));
+  }
+  else
+  {
+    ezSharedPtr<ezAsyncFileReadQueue> pQueue = EZ_DEFAULT_NEW(ezAsyncFileReadQueue);
+    pQueue->m_Requests = requests;
+
+    const ezUInt32 uiNumThreads = ezMath::Max(1u, ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::LongTasks));
+    const ezUInt32 uiNumTasks = ezMath::Clamp(requests.GetCount(), 1u, uiNumThreads);
+
+    for (ezUInt32 i = 0; i < uiNumTasks; ++i)
+    {
+      ezTaskSystem::AddTaskToGroup(group, EZ_DEFAULT_NEW(ezAsyncFileReadTask, pQueue));
+    }
+  }
+
+  ezTaskSystem::StartTaskGroup(group);
+  return group;
+}
+
+// static
+bool ezAsyncFileReader::IsUsingNativeAsyncIO()
+{
+  return ezAsyncFileReaderDetail::s_bNativeAsyncIOEnabled && ezAsyncFileReaderImpl::IsSupported();
+}
+
+// static
+void ezAsyncFileReader::SetNativeAsyncIOEnabled(bool bEnable)
+{
+  ezAsyncFileReaderDetail::s_bNativeAsyncIOEnabled = bEnable;
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_IO_Implementation_AsyncFileReader);
@@ -4,6 +4,8 @@
 #  include <Foundation/IO/Implementation/Win/DirectoryWatcher_win.h>
 #elif EZ_ENABLED(EZ_PLATFORM_WINDOWS_UWP)
 #  include <Foundation/IO/Implementation/Win/DirectoryWatcher_uwp.h>
+#elif EZ_ENABLED(EZ_PLATFORM_LINUX) || EZ_ENABLED(EZ_PLATFORM_ANDROID)
+#  include <Foundation/IO/Implementation/Linux/DirectoryWatcher_linux.h>
 #elif EZ_ENABLED(EZ_USE_POSIX_FILE_API)
 #  include <Foundation/IO/Implementation/Posix/DirectoryWatcher_posix.h>
 #else
@@ -0,0 +1,594 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/IO/Implementation/TextScanning.h>
+#include <Foundation/IO/JSONPullParser.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Math/Math.h>
+
+namespace
+{
+  constexpr double s_PowersOf10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+    1e20, 1e21, 1e22};
+
+  EZ_ALWAYS_INLINE bool IsDigit(ezUInt8 c)
+  {
+    return c >= '0' && c <= '9';
+  }
+
+  EZ_ALWAYS_INLINE bool IsEndOfWord(ezUInt8 c)
+  {
+    return ezStringUtils::IsWhiteSpace(c) || c == ',' || c == ']' || c == '}' || c == '/';
+  }
+
+  bool HexToValue(ezUInt8 c, ezUInt32& out_uiValue)
+  {
+    if (c >= '0' && c <= '9')
+      out_uiValue = c - '0';
+    else if (c >= 'a' && c <= 'f')
+      out_uiValue = c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F')
+      out_uiValue = c - 'A' + 10;
+    else
+      return false;
+
+    return true;
+  }
+} // namespace
+
+ezJSONPullParser::ezJSONPullParser() = default;
+
+void ezJSONPullParser::SetInputBuffer(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset /*= 0*/)
+{
+  m_pBufferStart = data.GetPtr();
+  m_pCur = data.GetPtr();
+  m_pEnd = data.GetPtr() + data.GetCount();
+  m_uiFirstLineOffset = uiFirstLineOffset;
+
+  // buffers that were filled from a string often include the terminator
+  while (m_pEnd > m_pCur && m_pEnd[-1] == '\0')
+    --m_pEnd;
+
+  m_Stack.Clear();
+  m_bFirstElement = true;
+  m_bStarted = false;
+  m_bHadFatalParsingError = false;
+  m_LastToken = Token::EndOfDocument;
+  m_sName = ezStringView();
+  m_sString = ezStringView();
+  m_sErrorMessage.Clear();
+  m_uiErrorLine = 0;
+  m_uiErrorColumn = 0;
+}
+
+ezJSONPullParser::Token ezJSONPullParser::ReadNext()
+{
+  m_sName = ezStringView();
+
+  if (m_bHadFatalParsingError)
+    return Token::Error;
+
+  SkipWhitespace();
+
+  if (m_Stack.IsEmpty())
+  {
+    // anything after the top-level value is ignored, like in ezJSONParser
+    if (m_bStarted || m_pCur == m_pEnd)
+    {
+      m_LastToken = Token::EndOfDocument;
+      return m_LastToken;
+    }
+
+    m_bStarted = true;
+    m_LastToken = ReadValue();
+    return m_LastToken;
+  }
+
+  if (m_pCur == m_pEnd)
+    return ParsingError("End of the document reached without closing all objects.");
+
+  if (m_Stack.PeekBack())
+  {
+    if (!m_bFirstElement && *m_pCur != ',' && *m_pCur != '}')
+    {
+      ezStringBuilder s;
+      s.Format("After parsing value: Expected a comma or }. Got '{0}' instead.", ezArgC(*m_pCur));
+      return ParsingError(s);
+    }
+
+    // superfluous commas in objects are ignored
+    while (m_pCur < m_pEnd && *m_pCur == ',')
+    {
+      ++m_pCur;
+      SkipWhitespace();
+    }
+
+    if (m_pCur == m_pEnd)
+      return ParsingError("End of the document reached without closing all objects.");
+
+    if (*m_pCur == '}')
+    {
+      ++m_pCur;
+      m_Stack.PopBack();
+      m_bFirstElement = false;
+      m_LastToken = Token::EndObject;
+      return m_LastToken;
+    }
+
+    if (*m_pCur != '\"')
+    {
+      ezStringBuilder s;
+      s.Format("While parsing object: Expected \" to begin a new variable, or } to close the object. Got '{0}' instead.", ezArgC(*m_pCur));
+      return ParsingError(s);
+    }
+
+    if (!ReadString(m_DecodedName, m_sName))
+      return Token::Error;
+
+    SkipWhitespace();
+
+    if (m_pCur == m_pEnd || *m_pCur != ':')
+      return ParsingError("After parsing variable name: Expected : to separate variable and value.");
+
+    ++m_pCur;
+    SkipWhitespace();
+  }
+  else
+  {
+    if (!m_bFirstElement)
+    {
+      // one superfluous comma at the end of an array is allowed
+      if (*m_pCur == ',')
+      {
+        ++m_pCur;
+        SkipWhitespace();
+      }
+      else if (*m_pCur != ']')
+      {
+        ezStringBuilder s;
+        s.Format("After parsing value: Expected a comma or ]. Got '{0}' instead.", ezArgC(*m_pCur));
+        return ParsingError(s);
+      }
+    }
+
+    if (m_pCur < m_pEnd && *m_pCur == ']')
+    {
+      ++m_pCur;
+      m_Stack.PopBack();
+      m_bFirstElement = false;
+      m_LastToken = Token::EndArray;
+      return m_LastToken;
+    }
+  }
+
+  m_bFirstElement = false;
+  m_LastToken = ReadValue();
+  return m_LastToken;
+}
+
+void ezJSONPullParser::SkipValue()
+{
+  if (m_LastToken != Token::BeginObject && m_LastToken != Token::BeginArray)
+    return;
+
+  const ezUInt32 uiDepth = m_Stack.GetCount();
+
+  while (m_Stack.GetCount() >= uiDepth)
+  {
+    const Token token = ReadNext();
+
+    if (token == Token::Error || token == Token::EndOfDocument)
+      return;
+  }
+}
+
+ezJSONPullParser::Token ezJSONPullParser::ReadValue()
+{
+  if (m_pCur == m_pEnd)
+    return ParsingError("Parsing value: Reached the end of the document.");
+
+  switch (*m_pCur)
+  {
+    case '{':
+      ++m_pCur;
+      m_Stack.PushBack(true);
+      m_bFirstElement = true;
+      return Token::BeginObject;
+
+    case '[':
+      ++m_pCur;
+      m_Stack.PushBack(false);
+      m_bFirstElement = true;
+      return Token::BeginArray;
+
+    case '\"':
+      return ReadString(m_DecodedString, m_sString) ? Token::String : Token::Error;
+
+    case '+':
+    case '-':
+    case '.':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+      return ReadNumber();
+
+    case 't':
+    case 'f':
+    case 'n':
+      return ReadWord();
+
+    default:
+    {
+      ezStringBuilder s;
+      s.Format("Parsing value: Expected [, {, f, t, n, \", 0-9, ., + or -. Got '{0}' instead", ezArgC(*m_pCur));
+      return ParsingError(s);
+    }
+  }
+}
+
+ezJSONPullParser::Token ezJSONPullParser::ParsingError(const char* szMessage)
+{
+  m_bHadFatalParsingError = true;
+  m_sErrorMessage = szMessage;
+
+  // the position is only needed for error messages, so it is not tracked while parsing
+  m_uiErrorLine = 1 + m_uiFirstLineOffset;
+  const ezUInt8* pLineStart = m_pBufferStart;
+  for (const ezUInt8* pNewLine = ezInternal::FindFirstOf(pLineStart, m_pCur, '\n', '\n', '\n'); pNewLine != m_pCur;
+       pNewLine = ezInternal::FindFirstOf(pLineStart, m_pCur, '\n', '\n', '\n'))
+  {
+    ++m_uiErrorLine;
+    pLineStart = pNewLine + 1;
+  }
+  m_uiErrorColumn = static_cast<ezUInt32>(m_pCur - pLineStart) + 1;
+
+  m_pCur = m_pEnd;
+  m_Stack.Clear();
+  m_LastToken = Token::Error;
+
+  ezLog::Error(m_pLogInterface, "Line {0} ({1}): {2}", m_uiErrorLine, m_uiErrorColumn, szMessage);
+
+  return Token::Error;
+}
+
+void ezJSONPullParser::SkipWhitespace()
+{
+  while (true)
+  {
+    m_pCur = ezInternal::FindEndOfWhitespace(m_pCur, m_pEnd);
+
+    if (m_pEnd - m_pCur < 2 || m_pCur[0] != '/')
+      return;
+
+    if (m_pCur[1] == '/')
+    {
+      // line comment, skip till line break
+      m_pCur = ezInternal::FindFirstOf(m_pCur + 2, m_pEnd, '\n', '\n', '\n');
+    }
+    else if (m_pCur[1] == '*')
+    {
+      // block comment, skip till */
+      const ezUInt8* pStar = m_pCur + 2;
+      while (true)
+      {
+        pStar = ezInternal::FindFirstOf(pStar, m_pEnd, '*', '*', '*');
+
+        if (m_pEnd - pStar < 2)
+        {
+          m_pCur = m_pEnd;
+          break;
+        }
+
+        if (pStar[1] == '/')
+        {
+          m_pCur = pStar + 2;
+          break;
+        }
+
+        ++pStar;
+      }
+    }
+    else
+    {
+      return;
+    }
+  }
+}
+
+bool ezJSONPullParser::ReadString(ezHybridArray<char, 256>& ref_decoded, ezStringView& out_sString)
+{
+  // skip the opening quote
+  ++m_pCur;
+
+  const ezUInt8* pRunStart = m_pCur;
+  const ezUInt8* pRunEnd = ezInternal::FindFirstOf(pRunStart, m_pEnd, '\"', '\\', '\"');
+
+  if (pRunEnd == m_pEnd)
+  {
+    ParsingError("While reading string: Reached end of document before end of string was found.");
+    return false;
+  }
+
+  // the common case, a string without escape sequences is returned without a copy
+  if (*pRunEnd == '\"')
+  {
+    out_sString = ezStringView(reinterpret_cast<const char*>(pRunStart), reinterpret_cast<const char*>(pRunEnd));
+    m_pCur = pRunEnd + 1;
+    return true;
+  }
+
+  ref_decoded.Clear();
+
+  while (true)
+  {
+    ref_decoded.PushBackRange(ezArrayPtr<const char>(reinterpret_cast<const char*>(pRunStart), static_cast<ezUInt32>(pRunEnd - pRunStart)));
+
+    m_pCur = pRunEnd + 1;
+
+    if (*pRunEnd == '\"')
+      break;
+
+    if (!ReadEscapeSequence(ref_decoded))
+      return false;
+
+    pRunStart = m_pCur;
+    pRunEnd = ezInternal::FindFirstOf(pRunStart, m_pEnd, '\"', '\\', '\"');
+
+    if (pRunEnd == m_pEnd)
+    {
+      ParsingError("While reading string: Reached end of document before end of string was found.");
+      return false;
+    }
+  }
+
+  out_sString = ezStringView(ref_decoded.GetData(), ref_decoded.GetData() + ref_decoded.GetCount());
+  return true;
+}
+
+bool ezJSONPullParser::ReadEscapeSequence(ezHybridArray<char, 256>& ref_decoded)
+{
+  if (m_pCur == m_pEnd)
+  {
+    ParsingError("While reading string: Reached end of document before end of string was found.");
+    return false;
+  }
+
+  const ezUInt8 uiEscaped = *m_pCur;
+  ++m_pCur;
+
+  switch (uiEscaped)
+  {
+    case '\"':
+    case '\\':
+    case '/':
+      ref_decoded.PushBack(static_cast<char>(uiEscaped));
+      return true;
+    case 'b':
+      ref_decoded.PushBack('\b');
+      return true;
+    case 'f':
+      ref_decoded.PushBack('\f');
+      return true;
+    case 'n':
+      ref_decoded.PushBack('\n');
+      return true;
+    case 'r':
+      ref_decoded.PushBack('\r');
+      return true;
+    case 't':
+      ref_decoded.PushBack('\t');
+      return true;
+
+    case 'u':
+    {
+      ezUInt16 cpt[2] = {0, 0};
+      if (!ReadUtf16CodeUnit(cpt[0]))
+        return false;
+
+      const ezUInt16* pStart = &cpt[0];
+      if (ezUnicodeUtils::IsUtf16Surrogate(pStart))
+      {
+        if (m_pEnd - m_pCur < 2 || m_pCur[0] != '\\' || m_pCur[1] != 'u')
+        {
+          ParsingError("Unicode surrogate must be followed by another unicode escape sequence");
+          return false;
+        }
+
+        m_pCur += 2;
+
+        if (!ReadUtf16CodeUnit(cpt[1]))
+          return false;
+      }
+
+      const ezUInt32 uiCodePoint = ezUnicodeUtils::DecodeUtf16ToUtf32(pStart);
+      ezUnicodeUtils::UtfInserter<char, ezHybridArray<char, 256>> inserter(&ref_decoded);
+      ezUnicodeUtils::EncodeUtf32ToUtf8(uiCodePoint, inserter);
+      return true;
+    }
+
+    default:
+    {
+      ezStringBuilder s;
+      s.Format("Unknown escape-sequence '\\{0}'", ezArgC(uiEscaped));
+      ParsingError(s);
+      return false;
+    }
+  }
+}
+
+bool ezJSONPullParser::ReadUtf16CodeUnit(ezUInt16& out_uiCodeUnit)
+{
+  // Unicode literals are utf16 in the format \uFFFF. The hex number FFFF can be upper or lower case but must be 4 characters long.
+  if (m_pEnd - m_pCur < 4)
+  {
+    ParsingError("Unicode literal is too short, must be 4 hex characters.");
+    return false;
+  }
+
+  ezUInt32 uiCodeUnit = 0;
+  for (ezUInt32 i = 0; i < 4; ++i)
+  {
+    ezUInt32 uiDigit = 0;
+    if (!HexToValue(m_pCur[i], uiDigit))
+    {
+      ParsingError("Unicode literal contains an invalid character.");
+      return false;
+    }
+
+    uiCodeUnit = (uiCodeUnit << 4) | uiDigit;
+  }
+
+  m_pCur += 4;
+  out_uiCodeUnit = static_cast<ezUInt16>(uiCodeUnit);
+  return true;
+}
+
+ezJSONPullParser::Token ezJSONPullParser::ReadNumber()
+{
+  const ezUInt8* p = m_pCur;
+
+  bool bNegative = false;
+  if (*p == '-' || *p == '+')
+  {
+    bNegative = (*p == '-');
+    ++p;
+  }
+
+  // accumulate up to 19 significant digits, which always fit into 64 bit
+  ezUInt64 uiMantissa = 0;
+  ezUInt32 uiSignificantDigits = 0;
+  ezInt32 iExponent = 0;
+  bool bAnyDigit = false;
+  bool bTruncated = false;
+
+  for (; p < m_pEnd && IsDigit(*p); ++p)
+  {
+    bAnyDigit = true;
+
+    if (uiSignificantDigits < 19)
+    {
+      uiMantissa = uiMantissa * 10 + (*p - '0');
+      uiSignificantDigits += (uiMantissa != 0) ? 1 : 0;
+    }
+    else
+    {
+      ++iExponent;
+      bTruncated = true;
+    }
+  }
+
+  if (p < m_pEnd && *p == '.')
+  {
+    ++p;
+
+    for (; p < m_pEnd && IsDigit(*p); ++p)
+    {
+      bAnyDigit = true;
+
+      if (uiSignificantDigits < 19)
+      {
+        uiMantissa = uiMantissa * 10 + (*p - '0');
+        uiSignificantDigits += (uiMantissa != 0) ? 1 : 0;
+        --iExponent;
+      }
+      else
+      {
+        bTruncated = true;
+      }
+    }
+  }
+
+  if (!bAnyDigit)
+    return ParsingError("Reading number failed: Expected at least one digit.");
+
+  if (p < m_pEnd && (*p == 'e' || *p == 'E'))
+  {
+    ++p;
+
+    bool bNegativeExponent = false;
+    if (p < m_pEnd && (*p == '-' || *p == '+'))
+    {
+      bNegativeExponent = (*p == '-');
+      ++p;
+    }
+
+    if (p == m_pEnd || !IsDigit(*p))
+      return ParsingError("Reading number failed: Expected digits after the exponent.");
+
+    ezInt32 iExplicitExponent = 0;
+    for (; p < m_pEnd && IsDigit(*p); ++p)
+    {
+      // larger exponents are out of range anyway
+      if (iExplicitExponent < 100000)
+        iExplicitExponent = iExplicitExponent * 10 + (*p - '0');
+    }
+
+    iExponent += bNegativeExponent ? -iExplicitExponent : iExplicitExponent;
+  }
+
+  m_pCur = p;
+
+  // Integers up to 2^53 and powers of ten up to 10^22 are exact doubles, so a single multiplication or division is correctly rounded.
+  if (!bTruncated && uiMantissa <= (1ull << 53) && iExponent >= -22 && iExponent <= 22)
+  {
+    double fValue = static_cast<double>(uiMantissa);
+    fValue = (iExponent < 0) ? fValue / s_PowersOf10[-iExponent] : fValue * s_PowersOf10[iExponent];
+
+    m_fNumber = bNegative ? -fValue : fValue;
+    return Token::Number;
+  }
+
+  // rare case, e.g. very long or very small numbers, which are only converted with a small rounding error
+  double fValue = static_cast<double>(uiMantissa);
+
+  if (iExponent < -300)
+  {
+    // 10^iExponent alone would underflow, even though the result may still be a denormalized number
+    fValue /= 1e300;
+    iExponent += 300;
+  }
+
+  fValue *= ezMath::Pow(10.0, static_cast<double>(iExponent));
+
+  m_fNumber = bNegative ? -fValue : fValue;
+  return Token::Number;
+}
+
+ezJSONPullParser::Token ezJSONPullParser::ReadWord()
+{
+  const ezUInt8* p = m_pCur;
+  while (p < m_pEnd && !IsEndOfWord(*p))
+    ++p;
+
+  const ezStringView sWord(reinterpret_cast<const char*>(m_pCur), reinterpret_cast<const char*>(p));
+  m_pCur = p;
+
+  if (sWord == "true")
+  {
+    m_bBool = true;
+    return Token::Bool;
+  }
+
+  if (sWord == "false")
+  {
+    m_bBool = false;
+    return Token::Bool;
+  }
+
+  if (sWord == "null")
+    return Token::Null;
+
+  ezStringBuilder s;
+  s.Format("Parsing value: Expected 'true', 'false' or 'null'. Got '{0}' instead.", sWord);
+  return ParsingError(s);
+}
+
+
+
+EZ_STATICLINK_FILE(Foundation, Foundation_IO_Implementation_JSONPullParser);
@@ -1,6 +1,8 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/IO/JSONPullParser.h>
 #include <Foundation/IO/JSONReader.h>
+#include <Foundation/Logging/Log.h>
 
 
 ezJSONReader::ezJSONReader()
@@ -20,6 +22,95 @@ ezResult ezJSONReader::Parse(ezStreamReader& InputStream, ezUInt32 uiFirstLineOf
   {
   }
 
+  return FinishParsing();
+}
+
+ezResult ezJSONReader::Parse(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset)
+{
+  m_bParsingError = false;
+  m_Stack.Clear();
+  m_sLastName.Clear();
+
+  ezJSONPullParser parser;
+  parser.SetLogInterface(m_pLogInterface);
+  parser.SetInputBuffer(data, uiFirstLineOffset);
+
+  // the callbacks expect zero-terminated strings
+  ezStringBuilder sTemp;
+
+  while (!m_bParsingError)
+  {
+    const ezJSONPullParser::Token token = parser.ReadNext();
+
+    if (token == ezJSONPullParser::Token::EndOfDocument)
+      break;
+
+    if (token == ezJSONPullParser::Token::Error)
+    {
+      OnParsingError(parser.GetErrorMessage(), true, parser.GetErrorLine(), parser.GetErrorColumn());
+      break;
+    }
+
+    if (m_Stack.IsEmpty())
+    {
+      if (token != ezJSONPullParser::Token::BeginObject)
+      {
+        const char* szMessage = "Start of document: Expected a { or an empty document.";
+        ezLog::Error(m_pLogInterface, "Line {0} ({1}): {2}", 1 + uiFirstLineOffset, 1, szMessage);
+        OnParsingError(szMessage, true, 1 + uiFirstLineOffset, 1);
+        break;
+      }
+    }
+    else if (m_Stack.PeekBack().m_Mode == ElementMode::Dictionary && token != ezJSONPullParser::Token::EndObject)
+    {
+      sTemp = parser.GetName();
+
+      if (!OnVariable(sTemp))
+      {
+        parser.SkipValue();
+        continue;
+      }
+    }
+
+    switch (token)
+    {
+      case ezJSONPullParser::Token::BeginObject:
+        OnBeginObject();
+        break;
+      case ezJSONPullParser::Token::EndObject:
+        OnEndObject();
+        break;
+      case ezJSONPullParser::Token::BeginArray:
+        OnBeginArray();
+        break;
+      case ezJSONPullParser::Token::EndArray:
+        OnEndArray();
+        break;
+      case ezJSONPullParser::Token::String:
+        sTemp = parser.GetString();
+        OnReadValue(sTemp.GetData());
+        break;
+      case ezJSONPullParser::Token::Number:
+        OnReadValue(parser.GetNumber());
+        break;
+      case ezJSONPullParser::Token::Bool:
+        OnReadValue(parser.GetBool());
+        break;
+      case ezJSONPullParser::Token::Null:
+        OnReadValueNULL();
+        break;
+
+      default:
+        EZ_ASSERT_NOT_IMPLEMENTED;
+        break;
+    }
+  }
+
+  return FinishParsing();
+}
+
+ezResult ezJSONReader::FinishParsing()
+{
   if (m_bParsingError)
   {
     m_Stack.Clear();
@@ -0,0 +1,499 @@
+#pragma once
+
+#include <Foundation/FoundationInternal.h>
+EZ_FOUNDATION_INTERNAL_HEADER
+
+#include <Foundation/Containers/HybridArray.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Logging/Log.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+/// \brief Minimal wrapper around an io_uring instance. liburing is not available, so the rings are set up through the raw system calls.
+class ezIoUring
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezIoUring);
+
+public:
+  ezIoUring() = default;
+  ~ezIoUring() { Deinit(); }
+
+  ezResult Init(ezUInt32 uiNumEntries);
+  void Deinit();
+
+  bool IsInitialized() const { return m_iRingFile >= 0; }
+
+  /// \brief Returns the number of submission queue entries, which is also the maximum number of reads that should be in flight.
+  ezUInt32 GetNumEntries() const { return m_uiNumEntries; }
+
+  /// \brief Queues a read into the submission queue. Returns false if the queue is full.
+  ///
+  /// \a out_uiPosition receives the position of the read in the submission queue, see WasSubmitted().
+  bool QueueRead(int iFile, iovec* pBuffer, ezUInt64 uiFileOffset, ezUInt64 uiUserData, ezUInt32& out_uiPosition);
+
+  /// \brief Submits all queued reads and waits until at least \a uiWaitForCompletions of them have completed.
+  ezResult Submit(ezUInt32 uiWaitForCompletions);
+
+  /// \brief Waits until at least \a uiWaitForCompletions reads have completed, without submitting any new ones.
+  ezResult WaitForCompletions(ezUInt32 uiWaitForCompletions);
+
+  /// \brief Returns whether the kernel has picked up the read at the given submission queue position. Only those reads will complete.
+  bool WasSubmitted(ezUInt32 uiPosition) const { return static_cast<ezInt32>(__atomic_load_n(m_pSqHead, __ATOMIC_ACQUIRE) - uiPosition) > 0; }
+
+  /// \brief Calls \a callback for every completion that is available.
+  template <typename Callback>
+  void ReapCompletions(Callback callback);
+
+private:
+  int m_iRingFile = -1;
+  ezUInt32 m_uiNumEntries = 0;
+
+  void* m_pSqRing = nullptr;
+  size_t m_uiSqRingSize = 0;
+  void* m_pCqRing = nullptr;
+  size_t m_uiCqRingSize = 0;
+  io_uring_sqe* m_pSqes = nullptr;
+  size_t m_uiSqesSize = 0;
+
+  ezUInt32* m_pSqHead = nullptr;
+  ezUInt32* m_pSqTail = nullptr;
+  ezUInt32* m_pSqRingMask = nullptr;
+  ezUInt32* m_pSqArray = nullptr;
+
+  ezUInt32* m_pCqHead = nullptr;
+  ezUInt32* m_pCqTail = nullptr;
+  ezUInt32* m_pCqRingMask = nullptr;
+  io_uring_cqe* m_pCqes = nullptr;
+};
+
+ezResult ezIoUring::Init(ezUInt32 uiNumEntries)
+{
+  io_uring_params params = {};
+
+  // fails with ENOSYS on kernels older than 5.1, or with EPERM when io_uring is disabled through sysctl or seccomp
+  m_iRingFile = static_cast<int>(syscall(__NR_io_uring_setup, uiNumEntries, &params));
+  if (m_iRingFile < 0)
+    return EZ_FAILURE;
+
+  m_uiNumEntries = params.sq_entries;
+  m_uiSqRingSize = params.sq_off.array + params.sq_entries * sizeof(ezUInt32);
+  m_uiCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  m_uiSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+  const bool bSingleMapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (bSingleMapping)
+  {
+    m_uiSqRingSize = ezMath::Max(m_uiSqRingSize, m_uiCqRingSize);
+    m_uiCqRingSize = m_uiSqRingSize;
+  }
+
+  m_pSqRing = mmap(nullptr, m_uiSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_iRingFile, IORING_OFF_SQ_RING);
+  if (m_pSqRing == MAP_FAILED)
+  {
+    m_pSqRing = nullptr;
+    Deinit();
+    return EZ_FAILURE;
+  }
+
+  if (bSingleMapping)
+  {
+    m_pCqRing = m_pSqRing;
+  }
+  else
+  {
+    m_pCqRing = mmap(nullptr, m_uiCqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_iRingFile, IORING_OFF_CQ_RING);
+    if (m_pCqRing == MAP_FAILED)
+    {
+      m_pCqRing = nullptr;
+      Deinit();
+      return EZ_FAILURE;
+    }
+  }
+
+  m_pSqes = static_cast<io_uring_sqe*>(mmap(nullptr, m_uiSqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_iRingFile, IORING_OFF_SQES));
+  if (m_pSqes == MAP_FAILED)
+  {
+    m_pSqes = nullptr;
+    Deinit();
+    return EZ_FAILURE;
+  }
+
+  ezUInt8* pSqRing = static_cast<ezUInt8*>(m_pSqRing);
+  m_pSqHead = reinterpret_cast<ezUInt32*>(pSqRing + params.sq_off.head);
+  m_pSqTail = reinterpret_cast<ezUInt32*>(pSqRing + params.sq_off.tail);
+  m_pSqRingMask = reinterpret_cast<ezUInt32*>(pSqRing + params.sq_off.ring_mask);
+  m_pSqArray = reinterpret_cast<ezUInt32*>(pSqRing + params.sq_off.array);
+
+  ezUInt8* pCqRing = static_cast<ezUInt8*>(m_pCqRing);
+  m_pCqHead = reinterpret_cast<ezUInt32*>(pCqRing + params.cq_off.head);
+  m_pCqTail = reinterpret_cast<ezUInt32*>(pCqRing + params.cq_off.tail);
+  m_pCqRingMask = reinterpret_cast<ezUInt32*>(pCqRing + params.cq_off.ring_mask);
+  m_pCqes = reinterpret_cast<io_uring_cqe*>(pCqRing + params.cq_off.cqes);
+
+  return EZ_SUCCESS;
+}
+
+void ezIoUring::Deinit()
+{
+  if (m_pSqes != nullptr)
+    munmap(m_pSqes, m_uiSqesSize);
+
+  if (m_pCqRing != nullptr && m_pCqRing != m_pSqRing)
+    munmap(m_pCqRing, m_uiCqRingSize);
+
+  if (m_pSqRing != nullptr)
+    munmap(m_pSqRing, m_uiSqRingSize);
+
+  if (m_iRingFile >= 0)
+    close(m_iRingFile);
+
+  m_pSqes = nullptr;
+  m_pCqRing = nullptr;
+  m_pSqRing = nullptr;
+  m_iRingFile = -1;
+  m_uiNumEntries = 0;
+}
+
+bool ezIoUring::QueueRead(int iFile, iovec* pBuffer, ezUInt64 uiFileOffset, ezUInt64 uiUserData, ezUInt32& out_uiPosition)
+{
+  // the tail is only ever written by us, the head is advanced by the kernel
+  const ezUInt32 uiTail = *m_pSqTail;
+  if (uiTail - __atomic_load_n(m_pSqHead, __ATOMIC_ACQUIRE) >= m_uiNumEntries)
+    return false;
+
+  const ezUInt32 uiIndex = uiTail & *m_pSqRingMask;
+
+  io_uring_sqe* pSqe = &m_pSqes[uiIndex];
+  ezMemoryUtils::ZeroFill(pSqe, 1);
+  pSqe->opcode = IORING_OP_READV;
+  pSqe->fd = iFile;
+  pSqe->off = uiFileOffset;
+  pSqe->addr = reinterpret_cast<ezUInt64>(pBuffer);
+  pSqe->len = 1;
+  pSqe->user_data = uiUserData;
+
+  m_pSqArray[uiIndex] = uiIndex;
+  out_uiPosition = uiTail;
+
+  // the entry must be fully written before the kernel can see it
+  __atomic_store_n(m_pSqTail, uiTail + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+ezResult ezIoUring::Submit(ezUInt32 uiWaitForCompletions)
+{
+  while (true)
+  {
+    const ezUInt32 uiToSubmit = *m_pSqTail - __atomic_load_n(m_pSqHead, __ATOMIC_ACQUIRE);
+    const ezUInt32 uiFlags = uiWaitForCompletions > 0 ? IORING_ENTER_GETEVENTS : 0;
+
+    if (syscall(__NR_io_uring_enter, m_iRingFile, uiToSubmit, uiWaitForCompletions, uiFlags, nullptr, 0) >= 0)
+      return EZ_SUCCESS;
+
+    // EAGAIN and EBUSY mean that the kernel is temporarily out of resources or the completion queue is full
+    if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+    {
+      ezLog::Error("io_uring_enter failed, errno: {0}", errno);
+      return EZ_FAILURE;
+    }
+  }
+}
+
+ezResult ezIoUring::WaitForCompletions(ezUInt32 uiWaitForCompletions)
+{
+  while (true)
+  {
+    if (syscall(__NR_io_uring_enter, m_iRingFile, 0, uiWaitForCompletions, IORING_ENTER_GETEVENTS, nullptr, 0) >= 0)
+      return EZ_SUCCESS;
+
+    if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+    {
+      ezLog::Error("io_uring_enter failed, errno: {0}", errno);
+      return EZ_FAILURE;
+    }
+  }
+}
+
+template <typename Callback>
+void ezIoUring::ReapCompletions(Callback callback)
+{
+  ezUInt32 uiHead = *m_pCqHead;
+  const ezUInt32 uiTail = __atomic_load_n(m_pCqTail, __ATOMIC_ACQUIRE);
+
+  while (uiHead != uiTail)
+  {
+    const io_uring_cqe cqe = m_pCqes[uiHead & *m_pCqRingMask];
+    ++uiHead;
+
+    // hand the entry back to the kernel right away, the callback might queue new reads
+    __atomic_store_n(m_pCqHead, uiHead, __ATOMIC_RELEASE);
+
+    callback(cqe);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+struct ezAsyncFileReaderImpl
+{
+  static bool IsSupported();
+  static void ReadFiles(ezArrayPtr<ezAsyncFileRead> requests, ezAsyncFileReaderDetail::RequestFinisher& finisher);
+
+  /// Opens the file and allocates the buffer for its content. Returns a file descriptor for reading the content.
+  ///
+  /// Returns -1, if the file doesn't exist or can't be read directly by the OS. In the latter case it is read right away through the file system.
+  static int OpenFile(ezAsyncFileRead& request);
+
+  /// Returns the ring of the calling thread, or nullptr if it can't be set up.
+  static ezIoUring* GetThreadRing();
+
+  static constexpr ezUInt32 s_uiMaxReadsInFlight = 64;
+};
+
+// static
+bool ezAsyncFileReaderImpl::IsSupported()
+{
+  static const bool s_bSupported = []() {
+    ezIoUring ring;
+    return ring.Init(1).Succeeded();
+  }();
+
+  return s_bSupported;
+}
+
+// static
+int ezAsyncFileReaderImpl::OpenFile(ezAsyncFileRead& request)
+{
+  ezAsyncFileReaderDetail::FileHandleReader file;
+  if (!ezAsyncFileReaderDetail::OpenFile(file, request))
+    return -1;
+
+  // io_uring reads at explicit offsets, so it can share the file with the reader, but it needs its own descriptor once the reader is closed
+  int iFile = -1;
+
+  const ezOSFile* pOSFile = file.GetOSFile();
+  if (pOSFile != nullptr && pOSFile->GetFileData().m_pFileHandle != nullptr)
+  {
+    iFile = fcntl(fileno(pOSFile->GetFileData().m_pFileHandle), F_DUPFD_CLOEXEC, 0);
+
+    struct stat info = {};
+    if (iFile >= 0 && (fstat(iFile, &info) != 0 || !S_ISREG(info.st_mode)))
+    {
+      close(iFile);
+      iFile = -1;
+    }
+  }
+
+  if (iFile < 0)
+  {
+    // e.g. files inside of archives can't be read by the OS
+    if (file.ReadBytes(request.m_Data.GetData(), request.m_Data.GetCount()) == request.m_Data.GetCount())
+    {
+      request.m_Result = EZ_SUCCESS;
+    }
+  }
+
+  return iFile;
+}
+
+// static
+ezIoUring* ezAsyncFileReaderImpl::GetThreadRing()
+{
+  // setting up a ring takes several system calls and memory mappings, so every thread keeps its ring for all following batches
+  thread_local ezIoUring s_Ring;
+
+  if (!s_Ring.IsInitialized() && s_Ring.Init(s_uiMaxReadsInFlight).Failed())
+    return nullptr;
+
+  return &s_Ring;
+}
+
+// static
+void ezAsyncFileReaderImpl::ReadFiles(ezArrayPtr<ezAsyncFileRead> requests, ezAsyncFileReaderDetail::RequestFinisher& finisher)
+{
+  ezIoUring* pRing = GetThreadRing();
+  if (pRing == nullptr)
+  {
+    for (ezAsyncFileRead& request : requests)
+    {
+      ezAsyncFileReaderDetail::ReadFileBlocking(request);
+      finisher.Finish(request);
+    }
+
+    return;
+  }
+
+  ezIoUring& ring = *pRing;
+
+  struct InFlightRead
+  {
+    ezAsyncFileRead* m_pRequest = nullptr;
+    int m_iFile = -1;
+    ezUInt32 m_uiSubmissionPosition = 0;
+    ezUInt64 m_uiBytesRead = 0;
+    iovec m_Buffer = {};
+  };
+
+  const ezUInt32 uiMaxInFlight = ezMath::Min(ring.GetNumEntries(), s_uiMaxReadsInFlight);
+
+  ezHybridArray<InFlightRead, s_uiMaxReadsInFlight> inFlight;
+  ezHybridArray<ezUInt32, s_uiMaxReadsInFlight> freeSlots;
+  inFlight.SetCount(uiMaxInFlight);
+
+  for (ezUInt32 i = uiMaxInFlight; i > 0; --i)
+  {
+    freeSlots.PushBack(i - 1);
+  }
+
+  auto QueueNextRead = [&](ezUInt32 uiSlot) {
+    InFlightRead& read = inFlight[uiSlot];
+    ezUInt8* pData = read.m_pRequest->m_Data.GetData();
+
+    read.m_Buffer.iov_base = pData + read.m_uiBytesRead;
+    read.m_Buffer.iov_len = read.m_pRequest->m_Data.GetCount() - read.m_uiBytesRead;
+
+    // can't fail, there are never more reads in flight than the queue has entries
+    EZ_VERIFY(ring.QueueRead(read.m_iFile, &read.m_Buffer, read.m_uiBytesRead, uiSlot, read.m_uiSubmissionPosition), "io_uring submission queue is full");
+  };
+
+  auto FinishRead = [&](ezUInt32 uiSlot, bool bSuccess) {
+    InFlightRead& read = inFlight[uiSlot];
+    close(read.m_iFile);
+
+    if (bSuccess)
+      read.m_pRequest->m_Result = EZ_SUCCESS;
+    else
+      ezAsyncFileReaderDetail::ReadFileBlocking(*read.m_pRequest);
+
+    finisher.Finish(*read.m_pRequest);
+
+    read = InFlightRead();
+    freeSlots.PushBack(uiSlot);
+  };
+
+  ezUInt32 uiNextRequest = 0;
+
+  // Used when the ring fails. The kernel may still write into the buffers of all reads that it has picked up, so those have to complete
+  // before their requests can be finished. All other requests are read through the file system instead.
+  auto AbortAllReads = [&]() {
+    while (true)
+    {
+      ring.ReapCompletions([&](const io_uring_cqe& cqe) {
+        const ezUInt32 uiSlot = static_cast<ezUInt32>(cqe.user_data);
+        InFlightRead& read = inFlight[uiSlot];
+
+        if (cqe.res > 0)
+          read.m_uiBytesRead += static_cast<ezUInt64>(cqe.res);
+
+        FinishRead(uiSlot, read.m_uiBytesRead == read.m_pRequest->m_Data.GetCount());
+      });
+
+      ezUInt32 uiNumPending = 0;
+      for (const InFlightRead& read : inFlight)
+      {
+        if (read.m_pRequest != nullptr && ring.WasSubmitted(read.m_uiSubmissionPosition))
+          ++uiNumPending;
+      }
+
+      if (uiNumPending == 0 || ring.WaitForCompletions(1).Failed())
+        break;
+    }
+
+    for (ezUInt32 uiSlot = 0; uiSlot < uiMaxInFlight; ++uiSlot)
+    {
+      InFlightRead& read = inFlight[uiSlot];
+      if (read.m_pRequest == nullptr)
+        continue;
+
+      if (ring.WasSubmitted(read.m_uiSubmissionPosition))
+      {
+        // waiting for the read failed, its buffer must never be freed or reused, since the kernel might still write into it
+        ezDynamicArray<ezUInt8>* pAbandonedBuffer = EZ_DEFAULT_NEW(ezDynamicArray<ezUInt8>);
+        pAbandonedBuffer->Swap(read.m_pRequest->m_Data);
+      }
+
+      FinishRead(uiSlot, false);
+    }
+
+    // don't reuse a ring that failed
+    ring.Deinit();
+
+    while (uiNextRequest < requests.GetCount())
+    {
+      ezAsyncFileRead& request = requests[uiNextRequest++];
+      ezAsyncFileReaderDetail::ReadFileBlocking(request);
+      finisher.Finish(request);
+    }
+  };
+
+  while (uiNextRequest < requests.GetCount() || freeSlots.GetCount() < uiMaxInFlight)
+  {
+    // keep as many reads in flight as possible
+    while (uiNextRequest < requests.GetCount() && !freeSlots.IsEmpty())
+    {
+      ezAsyncFileRead& request = requests[uiNextRequest++];
+
+      const int iFile = OpenFile(request);
+      if (iFile < 0)
+      {
+        finisher.Finish(request);
+        continue;
+      }
+
+      if (request.m_Data.IsEmpty())
+      {
+        close(iFile);
+        request.m_Result = EZ_SUCCESS;
+        finisher.Finish(request);
+        continue;
+      }
+
+      const ezUInt32 uiSlot = freeSlots.PeekBack();
+      freeSlots.PopBack();
+
+      inFlight[uiSlot].m_pRequest = &request;
+      inFlight[uiSlot].m_iFile = iFile;
+      QueueNextRead(uiSlot);
+    }
+
+    if (freeSlots.GetCount() == uiMaxInFlight)
+      continue;
+
+    if (ring.Submit(1).Failed())
+    {
+      AbortAllReads();
+      return;
+    }
+
+    ring.ReapCompletions([&](const io_uring_cqe& cqe) {
+      const ezUInt32 uiSlot = static_cast<ezUInt32>(cqe.user_data);
+      InFlightRead& read = inFlight[uiSlot];
+
+      if (cqe.res <= 0)
+      {
+        // an error or the file got shorter in the mean time, let the file system handle it
+        FinishRead(uiSlot, false);
+        return;
+      }
+
+      read.m_uiBytesRead += static_cast<ezUInt64>(cqe.res);
+
+      if (read.m_uiBytesRead < read.m_pRequest->m_Data.GetCount())
+      {
+        // short read, e.g. for very large files
+        QueueNextRead(uiSlot);
+        return;
+      }
+
+      FinishRead(uiSlot, true);
+    });
+  }
+}
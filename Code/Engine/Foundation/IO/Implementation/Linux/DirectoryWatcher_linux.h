@@ -0,0 +1,286 @@
+#pragma once
+
+#include <Foundation/FoundationInternal.h>
+EZ_FOUNDATION_INTERNAL_HEADER
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/IO/DirectoryWatcher.h>
+#include <Foundation/Logging/Log.h>
+
+#include <dirent.h>
+#include <errno.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct ezDirectoryWatcherImpl
+{
+  /// Watches the given directory and, if requested, all its sub-directories. The files found along the way are added to \a pFoundFiles.
+  void AddWatch(const char* szRelativePath, ezDynamicArray<ezString>* pFoundFiles);
+  void RemoveWatches(const char* szRelativePath);
+  void RemoveAllWatches();
+
+  int m_iFileDescriptor = -1;
+  bool m_bWatchSubdirs = false;
+  ezUInt32 m_uiMask = 0;
+  ezUInt32 m_uiReportMask = 0;
+  ezString m_sRootPath;
+
+  // inotify is not recursive, every directory has its own watch descriptor
+  ezHashTable<int, ezString> m_WatchToRelativePath;
+  ezDynamicArray<ezUInt8> m_Buffer;
+};
+
+void ezDirectoryWatcherImpl::AddWatch(const char* szRelativePath, ezDynamicArray<ezString>* pFoundFiles)
+{
+  ezStringBuilder sAbsolutePath = m_sRootPath;
+  sAbsolutePath.AppendPath(szRelativePath);
+
+  const int iWatch = inotify_add_watch(m_iFileDescriptor, sAbsolutePath, m_uiMask | IN_ONLYDIR | IN_DONT_FOLLOW);
+  if (iWatch < 0)
+  {
+    // typically ENOSPC, which means that fs.inotify.max_user_watches is exhausted
+    ezLog::Warning("Failed to watch directory '{0}', errno: {1}", sAbsolutePath, errno);
+    return;
+  }
+
+  m_WatchToRelativePath[iWatch] = szRelativePath;
+
+  if (!m_bWatchSubdirs && pFoundFiles == nullptr)
+    return;
+
+  DIR* pDir = opendir(sAbsolutePath);
+  if (pDir == nullptr)
+    return;
+
+  ezStringBuilder sChildPath;
+  while (const dirent* pEntry = readdir(pDir))
+  {
+    if (ezStringUtils::IsEqual(pEntry->d_name, ".") || ezStringUtils::IsEqual(pEntry->d_name, ".."))
+      continue;
+
+    bool bIsDirectory = pEntry->d_type == DT_DIR;
+
+    // not every file system fills out d_type
+    if (pEntry->d_type == DT_UNKNOWN)
+    {
+      sChildPath = sAbsolutePath;
+      sChildPath.AppendPath(pEntry->d_name);
+
+      struct stat info = {};
+      bIsDirectory = lstat(sChildPath, &info) == 0 && S_ISDIR(info.st_mode);
+    }
+
+    sChildPath = szRelativePath;
+    sChildPath.AppendPath(pEntry->d_name);
+
+    if (!bIsDirectory)
+    {
+      if (pFoundFiles != nullptr)
+        pFoundFiles->PushBack(sChildPath);
+    }
+    else if (m_bWatchSubdirs)
+    {
+      AddWatch(sChildPath, pFoundFiles);
+    }
+  }
+
+  closedir(pDir);
+}
+
+void ezDirectoryWatcherImpl::RemoveWatches(const char* szRelativePath)
+{
+  const ezUInt32 uiPathLength = ezStringUtils::GetStringElementCount(szRelativePath);
+
+  ezHybridArray<int, 16> watchesToRemove;
+  for (auto it = m_WatchToRelativePath.GetIterator(); it.IsValid(); ++it)
+  {
+    const ezString& sPath = it.Value();
+    if (sPath.StartsWith(szRelativePath) && (sPath.GetElementCount() == uiPathLength || sPath.GetData()[uiPathLength] == '/'))
+    {
+      watchesToRemove.PushBack(it.Key());
+    }
+  }
+
+  for (int iWatch : watchesToRemove)
+  {
+    inotify_rm_watch(m_iFileDescriptor, iWatch);
+    m_WatchToRelativePath.Remove(iWatch);
+  }
+}
+
+void ezDirectoryWatcherImpl::RemoveAllWatches()
+{
+  for (auto it = m_WatchToRelativePath.GetIterator(); it.IsValid(); ++it)
+  {
+    inotify_rm_watch(m_iFileDescriptor, it.Key());
+  }
+
+  m_WatchToRelativePath.Clear();
+}
+
+ezDirectoryWatcher::ezDirectoryWatcher()
+  : m_pImpl(EZ_DEFAULT_NEW(ezDirectoryWatcherImpl))
+{
+  m_pImpl->m_Buffer.SetCountUninitialized(64 * 1024);
+}
+
+ezResult ezDirectoryWatcher::OpenDirectory(const ezString& absolutePath, ezBitflags<Watch> whatToWatch)
+{
+  EZ_ASSERT_DEV(m_sDirectoryPath.IsEmpty(), "Directory already open, call CloseDirectory first!");
+  ezStringBuilder sPath(absolutePath);
+  sPath.MakeCleanPath();
+  sPath.Trim("", "/");
+
+  m_pImpl->m_uiReportMask = 0;
+  if (whatToWatch.IsSet(Watch::Reads))
+    m_pImpl->m_uiReportMask |= IN_ACCESS;
+  if (whatToWatch.IsSet(Watch::Writes))
+    m_pImpl->m_uiReportMask |= IN_MODIFY;
+  if (whatToWatch.IsSet(Watch::Creates))
+    m_pImpl->m_uiReportMask |= IN_CREATE;
+  if (whatToWatch.IsSet(Watch::Renames))
+    m_pImpl->m_uiReportMask |= IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE;
+
+  m_pImpl->m_bWatchSubdirs = whatToWatch.IsSet(Watch::Subdirectories);
+  m_pImpl->m_uiMask = m_pImpl->m_uiReportMask;
+
+  // new sub-directories need to be watched as well, the watches of moved sub-directories are recreated
+  if (m_pImpl->m_bWatchSubdirs)
+    m_pImpl->m_uiMask |= IN_CREATE | IN_MOVED_TO | IN_MOVED_FROM;
+
+  m_pImpl->m_iFileDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (m_pImpl->m_iFileDescriptor < 0)
+  {
+    return EZ_FAILURE;
+  }
+
+  m_pImpl->m_sRootPath = sPath;
+  m_pImpl->AddWatch("", nullptr);
+
+  if (m_pImpl->m_WatchToRelativePath.IsEmpty())
+  {
+    close(m_pImpl->m_iFileDescriptor);
+    m_pImpl->m_iFileDescriptor = -1;
+    return EZ_FAILURE;
+  }
+
+  m_sDirectoryPath = sPath;
+
+  return EZ_SUCCESS;
+}
+
+void ezDirectoryWatcher::CloseDirectory()
+{
+  if (!m_sDirectoryPath.IsEmpty())
+  {
+    m_pImpl->RemoveAllWatches();
+    close(m_pImpl->m_iFileDescriptor);
+    m_pImpl->m_iFileDescriptor = -1;
+    m_sDirectoryPath.Clear();
+  }
+}
+
+ezDirectoryWatcher::~ezDirectoryWatcher()
+{
+  CloseDirectory();
+  EZ_DEFAULT_DELETE(m_pImpl);
+}
+
+void ezDirectoryWatcher::EnumerateChanges(EnumerateChangesFunction func)
+{
+  EZ_ASSERT_DEV(!m_sDirectoryPath.IsEmpty(), "No directory opened!");
+
+  m_bMissedChanges = false;
+
+  ezStringBuilder sPath;
+  ezDynamicArray<ezString> foundFiles;
+
+  while (true)
+  {
+    const ssize_t iNumBytes = read(m_pImpl->m_iFileDescriptor, m_pImpl->m_Buffer.GetData(), m_pImpl->m_Buffer.GetCount());
+    if (iNumBytes <= 0)
+    {
+      if (iNumBytes < 0 && errno == EINTR)
+        continue;
+
+      EZ_ASSERT_DEV(iNumBytes == 0 || errno == EAGAIN, "Reading inotify events failed, errno: {0}", errno);
+      break;
+    }
+
+    const ezUInt8* pCur = m_pImpl->m_Buffer.GetData();
+    const ezUInt8* pEnd = pCur + iNumBytes;
+
+    while (pCur < pEnd)
+    {
+      const inotify_event* pEvent = reinterpret_cast<const inotify_event*>(pCur);
+      pCur += sizeof(inotify_event) + pEvent->len;
+
+      if (pEvent->mask & IN_Q_OVERFLOW)
+      {
+        ezLog::Warning("Too many changes in directory '{0}', some of them were not reported", m_sDirectoryPath);
+
+        // sub-directories might have been created or moved without us noticing, so all watches are recreated
+        m_bMissedChanges = true;
+        m_pImpl->RemoveAllWatches();
+        m_pImpl->AddWatch("", nullptr);
+        continue;
+      }
+
+      if (pEvent->mask & IN_IGNORED)
+      {
+        // the directory was removed, or the watch was removed explicitly
+        m_pImpl->m_WatchToRelativePath.Remove(pEvent->wd);
+        continue;
+      }
+
+      const ezString* pDirectory = m_pImpl->m_WatchToRelativePath.GetValue(pEvent->wd);
+      if (pDirectory == nullptr)
+        continue;
+
+      sPath = *pDirectory;
+      if (pEvent->len > 0)
+        sPath.AppendPath(pEvent->name);
+
+      foundFiles.Clear();
+
+      if (m_pImpl->m_bWatchSubdirs && (pEvent->mask & IN_ISDIR))
+      {
+        if (pEvent->mask & IN_MOVED_FROM)
+        {
+          // the watches of a moved directory would keep reporting the old path, if it stays inside the watched directory,
+          // it gets new watches through the IN_MOVED_TO event
+          m_pImpl->RemoveWatches(sPath);
+        }
+        else if (pEvent->mask & (IN_CREATE | IN_MOVED_TO))
+        {
+          // files that were created in the new directory before it was watched have to be reported as well
+          m_pImpl->AddWatch(sPath, &foundFiles);
+        }
+      }
+
+      if ((pEvent->mask & m_pImpl->m_uiReportMask) == 0)
+        continue;
+
+      ezDirectoryWatcherAction action = ezDirectoryWatcherAction::None;
+      if (pEvent->mask & IN_CREATE)
+        action = ezDirectoryWatcherAction::Added;
+      else if (pEvent->mask & IN_DELETE)
+        action = ezDirectoryWatcherAction::Removed;
+      else if (pEvent->mask & (IN_MODIFY | IN_ACCESS))
+        action = ezDirectoryWatcherAction::Modified;
+      else if (pEvent->mask & IN_MOVED_FROM)
+        action = ezDirectoryWatcherAction::RenamedOldName;
+      else if (pEvent->mask & IN_MOVED_TO)
+        action = ezDirectoryWatcherAction::RenamedNewName;
+
+      func(sPath, action);
+
+      for (const ezString& sFoundFile : foundFiles)
+      {
+        func(sFoundFile, ezDirectoryWatcherAction::Added);
+      }
+    }
+  }
+}
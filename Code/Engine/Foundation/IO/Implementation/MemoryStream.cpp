@@ -40,6 +40,20 @@ ezUInt64 ezMemoryStreamReader::SkipBytes(ezUInt64 uiBytesToSkip)
   return uiBytes;
 }
 
+bool ezMemoryStreamReader::GetRemainingContiguousData(ezArrayPtr<const ezUInt8>& out_Data) const
+{
+  EZ_ASSERT_RELEASE(m_pStreamStorage != nullptr, "The memory stream reader needs a valid memory storage object!");
+
+  const ezUInt32 uiStorageSize = m_pStreamStorage->GetStorageSize();
+
+  if (m_uiReadPosition < uiStorageSize)
+    out_Data = ezArrayPtr<const ezUInt8>(m_pStreamStorage->GetInternalData() + m_uiReadPosition, uiStorageSize - m_uiReadPosition);
+  else
+    out_Data = ezArrayPtr<const ezUInt8>();
+
+  return true;
+}
+
 void ezMemoryStreamReader::SetReadPosition(ezUInt32 uiReadPosition)
 {
   EZ_ASSERT_RELEASE(uiReadPosition <= GetByteCount(), "Read position must be between 0 and GetByteCount()!");
@@ -185,6 +199,18 @@ ezUInt64 ezRawMemoryStreamReader::SkipBytes(ezUInt64 uiBytesToSkip)
   return uiBytes;
 }
 
+bool ezRawMemoryStreamReader::GetRemainingContiguousData(ezArrayPtr<const ezUInt8>& out_Data) const
+{
+  const ezUInt64 uiRemaining = m_uiChunkSize - m_uiReadPosition;
+
+  // ezArrayPtr can't address more than that
+  if (uiRemaining > ezMath::MaxValue<ezUInt32>())
+    return false;
+
+  out_Data = ezArrayPtr<const ezUInt8>(m_pRawMemory + m_uiReadPosition, static_cast<ezUInt32>(uiRemaining));
+  return true;
+}
+
 void ezRawMemoryStreamReader::SetReadPosition(ezUInt64 uiReadPosition)
 {
   EZ_ASSERT_RELEASE(uiReadPosition < GetByteCount(), "Read position must be between 0 and GetByteCount()!");
@@ -1,5 +1,6 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/IO/Implementation/TextScanning.h>
 #include <Foundation/IO/OpenDdlParser.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Utilities/ConversionUtils.h>
@@ -7,6 +8,9 @@
 ezOpenDdlParser::ezOpenDdlParser()
 {
   m_pLogInterface = nullptr;
+  m_pInput = nullptr;
+  m_pInputBuffer = nullptr;
+  m_pInputBufferEnd = nullptr;
   m_bHadFatalParsingError = false;
 }
 
@@ -42,6 +46,22 @@ void ezOpenDdlParser::SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLin
 
   m_pInput = &stream;
 
+  InitializeInput(uiFirstLineOffset);
+}
+
+void ezOpenDdlParser::SetInputBuffer(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset /*= 0*/)
+{
+  EZ_ASSERT_DEV(m_StateStack.IsEmpty(), "OpenDDL Parser cannot be restarted");
+
+  m_pInput = nullptr;
+  m_pInputBuffer = data.GetPtr();
+  m_pInputBufferEnd = data.GetPtr() + data.GetCount();
+
+  InitializeInput(uiFirstLineOffset);
+}
+
+void ezOpenDdlParser::InitializeInput(ezUInt32 uiFirstLineOffset)
+{
   m_bSkippingMode = false;
   m_uiCurLine = 1 + uiFirstLineOffset;
   m_uiCurColumn = 0;
@@ -185,7 +205,18 @@ void ezOpenDdlParser::ParsingError(const char* szMessage, bool bFatal)
 
 void ezOpenDdlParser::ReadNextByte()
 {
-  m_pInput->ReadBytes(&m_uiNextByte, sizeof(ezUInt8));
+  if (m_pInput == nullptr)
+  {
+    if (m_pInputBuffer < m_pInputBufferEnd)
+    {
+      m_uiNextByte = *m_pInputBuffer;
+      ++m_pInputBuffer;
+    }
+  }
+  else
+  {
+    m_pInput->ReadBytes(&m_uiNextByte, sizeof(ezUInt8));
+  }
 
   if (m_uiNextByte == '\n')
   {
@@ -196,6 +227,47 @@ void ezOpenDdlParser::ReadNextByte()
     ++m_uiCurColumn;
 }
 
+void ezOpenDdlParser::AdvanceInputBuffer(const ezUInt8* pNewPosition)
+{
+  // does the same line and column bookkeeping as ReadNextByte, for all skipped bytes at once
+  const ezUInt8* pCur = m_pInputBuffer;
+  const ezUInt8* pLastLineBreak = nullptr;
+
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+  const __m128i lineBreak = _mm_set1_epi8('\n');
+
+  while (pNewPosition - pCur >= 16)
+  {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCur));
+    const ezUInt32 uiLineBreakMask = static_cast<ezUInt32>(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, lineBreak)));
+
+    if (uiLineBreakMask != 0)
+    {
+      m_uiCurLine += ezMath::CountBits(uiLineBreakMask);
+      pLastLineBreak = pCur + ezMath::FirstBitHigh(uiLineBreakMask);
+    }
+
+    pCur += 16;
+  }
+#endif
+
+  for (; pCur < pNewPosition; ++pCur)
+  {
+    if (*pCur == '\n')
+    {
+      ++m_uiCurLine;
+      pLastLineBreak = pCur;
+    }
+  }
+
+  if (pLastLineBreak != nullptr)
+    m_uiCurColumn = static_cast<ezUInt32>(pNewPosition - pLastLineBreak - 1);
+  else
+    m_uiCurColumn += static_cast<ezUInt32>(pNewPosition - m_pInputBuffer);
+
+  m_pInputBuffer = pNewPosition;
+}
+
 bool ezOpenDdlParser::ReadCharacter()
 {
   m_uiCurByte = m_uiNextByte;
@@ -219,6 +291,12 @@ bool ezOpenDdlParser::ReadCharacterSkipComments()
     // line comment, read till line break
     if (m_uiNextByte == '/')
     {
+      if (m_pInput == nullptr)
+      {
+        // jump to the end of the line, the loop below then only reads the line break
+        AdvanceInputBuffer(ezInternal::FindFirstOf(m_pInputBuffer, m_pInputBufferEnd, '\n', '\0', '\0'));
+      }
+
       while (m_uiNextByte != '\0' && m_uiNextByte != '\n')
       {
         m_uiNextByte = '\0';
@@ -233,6 +311,17 @@ bool ezOpenDdlParser::ReadCharacterSkipComments()
 
       while (m_uiNextByte != '\0' && (m_uiCurByte != '*' || m_uiNextByte != '/'))
       {
+        if (m_pInput == nullptr && m_uiNextByte != '*')
+        {
+          // jump right before the next '*', nothing else can end the comment
+          const ezUInt8* pStar = ezInternal::FindFirstOf(m_pInputBuffer, m_pInputBufferEnd, '*', '\0', '\0');
+          if (pStar > m_pInputBuffer)
+          {
+            m_uiNextByte = pStar[-1];
+            AdvanceInputBuffer(pStar);
+          }
+        }
+
         m_uiCurByte = m_uiNextByte;
 
         m_uiNextByte = '\0';
@@ -255,6 +344,17 @@ void ezOpenDdlParser::SkipWhitespace()
 {
   do
   {
+    if (m_pInput == nullptr && ezStringUtils::IsWhiteSpace(m_uiNextByte))
+    {
+      // the upcoming bytes are whitespace as well, skip all but the last one
+      const ezUInt8* pEndOfWhitespace = ezInternal::FindEndOfWhitespace(m_pInputBuffer, m_pInputBufferEnd);
+      if (pEndOfWhitespace > m_pInputBuffer)
+      {
+        m_uiNextByte = pEndOfWhitespace[-1];
+        AdvanceInputBuffer(pEndOfWhitespace);
+      }
+    }
+
     m_uiCurByte = '\0';
 
     if (!ReadCharacterSkipComments())
@@ -597,6 +697,29 @@ void ezOpenDdlParser::ReadString()
   {
     const bool bEscapeSequence = (m_uiCurByte == '\\');
 
+    if (m_pInput == nullptr && !bEscapeSequence && m_uiNextByte != '\"' && m_uiNextByte != '\\' && m_uiNextByte != '\0')
+    {
+      // copy all characters up to the next quote or escape sequence at once
+      const ezUInt8* pRunEnd = ezInternal::FindFirstOf(m_pInputBuffer, m_pInputBufferEnd, '\"', '\\', '\0');
+      const ezUInt32 uiRunLength = 1 + static_cast<ezUInt32>(pRunEnd - m_pInputBuffer);
+
+      while (m_uiTempStringLength + uiRunLength + 2 >= m_TempString.GetCount())
+      {
+        m_TempString.SetCountUninitialized(m_TempString.GetCount() * 2);
+      }
+
+      m_TempString[m_uiTempStringLength] = m_uiNextByte;
+      ezMemoryUtils::Copy(&m_TempString[m_uiTempStringLength + 1], m_pInputBuffer, uiRunLength - 1);
+      m_uiTempStringLength += uiRunLength;
+
+      m_uiCurByte = uiRunLength > 1 ? pRunEnd[-1] : m_uiNextByte;
+      AdvanceInputBuffer(pRunEnd);
+
+      m_uiNextByte = '\0';
+      ReadNextByte();
+      continue;
+    }
+
     m_uiCurByte = '\0';
 
     if (!ReadCharacter())
@@ -21,6 +21,22 @@ ezResult ezOpenDdlReader::ParseDocument(ezStreamReader& stream, ezUInt32 uiFirst
   SetCacheSize(uiCacheSizeInKB);
   SetInputStream(stream, uiFirstLineOffset);
 
+  return ParseDocumentFromInput();
+}
+
+ezResult ezOpenDdlReader::ParseDocument(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset, ezLogInterface* pLog, ezUInt32 uiCacheSizeInKB)
+{
+  EZ_ASSERT_DEBUG(m_ObjectStack.IsEmpty(), "A reader can only be used once.");
+
+  SetLogInterface(pLog);
+  SetCacheSize(uiCacheSizeInKB);
+  SetInputBuffer(data, uiFirstLineOffset);
+
+  return ParseDocumentFromInput();
+}
+
+ezResult ezOpenDdlReader::ParseDocumentFromInput()
+{
   m_TempCache.Reserve(s_uiChunkSize);
 
   ezOpenDdlReaderElement* pElement = &m_Elements.ExpandAndGetRef();
@@ -55,9 +71,13 @@ const char* ezOpenDdlReader::CopyString(const ezStringView& string)
   if (string.IsEmpty())
     return nullptr;
 
-  // no idea how to make this more efficient without running into lots of other problems
-  m_Strings.PushBack(string);
-  return m_Strings.PeekBack().GetData();
+  // strings are stored in the same chunks as the primitive data, instead of allocating each one individually
+  const ezUInt32 uiNumBytes = string.GetElementCount();
+  char* szCopy = reinterpret_cast<char*>(AllocateBytes(uiNumBytes + 1));
+  ezMemoryUtils::Copy(szCopy, string.GetStartPointer(), uiNumBytes);
+  szCopy[uiNumBytes] = '\0';
+
+  return szCopy;
 }
 
 ezOpenDdlReaderElement* ezOpenDdlReader::CreateElement(ezOpenDdlPrimitiveType type, const char* szType, const char* szName, bool bGlobalName)
@@ -260,6 +280,9 @@ void ezOpenDdlReader::ClearDataChunks()
   }
 
   m_DataChunks.Clear();
+
+  m_pCurrentChunk = nullptr;
+  m_uiBytesInChunkLeft = 0;
 }
 
 ezUInt8* ezOpenDdlReader::AllocateBytes(ezUInt32 uiNumBytes)
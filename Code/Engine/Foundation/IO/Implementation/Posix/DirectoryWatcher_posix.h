@@ -2,28 +2,23 @@
 
 #include <Foundation/IO/DirectoryWatcher.h>
 
-struct ezDirectoryWatcherImpl
-{
-};
+// Not supported on this platform, callers need to handle OpenDirectory failing.
 
 ezDirectoryWatcher::ezDirectoryWatcher()
   : m_pImpl(nullptr)
 {
 }
 
-ezResult ezDirectoryWatcher::OpenDirectory(const ezString& path, ezBitflags<Watch> whatToWatch)
+ezResult ezDirectoryWatcher::OpenDirectory(const ezString& absolutePath, ezBitflags<Watch> whatToWatch)
 {
-  EZ_ASSERT_NOT_IMPLEMENTED
   return EZ_FAILURE;
 }
 
-void ezDirectoryWatcher::CloseDirectory(){EZ_ASSERT_NOT_IMPLEMENTED}
+void ezDirectoryWatcher::CloseDirectory() {}
 
 ezDirectoryWatcher::~ezDirectoryWatcher()
 {
+  CloseDirectory();
 }
 
-void ezDirectoryWatcher::EnumerateChanges(EnumerateChangesFunction func)
-{
-  EZ_ASSERT_NOT_IMPLEMENTED
-}
+void ezDirectoryWatcher::EnumerateChanges(EnumerateChangesFunction func) {}
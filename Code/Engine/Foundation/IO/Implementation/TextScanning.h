@@ -0,0 +1,66 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/SimdMath/SimdTypes.h>
+#include <Foundation/Strings/StringUtils.h>
+
+namespace ezInternal
+{
+  // The text parsers use these functions to skip over larger blocks of a buffer at once, 16 bytes at a time where SSE is available.
+
+  /// \brief Returns the first byte in the range that is not whitespace (as defined by ezStringUtils::IsWhiteSpace), or pEnd.
+  inline const ezUInt8* FindEndOfWhitespace(const ezUInt8* pCur, const ezUInt8* pEnd)
+  {
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i zero = _mm_setzero_si128();
+
+    while (pEnd - pCur >= 16)
+    {
+      const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCur));
+
+      // whitespace is everything from 1 to 32
+      const __m128i notAboveSpace = _mm_cmpeq_epi8(_mm_min_epu8(chars, space), chars);
+      const __m128i isZero = _mm_cmpeq_epi8(chars, zero);
+      const ezUInt32 uiWhitespaceMask = static_cast<ezUInt32>(_mm_movemask_epi8(_mm_andnot_si128(isZero, notAboveSpace)));
+
+      if (uiWhitespaceMask != 0xFFFF)
+        return pCur + ezMath::FirstBitLow(~uiWhitespaceMask);
+
+      pCur += 16;
+    }
+#endif
+
+    while (pCur < pEnd && ezStringUtils::IsWhiteSpace(*pCur))
+      ++pCur;
+
+    return pCur;
+  }
+
+  /// \brief Returns the first occurrence of any of the three given bytes in the range, or pEnd.
+  inline const ezUInt8* FindFirstOf(const ezUInt8* pCur, const ezUInt8* pEnd, ezUInt8 a, ezUInt8 b, ezUInt8 c)
+  {
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+    const __m128i va = _mm_set1_epi8(static_cast<char>(a));
+    const __m128i vb = _mm_set1_epi8(static_cast<char>(b));
+    const __m128i vc = _mm_set1_epi8(static_cast<char>(c));
+
+    while (pEnd - pCur >= 16)
+    {
+      const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pCur));
+      const __m128i found = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chars, va), _mm_cmpeq_epi8(chars, vb)), _mm_cmpeq_epi8(chars, vc));
+      const ezUInt32 uiFoundMask = static_cast<ezUInt32>(_mm_movemask_epi8(found));
+
+      if (uiFoundMask != 0)
+        return pCur + ezMath::FirstBitLow(uiFoundMask);
+
+      pCur += 16;
+    }
+#endif
+
+    while (pCur < pEnd && *pCur != a && *pCur != b && *pCur != c)
+      ++pCur;
+
+    return pCur;
+  }
+} // namespace ezInternal
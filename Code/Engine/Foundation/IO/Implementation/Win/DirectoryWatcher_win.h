@@ -92,6 +92,7 @@ void ezDirectoryWatcherImpl::DoRead()
 void ezDirectoryWatcher::EnumerateChanges(EnumerateChangesFunction func)
 {
   EZ_ASSERT_DEV(!m_sDirectoryPath.IsEmpty(), "No directory opened!");
+  m_bMissedChanges = false;
   OVERLAPPED* lpOverlapped;
   DWORD numberOfBytes;
   ULONG_PTR completionKey;
@@ -99,7 +100,9 @@ void ezDirectoryWatcher::EnumerateChanges(EnumerateChangesFunction func)
   {
     if (numberOfBytes <= 0)
     {
-      ezLog::Debug("GetQueuedCompletionStatus with size 0. Should not happen according to msdn.");
+      // ReadDirectoryChangesW reports a buffer overflow this way, all changes in between are lost
+      ezLog::Debug("GetQueuedCompletionStatus with size 0, some changes were not reported.");
+      m_bMissedChanges = true;
       m_pImpl->DoRead();
       continue;
     }
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Containers/HybridArray.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Types/ArrayPtr.h>
+
+class ezLogInterface;
+
+/// \brief A JSON parser that reads a document from a contiguous buffer, one value at a time.
+///
+/// In contrast to ezJSONParser, the caller pulls the structure of the document through ReadNext() instead of overriding callbacks.
+/// Names and strings without escape sequences are returned as views into the buffer and numbers are converted directly from the buffer,
+/// so nothing is copied or allocated per value. Whitespace, comments and strings are scanned 16 bytes at a time where SSE is available.
+/// This makes it suitable for very large documents, such as profiling captures.
+///
+/// Like ezJSONParser it accepts comments, superfluous commas in objects and one superfluous comma at the end of arrays.
+/// Unlike ezJSONParser, it does not allow comments inside of values, e.g. between the characters of a number or keyword.
+/// Any other deviation from the JSON syntax is a fatal error, after which ReadNext() only returns Token::Error.
+/// ezJSONReader::Parse() can use this parser to build its ezVariant representation of the document from a buffer.
+class EZ_FOUNDATION_DLL ezJSONPullParser
+{
+public:
+  enum class Token : ezUInt8
+  {
+    EndOfDocument,
+    BeginObject,
+    EndObject,
+    BeginArray,
+    EndArray,
+    String,
+    Number,
+    Bool,
+    Null,
+    Error,
+  };
+
+  ezJSONPullParser();
+
+  /// \brief Allows to specify an ezLogInterface through which errors are reported.
+  void SetLogInterface(ezLogInterface* pLog) { m_pLogInterface = pLog; }
+
+  /// \brief Resets the parser to the start state and configures it to read from the given buffer, which must stay valid while parsing.
+  void SetInputBuffer(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset = 0); // [tested]
+
+  /// \brief Reads the next value or the end of the current object or array.
+  ///
+  /// Values inside an object are returned together with their name, see GetName().
+  /// Returns Token::EndOfDocument once the top-level value has been read completely.
+  Token ReadNext(); // [tested]
+
+  /// \brief Skips the rest of the object or array that was started by the last call to ReadNext(), including its end token.
+  ///
+  /// Does nothing, if the last token did not begin an object or array.
+  void SkipValue(); // [tested]
+
+  /// \brief Returns the name of the last value, if it is part of an object. Returns an empty string for array elements and end tokens.
+  ///
+  /// The view is only valid until the next call to ReadNext().
+  ezStringView GetName() const { return m_sName; }
+
+  /// \brief Returns the value of the last Token::String. The view is only valid until the next call to ReadNext().
+  ezStringView GetString() const { return m_sString; }
+
+  /// \brief Returns the value of the last Token::Number.
+  double GetNumber() const { return m_fNumber; }
+
+  /// \brief Returns the value of the last Token::Bool.
+  bool GetBool() const { return m_bBool; }
+
+  /// \brief Returns the number of objects and arrays that are currently open.
+  ezUInt32 GetDepth() const { return m_Stack.GetCount(); }
+
+  /// \brief Returns whether a fatal parsing error occurred.
+  bool HadFatalParsingError() const { return m_bHadFatalParsingError; }
+
+  /// \brief Returns the message of the last parsing error and where it occurred.
+  const char* GetErrorMessage() const { return m_sErrorMessage.GetData(); }
+  ezUInt32 GetErrorLine() const { return m_uiErrorLine; }
+  ezUInt32 GetErrorColumn() const { return m_uiErrorColumn; }
+
+private:
+  Token ReadValue();
+  Token ParsingError(const char* szMessage);
+  void SkipWhitespace();
+  bool ReadString(ezHybridArray<char, 256>& ref_decoded, ezStringView& out_sString);
+  bool ReadEscapeSequence(ezHybridArray<char, 256>& ref_decoded);
+  bool ReadUtf16CodeUnit(ezUInt16& out_uiCodeUnit);
+  Token ReadNumber();
+  Token ReadWord();
+
+  ezLogInterface* m_pLogInterface = nullptr;
+
+  const ezUInt8* m_pBufferStart = nullptr;
+  const ezUInt8* m_pCur = nullptr;
+  const ezUInt8* m_pEnd = nullptr;
+  ezUInt32 m_uiFirstLineOffset = 0;
+
+  /// One entry for every open object (true) or array (false).
+  ezHybridArray<bool, 32> m_Stack;
+  bool m_bFirstElement = true;
+  bool m_bStarted = false;
+  bool m_bHadFatalParsingError = false;
+  Token m_LastToken = Token::EndOfDocument;
+
+  ezStringView m_sName;
+  ezStringView m_sString;
+  double m_fNumber = 0.0;
+  bool m_bBool = false;
+
+  // Names and strings that contain escape sequences are decoded into these buffers
+  ezHybridArray<char, 256> m_DecodedName;
+  ezHybridArray<char, 256> m_DecodedString;
+
+  ezStringBuilder m_sErrorMessage;
+  ezUInt32 m_uiErrorLine = 0;
+  ezUInt32 m_uiErrorColumn = 0;
+};
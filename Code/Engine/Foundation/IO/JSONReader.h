@@ -19,6 +19,12 @@ public:
   /// error occurred.
   ezResult Parse(ezStreamReader& pInput, ezUInt32 uiFirstLineOffset = 0);
 
+  /// \brief Same as above, but parses a document that is entirely in memory with ezJSONPullParser, which is a lot faster for large documents.
+  ///
+  /// Derived classes are called through the same virtual functions as when parsing from a stream. Returns EZ_FAILURE if any parsing error
+  /// occurred.
+  ezResult Parse(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset = 0); // [tested]
+
   /// \brief Returns the top-level object of the JSON document.
   const ezVariantDictionary& GetTopLevelObject() const { return m_Stack.PeekBack().m_Dictionary; }
 
@@ -52,6 +58,8 @@ private:
 
   virtual void OnParsingError(const char* szMessage, bool bFatal, ezUInt32 uiLine, ezUInt32 uiColumn) override;
 
+  ezResult FinishParsing();
+
 protected:
   enum class ElementMode : ezInt8
   {
@@ -182,6 +182,9 @@ public:
   /// \brief Skips bytes in the stream (e.g. for skipping objects which can't be serialized due to missing information etc.)
   virtual ezUInt64 SkipBytes(ezUInt64 uiBytesToSkip) override; // [tested]
 
+  /// \brief Returns the part of the storage that has not been read yet.
+  virtual bool GetRemainingContiguousData(ezArrayPtr<const ezUInt8>& out_Data) const override;
+
   /// \brief Sets the read position to be used
   void SetReadPosition(ezUInt32 uiReadPosition); // [tested]
 
@@ -288,6 +291,9 @@ public:
   /// \brief Skips bytes in the stream (e.g. for skipping objects which can't be serialized due to missing information etc.)
   virtual ezUInt64 SkipBytes(ezUInt64 uiBytesToSkip) override; // [tested]
 
+  /// \brief Returns the part of the memory chunk that has not been read yet.
+  virtual bool GetRemainingContiguousData(ezArrayPtr<const ezUInt8>& out_Data) const override;
+
   /// \brief Sets the read position to be used
   void SetReadPosition(ezUInt64 uiReadPosition); // [tested]
 
@@ -4,6 +4,7 @@
 #include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/IO/Stream.h>
+#include <Foundation/Types/ArrayPtr.h>
 
 class ezLogInterface;
 
@@ -54,6 +55,14 @@ protected:
   /// \brief Configures the parser to read from the given stream. This can only be called once on a parser instance.
   void SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLineOffset = 0); // [tested]
 
+  /// \brief Configures the parser to read from a contiguous block of memory, e.g. a loaded or memory-mapped file. This can only be called once on a
+  /// parser instance.
+  ///
+  /// The data must stay valid until parsing is finished. This is much faster than reading from a stream, since the parser doesn't need to request
+  /// every byte individually and can skip over whitespace, comments and strings in larger blocks. Parsing stops at the end of the buffer or at the
+  /// first null terminator, whichever comes first.
+  void SetInputBuffer(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset = 0); // [tested]
+
   /// \brief Call this to parse the next piece of the document. This may trigger a callback through which data is returned.
   ///
   /// This function returns false when the end of the document has been reached, or a fatal parsing error has been reported.
@@ -160,7 +169,9 @@ private:
     State m_State;
   };
 
+  void InitializeInput(ezUInt32 uiFirstLineOffset);
   void ReadNextByte();
+  void AdvanceInputBuffer(const ezUInt8* pNewPosition);
   bool ReadCharacter();
   bool ReadCharacterSkipComments();
   void SkipWhitespace();
@@ -182,6 +193,8 @@ private:
 
   ezHybridArray<DdlState, 32> m_StateStack;
   ezStreamReader* m_pInput;
+  const ezUInt8* m_pInputBuffer;
+  const ezUInt8* m_pInputBufferEnd;
   ezDynamicArray<ezUInt8> m_Cache;
 
   static const ezUInt32 s_uiMaxIdentifierLength = 64;
@@ -130,6 +130,12 @@ public:
   ezResult ParseDocument(ezStreamReader& stream, ezUInt32 uiFirstLineOffset = 0, ezLogInterface* pLog = ezLog::GetThreadLocalLogSystem(),
     ezUInt32 uiCacheSizeInKB = 4); // [tested]
 
+  /// \brief Same as the stream version, but parses a document that is entirely in memory, which is much faster.
+  ///
+  /// The data only needs to stay valid during this call, all strings are copied into the reader.
+  ezResult ParseDocument(ezArrayPtr<const ezUInt8> data, ezUInt32 uiFirstLineOffset = 0, ezLogInterface* pLog = ezLog::GetThreadLocalLogSystem(),
+    ezUInt32 uiCacheSizeInKB = 4); // [tested]
+
   /// \brief Every document has exactly one root element.
   const ezOpenDdlReaderElement* GetRootElement() const; // [tested]
 
@@ -163,6 +169,7 @@ protected:
   virtual void OnParsingError(const char* szMessage, bool bFatal, ezUInt32 uiLine, ezUInt32 uiColumn) override;
 
 protected:
+  ezResult ParseDocumentFromInput();
   ezOpenDdlReaderElement* CreateElement(ezOpenDdlPrimitiveType type, const char* szType, const char* szName, bool bGlobalName);
   const char* CopyString(const ezStringView& string);
   void StorePrimitiveData(bool bThisIsAll, ezUInt32 bytecount, const ezUInt8* pData);
@@ -181,7 +188,5 @@ protected:
   ezDeque<ezOpenDdlReaderElement> m_Elements;
   ezHybridArray<ezOpenDdlReaderElement*, 16> m_ObjectStack;
 
-  ezDeque<ezString> m_Strings;
-
   ezMap<ezString, ezOpenDdlReaderElement*> m_GlobalNames;
 };
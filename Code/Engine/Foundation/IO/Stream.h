@@ -94,6 +94,13 @@ public:
     return uiBytesSkipped;
   }
 
+  /// \brief Returns a view of all bytes that have not been read yet, if the stream keeps them in one contiguous block of memory.
+  ///
+  /// This allows to parse data in place, without copying it through ReadBytes() first. The read position is not changed, use SkipBytes()
+  /// to advance it. The view stays valid until the stream is closed or its underlying memory is modified.
+  /// Returns false, if the stream does not have all its data available in memory (the default).
+  virtual bool GetRemainingContiguousData(ezArrayPtr<const ezUInt8>& out_Data) const { return false; }
+
   EZ_ALWAYS_INLINE ezTypeVersion ReadVersion(ezTypeVersion uiExpectedMaxVersion);
 };
 
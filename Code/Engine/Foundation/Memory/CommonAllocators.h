@@ -9,6 +9,7 @@
 #include <Foundation/Memory/Policies/GuardedAllocation.h>
 #include <Foundation/Memory/Policies/HeapAllocation.h>
 #include <Foundation/Memory/Policies/ProxyAllocation.h>
+#include <Foundation/Memory/Policies/ThreadCachingHeapAllocation.h>
 
 
 /// \brief Default heap allocator
@@ -17,6 +18,9 @@ typedef ezAllocator<ezMemoryPolicies::ezAlignedHeapAllocation> ezAlignedHeapAllo
 /// \brief Default heap allocator
 typedef ezAllocator<ezMemoryPolicies::ezHeapAllocation> ezHeapAllocator;
 
+/// \brief Heap allocator that serves small allocations from per-thread caches
+typedef ezAllocator<ezMemoryPolicies::ezThreadCachingHeapAllocation> ezThreadCachingHeapAllocator;
+
 /// \brief Guarded allocator
 typedef ezAllocator<ezMemoryPolicies::ezGuardedAllocation> ezGuardedAllocator;
 
@@ -1,6 +1,12 @@
 #pragma once
 
 #include <Foundation/Memory/StackAllocator.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+namespace ezInternal
+{
+  class ezThreadArenaAllocator;
+}
 
 /// \brief A double buffered stack allocator
 class EZ_FOUNDATION_DLL ezDoubleBufferedStackAllocator
@@ -21,12 +27,37 @@ private:
   StackAllocatorType* m_pOtherAllocator;
 };
 
+/// \brief Usage of the arenas of one thread, see ezFrameAllocator::GetThreadStats().
+struct ezFrameAllocatorThreadStats
+{
+  ezThreadID m_ThreadID;
+  bool m_bIsMainThread = false;
+
+  ezUInt64 m_uiFrameBytes = 0;     ///< Bytes that were allocated through GetThreadAllocator() in the current frame.
+  ezUInt64 m_uiPeakFrameBytes = 0; ///< The most bytes that were allocated through GetThreadAllocator() in a single frame.
+  ezUInt64 m_uiPeakTempBytes = 0;  ///< The most bytes that were in use in ezTempAllocatorScope at the same time.
+  ezUInt64 m_uiReservedBytes = 0;  ///< The memory that the arenas of the thread keep around for reuse.
+};
+
 class EZ_FOUNDATION_DLL ezFrameAllocator
 {
 public:
   EZ_ALWAYS_INLINE static ezAllocatorBase* GetCurrentAllocator() { return s_pAllocator->GetCurrentAllocator(); }
 
+  /// \brief Returns a bump pointer allocator that belongs to the calling thread, allocating from it never locks.
+  ///
+  /// Like allocations from GetCurrentAllocator(), the memory stays valid until Swap() was called twice, so e.g. render data can be
+  /// created on a worker thread and read on another one. The allocator itself must only be used on the thread that retrieved it and
+  /// must not be kept across frames. Each thread has two arenas which take turns, an arena is reset the first time the thread uses it
+  /// after a Swap().
+  static ezAllocatorBase* GetThreadAllocator();
+
+  /// \brief Returns the arena usage of all threads that used GetThreadAllocator() or ezTempAllocatorScope.
+  static void GetThreadStats(ezDynamicArray<ezFrameAllocatorThreadStats>& out_Stats);
+
   static void Swap();
+
+  /// \brief Frees all memory of GetCurrentAllocator() and GetThreadAllocator(). No other thread may allocate while this is called.
   static void Reset();
 
 private:
@@ -37,3 +68,22 @@ private:
 
   static ezDoubleBufferedStackAllocator* s_pAllocator;
 };
+
+/// \brief Provides a temporary arena of the calling thread, everything that is allocated from GetAllocator() is freed when the scope ends.
+///
+/// Meant for scratch data of tasks that is not needed after the task finished. Scopes can be nested, but have to end in reverse order on
+/// the thread that created them. Destructors of objects that were created with EZ_NEW are called when the scope ends.
+class EZ_FOUNDATION_DLL ezTempAllocatorScope
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezTempAllocatorScope);
+
+public:
+  ezTempAllocatorScope();
+  ~ezTempAllocatorScope();
+
+  ezAllocatorBase* GetAllocator() const;
+
+private:
+  ezInternal::ezThreadArenaAllocator* m_pArena;
+  ezUInt32 m_uiDepth;
+};
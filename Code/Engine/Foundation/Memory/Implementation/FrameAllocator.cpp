@@ -2,8 +2,13 @@
 
 #include <Foundation/Configuration/Startup.h>
 #include <Foundation/Memory/FrameAllocator.h>
+#include <Foundation/Memory/MemoryTracker.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Mutex.h>
+
+#include <atomic>
 
 ezDoubleBufferedStackAllocator::ezDoubleBufferedStackAllocator(const char* szName, ezAllocatorBase* pParent)
 {
@@ -37,6 +42,280 @@ void ezDoubleBufferedStackAllocator::Reset()
   m_pOtherAllocator->Reset();
 }
 
+//////////////////////////////////////////////////////////////////////////
+
+namespace ezInternal
+{
+  /// \brief Stack allocator for a single thread, so it doesn't need to lock.
+  class ezThreadArenaAllocator : public ezAllocatorBase
+  {
+  public:
+    ezThreadArenaAllocator(const char* szName, ezAllocatorBase* pParent)
+      : m_Stack(pParent)
+      , m_DestructData(pParent)
+      , m_PtrToDestructDataIndexTable(pParent)
+      , m_Markers(pParent)
+    {
+      m_Id = ezMemoryTracker::RegisterAllocator(szName, ezMemoryTrackingFlags::RegisterAllocator, pParent->GetId());
+    }
+
+    ~ezThreadArenaAllocator()
+    {
+      Reset();
+      ezMemoryTracker::DeregisterAllocator(m_Id);
+    }
+
+    virtual void* Allocate(size_t uiSize, size_t uiAlign, ezMemoryUtils::DestructorFunction destructorFunc = nullptr) override
+    {
+      if (uiSize == 0)
+        return nullptr;
+
+      const ezUInt32 uiNumBuckets = m_Stack.GetNumBuckets();
+      void* ptr = m_Stack.Allocate(uiSize, uiAlign);
+
+      if (m_Stack.GetNumBuckets() != uiNumBuckets)
+      {
+        UpdateReservedBytes();
+      }
+
+      const ezUInt64 uiUsedBytes = m_uiUsedBytes.load(std::memory_order_relaxed) + ezMemoryUtils::AlignSize<ezUInt64>(uiSize, ezMemoryPolicies::ezStackAllocation::Alignment);
+      m_uiUsedBytes.store(uiUsedBytes, std::memory_order_relaxed);
+
+      if (uiUsedBytes > m_uiPeakBytes.load(std::memory_order_relaxed))
+        m_uiPeakBytes.store(uiUsedBytes, std::memory_order_relaxed);
+
+      if (destructorFunc != nullptr)
+      {
+        m_PtrToDestructDataIndexTable.Insert(ptr, m_DestructData.GetCount());
+
+        auto& data = m_DestructData.ExpandAndGetRef();
+        data.m_Func = destructorFunc;
+        data.m_Ptr = ptr;
+      }
+
+      return ptr;
+    }
+
+    virtual void Deallocate(void* ptr) override
+    {
+      // memory is only freed on reset, but the destructor must not be called again
+      ezUInt32 uiIndex;
+      if (m_PtrToDestructDataIndexTable.Remove(ptr, &uiIndex))
+      {
+        m_DestructData[uiIndex].m_Func = nullptr;
+        m_DestructData[uiIndex].m_Ptr = nullptr;
+      }
+    }
+
+    virtual size_t AllocatedSize(const void* ptr) override { return 0; }
+    virtual ezAllocatorId GetId() const override { return m_Id; }
+    virtual Stats GetStats() const override { return ezMemoryTracker::GetAllocatorStats(m_Id); }
+
+    void Reset()
+    {
+      EZ_ASSERT_DEV(m_Markers.IsEmpty(), "Can't reset a thread arena while a ezTempAllocatorScope is active");
+
+      CallDestructors(0);
+      m_Stack.Reset();
+      m_uiUsedBytes.store(0, std::memory_order_relaxed);
+
+      ezAllocatorBase::Stats stats;
+      m_Stack.FillStats(stats);
+      ezMemoryTracker::SetAllocatorStats(m_Id, stats);
+    }
+
+    ezUInt32 PushMarker()
+    {
+      Marker& marker = m_Markers.ExpandAndGetRef();
+      marker.m_StackMarker = m_Stack.GetMarker();
+      marker.m_uiNumDestructData = m_DestructData.GetCount();
+      marker.m_uiUsedBytes = m_uiUsedBytes.load(std::memory_order_relaxed);
+
+      return m_Markers.GetCount();
+    }
+
+    void PopMarker(ezUInt32 uiDepth)
+    {
+      EZ_ASSERT_DEV(uiDepth == m_Markers.GetCount(), "ezTempAllocatorScope instances have to be destroyed in reverse order");
+
+      const Marker& marker = m_Markers.PeekBack();
+      CallDestructors(marker.m_uiNumDestructData);
+      m_Stack.ResetToMarker(marker.m_StackMarker);
+      m_uiUsedBytes.store(marker.m_uiUsedBytes, std::memory_order_relaxed);
+
+      m_Markers.PopBack();
+    }
+
+    // only written by the owning thread, other threads read them for statistics and may see outdated values
+    std::atomic<ezUInt64> m_uiUsedBytes = 0;
+    std::atomic<ezUInt64> m_uiPeakBytes = 0;
+    std::atomic<ezUInt64> m_uiReservedBytes = 0;
+
+  private:
+    void UpdateReservedBytes()
+    {
+      ezAllocatorBase::Stats stats;
+      m_Stack.FillStats(stats);
+      m_uiReservedBytes.store(stats.m_uiAllocationSize, std::memory_order_relaxed);
+    }
+
+    void CallDestructors(ezUInt32 uiFirstIndex)
+    {
+      for (ezUInt32 i = m_DestructData.GetCount(); i-- > uiFirstIndex;)
+      {
+        auto& data = m_DestructData[i];
+        if (data.m_Func != nullptr)
+        {
+          data.m_Func(data.m_Ptr);
+          m_PtrToDestructDataIndexTable.Remove(data.m_Ptr);
+        }
+      }
+
+      m_DestructData.SetCountUninitialized(uiFirstIndex);
+    }
+
+    struct DestructData
+    {
+      EZ_DECLARE_POD_TYPE();
+
+      ezMemoryUtils::DestructorFunction m_Func;
+      void* m_Ptr;
+    };
+
+    struct Marker
+    {
+      EZ_DECLARE_POD_TYPE();
+
+      ezMemoryPolicies::ezStackAllocation::Marker m_StackMarker;
+      ezUInt32 m_uiNumDestructData;
+      ezUInt64 m_uiUsedBytes;
+    };
+
+    ezMemoryPolicies::ezStackAllocation m_Stack;
+    ezDynamicArray<DestructData> m_DestructData;
+    ezHashTable<void*, ezUInt32> m_PtrToDestructDataIndexTable;
+    ezDynamicArray<Marker> m_Markers;
+    ezAllocatorId m_Id;
+  };
+} // namespace ezInternal
+
+namespace
+{
+  struct ezFrameAllocatorThreadData
+  {
+    ezInternal::ezThreadArenaAllocator* m_pFrameArenas[2] = {};
+    std::atomic<ezUInt32> m_uiArenaFrame[2] = {}; ///< Only written by the owning thread, read by GetThreadStats().
+    ezInternal::ezThreadArenaAllocator* m_pTempArena = nullptr;
+
+    ezThreadID m_ThreadID = {};
+    bool m_bIsMainThread = false;
+    bool m_bInUse = false;
+  };
+
+  ezMutex s_ThreadDataMutex;
+  ezDynamicArray<ezFrameAllocatorThreadData*>* s_pThreadData = nullptr;
+
+  // changes on startup and shutdown, so threads notice that their thread data was destroyed
+  ezUInt32 s_uiThreadDataGeneration = 0;
+
+  // only written by ezFrameAllocator::Swap(), the frame synchronization of the caller orders it with the allocations
+  std::atomic<ezUInt32> s_uiFrame = 1;
+
+  thread_local ezFrameAllocatorThreadData* tl_pThreadData = nullptr;
+  thread_local ezUInt32 tl_uiThreadDataGeneration = 0;
+
+  /// Makes the thread data available to other threads when this thread exits. The arenas are not reset, their memory may still be in use.
+  struct ezFrameAllocatorThreadDataOwner
+  {
+    ~ezFrameAllocatorThreadDataOwner()
+    {
+      EZ_LOCK(s_ThreadDataMutex);
+
+      if (tl_pThreadData != nullptr && tl_uiThreadDataGeneration == s_uiThreadDataGeneration)
+      {
+        tl_pThreadData->m_bInUse = false;
+      }
+
+      tl_pThreadData = nullptr;
+      tl_uiThreadDataGeneration = 0;
+    }
+
+    bool m_bRegistered = false;
+  };
+
+  thread_local ezFrameAllocatorThreadDataOwner tl_ThreadDataOwner;
+
+  ezFrameAllocatorThreadData* AcquireThreadData()
+  {
+    EZ_LOCK(s_ThreadDataMutex);
+    EZ_ASSERT_DEV(s_pThreadData != nullptr, "ezFrameAllocator has not been initialized");
+
+    ezFrameAllocatorThreadData* pData = nullptr;
+    for (ezFrameAllocatorThreadData* pExisting : *s_pThreadData)
+    {
+      if (!pExisting->m_bInUse)
+      {
+        pData = pExisting;
+        break;
+      }
+    }
+
+    if (pData == nullptr)
+    {
+      ezAllocatorBase* pParent = ezFoundation::GetAlignedAllocator();
+
+      pData = EZ_DEFAULT_NEW(ezFrameAllocatorThreadData);
+
+      ezStringBuilder sName;
+      for (ezUInt32 i = 0; i < 2; ++i)
+      {
+        sName.Format("FrameAllocator Thread{0} {1}", s_pThreadData->GetCount(), i);
+        pData->m_pFrameArenas[i] = EZ_DEFAULT_NEW(ezInternal::ezThreadArenaAllocator, sName, pParent);
+      }
+
+      sName.Format("FrameAllocator Thread{0} Temp", s_pThreadData->GetCount());
+      pData->m_pTempArena = EZ_DEFAULT_NEW(ezInternal::ezThreadArenaAllocator, sName, pParent);
+
+      s_pThreadData->PushBack(pData);
+    }
+
+    pData->m_ThreadID = ezThreadUtils::GetCurrentThreadID();
+    pData->m_bIsMainThread = ezThreadUtils::IsMainThread();
+    pData->m_bInUse = true;
+
+    tl_pThreadData = pData;
+    tl_uiThreadDataGeneration = s_uiThreadDataGeneration;
+
+    // makes sure the owner is constructed, so that its destructor runs when the thread exits
+    tl_ThreadDataOwner.m_bRegistered = true;
+
+    return pData;
+  }
+
+  EZ_ALWAYS_INLINE ezFrameAllocatorThreadData* GetThreadData()
+  {
+    if (tl_uiThreadDataGeneration == s_uiThreadDataGeneration && tl_pThreadData != nullptr)
+      return tl_pThreadData;
+
+    return AcquireThreadData();
+  }
+} // namespace
+
+ezTempAllocatorScope::ezTempAllocatorScope()
+{
+  m_pArena = GetThreadData()->m_pTempArena;
+  m_uiDepth = m_pArena->PushMarker();
+}
+
+ezTempAllocatorScope::~ezTempAllocatorScope()
+{
+  m_pArena->PopMarker(m_uiDepth);
+}
+
+ezAllocatorBase* ezTempAllocatorScope::GetAllocator() const
+{
+  return m_pArena;
+}
 
 // clang-format off
 EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, FrameAllocator)
@@ -56,12 +335,68 @@ EZ_END_SUBSYSTEM_DECLARATION;
 
 ezDoubleBufferedStackAllocator* ezFrameAllocator::s_pAllocator;
 
+// static
+ezAllocatorBase* ezFrameAllocator::GetThreadAllocator()
+{
+  ezFrameAllocatorThreadData* pData = GetThreadData();
+
+  // the arena of the other parity still holds the allocations of the previous frame
+  const ezUInt32 uiFrame = s_uiFrame.load(std::memory_order_relaxed);
+  const ezUInt32 uiArena = uiFrame & 1;
+
+  if (pData->m_uiArenaFrame[uiArena].load(std::memory_order_relaxed) != uiFrame)
+  {
+    pData->m_pFrameArenas[uiArena]->Reset();
+    pData->m_uiArenaFrame[uiArena].store(uiFrame, std::memory_order_relaxed);
+  }
+
+  return pData->m_pFrameArenas[uiArena];
+}
+
+// static
+void ezFrameAllocator::GetThreadStats(ezDynamicArray<ezFrameAllocatorThreadStats>& out_Stats)
+{
+  out_Stats.Clear();
+
+  EZ_LOCK(s_ThreadDataMutex);
+
+  if (s_pThreadData == nullptr)
+    return;
+
+  const ezUInt32 uiFrame = s_uiFrame.load(std::memory_order_relaxed);
+
+  for (const ezFrameAllocatorThreadData* pData : *s_pThreadData)
+  {
+    auto& stats = out_Stats.ExpandAndGetRef();
+    stats.m_ThreadID = pData->m_ThreadID;
+    stats.m_bIsMainThread = pData->m_bIsMainThread;
+    stats.m_uiPeakTempBytes = pData->m_pTempArena->m_uiPeakBytes.load(std::memory_order_relaxed);
+    stats.m_uiReservedBytes = pData->m_pTempArena->m_uiReservedBytes.load(std::memory_order_relaxed);
+
+    for (ezUInt32 i = 0; i < 2; ++i)
+    {
+      ezInternal::ezThreadArenaAllocator* pArena = pData->m_pFrameArenas[i];
+
+      if (pData->m_uiArenaFrame[i].load(std::memory_order_relaxed) == uiFrame)
+      {
+        stats.m_uiFrameBytes = pArena->m_uiUsedBytes.load(std::memory_order_relaxed);
+      }
+
+      stats.m_uiPeakFrameBytes = ezMath::Max(stats.m_uiPeakFrameBytes, pArena->m_uiPeakBytes.load(std::memory_order_relaxed));
+      stats.m_uiReservedBytes += pArena->m_uiReservedBytes.load(std::memory_order_relaxed);
+    }
+  }
+}
+
 // static
 void ezFrameAllocator::Swap()
 {
   EZ_PROFILE_SCOPE("FrameAllocator.Swap");
 
   s_pAllocator->Swap();
+
+  // the thread arenas are reset lazily by their threads
+  s_uiFrame.fetch_add(1, std::memory_order_relaxed);
 }
 
 // static
@@ -71,18 +406,49 @@ void ezFrameAllocator::Reset()
   {
     s_pAllocator->Reset();
   }
+
+  EZ_LOCK(s_ThreadDataMutex);
+
+  if (s_pThreadData != nullptr)
+  {
+    for (ezFrameAllocatorThreadData* pData : *s_pThreadData)
+    {
+      for (ezUInt32 i = 0; i < 2; ++i)
+      {
+        pData->m_pFrameArenas[i]->Reset();
+        pData->m_uiArenaFrame[i].store(0, std::memory_order_relaxed);
+      }
+    }
+  }
 }
 
 // static
 void ezFrameAllocator::Startup()
 {
   s_pAllocator = EZ_DEFAULT_NEW(ezDoubleBufferedStackAllocator, "FrameAllocator", ezFoundation::GetAlignedAllocator());
+
+  EZ_LOCK(s_ThreadDataMutex);
+  s_pThreadData = EZ_DEFAULT_NEW(ezDynamicArray<ezFrameAllocatorThreadData*>);
+  ++s_uiThreadDataGeneration;
 }
 
 // static
 void ezFrameAllocator::Shutdown()
 {
   EZ_DEFAULT_DELETE(s_pAllocator);
+
+  EZ_LOCK(s_ThreadDataMutex);
+
+  for (ezFrameAllocatorThreadData* pData : *s_pThreadData)
+  {
+    EZ_DEFAULT_DELETE(pData->m_pFrameArenas[0]);
+    EZ_DEFAULT_DELETE(pData->m_pFrameArenas[1]);
+    EZ_DEFAULT_DELETE(pData->m_pTempArena);
+    EZ_DEFAULT_DELETE(pData);
+  }
+
+  EZ_DEFAULT_DELETE(s_pThreadData);
+  ++s_uiThreadDataGeneration;
 }
 
 EZ_STATICLINK_FILE(Foundation, Foundation_Memory_Implementation_FrameAllocator);
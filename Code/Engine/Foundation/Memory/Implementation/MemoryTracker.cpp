@@ -7,6 +7,7 @@
 #include <Foundation/Memory/Policies/HeapAllocation.h>
 #include <Foundation/Strings/String.h>
 #include <Foundation/System/StackTracer.h>
+#include <Foundation/Threading/AtomicInteger.h>
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
 
@@ -26,6 +27,20 @@ namespace
     EZ_ALWAYS_INLINE static ezAllocatorBase* GetAllocator() { return s_pTrackerDataAllocator; }
   };
 
+  enum
+  {
+    NUM_ALLOCATION_SHARDS = 16,
+    ALLOCATOR_CHUNK_SIZE = 256,
+    MAX_ALLOCATOR_CHUNKS = 256,
+  };
+
+  typedef ezHashTable<const void*, ezMemoryTracker::AllocationInfo, ezHashHelper<const void*>, TrackerDataAllocatorWrapper> AllocationTable;
+
+  struct AllocationShard
+  {
+    ezMutex m_Mutex;
+    AllocationTable m_Allocations;
+  };
 
   struct AllocatorData
   {
@@ -36,9 +51,30 @@ namespace
 
     ezAllocatorId m_ParentId;
 
-    ezAllocatorBase::Stats m_Stats;
+    // updated without any lock
+    ezAtomicInteger64 m_iNumAllocations;
+    ezAtomicInteger64 m_iNumDeallocations;
+    ezAtomicInteger64 m_iAllocationSize;
+    ezAtomicInteger64 m_iPerFrameAllocationSize;
+    ezAtomicInteger64 m_iPerFrameAllocationTimeNs;
+
+    /// Live allocations that were skipped by sampling. As long as there are any, freeing an unknown pointer is not an error.
+    ezAtomicInteger64 m_iNumUntrackedAllocations;
+
+    AllocationShard m_Shards[NUM_ALLOCATION_SHARDS];
 
-    ezHashTable<const void*, ezMemoryTracker::AllocationInfo, ezHashHelper<const void*>, TrackerDataAllocatorWrapper> m_Allocations;
+    EZ_ALWAYS_INLINE AllocationShard& GetShard(const void* ptr) { return m_Shards[(reinterpret_cast<size_t>(ptr) >> 4) % NUM_ALLOCATION_SHARDS]; }
+
+    ezAllocatorBase::Stats GetStats() const
+    {
+      ezAllocatorBase::Stats stats;
+      stats.m_uiNumAllocations = static_cast<ezUInt64>(static_cast<ezInt64>(m_iNumAllocations));
+      stats.m_uiNumDeallocations = static_cast<ezUInt64>(static_cast<ezInt64>(m_iNumDeallocations));
+      stats.m_uiAllocationSize = static_cast<ezUInt64>(ezMath::Max<ezInt64>(m_iAllocationSize, 0));
+      stats.m_uiPerFrameAllocationSize = static_cast<ezUInt64>(static_cast<ezInt64>(m_iPerFrameAllocationSize));
+      stats.m_PerFrameAllocationTime = ezTime::Nanoseconds(static_cast<double>(static_cast<ezInt64>(m_iPerFrameAllocationTimeNs)));
+      return stats;
+    }
   };
 
   struct TrackerData
@@ -48,16 +84,26 @@ namespace
 
     ezMutex m_Mutex;
 
-    typedef ezIdTable<ezAllocatorId, AllocatorData, TrackerDataAllocatorWrapper> AllocatorTable;
+    typedef ezIdTable<ezAllocatorId, AllocatorData*, TrackerDataAllocatorWrapper> AllocatorTable;
     AllocatorTable m_AllocatorData;
 
     ezAllocatorId m_StaticAllocatorId;
+
+    /// The allocator data by index of the allocator ID. Allocations and deallocations look up their allocator here without taking m_Mutex.
+    /// Chunks are only ever added, so the pointers stay valid.
+    AllocatorData** m_AllocatorChunks[MAX_ALLOCATOR_CHUNKS] = {};
   };
 
   static TrackerData* s_pTrackerData;
   static bool s_bIsInitialized = false;
   static bool s_bIsInitializing = false;
 
+  static ezAtomicInteger32 s_iSamplingInterval;
+
+  // distance in bytes to the next sampled allocation of the thread
+  static thread_local ezInt64 tl_iBytesUntilNextSample = 0;
+  static thread_local ezUInt32 tl_uiSamplingRandom = 0;
+
   static void Initialize()
   {
     if (s_bIsInitialized)
@@ -84,6 +130,54 @@ namespace
     s_bIsInitializing = false;
   }
 
+  EZ_ALWAYS_INLINE AllocatorData& GetAllocatorData(ezAllocatorId allocatorId)
+  {
+    const ezUInt32 uiIndex = allocatorId.m_InstanceIndex;
+    return *s_pTrackerData->m_AllocatorChunks[uiIndex / ALLOCATOR_CHUNK_SIZE][uiIndex % ALLOCATOR_CHUNK_SIZE];
+  }
+
+  static void SetAllocatorData(ezAllocatorId allocatorId, AllocatorData* pData)
+  {
+    const ezUInt32 uiIndex = allocatorId.m_InstanceIndex;
+    const ezUInt32 uiChunk = uiIndex / ALLOCATOR_CHUNK_SIZE;
+    EZ_ASSERT_RELEASE(uiChunk < MAX_ALLOCATOR_CHUNKS, "Too many allocators, at most {0} allocators can be registered at the same time", MAX_ALLOCATOR_CHUNKS * ALLOCATOR_CHUNK_SIZE);
+
+    AllocatorData**& pChunk = s_pTrackerData->m_AllocatorChunks[uiChunk];
+    if (pChunk == nullptr)
+    {
+      pChunk = EZ_NEW_RAW_BUFFER(s_pTrackerDataAllocator, AllocatorData*, ALLOCATOR_CHUNK_SIZE);
+      ezMemoryUtils::ZeroFill(pChunk, ALLOCATOR_CHUNK_SIZE);
+    }
+
+    pChunk[uiIndex % ALLOCATOR_CHUNK_SIZE] = pData;
+  }
+
+  /// Decides whether an allocation of the calling thread is tracked, when sampling is enabled.
+  EZ_ALWAYS_INLINE bool ShouldSampleAllocation(size_t uiSize, ezUInt32 uiSamplingInterval)
+  {
+    tl_iBytesUntilNextSample -= static_cast<ezInt64>(uiSize);
+
+    if (tl_iBytesUntilNextSample > 0)
+      return false;
+
+    // the distance to the next sample is randomized, so that repeating allocation patterns don't always sample the same allocation
+    if (tl_uiSamplingRandom == 0)
+    {
+      tl_uiSamplingRandom = static_cast<ezUInt32>(reinterpret_cast<size_t>(&tl_uiSamplingRandom) >> 4) | 1;
+    }
+
+    tl_uiSamplingRandom = tl_uiSamplingRandom * 1664525u + 1013904223u;
+    tl_iBytesUntilNextSample = uiSamplingInterval / 2 + (tl_uiSamplingRandom >> 8) % uiSamplingInterval;
+
+    return true;
+  }
+
+  /// The amount that a tracked allocation contributes to the live allocation size.
+  EZ_ALWAYS_INLINE ezInt64 GetTrackedSize(const ezMemoryTracker::AllocationInfo& info)
+  {
+    return static_cast<ezInt64>(ezMath::Max<size_t>(info.m_uiSize, info.m_uiSamplingInterval));
+  }
+
   static void DumpLeak(const ezMemoryTracker::AllocationInfo& info, const char* szAllocatorName)
   {
     char szBuffer[512];
@@ -111,17 +205,17 @@ ezAllocatorId ezMemoryTracker::Iterator::Id() const
 
 const char* ezMemoryTracker::Iterator::Name() const
 {
-  return CAST_ITER(m_pData)->Value().m_sName.GetData();
+  return CAST_ITER(m_pData)->Value()->m_sName.GetData();
 }
 
 ezAllocatorId ezMemoryTracker::Iterator::ParentId() const
 {
-  return CAST_ITER(m_pData)->Value().m_ParentId;
+  return CAST_ITER(m_pData)->Value()->m_ParentId;
 }
 
-const ezAllocatorBase::Stats& ezMemoryTracker::Iterator::Stats() const
+ezAllocatorBase::Stats ezMemoryTracker::Iterator::Stats() const
 {
-  return CAST_ITER(m_pData)->Value().m_Stats;
+  return CAST_ITER(m_pData)->Value()->GetStats();
 }
 
 void ezMemoryTracker::Iterator::Next()
@@ -149,14 +243,15 @@ ezAllocatorId ezMemoryTracker::RegisterAllocator(const char* szName, ezBitflags<
 
   EZ_LOCK(*s_pTrackerData);
 
-  AllocatorData data;
-  data.m_sName = szName;
-  data.m_Flags = flags;
-  data.m_ParentId = parentId;
+  AllocatorData* pData = EZ_NEW(s_pTrackerDataAllocator, AllocatorData);
+  pData->m_sName = szName;
+  pData->m_Flags = flags;
+  pData->m_ParentId = parentId;
 
-  ezAllocatorId id = s_pTrackerData->m_AllocatorData.Insert(data);
+  ezAllocatorId id = s_pTrackerData->m_AllocatorData.Insert(pData);
+  SetAllocatorData(id, pData);
 
-  if (data.m_sName == EZ_STATIC_ALLOCATOR_NAME)
+  if (pData->m_sName == EZ_STATIC_ALLOCATOR_NAME)
   {
     s_pTrackerData->m_StaticAllocatorId = id;
   }
@@ -169,20 +264,29 @@ void ezMemoryTracker::DeregisterAllocator(ezAllocatorId allocatorId)
 {
   EZ_LOCK(*s_pTrackerData);
 
-  const AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
+  AllocatorData* pData = s_pTrackerData->m_AllocatorData[allocatorId];
 
-  ezUInt32 uiLiveAllocations = data.m_Allocations.GetCount();
-  if (uiLiveAllocations != 0)
+  ezUInt32 uiLiveAllocations = 0;
+  for (AllocationShard& shard : pData->m_Shards)
   {
-    for (auto it = data.m_Allocations.GetIterator(); it.IsValid(); ++it)
+    EZ_LOCK(shard.m_Mutex);
+
+    uiLiveAllocations += shard.m_Allocations.GetCount();
+    for (auto it = shard.m_Allocations.GetIterator(); it.IsValid(); ++it)
     {
-      DumpLeak(it.Value(), data.m_sName.GetData());
+      DumpLeak(it.Value(), pData->m_sName.GetData());
     }
+  }
 
-    EZ_REPORT_FAILURE("Allocator '{0}' leaked {1} allocation(s)", data.m_sName.GetData(), uiLiveAllocations);
+  if (uiLiveAllocations != 0)
+  {
+    EZ_REPORT_FAILURE("Allocator '{0}' leaked {1} allocation(s)", pData->m_sName.GetData(), uiLiveAllocations);
   }
 
+  SetAllocatorData(allocatorId, nullptr);
   s_pTrackerData->m_AllocatorData.Remove(allocatorId);
+
+  EZ_DELETE(s_pTrackerDataAllocator, pData);
 }
 
 // static
@@ -191,8 +295,22 @@ void ezMemoryTracker::AddAllocation(
 {
   EZ_ASSERT_DEV(uiAlign < 0xFFFF, "Alignment too big");
 
+  AllocatorData& data = GetAllocatorData(allocatorId);
+  EZ_ASSERT_DEBUG(data.m_Flags == flags, "Given flags have to be identical to allocator flags");
+
+  data.m_iNumAllocations.Increment();
+  data.m_iPerFrameAllocationSize.Add(static_cast<ezInt64>(uiSize));
+  data.m_iPerFrameAllocationTimeNs.Add(static_cast<ezInt64>(allocationTime.GetNanoseconds()));
+
+  const ezUInt32 uiSamplingInterval = static_cast<ezUInt32>(static_cast<ezInt32>(s_iSamplingInterval));
+  if (uiSamplingInterval != 0 && !ShouldSampleAllocation(uiSize, uiSamplingInterval))
+  {
+    data.m_iNumUntrackedAllocations.Increment();
+    return;
+  }
+
   ezArrayPtr<void*> stackTrace;
-  if (flags.IsSet(ezMemoryTrackingFlags::EnableStackTrace))
+  if (uiSamplingInterval != 0 || flags.IsSet(ezMemoryTrackingFlags::EnableStackTrace))
   {
     void* pBuffer[64];
     ezArrayPtr<void*> tempTrace(pBuffer);
@@ -202,64 +320,82 @@ void ezMemoryTracker::AddAllocation(
     ezMemoryUtils::Copy(stackTrace.GetPtr(), pBuffer, uiNumTraces);
   }
 
-  {
-    EZ_LOCK(*s_pTrackerData);
-
-    AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
-    data.m_Stats.m_uiNumAllocations++;
-    data.m_Stats.m_uiAllocationSize += uiSize;
-    data.m_Stats.m_uiPerFrameAllocationSize += uiSize;
-    data.m_Stats.m_PerFrameAllocationTime += allocationTime;
-
-    EZ_ASSERT_DEBUG(data.m_Flags == flags, "Given flags have to be identical to allocator flags");
-    auto pInfo = &data.m_Allocations[ptr];
-    pInfo->m_uiSize = uiSize;
-    pInfo->m_uiAlignment = (ezUInt16)uiAlign;
-    pInfo->SetStackTrace(stackTrace);
-  }
+  AllocationInfo info;
+  info.m_uiSize = uiSize;
+  info.m_uiAlignment = (ezUInt16)uiAlign;
+  info.m_uiSamplingInterval = uiSamplingInterval;
+  info.SetStackTrace(stackTrace);
+
+  data.m_iAllocationSize.Add(GetTrackedSize(info));
+
+  AllocationShard& shard = data.GetShard(ptr);
+  EZ_LOCK(shard.m_Mutex);
+  shard.m_Allocations[ptr] = info;
 }
 
 // static
 void ezMemoryTracker::RemoveAllocation(ezAllocatorId allocatorId, const void* ptr)
 {
-  ezArrayPtr<void*> stackTrace;
+  AllocatorData& data = GetAllocatorData(allocatorId);
+
+  AllocationInfo info;
+  bool bFound = false;
 
   {
-    EZ_LOCK(*s_pTrackerData);
+    AllocationShard& shard = data.GetShard(ptr);
+    EZ_LOCK(shard.m_Mutex);
+    bFound = shard.m_Allocations.Remove(ptr, &info);
+  }
 
-    AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
+  if (bFound)
+  {
+    data.m_iNumDeallocations.Increment();
+    data.m_iAllocationSize.Subtract(GetTrackedSize(info));
 
-    AllocationInfo info;
-    if (data.m_Allocations.Remove(ptr, &info))
-    {
-      data.m_Stats.m_uiNumDeallocations++;
-      data.m_Stats.m_uiAllocationSize -= info.m_uiSize;
+    EZ_DELETE_ARRAY(s_pTrackerDataAllocator, info.GetStackTrace());
+    return;
+  }
 
-      stackTrace = info.GetStackTrace();
-    }
-    else
+  // the pointer has to be one of the allocations that were skipped by sampling
+  ezInt64 iNumUntracked = data.m_iNumUntrackedAllocations;
+  while (iNumUntracked > 0)
+  {
+    if (data.m_iNumUntrackedAllocations.TestAndSet(iNumUntracked, iNumUntracked - 1))
     {
-      EZ_REPORT_FAILURE("Invalid Allocation '{0}'. Memory corruption?", ezArgP(ptr));
+      data.m_iNumDeallocations.Increment();
+      return;
     }
+
+    iNumUntracked = data.m_iNumUntrackedAllocations;
   }
 
-  EZ_DELETE_ARRAY(s_pTrackerDataAllocator, stackTrace);
+  EZ_REPORT_FAILURE("Invalid Allocation '{0}'. Memory corruption?", ezArgP(ptr));
 }
 
 // static
 void ezMemoryTracker::RemoveAllAllocations(ezAllocatorId allocatorId)
 {
   EZ_LOCK(*s_pTrackerData);
-  AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
-  for (auto it = data.m_Allocations.GetIterator(); it.IsValid(); ++it)
+  AllocatorData& data = *s_pTrackerData->m_AllocatorData[allocatorId];
+
+  for (AllocationShard& shard : data.m_Shards)
   {
-    auto& info = it.Value();
-    data.m_Stats.m_uiNumDeallocations++;
-    data.m_Stats.m_uiAllocationSize -= info.m_uiSize;
+    EZ_LOCK(shard.m_Mutex);
 
-    EZ_DELETE_ARRAY(s_pTrackerDataAllocator, info.GetStackTrace());
+    for (auto it = shard.m_Allocations.GetIterator(); it.IsValid(); ++it)
+    {
+      auto& info = it.Value();
+      data.m_iAllocationSize.Subtract(GetTrackedSize(info));
+
+      EZ_DELETE_ARRAY(s_pTrackerDataAllocator, info.GetStackTrace());
+    }
+
+    data.m_iNumDeallocations.Add(shard.m_Allocations.GetCount());
+    shard.m_Allocations.Clear();
   }
-  data.m_Allocations.Clear();
+
+  // the allocations that were skipped by sampling are gone as well
+  data.m_iNumDeallocations.Add(data.m_iNumUntrackedAllocations.Set(0));
 }
 
 // static
@@ -267,7 +403,12 @@ void ezMemoryTracker::SetAllocatorStats(ezAllocatorId allocatorId, const ezAlloc
 {
   EZ_LOCK(*s_pTrackerData);
 
-  s_pTrackerData->m_AllocatorData[allocatorId].m_Stats = stats;
+  AllocatorData& data = *s_pTrackerData->m_AllocatorData[allocatorId];
+  data.m_iNumAllocations = static_cast<ezInt64>(stats.m_uiNumAllocations);
+  data.m_iNumDeallocations = static_cast<ezInt64>(stats.m_uiNumDeallocations);
+  data.m_iAllocationSize = static_cast<ezInt64>(stats.m_uiAllocationSize);
+  data.m_iPerFrameAllocationSize = static_cast<ezInt64>(stats.m_uiPerFrameAllocationSize);
+  data.m_iPerFrameAllocationTimeNs = static_cast<ezInt64>(stats.m_PerFrameAllocationTime.GetNanoseconds());
 }
 
 // static
@@ -277,9 +418,9 @@ void ezMemoryTracker::ResetPerFrameAllocatorStats()
 
   for (auto it = s_pTrackerData->m_AllocatorData.GetIterator(); it.IsValid(); ++it)
   {
-    AllocatorData& data = it.Value();
-    data.m_Stats.m_uiPerFrameAllocationSize = 0;
-    data.m_Stats.m_PerFrameAllocationTime.SetZero();
+    AllocatorData& data = *it.Value();
+    data.m_iPerFrameAllocationSize = 0;
+    data.m_iPerFrameAllocationTimeNs = 0;
   }
 }
 
@@ -288,15 +429,15 @@ const char* ezMemoryTracker::GetAllocatorName(ezAllocatorId allocatorId)
 {
   EZ_LOCK(*s_pTrackerData);
 
-  return s_pTrackerData->m_AllocatorData[allocatorId].m_sName.GetData();
+  return s_pTrackerData->m_AllocatorData[allocatorId]->m_sName.GetData();
 }
 
 // static
-const ezAllocatorBase::Stats& ezMemoryTracker::GetAllocatorStats(ezAllocatorId allocatorId)
+ezAllocatorBase::Stats ezMemoryTracker::GetAllocatorStats(ezAllocatorId allocatorId)
 {
   EZ_LOCK(*s_pTrackerData);
 
-  return s_pTrackerData->m_AllocatorData[allocatorId].m_Stats;
+  return s_pTrackerData->m_AllocatorData[allocatorId]->GetStats();
 }
 
 // static
@@ -304,27 +445,45 @@ ezAllocatorId ezMemoryTracker::GetAllocatorParentId(ezAllocatorId allocatorId)
 {
   EZ_LOCK(*s_pTrackerData);
 
-  return s_pTrackerData->m_AllocatorData[allocatorId].m_ParentId;
+  return s_pTrackerData->m_AllocatorData[allocatorId]->m_ParentId;
 }
 
 // static
 const ezMemoryTracker::AllocationInfo& ezMemoryTracker::GetAllocationInfo(ezAllocatorId allocatorId, const void* ptr)
 {
-  EZ_LOCK(*s_pTrackerData);
+  AllocationShard& shard = GetAllocatorData(allocatorId).GetShard(ptr);
+  EZ_LOCK(shard.m_Mutex);
 
-  const AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
   const AllocationInfo* info = nullptr;
-  if (data.m_Allocations.TryGetValue(ptr, info))
+  if (shard.m_Allocations.TryGetValue(ptr, info))
   {
     return *info;
   }
 
   static AllocationInfo invalidInfo;
 
-  EZ_REPORT_FAILURE("Could not find info for allocation {0}", ezArgP(ptr));
+  if (GetAllocatorData(allocatorId).m_iNumUntrackedAllocations == 0)
+  {
+    EZ_REPORT_FAILURE("Could not find info for allocation {0}", ezArgP(ptr));
+  }
+
   return invalidInfo;
 }
 
+// static
+void ezMemoryTracker::SetSamplingInterval(ezUInt32 uiSamplingIntervalBytes)
+{
+  EZ_ASSERT_DEV(uiSamplingIntervalBytes <= static_cast<ezUInt32>(ezMath::MaxValue<ezInt32>()), "Sampling interval is too large");
+
+  s_iSamplingInterval = static_cast<ezInt32>(uiSamplingIntervalBytes);
+}
+
+// static
+ezUInt32 ezMemoryTracker::GetSamplingInterval()
+{
+  return static_cast<ezUInt32>(static_cast<ezInt32>(s_iSamplingInterval));
+}
+
 
 struct LeakInfo
 {
@@ -350,15 +509,20 @@ void ezMemoryTracker::DumpMemoryLeaks()
   // first collect all leaks
   for (auto it = s_pTrackerData->m_AllocatorData.GetIterator(); it.IsValid(); ++it)
   {
-    const AllocatorData& data = it.Value();
-    for (auto it2 = data.m_Allocations.GetIterator(); it2.IsValid(); ++it2)
+    AllocatorData& data = *it.Value();
+    for (AllocationShard& shard : data.m_Shards)
     {
-      LeakInfo leak;
-      leak.m_AllocatorId = it.Id();
-      leak.m_uiSize = it2.Value().m_uiSize;
-      leak.m_pParentLeak = nullptr;
+      EZ_LOCK(shard.m_Mutex);
 
-      leakTable.Insert(it2.Key(), leak);
+      for (auto it2 = shard.m_Allocations.GetIterator(); it2.IsValid(); ++it2)
+      {
+        LeakInfo leak;
+        leak.m_AllocatorId = it.Id();
+        leak.m_uiSize = it2.Value().m_uiSize;
+        leak.m_pParentLeak = nullptr;
+
+        leakTable.Insert(it2.Key(), leak);
+      }
     }
   }
 
@@ -402,9 +566,13 @@ void ezMemoryTracker::DumpMemoryLeaks()
                      "\n--------------------------------------------------------------------\n\n");
       }
 
-      const AllocatorData& data = s_pTrackerData->m_AllocatorData[leak.m_AllocatorId];
+      AllocatorData& data = *s_pTrackerData->m_AllocatorData[leak.m_AllocatorId];
       ezMemoryTracker::AllocationInfo info;
-      data.m_Allocations.TryGetValue(ptr, info);
+      {
+        AllocationShard& shard = data.GetShard(ptr);
+        EZ_LOCK(shard.m_Mutex);
+        shard.m_Allocations.TryGetValue(ptr, info);
+      }
 
       DumpLeak(info, data.m_sName.GetData());
 
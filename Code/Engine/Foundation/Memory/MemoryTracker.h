@@ -40,6 +40,12 @@ struct ezMemoryTrackingFlags
 #define EZ_STATIC_ALLOCATOR_NAME "Statics"
 
 /// \brief Memory tracker which keeps track of all allocations and constructions
+///
+/// The allocation statistics are updated with atomic counters. The individual allocations are stored in hash tables that are split into
+/// several shards per allocator, each with its own lock, so threads that allocate concurrently rarely wait for each other.
+///
+/// With SetSamplingInterval() only a statistically representative subset of the allocations is tracked individually, which makes it cheap
+/// enough to leave allocation tracking enabled in performance test builds. See SetSamplingInterval() for the limitations of that mode.
 class EZ_FOUNDATION_DLL ezMemoryTracker
 {
 public:
@@ -52,6 +58,7 @@ public:
       , m_uiSize(0)
       , m_uiAlignment(0)
       , m_uiStackTraceLength(0)
+      , m_uiSamplingInterval(0)
     {
     }
 
@@ -59,6 +66,7 @@ public:
     size_t m_uiSize;
     ezUInt16 m_uiAlignment;
     ezUInt16 m_uiStackTraceLength;
+    ezUInt32 m_uiSamplingInterval; ///< Zero if all allocations were tracked, otherwise the sampling interval that was active when the allocation was sampled.
 
     EZ_ALWAYS_INLINE const ezArrayPtr<void*> GetStackTrace() const { return ezArrayPtr<void*>(m_pStackTrace, (ezUInt32)m_uiStackTraceLength); }
 
@@ -80,7 +88,7 @@ public:
     ezAllocatorId Id() const;
     const char* Name() const;
     ezAllocatorId ParentId() const;
-    const ezAllocatorBase::Stats& Stats() const;
+    ezAllocatorBase::Stats Stats() const;
 
     void Next();
     bool IsValid() const;
@@ -110,11 +118,25 @@ public:
   static void ResetPerFrameAllocatorStats();
 
   static const char* GetAllocatorName(ezAllocatorId allocatorId);
-  static const ezAllocatorBase::Stats& GetAllocatorStats(ezAllocatorId allocatorId);
+  static ezAllocatorBase::Stats GetAllocatorStats(ezAllocatorId allocatorId);
   static ezAllocatorId GetAllocatorParentId(ezAllocatorId allocatorId);
   static const AllocationInfo& GetAllocationInfo(ezAllocatorId allocatorId, const void* ptr);
 
   static void DumpMemoryLeaks();
 
+  /// \brief Enables sampled allocation tracking. On average only one allocation per \a uiSamplingIntervalBytes allocated bytes is tracked
+  /// individually, and always with a stack trace, independent of ezMemoryTrackingFlags::EnableStackTrace. Zero tracks all allocations.
+  ///
+  /// Larger allocations are thus more likely to be sampled, allocations larger than the interval are always sampled.
+  /// The number of allocations and deallocations and the per frame statistics stay exact. The live allocation size becomes an estimate,
+  /// each sampled allocation accounts for the larger of its own size and the sampling interval.
+  /// Leak reports and GetAllocationInfo() only cover the sampled allocations. Freeing memory that is not tracked is not reported as an
+  /// error, as long as the allocator still has allocations that were skipped by sampling. Once those are freed, e.g. after sampling was
+  /// disabled again, the regular error checks apply again.
+  static void SetSamplingInterval(ezUInt32 uiSamplingIntervalBytes);
+
+  /// \brief Returns the interval that was set with SetSamplingInterval().
+  static ezUInt32 GetSamplingInterval();
+
   static Iterator GetIterator();
 };
@@ -92,6 +92,34 @@ namespace ezMemoryPolicies
       m_pNextAllocation = !m_Buckets.IsEmpty() ? m_Buckets[0].GetPtr() : nullptr;
     }
 
+    /// \brief Identifies the top of the stack at the time GetMarker() was called.
+    struct Marker
+    {
+      ezUInt32 m_uiBucketIndex = 0;
+      ezUInt8* m_pNextAllocation = nullptr;
+    };
+
+    EZ_ALWAYS_INLINE Marker GetMarker() const
+    {
+      Marker marker;
+      marker.m_uiBucketIndex = m_uiCurrentBucketIndex;
+      marker.m_pNextAllocation = m_pNextAllocation;
+      return marker;
+    }
+
+    /// \brief Frees everything that was allocated after the marker was retrieved. The buckets are kept for later allocations.
+    EZ_FORCE_INLINE void ResetToMarker(const Marker& marker)
+    {
+      if (marker.m_pNextAllocation == nullptr)
+      {
+        Reset();
+        return;
+      }
+
+      m_uiCurrentBucketIndex = marker.m_uiBucketIndex;
+      m_pNextAllocation = marker.m_pNextAllocation;
+    }
+
     EZ_FORCE_INLINE void FillStats(ezAllocatorBase::Stats& stats)
     {
       stats.m_uiNumAllocations = m_Buckets.GetCount();
@@ -103,6 +131,9 @@ namespace ezMemoryPolicies
 
     EZ_ALWAYS_INLINE ezAllocatorBase* GetParent() const { return m_pParent; }
 
+    /// \brief Buckets are only added, never freed before destruction.
+    EZ_ALWAYS_INLINE ezUInt32 GetNumBuckets() const { return m_Buckets.GetCount(); }
+
   private:
     ezAllocatorBase* m_pParent = nullptr;
 
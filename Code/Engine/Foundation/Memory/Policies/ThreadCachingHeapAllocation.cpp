@@ -0,0 +1,697 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Memory/PageAllocator.h>
+#include <Foundation/Memory/Policies/AlignedHeapAllocation.h>
+#include <Foundation/Memory/Policies/ThreadCachingHeapAllocation.h>
+#include <Foundation/Threading/AtomicUtils.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Mutex.h>
+
+namespace
+{
+  constexpr ezUInt32 MaxInstances = ezMemoryPolicies::ezThreadCachingHeapAllocation::MaxInstances;
+  constexpr ezUInt32 MaxSmallAllocationSize = ezMemoryPolicies::ezThreadCachingHeapAllocation::MaxSmallAllocationSize;
+
+  constexpr ezUInt32 SlabSizeShift = 16;
+  constexpr size_t SlabSize = size_t(1) << SlabSizeShift;
+  constexpr size_t SlabHeaderSize = 64;
+  constexpr ezUInt32 SlabsPerSegment = 64;
+  constexpr size_t SegmentSize = SlabSize * SlabsPerSegment;
+  constexpr size_t SmallAlignment = 16;
+  constexpr ezUInt32 NumSizeClasses = 32;
+
+  /// Empty slabs that a thread cache keeps before it gives them back to the heap.
+  constexpr ezUInt32 MaxCachedEmptySlabs = 4;
+
+  /// Size classes are 16 byte steps up to 128 bytes, then four classes per power of two.
+  EZ_ALWAYS_INLINE ezUInt32 GetSizeClass(size_t uiSize)
+  {
+    if (uiSize <= 128)
+      return static_cast<ezUInt32>(uiSize - 1) >> 4;
+
+    const ezUInt32 uiValue = static_cast<ezUInt32>(uiSize - 1);
+    const ezUInt32 uiHighBit = ezMath::FirstBitHigh(uiValue);
+    return 8 + (uiHighBit - 7) * 4 + ((uiValue >> (uiHighBit - 2)) & 3);
+  }
+
+  constexpr ezUInt32 GetBlockSize(ezUInt32 uiSizeClass)
+  {
+    return uiSizeClass < 8 ? (uiSizeClass + 1) * 16 : (128u << ((uiSizeClass - 8) / 4)) + ((uiSizeClass - 8) % 4 + 1) * (32u << ((uiSizeClass - 8) / 4));
+  }
+
+  static_assert(GetBlockSize(NumSizeClasses - 1) == MaxSmallAllocationSize, "The largest size class has to match the small allocation size");
+
+  // The page map stores for every 64 KB of the address space the index + 1 of the heap whose slab is located there, so Deallocate() can
+  // tell slabs and large allocations apart without touching the memory. Two levels cover 48 bit of address space. Leaves are allocated on
+  // demand and never freed, a process only ever touches a few of them.
+  constexpr ezUInt32 AddressBits = sizeof(void*) * 8 > 48 ? 48 : sizeof(void*) * 8;
+  constexpr ezUInt32 PageMapLeafBits = 16;
+  constexpr ezUInt32 PageMapRootSize = 1u << (AddressBits - SlabSizeShift - PageMapLeafBits);
+  constexpr ezUInt32 PageMapLeafSize = 1u << PageMapLeafBits;
+
+  ezUInt8* volatile s_PageMap[PageMapRootSize];
+
+  EZ_ALWAYS_INLINE ezUInt8 GetSlabOwner(const void* ptr)
+  {
+    const ezUInt64 uiSlab = static_cast<ezUInt64>(reinterpret_cast<size_t>(ptr)) >> SlabSizeShift;
+    const ezUInt64 uiRoot = uiSlab >> PageMapLeafBits;
+
+    if (uiRoot >= PageMapRootSize)
+      return 0;
+
+    const ezUInt8* pLeaf = s_PageMap[uiRoot];
+    return pLeaf != nullptr ? pLeaf[uiSlab & (PageMapLeafSize - 1)] : 0;
+  }
+} // namespace
+
+namespace ezInternal
+{
+  class ezThreadCachingHeap
+  {
+  public:
+    struct ThreadCache;
+
+    /// \brief Header in the first bytes of every slab.
+    struct Slab
+    {
+      enum class State : ezUInt8
+      {
+        Free,    ///< Not used by any thread cache.
+        Current, ///< The slab that a thread cache allocates from for its size class.
+        Partial, ///< Has free blocks, linked into the partial list of its size class.
+        Full,    ///< All blocks were handed out, not linked into any list.
+      };
+
+      ThreadCache* m_pOwner;
+      Slab* m_pPrev;
+      Slab* m_pNext;
+      void* m_pFreeList;
+      ezUInt32 m_uiBlockSize;
+      ezUInt32 m_uiNumBlocks;
+      ezUInt32 m_uiNumUsed;
+      ezUInt32 m_uiNumCarved;
+      ezUInt8 m_uiSizeClass;
+      State m_State;
+
+      EZ_ALWAYS_INLINE void* Pop()
+      {
+        void* ptr = m_pFreeList;
+
+        if (ptr != nullptr)
+        {
+          m_pFreeList = *static_cast<void**>(ptr);
+        }
+        else if (m_uiNumCarved < m_uiNumBlocks)
+        {
+          // blocks that were never used are carved off lazily, so a new slab doesn't touch all of its memory
+          ptr = ezMemoryUtils::AddByteOffset(this, SlabHeaderSize + static_cast<size_t>(m_uiNumCarved) * m_uiBlockSize);
+          ++m_uiNumCarved;
+        }
+        else
+        {
+          return nullptr;
+        }
+
+        ++m_uiNumUsed;
+        return ptr;
+      }
+    };
+
+    /// \brief Stored right behind the last slab of a segment, in the padding that is needed to align the slabs.
+    struct Segment
+    {
+      void* m_pAllocation;
+      void* m_pFirstSlab;
+      Segment* m_pNext;
+    };
+
+    struct ThreadCache
+    {
+      struct SizeClass
+      {
+        Slab* m_pCurrent = nullptr;
+        Slab* m_pPartial = nullptr;
+      };
+
+      SizeClass m_SizeClasses[NumSizeClasses];
+      Slab* m_pEmptySlabs = nullptr;
+      ezUInt32 m_uiNumEmptySlabs = 0;
+
+      ThreadCache* m_pNextCache = nullptr;
+      ThreadCache* m_pNextFreeCache = nullptr;
+
+      // other threads write to the remote free list, keep it away from the data of the owning thread
+      ezUInt8 m_Padding[64];
+      void* volatile m_pRemoteFreeList = nullptr;
+    };
+
+    struct ThreadCacheBinding
+    {
+      ThreadCache* m_pCache;
+      ezUInt32 m_uiGeneration;
+    };
+
+    ezThreadCachingHeap();
+    ~ezThreadCachingHeap();
+
+    void* Allocate(size_t uiSize, size_t uiAlign);
+    void* Reallocate(void* ptr, size_t uiCurrentSize, size_t uiNewSize, size_t uiAlign);
+    void Deallocate(void* ptr);
+
+    /// \brief Called when a thread exits, the cache and its slabs are kept for the next thread.
+    void ReleaseThreadCache(ThreadCache* pCache);
+
+    EZ_ALWAYS_INLINE ezUInt32 GetGeneration() const { return m_uiGeneration; }
+
+  private:
+    EZ_ALWAYS_INLINE static Slab* GetSlab(const void* ptr) { return static_cast<Slab*>(ezMemoryUtils::Align(const_cast<void*>(ptr), SlabSize)); }
+
+    ThreadCache* GetThreadCache();
+    ThreadCache* BindThreadCache(ThreadCacheBinding& binding);
+
+    void* AllocateSmall(ThreadCache* pCache, ezUInt32 uiSizeClass);
+    void FreeLocal(ThreadCache* pCache, Slab* pSlab, void* ptr);
+    void FreeRemote(ThreadCache* pOwner, void* ptr);
+    void CollectRemoteFrees(ThreadCache* pCache);
+
+    Slab* AcquireSlab(ThreadCache* pCache, ezUInt32 uiSizeClass);
+    void ReleaseSlab(ThreadCache* pCache, Slab* pSlab);
+    bool AllocateSegment();
+
+    static void LinkPartial(ThreadCache::SizeClass& sizeClass, Slab* pSlab);
+    static void UnlinkPartial(ThreadCache::SizeClass& sizeClass, Slab* pSlab);
+
+    ezUInt32 m_uiIndex = ezInvalidIndex;
+    ezUInt32 m_uiGeneration = 0;
+
+    ezMemoryPolicies::ezAlignedHeapAllocation m_LargeAllocation;
+
+    ezMutex m_Mutex;
+    Segment* m_pSegments = nullptr;
+    Slab* m_pFreeSlabs = nullptr;
+    ThreadCache* m_pAllCaches = nullptr;
+    ThreadCache* m_pFreeCaches = nullptr;
+  };
+} // namespace ezInternal
+
+namespace
+{
+  using ezThreadCachingHeap = ezInternal::ezThreadCachingHeap;
+
+  /// Keeps track of the existing heaps, so that exiting threads only return their caches to heaps that are still alive.
+  /// It is never destroyed, threads may exit after the static destructors ran.
+  class ezThreadCachingHeapRegistry
+  {
+  public:
+    static ezThreadCachingHeapRegistry& Get()
+    {
+      EZ_ALIGN_VARIABLE(static ezUInt8 s_Buffer[sizeof(ezThreadCachingHeapRegistry)], EZ_ALIGNMENT_OF(ezThreadCachingHeapRegistry));
+      static ezThreadCachingHeapRegistry* s_pRegistry = new (s_Buffer) ezThreadCachingHeapRegistry();
+      return *s_pRegistry;
+    }
+
+    ezMutex m_Mutex;
+    ezThreadCachingHeap* m_Heaps[MaxInstances] = {};
+    ezUInt32 m_uiNextGeneration = 1;
+
+    ezMutex m_PageMapMutex;
+  };
+
+  bool SetSlabOwners(void* pFirstSlab, ezUInt32 uiNumSlabs, ezUInt8 uiOwner)
+  {
+    ezThreadCachingHeapRegistry& registry = ezThreadCachingHeapRegistry::Get();
+    EZ_LOCK(registry.m_PageMapMutex);
+
+    const ezUInt64 uiFirstSlab = static_cast<ezUInt64>(reinterpret_cast<size_t>(pFirstSlab)) >> SlabSizeShift;
+    if (((uiFirstSlab + uiNumSlabs - 1) >> PageMapLeafBits) >= PageMapRootSize)
+      return false;
+
+    for (ezUInt64 uiSlab = uiFirstSlab; uiSlab < uiFirstSlab + uiNumSlabs; ++uiSlab)
+    {
+      const ezUInt64 uiRoot = uiSlab >> PageMapLeafBits;
+
+      ezUInt8* pLeaf = s_PageMap[uiRoot];
+      if (pLeaf == nullptr)
+      {
+        pLeaf = static_cast<ezUInt8*>(ezMemoryPolicies::ezAlignedHeapAllocation(nullptr).Allocate(PageMapLeafSize, EZ_ALIGNMENT_MINIMUM));
+        ezMemoryUtils::ZeroFill(pLeaf, PageMapLeafSize);
+
+        // publish the leaf only after it was cleared, lookups don't lock
+        ezAtomicUtils::TestAndSet(reinterpret_cast<void**>(const_cast<ezUInt8**>(&s_PageMap[uiRoot])), nullptr, pLeaf);
+      }
+
+      pLeaf[uiSlab & (PageMapLeafSize - 1)] = uiOwner;
+    }
+
+    return true;
+  }
+
+  // Plain data, so that it is still accessible while the destructors of other thread_local objects run.
+  thread_local ezThreadCachingHeap::ThreadCacheBinding tl_Bindings[MaxInstances];
+  thread_local bool tl_bThreadExiting = false;
+
+  struct ThreadExitHook
+  {
+    ~ThreadExitHook()
+    {
+      tl_bThreadExiting = true;
+
+      ezThreadCachingHeapRegistry& registry = ezThreadCachingHeapRegistry::Get();
+      EZ_LOCK(registry.m_Mutex);
+
+      for (ezUInt32 i = 0; i < MaxInstances; ++i)
+      {
+        ezThreadCachingHeap::ThreadCacheBinding& binding = tl_Bindings[i];
+
+        ezThreadCachingHeap* pHeap = registry.m_Heaps[i];
+        if (binding.m_pCache != nullptr && pHeap != nullptr && pHeap->GetGeneration() == binding.m_uiGeneration)
+        {
+          pHeap->ReleaseThreadCache(binding.m_pCache);
+        }
+
+        binding.m_pCache = nullptr;
+        binding.m_uiGeneration = 0;
+      }
+    }
+
+    bool m_bRegistered = false;
+  };
+
+  thread_local ThreadExitHook tl_ThreadExitHook;
+} // namespace
+
+namespace ezInternal
+{
+  ezThreadCachingHeap::ezThreadCachingHeap()
+    : m_LargeAllocation(nullptr)
+  {
+    ezThreadCachingHeapRegistry& registry = ezThreadCachingHeapRegistry::Get();
+    EZ_LOCK(registry.m_Mutex);
+
+    for (ezUInt32 i = 0; i < MaxInstances; ++i)
+    {
+      if (registry.m_Heaps[i] == nullptr)
+      {
+        registry.m_Heaps[i] = this;
+        m_uiIndex = i;
+
+        // generation 0 marks unused bindings
+        m_uiGeneration = registry.m_uiNextGeneration++;
+        if (m_uiGeneration == 0)
+          m_uiGeneration = registry.m_uiNextGeneration++;
+
+        break;
+      }
+    }
+  }
+
+  ezThreadCachingHeap::~ezThreadCachingHeap()
+  {
+    if (m_uiIndex != ezInvalidIndex)
+    {
+      ezThreadCachingHeapRegistry& registry = ezThreadCachingHeapRegistry::Get();
+      EZ_LOCK(registry.m_Mutex);
+      registry.m_Heaps[m_uiIndex] = nullptr;
+    }
+
+    while (m_pSegments != nullptr)
+    {
+      Segment* pSegment = m_pSegments;
+      m_pSegments = pSegment->m_pNext;
+
+      SetSlabOwners(pSegment->m_pFirstSlab, SlabsPerSegment, 0);
+      ezPageAllocator::DeallocatePage(pSegment->m_pAllocation);
+    }
+
+    while (m_pAllCaches != nullptr)
+    {
+      ThreadCache* pCache = m_pAllCaches;
+      m_pAllCaches = pCache->m_pNextCache;
+
+      pCache->~ThreadCache();
+      m_LargeAllocation.Deallocate(pCache);
+    }
+  }
+
+  void* ezThreadCachingHeap::Allocate(size_t uiSize, size_t uiAlign)
+  {
+    if (uiSize <= MaxSmallAllocationSize && uiAlign <= SmallAlignment)
+    {
+      if (ThreadCache* pCache = GetThreadCache())
+      {
+        const ezUInt32 uiSizeClass = GetSizeClass(ezMath::Max<size_t>(uiSize, 1));
+
+        if (Slab* pSlab = pCache->m_SizeClasses[uiSizeClass].m_pCurrent)
+        {
+          if (void* ptr = pSlab->Pop())
+            return ptr;
+        }
+
+        if (void* ptr = AllocateSmall(pCache, uiSizeClass))
+          return ptr;
+      }
+    }
+
+    return m_LargeAllocation.Allocate(uiSize, uiAlign);
+  }
+
+  void* ezThreadCachingHeap::Reallocate(void* ptr, size_t uiCurrentSize, size_t uiNewSize, size_t uiAlign)
+  {
+    // growing within the same size class doesn't need to move anything
+    if (ptr != nullptr && uiNewSize <= MaxSmallAllocationSize && uiAlign <= SmallAlignment && GetSlabOwner(ptr) != 0 &&
+        GetSlab(ptr)->m_uiSizeClass == GetSizeClass(ezMath::Max<size_t>(uiNewSize, 1)))
+    {
+      return ptr;
+    }
+
+    void* pNewPtr = Allocate(uiNewSize, uiAlign);
+
+    if (ptr != nullptr)
+    {
+      ezMemoryUtils::RawByteCopy(pNewPtr, ptr, ezMath::Min(uiCurrentSize, uiNewSize));
+      Deallocate(ptr);
+    }
+
+    return pNewPtr;
+  }
+
+  void ezThreadCachingHeap::Deallocate(void* ptr)
+  {
+    const ezUInt8 uiOwner = GetSlabOwner(ptr);
+
+    if (uiOwner == 0)
+    {
+      m_LargeAllocation.Deallocate(ptr);
+      return;
+    }
+
+    EZ_ASSERT_DEBUG(uiOwner == m_uiIndex + 1, "The memory was not allocated by this allocator");
+
+    Slab* pSlab = GetSlab(ptr);
+    const ThreadCacheBinding& binding = tl_Bindings[m_uiIndex];
+
+    if (binding.m_uiGeneration == m_uiGeneration && pSlab->m_pOwner == binding.m_pCache)
+    {
+      FreeLocal(binding.m_pCache, pSlab, ptr);
+    }
+    else
+    {
+      FreeRemote(pSlab->m_pOwner, ptr);
+    }
+  }
+
+  void ezThreadCachingHeap::ReleaseThreadCache(ThreadCache* pCache)
+  {
+    EZ_LOCK(m_Mutex);
+
+    pCache->m_pNextFreeCache = m_pFreeCaches;
+    m_pFreeCaches = pCache;
+  }
+
+  EZ_FORCE_INLINE ezThreadCachingHeap::ThreadCache* ezThreadCachingHeap::GetThreadCache()
+  {
+    if (m_uiIndex == ezInvalidIndex)
+      return nullptr;
+
+    ThreadCacheBinding& binding = tl_Bindings[m_uiIndex];
+    if (binding.m_uiGeneration == m_uiGeneration)
+      return binding.m_pCache;
+
+    return BindThreadCache(binding);
+  }
+
+  ezThreadCachingHeap::ThreadCache* ezThreadCachingHeap::BindThreadCache(ThreadCacheBinding& binding)
+  {
+    // allocations from destructors of other thread_local objects go to the heap directly
+    if (tl_bThreadExiting)
+      return nullptr;
+
+    // makes sure that the hook is constructed, so its destructor returns the cache when the thread exits
+    tl_ThreadExitHook.m_bRegistered = true;
+
+    ThreadCache* pCache = nullptr;
+    {
+      EZ_LOCK(m_Mutex);
+
+      if (m_pFreeCaches != nullptr)
+      {
+        pCache = m_pFreeCaches;
+        m_pFreeCaches = pCache->m_pNextFreeCache;
+        pCache->m_pNextFreeCache = nullptr;
+      }
+    }
+
+    if (pCache == nullptr)
+    {
+      pCache = new (m_LargeAllocation.Allocate(sizeof(ThreadCache), 64)) ThreadCache();
+
+      EZ_LOCK(m_Mutex);
+      pCache->m_pNextCache = m_pAllCaches;
+      m_pAllCaches = pCache;
+    }
+
+    binding.m_pCache = pCache;
+    binding.m_uiGeneration = m_uiGeneration;
+    return pCache;
+  }
+
+  void* ezThreadCachingHeap::AllocateSmall(ThreadCache* pCache, ezUInt32 uiSizeClass)
+  {
+    // blocks that other threads gave back may make slabs of this size class usable again
+    CollectRemoteFrees(pCache);
+
+    ThreadCache::SizeClass& sizeClass = pCache->m_SizeClasses[uiSizeClass];
+
+    if (Slab* pCurrent = sizeClass.m_pCurrent)
+    {
+      if (void* ptr = pCurrent->Pop())
+        return ptr;
+
+      pCurrent->m_State = Slab::State::Full;
+      sizeClass.m_pCurrent = nullptr;
+    }
+
+    Slab* pSlab = sizeClass.m_pPartial;
+    if (pSlab != nullptr)
+    {
+      UnlinkPartial(sizeClass, pSlab);
+    }
+    else
+    {
+      pSlab = AcquireSlab(pCache, uiSizeClass);
+      if (pSlab == nullptr)
+        return nullptr;
+    }
+
+    pSlab->m_State = Slab::State::Current;
+    sizeClass.m_pCurrent = pSlab;
+
+    return pSlab->Pop();
+  }
+
+  void ezThreadCachingHeap::FreeLocal(ThreadCache* pCache, Slab* pSlab, void* ptr)
+  {
+    EZ_ASSERT_DEBUG(pSlab->m_uiNumUsed > 0, "Invalid deallocation");
+
+    *static_cast<void**>(ptr) = pSlab->m_pFreeList;
+    pSlab->m_pFreeList = ptr;
+    --pSlab->m_uiNumUsed;
+
+    if (pSlab->m_State == Slab::State::Current)
+      return;
+
+    ThreadCache::SizeClass& sizeClass = pCache->m_SizeClasses[pSlab->m_uiSizeClass];
+
+    if (pSlab->m_State == Slab::State::Full)
+    {
+      pSlab->m_State = Slab::State::Partial;
+      LinkPartial(sizeClass, pSlab);
+    }
+
+    if (pSlab->m_uiNumUsed == 0)
+    {
+      UnlinkPartial(sizeClass, pSlab);
+      ReleaseSlab(pCache, pSlab);
+    }
+  }
+
+  void ezThreadCachingHeap::FreeRemote(ThreadCache* pOwner, void* ptr)
+  {
+    EZ_ASSERT_DEBUG(pOwner != nullptr, "Invalid deallocation, the memory is not in use");
+
+    void* pHead;
+    do
+    {
+      pHead = pOwner->m_pRemoteFreeList;
+      *static_cast<void**>(ptr) = pHead;
+    } while (!ezAtomicUtils::TestAndSet(const_cast<void**>(&pOwner->m_pRemoteFreeList), pHead, ptr));
+  }
+
+  void ezThreadCachingHeap::CollectRemoteFrees(ThreadCache* pCache)
+  {
+    if (pCache->m_pRemoteFreeList == nullptr)
+      return;
+
+    // only the owning thread takes from the list, so there is no ABA problem
+    void* pList;
+    do
+    {
+      pList = pCache->m_pRemoteFreeList;
+    } while (!ezAtomicUtils::TestAndSet(const_cast<void**>(&pCache->m_pRemoteFreeList), pList, nullptr));
+
+    while (pList != nullptr)
+    {
+      void* pNext = *static_cast<void**>(pList);
+      FreeLocal(pCache, GetSlab(pList), pList);
+      pList = pNext;
+    }
+  }
+
+  ezThreadCachingHeap::Slab* ezThreadCachingHeap::AcquireSlab(ThreadCache* pCache, ezUInt32 uiSizeClass)
+  {
+    Slab* pSlab = pCache->m_pEmptySlabs;
+
+    if (pSlab != nullptr)
+    {
+      pCache->m_pEmptySlabs = pSlab->m_pNext;
+      --pCache->m_uiNumEmptySlabs;
+    }
+    else
+    {
+      EZ_LOCK(m_Mutex);
+
+      if (m_pFreeSlabs == nullptr && !AllocateSegment())
+        return nullptr;
+
+      pSlab = m_pFreeSlabs;
+      m_pFreeSlabs = pSlab->m_pNext;
+    }
+
+    pSlab->m_pOwner = pCache;
+    pSlab->m_pPrev = nullptr;
+    pSlab->m_pNext = nullptr;
+    pSlab->m_pFreeList = nullptr;
+    pSlab->m_uiBlockSize = GetBlockSize(uiSizeClass);
+    pSlab->m_uiNumBlocks = static_cast<ezUInt32>((SlabSize - SlabHeaderSize) / pSlab->m_uiBlockSize);
+    pSlab->m_uiNumUsed = 0;
+    pSlab->m_uiNumCarved = 0;
+    pSlab->m_uiSizeClass = static_cast<ezUInt8>(uiSizeClass);
+    pSlab->m_State = Slab::State::Free;
+
+    return pSlab;
+  }
+
+  void ezThreadCachingHeap::ReleaseSlab(ThreadCache* pCache, Slab* pSlab)
+  {
+    pSlab->m_pOwner = nullptr;
+    pSlab->m_State = Slab::State::Free;
+
+    if (pCache->m_uiNumEmptySlabs < MaxCachedEmptySlabs)
+    {
+      pSlab->m_pNext = pCache->m_pEmptySlabs;
+      pCache->m_pEmptySlabs = pSlab;
+      ++pCache->m_uiNumEmptySlabs;
+      return;
+    }
+
+    EZ_LOCK(m_Mutex);
+    pSlab->m_pNext = m_pFreeSlabs;
+    m_pFreeSlabs = pSlab;
+  }
+
+  bool ezThreadCachingHeap::AllocateSegment()
+  {
+    EZ_ASSERT_DEBUG(m_Mutex.IsLocked(), "The heap has to be locked");
+
+    // allocate one slab more than needed, so the slabs can be aligned to their size and GetSlab() works on any block
+    void* pAllocation = ezPageAllocator::AllocatePage(SegmentSize + SlabSize);
+    if (pAllocation == nullptr)
+      return false;
+
+    void* pFirstSlab = ezMemoryUtils::Align(ezMemoryUtils::AddByteOffset(pAllocation, SlabSize - 1), SlabSize);
+
+    // the page map can't represent memory outside of 48 bit address space
+    if (!SetSlabOwners(pFirstSlab, SlabsPerSegment, static_cast<ezUInt8>(m_uiIndex + 1)))
+    {
+      ezPageAllocator::DeallocatePage(pAllocation);
+      return false;
+    }
+
+    Segment* pSegment = static_cast<Segment*>(ezMemoryUtils::AddByteOffset(pFirstSlab, SegmentSize));
+    EZ_ASSERT_DEBUG(ezMemoryUtils::AddByteOffset(pSegment, sizeof(Segment)) <= ezMemoryUtils::AddByteOffset(pAllocation, SegmentSize + SlabSize),
+      "Not enough space for the segment header");
+
+    pSegment->m_pAllocation = pAllocation;
+    pSegment->m_pFirstSlab = pFirstSlab;
+    pSegment->m_pNext = m_pSegments;
+    m_pSegments = pSegment;
+
+    for (ezUInt32 i = SlabsPerSegment; i > 0; --i)
+    {
+      Slab* pSlab = static_cast<Slab*>(ezMemoryUtils::AddByteOffset(pFirstSlab, (i - 1) * SlabSize));
+      pSlab->m_pOwner = nullptr;
+      pSlab->m_State = Slab::State::Free;
+      pSlab->m_pNext = m_pFreeSlabs;
+      m_pFreeSlabs = pSlab;
+    }
+
+    return true;
+  }
+
+  void ezThreadCachingHeap::LinkPartial(ThreadCache::SizeClass& sizeClass, Slab* pSlab)
+  {
+    pSlab->m_pPrev = nullptr;
+    pSlab->m_pNext = sizeClass.m_pPartial;
+
+    if (sizeClass.m_pPartial != nullptr)
+      sizeClass.m_pPartial->m_pPrev = pSlab;
+
+    sizeClass.m_pPartial = pSlab;
+  }
+
+  void ezThreadCachingHeap::UnlinkPartial(ThreadCache::SizeClass& sizeClass, Slab* pSlab)
+  {
+    if (pSlab->m_pPrev != nullptr)
+      pSlab->m_pPrev->m_pNext = pSlab->m_pNext;
+    else
+      sizeClass.m_pPartial = pSlab->m_pNext;
+
+    if (pSlab->m_pNext != nullptr)
+      pSlab->m_pNext->m_pPrev = pSlab->m_pPrev;
+
+    pSlab->m_pPrev = nullptr;
+    pSlab->m_pNext = nullptr;
+  }
+} // namespace ezInternal
+
+namespace ezMemoryPolicies
+{
+  ezThreadCachingHeapAllocation::ezThreadCachingHeapAllocation(ezAllocatorBase* pParent)
+  {
+    void* pMemory = ezAlignedHeapAllocation(nullptr).Allocate(sizeof(ezInternal::ezThreadCachingHeap), EZ_ALIGNMENT_OF(ezInternal::ezThreadCachingHeap));
+    m_pHeap = new (pMemory) ezInternal::ezThreadCachingHeap();
+  }
+
+  ezThreadCachingHeapAllocation::~ezThreadCachingHeapAllocation()
+  {
+    m_pHeap->~ezThreadCachingHeap();
+    ezAlignedHeapAllocation(nullptr).Deallocate(m_pHeap);
+  }
+
+  void* ezThreadCachingHeapAllocation::Allocate(size_t uiSize, size_t uiAlign)
+  {
+    return m_pHeap->Allocate(uiSize, uiAlign);
+  }
+
+  void* ezThreadCachingHeapAllocation::Reallocate(void* currentPtr, size_t uiCurrentSize, size_t uiNewSize, size_t uiAlign)
+  {
+    return m_pHeap->Reallocate(currentPtr, uiCurrentSize, uiNewSize, uiAlign);
+  }
+
+  void ezThreadCachingHeapAllocation::Deallocate(void* ptr)
+  {
+    m_pHeap->Deallocate(ptr);
+  }
+} // namespace ezMemoryPolicies
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Memory_Policies_ThreadCachingHeapAllocation);
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+
+namespace ezInternal
+{
+  class ezThreadCachingHeap;
+}
+
+namespace ezMemoryPolicies
+{
+  /// \brief General purpose heap allocation policy that serves small allocations from per-thread caches.
+  ///
+  /// Allocations of up to MaxSmallAllocationSize bytes are rounded up to one of 32 size classes and taken from 64 KB slabs, which are
+  /// carved out of 4 MB segments that are allocated through ezPageAllocator. Every thread that allocates gets its own cache that owns
+  /// the slabs it allocates from, so allocating and freeing on the same thread never locks.
+  /// Memory that is freed on another thread is pushed onto a lock-free list of the owning cache and picked up by the owning thread once
+  /// its slabs run out of free blocks. When a thread exits, its cache including all its slabs is handed over to the next thread that
+  /// needs one.
+  ///
+  /// Larger allocations and allocations that need an alignment above 16 bytes are forwarded to ezAlignedHeapAllocation.
+  /// All memory is returned to the system when the allocator is destroyed. At most MaxInstances allocators with this policy can exist
+  /// at the same time, additional ones forward all allocations to ezAlignedHeapAllocation.
+  ///
+  /// Enable EZ_USE_THREAD_CACHING_ALLOCATIONS in UserConfig.h to use this policy for the default allocator.
+  ///
+  /// \see ezAllocator
+  class EZ_FOUNDATION_DLL ezThreadCachingHeapAllocation
+  {
+  public:
+    /// \brief Allocations above this size are not cached.
+    static constexpr ezUInt32 MaxSmallAllocationSize = 8192;
+
+    /// \brief The maximum number of allocators with this policy that can use thread caches at the same time.
+    static constexpr ezUInt32 MaxInstances = 32;
+
+    ezThreadCachingHeapAllocation(ezAllocatorBase* pParent);
+    ~ezThreadCachingHeapAllocation();
+
+    void* Allocate(size_t uiSize, size_t uiAlign);
+    void* Reallocate(void* currentPtr, size_t uiCurrentSize, size_t uiNewSize, size_t uiAlign);
+    void Deallocate(void* ptr);
+
+    EZ_ALWAYS_INLINE ezAllocatorBase* GetParent() const { return nullptr; }
+
+  private:
+    ezInternal::ezThreadCachingHeap* m_pHeap;
+  };
+} // namespace ezMemoryPolicies
@@ -5,9 +5,13 @@
 #include <Foundation/Configuration/Startup.h>
 #include <Foundation/Containers/IdTable.h>
 #include <Foundation/Containers/StaticRingBuffer.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/JSONWriter.h>
+#include <Foundation/IO/OSFile.h>
 #include <Foundation/Memory/CommonAllocators.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
 #include <Foundation/Threading/ThreadUtils.h>
 
 #if EZ_ENABLED(EZ_USE_PROFILING)
@@ -42,6 +46,7 @@ EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, ProfilingSystem)
   ON_CORESYSTEMS_SHUTDOWN
   {
     s_ProfileCaptureDataTransfer.DisableDataTransfer();
+    ezProfilingSystem::StopStreamingCapture();
     ezProfilingSystem::Reset();
   }
 
@@ -71,6 +76,11 @@ namespace
 
     ezUInt64 m_uiThreadId = 0;
     bool IsMainThread() const { return m_uiThreadId == s_MainThreadId; }
+
+    /// Scopes that still have to be written by a streaming capture. The writer thread swaps the array with an empty one, so the lock is only
+    /// ever held for a moment.
+    ezMutex m_StreamedScopesMutex;
+    ezDynamicArray<ezProfilingSystem::CPUScope> m_StreamedScopes;
   };
 
   template <ezUInt32 SizeInBytes>
@@ -111,9 +121,396 @@ namespace
 
   static GPUScopesBuffer* s_GPUScopes;
 
+  //////////////////////////////////////////////////////////////////////////
+  // Streaming capture
+
+  /// Layout of a streaming capture file:
+  ///
+  /// Header: ezUInt32 magic, ezUInt8 version, ezUInt64 process ID, ezUInt64 frame count at the start of the capture.
+  /// Followed by records, each starting with an ezUInt8 record type. All integers in records are LEB128 encoded, signed ones with zigzag encoding.
+  ///
+  /// String:   length, characters. Strings are numbered in the order in which they appear, starting at 1. Index 0 means 'no string'.
+  /// Thread:   thread ID, name string index. Threads are numbered in the order in which they appear, starting at 0.
+  /// CPUScope: thread index, name string index, function name string index, begin time delta (signed), duration.
+  /// GPUScope: name string index, begin time delta (signed), duration.
+  /// Frame:    start time delta (signed).
+  /// End:      written when the capture is stopped. A file without it was not closed properly, all complete records are still valid.
+  ///
+  /// Times are in nanoseconds. Begin times are relative to the previous begin time of the same thread, the GPU or the frames, respectively.
+  namespace StreamFormat
+  {
+    constexpr ezUInt32 Magic = 0x5450455A; // 'EZPT'
+    constexpr ezUInt8 Version = 1;
+
+    enum Record : ezUInt8
+    {
+      End = 0,
+      String = 1,
+      Thread = 2,
+      CPUScope = 3,
+      GPUScope = 4,
+      Frame = 5,
+    };
+  } // namespace StreamFormat
+
+  enum
+  {
+    /// If the writer thread can't keep up, each thread only buffers this many scopes, further scopes are dropped.
+    STREAMING_MAX_PENDING_SCOPES = 256 * 1024,
+  };
+
+  EZ_ALWAYS_INLINE void WriteVarUInt(ezDynamicArray<ezUInt8>& out, ezUInt64 uiValue)
+  {
+    while (uiValue >= 0x80)
+    {
+      out.PushBack(static_cast<ezUInt8>(uiValue | 0x80));
+      uiValue >>= 7;
+    }
+
+    out.PushBack(static_cast<ezUInt8>(uiValue));
+  }
+
+  EZ_ALWAYS_INLINE void WriteVarInt(ezDynamicArray<ezUInt8>& out, ezInt64 iValue)
+  {
+    WriteVarUInt(out, (static_cast<ezUInt64>(iValue) << 1) ^ static_cast<ezUInt64>(iValue >> 63));
+  }
+
+  EZ_ALWAYS_INLINE ezInt64 ToNanoseconds(ezTime t)
+  {
+    return static_cast<ezInt64>(t.GetNanoseconds());
+  }
+
+  /// Decodes the records of a streaming capture. Running out of data is not an error, the capture may not have been stopped properly.
+  struct StreamDecoder
+  {
+    const ezUInt8* m_pCur = nullptr;
+    const ezUInt8* m_pEnd = nullptr;
+    bool m_bOutOfData = false;
+
+    bool HasData() const { return m_pCur < m_pEnd; }
+
+    void ReadRaw(void* pDest, ezUInt32 uiBytes)
+    {
+      if (static_cast<ezUInt64>(m_pEnd - m_pCur) < uiBytes)
+      {
+        m_bOutOfData = true;
+        m_pCur = m_pEnd;
+        ezMemoryUtils::ZeroFill(static_cast<ezUInt8*>(pDest), uiBytes);
+        return;
+      }
+
+      ezMemoryUtils::Copy(static_cast<ezUInt8*>(pDest), m_pCur, uiBytes);
+      m_pCur += uiBytes;
+    }
+
+    ezUInt64 ReadVarUInt()
+    {
+      ezUInt64 uiValue = 0;
+
+      for (ezUInt32 uiShift = 0; uiShift < 64; uiShift += 7)
+      {
+        if (m_pCur == m_pEnd)
+        {
+          m_bOutOfData = true;
+          return 0;
+        }
+
+        const ezUInt8 uiByte = *m_pCur++;
+        uiValue |= static_cast<ezUInt64>(uiByte & 0x7F) << uiShift;
+
+        if ((uiByte & 0x80) == 0)
+          break;
+      }
+
+      return uiValue;
+    }
+
+    ezInt64 ReadVarInt()
+    {
+      const ezUInt64 uiValue = ReadVarUInt();
+      return static_cast<ezInt64>(uiValue >> 1) ^ -static_cast<ezInt64>(uiValue & 1);
+    }
+
+    ezStringView ReadString(ezUInt64 uiLength)
+    {
+      if (static_cast<ezUInt64>(m_pEnd - m_pCur) < uiLength)
+      {
+        m_bOutOfData = true;
+        m_pCur = m_pEnd;
+        return {};
+      }
+
+      const char* szStart = reinterpret_cast<const char*>(m_pCur);
+      m_pCur += uiLength;
+      return ezStringView(szStart, szStart + uiLength);
+    }
+  };
+
+  static ezAtomicBool s_bStreamingCaptureActive;
+  static ezAtomicInteger64 s_iNumDroppedStreamedScopes;
+
+  /// GPU scopes and frame start times that still have to be written by a streaming capture.
+  static ezMutex s_StreamedDataMutex;
+  static ezDynamicArray<ezProfilingSystem::GPUScope> s_StreamedGPUScopes;
+  static ezDynamicArray<ezTime> s_StreamedFrameStartTimes;
+
+  class ezProfilingStreamWriter : public ezThread
+  {
+  public:
+    ezProfilingStreamWriter()
+      : ezThread("Profiling Stream Writer")
+    {
+    }
+
+    ezResult Open(const char* szFile, ezUInt64 uiFrameCount)
+    {
+      ezStringBuilder sAbsolutePath = szFile;
+      if (!ezPathUtils::IsAbsolutePath(szFile) && ezFileSystem::ResolvePath(szFile, &sAbsolutePath, nullptr).Failed())
+      {
+        ezLog::Error("Could not resolve the path '{0}' for the profiling capture.", szFile);
+        return EZ_FAILURE;
+      }
+
+      // the file system is not used for writing, the capture may still be running when it is shut down
+      if (m_File.Open(sAbsolutePath, ezFileOpenMode::Write).Failed())
+      {
+        ezLog::Error("Could not open '{0}' for the profiling capture.", sAbsolutePath);
+        return EZ_FAILURE;
+      }
+
+      const ezUInt32 uiMagic = StreamFormat::Magic;
+      const ezUInt8 uiVersion = StreamFormat::Version;
+#  if EZ_ENABLED(EZ_SUPPORTS_PROCESSES)
+      const ezUInt64 uiProcessID = ezProcess::GetCurrentProcessID();
+#  else
+      const ezUInt64 uiProcessID = 0;
+#  endif
+
+      m_Encoded.PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(&uiMagic), sizeof(uiMagic)));
+      m_Encoded.PushBack(uiVersion);
+      m_Encoded.PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(&uiProcessID), sizeof(uiProcessID)));
+      m_Encoded.PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(&uiFrameCount), sizeof(uiFrameCount)));
+
+      return WriteEncoded();
+    }
+
+    /// Stops the thread, writes everything that is left and closes the file.
+    void Close()
+    {
+      m_bStop = true;
+      m_WakeUp.RaiseSignal();
+      Join();
+
+      Flush();
+
+      EZ_LOCK(m_FlushMutex);
+      m_Encoded.PushBack(StreamFormat::End);
+      WriteEncoded().IgnoreResult();
+      m_File.Close();
+    }
+
+    void Flush()
+    {
+      EZ_LOCK(m_FlushMutex);
+
+      if (!m_File.IsOpen())
+        return;
+
+      // thread buffers are only ever deleted on shutdown, after the capture was stopped
+      ezHybridArray<CpuScopesBufferBase*, 32> cpuBuffers;
+      {
+        EZ_LOCK(s_AllCpuScopesMutex);
+        cpuBuffers = s_AllCpuScopes;
+      }
+
+      for (CpuScopesBufferBase* pBuffer : cpuBuffers)
+      {
+        {
+          EZ_LOCK(pBuffer->m_StreamedScopesMutex);
+          m_CPUScopes.Swap(pBuffer->m_StreamedScopes);
+        }
+
+        if (m_CPUScopes.IsEmpty())
+          continue;
+
+        const ezUInt32 uiThreadIndex = GetThreadIndex(pBuffer->m_uiThreadId);
+
+        for (const ezProfilingSystem::CPUScope& scope : m_CPUScopes)
+        {
+          const ezUInt32 uiName = GetStringIndex(scope.m_szName);
+          const ezUInt32 uiFunction = GetStringIndex(scope.m_szFunctionName);
+          const ezInt64 iBeginTime = ToNanoseconds(scope.m_BeginTime);
+
+          m_Encoded.PushBack(StreamFormat::CPUScope);
+          WriteVarUInt(m_Encoded, uiThreadIndex);
+          WriteVarUInt(m_Encoded, uiName);
+          WriteVarUInt(m_Encoded, uiFunction);
+          WriteVarInt(m_Encoded, iBeginTime - m_LastBeginTimes[uiThreadIndex]);
+          WriteVarUInt(m_Encoded, static_cast<ezUInt64>(ezMath::Max<ezInt64>(ToNanoseconds(scope.m_EndTime) - iBeginTime, 0)));
+
+          m_LastBeginTimes[uiThreadIndex] = iBeginTime;
+        }
+
+        m_Stats.m_uiNumCPUScopes += m_CPUScopes.GetCount();
+        m_CPUScopes.Clear();
+      }
+
+      {
+        EZ_LOCK(s_StreamedDataMutex);
+        m_GPUScopes.Swap(s_StreamedGPUScopes);
+        m_FrameStartTimes.Swap(s_StreamedFrameStartTimes);
+      }
+
+      for (const ezProfilingSystem::GPUScope& scope : m_GPUScopes)
+      {
+        const ezUInt32 uiName = GetStringIndex(scope.m_szName);
+        const ezInt64 iBeginTime = ToNanoseconds(scope.m_BeginTime);
+
+        m_Encoded.PushBack(StreamFormat::GPUScope);
+        WriteVarUInt(m_Encoded, uiName);
+        WriteVarInt(m_Encoded, iBeginTime - m_iLastGPUBeginTime);
+        WriteVarUInt(m_Encoded, static_cast<ezUInt64>(ezMath::Max<ezInt64>(ToNanoseconds(scope.m_EndTime) - iBeginTime, 0)));
+
+        m_iLastGPUBeginTime = iBeginTime;
+      }
+
+      for (ezTime frameStartTime : m_FrameStartTimes)
+      {
+        const ezInt64 iStartTime = ToNanoseconds(frameStartTime);
+
+        m_Encoded.PushBack(StreamFormat::Frame);
+        WriteVarInt(m_Encoded, iStartTime - m_iLastFrameStartTime);
+
+        m_iLastFrameStartTime = iStartTime;
+      }
+
+      m_Stats.m_uiNumGPUScopes += m_GPUScopes.GetCount();
+      m_Stats.m_uiNumFrames += m_FrameStartTimes.GetCount();
+      m_GPUScopes.Clear();
+      m_FrameStartTimes.Clear();
+
+      WriteEncoded().IgnoreResult();
+    }
+
+    ezProfilingSystem::StreamingCaptureStats GetStats()
+    {
+      EZ_LOCK(m_FlushMutex);
+      return m_Stats;
+    }
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      while (!m_bStop)
+      {
+        m_WakeUp.WaitForSignal(ezTime::Milliseconds(50));
+        Flush();
+      }
+
+      return 0;
+    }
+
+    ezResult WriteEncoded()
+    {
+      if (m_Encoded.IsEmpty())
+        return EZ_SUCCESS;
+
+      const ezResult res = m_File.Write(m_Encoded.GetData(), m_Encoded.GetCount());
+      m_Stats.m_uiBytesWritten += m_Encoded.GetCount();
+      m_Encoded.Clear();
+
+      return res;
+    }
+
+    ezUInt32 GetStringIndex(const char* szString)
+    {
+      if (szString == nullptr)
+        return 0;
+
+      const ezStringView sString = szString;
+
+      if (auto it = m_StringIndices.Find(sString); it.IsValid())
+        return it.Value();
+
+      const ezUInt32 uiIndex = m_StringIndices.GetCount() + 1;
+      m_StringIndices.Insert(sString, uiIndex);
+
+      m_Encoded.PushBack(StreamFormat::String);
+      WriteVarUInt(m_Encoded, sString.GetElementCount());
+      m_Encoded.PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(sString.GetStartPointer()), sString.GetElementCount()));
+
+      return uiIndex;
+    }
+
+    ezUInt32 GetThreadIndex(ezUInt64 uiThreadId)
+    {
+      if (const ezUInt32* pIndex = m_ThreadIndices.GetValue(uiThreadId))
+        return *pIndex;
+
+      ezString sName;
+      {
+        EZ_LOCK(s_ThreadInfosMutex);
+
+        // thread IDs may be reused, the last entry belongs to the thread that is alive
+        for (ezUInt32 i = s_ThreadInfos.GetCount(); i > 0; --i)
+        {
+          if (s_ThreadInfos[i - 1].m_uiThreadId == uiThreadId)
+          {
+            sName = s_ThreadInfos[i - 1].m_sName;
+            break;
+          }
+        }
+      }
+
+      const ezUInt32 uiNameIndex = GetStringIndex(sName.GetData());
+
+      const ezUInt32 uiIndex = m_ThreadIndices.GetCount();
+      m_ThreadIndices.Insert(uiThreadId, uiIndex);
+      m_LastBeginTimes.PushBack(0);
+
+      m_Encoded.PushBack(StreamFormat::Thread);
+      WriteVarUInt(m_Encoded, uiThreadId);
+      WriteVarUInt(m_Encoded, uiNameIndex);
+
+      return uiIndex;
+    }
+
+    ezAtomicBool m_bStop;
+    ezThreadSignal m_WakeUp;
+
+    ezMutex m_FlushMutex;
+    ezOSFile m_File;
+    ezDynamicArray<ezUInt8> m_Encoded;
+    ezProfilingSystem::StreamingCaptureStats m_Stats;
+
+    ezHashTable<ezString, ezUInt32> m_StringIndices;
+    ezHashTable<ezUInt64, ezUInt32> m_ThreadIndices;
+    ezDynamicArray<ezInt64> m_LastBeginTimes;
+    ezInt64 m_iLastGPUBeginTime = 0;
+    ezInt64 m_iLastFrameStartTime = 0;
+
+    ezDynamicArray<ezProfilingSystem::CPUScope> m_CPUScopes;
+    ezDynamicArray<ezProfilingSystem::GPUScope> m_GPUScopes;
+    ezDynamicArray<ezTime> m_FrameStartTimes;
+  };
+
+  static ezMutex s_StreamWriterMutex;
+  static ezProfilingStreamWriter* s_pStreamWriter = nullptr;
+  static ezProfilingSystem::StreamingCaptureStats s_LastStreamingCaptureStats;
+
   static ezEventSubscriptionID s_PluginEventSubscription = 0;
   void PluginEvent(const ezPluginEvent& e)
   {
+    if (e.m_EventType == ezPluginEvent::BeforeUnloading)
+    {
+      // function names may point into the plugin, they have to be written before it is gone
+      EZ_LOCK(s_StreamWriterMutex);
+      if (s_pStreamWriter != nullptr)
+      {
+        s_pStreamWriter->Flush();
+      }
+    }
+
     if (e.m_EventType == ezPluginEvent::AfterUnloading)
     {
       // When a plugin is unloaded we need to clear all profiling data
@@ -134,6 +531,7 @@ void ezProfilingSystem::ProfilingData::Clear()
   m_FrameStartTimes.Clear();
   m_GPUScopes.Clear();
   m_ThreadInfos.Clear();
+  m_StringStorages.Clear();
 }
 
 void ezProfilingSystem::ProfilingData::Merge(ProfilingData& out_Merged, ezArrayPtr<const ProfilingData*> inputs)
@@ -167,6 +565,7 @@ void ezProfilingSystem::ProfilingData::Merge(ProfilingData& out_Merged, ezArrayP
     {
       out_Merged.m_FrameStartTimes.PushBackRange(pd->m_FrameStartTimes);
       out_Merged.m_GPUScopes.PushBackRange(pd->m_GPUScopes);
+      out_Merged.m_StringStorages.PushBackRange(pd->m_StringStorages);
     }
   }
 
@@ -462,6 +861,179 @@ ezResult ezProfilingSystem::ProfilingData::Write(ezStreamWriter& outputStream) c
   return writer.HadWriteError() ? EZ_FAILURE : EZ_SUCCESS;
 }
 
+ezResult ezProfilingSystem::ProfilingData::ReadStreamingCapture(ezStreamReader& inputStream)
+{
+  Clear();
+
+  ezDynamicArray<ezUInt8> fileContent;
+  ezArrayPtr<const ezUInt8> data;
+
+  if (!inputStream.GetRemainingContiguousData(data))
+  {
+    ezUInt8 temp[1024 * 16];
+    while (true)
+    {
+      const ezUInt64 uiRead = inputStream.ReadBytes(temp, EZ_ARRAY_SIZE(temp));
+      fileContent.PushBackRange(ezArrayPtr<const ezUInt8>(temp, static_cast<ezUInt32>(uiRead)));
+
+      if (uiRead < EZ_ARRAY_SIZE(temp))
+        break;
+    }
+
+    data = fileContent;
+  }
+
+  StreamDecoder decoder;
+  decoder.m_pCur = data.GetPtr();
+  decoder.m_pEnd = data.GetPtr() + data.GetCount();
+
+  ezUInt32 uiMagic = 0;
+  ezUInt8 uiVersion = 0;
+  ezUInt64 uiProcessID = 0;
+  ezUInt64 uiStartFrameCount = 0;
+  decoder.ReadRaw(&uiMagic, sizeof(uiMagic));
+  decoder.ReadRaw(&uiVersion, sizeof(uiVersion));
+  decoder.ReadRaw(&uiProcessID, sizeof(uiProcessID));
+  decoder.ReadRaw(&uiStartFrameCount, sizeof(uiStartFrameCount));
+
+  if (decoder.m_bOutOfData || uiMagic != StreamFormat::Magic || uiVersion != StreamFormat::Version)
+  {
+    ezLog::Error("The data is not a streaming profiling capture or was written by an incompatible version.");
+    return EZ_FAILURE;
+  }
+
+  m_uiFramesThreadID = 1;
+  m_uiGPUThreadID = 0;
+  m_uiProcessID = static_cast<ezOsProcessID>(uiProcessID);
+
+  ezSharedPtr<StringStorage> pStorage = EZ_DEFAULT_NEW(StringStorage);
+  m_StringStorages.PushBack(pStorage);
+
+  // maps the string indices of the capture to the strings in pStorage, index 0 means 'no string'
+  ezDynamicArray<const char*> strings;
+  strings.PushBack("");
+
+  ezDynamicArray<ezInt64> lastBeginTimes;
+  ezInt64 iLastGPUBeginTime = 0;
+  ezInt64 iLastFrameStartTime = 0;
+
+  auto InvalidData = [this](const char* szWhat) {
+    ezLog::Error("Invalid streaming profiling capture: {0}", szWhat);
+    Clear();
+    return EZ_FAILURE;
+  };
+
+  while (decoder.HasData())
+  {
+    const ezUInt8 uiRecord = *decoder.m_pCur++;
+
+    if (uiRecord == StreamFormat::End)
+      break;
+
+    switch (uiRecord)
+    {
+      case StreamFormat::String:
+      {
+        const ezStringView sString = decoder.ReadString(decoder.ReadVarUInt());
+        if (decoder.m_bOutOfData)
+          break;
+
+        ezString& sStored = pStorage->m_Strings.ExpandAndGetRef();
+        sStored = sString;
+        strings.PushBack(sStored.GetData());
+      }
+      break;
+
+      case StreamFormat::Thread:
+      {
+        const ezUInt64 uiThreadId = decoder.ReadVarUInt();
+        const ezUInt64 uiName = decoder.ReadVarUInt();
+        if (decoder.m_bOutOfData)
+          break;
+
+        if (uiName >= strings.GetCount())
+          return InvalidData("Unknown thread name.");
+
+        ThreadInfo& info = m_ThreadInfos.ExpandAndGetRef();
+        info.m_uiThreadId = uiThreadId;
+        info.m_sName = strings[static_cast<ezUInt32>(uiName)];
+
+        m_AllEventBuffers.ExpandAndGetRef().m_uiThreadId = uiThreadId;
+        lastBeginTimes.PushBack(0);
+      }
+      break;
+
+      case StreamFormat::CPUScope:
+      {
+        const ezUInt64 uiThread = decoder.ReadVarUInt();
+        const ezUInt64 uiName = decoder.ReadVarUInt();
+        const ezUInt64 uiFunction = decoder.ReadVarUInt();
+        const ezInt64 iBeginDelta = decoder.ReadVarInt();
+        const ezUInt64 uiDuration = decoder.ReadVarUInt();
+        if (decoder.m_bOutOfData)
+          break;
+
+        if (uiThread >= m_AllEventBuffers.GetCount() || uiName >= strings.GetCount() || uiFunction >= strings.GetCount())
+          return InvalidData("Unknown thread or string.");
+
+        const ezUInt32 uiThreadIndex = static_cast<ezUInt32>(uiThread);
+        const ezInt64 iBeginTime = lastBeginTimes[uiThreadIndex] + iBeginDelta;
+        lastBeginTimes[uiThreadIndex] = iBeginTime;
+
+        CPUScope& scope = m_AllEventBuffers[uiThreadIndex].m_Data.ExpandAndGetRef();
+        scope.m_szFunctionName = uiFunction != 0 ? strings[static_cast<ezUInt32>(uiFunction)] : nullptr;
+        scope.m_BeginTime = ezTime::Nanoseconds(static_cast<double>(iBeginTime));
+        scope.m_EndTime = ezTime::Nanoseconds(static_cast<double>(iBeginTime + static_cast<ezInt64>(uiDuration)));
+        ezStringUtils::Copy(scope.m_szName, CPUScope::NAME_SIZE, strings[static_cast<ezUInt32>(uiName)]);
+      }
+      break;
+
+      case StreamFormat::GPUScope:
+      {
+        const ezUInt64 uiName = decoder.ReadVarUInt();
+        const ezInt64 iBeginDelta = decoder.ReadVarInt();
+        const ezUInt64 uiDuration = decoder.ReadVarUInt();
+        if (decoder.m_bOutOfData)
+          break;
+
+        if (uiName >= strings.GetCount())
+          return InvalidData("Unknown string.");
+
+        const ezInt64 iBeginTime = iLastGPUBeginTime + iBeginDelta;
+        iLastGPUBeginTime = iBeginTime;
+
+        GPUScope& scope = m_GPUScopes.ExpandAndGetRef();
+        scope.m_BeginTime = ezTime::Nanoseconds(static_cast<double>(iBeginTime));
+        scope.m_EndTime = ezTime::Nanoseconds(static_cast<double>(iBeginTime + static_cast<ezInt64>(uiDuration)));
+        ezStringUtils::Copy(scope.m_szName, GPUScope::NAME_SIZE, strings[static_cast<ezUInt32>(uiName)]);
+      }
+      break;
+
+      case StreamFormat::Frame:
+      {
+        const ezInt64 iStartDelta = decoder.ReadVarInt();
+        if (decoder.m_bOutOfData)
+          break;
+
+        iLastFrameStartTime += iStartDelta;
+        m_FrameStartTimes.PushBack(ezTime::Nanoseconds(static_cast<double>(iLastFrameStartTime)));
+      }
+      break;
+
+      default:
+        return InvalidData("Unknown record type.");
+    }
+
+    // a record that was cut off is ignored
+    if (decoder.m_bOutOfData)
+      break;
+  }
+
+  m_uiFrameCount = uiStartFrameCount + m_FrameStartTimes.GetCount();
+
+  return EZ_SUCCESS;
+}
+
 // static
 void ezProfilingSystem::Clear()
 {
@@ -584,7 +1156,14 @@ void ezProfilingSystem::StartNewFrame()
     s_FrameStartTimes.PopFront();
   }
 
-  s_FrameStartTimes.PushBack(ezTime::Now());
+  const ezTime now = ezTime::Now();
+  s_FrameStartTimes.PushBack(now);
+
+  if (s_bStreamingCaptureActive)
+  {
+    EZ_LOCK(s_StreamedDataMutex);
+    s_StreamedFrameStartTimes.PushBack(now);
+  }
 }
 
 // static
@@ -642,6 +1221,100 @@ void ezProfilingSystem::AddCPUScope(const char* szName, const char* szFunctionNa
 
     pOtherThreadBuffer->m_Data.PushBack(scope);
   }
+
+  if (s_bStreamingCaptureActive)
+  {
+    EZ_LOCK(pScopes->m_StreamedScopesMutex);
+
+    if (pScopes->m_StreamedScopes.GetCount() < STREAMING_MAX_PENDING_SCOPES)
+    {
+      pScopes->m_StreamedScopes.PushBack(scope);
+    }
+    else
+    {
+      s_iNumDroppedStreamedScopes.Increment();
+    }
+  }
+}
+
+// static
+ezResult ezProfilingSystem::StartStreamingCapture(const char* szFile)
+{
+  EZ_LOCK(s_StreamWriterMutex);
+
+  if (s_pStreamWriter != nullptr)
+  {
+    ezLog::Error("A streaming profiling capture is already running.");
+    return EZ_FAILURE;
+  }
+
+  ezProfilingStreamWriter* pWriter = EZ_DEFAULT_NEW(ezProfilingStreamWriter);
+  if (pWriter->Open(szFile, s_uiFrameCount).Failed())
+  {
+    EZ_DEFAULT_DELETE(pWriter);
+    return EZ_FAILURE;
+  }
+
+  // discard anything that was left over from a previous capture
+  {
+    EZ_LOCK(s_AllCpuScopesMutex);
+    for (auto pEventBuffer : s_AllCpuScopes)
+    {
+      EZ_LOCK(pEventBuffer->m_StreamedScopesMutex);
+      pEventBuffer->m_StreamedScopes.Clear();
+    }
+  }
+
+  {
+    EZ_LOCK(s_StreamedDataMutex);
+    s_StreamedGPUScopes.Clear();
+    s_StreamedFrameStartTimes.Clear();
+  }
+
+  s_iNumDroppedStreamedScopes = 0;
+  s_pStreamWriter = pWriter;
+  s_bStreamingCaptureActive = true;
+
+  pWriter->Start();
+
+  return EZ_SUCCESS;
+}
+
+// static
+void ezProfilingSystem::StopStreamingCapture()
+{
+  EZ_LOCK(s_StreamWriterMutex);
+
+  if (s_pStreamWriter == nullptr)
+    return;
+
+  s_bStreamingCaptureActive = false;
+
+  s_pStreamWriter->Close();
+
+  s_LastStreamingCaptureStats = s_pStreamWriter->GetStats();
+  s_LastStreamingCaptureStats.m_uiNumDroppedScopes = static_cast<ezUInt64>(static_cast<ezInt64>(s_iNumDroppedStreamedScopes));
+
+  EZ_DEFAULT_DELETE(s_pStreamWriter);
+}
+
+// static
+bool ezProfilingSystem::IsStreamingCaptureActive()
+{
+  return s_bStreamingCaptureActive;
+}
+
+// static
+ezProfilingSystem::StreamingCaptureStats ezProfilingSystem::GetStreamingCaptureStats()
+{
+  EZ_LOCK(s_StreamWriterMutex);
+
+  if (s_pStreamWriter == nullptr)
+    return s_LastStreamingCaptureStats;
+
+  StreamingCaptureStats stats = s_pStreamWriter->GetStats();
+  stats.m_uiNumDroppedScopes = static_cast<ezUInt64>(static_cast<ezInt64>(s_iNumDroppedStreamedScopes));
+  return stats;
 }
 
 // static
@@ -733,6 +1406,12 @@ void ezProfilingSystem::AddGPUScope(const char* szName, ezTime beginTime, ezTime
   ezStringUtils::Copy(scope.m_szName, EZ_ARRAY_SIZE(scope.m_szName), szName);
 
   s_GPUScopes->PushBack(scope);
+
+  if (s_bStreamingCaptureActive)
+  {
+    EZ_LOCK(s_StreamedDataMutex);
+    s_StreamedGPUScopes.PushBack(scope);
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -792,6 +1471,11 @@ ezResult ezProfilingSystem::ProfilingData::Write(ezStreamWriter& outputStream) c
   return EZ_FAILURE;
 }
 
+ezResult ezProfilingSystem::ProfilingData::ReadStreamingCapture(ezStreamReader& inputStream)
+{
+  return EZ_FAILURE;
+}
+
 void ezProfilingSystem::Clear() {}
 
 void ezProfilingSystem::Capture(ezProfilingSystem::ProfilingData& out_Capture, bool bClearAfterCapture) {}
@@ -802,6 +1486,23 @@ void ezProfilingSystem::StartNewFrame() {}
 
 void ezProfilingSystem::AddCPUScope(const char* szName, const char* szFunctionName, ezTime beginTime, ezTime endTime) {}
 
+ezResult ezProfilingSystem::StartStreamingCapture(const char* szFile)
+{
+  return EZ_FAILURE;
+}
+
+void ezProfilingSystem::StopStreamingCapture() {}
+
+bool ezProfilingSystem::IsStreamingCaptureActive()
+{
+  return false;
+}
+
+ezProfilingSystem::StreamingCaptureStats ezProfilingSystem::GetStreamingCaptureStats()
+{
+  return {};
+}
+
 void ezProfilingSystem::Initialize() {}
 
 void ezProfilingSystem::Reset() {}
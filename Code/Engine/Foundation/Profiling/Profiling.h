@@ -1,11 +1,16 @@
 #pragma once
 
 #include <Foundation/Basics.h>
+#include <Foundation/Containers/Deque.h>
 #include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Containers/StaticRingBuffer.h>
+#include <Foundation/Strings/String.h>
 #include <Foundation/System/Process.h>
 #include <Foundation/Time/Time.h>
+#include <Foundation/Types/RefCounted.h>
+#include <Foundation/Types/SharedPtr.h>
 
+class ezStreamReader;
 class ezStreamWriter;
 class ezThread;
 
@@ -109,15 +114,39 @@ public:
 
     ezDynamicArray<GPUScope> m_GPUScopes;
 
+    /// \brief Owns the strings that CPUScope::m_szFunctionName points to, when the data was read by ReadStreamingCapture().
+    struct EZ_FOUNDATION_DLL StringStorage : public ezRefCounted
+    {
+      ezDeque<ezString> m_Strings; ///< A deque never relocates its elements, so pointers into them stay valid.
+    };
+
+    /// \brief The string storages that the scopes point into. Merge() shares the storages of its inputs instead of copying them.
+    ezHybridArray<ezSharedPtr<StringStorage>, 1> m_StringStorages;
+
     /// \brief Writes profiling data as JSON to the output stream.
     ezResult Write(ezStreamWriter& outputStream) const;
 
+    /// \brief Reads a file that was written by a streaming capture, see ezProfilingSystem::StartStreamingCapture().
+    ///
+    /// Afterwards Write() can be used to convert the capture to JSON.
+    ezResult ReadStreamingCapture(ezStreamReader& inputStream);
+
     void Clear();
 
     /// \brief Concatenates all given ProfilingData instances into one merge struct
     static void Merge(ProfilingData& out_Merged, ezArrayPtr<const ProfilingData*> inputs);
   };
 
+  /// \brief Statistics about the current or the last streaming capture.
+  struct StreamingCaptureStats
+  {
+    ezUInt64 m_uiNumCPUScopes = 0;
+    ezUInt64 m_uiNumGPUScopes = 0;
+    ezUInt64 m_uiNumFrames = 0;
+    ezUInt64 m_uiNumDroppedScopes = 0; ///< Scopes that were lost, because the writer thread could not keep up.
+    ezUInt64 m_uiBytesWritten = 0;
+  };
+
 public:
   static void Clear();
 
@@ -132,6 +161,21 @@ public:
   /// \brief Adds a new scoped event for the calling thread in the profiling system
   static void AddCPUScope(const char* szName, const char* szFunctionName, ezTime beginTime, ezTime endTime);
 
+  /// \brief Starts writing all CPU and GPU scopes and frame boundaries continuously to the given file.
+  ///
+  /// In contrast to Capture(), which only returns what still fits into the ring buffers, a streaming capture covers everything from the
+  /// start until StopStreamingCapture() is called, which makes it suitable for long running sessions. A background thread writes the data
+  /// in a compact binary format, in which scope names are stored only once and timestamps are delta encoded.
+  /// Use ProfilingData::ReadStreamingCapture() and ProfilingData::Write() to convert the file to JSON.
+  static ezResult StartStreamingCapture(const char* szFile);
+
+  /// \brief Writes all remaining data and closes the file of the streaming capture.
+  static void StopStreamingCapture();
+
+  static bool IsStreamingCaptureActive();
+
+  static StreamingCaptureStats GetStreamingCaptureStats();
+
 private:
   EZ_MAKE_SUBSYSTEM_STARTUP_FRIEND(Foundation, ProfilingSystem);
   friend ezUInt32 RunThread(ezThread* pThread);
@@ -3,6 +3,8 @@
 /// \file
 
 #include <Foundation/Basics.h>
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/HashTable.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Containers/Set.h>
 #include <Foundation/Reflection/Reflection.h>
@@ -18,6 +20,7 @@ class EZ_FOUNDATION_DLL ezAbstractObjectNode
 public:
   struct Property
   {
+    /// Interned by the owning graph, see ezAbstractObjectGraph::RegisterString().
     const char* m_szPropertyName;
     ezVariant m_Value;
   };
@@ -33,6 +36,7 @@ public:
   const ezHybridArray<Property, 16>& GetProperties() const { return m_Properties; }
 
   void AddProperty(const char* szName, const ezVariant& value);
+  void AddProperty(const char* szName, ezVariant&& value);
 
   void RemoveProperty(const char* szName);
 
@@ -134,8 +138,15 @@ public:
   ezAbstractObjectNode* AddNode(const ezUuid& guid, const char* szType, ezUInt32 uiTypeVersion, const char* szNodeName = nullptr);
   void RemoveNode(const ezUuid& guid);
 
-  const ezMap<ezUuid, ezAbstractObjectNode*>& GetAllNodes() const { return m_Nodes; }
-  ezMap<ezUuid, ezAbstractObjectNode*>& GetAllNodes() { return m_Nodes; }
+  /// \brief Returns all nodes by their guid. The order of iteration is arbitrary, use GetNodesSortedByGuid() where it has to be deterministic.
+  ///
+  /// Nodes must not be added or removed while iterating over the table. Use GetNodesSortedByGuid() to iterate over a copy instead.
+  const ezHashTable<ezUuid, ezAbstractObjectNode*>& GetAllNodes() const { return m_Nodes; }
+  ezHashTable<ezUuid, ezAbstractObjectNode*>& GetAllNodes() { return m_Nodes; }
+
+  /// \brief Returns all nodes sorted by their guid, e.g. to write them in the same order every time.
+  void GetNodesSortedByGuid(ezDynamicArray<const ezAbstractObjectNode*>& out_Nodes) const;
+  void GetNodesSortedByGuid(ezDynamicArray<ezAbstractObjectNode*>& out_Nodes);
 
   /// \brief Remaps all node guids by adding the given seed, or if bRemapInverse is true, by subtracting it/
   ///   This is mostly used to remap prefab instance graphs to their prefab template graph.
@@ -169,7 +180,17 @@ private:
   void MergeArrays(const ezVariantArray& baseArray, const ezVariantArray& leftArray, const ezVariantArray& rightArray, ezVariantArray& out) const;
   void ReMapNodeGuidsToMatchGraphRecursive(ezHashTable<ezUuid, ezUuid>& guidMap, ezAbstractObjectNode* lhs, const ezAbstractObjectGraph& rhsGraph, const ezAbstractObjectNode* rhs);
 
-  ezSet<ezString> m_Strings;
-  ezMap<ezUuid, ezAbstractObjectNode*> m_Nodes;
-  ezMap<const char*, ezAbstractObjectNode*, CompareConstChar> m_NodesByName;
+  const char* FindString(const char* szString) const;
+
+  /// All strings are interned, so nodes can store and compare them as pointers.
+  /// The characters are stored in blocks that are never reallocated, so the pointers stay valid until Clear() is called.
+  ezHashTable<const char*, const char*> m_Strings;
+  ezDynamicArray<ezDynamicArray<char>> m_StringBlocks;
+
+  /// Nodes are allocated in chunks and removed nodes are reused, instead of allocating every node individually.
+  ezDeque<ezAbstractObjectNode> m_NodeStorage;
+  ezDynamicArray<ezAbstractObjectNode*> m_FreeNodes;
+
+  ezHashTable<ezUuid, ezAbstractObjectNode*> m_Nodes;
+  ezHashTable<const char*, ezAbstractObjectNode*> m_NodesByName;
 };
@@ -6,6 +6,13 @@
 #include <Foundation/IO/Stream.h>
 #include <Foundation/Serialization/AbstractObjectGraph.h>
 
+class ezAbstractGraphBinaryView;
+
+/// \brief Writes and reads an ezAbstractObjectGraph in a compact binary format.
+///
+/// All strings of a graph (types, node names, property names and string values) are stored once in a string table and are referenced by
+/// index. Nodes and properties are stored as fixed-size records, only non-string property values follow as variants.
+/// Use ezAbstractGraphBinaryView to access the data without creating an ezAbstractObjectGraph.
 class EZ_FOUNDATION_DLL ezAbstractGraphBinarySerializer
 {
 public:
@@ -13,4 +20,114 @@ public:
   static void Read(ezStreamReader& stream, ezAbstractObjectGraph* pGraph, ezAbstractObjectGraph* pTypesGraph = nullptr, bool bApplyPatches = false); // [tested]
 
 private:
+  /// \brief Moves the values out of the view, which is read again or discarded afterwards.
+  static void CreateGraph(ezAbstractGraphBinaryView& view, ezAbstractObjectGraph* pGraph);
+};
+
+/// \brief Read-only access to a graph that was written by ezAbstractGraphBinarySerializer.
+///
+/// The string table and the node and property records are read in bulk, no node, property or string is allocated individually.
+/// Lookups of strings, nodes and properties go through hash tables that are built once when the data is read through Read().
+/// This is useful to look up a few values in a file, e.g. the meta data of an asset, without building the full ezAbstractObjectGraph.
+/// Only data written with the current format version can be viewed, older data has to be read through ezAbstractGraphBinarySerializer.
+class EZ_FOUNDATION_DLL ezAbstractGraphBinaryView
+{
+  // the string index references the string data of the view
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezAbstractGraphBinaryView);
+
+public:
+  ezAbstractGraphBinaryView() = default;
+
+  struct Node
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUuid m_Guid;
+    ezUInt32 m_uiType = 0;
+    ezUInt32 m_uiTypeVersion = 0;
+    ezUInt32 m_uiNodeName = 0;
+    ezUInt32 m_uiNumProperties = 0;
+  };
+
+  struct Property
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiName = 0;
+
+    /// \brief Index of the value in the string table or ezInvalidIndex if the value is not a string.
+    ezUInt32 m_uiStringValue = ezInvalidIndex;
+  };
+
+  /// \brief Reads the data written by ezAbstractGraphBinarySerializer::Write.
+  ///
+  /// Fails if the data was written with an older format version, is truncated or references strings or properties that do not exist.
+  ezResult Read(ezStreamReader& stream, ezAbstractGraphBinaryView* pTypesGraph = nullptr); // [tested]
+
+  void Clear();
+
+  ezUInt32 GetStringCount() const { return m_StringOffsets.GetCount(); }
+  ezStringView GetString(ezUInt32 uiIndex) const;
+
+  /// \brief Returns the index of the string in the string table or ezInvalidIndex if the graph does not contain it.
+  ezUInt32 FindString(ezStringView sString) const;
+
+  ezArrayPtr<const Node> GetNodes() const { return m_Nodes; }
+
+  const Node* GetNodeByGuid(const ezUuid& guid) const;
+  const Node* GetNodeByName(ezStringView sName) const; // [tested]
+
+  /// \brief Returns the properties of the given node, which has to be one of the nodes returned by GetNodes().
+  ezArrayPtr<const Property> GetProperties(const Node& node) const;
+
+  /// \brief Returns the index of the property of the given node or ezInvalidIndex if the node does not have it.
+  ezUInt32 FindProperty(const Node& node, ezStringView sName) const; // [tested]
+
+  /// \brief Returns the index of the given property, which has to be one of the properties returned by GetProperties().
+  ezUInt32 GetPropertyIndex(const Property& property) const { return static_cast<ezUInt32>(&property - m_Properties.GetData()); }
+
+  const Property& GetProperty(ezUInt32 uiIndex) const { return m_Properties[uiIndex]; }
+
+  /// \brief Returns the value of the property, string values are returned as ezString.
+  ezVariant GetPropertyValue(ezUInt32 uiIndex) const; // [tested]
+
+  /// \brief Returns the value of a property that has no string value without copying it, e.g. an ezVariantArray.
+  const ezVariant& GetNonStringPropertyValue(ezUInt32 uiIndex) const
+  {
+    EZ_ASSERT_DEBUG(m_Properties[uiIndex].m_uiStringValue == ezInvalidIndex, "Property has a string value");
+    return m_Values[uiIndex];
+  }
+
+  /// \brief Adds all nodes of the view to the graph, e.g. to pass them to an ezRttiConverterReader.
+  void CreateGraph(ezAbstractObjectGraph* pGraph) const; // [tested]
+
+private:
+  friend class ezAbstractGraphBinarySerializer;
+
+  /// \brief Reads and validates the data, the lookup tables are only built by BuildIndices().
+  ezResult ReadGraph(ezStreamReader& stream);
+  ezResult Validate();
+  void BuildIndices();
+
+  struct StringViewHashHelper
+  {
+    EZ_ALWAYS_INLINE static ezUInt32 Hash(ezStringView sValue) { return ezHashingUtils::xxHash32String(sValue); }
+    EZ_ALWAYS_INLINE static bool Equal(ezStringView a, ezStringView b) { return a == b; }
+  };
+
+  ezDynamicArray<char> m_StringData;
+  ezDynamicArray<ezUInt32> m_StringOffsets;
+  ezDynamicArray<Node> m_Nodes;
+  ezDynamicArray<ezUInt32> m_FirstProperty;
+  ezDynamicArray<Property> m_Properties;
+
+  /// The values of all non-string properties, indexed like m_Properties.
+  ezDynamicArray<ezVariant> m_Values;
+
+  ezHashTable<ezStringView, ezUInt32, StringViewHashHelper> m_StringToIndex;
+  ezHashTable<ezUuid, ezUInt32> m_GuidToNode;
+  ezHashTable<ezUInt32, ezUInt32> m_NameToNode;
+
+  /// Maps the node index in the upper and the property name in the lower 32 bits to the property index.
+  ezHashTable<ezUInt64, ezUInt32> m_NodePropertyToIndex;
 };
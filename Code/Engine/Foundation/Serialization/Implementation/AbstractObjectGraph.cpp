@@ -28,6 +28,24 @@ EZ_BEGIN_STATIC_REFLECTED_TYPE(ezDiffOperation, ezNoBase, 1, ezRTTIDefaultAlloca
 EZ_END_STATIC_REFLECTED_TYPE;
 // clang-format on
 
+namespace
+{
+  constexpr ezUInt32 StringBlockSize = 16 * 1024;
+
+  /// Hashes interned strings by their full address, strings of one graph are packed closely into the same blocks.
+  struct ezInternedStringHashHelper
+  {
+    EZ_ALWAYS_INLINE static ezUInt32 Hash(const char* szValue) { return ezHashHelper<ezUInt64>::Hash(static_cast<ezUInt64>(reinterpret_cast<size_t>(szValue))); }
+    EZ_ALWAYS_INLINE static bool Equal(const char* a, const char* b) { return a == b; }
+  };
+
+  EZ_ALWAYS_INLINE bool IsPropertyName(const char* szPropertyName, const char* szName)
+  {
+    // property names are interned, so names that come from the same graph are equal by pointer
+    return szPropertyName == szName || ezStringUtils::IsEqual(szPropertyName, szName);
+  }
+} // namespace
+
 ezAbstractObjectGraph::~ezAbstractObjectGraph()
 {
   Clear();
@@ -35,19 +53,20 @@ ezAbstractObjectGraph::~ezAbstractObjectGraph()
 
 void ezAbstractObjectGraph::Clear()
 {
-  for (auto it = m_Nodes.GetIterator(); it.IsValid(); ++it)
-  {
-    EZ_DEFAULT_DELETE(it.Value());
-  }
   m_Nodes.Clear();
   m_NodesByName.Clear();
+  m_FreeNodes.Clear();
+  m_NodeStorage.Clear();
   m_Strings.Clear();
+  m_StringBlocks.Clear();
 }
 
 
 void ezAbstractObjectGraph::Clone(ezAbstractObjectGraph& cloneTarget) const
 {
   cloneTarget.Clear();
+  cloneTarget.m_Strings.Reserve(m_Strings.GetCount());
+  cloneTarget.m_Nodes.Reserve(m_Nodes.GetCount());
 
   for (auto it = m_Nodes.GetIterator(); it.IsValid(); ++it)
   {
@@ -57,14 +76,40 @@ void ezAbstractObjectGraph::Clone(ezAbstractObjectGraph& cloneTarget) const
 
 const char* ezAbstractObjectGraph::RegisterString(const char* szString)
 {
-  auto it = m_Strings.Insert(szString);
-  EZ_ASSERT_DEV(it.IsValid(), "");
-  return it.Key().GetData();
+  if (szString == nullptr)
+    szString = "";
+
+  if (const char* szRegistered = FindString(szString))
+    return szRegistered;
+
+  const ezUInt32 uiElementCount = ezStringUtils::GetStringElementCount(szString) + 1;
+
+  if (m_StringBlocks.IsEmpty() || m_StringBlocks.PeekBack().GetCount() + uiElementCount > m_StringBlocks.PeekBack().GetCapacity())
+  {
+    m_StringBlocks.ExpandAndGetRef().Reserve(ezMath::Max(uiElementCount, StringBlockSize));
+  }
+
+  ezDynamicArray<char>& block = m_StringBlocks.PeekBack();
+  const ezUInt32 uiOffset = block.GetCount();
+  block.PushBackRange(ezMakeArrayPtr(szString, uiElementCount));
+
+  const char* szRegistered = block.GetData() + uiOffset;
+  m_Strings.Insert(szRegistered, szRegistered);
+  return szRegistered;
+}
+
+const char* ezAbstractObjectGraph::FindString(const char* szString) const
+{
+  const char* szRegistered = nullptr;
+  m_Strings.TryGetValue(szString, szRegistered);
+  return szRegistered;
 }
 
 ezAbstractObjectNode* ezAbstractObjectGraph::GetNode(const ezUuid& guid)
 {
-  return m_Nodes.GetValueOrDefault(guid, nullptr);
+  ezAbstractObjectNode* pNode = nullptr;
+  m_Nodes.TryGetValue(guid, pNode);
+  return pNode;
 }
 
 const ezAbstractObjectNode* ezAbstractObjectGraph::GetNode(const ezUuid& guid) const
@@ -79,7 +124,9 @@ const ezAbstractObjectNode* ezAbstractObjectGraph::GetNodeByName(const char* szN
 
 ezAbstractObjectNode* ezAbstractObjectGraph::GetNodeByName(const char* szName)
 {
-  return m_NodesByName.GetValueOrDefault(szName, nullptr);
+  ezAbstractObjectNode* pNode = nullptr;
+  m_NodesByName.TryGetValue(szName, pNode);
+  return pNode;
 }
 
 ezAbstractObjectNode* ezAbstractObjectGraph::AddNode(const ezUuid& guid, const char* szType, ezUInt32 uiTypeVersion, const char* szNodeName)
@@ -94,14 +141,24 @@ ezAbstractObjectNode* ezAbstractObjectGraph::AddNode(const ezUuid& guid, const c
     szNodeName = nullptr;
   }
 
-  ezAbstractObjectNode* pNode = EZ_DEFAULT_NEW(ezAbstractObjectNode);
+  ezAbstractObjectNode* pNode = nullptr;
+  if (!m_FreeNodes.IsEmpty())
+  {
+    pNode = m_FreeNodes.PeekBack();
+    m_FreeNodes.PopBack();
+  }
+  else
+  {
+    pNode = &m_NodeStorage.ExpandAndGetRef();
+  }
+
   pNode->m_Guid = guid;
   pNode->m_pOwner = this;
   pNode->m_szType = RegisterString(szType);
   pNode->m_uiTypeVersion = uiTypeVersion;
   pNode->m_szNodeName = szNodeName;
 
-  m_Nodes[guid] = pNode;
+  m_Nodes.Insert(guid, pNode);
 
   if (!ezStringUtils::IsNullOrEmpty(szNodeName))
   {
@@ -113,19 +170,45 @@ ezAbstractObjectNode* ezAbstractObjectGraph::AddNode(const ezUuid& guid, const c
 
 void ezAbstractObjectGraph::RemoveNode(const ezUuid& guid)
 {
-  auto it = m_Nodes.Find(guid);
+  ezAbstractObjectNode* pNode = nullptr;
 
-  if (it.IsValid())
+  if (m_Nodes.Remove(guid, &pNode))
   {
-    ezAbstractObjectNode* pNode = it.Value();
     if (pNode->m_szNodeName != nullptr)
       m_NodesByName.Remove(pNode->m_szNodeName);
 
-    m_Nodes.Remove(guid);
-    EZ_DEFAULT_DELETE(pNode);
+    // the node is reused by the next call to AddNode
+    pNode->m_Properties.Clear();
+    m_FreeNodes.PushBack(pNode);
   }
 }
 
+void ezAbstractObjectGraph::GetNodesSortedByGuid(ezDynamicArray<const ezAbstractObjectNode*>& out_Nodes) const
+{
+  out_Nodes.Clear();
+  out_Nodes.Reserve(m_Nodes.GetCount());
+
+  for (auto it = m_Nodes.GetIterator(); it.IsValid(); ++it)
+  {
+    out_Nodes.PushBack(it.Value());
+  }
+
+  out_Nodes.Sort([](const ezAbstractObjectNode* a, const ezAbstractObjectNode* b) -> bool { return a->GetGuid() < b->GetGuid(); });
+}
+
+void ezAbstractObjectGraph::GetNodesSortedByGuid(ezDynamicArray<ezAbstractObjectNode*>& out_Nodes)
+{
+  out_Nodes.Clear();
+  out_Nodes.Reserve(m_Nodes.GetCount());
+
+  for (auto it = m_Nodes.GetIterator(); it.IsValid(); ++it)
+  {
+    out_Nodes.PushBack(it.Value());
+  }
+
+  out_Nodes.Sort([](const ezAbstractObjectNode* a, const ezAbstractObjectNode* b) -> bool { return a->GetGuid() < b->GetGuid(); });
+}
+
 void ezAbstractObjectNode::AddProperty(const char* szName, const ezVariant& value)
 {
   auto& prop = m_Properties.ExpandAndGetRef();
@@ -133,11 +216,18 @@ void ezAbstractObjectNode::AddProperty(const char* szName, const ezVariant& valu
   prop.m_Value = value;
 }
 
+void ezAbstractObjectNode::AddProperty(const char* szName, ezVariant&& value)
+{
+  auto& prop = m_Properties.ExpandAndGetRef();
+  prop.m_szPropertyName = m_pOwner->RegisterString(szName);
+  prop.m_Value = std::move(value);
+}
+
 void ezAbstractObjectNode::ChangeProperty(const char* szName, const ezVariant& value)
 {
   for (ezUInt32 i = 0; i < m_Properties.GetCount(); ++i)
   {
-    if (ezStringUtils::IsEqual(m_Properties[i].m_szPropertyName, szName))
+    if (IsPropertyName(m_Properties[i].m_szPropertyName, szName))
     {
       m_Properties[i].m_Value = value;
       return;
@@ -151,7 +241,7 @@ void ezAbstractObjectNode::RenameProperty(const char* szOldName, const char* szN
 {
   for (ezUInt32 i = 0; i < m_Properties.GetCount(); ++i)
   {
-    if (ezStringUtils::IsEqual(m_Properties[i].m_szPropertyName, szOldName))
+    if (IsPropertyName(m_Properties[i].m_szPropertyName, szOldName))
     {
       m_Properties[i].m_szPropertyName = m_pOwner->RegisterString(szNewName);
       return;
@@ -164,7 +254,7 @@ ezResult ezAbstractObjectNode::InlineProperty(const char* szName)
   for (ezUInt32 i = 0; i < m_Properties.GetCount(); ++i)
   {
     Property& prop = m_Properties[i];
-    if (ezStringUtils::IsEqual(prop.m_szPropertyName, szName))
+    if (IsPropertyName(prop.m_szPropertyName, szName))
     {
       if (!prop.m_Value.IsA<ezUuid>())
         return EZ_FAILURE;
@@ -207,7 +297,7 @@ void ezAbstractObjectNode::RemoveProperty(const char* szName)
 {
   for (ezUInt32 i = 0; i < m_Properties.GetCount(); ++i)
   {
-    if (ezStringUtils::IsEqual(m_Properties[i].m_szPropertyName, szName))
+    if (IsPropertyName(m_Properties[i].m_szPropertyName, szName))
     {
       m_Properties.RemoveAtAndSwap(i);
       return;
@@ -224,7 +314,7 @@ const ezAbstractObjectNode::Property* ezAbstractObjectNode::FindProperty(const c
 {
   for (ezUInt32 i = 0; i < m_Properties.GetCount(); ++i)
   {
-    if (ezStringUtils::IsEqual(m_Properties[i].m_szPropertyName, szName))
+    if (IsPropertyName(m_Properties[i].m_szPropertyName, szName))
     {
       return &m_Properties[i];
     }
@@ -237,7 +327,7 @@ ezAbstractObjectNode::Property* ezAbstractObjectNode::FindProperty(const char* s
 {
   for (ezUInt32 i = 0; i < m_Properties.GetCount(); ++i)
   {
-    if (ezStringUtils::IsEqual(m_Properties[i].m_szPropertyName, szName))
+    if (IsPropertyName(m_Properties[i].m_szPropertyName, szName))
     {
       return &m_Properties[i];
     }
@@ -279,7 +369,7 @@ void ezAbstractObjectGraph::ReMapNodeGuids(const ezUuid& seedGuid, bool bRemapIn
     {
       RemapVariant(prop.m_Value, guidMap);
     }
-    m_Nodes[pNode->m_Guid] = pNode;
+    m_Nodes.Insert(pNode->m_Guid, pNode);
   }
 }
 
@@ -299,7 +389,6 @@ void ezAbstractObjectGraph::ReMapNodeGuidsToMatchGraph(ezAbstractObjectNode* roo
     {
       RemapVariant(prop.m_Value, guidMap);
     }
-    m_Nodes[it.Value()->m_Guid] = it.Value();
   }
 }
 
@@ -517,6 +606,7 @@ void ezAbstractObjectGraph::CreateDiffWithBaseGraph(const ezAbstractObjectGraph&
         op.m_Node = itNodeThis.Key();
         op.m_Operation = ezAbstractGraphDiffOperation::Op::NodeAdded;
         op.m_sProperty = itNodeThis.Value()->m_szType;
+        op.m_uiTypeVersion = itNodeThis.Value()->m_uiTypeVersion;
         op.m_Value = itNodeThis.Value()->m_szNodeName;
 
         out_DiffResult.PushBack(op);
@@ -536,6 +626,10 @@ void ezAbstractObjectGraph::CreateDiffWithBaseGraph(const ezAbstractObjectGraph&
 
   // check whether any properties have been modified
   {
+    // the property names of both graphs are interned, so each name only has to be looked up once in the base graph and can then be
+    // compared by pointer
+    ezHashTable<const char*, const char*, ezInternedStringHashHelper> baseNames;
+
     for (auto itNodeThis = GetAllNodes().GetIterator(); itNodeThis.IsValid(); ++itNodeThis)
     {
       const auto pBaseNode = base.GetNode(itNodeThis.Key());
@@ -545,19 +639,20 @@ void ezAbstractObjectGraph::CreateDiffWithBaseGraph(const ezAbstractObjectGraph&
 
       for (const ezAbstractObjectNode::Property& prop : itNodeThis.Value()->GetProperties())
       {
+        const char* szBaseName = nullptr;
+        if (!baseNames.TryGetValue(prop.m_szPropertyName, szBaseName))
+        {
+          szBaseName = base.FindString(prop.m_szPropertyName);
+          baseNames.Insert(prop.m_szPropertyName, szBaseName);
+        }
+
         bool bDifferent = true;
 
         for (const ezAbstractObjectNode::Property& baseProp : pBaseNode->GetProperties())
         {
-          if (ezStringUtils::IsEqual(baseProp.m_szPropertyName, prop.m_szPropertyName))
+          if (baseProp.m_szPropertyName == szBaseName)
           {
-            if (baseProp.m_Value == prop.m_Value)
-            {
-              bDifferent = false;
-              break;
-            }
-
-            bDifferent = true;
+            bDifferent = !(baseProp.m_Value == prop.m_Value);
             break;
           }
         }
@@ -7,35 +7,136 @@ enum ezBinarySerializerVersion : ezUInt32
 {
   InvalidVersion = 0,
   Version1,
+  Version2, ///< String table and fixed-size node and property records
   // << insert new versions here >>
 
   ENUM_COUNT,
   CurrentVersion = ENUM_COUNT - 1 // automatically the highest version number
 };
 
+namespace
+{
+  static_assert(sizeof(ezAbstractGraphBinaryView::Node) == 32, "Node records are written as raw bytes and must not contain padding");
+  static_assert(sizeof(ezAbstractGraphBinaryView::Property) == 8, "Property records are written as raw bytes and must not contain padding");
+
+  template <typename T>
+  void WriteRecords(ezStreamWriter& stream, const ezDynamicArray<T>& records)
+  {
+    const ezUInt32 uiCount = records.GetCount();
+    stream << uiCount;
+
+    if (uiCount > 0)
+    {
+      stream.WriteBytes(records.GetData(), sizeof(T) * uiCount).IgnoreResult();
+    }
+  }
+
+  template <typename T>
+  ezResult ReadRecords(ezStreamReader& stream, ezDynamicArray<T>& records)
+  {
+    ezUInt32 uiCount = 0;
+    EZ_SUCCEED_OR_RETURN(stream.ReadDWordValue(&uiCount));
+
+    // The count is not trusted, the array is grown in chunks so that truncated data fails before a large allocation is made.
+    constexpr ezUInt32 uiChunkSize = 16 * 1024;
+
+    records.Clear();
+    while (records.GetCount() < uiCount)
+    {
+      const ezUInt32 uiStart = records.GetCount();
+      const ezUInt32 uiNumRecords = ezMath::Min(uiCount - uiStart, uiChunkSize);
+      records.SetCountUninitialized(uiStart + uiNumRecords);
+
+      const ezUInt64 uiSize = sizeof(T) * uiNumRecords;
+      if (stream.ReadBytes(records.GetData() + uiStart, uiSize) != uiSize)
+        return EZ_FAILURE;
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  class ezStringTableWriter
+  {
+  public:
+    /// \brief The string has to stay valid until the table is written.
+    ezUInt32 AddString(const char* szString)
+    {
+      if (szString == nullptr)
+        szString = "";
+
+      ezUInt32 uiIndex = ezInvalidIndex;
+      if (!m_StringToIndex.TryGetValue(szString, uiIndex))
+      {
+        uiIndex = m_Offsets.GetCount();
+        m_Offsets.PushBack(m_Data.GetCount());
+        m_Data.PushBackRange(ezArrayPtr<const char>(szString, ezStringUtils::GetStringElementCount(szString) + 1));
+        m_StringToIndex.Insert(szString, uiIndex);
+      }
+
+      return uiIndex;
+    }
+
+    void Write(ezStreamWriter& stream) const
+    {
+      WriteRecords(stream, m_Data);
+      WriteRecords(stream, m_Offsets);
+    }
+
+  private:
+    ezHashTable<const char*, ezUInt32> m_StringToIndex;
+    ezDynamicArray<char> m_Data;
+    ezDynamicArray<ezUInt32> m_Offsets;
+  };
+} // namespace
+
 static void WriteGraph(const ezAbstractObjectGraph* pGraph, ezStreamWriter& stream)
 {
-  const auto& Nodes = pGraph->GetAllNodes();
+  ezDynamicArray<const ezAbstractObjectNode*> Nodes;
+  pGraph->GetNodesSortedByGuid(Nodes);
+
+  ezStringTableWriter strings;
+  ezDynamicArray<ezAbstractGraphBinaryView::Node> nodes;
+  ezDynamicArray<ezAbstractGraphBinaryView::Property> properties;
+  ezDynamicArray<const ezVariant*> values;
 
-  ezUInt32 uiNodes = Nodes.GetCount();
-  stream << uiNodes;
-  for (auto itNode = Nodes.GetIterator(); itNode.IsValid(); ++itNode)
+  nodes.Reserve(Nodes.GetCount());
+
+  for (const ezAbstractObjectNode* pNode : Nodes)
   {
-    const auto& node = *itNode.Value();
-    stream << node.GetGuid();
-    stream << node.GetType();
-    stream << node.GetTypeVersion();
-    stream << node.GetNodeName();
+    const auto& node = *pNode;
+
+    auto& nodeRecord = nodes.ExpandAndGetRef();
+    nodeRecord.m_Guid = node.GetGuid();
+    nodeRecord.m_uiType = strings.AddString(node.GetType());
+    nodeRecord.m_uiTypeVersion = node.GetTypeVersion();
+    nodeRecord.m_uiNodeName = strings.AddString(node.GetNodeName());
+    nodeRecord.m_uiNumProperties = node.GetProperties().GetCount();
 
-    const ezHybridArray<ezAbstractObjectNode::Property, 16>& properties = node.GetProperties();
-    ezUInt32 uiProps = properties.GetCount();
-    stream << uiProps;
-    for (const ezAbstractObjectNode::Property& prop : properties)
+    for (const ezAbstractObjectNode::Property& prop : node.GetProperties())
     {
-      stream << prop.m_szPropertyName;
-      stream << prop.m_Value;
+      auto& propertyRecord = properties.ExpandAndGetRef();
+      propertyRecord.m_uiName = strings.AddString(prop.m_szPropertyName);
+
+      if (prop.m_Value.IsA<ezString>())
+      {
+        propertyRecord.m_uiStringValue = strings.AddString(prop.m_Value.Get<ezString>().GetData());
+      }
+      else
+      {
+        propertyRecord.m_uiStringValue = ezInvalidIndex;
+        values.PushBack(&prop.m_Value);
+      }
     }
   }
+
+  strings.Write(stream);
+  WriteRecords(stream, nodes);
+  WriteRecords(stream, properties);
+
+  for (const ezVariant* pValue : values)
+  {
+    stream << *pValue;
+  }
 }
 
 void ezAbstractGraphBinarySerializer::Write(ezStreamWriter& stream, const ezAbstractObjectGraph* pGraph, const ezAbstractObjectGraph* pTypesGraph)
@@ -50,7 +151,7 @@ void ezAbstractGraphBinarySerializer::Write(ezStreamWriter& stream, const ezAbst
   }
 }
 
-static void ReadGraph(ezStreamReader& stream, ezAbstractObjectGraph* pGraph)
+static void ReadGraphVersion1(ezStreamReader& stream, ezAbstractObjectGraph* pGraph)
 {
   ezUInt32 uiNodes = 0;
   stream >> uiNodes;
@@ -83,17 +184,40 @@ void ezAbstractGraphBinarySerializer::Read(
 {
   ezUInt32 uiVersion = 0;
   stream >> uiVersion;
-  if (uiVersion != ezBinarySerializerVersion::CurrentVersion)
+  if (uiVersion == ezBinarySerializerVersion::Version1)
+  {
+    ReadGraphVersion1(stream, pGraph);
+    if (pTypesGraph)
+    {
+      ReadGraphVersion1(stream, pTypesGraph);
+    }
+  }
+  else if (uiVersion == ezBinarySerializerVersion::Version2)
+  {
+    ezAbstractGraphBinaryView view;
+    if (view.ReadGraph(stream).Failed())
+    {
+      EZ_REPORT_FAILURE("Binary serializer data is invalid or truncated, re-export file.");
+      return;
+    }
+    CreateGraph(view, pGraph);
+
+    if (pTypesGraph)
+    {
+      if (view.ReadGraph(stream).Failed())
+      {
+        EZ_REPORT_FAILURE("Binary serializer data is invalid or truncated, re-export file.");
+        return;
+      }
+      CreateGraph(view, pTypesGraph);
+    }
+  }
+  else
   {
     EZ_REPORT_FAILURE(
       "Binary serializer version {0} does not match expected version {1}, re-export file.", uiVersion, ezBinarySerializerVersion::CurrentVersion);
     return;
   }
-  ReadGraph(stream, pGraph);
-  if (pTypesGraph)
-  {
-    ReadGraph(stream, pTypesGraph);
-  }
 
   if (bApplyPatches)
   {
@@ -103,4 +227,245 @@ void ezAbstractGraphBinarySerializer::Read(
   }
 }
 
+void ezAbstractGraphBinarySerializer::CreateGraph(ezAbstractGraphBinaryView& view, ezAbstractObjectGraph* pGraph)
+{
+  // all strings in the table are zero-terminated
+  for (const ezAbstractGraphBinaryView::Node& node : view.GetNodes())
+  {
+    ezAbstractObjectNode* pNode = pGraph->AddNode(
+      node.m_Guid, view.GetString(node.m_uiType).GetStartPointer(), node.m_uiTypeVersion, view.GetString(node.m_uiNodeName).GetStartPointer());
+
+    for (const ezAbstractGraphBinaryView::Property& prop : view.GetProperties(node))
+    {
+      const char* szName = view.GetString(prop.m_uiName).GetStartPointer();
+
+      if (prop.m_uiStringValue != ezInvalidIndex)
+        pNode->AddProperty(szName, ezVariant(view.GetString(prop.m_uiStringValue).GetStartPointer()));
+      else
+        pNode->AddProperty(szName, std::move(view.m_Values[view.GetPropertyIndex(prop)]));
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezResult ezAbstractGraphBinaryView::Read(ezStreamReader& stream, ezAbstractGraphBinaryView* pTypesGraph)
+{
+  Clear();
+
+  ezUInt32 uiVersion = 0;
+  stream >> uiVersion;
+  if (uiVersion != ezBinarySerializerVersion::CurrentVersion)
+    return EZ_FAILURE;
+
+  EZ_SUCCEED_OR_RETURN(ReadGraph(stream));
+  BuildIndices();
+
+  if (pTypesGraph)
+  {
+    EZ_SUCCEED_OR_RETURN(pTypesGraph->ReadGraph(stream));
+    pTypesGraph->BuildIndices();
+  }
+
+  return EZ_SUCCESS;
+}
+
+void ezAbstractGraphBinaryView::Clear()
+{
+  m_StringData.Clear();
+  m_StringOffsets.Clear();
+  m_Nodes.Clear();
+  m_FirstProperty.Clear();
+  m_Properties.Clear();
+  m_Values.Clear();
+  m_StringToIndex.Clear();
+  m_GuidToNode.Clear();
+  m_NameToNode.Clear();
+  m_NodePropertyToIndex.Clear();
+}
+
+ezStringView ezAbstractGraphBinaryView::GetString(ezUInt32 uiIndex) const
+{
+  const ezUInt32 uiStart = m_StringOffsets[uiIndex];
+  const ezUInt32 uiEnd = (uiIndex + 1 < m_StringOffsets.GetCount() ? m_StringOffsets[uiIndex + 1] : m_StringData.GetCount()) - 1;
+
+  return ezStringView(m_StringData.GetData() + uiStart, m_StringData.GetData() + uiEnd);
+}
+
+ezUInt32 ezAbstractGraphBinaryView::FindString(ezStringView sString) const
+{
+  ezUInt32 uiIndex = ezInvalidIndex;
+  m_StringToIndex.TryGetValue(sString, uiIndex);
+  return uiIndex;
+}
+
+const ezAbstractGraphBinaryView::Node* ezAbstractGraphBinaryView::GetNodeByGuid(const ezUuid& guid) const
+{
+  ezUInt32 uiNodeIndex = 0;
+  if (!m_GuidToNode.TryGetValue(guid, uiNodeIndex))
+    return nullptr;
+
+  return &m_Nodes[uiNodeIndex];
+}
+
+const ezAbstractGraphBinaryView::Node* ezAbstractGraphBinaryView::GetNodeByName(ezStringView sName) const
+{
+  const ezUInt32 uiName = FindString(sName);
+  if (uiName == ezInvalidIndex)
+    return nullptr;
+
+  ezUInt32 uiNodeIndex = 0;
+  if (!m_NameToNode.TryGetValue(uiName, uiNodeIndex))
+    return nullptr;
+
+  return &m_Nodes[uiNodeIndex];
+}
+
+ezArrayPtr<const ezAbstractGraphBinaryView::Property> ezAbstractGraphBinaryView::GetProperties(const Node& node) const
+{
+  const ezUInt32 uiNodeIndex = static_cast<ezUInt32>(&node - m_Nodes.GetData());
+  return m_Properties.GetArrayPtr().GetSubArray(m_FirstProperty[uiNodeIndex], node.m_uiNumProperties);
+}
+
+ezUInt32 ezAbstractGraphBinaryView::FindProperty(const Node& node, ezStringView sName) const
+{
+  const ezUInt32 uiName = FindString(sName);
+  if (uiName == ezInvalidIndex)
+    return ezInvalidIndex;
+
+  const ezUInt64 uiNodeIndex = static_cast<ezUInt64>(&node - m_Nodes.GetData());
+
+  ezUInt32 uiIndex = ezInvalidIndex;
+  m_NodePropertyToIndex.TryGetValue((uiNodeIndex << 32) | uiName, uiIndex);
+  return uiIndex;
+}
+
+ezVariant ezAbstractGraphBinaryView::GetPropertyValue(ezUInt32 uiIndex) const
+{
+  const ezUInt32 uiStringValue = m_Properties[uiIndex].m_uiStringValue;
+  if (uiStringValue != ezInvalidIndex)
+    return ezVariant(GetString(uiStringValue).GetStartPointer());
+
+  return m_Values[uiIndex];
+}
+
+void ezAbstractGraphBinaryView::CreateGraph(ezAbstractObjectGraph* pGraph) const
+{
+  for (const Node& node : m_Nodes)
+  {
+    ezAbstractObjectNode* pNode =
+      pGraph->AddNode(node.m_Guid, GetString(node.m_uiType).GetStartPointer(), node.m_uiTypeVersion, GetString(node.m_uiNodeName).GetStartPointer());
+
+    for (const Property& prop : GetProperties(node))
+    {
+      pNode->AddProperty(GetString(prop.m_uiName).GetStartPointer(), GetPropertyValue(GetPropertyIndex(prop)));
+    }
+  }
+}
+
+ezResult ezAbstractGraphBinaryView::ReadGraph(ezStreamReader& stream)
+{
+  Clear();
+
+  EZ_SUCCEED_OR_RETURN(ReadRecords(stream, m_StringData));
+  EZ_SUCCEED_OR_RETURN(ReadRecords(stream, m_StringOffsets));
+  EZ_SUCCEED_OR_RETURN(ReadRecords(stream, m_Nodes));
+  EZ_SUCCEED_OR_RETURN(ReadRecords(stream, m_Properties));
+
+  if (Validate().Failed())
+  {
+    Clear();
+    return EZ_FAILURE;
+  }
+
+  m_Values.SetCount(m_Properties.GetCount());
+
+  for (ezUInt32 i = 0; i < m_Properties.GetCount(); ++i)
+  {
+    if (m_Properties[i].m_uiStringValue == ezInvalidIndex)
+    {
+      stream >> m_Values[i];
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezAbstractGraphBinaryView::Validate()
+{
+  const ezUInt32 uiNumStrings = m_StringOffsets.GetCount();
+
+  // every string has to start inside the data and be terminated right before the next one starts
+  for (ezUInt32 i = 0; i < uiNumStrings; ++i)
+  {
+    const ezUInt32 uiEnd = i + 1 < uiNumStrings ? m_StringOffsets[i + 1] : m_StringData.GetCount();
+    if (m_StringOffsets[i] >= uiEnd || uiEnd > m_StringData.GetCount() || m_StringData[uiEnd - 1] != '\0')
+      return EZ_FAILURE;
+  }
+
+  m_FirstProperty.SetCountUninitialized(m_Nodes.GetCount());
+
+  ezUInt64 uiNumProperties = 0;
+  for (ezUInt32 i = 0; i < m_Nodes.GetCount(); ++i)
+  {
+    const Node& node = m_Nodes[i];
+    if (node.m_uiType >= uiNumStrings || node.m_uiNodeName >= uiNumStrings)
+      return EZ_FAILURE;
+
+    m_FirstProperty[i] = static_cast<ezUInt32>(uiNumProperties);
+    uiNumProperties += node.m_uiNumProperties;
+
+    if (uiNumProperties > m_Properties.GetCount())
+      return EZ_FAILURE;
+  }
+
+  if (uiNumProperties != m_Properties.GetCount())
+    return EZ_FAILURE;
+
+  for (const Property& prop : m_Properties)
+  {
+    if (prop.m_uiName >= uiNumStrings || (prop.m_uiStringValue != ezInvalidIndex && prop.m_uiStringValue >= uiNumStrings))
+      return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+void ezAbstractGraphBinaryView::BuildIndices()
+{
+  const ezUInt32 uiNumStrings = m_StringOffsets.GetCount();
+
+  // the writer stores every string, guid and property name of a node once, for duplicates in foreign data the first one is found
+  m_StringToIndex.Reserve(uiNumStrings);
+  for (ezUInt32 i = 0; i < uiNumStrings; ++i)
+  {
+    const ezStringView sString = GetString(i);
+    if (!m_StringToIndex.Contains(sString))
+      m_StringToIndex.Insert(sString, i);
+  }
+
+  m_GuidToNode.Reserve(m_Nodes.GetCount());
+  m_NameToNode.Reserve(m_Nodes.GetCount());
+  m_NodePropertyToIndex.Reserve(m_Properties.GetCount());
+
+  for (ezUInt32 uiNode = 0; uiNode < m_Nodes.GetCount(); ++uiNode)
+  {
+    const Node& node = m_Nodes[uiNode];
+
+    if (!m_GuidToNode.Contains(node.m_Guid))
+      m_GuidToNode.Insert(node.m_Guid, uiNode);
+
+    if (!m_NameToNode.Contains(node.m_uiNodeName))
+      m_NameToNode.Insert(node.m_uiNodeName, uiNode);
+
+    const ezUInt32 uiFirstProperty = m_FirstProperty[uiNode];
+    for (ezUInt32 i = uiFirstProperty; i < uiFirstProperty + node.m_uiNumProperties; ++i)
+    {
+      const ezUInt64 uiKey = (static_cast<ezUInt64>(uiNode) << 32) | m_Properties[i].m_uiName;
+      if (!m_NodePropertyToIndex.Contains(uiKey))
+        m_NodePropertyToIndex.Insert(uiKey, i);
+    }
+  }
+}
+
 EZ_STATICLINK_FILE(Foundation, Foundation_Serialization_Implementation_BinarySerializer);
@@ -1,5 +1,6 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/IO/OpenDdlReader.h>
 #include <Foundation/IO/OpenDdlUtils.h>
 #include <Foundation/IO/OpenDdlWriter.h>
@@ -9,6 +10,15 @@
 
 namespace
 {
+  /// \brief Reads the whole stream into memory first, since parsing a buffer is a lot faster than parsing byte by byte from a stream.
+  ezResult ParseEntireDocument(ezOpenDdlReader& reader, ezStreamReader& stream)
+  {
+    ezMemoryStreamContainerStorage<ezDynamicArray<ezUInt8>> storage;
+    storage.ReadAll(stream);
+
+    return reader.ParseDocument(ezArrayPtr<const ezUInt8>(storage.GetData(), storage.GetStorageSize()), 0, ezLog::GetThreadLocalLogSystem());
+  }
+
   ezSerializedBlock* FindBlock(ezHybridArray<ezSerializedBlock, 3>& blocks, const char* szName)
   {
     for (auto& block : blocks)
@@ -62,10 +72,12 @@ static void WriteGraph(ezOpenDdlWriter& writer, const ezAbstractObjectGraph* pGr
 
   writer.BeginObject(szName);
 
-  const auto& Nodes = pGraph->GetAllNodes();
-  for (auto itNode = Nodes.GetIterator(); itNode.IsValid(); ++itNode)
+  ezDynamicArray<const ezAbstractObjectNode*> Nodes;
+  pGraph->GetNodesSortedByGuid(Nodes);
+
+  for (const ezAbstractObjectNode* pNode : Nodes)
   {
-    const auto& node = *itNode.Value();
+    const auto& node = *pNode;
 
     writer.BeginObject("o");
 
@@ -182,7 +194,7 @@ ezResult ezAbstractGraphDdlSerializer::Read(
   ezStreamReader& stream, ezAbstractObjectGraph* pGraph, ezAbstractObjectGraph* pTypesGraph, bool bApplyPatches)
 {
   ezOpenDdlReader reader;
-  if (reader.ParseDocument(stream, 0, ezLog::GetThreadLocalLogSystem()).Failed())
+  if (ParseEntireDocument(reader, stream).Failed())
   {
     ezLog::Error("Failed to parse DDL graph");
     return EZ_FAILURE;
@@ -233,7 +245,7 @@ ezResult ezAbstractGraphDdlSerializer::Read(const ezOpenDdlReaderElement* pRootE
 ezResult ezAbstractGraphDdlSerializer::ReadBlocks(ezStreamReader& stream, ezHybridArray<ezSerializedBlock, 3>& blocks)
 {
   ezOpenDdlReader reader;
-  if (reader.ParseDocument(stream, 0, ezLog::GetThreadLocalLogSystem()).Failed())
+  if (ParseEntireDocument(reader, stream).Failed())
   {
     ezLog::Error("Failed to parse DDL graph");
     return EZ_FAILURE;
@@ -226,11 +226,25 @@ void ezGraphVersioning::PatchGraph(ezAbstractObjectGraph* pGraph, ezAbstractObje
     pPatch->Patch(context, pGraph, nullptr);
   }
 
-  auto& nodes = pGraph->GetAllNodes();
-  for (auto it = nodes.GetIterator(); it.IsValid(); ++it)
+  // patches can add and remove nodes, e.g. when inlining properties, so the nodes are looked up again by their guid
+  ezDynamicArray<ezUuid> guids;
   {
-    ezAbstractObjectNode* pNode = it.Value();
-    context.Patch(pNode);
+    ezDynamicArray<const ezAbstractObjectNode*> nodes;
+    pGraph->GetNodesSortedByGuid(nodes);
+
+    guids.Reserve(nodes.GetCount());
+    for (const ezAbstractObjectNode* pNode : nodes)
+    {
+      guids.PushBack(pNode->GetGuid());
+    }
+  }
+
+  for (const ezUuid& guid : guids)
+  {
+    if (ezAbstractObjectNode* pNode = pGraph->GetNode(guid))
+    {
+      context.Patch(pNode);
+    }
   }
 }
 
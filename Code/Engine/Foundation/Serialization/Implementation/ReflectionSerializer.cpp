@@ -1,5 +1,8 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/Configuration/Plugin.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/IO/OpenDdlReader.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Reflection/ReflectionUtils.h>
@@ -7,9 +10,486 @@
 #include <Foundation/Serialization/DdlSerializer.h>
 #include <Foundation/Serialization/ReflectionSerializer.h>
 #include <Foundation/Serialization/RttiConverter.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Types/RefCounted.h>
 #include <Foundation/Types/ScopeExit.h>
+#include <Foundation/Types/SharedPtr.h>
 #include <Foundation/Types/VariantTypeRegistry.h>
 
+////////////////////////////////////////////////////////////////////////
+// Serialization plans
+////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+  /// \brief The first bytes of binary data that was written through a serialization plan.
+  ///
+  /// The graph format starts with its version number, which can never be mistaken for this tag.
+  static constexpr ezUInt8 s_PlainDataTag[4] = {'E', 'Z', 'R', 'P'};
+
+  /// \brief The largest plain data type is ezMat4, values behind accessor functions are copied through a buffer of this size.
+  static constexpr ezUInt32 s_uiMaxPlainDataSize = sizeof(ezMat4);
+
+  /// \brief Returns the size of the variant type if it is plain data that can be copied byte by byte, otherwise 0.
+  ///
+  /// If \a pData is given, the value is also read from it into \a out_Value.
+  ezUInt32 ReadPlainDataValue(ezVariantType::Enum type, const void* pData, ezVariant* out_pValue)
+  {
+#define EZ_PLAIN_DATA_TYPE(VariantType, Type)                 \
+  case ezVariantType::VariantType:                            \
+    if (pData != nullptr)                                     \
+    {                                                         \
+      Type value;                                             \
+      ezMemoryUtils::RawByteCopy(&value, pData, sizeof(Type)); \
+      *out_pValue = value;                                    \
+    }                                                         \
+    return sizeof(Type)
+
+    switch (type)
+    {
+      case ezVariantType::Bool:
+        if (pData != nullptr)
+        {
+          // any byte that is not zero is true, copying it into a bool directly would be undefined behavior
+          *out_pValue = *static_cast<const ezUInt8*>(pData) != 0;
+        }
+        return sizeof(bool);
+
+      EZ_PLAIN_DATA_TYPE(Int8, ezInt8);
+      EZ_PLAIN_DATA_TYPE(UInt8, ezUInt8);
+      EZ_PLAIN_DATA_TYPE(Int16, ezInt16);
+      EZ_PLAIN_DATA_TYPE(UInt16, ezUInt16);
+      EZ_PLAIN_DATA_TYPE(Int32, ezInt32);
+      EZ_PLAIN_DATA_TYPE(UInt32, ezUInt32);
+      EZ_PLAIN_DATA_TYPE(Int64, ezInt64);
+      EZ_PLAIN_DATA_TYPE(UInt64, ezUInt64);
+      EZ_PLAIN_DATA_TYPE(Float, float);
+      EZ_PLAIN_DATA_TYPE(Double, double);
+      EZ_PLAIN_DATA_TYPE(Color, ezColor);
+      EZ_PLAIN_DATA_TYPE(Vector2, ezVec2);
+      EZ_PLAIN_DATA_TYPE(Vector3, ezVec3);
+      EZ_PLAIN_DATA_TYPE(Vector4, ezVec4);
+      EZ_PLAIN_DATA_TYPE(Vector2I, ezVec2I32);
+      EZ_PLAIN_DATA_TYPE(Vector3I, ezVec3I32);
+      EZ_PLAIN_DATA_TYPE(Vector4I, ezVec4I32);
+      EZ_PLAIN_DATA_TYPE(Vector2U, ezVec2U32);
+      EZ_PLAIN_DATA_TYPE(Vector3U, ezVec3U32);
+      EZ_PLAIN_DATA_TYPE(Vector4U, ezVec4U32);
+      EZ_PLAIN_DATA_TYPE(Quaternion, ezQuat);
+      EZ_PLAIN_DATA_TYPE(Matrix3, ezMat3);
+      EZ_PLAIN_DATA_TYPE(Matrix4, ezMat4);
+      EZ_PLAIN_DATA_TYPE(Transform, ezTransform);
+      EZ_PLAIN_DATA_TYPE(Time, ezTime);
+      EZ_PLAIN_DATA_TYPE(Uuid, ezUuid);
+      EZ_PLAIN_DATA_TYPE(Angle, ezAngle);
+      EZ_PLAIN_DATA_TYPE(ColorGamma, ezColorGammaUB);
+
+      default:
+        return 0;
+    }
+
+#undef EZ_PLAIN_DATA_TYPE
+  }
+
+  /// \brief Describes how to copy the properties of one type, computed once per type.
+  ///
+  /// Members that are plain data and directly accessible are copied with memcpy, consecutive ones in a single run. Plain data behind
+  /// accessor functions is copied through a buffer, without converting it to an ezVariant. All other properties are handled one by one
+  /// like before.
+  struct ezSerializationPlan : public ezRefCounted
+  {
+    enum class StepType : ezUInt8
+    {
+      MemCopy,  ///< m_uiSize bytes at m_uiOffset in the object
+      Accessor, ///< m_uiSize bytes through GetValuePtr / SetValuePtr of m_pProperty
+      Property, ///< any other property, only supported by Clone
+    };
+
+    struct Step
+    {
+      StepType m_Type;
+      bool m_bBool = false; ///< The step copies a single bool, which is validated when reading
+      ezUInt32 m_uiOffset = 0;
+      ezUInt32 m_uiSize = 0;
+      ezAbstractProperty* m_pProperty = nullptr;
+    };
+
+    ezDynamicArray<Step> m_Steps;
+
+    /// All serialized properties are plain data, the object can be written in the plain data binary format.
+    bool m_bPlainData = true;
+
+    /// The number of bytes that the plain data properties take up in the binary format.
+    ezUInt32 m_uiDataSize = 0;
+
+    /// Identifies the type name, the versions of the type hierarchy and the names and types of the properties.
+    /// Data with the same hash can be copied into an object without looking at the schema.
+    ezUInt64 m_uiSchemaHash = 0;
+
+    /// The name and variant type of every plain data property, in the order in which the values are stored.
+    ezDynamicArray<ezUInt8> m_Schema;
+
+    void Build(const ezRTTI* pRtti, const void* pInstance)
+    {
+      ezHybridArray<const ezRTTI*, 8> hierarchy;
+      for (const ezRTTI* pType = pRtti; pType != nullptr; pType = pType->GetParentType())
+      {
+        hierarchy.PushBack(pType);
+      }
+
+      struct SchemaEntry
+      {
+        EZ_DECLARE_POD_TYPE();
+
+        const char* m_szName;
+        ezUInt8 m_uiType;
+      };
+
+      ezHybridArray<SchemaEntry, 32> schema;
+
+      m_uiSchemaHash = ezHashingUtils::xxHash64String(ezStringView(pRtti->GetTypeName()));
+
+      const ezUInt8* pObjectStart = static_cast<const ezUInt8*>(pInstance);
+      const ezUInt8* pObjectEnd = pObjectStart + pRtti->GetTypeSize();
+
+      // parent properties first, this is the order in which the graph based path applies them
+      for (ezUInt32 t = hierarchy.GetCount(); t > 0; --t)
+      {
+        const ezRTTI* pType = hierarchy[t - 1];
+
+        const ezUInt32 uiVersion = pType->GetTypeVersion();
+        m_uiSchemaHash = ezHashingUtils::xxHash64(&uiVersion, sizeof(uiVersion), m_uiSchemaHash);
+
+        for (ezAbstractProperty* pProp : pType->GetProperties())
+        {
+          if (pProp->GetCategory() == ezPropertyCategory::Constant || pProp->GetFlags().IsSet(ezPropertyFlags::ReadOnly))
+            continue;
+
+          const ezVariantType::Enum variantType = pProp->GetSpecificType()->GetVariantType();
+          const ezUInt32 uiSize = ReadPlainDataValue(variantType, nullptr, nullptr);
+
+          if (pProp->GetCategory() != ezPropertyCategory::Member || pProp->GetFlags().IsSet(ezPropertyFlags::Pointer) ||
+              !pProp->GetFlags().IsSet(ezPropertyFlags::StandardType) || uiSize == 0 || uiSize != pProp->GetSpecificType()->GetTypeSize())
+          {
+            auto& step = m_Steps.ExpandAndGetRef();
+            step.m_Type = StepType::Property;
+            step.m_pProperty = pProp;
+
+            m_bPlainData = false;
+            continue;
+          }
+
+          auto* pMember = static_cast<ezAbstractMemberProperty*>(pProp);
+          const ezUInt8* pMemberData = static_cast<const ezUInt8*>(pMember->GetPropertyPointer(pInstance));
+
+          if (pMemberData >= pObjectStart && pMemberData + uiSize <= pObjectEnd)
+          {
+            const ezUInt32 uiOffset = static_cast<ezUInt32>(pMemberData - pObjectStart);
+            const bool bBool = variantType == ezVariantType::Bool;
+
+            // bools get a step of their own, so that reading can turn any byte into a valid bool
+            if (!bBool && !m_Steps.IsEmpty() && m_Steps.PeekBack().m_Type == StepType::MemCopy && !m_Steps.PeekBack().m_bBool &&
+                m_Steps.PeekBack().m_uiOffset + m_Steps.PeekBack().m_uiSize == uiOffset)
+            {
+              m_Steps.PeekBack().m_uiSize += uiSize;
+            }
+            else
+            {
+              auto& step = m_Steps.ExpandAndGetRef();
+              step.m_Type = StepType::MemCopy;
+              step.m_bBool = bBool;
+              step.m_uiOffset = uiOffset;
+              step.m_uiSize = uiSize;
+            }
+          }
+          else
+          {
+            auto& step = m_Steps.ExpandAndGetRef();
+            step.m_Type = StepType::Accessor;
+            step.m_bBool = variantType == ezVariantType::Bool;
+            step.m_uiSize = uiSize;
+            step.m_pProperty = pProp;
+          }
+
+          m_uiDataSize += uiSize;
+          schema.PushBack({pProp->GetPropertyName(), static_cast<ezUInt8>(variantType)});
+        }
+      }
+
+      if (!m_bPlainData)
+        return;
+
+      ezMemoryStreamContainerWrapperStorage<ezDynamicArray<ezUInt8>> storage(&m_Schema);
+      ezMemoryStreamWriter writer(&storage);
+
+      writer << schema.GetCount();
+      for (const SchemaEntry& entry : schema)
+      {
+        writer << entry.m_szName;
+        writer << entry.m_uiType;
+      }
+
+      m_uiSchemaHash = ezHashingUtils::xxHash64(m_Schema.GetData(), m_Schema.GetCount(), m_uiSchemaHash);
+    }
+
+    void Clone(const void* pObject, void* pClone) const;
+
+    void WritePlainData(ezStreamWriter& stream, const void* pObject) const
+    {
+      const ezUInt8* pSource = static_cast<const ezUInt8*>(pObject);
+      EZ_ALIGN_16(ezUInt8 buffer[s_uiMaxPlainDataSize]);
+
+      for (const Step& step : m_Steps)
+      {
+        if (step.m_Type == StepType::MemCopy)
+        {
+          stream.WriteBytes(pSource + step.m_uiOffset, step.m_uiSize).IgnoreResult();
+        }
+        else
+        {
+          static_cast<ezAbstractMemberProperty*>(step.m_pProperty)->GetValuePtr(pObject, buffer);
+          stream.WriteBytes(buffer, step.m_uiSize).IgnoreResult();
+        }
+      }
+    }
+
+    void ReadPlainData(ezStreamReader& stream, void* pObject) const
+    {
+      ezUInt8* pTarget = static_cast<ezUInt8*>(pObject);
+      EZ_ALIGN_16(ezUInt8 buffer[s_uiMaxPlainDataSize]);
+
+      for (const Step& step : m_Steps)
+      {
+        if (step.m_bBool)
+        {
+          ezUInt8 uiValue = 0;
+          stream >> uiValue;
+          bool bValue = uiValue != 0;
+
+          if (step.m_Type == StepType::MemCopy)
+            ezMemoryUtils::RawByteCopy(pTarget + step.m_uiOffset, &bValue, sizeof(bool));
+          else
+            static_cast<ezAbstractMemberProperty*>(step.m_pProperty)->SetValuePtr(pObject, &bValue);
+        }
+        else if (step.m_Type == StepType::MemCopy)
+        {
+          stream.ReadBytes(pTarget + step.m_uiOffset, step.m_uiSize);
+        }
+        else
+        {
+          stream.ReadBytes(buffer, step.m_uiSize);
+          static_cast<ezAbstractMemberProperty*>(step.m_pProperty)->SetValuePtr(pObject, buffer);
+        }
+      }
+    }
+  };
+
+  struct ezSerializationPlanCache
+  {
+    ezMutex m_Mutex;
+    ezHashTable<const ezRTTI*, ezSharedPtr<const ezSerializationPlan>> m_Plans;
+  };
+
+  static ezSerializationPlanCache* s_pPlanCache = nullptr;
+
+  /// \brief Returns the plan for pRtti, building it from \a pInstance on first use. Returns nullptr before the Foundation is started up.
+  ///
+  /// The plan is returned by reference, so that clearing the cache on another thread does not delete a plan that is still in use.
+  ezSharedPtr<const ezSerializationPlan> GetSerializationPlan(const ezRTTI* pRtti, const void* pInstance)
+  {
+    if (s_pPlanCache == nullptr)
+      return nullptr;
+
+    EZ_LOCK(s_pPlanCache->m_Mutex);
+
+    ezSharedPtr<const ezSerializationPlan>* pExisting = nullptr;
+    if (s_pPlanCache->m_Plans.TryGetValue(pRtti, pExisting))
+      return *pExisting;
+
+    ezSharedPtr<ezSerializationPlan> pPlan = EZ_DEFAULT_NEW(ezSerializationPlan);
+    pPlan->Build(pRtti, pInstance);
+
+    s_pPlanCache->m_Plans.Insert(pRtti, pPlan);
+    return pPlan;
+  }
+
+  void SerializationPlanPluginEventHandler(const ezPluginEvent& e)
+  {
+    // types of unloaded plugins are gone and new types may end up at the same address
+    if (e.m_EventType == ezPluginEvent::AfterUnloading)
+    {
+      EZ_LOCK(s_pPlanCache->m_Mutex);
+      s_pPlanCache->m_Plans.Clear();
+    }
+  }
+
+  /// \brief Replays the first bytes that were already read to detect the format, before passing on the rest of the stream.
+  class ezPrefixedStreamReader : public ezStreamReader
+  {
+  public:
+    ezPrefixedStreamReader(ezStreamReader& stream, const ezUInt8* pPrefix, ezUInt32 uiPrefixSize)
+      : m_Stream(stream)
+      , m_pPrefix(pPrefix)
+      , m_uiPrefixSize(uiPrefixSize)
+    {
+    }
+
+    virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override
+    {
+      ezUInt8* pBuffer = static_cast<ezUInt8*>(pReadBuffer);
+      ezUInt64 uiBytesRead = 0;
+
+      while (m_uiPrefixRead < m_uiPrefixSize && uiBytesRead < uiBytesToRead)
+      {
+        pBuffer[uiBytesRead++] = m_pPrefix[m_uiPrefixRead++];
+      }
+
+      if (uiBytesRead < uiBytesToRead)
+      {
+        uiBytesRead += m_Stream.ReadBytes(pBuffer + uiBytesRead, uiBytesToRead - uiBytesRead);
+      }
+
+      return uiBytesRead;
+    }
+
+  private:
+    ezStreamReader& m_Stream;
+    const ezUInt8* m_pPrefix;
+    ezUInt32 m_uiPrefixSize;
+    ezUInt32 m_uiPrefixRead = 0;
+  };
+
+  /// \brief Reads the plain data format (after the tag and the type name) and applies it to pObject of type rtti.
+  ///
+  /// If the data was written with exactly the same schema, the values are copied right into the object. Otherwise the properties are matched
+  /// by name through the regular ezRttiConverterReader, like in the graph based path. Values that do not fit the data are not applied.
+  void ReadPlainDataProperties(ezStreamReader& stream, const char* szTypeName, const ezRTTI& rtti, void* pObject)
+  {
+    // the sizes are read from the stream, anything larger than this is corrupted data
+    constexpr ezUInt32 uiMaxSize = 16 * 1024 * 1024;
+
+    ezUInt32 uiTypeVersion = 0;
+    ezUInt64 uiSchemaHash = 0;
+    ezUInt32 uiSchemaSize = 0;
+    stream >> uiTypeVersion;
+    stream >> uiSchemaHash;
+    stream >> uiSchemaSize;
+
+    ezSharedPtr<const ezSerializationPlan> pPlan = GetSerializationPlan(&rtti, pObject);
+
+    ezDynamicArray<ezUInt8> schema;
+    ezUInt32 uiDataSize = 0;
+
+    if (pPlan != nullptr && pPlan->m_bPlainData && pPlan->m_uiSchemaHash == uiSchemaHash && pPlan->m_Schema.GetCount() == uiSchemaSize)
+    {
+      stream.SkipBytes(uiSchemaSize);
+      stream >> uiDataSize;
+
+      if (uiDataSize == pPlan->m_uiDataSize)
+      {
+        pPlan->ReadPlainData(stream, pObject);
+        return;
+      }
+
+      // the schema is the same, only the data does not fit it, let the generic path pick out what it can
+      schema = pPlan->m_Schema;
+    }
+    else
+    {
+      if (uiSchemaSize > uiMaxSize)
+      {
+        ezLog::Error("Invalid plain data schema size {0} for type '{1}'", uiSchemaSize, szTypeName);
+        return;
+      }
+
+      schema.SetCountUninitialized(uiSchemaSize);
+      if (stream.ReadBytes(schema.GetData(), uiSchemaSize) != uiSchemaSize)
+      {
+        ezLog::Error("Plain data schema of type '{0}' is truncated", szTypeName);
+        return;
+      }
+
+      stream >> uiDataSize;
+    }
+
+    if (uiDataSize > uiMaxSize)
+    {
+      ezLog::Error("Invalid plain data size {0} for type '{1}'", uiDataSize, szTypeName);
+      return;
+    }
+
+    ezDynamicArray<ezUInt8> data;
+    data.SetCountUninitialized(uiDataSize);
+    if (stream.ReadBytes(data.GetData(), uiDataSize) != uiDataSize)
+    {
+      ezLog::Error("Plain data of type '{0}' is truncated", szTypeName);
+      return;
+    }
+
+    ezAbstractObjectGraph graph;
+    ezUuid guid;
+    guid.CreateNewUuid();
+    ezAbstractObjectNode* pNode = graph.AddNode(guid, szTypeName, uiTypeVersion, "root");
+
+    ezRawMemoryStreamReader schemaReader(schema);
+    ezUInt32 uiNumProperties = 0;
+    schemaReader >> uiNumProperties;
+
+    ezStringBuilder sName;
+    ezUInt32 uiDataOffset = 0;
+    for (ezUInt32 i = 0; i < uiNumProperties; ++i)
+    {
+      ezUInt8 uiType = 0;
+      schemaReader >> sName;
+      if (schemaReader.ReadBytes(&uiType, sizeof(uiType)) != sizeof(uiType))
+      {
+        ezLog::Error("Plain data schema of type '{0}' is truncated", szTypeName);
+        break;
+      }
+
+      const ezUInt32 uiSize = ReadPlainDataValue(static_cast<ezVariantType::Enum>(uiType), nullptr, nullptr);
+      if (uiSize == 0 || uiSize > uiDataSize - uiDataOffset)
+      {
+        ezLog::Error("Plain data of type '{0}' does not match its schema at property '{1}'", szTypeName, sName);
+        break;
+      }
+
+      ezVariant value;
+      ReadPlainDataValue(static_cast<ezVariantType::Enum>(uiType), data.GetData() + uiDataOffset, &value);
+      uiDataOffset += uiSize;
+
+      pNode->AddProperty(sName, value);
+    }
+
+    ezRttiConverterContext context;
+    ezRttiConverterReader convRead(&graph, &context);
+    convRead.ApplyPropertiesToObject(pNode, &rtti, pObject);
+  }
+} // namespace
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, ReflectionSerializer)
+
+  BEGIN_SUBSYSTEM_DEPENDENCIES
+  "Reflection"
+  END_SUBSYSTEM_DEPENDENCIES
+
+  ON_CORESYSTEMS_STARTUP
+  {
+    s_pPlanCache = EZ_DEFAULT_NEW(ezSerializationPlanCache);
+    ezPlugin::s_PluginEvents.AddEventHandler(SerializationPlanPluginEventHandler);
+  }
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    ezPlugin::s_PluginEvents.RemoveEventHandler(SerializationPlanPluginEventHandler);
+    EZ_DEFAULT_DELETE(s_pPlanCache);
+  }
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
 ////////////////////////////////////////////////////////////////////////
 // ezReflectionSerializer public static functions
 ////////////////////////////////////////////////////////////////////////
@@ -46,6 +526,19 @@ void ezReflectionSerializer::WriteObjectToDDL(ezOpenDdlWriter& ddl, const ezRTTI
 
 void ezReflectionSerializer::WriteObjectToBinary(ezStreamWriter& stream, const ezRTTI* pRtti, const void* pObject)
 {
+  if (ezSharedPtr<const ezSerializationPlan> pPlan = GetSerializationPlan(pRtti, pObject); pPlan != nullptr && pPlan->m_bPlainData)
+  {
+    stream.WriteBytes(s_PlainDataTag, sizeof(s_PlainDataTag)).IgnoreResult();
+    stream << pRtti->GetTypeName();
+    stream << pRtti->GetTypeVersion();
+    stream << pPlan->m_uiSchemaHash;
+    stream << pPlan->m_Schema.GetCount();
+    stream.WriteBytes(pPlan->m_Schema.GetData(), pPlan->m_Schema.GetCount()).IgnoreResult();
+    stream << pPlan->m_uiDataSize;
+    pPlan->WritePlainData(stream, pObject);
+    return;
+  }
+
   ezAbstractObjectGraph graph;
   ezRttiConverterContext context;
   ezRttiConverterWriter conv(&graph, &context, false, true);
@@ -94,10 +587,32 @@ void* ezReflectionSerializer::ReadObjectFromDDL(const ezOpenDdlReaderElement* pR
 
 void* ezReflectionSerializer::ReadObjectFromBinary(ezStreamReader& stream, const ezRTTI*& pRtti)
 {
+  ezUInt8 tag[sizeof(s_PlainDataTag)];
+  const ezUInt32 uiTagSize = static_cast<ezUInt32>(stream.ReadBytes(tag, sizeof(tag)));
+
+  if (uiTagSize == sizeof(tag) && ezMemoryUtils::IsEqual(tag, s_PlainDataTag, sizeof(tag)))
+  {
+    ezStringBuilder sTypeName;
+    stream >> sTypeName;
+
+    pRtti = ezRTTI::FindTypeByName(sTypeName);
+    if (pRtti == nullptr || !pRtti->GetAllocator()->CanAllocate())
+    {
+      ezLog::Error("Cannot create an object of unknown type '{0}'", sTypeName);
+      pRtti = nullptr;
+      return nullptr;
+    }
+
+    void* pTarget = pRtti->GetAllocator()->Allocate<void>();
+    ReadPlainDataProperties(stream, sTypeName, *pRtti, pTarget);
+    return pTarget;
+  }
+
   ezAbstractObjectGraph graph;
   ezRttiConverterContext context;
 
-  ezAbstractGraphBinarySerializer::Read(stream, &graph);
+  ezPrefixedStreamReader graphStream(stream, tag, uiTagSize);
+  ezAbstractGraphBinarySerializer::Read(graphStream, &graph);
 
   ezRttiConverterReader convRead(&graph, &context);
   auto* pRootNode = graph.GetNodeByName("root");
@@ -133,10 +648,23 @@ void ezReflectionSerializer::ReadObjectPropertiesFromDDL(ezStreamReader& stream,
 
 void ezReflectionSerializer::ReadObjectPropertiesFromBinary(ezStreamReader& stream, const ezRTTI& rtti, void* pObject)
 {
+  ezUInt8 tag[sizeof(s_PlainDataTag)];
+  const ezUInt32 uiTagSize = static_cast<ezUInt32>(stream.ReadBytes(tag, sizeof(tag)));
+
+  if (uiTagSize == sizeof(tag) && ezMemoryUtils::IsEqual(tag, s_PlainDataTag, sizeof(tag)))
+  {
+    ezStringBuilder sTypeName;
+    stream >> sTypeName;
+
+    ReadPlainDataProperties(stream, sTypeName, rtti, pObject);
+    return;
+  }
+
   ezAbstractObjectGraph graph;
   ezRttiConverterContext context;
 
-  ezAbstractGraphBinarySerializer::Read(stream, &graph);
+  ezPrefixedStreamReader graphStream(stream, tag, uiTagSize);
+  ezAbstractGraphBinarySerializer::Read(graphStream, &graph);
 
   ezRttiConverterReader convRead(&graph, &context);
   auto* pRootNode = graph.GetNodeByName("root");
@@ -385,6 +913,50 @@ namespace
       CloneProperty(pObject, pClone, pProp);
     }
   }
+
+  void ezSerializationPlan::Clone(const void* pObject, void* pClone) const
+  {
+    const ezUInt8* pSource = static_cast<const ezUInt8*>(pObject);
+    ezUInt8* pTarget = static_cast<ezUInt8*>(pClone);
+    EZ_ALIGN_16(ezUInt8 buffer[s_uiMaxPlainDataSize]);
+
+    for (const Step& step : m_Steps)
+    {
+      switch (step.m_Type)
+      {
+        case StepType::MemCopy:
+          if (pSource != pTarget)
+          {
+            ezMemoryUtils::RawByteCopy(pTarget + step.m_uiOffset, pSource + step.m_uiOffset, step.m_uiSize);
+          }
+          break;
+
+        case StepType::Accessor:
+        {
+          auto* pMember = static_cast<ezAbstractMemberProperty*>(step.m_pProperty);
+          pMember->GetValuePtr(pObject, buffer);
+          pMember->SetValuePtr(pClone, buffer);
+        }
+        break;
+
+        case StepType::Property:
+          CloneProperty(pObject, pClone, step.m_pProperty);
+          break;
+      }
+    }
+  }
+
+  void ClonePropertiesWithPlan(const void* pObject, void* pClone, const ezRTTI* pType)
+  {
+    if (ezSharedPtr<const ezSerializationPlan> pPlan = GetSerializationPlan(pType, pObject))
+    {
+      pPlan->Clone(pObject, pClone);
+    }
+    else
+    {
+      CloneProperties(pObject, pClone, pType);
+    }
+  }
 } // namespace
 
 void* ezReflectionSerializer::Clone(const void* pObject, const ezRTTI* pType)
@@ -401,7 +973,7 @@ void* ezReflectionSerializer::Clone(const void* pObject, const ezRTTI* pType)
 
   EZ_ASSERT_DEV(pType->GetAllocator()->CanAllocate(), "The type '{0}' can't be cloned!", pType->GetTypeName());
   void* pClone = pType->GetAllocator()->Allocate<void>();
-  CloneProperties(pObject, pClone, pType);
+  ClonePropertiesWithPlan(pObject, pClone, pType);
   return pClone;
 }
 
@@ -416,7 +988,7 @@ void ezReflectionSerializer::Clone(const void* pObject, void* pClone, const ezRT
     EZ_ASSERT_DEV(pType == static_cast<ezReflectedClass*>(pClone)->GetDynamicRTTI(), "Object '{0}' and clone '{1}' have mismatching types!", pType->GetTypeName(), static_cast<ezReflectedClass*>(pClone)->GetDynamicRTTI()->GetTypeName());
   }
 
-  CloneProperties(pObject, pClone, pType);
+  ClonePropertiesWithPlan(pObject, pClone, pType);
 }
 
 EZ_STATICLINK_FILE(Foundation, Foundation_Serialization_Implementation_ReflectionSerializer);
@@ -25,6 +25,10 @@ public:
   static void WriteObjectToDDL(ezOpenDdlWriter& ddl, const ezRTTI* pRtti, const void* pObject, ezUuid guid = ezUuid()); // [tested]
 
   /// \brief Same as WriteObjectToDDL but binary.
+  ///
+  /// Types whose writable properties are all plain data (numbers, vectors, matrices, colors, ...) are written in a compact format that
+  /// stores the raw values in a precomputed order. When read back into the same version of the type, the values are copied without any
+  /// lookups, otherwise they are matched by name like the regular graph data. All other types are written as an abstract object graph.
   static void WriteObjectToBinary(ezStreamWriter& stream, const ezRTTI* pRtti, const void* pObject); // [tested]
 
   /// \brief Reads the entire DDL data in the stream and restores a reflected object.
@@ -79,4 +79,8 @@
 //#undef EZ_USE_GUARDED_ALLOCATIONS
 //#define EZ_USE_GUARDED_ALLOCATIONS EZ_ON
 
+// Uncomment to use ezThreadCachingHeapAllocator as the default allocator. Reduces lock contention when many threads allocate small blocks.
+//#undef EZ_USE_THREAD_CACHING_ALLOCATIONS
+//#define EZ_USE_THREAD_CACHING_ALLOCATIONS EZ_ON
+
 #endif
@@ -0,0 +1,404 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Types/UniquePtr.h>
+#include <Foundation/Utilities/Metrics.h>
+#include <Foundation/Utilities/Stats.h>
+
+#include <atomic>
+
+struct ezMetricInfo
+{
+  ezString m_sName;
+  ezMetricType::Enum m_Type = ezMetricType::Counter;
+  ezUInt32 m_uiFirstSlot = ezInvalidIndex;
+  ezUInt32 m_uiNumSlots = 0;
+
+  // never changed after registration, histograms read them without a lock
+  ezHybridArray<double, ezMetrics::MaxHistogramBuckets> m_BucketUpperBounds;
+
+  // gauges store the bit pattern of a double
+  ezAtomicInteger64 m_iGaugeValue;
+
+  // the following are only accessed by ezMetrics::Update() and GetSnapshots()
+  ezString m_sCountStatName;
+  ezString m_sMeanStatName;
+  ezInt64 m_iLastTotal = 0;
+  double m_fLastSum = 0.0;
+  ezHybridArray<ezInt64, ezMetrics::MaxHistogramBuckets> m_LastBucketTotals;
+  ezMetricSnapshot m_Snapshot;
+};
+
+namespace
+{
+  /// The values of all counters and histograms that were written by one thread. Only that thread ever writes to them, so no atomic
+  /// read-modify-write operations are needed, a relaxed load and store is enough. ezMetrics::Update() reads them with relaxed loads
+  /// while they are being written.
+  struct ezMetricsThreadSlots
+  {
+    std::atomic<ezInt64> m_Values[ezMetrics::MaxSlots] = {};
+    bool m_bInUse = false;
+  };
+
+  struct ezMetricsData
+  {
+    ezMutex m_Mutex;
+    ezDynamicArray<ezUniquePtr<ezMetricInfo>> m_Metrics;
+    ezDynamicArray<ezUniquePtr<ezMetricsThreadSlots>> m_ThreadSlots;
+    ezUInt32 m_uiNumUsedSlots = 0;
+    bool m_bExportToStats = true;
+  };
+
+  ezMetricsData& GetData()
+  {
+    // metrics are typically registered during static initialization
+    static ezMetricsData s_Data;
+    return s_Data;
+  }
+
+  /// Hands the slots back when the thread exits, such that the next new thread can continue using them. Their values are kept, because
+  /// all that matters is the sum over all threads.
+  struct ezMetricsThreadSlotsOwner
+  {
+    ~ezMetricsThreadSlotsOwner()
+    {
+      if (m_pSlots != nullptr)
+      {
+        EZ_LOCK(GetData().m_Mutex);
+        m_pSlots->m_bInUse = false;
+      }
+    }
+
+    ezMetricsThreadSlots* m_pSlots = nullptr;
+  };
+
+  thread_local ezMetricsThreadSlotsOwner tl_MetricsSlots;
+
+  std::atomic<ezInt64>* AcquireThreadSlots()
+  {
+    ezMetricsData& data = GetData();
+    EZ_LOCK(data.m_Mutex);
+
+    ezMetricsThreadSlots* pSlots = nullptr;
+
+    for (auto& pCandidate : data.m_ThreadSlots)
+    {
+      if (!pCandidate->m_bInUse)
+      {
+        pSlots = pCandidate.Borrow();
+        break;
+      }
+    }
+
+    if (pSlots == nullptr)
+    {
+      data.m_ThreadSlots.PushBack(EZ_DEFAULT_NEW(ezMetricsThreadSlots));
+      pSlots = data.m_ThreadSlots.PeekBack().Borrow();
+    }
+
+    pSlots->m_bInUse = true;
+    tl_MetricsSlots.m_pSlots = pSlots;
+
+    return pSlots->m_Values;
+  }
+
+  EZ_ALWAYS_INLINE std::atomic<ezInt64>* GetThreadSlots()
+  {
+    if (ezMetricsThreadSlots* pSlots = tl_MetricsSlots.m_pSlots)
+      return pSlots->m_Values;
+
+    return AcquireThreadSlots();
+  }
+
+  EZ_ALWAYS_INLINE ezInt64 DoubleToBits(double fValue)
+  {
+    ezInt64 iBits;
+    ezMemoryUtils::RawByteCopy(&iBits, &fValue, sizeof(double));
+    return iBits;
+  }
+
+  EZ_ALWAYS_INLINE double BitsToDouble(ezInt64 iBits)
+  {
+    double fValue;
+    ezMemoryUtils::RawByteCopy(&fValue, &iBits, sizeof(double));
+    return fValue;
+  }
+
+  ezMetricInfo* RegisterMetric(const char* szName, ezMetricType::Enum type, ezUInt32 uiNumSlots)
+  {
+    ezMetricsData& data = GetData();
+    EZ_ASSERT_DEBUG(data.m_Mutex.IsLocked(), "");
+
+    for (auto& pInfo : data.m_Metrics)
+    {
+      if (pInfo->m_sName == szName)
+      {
+        if (pInfo->m_Type != type)
+        {
+          ezLog::Error("Metric '{0}' is already registered with a different type.", szName);
+          return nullptr;
+        }
+
+        return pInfo.Borrow();
+      }
+    }
+
+    if (data.m_uiNumUsedSlots + uiNumSlots > ezMetrics::MaxSlots)
+    {
+      ezLog::Error("Can't register metric '{0}', all {1} metric slots are in use.", szName, ezMetrics::MaxSlots);
+      return nullptr;
+    }
+
+    data.m_Metrics.PushBack(EZ_DEFAULT_NEW(ezMetricInfo));
+    ezMetricInfo* pInfo = data.m_Metrics.PeekBack().Borrow();
+    pInfo->m_sName = szName;
+    pInfo->m_Type = type;
+    pInfo->m_uiNumSlots = uiNumSlots;
+    pInfo->m_uiFirstSlot = uiNumSlots > 0 ? data.m_uiNumUsedSlots : ezInvalidIndex;
+    pInfo->m_Snapshot.m_sName = szName;
+    pInfo->m_Snapshot.m_Type = type;
+
+    data.m_uiNumUsedSlots += uiNumSlots;
+
+    return pInfo;
+  }
+} // namespace
+
+void ezMetricCounter::Add(ezInt64 iValue) const
+{
+  if (m_uiSlot == ezInvalidIndex)
+    return;
+
+  std::atomic<ezInt64>& slot = GetThreadSlots()[m_uiSlot];
+  slot.store(slot.load(std::memory_order_relaxed) + iValue, std::memory_order_relaxed);
+}
+
+void ezMetricGauge::Set(double fValue) const
+{
+  if (m_pInfo == nullptr)
+    return;
+
+  m_pInfo->m_iGaugeValue = DoubleToBits(fValue);
+}
+
+void ezMetricHistogram::Record(double fValue) const
+{
+  if (m_pInfo == nullptr)
+    return;
+
+  const ezUInt32 uiNumBounds = m_pInfo->m_BucketUpperBounds.GetCount();
+
+  ezUInt32 uiBucket = 0;
+  while (uiBucket < uiNumBounds && fValue > m_pInfo->m_BucketUpperBounds[uiBucket])
+  {
+    ++uiBucket;
+  }
+
+  std::atomic<ezInt64>* pSlots = GetThreadSlots() + m_pInfo->m_uiFirstSlot;
+  pSlots[uiBucket].store(pSlots[uiBucket].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+  // the last slot is the sum of all samples
+  std::atomic<ezInt64>& sum = pSlots[uiNumBounds + 1];
+  sum.store(DoubleToBits(BitsToDouble(sum.load(std::memory_order_relaxed)) + fValue), std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+// static
+ezMetricCounter ezMetrics::RegisterCounter(const char* szName)
+{
+  EZ_LOCK(GetData().m_Mutex);
+
+  ezMetricCounter counter;
+
+  if (ezMetricInfo* pInfo = RegisterMetric(szName, ezMetricType::Counter, 1))
+  {
+    counter.m_uiSlot = pInfo->m_uiFirstSlot;
+  }
+
+  return counter;
+}
+
+// static
+ezMetricGauge ezMetrics::RegisterGauge(const char* szName)
+{
+  EZ_LOCK(GetData().m_Mutex);
+
+  ezMetricGauge gauge;
+  gauge.m_pInfo = RegisterMetric(szName, ezMetricType::Gauge, 0);
+
+  return gauge;
+}
+
+// static
+ezMetricHistogram ezMetrics::RegisterHistogram(const char* szName, ezArrayPtr<const double> bucketUpperBounds)
+{
+  EZ_ASSERT_DEV(bucketUpperBounds.GetCount() < MaxHistogramBuckets, "A histogram can have at most {0} bucket bounds.", MaxHistogramBuckets - 1);
+
+  for (ezUInt32 i = 1; i < bucketUpperBounds.GetCount(); ++i)
+  {
+    EZ_ASSERT_DEV(bucketUpperBounds[i - 1] < bucketUpperBounds[i], "The bucket bounds of histogram '{0}' are not sorted.", szName);
+  }
+
+  EZ_LOCK(GetData().m_Mutex);
+
+  ezMetricHistogram histogram;
+
+  // one slot per bucket, plus the overflow bucket, plus the sum
+  ezMetricInfo* pInfo = RegisterMetric(szName, ezMetricType::Histogram, bucketUpperBounds.GetCount() + 2);
+
+  if (pInfo != nullptr)
+  {
+    if (pInfo->m_BucketUpperBounds.IsEmpty() && pInfo->m_LastBucketTotals.IsEmpty())
+    {
+      pInfo->m_BucketUpperBounds = bucketUpperBounds;
+      pInfo->m_LastBucketTotals.SetCount(bucketUpperBounds.GetCount() + 1);
+
+      pInfo->m_Snapshot.m_BucketUpperBounds = bucketUpperBounds;
+      pInfo->m_Snapshot.m_BucketCounts.SetCount(bucketUpperBounds.GetCount() + 1);
+
+      ezStringBuilder sStatName;
+      sStatName.Set(szName, "/Count");
+      pInfo->m_sCountStatName = sStatName;
+      sStatName.Set(szName, "/Mean");
+      pInfo->m_sMeanStatName = sStatName;
+    }
+
+    histogram.m_pInfo = pInfo;
+  }
+
+  return histogram;
+}
+
+// static
+void ezMetrics::Update()
+{
+  struct StatToExport
+  {
+    const char* m_szName;
+    ezVariant m_Value;
+  };
+
+  ezHybridArray<StatToExport, 64> statsToExport;
+
+  ezMetricsData& data = GetData();
+  {
+    // the stats are set after the lock is released, their event handlers must not wait for the metrics
+    EZ_LOCK(data.m_Mutex);
+
+    auto SumSlot = [&](ezUInt32 uiSlot) -> ezInt64 {
+      ezInt64 iSum = 0;
+      for (auto& pSlots : data.m_ThreadSlots)
+      {
+        iSum += pSlots->m_Values[uiSlot].load(std::memory_order_relaxed);
+      }
+      return iSum;
+    };
+
+    for (auto& pInfo : data.m_Metrics)
+    {
+      ezMetricSnapshot& snapshot = pInfo->m_Snapshot;
+
+      switch (pInfo->m_Type)
+      {
+        case ezMetricType::Counter:
+        {
+          const ezInt64 iTotal = SumSlot(pInfo->m_uiFirstSlot);
+
+          snapshot.m_fValue = static_cast<double>(iTotal - pInfo->m_iLastTotal);
+          snapshot.m_iTotal = iTotal;
+          pInfo->m_iLastTotal = iTotal;
+
+          if (data.m_bExportToStats)
+            statsToExport.PushBack({pInfo->m_sName.GetData(), ezVariant(static_cast<ezInt64>(snapshot.m_fValue))});
+        }
+        break;
+
+        case ezMetricType::Gauge:
+        {
+          snapshot.m_fValue = BitsToDouble(pInfo->m_iGaugeValue);
+
+          if (data.m_bExportToStats)
+            statsToExport.PushBack({pInfo->m_sName.GetData(), ezVariant(snapshot.m_fValue)});
+        }
+        break;
+
+        case ezMetricType::Histogram:
+        {
+          const ezUInt32 uiNumBuckets = pInfo->m_LastBucketTotals.GetCount();
+
+          ezInt64 iTotal = 0;
+          ezInt64 iFrameCount = 0;
+
+          for (ezUInt32 b = 0; b < uiNumBuckets; ++b)
+          {
+            const ezInt64 iBucketTotal = SumSlot(pInfo->m_uiFirstSlot + b);
+
+            snapshot.m_BucketCounts[b] = static_cast<ezUInt64>(iBucketTotal - pInfo->m_LastBucketTotals[b]);
+            pInfo->m_LastBucketTotals[b] = iBucketTotal;
+
+            iTotal += iBucketTotal;
+            iFrameCount += snapshot.m_BucketCounts[b];
+          }
+
+          double fSum = 0.0;
+          for (auto& pSlots : data.m_ThreadSlots)
+          {
+            fSum += BitsToDouble(pSlots->m_Values[pInfo->m_uiFirstSlot + uiNumBuckets].load(std::memory_order_relaxed));
+          }
+
+          snapshot.m_fValue = iFrameCount > 0 ? (fSum - pInfo->m_fLastSum) / iFrameCount : 0.0;
+          snapshot.m_iTotal = iTotal;
+          pInfo->m_fLastSum = fSum;
+
+          if (data.m_bExportToStats)
+          {
+            statsToExport.PushBack({pInfo->m_sCountStatName.GetData(), ezVariant(iFrameCount)});
+            statsToExport.PushBack({pInfo->m_sMeanStatName.GetData(), ezVariant(snapshot.m_fValue)});
+          }
+        }
+        break;
+      }
+    }
+  }
+
+  // the names stay valid, metrics are never unregistered
+  for (const StatToExport& stat : statsToExport)
+  {
+    ezStats::SetStat(stat.m_szName, stat.m_Value);
+  }
+}
+
+// static
+void ezMetrics::GetSnapshots(ezDynamicArray<ezMetricSnapshot>& out_Snapshots)
+{
+  ezMetricsData& data = GetData();
+  EZ_LOCK(data.m_Mutex);
+
+  out_Snapshots.Clear();
+  out_Snapshots.Reserve(data.m_Metrics.GetCount());
+
+  for (auto& pInfo : data.m_Metrics)
+  {
+    out_Snapshots.PushBack(pInfo->m_Snapshot);
+  }
+}
+
+// static
+void ezMetrics::SetExportToStats(bool bEnable)
+{
+  EZ_LOCK(GetData().m_Mutex);
+  GetData().m_bExportToStats = bEnable;
+}
+
+// static
+ezUInt32 ezMetrics::GetNumUsedSlots()
+{
+  EZ_LOCK(GetData().m_Mutex);
+  return GetData().m_uiNumUsedSlots;
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Utilities_Implementation_Metrics);
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Containers/HybridArray.h>
+#include <Foundation/Strings/String.h>
+#include <Foundation/Types/ArrayPtr.h>
+#include <Foundation/Types/Enum.h>
+
+struct ezMetricInfo;
+
+/// \brief The different kinds of metrics that can be registered at ezMetrics.
+struct ezMetricType
+{
+  using StorageType = ezUInt8;
+
+  enum Enum : ezUInt8
+  {
+    Counter,   ///< A value that is only ever added to, e.g. the number of updated objects. Reported per frame.
+    Gauge,     ///< A value that is set to an absolute value, e.g. the size of a pool. Reports the last value that was set.
+    Histogram, ///< Records the distribution of individual samples, e.g. durations, in predefined buckets. Reported per frame.
+
+    Default = Counter
+  };
+};
+
+/// \brief Handle to a counter that was registered through ezMetrics::RegisterCounter().
+///
+/// Adding to a counter only writes to a slot of the calling thread, it never locks and never contends with other threads.
+class EZ_FOUNDATION_DLL ezMetricCounter
+{
+public:
+  /// \brief Adds \a iValue to the counter. Can be called from any thread at any frequency.
+  void Add(ezInt64 iValue = 1) const;
+
+  bool IsValid() const { return m_uiSlot != ezInvalidIndex; }
+
+private:
+  friend class ezMetrics;
+
+  ezUInt32 m_uiSlot = ezInvalidIndex;
+};
+
+/// \brief Handle to a gauge that was registered through ezMetrics::RegisterGauge().
+class EZ_FOUNDATION_DLL ezMetricGauge
+{
+public:
+  /// \brief Sets the value of the gauge. Can be called from any thread, the last value that was set before ezMetrics::Update() is reported.
+  void Set(double fValue) const;
+
+  bool IsValid() const { return m_pInfo != nullptr; }
+
+private:
+  friend class ezMetrics;
+
+  ezMetricInfo* m_pInfo = nullptr;
+};
+
+/// \brief Handle to a histogram that was registered through ezMetrics::RegisterHistogram().
+class EZ_FOUNDATION_DLL ezMetricHistogram
+{
+public:
+  /// \brief Adds one sample to the histogram. Can be called from any thread at any frequency.
+  void Record(double fValue) const;
+
+  bool IsValid() const { return m_pInfo != nullptr; }
+
+private:
+  friend class ezMetrics;
+
+  const ezMetricInfo* m_pInfo = nullptr;
+};
+
+/// \brief The aggregated state of one metric, as computed by the last call to ezMetrics::Update().
+struct EZ_FOUNDATION_DLL ezMetricSnapshot
+{
+  ezString m_sName;
+  ezEnum<ezMetricType> m_Type;
+
+  /// \brief Counters: the amount that was added during the last frame. Gauges: the current value. Histograms: the mean of the samples of the
+  /// last frame.
+  double m_fValue = 0.0;
+
+  /// \brief Counters: the sum of everything that was ever added. Histograms: the number of samples that were ever recorded.
+  ezInt64 m_iTotal = 0;
+
+  /// \brief Histograms only: the upper bound of each bucket, the last bucket has no upper bound.
+  ezHybridArray<double, 16> m_BucketUpperBounds;
+
+  /// \brief Histograms only: the number of samples of the last frame that fell into each bucket. Has one more entry than m_BucketUpperBounds.
+  ezHybridArray<ezUInt64, 16> m_BucketCounts;
+};
+
+/// \brief A registry of typed metrics that are cheap enough to be updated from hot code on any thread.
+///
+/// In contrast to ezStats, which is meant for values that change rarely, metrics are registered once up front, e.g. in a static variable,
+/// and then updated through their handle. Counters and histograms write into slots that belong to the calling thread, so updating them
+/// neither locks nor causes cache line contention. Gauges are a single atomic value.
+///
+/// Update() has to be called once per frame (ezGameApplicationBase does that). It sums up the slots of all threads and, unless disabled
+/// through SetExportToStats(), publishes the results through ezStats, which also makes them available through ezTelemetry and in
+/// ezInspector. Histograms are published as '<Name>/Count' and '<Name>/Mean'.
+class EZ_FOUNDATION_DLL ezMetrics
+{
+public:
+  /// \brief The maximum number of slots that all metrics together may use. A counter uses one slot, a histogram uses one slot per bucket
+  /// plus one.
+  static constexpr ezUInt32 MaxSlots = 1024;
+
+  /// \brief The maximum number of buckets of a histogram, including the last one without an upper bound.
+  static constexpr ezUInt32 MaxHistogramBuckets = 16;
+
+  /// \brief Registers a counter. Registering the same name again returns the existing counter.
+  ///
+  /// Returns an invalid handle if the name is already used by a metric of a different type or all slots are in use.
+  /// Adding to an invalid handle does nothing.
+  static ezMetricCounter RegisterCounter(const char* szName);
+
+  /// \brief Registers a gauge. Registering the same name again returns the existing gauge.
+  static ezMetricGauge RegisterGauge(const char* szName);
+
+  /// \brief Registers a histogram with the given bucket upper bounds, which must be sorted in ascending order.
+  ///
+  /// A sample goes into the first bucket whose upper bound is larger or equal, samples above the last bound go into an additional bucket.
+  /// Registering the same name again returns the existing histogram, the bucket bounds are not changed in that case.
+  static ezMetricHistogram RegisterHistogram(const char* szName, ezArrayPtr<const double> bucketUpperBounds);
+
+  /// \brief Aggregates all metrics and publishes them through ezStats. Should be called once per frame on the main thread.
+  static void Update();
+
+  /// \brief Returns the state of all metrics as of the last call to Update().
+  static void GetSnapshots(ezDynamicArray<ezMetricSnapshot>& out_Snapshots);
+
+  /// \brief Enables or disables publishing the metrics through ezStats in Update(). Enabled by default.
+  static void SetExportToStats(bool bEnable);
+
+  /// \brief Returns the number of slots that are used by all registered metrics.
+  static ezUInt32 GetNumUsedSlots();
+};
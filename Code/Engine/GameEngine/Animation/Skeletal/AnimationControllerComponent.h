@@ -5,11 +5,29 @@
 #include <Core/World/Component.h>
 #include <Core/World/ComponentManager.h>
 #include <RendererCore/AnimationSystem/AnimGraph/AnimGraph.h>
+#include <RendererCore/AnimationSystem/AnimationLod.h>
 
 using ezSkeletonResourceHandle = ezTypedResourceHandle<class ezSkeletonResource>;
 using ezAnimGraphResourceHandle = ezTypedResourceHandle<class ezAnimGraphResource>;
 
-using ezAnimationControllerComponentManager = ezComponentManagerSimple<class ezAnimationControllerComponent, ezComponentUpdateType::WhenSimulating, ezBlockStorageType::FreeList>;
+struct ezMsgExtractRenderData;
+
+class EZ_GAMEENGINE_DLL ezAnimationControllerComponentManager : public ezComponentManager<class ezAnimationControllerComponent, ezBlockStorageType::FreeList>
+{
+  using SUPER = ezComponentManager<class ezAnimationControllerComponent, ezBlockStorageType::FreeList>;
+
+public:
+  ezAnimationControllerComponentManager(ezWorld* pWorld);
+
+  virtual void Initialize() override;
+
+private:
+  /// \brief Steps the animation graphs and computes the blended poses. Runs in the async phase, distributed over the worker threads.
+  void UpdateAnimations(const ezWorldModule::UpdateContext& context);
+
+  /// \brief Broadcasts the poses and root motion that were computed during the async phase. Runs synchronously after the async phase.
+  void SendResults(const ezWorldModule::UpdateContext& context);
+};
 
 class EZ_GAMEENGINE_DLL ezAnimationControllerComponent : public ezComponent
 {
@@ -36,8 +54,14 @@ public:
   const char* GetAnimationControllerFile() const;      // [ property ]
 
 protected:
-  void Update();
+  void UpdateAnimation(); // called on a worker thread
+  void SendResult();      // called on the main thread
+  void OnMsgExtractRenderData(ezMsgExtractRenderData& msg) const; // [ msg handler ]
+  void OnMsgAnimationLodVisible(ezMsgAnimationLodVisible& msg);    // [ msg handler ]
 
   ezAnimGraphResourceHandle m_hAnimationController;
   ezAnimGraph m_AnimationGraph;
+  ezAnimationLod m_AnimationLod;
+  bool m_bPoseUpdated = false;
+  ezVec3 m_vRootMotionVelocity = ezVec3::ZeroVector();
 };
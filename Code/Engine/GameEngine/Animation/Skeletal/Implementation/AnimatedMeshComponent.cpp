@@ -145,7 +145,7 @@ ezMeshRenderData* ezAnimatedMeshComponent::CreateRenderData() const
   if (!m_SkinningSpacePose.IsEmpty())
   {
     // this copy is necessary for the multi-threaded renderer to not access m_SkinningSpacePose while we update it
-    ezArrayPtr<ezMat4> pRenderMatrices = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezMat4, m_SkinningSpacePose.GetTransformCount());
+    ezArrayPtr<ezMat4> pRenderMatrices = EZ_NEW_ARRAY(ezFrameAllocator::GetThreadAllocator(), ezMat4, m_SkinningSpacePose.GetTransformCount());
     pRenderMatrices.CopyFrom(m_SkinningSpacePose.m_Transforms);
 
     m_SkinningMatrices = pRenderMatrices;
@@ -8,6 +8,63 @@
 #include <Physics/CharacterControllerComponent.h>
 #include <RendererCore/AnimationSystem/AnimGraph/AnimGraphResource.h>
 #include <RendererCore/AnimationSystem/SkeletonResource.h>
+#include <RendererCore/Pipeline/RenderData.h>
+
+ezAnimationControllerComponentManager::ezAnimationControllerComponentManager(ezWorld* pWorld)
+  : SUPER(pWorld)
+{
+}
+
+void ezAnimationControllerComponentManager::Initialize()
+{
+  SUPER::Initialize();
+
+  {
+    auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezAnimationControllerComponentManager::UpdateAnimations, this);
+    desc.m_Phase = ezWorldModule::UpdateFunctionDesc::Phase::Async;
+    desc.m_bOnlyUpdateWhenSimulating = true;
+    desc.m_uiGranularity = 16;
+
+    this->RegisterUpdateFunction(desc);
+  }
+
+  {
+    auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezAnimationControllerComponentManager::SendResults, this);
+    desc.m_Phase = ezWorldModule::UpdateFunctionDesc::Phase::PostAsync;
+    desc.m_bOnlyUpdateWhenSimulating = true;
+
+    this->RegisterUpdateFunction(desc);
+  }
+}
+
+void ezAnimationControllerComponentManager::UpdateAnimations(const ezWorldModule::UpdateContext& context)
+{
+  for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+  {
+    ComponentType* pComponent = it;
+    if (pComponent->IsActiveAndInitialized())
+    {
+      pComponent->UpdateAnimation();
+    }
+  }
+}
+
+void ezAnimationControllerComponentManager::SendResults(const ezWorldModule::UpdateContext& context)
+{
+  const ezAnimationLodReference lodReference = ezAnimationLod::GetReference(GetWorld());
+
+  for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+  {
+    ComponentType* pComponent = it;
+    if (pComponent->IsActiveAndInitialized())
+    {
+      pComponent->SendResult();
+      pComponent->m_AnimationLod.UpdateLevel(lodReference, pComponent->GetOwner()->GetGlobalPosition());
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
 
 // clang-format off
 EZ_BEGIN_COMPONENT_TYPE(ezAnimationControllerComponent, 1, ezComponentMode::Static);
@@ -18,6 +75,13 @@ EZ_BEGIN_COMPONENT_TYPE(ezAnimationControllerComponent, 1, ezComponentMode::Stat
   }
   EZ_END_PROPERTIES;
 
+  EZ_BEGIN_MESSAGEHANDLERS
+  {
+    EZ_MESSAGE_HANDLER(ezMsgExtractRenderData, OnMsgExtractRenderData),
+    EZ_MESSAGE_HANDLER(ezMsgAnimationLodVisible, OnMsgAnimationLodVisible),
+  }
+  EZ_END_MESSAGEHANDLERS;
+
   EZ_BEGIN_ATTRIBUTES
   {
       new ezCategoryAttribute("Animation"),
@@ -89,6 +153,8 @@ void ezAnimationControllerComponent::OnSimulationStarted()
 
   m_AnimationGraph.m_hSkeleton = msg.m_hSkeleton;
 
+  m_AnimationLod.SetStaggerOffset(GetUniqueID());
+
   ezHashedString hs;
   hs.Assign("Idle");
   m_AnimationGraph.m_Blackboard.RegisterEntry(hs, 0.0f);
@@ -110,8 +176,29 @@ void ezAnimationControllerComponent::OnSimulationStarted()
   m_AnimationGraph.m_Blackboard.RegisterEntry(hs, 0.0f);
 }
 
-void ezAnimationControllerComponent::Update()
+void ezAnimationControllerComponent::UpdateAnimation()
 {
+  ezTime tDiff;
+  if (!m_AnimationLod.ShouldUpdate(GetWorld()->GetClock().GetTimeDiff(), tDiff))
+  {
+    if (m_AnimationLod.IsPaused())
+    {
+      // the pose is not advanced, so the character must not keep moving with the velocity of the last update either
+      m_vRootMotionVelocity.SetZero();
+      return;
+    }
+
+    if (!m_AnimationGraph.m_hSkeleton.IsValid())
+      return;
+
+    ezResourceLock<ezSkeletonResource> pSkeleton(m_AnimationGraph.m_hSkeleton, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+    if (pSkeleton.GetAcquireResult() != ezResourceAcquireResult::Final)
+      return;
+
+    m_bPoseUpdated = m_AnimationLod.InterpolatePose(pSkeleton->GetDescriptor().m_Skeleton.GetOzzSkeleton(), m_AnimationGraph.GetModelSpaceTransforms());
+    return;
+  }
+
   float fValue;
   bool bActive = false;
 
@@ -149,13 +236,37 @@ void ezAnimationControllerComponent::Update()
 
   m_AnimationGraph.m_Blackboard.SetEntryValue("Idle", bActive ? 0.0f : 1.0f);
 
-  m_AnimationGraph.Update(GetWorld()->GetClock().GetTimeDiff());
-  m_AnimationGraph.SendResultTo(GetOwner());
+  m_AnimationGraph.Update(tDiff);
 
-  const ezTime tDiff = GetWorld()->GetClock().GetTimeDiff();
-  const ezTime tInv = 1.0 / tDiff;
-  const ezVec3 vRootMotion = tInv.AsFloatInSeconds() * m_AnimationGraph.GetRootMotion();
+  if (m_AnimationGraph.m_hSkeleton.IsValid())
+  {
+    ezResourceLock<ezSkeletonResource> pSkeleton(m_AnimationGraph.m_hSkeleton, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+    if (pSkeleton.GetAcquireResult() == ezResourceAcquireResult::Final)
+    {
+      m_AnimationLod.SetComputedPose(pSkeleton->GetDescriptor().m_Skeleton.GetOzzSkeleton(), m_AnimationGraph.GetLocalTransforms(), m_AnimationGraph.GetModelSpaceTransforms());
+    }
+  }
+  m_bPoseUpdated = true;
 
+  // the root motion covers all frames since the last update, convert it to a velocity that is applied every frame
+  m_vRootMotionVelocity.SetZero();
+  if (tDiff.IsPositive())
+  {
+    m_vRootMotionVelocity = m_AnimationGraph.GetRootMotion() / tDiff.AsFloatInSeconds();
+  }
+}
+
+void ezAnimationControllerComponent::SendResult()
+{
+  if (m_bPoseUpdated)
+  {
+    m_bPoseUpdated = false;
+    m_AnimationGraph.SendResultTo(GetOwner());
+  }
+
+  const ezVec3 vRootMotion = m_vRootMotionVelocity;
+
+  float fValue;
   float fRotate = 0;
   ezInputManager::GetInputSlotState(ezInputSlot_Controller0_RightStick_NegX, &fValue);
   fRotate -= fValue;
@@ -181,4 +292,14 @@ void ezAnimationControllerComponent::Update()
   pOwner->SendMessage(msg);
 }
 
+void ezAnimationControllerComponent::OnMsgExtractRenderData(ezMsgExtractRenderData& msg) const
+{
+  ezAnimationLod::ReportVisible(*this);
+}
+
+void ezAnimationControllerComponent::OnMsgAnimationLodVisible(ezMsgAnimationLodVisible& msg)
+{
+  m_AnimationLod.SetVisible(msg);
+}
+
 EZ_STATICLINK_FILE(GameEngine, GameEngine_Animation_Skeletal_Implementation_AnimationControllerComponent);
@@ -5,6 +5,7 @@
 #include <GameEngine/Animation/Skeletal/SimpleAnimationComponent.h>
 #include <RendererCore/AnimationSystem/AnimationClipResource.h>
 #include <RendererCore/AnimationSystem/SkeletonResource.h>
+#include <RendererCore/Pipeline/RenderData.h>
 #include <ozz/animation/runtime/animation.h>
 #include <ozz/animation/runtime/local_to_model_job.h>
 #include <ozz/animation/runtime/sampling_job.h>
@@ -14,6 +15,62 @@ using namespace ozz;
 using namespace ozz::animation;
 using namespace ozz::math;
 
+ezSimpleAnimationComponentManager::ezSimpleAnimationComponentManager(ezWorld* pWorld)
+  : SUPER(pWorld)
+{
+}
+
+void ezSimpleAnimationComponentManager::Initialize()
+{
+  SUPER::Initialize();
+
+  {
+    auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezSimpleAnimationComponentManager::UpdateAnimations, this);
+    desc.m_Phase = ezWorldModule::UpdateFunctionDesc::Phase::Async;
+    desc.m_bOnlyUpdateWhenSimulating = true;
+    desc.m_uiGranularity = 32;
+
+    this->RegisterUpdateFunction(desc);
+  }
+
+  {
+    auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezSimpleAnimationComponentManager::SendPoses, this);
+    desc.m_Phase = ezWorldModule::UpdateFunctionDesc::Phase::PostAsync;
+    desc.m_bOnlyUpdateWhenSimulating = true;
+
+    this->RegisterUpdateFunction(desc);
+  }
+}
+
+void ezSimpleAnimationComponentManager::UpdateAnimations(const ezWorldModule::UpdateContext& context)
+{
+  for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+  {
+    ComponentType* pComponent = it;
+    if (pComponent->IsActiveAndInitialized())
+    {
+      pComponent->UpdateAnimation();
+    }
+  }
+}
+
+void ezSimpleAnimationComponentManager::SendPoses(const ezWorldModule::UpdateContext& context)
+{
+  const ezAnimationLodReference lodReference = ezAnimationLod::GetReference(GetWorld());
+
+  for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+  {
+    ComponentType* pComponent = it;
+    if (pComponent->IsActiveAndInitialized())
+    {
+      pComponent->SendPose();
+      pComponent->m_AnimationLod.UpdateLevel(lodReference, pComponent->GetOwner()->GetGlobalPosition());
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 // clang-format off
 EZ_BEGIN_COMPONENT_TYPE(ezSimpleAnimationComponent, 1, ezComponentMode::Static);
 {
@@ -25,6 +82,13 @@ EZ_BEGIN_COMPONENT_TYPE(ezSimpleAnimationComponent, 1, ezComponentMode::Static);
   }
   EZ_END_PROPERTIES;
 
+  EZ_BEGIN_MESSAGEHANDLERS
+  {
+    EZ_MESSAGE_HANDLER(ezMsgExtractRenderData, OnMsgExtractRenderData),
+    EZ_MESSAGE_HANDLER(ezMsgAnimationLodVisible, OnMsgAnimationLodVisible),
+  }
+  EZ_END_MESSAGEHANDLERS;
+
   EZ_BEGIN_ATTRIBUTES
   {
       new ezCategoryAttribute("Animation"),
@@ -66,6 +130,8 @@ void ezSimpleAnimationComponent::OnSimulationStarted()
   GetOwner()->SendMessage(msg);
 
   m_hSkeleton = msg.m_hSkeleton;
+
+  m_AnimationLod.SetStaggerOffset(GetUniqueID());
 }
 
 void ezSimpleAnimationComponent::SetAnimationClip(const ezAnimationClipResourceHandle& hResource)
@@ -106,14 +172,30 @@ void ezSimpleAnimationComponent::SetNormalizedPlaybackPosition(float fPosition)
   SetUserFlag(1, true);
 }
 
-void ezSimpleAnimationComponent::Update()
+void ezSimpleAnimationComponent::UpdateAnimation()
 {
+  m_bPoseUpdated = false;
+
   if (!m_hSkeleton.IsValid() || !m_hAnimationClip.IsValid())
     return;
 
   if (m_fSpeed == 0.0f && !GetUserFlag(1))
     return;
 
+  ezTime tDiff;
+  if (!m_AnimationLod.ShouldUpdate(GetWorld()->GetClock().GetTimeDiff(), tDiff))
+  {
+    if (m_AnimationLod.IsPaused())
+      return;
+
+    ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+    if (pSkeleton.GetAcquireResult() != ezResourceAcquireResult::Final)
+      return;
+
+    m_bPoseUpdated = m_AnimationLod.InterpolatePose(pSkeleton->GetDescriptor().m_Skeleton.GetOzzSkeleton(), m_ModelTransforms);
+    return;
+  }
+
   ezResourceLock<ezAnimationClipResource> pAnimation(m_hAnimationClip, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
   if (pAnimation.GetAcquireResult() != ezResourceAcquireResult::Final)
     return;
@@ -122,7 +204,7 @@ void ezSimpleAnimationComponent::Update()
 
   m_Duration = animDesc.GetDuration();
 
-  if (!UpdatePlaybackTime(GetWorld()->GetClock().GetTimeDiff()))
+  if (!UpdatePlaybackTime(tDiff))
     return;
 
   ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
@@ -138,41 +220,70 @@ void ezSimpleAnimationComponent::Update()
   if (uiNumSkeletonJoints != uiNumAnimatedJoints)
     return;
 
-  ezArrayPtr<ezMat4> pPoseMatrices = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezMat4, uiNumSkeletonJoints);
+  // the local transforms are only needed temporarily, so they are shared by all components that are updated on the same thread
+  static thread_local ozz::vector<ozz::math::SoaTransform> s_ozzLocalTransforms;
+  s_ozzLocalTransforms.resize(pOzzSkeleton->num_soa_joints());
 
   if (m_ozzSamplingCache.max_tracks() != uiNumAnimatedJoints)
   {
     m_ozzSamplingCache.Resize(uiNumAnimatedJoints);
-    m_ozzLocalTransforms.resize(pOzzSkeleton->num_soa_joints());
   }
 
+  m_ModelTransforms.SetCountUninitialized(uiNumSkeletonJoints);
+
   {
     ozz::animation::SamplingJob job;
     job.animation = pOzzAnimation;
     job.cache = &m_ozzSamplingCache;
     job.ratio = m_fNormalizedPlaybackPosition;
-    job.output = make_span(m_ozzLocalTransforms);
+    job.output = make_span(s_ozzLocalTransforms);
     job.Run();
   }
 
   {
     ozz::animation::LocalToModelJob job;
-    job.input = make_span(m_ozzLocalTransforms);
-    job.output = span<ozz::math::Float4x4>(reinterpret_cast<ozz::math::Float4x4*>(pPoseMatrices.GetPtr()), reinterpret_cast<ozz::math::Float4x4*>(pPoseMatrices.GetEndPtr()));
+    job.input = make_span(s_ozzLocalTransforms);
+    job.output = span<ozz::math::Float4x4>(reinterpret_cast<ozz::math::Float4x4*>(begin(m_ModelTransforms)), reinterpret_cast<ozz::math::Float4x4*>(end(m_ModelTransforms)));
     job.skeleton = pOzzSkeleton;
     job.Run();
   }
 
+  m_AnimationLod.SetComputedPose(*pOzzSkeleton, ezMakeArrayPtr(s_ozzLocalTransforms.data(), static_cast<ezUInt32>(s_ozzLocalTransforms.size())), m_ModelTransforms);
+
+  m_bPoseUpdated = true;
+}
+
+void ezSimpleAnimationComponent::SendPose()
+{
+  if (!m_bPoseUpdated)
+    return;
+
+  m_bPoseUpdated = false;
+
+  ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+  if (pSkeleton.GetAcquireResult() != ezResourceAcquireResult::Final)
+    return;
+
   // inform child nodes/components that a new pose is available
   {
     ezMsgAnimationPoseUpdated msg;
     msg.m_pSkeleton = &pSkeleton->GetDescriptor().m_Skeleton;
-    msg.m_ModelTransforms = pPoseMatrices;
+    msg.m_ModelTransforms = m_ModelTransforms;
 
     GetOwner()->SendMessageRecursive(msg);
   }
 }
 
+void ezSimpleAnimationComponent::OnMsgExtractRenderData(ezMsgExtractRenderData& msg) const
+{
+  ezAnimationLod::ReportVisible(*this);
+}
+
+void ezSimpleAnimationComponent::OnMsgAnimationLodVisible(ezMsgAnimationLodVisible& msg)
+{
+  m_AnimationLod.SetVisible(msg);
+}
+
 bool ezSimpleAnimationComponent::UpdatePlaybackTime(ezTime tDiff)
 {
   if (tDiff.IsZero() || m_fSpeed == 0.0f)
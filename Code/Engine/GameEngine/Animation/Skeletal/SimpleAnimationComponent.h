@@ -2,8 +2,10 @@
 
 #include <Core/ResourceManager/ResourceHandle.h>
 #include <Core/World/ComponentManager.h>
+#include <Foundation/Memory/AllocatorWrapper.h>
 #include <GameEngine/Animation/PropertyAnimResource.h>
 #include <GameEngine/Animation/Skeletal/AnimationControllerComponent.h>
+#include <RendererCore/AnimationSystem/AnimationLod.h>
 #include <RendererCore/AnimationSystem/AnimationPose.h>
 #include <ozz/animation/runtime/sampling_job.h>
 #include <ozz/base/containers/vector.h>
@@ -13,7 +15,24 @@
 using ezAnimationClipResourceHandle = ezTypedResourceHandle<class ezAnimationClipResource>;
 using ezSkeletonResourceHandle = ezTypedResourceHandle<class ezSkeletonResource>;
 
-using ezSimpleAnimationComponentManager = ezComponentManagerSimple<class ezSimpleAnimationComponent, ezComponentUpdateType::WhenSimulating, ezBlockStorageType::FreeList>;
+struct ezMsgExtractRenderData;
+
+class EZ_GAMEENGINE_DLL ezSimpleAnimationComponentManager : public ezComponentManager<class ezSimpleAnimationComponent, ezBlockStorageType::FreeList>
+{
+  using SUPER = ezComponentManager<class ezSimpleAnimationComponent, ezBlockStorageType::FreeList>;
+
+public:
+  ezSimpleAnimationComponentManager(ezWorld* pWorld);
+
+  virtual void Initialize() override;
+
+private:
+  /// \brief Samples the animation clips and computes the model space poses. Runs in the async phase, distributed over the worker threads.
+  void UpdateAnimations(const ezWorldModule::UpdateContext& context);
+
+  /// \brief Broadcasts the poses that were computed during the async phase. Runs synchronously after the async phase.
+  void SendPoses(const ezWorldModule::UpdateContext& context);
+};
 
 class EZ_GAMEENGINE_DLL ezSimpleAnimationComponent : public ezComponent
 {
@@ -49,8 +68,14 @@ public:
   float GetNormalizedPlaybackPosition() const { return m_fNormalizedPlaybackPosition; }
 
 protected:
-  void Update();
+  void UpdateAnimation(); // called on a worker thread
+  void SendPose();        // called on the main thread
   bool UpdatePlaybackTime(ezTime tDiff);
+  void OnMsgExtractRenderData(ezMsgExtractRenderData& msg) const; // [ msg handler ]
+  void OnMsgAnimationLodVisible(ezMsgAnimationLodVisible& msg);    // [ msg handler ]
+
+  bool m_bPoseUpdated = false;
+  ezAnimationLod m_AnimationLod;
 
   float m_fNormalizedPlaybackPosition = 0.0f;
   ezTime m_Duration;
@@ -58,5 +83,5 @@ protected:
   ezSkeletonResourceHandle m_hSkeleton;
 
   ozz::animation::SamplingCache m_ozzSamplingCache;
-  ozz::vector<ozz::math::SoaTransform> m_ozzLocalTransforms; // TODO: could be frame allocated
+  ezDynamicArray<ezMat4, ezAlignedAllocatorWrapper> m_ModelTransforms;
 };
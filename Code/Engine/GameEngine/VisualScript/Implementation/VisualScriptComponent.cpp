@@ -142,8 +142,20 @@ void ezVisualScriptComponent::Update()
     EnableUnhandledMessageHandler(true);
 
     m_Script = EZ_DEFAULT_NEW(ezVisualScriptInstance);
+  }
+
+  if (m_hResource.IsValid())
+  {
+    // a reloaded resource compiles a new program, the instance keeps executing the old one until it is configured again
+    bool bConfigure = m_Script->GetScriptResource() != m_hResource;
+
+    if (!bConfigure)
+    {
+      ezResourceLock<ezVisualScriptResource> pScript(m_hResource, ezResourceAcquireMode::PointerOnly);
+      bConfigure = m_Script->GetScriptChangeCounter() != pScript->GetCurrentResourceChangeCounter();
+    }
 
-    if (m_hResource.IsValid())
+    if (bConfigure)
     {
       m_Script->Configure(m_hResource, GetOwner());
     }
@@ -9,6 +9,7 @@
 #include <GameEngine/VisualScript/Nodes/VisualScriptMessageNodes.h>
 #include <GameEngine/VisualScript/VisualScriptInstance.h>
 #include <GameEngine/VisualScript/VisualScriptNode.h>
+#include <GameEngine/VisualScript/VisualScriptProgram.h>
 #include <GameEngine/VisualScript/VisualScriptResource.h>
 
 ezMap<ezVisualScriptInstance::AssignFuncKey, ezVisualScriptDataPinAssignFunc> ezVisualScriptInstance::s_DataPinAssignFunctions;
@@ -100,42 +101,19 @@ void ezVisualScriptInstance::Clear()
 
   m_pWorld = nullptr;
   m_Nodes.Clear();
-  m_ExecutionConnections.Clear();
-  m_DataConnections.Clear();
+  m_pProgram.Clear();
+  m_DataConnectionTargets.Clear();
   m_LocalVariables.Clear();
+  m_pMessageHandlers = nullptr;
   m_hScriptResource.Invalidate();
-}
-
-
-void ezVisualScriptInstance::ComputeNodeDependencies()
-{
-  m_NodeDependencies.SetCount(m_Nodes.GetCount());
-
-  for (auto it = m_DataConnections.GetIterator(); it.IsValid(); ++it)
-  {
-    const ezVisualScriptPinConnectionID src = it.Key();
-
-    const ezUInt16 uiSourceNode = (src >> 16) & 0xFFFF;
-
-    if (m_Nodes[uiSourceNode]->IsManuallyStepped())
-      continue;
-
-    const ezHybridArray<DataPinConnection, 2>& dst = it.Value();
-
-    for (const DataPinConnection& target : dst)
-    {
-      m_NodeDependencies[target.m_uiTargetNode].PushBack(uiSourceNode);
-    }
-  }
+  m_uiScriptChangeCounter = 0;
 }
 
 
 void ezVisualScriptInstance::ExecuteDependentNodes(ezUInt16 uiNode)
 {
-  const auto& dep = m_NodeDependencies[uiNode];
-  for (ezUInt32 i = 0; i < dep.GetCount(); ++i)
+  for (const ezUInt16 uiDependency : m_pProgram->GetDependencies(uiNode))
   {
-    const ezUInt16 uiDependency = dep[i];
     auto* pNode = m_Nodes[uiDependency];
 
     // recurse to the most dependent nodes first
@@ -154,9 +132,15 @@ void ezVisualScriptInstance::Configure(const ezVisualScriptResourceHandle& hScri
 
   ezResourceLock<ezVisualScriptResource> pScript(hScript, ezResourceAcquireMode::BlockTillLoaded);
   const auto& resource = pScript->GetDescriptor();
-  m_pMessageHandlers = &resource.m_MessageHandlers;
 
+  // an instance that failed to configure is not configured again until the resource changes
   m_hScriptResource = hScript;
+  m_uiScriptChangeCounter = pScript->GetCurrentResourceChangeCounter();
+
+  // the connections are compiled once per resource, only the addresses of the input pins differ between instances
+  ezSharedPtr<const ezVisualScriptProgram> pProgram = pScript->GetProgram();
+  if (pProgram == nullptr)
+    return;
 
   if (pOwner)
   {
@@ -174,44 +158,51 @@ void ezVisualScriptInstance::Configure(const ezVisualScriptResourceHandle& hScri
     {
       CreateFunctionCallNode(n, resource);
     }
-    else if (node.m_pType->IsDerivedFrom<ezMessage>())
+    else if (node.m_pType != nullptr && node.m_pType->IsDerivedFrom<ezMessage>() && (node.m_isMsgSender || node.m_isMsgHandler))
     {
       if (node.m_isMsgSender)
       {
         CreateFunctionMessageNode(n, resource);
       }
-      else if (node.m_isMsgHandler)
+      else
       {
         CreateEventMessageNode(n, resource);
       }
     }
-    else if (node.m_pType->IsDerivedFrom<ezVisualScriptNode>())
+    else if (node.m_pType != nullptr && node.m_pType->IsDerivedFrom<ezVisualScriptNode>())
     {
       CreateVisualScriptNode(n, resource);
     }
     else
     {
       ezLog::Error("Invalid node type '{0}' in visual script", node.m_sTypeName);
-      Clear();
-      return;
+      break;
     }
   }
 
-  m_ExecutionConnections.Reserve(resource.m_ExecutionPaths.GetCount());
-
-  for (const auto& con : resource.m_ExecutionPaths)
+  // the node indices of the program are used without further checks
+  if (m_Nodes.GetCount() != resource.m_Nodes.GetCount() || m_Nodes.GetCount() != pProgram->GetNodeCount())
   {
-    ConnectExecutionPins(con.m_uiSourceNode, con.m_uiOutputPin, con.m_uiTargetNode, con.m_uiInputPin);
+    const ezUInt32 uiChangeCounter = m_uiScriptChangeCounter;
+    Clear();
+
+    m_hScriptResource = hScript;
+    m_uiScriptChangeCounter = uiChangeCounter;
+    return;
   }
 
-  for (const auto& con : resource.m_DataPaths)
+  m_pProgram = pProgram;
+  m_pMessageHandlers = &m_pProgram->GetMessageHandlers();
+
+  const ezUInt32 uiNumDataConnections = m_pProgram->GetDataConnectionCount();
+  m_DataConnectionTargets.SetCountUninitialized(uiNumDataConnections);
+
+  for (ezUInt32 i = 0; i < uiNumDataConnections; ++i)
   {
-    ConnectDataPins(con.m_uiSourceNode, con.m_uiOutputPin, (ezVisualScriptDataPinType::Enum)con.m_uiOutputPinType, con.m_uiTargetNode,
-      con.m_uiInputPin, (ezVisualScriptDataPinType::Enum)con.m_uiInputPinType);
+    const auto& con = m_pProgram->GetDataConnection(i);
+    m_DataConnectionTargets[i] = m_Nodes[con.m_uiTargetNode]->GetInputPinDataPointer(con.m_uiTargetPin);
   }
 
-  ComputeNodeDependencies();
-
   // initialize local variables
   {
     for (const auto& p : resource.m_BoolParameters)
@@ -462,36 +453,21 @@ bool ezVisualScriptInstance::HandleMessage(ezMessage& msg)
   return bHandled;
 }
 
-void ezVisualScriptInstance::ConnectExecutionPins(ezUInt16 uiSourceNode, ezUInt8 uiOutputSlot, ezUInt16 uiTargetNode, ezUInt8 uiTargetPin)
-{
-  auto& con = m_ExecutionConnections[((ezUInt32)uiSourceNode << 16) | (ezUInt32)uiOutputSlot];
-  con.m_uiTargetNode = uiTargetNode;
-  con.m_uiTargetPin = uiTargetPin;
-}
-
-void ezVisualScriptInstance::ConnectDataPins(ezUInt16 uiSourceNode, ezUInt8 uiSourcePin, ezVisualScriptDataPinType::Enum sourcePinType,
-  ezUInt16 uiTargetNode, ezUInt8 uiTargetPin, ezVisualScriptDataPinType::Enum targetPinType)
-{
-  DataPinConnection& con = m_DataConnections[((ezUInt32)uiSourceNode << 16) | (ezUInt32)uiSourcePin].ExpandAndGetRef();
-  con.m_uiTargetNode = uiTargetNode;
-  con.m_uiTargetPin = uiTargetPin;
-  con.m_pTargetData = m_Nodes[uiTargetNode]->GetInputPinDataPointer(uiTargetPin);
-  con.m_AssignFunc = FindDataPinAssignFunction(sourcePinType, targetPinType);
-}
-
 void ezVisualScriptInstance::SetOutputPinValue(const ezVisualScriptNode* pNode, ezUInt8 uiPin, const void* pValue)
 {
   const ezUInt32 uiConnectionID = ((ezUInt32)pNode->m_uiNodeID << 16) | (ezUInt32)uiPin;
 
-  ezHybridArray<DataPinConnection, 2>* TargetNodeAndPins;
-  if (!m_DataConnections.TryGetValue(uiConnectionID, TargetNodeAndPins))
+  const ezVisualScriptProgram::DataPinRange range = m_pProgram->GetDataConnections(pNode->m_uiNodeID, uiPin);
+  if (range.m_uiCount == 0)
     return;
 
-  for (const DataPinConnection& TargetNodeAndPin : *TargetNodeAndPins)
+  for (ezUInt32 i = range.m_uiFirst; i < range.m_uiFirst + range.m_uiCount; ++i)
   {
+    const ezVisualScriptProgram::DataPinConnection& TargetNodeAndPin = m_pProgram->GetDataConnection(i);
+
     if (TargetNodeAndPin.m_AssignFunc)
     {
-      if (TargetNodeAndPin.m_AssignFunc(pValue, TargetNodeAndPin.m_pTargetData))
+      if (TargetNodeAndPin.m_AssignFunc(pValue, m_DataConnectionTargets[i]))
       {
         m_Nodes[TargetNodeAndPin.m_uiTargetNode]->m_bInputValuesChanged = true;
       }
@@ -513,15 +489,15 @@ Override ezVisualScriptNode::IsManuallyStepped() for type '{}' if necessary.",
 
   const ezUInt32 uiConnectionID = ((ezUInt32)pNode->m_uiNodeID << 16) | (ezUInt32)uiNthTarget;
 
-  ExecPinConnection TargetNode;
-  if (!m_ExecutionConnections.TryGetValue(uiConnectionID, TargetNode))
+  const ezVisualScriptProgram::ExecPinConnection* pTarget = m_pProgram->GetExecConnection(pNode->m_uiNodeID, uiNthTarget);
+  if (pTarget == nullptr)
     return;
 
-  auto* pTargetNode = m_Nodes[TargetNode.m_uiTargetNode];
+  auto* pTargetNode = m_Nodes[pTarget->m_uiTargetNode];
 
-  ExecuteDependentNodes(TargetNode.m_uiTargetNode);
+  ExecuteDependentNodes(pTarget->m_uiTargetNode);
 
-  pTargetNode->Execute(this, TargetNode.m_uiTargetPin);
+  pTargetNode->Execute(this, pTarget->m_uiTargetPin);
   pTargetNode->m_bInputValuesChanged = false;
 
   if (m_pActivity != nullptr)
@@ -0,0 +1,215 @@
+#include <GameEnginePCH.h>
+
+#include <GameEngine/VisualScript/VisualScriptInstance.h>
+#include <GameEngine/VisualScript/VisualScriptProgram.h>
+#include <GameEngine/VisualScript/VisualScriptResource.h>
+
+namespace
+{
+  bool IsNodeTypeManuallyStepped(const ezRTTI* pType)
+  {
+    // the virtual function needs an object, the node is only created temporarily once per resource
+    ezVisualScriptNode* pNode = pType->GetAllocator()->Allocate<ezVisualScriptNode>();
+    const bool bManuallyStepped = pNode->IsManuallyStepped();
+    pType->GetAllocator()->Deallocate(pNode);
+
+    return bManuallyStepped;
+  }
+
+  template <typename Connection>
+  void RemoveInvalidConnections(ezDynamicArray<Connection>& ref_connections, ezUInt32 uiNumNodes)
+  {
+    for (ezUInt32 i = ref_connections.GetCount(); i > 0; --i)
+    {
+      const Connection& con = ref_connections[i - 1];
+      if (con.m_uiSourceNode >= uiNumNodes || con.m_uiTargetNode >= uiNumNodes)
+      {
+        ezLog::Error("Visual script connection from node {0} to node {1} is invalid, the script only has {2} nodes", con.m_uiSourceNode,
+          con.m_uiTargetNode, uiNumNodes);
+        ref_connections.RemoveAtAndCopy(i - 1);
+      }
+    }
+  }
+} // namespace
+
+void ezVisualScriptProgram::Compile(const ezVisualScriptResourceDescriptor& descriptor)
+{
+  Clear();
+
+  ezVisualScriptInstance::SetupPinDataTypeConversions();
+
+  const ezUInt32 uiNumNodes = descriptor.m_Nodes.GetCount();
+  EZ_ASSERT_DEV(uiNumNodes < InvalidNode, "Max supported node index is 16 bit.");
+
+  m_Nodes.SetCount(uiNumNodes);
+  m_MessageHandlers = descriptor.m_MessageHandlers;
+
+  // every index that is stored in the program is used by the instances without further checks
+  ezDynamicArray<ezVisualScriptResourceDescriptor::ExecutionConnection> executionPaths = descriptor.m_ExecutionPaths;
+  ezDynamicArray<ezVisualScriptResourceDescriptor::DataConnection> dataPaths = descriptor.m_DataPaths;
+  RemoveInvalidConnections(executionPaths, uiNumNodes);
+  RemoveInvalidConnections(dataPaths, uiNumNodes);
+
+  for (ezUInt32 i = m_MessageHandlers.GetCount(); i > 0; --i)
+  {
+    if (m_MessageHandlers.GetValue(i - 1) >= uiNumNodes)
+    {
+      m_MessageHandlers.RemoveAtAndCopy(i - 1, true);
+    }
+  }
+
+  // nodes with execution pins are only executed through them, all others are pulled in by the nodes that read their output
+  {
+    ezMap<const ezRTTI*, bool> typeIsManuallyStepped;
+
+    for (ezUInt32 n = 0; n < uiNumNodes; ++n)
+    {
+      const auto& node = descriptor.m_Nodes[n];
+
+      if (node.m_isFunctionCall || node.m_isMsgSender || node.m_isMsgHandler)
+      {
+        m_Nodes[n].m_bManuallyStepped = true;
+      }
+      else if (node.m_pType != nullptr && node.m_pType->IsDerivedFrom<ezVisualScriptNode>())
+      {
+        bool bExisted = false;
+        auto it = typeIsManuallyStepped.FindOrAdd(node.m_pType, &bExisted);
+        if (!bExisted)
+        {
+          it.Value() = IsNodeTypeManuallyStepped(node.m_pType);
+        }
+
+        m_Nodes[n].m_bManuallyStepped = it.Value();
+      }
+      else
+      {
+        // invalid nodes are never executed, the instance refuses to configure itself anyway
+        m_Nodes[n].m_bManuallyStepped = true;
+      }
+    }
+  }
+
+  // count the output pins of every node
+  for (const auto& con : executionPaths)
+  {
+    Node& node = m_Nodes[con.m_uiSourceNode];
+    node.m_uiNumExecOutputs = ezMath::Max<ezUInt16>(node.m_uiNumExecOutputs, con.m_uiOutputPin + 1);
+  }
+
+  for (const auto& con : dataPaths)
+  {
+    Node& node = m_Nodes[con.m_uiSourceNode];
+    node.m_uiNumDataOutputs = ezMath::Max<ezUInt16>(node.m_uiNumDataOutputs, con.m_uiOutputPin + 1);
+  }
+
+  ezUInt32 uiNumExecOutputs = 0;
+  ezUInt32 uiNumDataOutputs = 0;
+  for (Node& node : m_Nodes)
+  {
+    node.m_uiFirstExecOutput = uiNumExecOutputs;
+    node.m_uiFirstDataOutput = uiNumDataOutputs;
+    uiNumExecOutputs += node.m_uiNumExecOutputs;
+    uiNumDataOutputs += node.m_uiNumDataOutputs;
+  }
+
+  // execution pins have at most one target
+  {
+    m_ExecConnections.SetCountUninitialized(uiNumExecOutputs);
+    for (auto& con : m_ExecConnections)
+    {
+      con.m_uiTargetNode = InvalidNode;
+      con.m_uiTargetPin = 0;
+    }
+
+    for (const auto& con : executionPaths)
+    {
+      auto& target = m_ExecConnections[m_Nodes[con.m_uiSourceNode].m_uiFirstExecOutput + con.m_uiOutputPin];
+      target.m_uiTargetNode = con.m_uiTargetNode;
+      target.m_uiTargetPin = con.m_uiInputPin;
+    }
+  }
+
+  // data pins can have any number of targets, store them consecutively per pin
+  {
+    m_DataOutputs.SetCount(uiNumDataOutputs);
+
+    for (const auto& con : dataPaths)
+    {
+      ++m_DataOutputs[m_Nodes[con.m_uiSourceNode].m_uiFirstDataOutput + con.m_uiOutputPin].m_uiCount;
+    }
+
+    ezUInt32 uiFirst = 0;
+    for (DataPinRange& range : m_DataOutputs)
+    {
+      range.m_uiFirst = uiFirst;
+      uiFirst += range.m_uiCount;
+      range.m_uiCount = 0;
+    }
+
+    m_DataConnections.SetCountUninitialized(dataPaths.GetCount());
+
+    for (const auto& con : dataPaths)
+    {
+      DataPinRange& range = m_DataOutputs[m_Nodes[con.m_uiSourceNode].m_uiFirstDataOutput + con.m_uiOutputPin];
+
+      DataPinConnection& target = m_DataConnections[range.m_uiFirst + range.m_uiCount];
+      target.m_uiTargetNode = con.m_uiTargetNode;
+      target.m_uiTargetPin = con.m_uiInputPin;
+      target.m_AssignFunc = ezVisualScriptInstance::FindDataPinAssignFunction(
+        (ezVisualScriptDataPinType::Enum)con.m_uiOutputPinType, (ezVisualScriptDataPinType::Enum)con.m_uiInputPinType);
+
+      ++range.m_uiCount;
+    }
+  }
+
+  // every node depends on the implicitly executed nodes that write to its input pins
+  {
+    for (const auto& con : dataPaths)
+    {
+      if (!m_Nodes[con.m_uiSourceNode].m_bManuallyStepped)
+      {
+        ++m_Nodes[con.m_uiTargetNode].m_uiNumDependencies;
+      }
+    }
+
+    ezUInt32 uiNumDependencies = 0;
+    for (Node& node : m_Nodes)
+    {
+      node.m_uiFirstDependency = uiNumDependencies;
+      uiNumDependencies += node.m_uiNumDependencies;
+      node.m_uiNumDependencies = 0;
+    }
+
+    m_Dependencies.SetCountUninitialized(uiNumDependencies);
+
+    for (const auto& con : dataPaths)
+    {
+      if (!m_Nodes[con.m_uiSourceNode].m_bManuallyStepped)
+      {
+        Node& target = m_Nodes[con.m_uiTargetNode];
+        m_Dependencies[target.m_uiFirstDependency + target.m_uiNumDependencies] = con.m_uiSourceNode;
+        ++target.m_uiNumDependencies;
+      }
+    }
+  }
+}
+
+void ezVisualScriptProgram::Clear()
+{
+  m_Nodes.Clear();
+  m_ExecConnections.Clear();
+  m_DataOutputs.Clear();
+  m_DataConnections.Clear();
+  m_Dependencies.Clear();
+  m_MessageHandlers.Clear();
+}
+
+ezUInt64 ezVisualScriptProgram::GetHeapMemoryUsage() const
+{
+  return m_Nodes.GetHeapMemoryUsage() + m_ExecConnections.GetHeapMemoryUsage() + m_DataOutputs.GetHeapMemoryUsage() +
+         m_DataConnections.GetHeapMemoryUsage() + m_Dependencies.GetHeapMemoryUsage() + m_MessageHandlers.GetHeapMemoryUsage();
+}
+
+
+
+EZ_STATICLINK_FILE(GameEngine, GameEngine_VisualScript_Implementation_VisualScriptProgram);
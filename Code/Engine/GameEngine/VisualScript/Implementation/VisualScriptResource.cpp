@@ -27,6 +27,8 @@ ezVisualScriptResource::~ezVisualScriptResource() = default;
 
 ezResourceLoadDesc ezVisualScriptResource::UnloadData(Unload WhatToUnload)
 {
+  m_pProgram.Clear();
+
   ezResourceLoadDesc res;
   res.m_uiQualityLevelsDiscardable = 0;
   res.m_uiQualityLevelsLoadable = 0;
@@ -57,6 +59,7 @@ ezResourceLoadDesc ezVisualScriptResource::UpdateContent(ezStreamReader* Stream)
   AssetHash.Read(*Stream).IgnoreResult();
 
   m_Descriptor.Load(*Stream);
+  CompileProgram();
 
   res.m_State = ezResourceState::Loaded;
   return res;
@@ -65,12 +68,28 @@ ezResourceLoadDesc ezVisualScriptResource::UpdateContent(ezStreamReader* Stream)
 void ezVisualScriptResource::UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage)
 {
   out_NewMemoryUsage.m_uiMemoryCPU = sizeof(ezVisualScriptResourceDescriptor);
+
+  if (m_pProgram != nullptr)
+  {
+    out_NewMemoryUsage.m_uiMemoryCPU += sizeof(ezVisualScriptProgram) + m_pProgram->GetHeapMemoryUsage();
+  }
+
   out_NewMemoryUsage.m_uiMemoryGPU = 0;
 }
 
+void ezVisualScriptResource::CompileProgram()
+{
+  // instances may still execute the previous program, so it must not be modified
+  ezSharedPtr<ezVisualScriptProgram> pProgram = EZ_DEFAULT_NEW(ezVisualScriptProgram);
+  pProgram->Compile(m_Descriptor);
+
+  m_pProgram = pProgram;
+}
+
 EZ_RESOURCE_IMPLEMENT_CREATEABLE(ezVisualScriptResource, ezVisualScriptResourceDescriptor)
 {
   m_Descriptor = descriptor;
+  CompileProgram();
 
   ezResourceLoadDesc res;
   res.m_uiQualityLevelsDiscardable = 0;
@@ -297,6 +316,8 @@ void ezVisualScriptResourceDescriptor::Save(ezStreamWriter& stream) const
 
 void ezVisualScriptResourceDescriptor::PrecomputeMessageHandlers()
 {
+  m_MessageHandlers.Clear();
+
   for (ezUInt32 uiNode = 0; uiNode < m_Nodes.GetCount(); ++uiNode)
   {
     auto& node = m_Nodes[uiNode];
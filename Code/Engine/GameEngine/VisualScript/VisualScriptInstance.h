@@ -7,6 +7,7 @@
 #include <Foundation/Containers/HashTable.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Containers/Map.h>
+#include <Foundation/Types/SharedPtr.h>
 #include <Foundation/Types/Variant.h>
 #include <GameEngine/GameEngineDLL.h>
 #include <GameEngine/VisualScript/VisualScriptNode.h>
@@ -16,6 +17,7 @@ class ezMessage;
 struct ezVisualScriptResourceDescriptor;
 class ezGameObject;
 class ezWorld;
+class ezVisualScriptProgram;
 struct ezVisualScriptInstanceActivity;
 struct ezEventMessage;
 
@@ -23,8 +25,6 @@ typedef ezUInt32 ezVisualScriptNodeConnectionID;
 typedef ezUInt32 ezVisualScriptPinConnectionID;
 typedef ezTypedResourceHandle<class ezVisualScriptResource> ezVisualScriptResourceHandle;
 
-typedef bool (*ezVisualScriptDataPinAssignFunc)(const void* src, void* dst);
-
 /// \brief An instance of a visual script resource. Stores the current script state and executes nodes.
 class EZ_GAMEENGINE_DLL ezVisualScriptInstance
 {
@@ -35,6 +35,14 @@ public:
   /// \brief Clears the current state and recreates the script instance from the given template.
   void Configure(const ezVisualScriptResourceHandle& hScript, ezGameObject* pOwner);
 
+  /// \brief Returns the script resource that was passed to Configure().
+  const ezVisualScriptResourceHandle& GetScriptResource() const { return m_hScriptResource; }
+
+  /// \brief Returns the change counter of the script resource at the time Configure() was called.
+  ///
+  /// When the resource was reloaded since, the instance still executes the old program and has to be configured again to pick up the changes.
+  ezUInt32 GetScriptChangeCounter() const { return m_uiScriptChangeCounter; }
+
   /// \brief Runs all nodes that are marked for execution. Typically nodes that handle events will mark themselves for execution in the next update.
   void ExecuteScript(ezVisualScriptInstanceActivity* pActivity = nullptr);
 
@@ -75,13 +83,8 @@ private:
   friend class ezVisualScriptNode;
 
   void Clear();
-  void ComputeNodeDependencies();
   void ExecuteDependentNodes(ezUInt16 uiNode);
 
-  void ConnectExecutionPins(ezUInt16 uiSourceNode, ezUInt8 uiOutputSlot, ezUInt16 uiTargetNode, ezUInt8 uiTargetPin);
-  void ConnectDataPins(ezUInt16 uiSourceNode, ezUInt8 uiSourcePin, ezVisualScriptDataPinType::Enum sourcePinType, ezUInt16 uiTargetNode,
-    ezUInt8 uiTargetPin, ezVisualScriptDataPinType::Enum targetPinType);
-
   void CreateVisualScriptNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource);
   void CreateFunctionMessageNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource);
   void CreateEventMessageNode(ezUInt32 uiNodeIdx, const ezVisualScriptResourceDescriptor& resource);
@@ -89,31 +92,18 @@ private:
   ezAbstractFunctionProperty* SearchForScriptableFunctionOnType(
     const ezRTTI* pObjectType, ezStringView sFuncName, const ezScriptableFunctionAttribute*& out_pSfAttr) const;
 
-  struct DataPinConnection
-  {
-    EZ_DECLARE_POD_TYPE();
-
-    ezUInt16 m_uiTargetNode;
-    ezUInt8 m_uiTargetPin;
-    ezVisualScriptDataPinAssignFunc m_AssignFunc = nullptr;
-    void* m_pTargetData = nullptr;
-  };
-
-  struct ExecPinConnection
-  {
-    EZ_DECLARE_POD_TYPE();
-
-    ezUInt16 m_uiTargetNode;
-    ezUInt8 m_uiTargetPin;
-  };
-
   ezVisualScriptResourceHandle m_hScriptResource;
+  ezUInt32 m_uiScriptChangeCounter = 0;
   ezGameObjectHandle m_hOwner;
   ezWorld* m_pWorld = nullptr;
   ezDynamicArray<ezVisualScriptNode*> m_Nodes;
-  ezDynamicArray<ezHybridArray<ezUInt16, 2>> m_NodeDependencies;
-  ezHashTable<ezVisualScriptNodeConnectionID, ExecPinConnection> m_ExecutionConnections;
-  ezHashTable<ezVisualScriptPinConnectionID, ezHybridArray<DataPinConnection, 2>> m_DataConnections;
+
+  /// The connections are shared by all instances of the resource, only the node state and the input pin addresses are per instance.
+  /// The reference keeps the program alive when the resource is reloaded while the instance is in use.
+  ezSharedPtr<const ezVisualScriptProgram> m_pProgram;
+  /// The input pin address of the node for each data connection of the program, in the same order.
+  ezDynamicArray<void*> m_DataConnectionTargets;
+
   ezStateMap m_LocalVariables;
   ezVisualScriptInstanceActivity* m_pActivity = nullptr;
   const ezArrayMap<ezMessageId, ezUInt16>* m_pMessageHandlers = nullptr;
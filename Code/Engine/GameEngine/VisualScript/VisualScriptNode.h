@@ -145,6 +145,9 @@ struct EZ_GAMEENGINE_DLL ezVisualScriptDataPinType
 
 EZ_DECLARE_REFLECTABLE_TYPE(EZ_GAMEENGINE_DLL, ezVisualScriptDataPinType);
 
+/// \brief Copies a data pin value of one ezVisualScriptDataPinType to another and returns whether the target value changed.
+typedef bool (*ezVisualScriptDataPinAssignFunc)(const void* src, void* dst);
+
 class EZ_GAMEENGINE_DLL ezVisScriptDataPinInAttribute : public ezPropertyAttribute
 {
   EZ_ADD_DYNAMIC_REFLECTION(ezVisScriptDataPinInAttribute, ezPropertyAttribute);
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <Foundation/Containers/ArrayMap.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Types/RefCounted.h>
+#include <GameEngine/GameEngineDLL.h>
+#include <GameEngine/VisualScript/VisualScriptNode.h>
+
+struct ezVisualScriptResourceDescriptor;
+
+/// \brief The connections of a visual script resource, compiled into flat arrays that are shared by all instances of the resource.
+///
+/// Pins are found by indexing instead of hashing, the data pin assign functions and the implicitly executed dependencies of every node are
+/// resolved once when the resource is loaded. An ezVisualScriptInstance only needs to store its nodes and the input pin addresses of the data
+/// connections.
+///
+/// The program is never modified after it was compiled. A reloaded resource compiles a new program, instances keep a reference to the one they
+/// were configured with until they are configured again.
+class EZ_GAMEENGINE_DLL ezVisualScriptProgram : public ezRefCounted
+{
+public:
+  struct ExecPinConnection
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt16 m_uiTargetNode;
+    ezUInt8 m_uiTargetPin;
+  };
+
+  struct DataPinConnection
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt16 m_uiTargetNode;
+    ezUInt8 m_uiTargetPin;
+    ezVisualScriptDataPinAssignFunc m_AssignFunc;
+  };
+
+  /// \brief A range in the array of data connections, all connections of one output pin are stored consecutively.
+  struct DataPinRange
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiFirst = 0;
+    ezUInt32 m_uiCount = 0;
+  };
+
+  static constexpr ezUInt16 InvalidNode = 0xFFFF;
+
+  void Compile(const ezVisualScriptResourceDescriptor& descriptor);
+  void Clear();
+
+  EZ_ALWAYS_INLINE ezUInt32 GetNodeCount() const { return m_Nodes.GetCount(); }
+
+  /// \brief Returns whether the node has execution pins. All other nodes are executed on demand, before the nodes that depend on their output.
+  EZ_ALWAYS_INLINE bool IsManuallyStepped(ezUInt16 uiNode) const { return m_Nodes[uiNode].m_bManuallyStepped; }
+
+  /// \brief Returns the connection of the given output execution pin or nullptr if the pin is not connected.
+  EZ_ALWAYS_INLINE const ExecPinConnection* GetExecConnection(ezUInt16 uiNode, ezUInt16 uiPin) const
+  {
+    const Node& node = m_Nodes[uiNode];
+    if (uiPin >= node.m_uiNumExecOutputs)
+      return nullptr;
+
+    const ExecPinConnection& con = m_ExecConnections[node.m_uiFirstExecOutput + uiPin];
+    return con.m_uiTargetNode != InvalidNode ? &con : nullptr;
+  }
+
+  /// \brief Returns the range of data connections of the given output data pin. The count is zero if the pin is not connected.
+  EZ_ALWAYS_INLINE DataPinRange GetDataConnections(ezUInt16 uiNode, ezUInt8 uiPin) const
+  {
+    const Node& node = m_Nodes[uiNode];
+    if (uiPin >= node.m_uiNumDataOutputs)
+      return DataPinRange{0, 0};
+
+    return m_DataOutputs[node.m_uiFirstDataOutput + uiPin];
+  }
+
+  EZ_ALWAYS_INLINE const DataPinConnection& GetDataConnection(ezUInt32 uiIndex) const { return m_DataConnections[uiIndex]; }
+
+  EZ_ALWAYS_INLINE ezUInt32 GetDataConnectionCount() const { return m_DataConnections.GetCount(); }
+
+  /// \brief Returns the nodes that handle each message type, sorted by message id.
+  EZ_ALWAYS_INLINE const ezArrayMap<ezMessageId, ezUInt16>& GetMessageHandlers() const { return m_MessageHandlers; }
+
+  /// \brief Returns the nodes that have to be executed before the given node, because it reads their output.
+  EZ_ALWAYS_INLINE ezArrayPtr<const ezUInt16> GetDependencies(ezUInt16 uiNode) const
+  {
+    const Node& node = m_Nodes[uiNode];
+    return m_Dependencies.GetArrayPtr().GetSubArray(node.m_uiFirstDependency, node.m_uiNumDependencies);
+  }
+
+  ezUInt64 GetHeapMemoryUsage() const;
+
+private:
+  struct Node
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiFirstExecOutput = 0;
+    ezUInt32 m_uiFirstDataOutput = 0;
+    ezUInt32 m_uiFirstDependency = 0;
+    ezUInt16 m_uiNumExecOutputs = 0;
+    ezUInt16 m_uiNumDataOutputs = 0;
+    ezUInt16 m_uiNumDependencies = 0;
+    bool m_bManuallyStepped = false;
+  };
+
+  ezDynamicArray<Node> m_Nodes;
+  ezDynamicArray<ExecPinConnection> m_ExecConnections;
+  ezDynamicArray<DataPinRange> m_DataOutputs;
+  ezDynamicArray<DataPinConnection> m_DataConnections;
+  ezDynamicArray<ezUInt16> m_Dependencies;
+  ezArrayMap<ezMessageId, ezUInt16> m_MessageHandlers;
+};
@@ -3,7 +3,9 @@
 #include <Core/ResourceManager/Resource.h>
 #include <Foundation/Containers/ArrayMap.h>
 #include <Foundation/Reflection/Reflection.h>
+#include <Foundation/Types/SharedPtr.h>
 #include <GameEngine/GameEngineDLL.h>
+#include <GameEngine/VisualScript/VisualScriptProgram.h>
 
 typedef ezTypedResourceHandle<class ezVisualScriptResource> ezVisualScriptResourceHandle;
 
@@ -95,11 +97,19 @@ public:
 
   const ezVisualScriptResourceDescriptor& GetDescriptor() const { return m_Descriptor; }
 
+  /// \brief Returns the connections of the script in the form that is shared by all ezVisualScriptInstance objects.
+  ///
+  /// Reloading the resource replaces the program instead of modifying it, instances keep the one they were configured with alive.
+  const ezSharedPtr<const ezVisualScriptProgram>& GetProgram() const { return m_pProgram; }
+
 private:
   virtual ezResourceLoadDesc UnloadData(Unload WhatToUnload) override;
   virtual ezResourceLoadDesc UpdateContent(ezStreamReader* Stream) override;
   virtual void UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage) override;
 
+  void CompileProgram();
+
 private:
   ezVisualScriptResourceDescriptor m_Descriptor;
+  ezSharedPtr<const ezVisualScriptProgram> m_pProgram;
 };
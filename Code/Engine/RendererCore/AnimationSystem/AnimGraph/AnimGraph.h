@@ -42,10 +42,19 @@ public:
   ezAnimGraph();
   ~ezAnimGraph();
 
+  /// \brief Steps all nodes and computes the blended model space pose. Does not access the world, so it may be called from a worker thread.
   void Update(ezTime tDiff);
+
+  /// \brief Broadcasts the pose computed in Update() as ezMsgAnimationPoseUpdated. Must be called from the thread that has write access to the world.
   void SendResultTo(ezGameObject* pObject);
   const ezVec3& GetRootMotion() const { return m_vRootMotion; }
 
+  /// \brief Gives access to the model space pose computed by the last Update(), e.g. to interpolate it between updates.
+  ezArrayPtr<ezMat4> GetModelSpaceTransforms() { return m_ModelSpaceTransforms; }
+
+  /// \brief Gives access to the local space pose computed by the last Update(), from which the model space pose was computed.
+  ezArrayPtr<const ozz::math::SoaTransform> GetLocalTransforms() const { return ezMakeArrayPtr(m_ozzLocalTransforms.data(), static_cast<ezUInt32>(m_ozzLocalTransforms.size())); }
+
   ezDynamicArray<ezUniquePtr<ezAnimGraphNode>> m_Nodes;
 
   ezSkeletonResourceHandle m_hSkeleton;
@@ -43,7 +43,10 @@ void ezAnimGraph::Update(ezTime tDiff)
     job.Run();
   }
 
+  // compute the model space pose right away, while the skeleton is locked anyway
+  // this way all the expensive work happens in Update(), which may run on a worker thread, and SendResultTo() only broadcasts the result
   m_bFinalized = false;
+  Finalize(pSkeleton.GetPointer());
 }
 
 void ezAnimGraph::Finalize(const ezSkeletonResource* pSkeleton)
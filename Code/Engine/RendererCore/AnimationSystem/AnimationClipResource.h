@@ -31,6 +31,7 @@ public:
   ezTime GetDuration() const;
   void SetDuration(ezTime duration);
 
+  /// \brief Returns the animation remapped to the joint order of the given skeleton. Thread-safe.
   const ozz::animation::Animation& GetMappedOzzAnimation(const ezSkeletonResource& skeleton) const;
 
   struct JointInfo
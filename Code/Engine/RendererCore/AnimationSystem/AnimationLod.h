@@ -0,0 +1,126 @@
+#pragma once
+
+#include <RendererCore/RendererCoreDLL.h>
+
+#include <Foundation/Communication/Message.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Math/Mat4.h>
+#include <Foundation/Memory/AllocatorWrapper.h>
+#include <Foundation/Time/Time.h>
+#include <Foundation/Types/Enum.h>
+#include <ozz/base/maths/soa_transform.h>
+
+class ezComponent;
+class ezWorld;
+
+namespace ozz::animation
+{
+  class Skeleton;
+}
+
+EZ_DEFINE_AS_POD_TYPE(ozz::math::SoaTransform);
+
+/// \brief The level of detail at which an animated skeleton gets updated.
+struct ezAnimationLodLevel
+{
+  using StorageType = ezUInt8;
+
+  enum Enum
+  {
+    Full,      ///< Close to the main view, the pose is computed every frame.
+    Reduced,   ///< The pose is computed every 'a_LodInterval1' frames and interpolated in between.
+    Low,       ///< The pose is computed every 'a_LodInterval2' frames and interpolated in between.
+    Invisible, ///< Not rendered in any view recently, the pose is not updated at all.
+
+    COUNT,
+    Default = Full
+  };
+};
+
+/// \brief The position from which animation LODs are computed. Look it up once per frame with ezAnimationLod::GetReference().
+struct ezAnimationLodReference
+{
+  bool m_bValid = false;
+  ezVec3 m_vPosition = ezVec3::ZeroVector();
+  ezUInt32 m_uiFrameCounter = 0;
+};
+
+/// \brief Posted by ezAnimationLod::ReportVisible() to an animation component that was extracted for rendering.
+///
+/// The component has to pass the message on to ezAnimationLod::SetVisible().
+struct EZ_RENDERERCORE_DLL ezMsgAnimationLodVisible : public ezMessage
+{
+  EZ_DECLARE_MESSAGE_TYPE(ezMsgAnimationLodVisible, ezMessage);
+
+  /// Render world frame counter of the extraction.
+  ezUInt32 m_uiFrameCounter = 0;
+};
+
+/// \brief Decides how often an animated skeleton needs to be updated and interpolates its pose in between.
+///
+/// Every animation component that computes poses owns one instance of this class. The LOD is chosen in a synchronous update step
+/// (see UpdateLevel()), from the distance to the main view and from whether the skeleton was rendered in any view recently.
+/// The (possibly asynchronous) animation update then calls ShouldUpdate() to find out whether a new pose has to be computed this frame.
+/// Skipped frames are filled in by InterpolatePose(), which blends between the local space transforms of the last two computed poses
+/// and converts the result to model space.
+///
+/// The LOD distances and update intervals are configured globally through the 'a_Lod*' cvars.
+class EZ_RENDERERCORE_DLL ezAnimationLod
+{
+public:
+  ezAnimationLod();
+
+  /// \brief Looks up the position of the main view of the given world. Has to be called from the main thread.
+  static ezAnimationLodReference GetReference(const ezWorld* pWorld);
+
+  /// \brief Sets an offset for the update frames, so that skeletons with the same LOD don't all get updated in the same frame.
+  void SetStaggerOffset(ezUInt32 uiOffset) { m_uiStaggerOffset = static_cast<ezUInt8>(uiOffset); }
+
+  /// \brief Chooses the LOD for the next update from the distance between the reference position and the skeleton position.
+  void UpdateLevel(const ezAnimationLodReference& reference, const ezVec3& vSkeletonPosition);
+
+  /// \brief Returns the current LOD.
+  ezAnimationLodLevel::Enum GetLevel() const { return m_Level; }
+
+  /// \brief Returns whether a new pose has to be computed this frame.
+  ///
+  /// The time of all skipped frames is accumulated and returned in \a out_tTimeStep, once an update is due.
+  /// The accumulated time is clamped, so that after a long pause, e.g. while invisible, the animation does not jump ahead in one huge step.
+  /// Can be called from a worker thread.
+  bool ShouldUpdate(ezTime tDiff, ezTime& out_tTimeStep);
+
+  /// \brief Has to be called after a new pose was computed in a frame for which ShouldUpdate() returned true.
+  ///
+  /// Stores the local space pose as the new interpolation target and, if interpolation is active, replaces \a inout_ModelPose with the
+  /// first interpolation step.
+  void SetComputedPose(const ozz::animation::Skeleton& skeleton, ezArrayPtr<const ozz::math::SoaTransform> localPose, ezArrayPtr<ezMat4> inout_ModelPose);
+
+  /// \brief Has to be called in frames for which ShouldUpdate() returned false.
+  ///
+  /// Returns true if \a inout_ModelPose was modified and thus needs to be broadcast again.
+  bool InterpolatePose(const ozz::animation::Skeleton& skeleton, ezArrayPtr<ezMat4> inout_ModelPose);
+
+  /// \brief Returns whether the skeleton is not updated at all at the moment, so anything derived from its animation, like root motion, should be paused.
+  bool IsPaused() const { return m_Level == ezAnimationLodLevel::Invisible; }
+
+  /// \brief Reports that the given component was extracted for rendering. Call this from its ezMsgExtractRenderData handler.
+  ///
+  /// Extraction must not modify the component, so this only posts an ezMsgAnimationLodVisible to it, which is handled in the next frame.
+  static void ReportVisible(const ezComponent& component);
+
+  /// \brief Records the frame in which the skeleton was rendered. Call this from the ezMsgAnimationLodVisible handler of the component.
+  void SetVisible(const ezMsgAnimationLodVisible& msg);
+
+private:
+  ezEnum<ezAnimationLodLevel> m_Level;
+  ezUInt8 m_uiUpdateInterval = 1;
+  ezUInt8 m_uiFramesSinceUpdate = 0xFF;
+  ezUInt8 m_uiStaggerOffset = 0;
+  ezTime m_AccumulatedTime;
+
+  /// Render world frame counter of the last extraction, 0 means never rendered.
+  ezUInt32 m_uiLastVisibleFrame = 0;
+
+  ezDynamicArray<ozz::math::SoaTransform, ezAlignedAllocatorWrapper> m_PreviousPose;
+  ezDynamicArray<ozz::math::SoaTransform, ezAlignedAllocatorWrapper> m_TargetPose;
+};
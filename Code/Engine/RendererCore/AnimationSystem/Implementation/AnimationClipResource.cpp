@@ -1,6 +1,8 @@
 #include <RendererCorePCH.h>
 
 #include <Core/Assets/AssetFileHeader.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Mutex.h>
 #include <RendererCore/AnimationSystem/AnimationClipResource.h>
 #include <RendererCore/AnimationSystem/AnimationPose.h>
 #include <RendererCore/AnimationSystem/Skeleton.h>
@@ -103,7 +105,13 @@ struct ezAnimationClipResourceDescriptor::OzzImpl
     ozz::unique_ptr<ozz::animation::Animation> m_pAnim;
   };
 
+  // animations are sampled on worker threads, so the cache is accessed by multiple threads
+  ezMutex m_Mutex;
   ezMap<const ezSkeletonResource*, CachedAnim> m_MappedOzzAnimations;
+
+  // an animation that was mapped to an older version of a skeleton may still be sampled by another thread,
+  // so it is kept alive until the descriptor is destroyed
+  ezDynamicArray<ozz::unique_ptr<ozz::animation::Animation>> m_OutdatedAnimations;
 };
 
 ezAnimationClipResourceDescriptor::ezAnimationClipResourceDescriptor()
@@ -244,6 +252,8 @@ EZ_FORCE_INLINE void ez2ozz(const ezQuat& in, ozz::math::Quaternion& out)
 
 const ozz::animation::Animation& ezAnimationClipResourceDescriptor::GetMappedOzzAnimation(const ezSkeletonResource& skeleton) const
 {
+  EZ_LOCK(m_OzzImpl->m_Mutex);
+
   auto it = m_OzzImpl->m_MappedOzzAnimations.Find(&skeleton);
   if (it.IsValid())
   {
@@ -345,6 +355,12 @@ const ozz::animation::Animation& ezAnimationClipResourceDescriptor::GetMappedOzz
   EZ_ASSERT_DEBUG(rawAnim.Validate(), "Invalid animation data");
 
   auto& cached = m_OzzImpl->m_MappedOzzAnimations[&skeleton];
+
+  if (cached.m_pAnim != nullptr)
+  {
+    m_OzzImpl->m_OutdatedAnimations.PushBack(std::move(cached.m_pAnim));
+  }
+
   cached.m_pAnim = std::move(animBuilder(rawAnim));
   cached.m_uiResourceChangeCounter = skeleton.GetCurrentResourceChangeCounter();
 
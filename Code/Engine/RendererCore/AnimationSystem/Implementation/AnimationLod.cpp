@@ -0,0 +1,242 @@
+#include <RendererCorePCH.h>
+
+#include <Core/World/World.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Utilities/Metrics.h>
+#include <RendererCore/AnimationSystem/AnimationLod.h>
+#include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+#include <ozz/animation/runtime/local_to_model_job.h>
+#include <ozz/animation/runtime/skeleton.h>
+#include <ozz/base/containers/vector.h>
+
+ezCVarBool CVarAnimLodEnable("a_LodEnable", true, ezCVarFlags::Default, "Enables distance and visibility based LOD for skeletal animation updates");
+ezCVarFloat CVarAnimLodDistance1("a_LodDistance1", 15.0f, ezCVarFlags::Default, "Distance to the main view beyond which skeletons are updated every 'a_LodInterval1' frames");
+ezCVarFloat CVarAnimLodDistance2("a_LodDistance2", 40.0f, ezCVarFlags::Default, "Distance to the main view beyond which skeletons are updated every 'a_LodInterval2' frames");
+ezCVarInt CVarAnimLodInterval1("a_LodInterval1", 2, ezCVarFlags::Default, "Number of frames between pose updates for skeletons beyond 'a_LodDistance1'");
+ezCVarInt CVarAnimLodInterval2("a_LodInterval2", 4, ezCVarFlags::Default, "Number of frames between pose updates for skeletons beyond 'a_LodDistance2'");
+ezCVarBool CVarAnimLodInterpolate("a_LodInterpolate", true, ezCVarFlags::Default, "Interpolates the poses of skeletons that are not updated every frame");
+ezCVarBool CVarAnimLodSkipInvisible("a_LodSkipInvisible", true, ezCVarFlags::Default, "Skips pose updates for skeletons that were not rendered in any view recently");
+
+namespace
+{
+  /// Number of frames that a skeleton still counts as visible after it was last extracted for rendering.
+  constexpr ezUInt32 s_uiVisibilityGracePeriod = 4;
+
+  /// Upper limit for the time step of a single pose update, in seconds.
+  constexpr double s_fMaxTimeStep = 0.25;
+
+  ezMetricCounter s_NumUpdated[ezAnimationLodLevel::COUNT];
+  ezMetricCounter s_NumSkipped[ezAnimationLodLevel::COUNT];
+
+  const char* s_szLevelNames[ezAnimationLodLevel::COUNT] = {"Full", "Reduced", "Low", "Invisible"};
+
+  void RegisterMetrics()
+  {
+    ezStringBuilder sName;
+
+    for (ezUInt32 i = 0; i < ezAnimationLodLevel::COUNT; ++i)
+    {
+      sName.Format("Animation LOD/{0}/Updated", s_szLevelNames[i]);
+      s_NumUpdated[i] = ezMetrics::RegisterCounter(sName);
+
+      sName.Format("Animation LOD/{0}/Skipped", s_szLevelNames[i]);
+      s_NumSkipped[i] = ezMetrics::RegisterCounter(sName);
+    }
+  }
+} // namespace
+
+// clang-format off
+EZ_IMPLEMENT_MESSAGE_TYPE(ezMsgAnimationLodVisible);
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezMsgAnimationLodVisible, 1, ezRTTIDefaultAllocator<ezMsgAnimationLodVisible>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+EZ_BEGIN_SUBSYSTEM_DECLARATION(RendererCore, AnimationLod)
+
+BEGIN_SUBSYSTEM_DEPENDENCIES
+"Foundation",
+"Core",
+"RenderWorld"
+END_SUBSYSTEM_DEPENDENCIES
+
+ON_HIGHLEVELSYSTEMS_STARTUP
+{
+  RegisterMetrics();
+}
+
+ON_HIGHLEVELSYSTEMS_SHUTDOWN
+{
+}
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+ezAnimationLod::ezAnimationLod() = default;
+
+// static
+ezAnimationLodReference ezAnimationLod::GetReference(const ezWorld* pWorld)
+{
+  ezAnimationLodReference reference;
+  reference.m_uiFrameCounter = static_cast<ezUInt32>(ezRenderWorld::GetFrameCounter());
+
+  if (const ezView* pView = ezRenderWorld::GetViewByUsageHint(ezCameraUsageHint::MainView, ezCameraUsageHint::EditorView, pWorld))
+  {
+    reference.m_bValid = true;
+    reference.m_vPosition = pView->GetCullingCamera()->GetCenterPosition();
+  }
+
+  return reference;
+}
+
+void ezAnimationLod::UpdateLevel(const ezAnimationLodReference& reference, const ezVec3& vSkeletonPosition)
+{
+  ezAnimationLodLevel::Enum level = ezAnimationLodLevel::Full;
+
+  if (CVarAnimLodEnable)
+  {
+    // skeletons that were never rendered are not treated as invisible, their render components might just be on another game object
+    if (CVarAnimLodSkipInvisible && m_uiLastVisibleFrame != 0 && (reference.m_uiFrameCounter + 1) - m_uiLastVisibleFrame > s_uiVisibilityGracePeriod)
+    {
+      level = ezAnimationLodLevel::Invisible;
+    }
+    else if (reference.m_bValid)
+    {
+      const float fDistSqr = (vSkeletonPosition - reference.m_vPosition).GetLengthSquared();
+
+      if (fDistSqr > ezMath::Square(CVarAnimLodDistance2.GetValue()))
+        level = ezAnimationLodLevel::Low;
+      else if (fDistSqr > ezMath::Square(CVarAnimLodDistance1.GetValue()))
+        level = ezAnimationLodLevel::Reduced;
+    }
+  }
+
+  if (m_Level == level)
+    return;
+
+  m_Level = level;
+
+  ezUInt32 uiInterval = 1;
+  if (level == ezAnimationLodLevel::Reduced)
+    uiInterval = ezMath::Clamp(CVarAnimLodInterval1.GetValue(), 1, 255);
+  else if (level == ezAnimationLodLevel::Low)
+    uiInterval = ezMath::Clamp(CVarAnimLodInterval2.GetValue(), 1, 255);
+
+  m_uiUpdateInterval = static_cast<ezUInt8>(uiInterval);
+
+  // distribute the update frames of all skeletons with the same LOD
+  m_uiFramesSinceUpdate = static_cast<ezUInt8>(m_uiStaggerOffset % m_uiUpdateInterval);
+
+  // the old interpolation target does not fit the new interval anymore
+  m_PreviousPose.Clear();
+  m_TargetPose.Clear();
+}
+
+bool ezAnimationLod::ShouldUpdate(ezTime tDiff, ezTime& out_tTimeStep)
+{
+  // after a long pause the animation continues with a regular step instead of catching up all at once
+  m_AccumulatedTime = ezMath::Min(m_AccumulatedTime + tDiff, ezTime::Seconds(s_fMaxTimeStep));
+
+  if (m_uiFramesSinceUpdate < 0xFF)
+  {
+    ++m_uiFramesSinceUpdate;
+  }
+
+  if (m_Level == ezAnimationLodLevel::Invisible || m_uiFramesSinceUpdate < m_uiUpdateInterval)
+  {
+    s_NumSkipped[m_Level].Add();
+    return false;
+  }
+
+  s_NumUpdated[m_Level].Add();
+
+  m_uiFramesSinceUpdate = 0;
+  out_tTimeStep = m_AccumulatedTime;
+  m_AccumulatedTime.SetZero();
+  return true;
+}
+
+void ezAnimationLod::SetComputedPose(const ozz::animation::Skeleton& skeleton, ezArrayPtr<const ozz::math::SoaTransform> localPose, ezArrayPtr<ezMat4> inout_ModelPose)
+{
+  if (!CVarAnimLodInterpolate || m_uiUpdateInterval <= 1)
+  {
+    m_PreviousPose.Clear();
+    m_TargetPose.Clear();
+    return;
+  }
+
+  // the previous target is exactly what was displayed last, so it becomes the start of the next interpolation
+  m_PreviousPose.Swap(m_TargetPose);
+  m_TargetPose = localPose;
+
+  if (m_PreviousPose.GetCount() != m_TargetPose.GetCount())
+  {
+    m_PreviousPose = localPose;
+    return;
+  }
+
+  InterpolatePose(skeleton, inout_ModelPose);
+}
+
+bool ezAnimationLod::InterpolatePose(const ozz::animation::Skeleton& skeleton, ezArrayPtr<ezMat4> inout_ModelPose)
+{
+  if (m_TargetPose.IsEmpty() || m_uiFramesSinceUpdate >= m_uiUpdateInterval)
+    return false;
+
+  if (m_TargetPose.GetCount() != static_cast<ezUInt32>(skeleton.num_soa_joints()) || inout_ModelPose.GetCount() != static_cast<ezUInt32>(skeleton.num_joints()))
+    return false;
+
+  // step 0 is the update frame itself, the target is reached in the last frame before the next update
+  const float fLerp = static_cast<float>(m_uiFramesSinceUpdate + 1) / static_cast<float>(m_uiUpdateInterval);
+  const ozz::math::SimdFloat4 lerp = ozz::math::simd_float4::Load1(fLerp);
+
+  // the blended local transforms are only needed temporarily, so they are shared by all skeletons that are updated on the same thread
+  static thread_local ozz::vector<ozz::math::SoaTransform> s_ozzLocalTransforms;
+  s_ozzLocalTransforms.resize(m_TargetPose.GetCount());
+
+  // blending in local space keeps the bone lengths and rotations intact, lerping model space matrices would shear and shrink them
+  for (ezUInt32 i = 0; i < m_TargetPose.GetCount(); ++i)
+  {
+    const ozz::math::SoaTransform& from = m_PreviousPose[i];
+    const ozz::math::SoaTransform& to = m_TargetPose[i];
+
+    // take the shorter way around, q and -q are the same rotation
+    const ozz::math::SimdInt4 sign = ozz::math::Sign(ozz::math::Dot(from.rotation, to.rotation));
+    const ozz::math::SoaQuaternion toRotation = {ozz::math::Xor(to.rotation.x, sign), ozz::math::Xor(to.rotation.y, sign), ozz::math::Xor(to.rotation.z, sign), ozz::math::Xor(to.rotation.w, sign)};
+
+    ozz::math::SoaTransform& out = s_ozzLocalTransforms[i];
+    out.translation = ozz::math::Lerp(from.translation, to.translation, lerp);
+    out.rotation = ozz::math::NLerp(from.rotation, toRotation, lerp);
+    out.scale = ozz::math::Lerp(from.scale, to.scale, lerp);
+  }
+
+  {
+    ozz::animation::LocalToModelJob job;
+    job.input = ozz::make_span(s_ozzLocalTransforms);
+    job.output = ozz::span<ozz::math::Float4x4>(reinterpret_cast<ozz::math::Float4x4*>(begin(inout_ModelPose)), reinterpret_cast<ozz::math::Float4x4*>(end(inout_ModelPose)));
+    job.skeleton = &skeleton;
+    job.Run();
+  }
+
+  return true;
+}
+
+// static
+void ezAnimationLod::ReportVisible(const ezComponent& component)
+{
+  ezMsgAnimationLodVisible msg;
+  msg.m_uiFrameCounter = static_cast<ezUInt32>(ezRenderWorld::GetFrameCounter()) + 1;
+
+  component.PostMessage(msg, ezTime::Zero(), ezObjectMsgQueueType::NextFrame);
+}
+
+void ezAnimationLod::SetVisible(const ezMsgAnimationLodVisible& msg)
+{
+  // multiple views may report different frames, only the latest one counts
+  if (m_uiLastVisibleFrame == 0 || static_cast<ezInt32>(msg.m_uiFrameCounter - m_uiLastVisibleFrame) > 0)
+  {
+    m_uiLastVisibleFrame = msg.m_uiFrameCounter;
+  }
+}
+
+EZ_STATICLINK_FILE(RendererCore, RendererCore_AnimationSystem_Implementation_AnimationLod);
@@ -87,7 +87,7 @@ void ezSkinnedMeshComponent::CreateSkinningTransformBuffer(ezArrayPtr<const ezMa
 
 void ezSkinnedMeshComponent::UpdateSkinningTransformBuffer(ezArrayPtr<const ezMat4> skinningMatrices)
 {
-  ezArrayPtr<ezMat4> pRenderMatrices = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezMat4, skinningMatrices.GetCount());
+  ezArrayPtr<ezMat4> pRenderMatrices = EZ_NEW_ARRAY(ezFrameAllocator::GetThreadAllocator(), ezMat4, skinningMatrices.GetCount());
   pRenderMatrices.CopyFrom(skinningMatrices);
 
   m_SkinningMatrices = pRenderMatrices;
@@ -244,10 +244,11 @@ void ezRenderPipelineResourceLoader::CreateRenderPipelineResourceDescriptor(cons
 
   auto pType = ezGetStaticRTTI<RenderPipelineResourceLoaderNodeDataInternal>();
   RenderPipelineResourceLoaderNodeDataInternal data;
-  auto& nodes = graph.GetAllNodes();
-  for (auto it = nodes.GetIterator(); it.IsValid(); ++it)
+  // the connections are added to the graph as sub-objects, so iterate over a copy of the nodes
+  ezDynamicArray<ezAbstractObjectNode*> nodes;
+  graph.GetNodesSortedByGuid(nodes);
+  for (auto* pNode : nodes)
   {
-    auto* pNode = it.Value();
     const ezUuid& guid = pNode->GetGuid();
 
     auto objectSoure = context.GetObjectByGUID(guid);
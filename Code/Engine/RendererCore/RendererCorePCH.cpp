@@ -6,6 +6,7 @@ EZ_STATICLINK_LIBRARY(RendererCore)
     return;
 
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_AnimationClipResource);
+  EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_AnimationLod);
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_AnimationPose);
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_EditableSkeleton);
   EZ_STATICLINK_REFERENCE(RendererCore_AnimationSystem_Implementation_OzzUtils);
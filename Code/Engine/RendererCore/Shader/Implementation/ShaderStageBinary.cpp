@@ -2,6 +2,7 @@
 
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/Threading/Mutex.h>
 #include <RendererCore/Shader/ShaderStageBinary.h>
 #include <RendererCore/Shader/Types.h>
 #include <RendererCore/ShaderCompiler/ShaderManager.h>
@@ -155,6 +156,9 @@ ezShaderResourceBinding::~ezShaderResourceBinding() {}
 
 ezMap<ezUInt32, ezShaderStageBinary> ezShaderStageBinary::s_ShaderStageBinaries[ezGALShaderStage::ENUM_COUNT];
 
+// the shader compiler may load and write stage binaries from several threads
+static ezMutex s_ShaderStageBinariesMutex;
+
 ezShaderStageBinary::ezShaderStageBinary()
 {
   m_uiSourceHash = 0;
@@ -330,6 +334,9 @@ ezResult ezShaderStageBinary::WriteStageBinary(ezLogInterface* pLog) const
   sShaderStageFile.AppendPath(ezShaderManager::GetActivePlatform().GetData());
   sShaderStageFile.AppendFormat("/{0}_{1}.ezShaderStage", ezGALShaderStage::Names[m_Stage], ezArgU(m_uiSourceHash, 8, true, 16, true));
 
+  // permutations that result in the same stage source write the same file
+  EZ_LOCK(s_ShaderStageBinariesMutex);
+
   ezFileWriter StageFileOut;
   if (StageFileOut.Open(sShaderStageFile.GetData()).Failed())
   {
@@ -349,6 +356,8 @@ ezResult ezShaderStageBinary::WriteStageBinary(ezLogInterface* pLog) const
 // static
 ezShaderStageBinary* ezShaderStageBinary::LoadStageBinary(ezGALShaderStage::Enum Stage, ezUInt32 uiHash)
 {
+  EZ_LOCK(s_ShaderStageBinariesMutex);
+
   auto itStage = s_ShaderStageBinaries[Stage].Find(uiHash);
 
   if (!itStage.IsValid())
@@ -393,6 +402,8 @@ ezShaderStageBinary* ezShaderStageBinary::LoadStageBinary(ezGALShaderStage::Enum
 // static
 void ezShaderStageBinary::OnEngineShutdown()
 {
+  EZ_LOCK(s_ShaderStageBinariesMutex);
+
   for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
   {
     s_ShaderStageBinaries[stage].Clear();
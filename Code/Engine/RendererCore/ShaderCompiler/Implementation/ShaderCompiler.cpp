@@ -95,9 +95,22 @@ namespace
   static const char* s_szStageDefines[ezGALShaderStage::ENUM_COUNT] = {"VERTEX_SHADER", "HULL_SHADER", "DOMAIN_SHADER", "GEOMETRY_SHADER", "PIXEL_SHADER", "COMPUTE_SHADER"};
 } // namespace
 
+ezShaderCompiler::ezShaderCompiler()
+{
+  m_pUsedFileCache = &m_FileCache;
+}
+
+void ezShaderCompiler::SetCustomFileCache(ezTokenizedFileCache* pFileCache)
+{
+  m_pUsedFileCache = &m_FileCache;
+
+  if (pFileCache != nullptr)
+    m_pUsedFileCache = pFileCache;
+}
+
 ezResult ezShaderCompiler::FileOpen(const char* szAbsoluteFile, ezDynamicArray<ezUInt8>& FileContent, ezTimestamp& out_FileModification)
 {
-  if (ezStringUtils::IsEqual(szAbsoluteFile, "ShaderRenderState"))
+  if (m_StateSourceFile == szAbsoluteFile)
   {
     const ezString& sData = m_ShaderData.m_StateSource;
     const ezUInt32 uiCount = sData.GetElementCount();
@@ -132,8 +145,6 @@ ezResult ezShaderCompiler::FileOpen(const char* szAbsoluteFile, ezDynamicArray<e
     }
   }
 
-  m_IncludeFiles.Insert(szAbsoluteFile);
-
   ezFileReader r;
   if (r.Open(szAbsoluteFile).Failed())
   {
@@ -159,6 +170,19 @@ ezResult ezShaderCompiler::FileOpen(const char* szAbsoluteFile, ezDynamicArray<e
   return EZ_SUCCESS;
 }
 
+ezResult ezShaderCompiler::FileLocator(const char* szCurAbsoluteFile, const char* szIncludeFile, ezPreprocessor::IncludeType IncType, ezStringBuilder& out_sAbsoluteFilePath)
+{
+  EZ_SUCCEED_OR_RETURN(ezPreprocessor::DefaultFileLocator(szCurAbsoluteFile, szIncludeFile, IncType, out_sAbsoluteFilePath));
+
+  // includes are tracked here instead of in FileOpen, because files from the cache are not opened again
+  if (IncType != ezPreprocessor::MainFile)
+  {
+    m_IncludeFiles.Insert(out_sAbsoluteFilePath);
+  }
+
+  return EZ_SUCCESS;
+}
+
 ezResult ezShaderCompiler::CompileShaderPermutationForPlatforms(const char* szFile, const ezArrayPtr<const ezPermutationVar>& permutationVars, ezLogInterface* pLog, const char* szPlatform)
 {
   ezStringBuilder sFileContent, sTemp;
@@ -242,6 +266,10 @@ ezResult ezShaderCompiler::CompileShaderPermutationForPlatforms(const char* szFi
   ezStringBuilder tmp = szFile;
   tmp.MakeCleanPath();
 
+  // the file cache may be shared with compilers of other shaders, so the in-memory sections need names that are unique per shader
+  m_StateSourceFile = tmp;
+  m_StateSourceFile.ChangeFileExtension("ShaderRenderState");
+
   m_StageSourceFile[ezGALShaderStage::VertexShader] = tmp;
   m_StageSourceFile[ezGALShaderStage::VertexShader].ChangeFileExtension("vs");
 
@@ -328,9 +356,10 @@ ezResult ezShaderCompiler::RunShaderCompiler(const char* szFile, const char* szP
       EZ_LOG_BLOCK(pLog, "Preprocessing Shader State Source");
 
       ezPreprocessor pp;
-      pp.SetCustomFileCache(&m_FileCache);
+      pp.SetCustomFileCache(m_pUsedFileCache);
       pp.SetLogInterface(ezLog::GetThreadLocalLogSystem());
       pp.SetFileOpenFunction(ezPreprocessor::FileOpenCB(&ezShaderCompiler::FileOpen, this));
+      pp.SetFileLocatorFunction(ezPreprocessor::FileLocatorCB(&ezShaderCompiler::FileLocator, this));
       pp.SetPassThroughPragma(false);
       pp.SetPassThroughLine(false);
 
@@ -350,7 +379,7 @@ ezResult ezShaderCompiler::RunShaderCompiler(const char* szFile, const char* szP
       });
 
       ezStringBuilder sOutput;
-      if (pp.Process("ShaderRenderState", sOutput, false).Failed() || bFoundUndefinedVars)
+      if (pp.Process(m_StateSourceFile, sOutput, false).Failed() || bFoundUndefinedVars)
       {
         ezLog::Error(pLog, "Preprocessing the Shader State block failed");
         return EZ_FAILURE;
@@ -376,9 +405,10 @@ ezResult ezShaderCompiler::RunShaderCompiler(const char* szFile, const char* szP
       bool bFoundUndefinedVars = false;
 
       ezPreprocessor pp;
-      pp.SetCustomFileCache(&m_FileCache);
+      pp.SetCustomFileCache(m_pUsedFileCache);
       pp.SetLogInterface(ezLog::GetThreadLocalLogSystem());
       pp.SetFileOpenFunction(ezPreprocessor::FileOpenCB(&ezShaderCompiler::FileOpen, this));
+      pp.SetFileLocatorFunction(ezPreprocessor::FileLocatorCB(&ezShaderCompiler::FileLocator, this));
       pp.SetPassThroughPragma(true);
       pp.SetPassThroughUnknownCmdsCB(ezMakeDelegate(&ezShaderCompiler::PassThroughUnknownCommandCB, this));
       pp.SetPassThroughLine(false);
@@ -64,6 +64,13 @@ public:
 class EZ_RENDERERCORE_DLL ezShaderCompiler
 {
 public:
+  ezShaderCompiler();
+
+  /// \brief Allows to share the tokenized include files between several compilers, e.g. when compiling many permutations of the same shader.
+  ///
+  /// The cache is thread-safe, so compilers that run in parallel can use the same cache. Passing nullptr resets to the internal cache.
+  void SetCustomFileCache(ezTokenizedFileCache* pFileCache = nullptr);
+
   ezResult CompileShaderPermutationForPlatforms(
     const char* szFile, const ezArrayPtr<const ezPermutationVar>& permutationVars, ezLogInterface* pLog, const char* szPlatform = "ALL");
 
@@ -85,9 +92,13 @@ private:
 
   ezResult FileOpen(const char* szAbsoluteFile, ezDynamicArray<ezUInt8>& FileContent, ezTimestamp& out_FileModification);
 
+  ezResult FileLocator(const char* szCurAbsoluteFile, const char* szIncludeFile, ezPreprocessor::IncludeType IncType, ezStringBuilder& out_sAbsoluteFilePath);
+
+  ezStringBuilder m_StateSourceFile;
   ezStringBuilder m_StageSourceFile[ezGALShaderStage::ENUM_COUNT];
 
   ezTokenizedFileCache m_FileCache;
+  ezTokenizedFileCache* m_pUsedFileCache;
   ezShaderData m_ShaderData;
 
   ezSet<ezString> m_IncludeFiles;
@@ -95,12 +95,16 @@ ezResourceLoadData ezTextureResourceLoader::OpenDataStream(const ezResource* pRe
   }
   else
   {
-    ezFileReader File;
+    ezFileReader& File = pData->m_File;
     if (File.Open(pResource->GetResourceID()).Failed())
+    {
+      EZ_DEFAULT_DELETE(pData);
       return res;
+    }
 
     const ezStringBuilder sAbsolutePath = File.GetFilePathAbsolute();
     res.m_sResourceDescription = File.GetFilePathRelative().GetView();
+    res.m_sLoadedFilePath = sAbsolutePath;
 
 #if EZ_ENABLED(EZ_SUPPORTS_FILE_STATS)
     {
@@ -118,8 +122,17 @@ ezResourceLoadData ezTextureResourceLoader::OpenDataStream(const ezResource* pRe
 
     if (sAbsolutePath.HasExtension("ezTexture2D") || sAbsolutePath.HasExtension("ezTexture3D") || sAbsolutePath.HasExtension("ezTextureCube") || sAbsolutePath.HasExtension("ezRenderTarget") || sAbsolutePath.HasExtension("ezLUT"))
     {
-      if (LoadTexFile(File, *pData).Failed())
+      // memory mapped files stay open until CloseDataStream(), the texture resource uploads the image straight from the mapping
+      if (LoadTexFile(File, *pData, true).Failed())
+      {
+        EZ_DEFAULT_DELETE(pData);
         return res;
+      }
+
+      // files that are not held in memory were copied into the image
+      ezArrayPtr<const ezUInt8> fileData;
+      if (!File.GetRemainingContiguousData(fileData))
+        File.Close();
     }
     else
     {
@@ -127,7 +140,10 @@ ezResourceLoadData ezTextureResourceLoader::OpenDataStream(const ezResource* pRe
       File.Close();
 
       if (pData->m_Image.LoadFrom(pResource->GetResourceID()).Failed())
+      {
+        EZ_DEFAULT_DELETE(pData);
         return res;
+      }
 
       if (pData->m_Image.GetImageFormat() == ezImageFormat::B8G8R8_UNORM)
       {
@@ -135,7 +151,10 @@ ezResourceLoadData ezTextureResourceLoader::OpenDataStream(const ezResource* pRe
 
         ezLog::Warning("Texture resource uses inefficient BGR format, converting to BGRX: '{0}'", sAbsolutePath);
         if (ezImageConversion::Convert(pData->m_Image, pData->m_Image, ezImageFormat::B8G8R8A8_UNORM).Failed())
+        {
+          EZ_DEFAULT_DELETE(pData);
           return res;
+        }
       }
     }
   }
@@ -189,8 +208,11 @@ bool ezTextureResourceLoader::IsResourceOutdated(const ezResource* pResource) co
   return true;
 }
 
-ezResult ezTextureResourceLoader::LoadTexFile(ezStreamReader& stream, LoadedData& data)
+ezResult ezTextureResourceLoader::LoadTexFile(ezStreamReader& stream, LoadedData& data, bool bInPlace)
 {
+  // never write into memory that a previous call referenced in place
+  data.m_Image.Clear();
+
   // read the hash, ignore it
   ezAssetFileHeader AssetHash;
   EZ_SUCCEED_OR_RETURN(AssetHash.Read(stream));
@@ -200,6 +222,10 @@ ezResult ezTextureResourceLoader::LoadTexFile(ezStreamReader& stream, LoadedData
   if (data.m_TexFormat.m_iRenderTargetResolutionX == 0)
   {
     ezDdsFileFormat fmt;
+
+    if (bInPlace)
+      return fmt.ReadImageInPlace(stream, data.m_Image, ezLog::GetThreadLocalLogSystem());
+
     return fmt.ReadImage(stream, data.m_Image, ezLog::GetThreadLocalLogSystem(), "dds");
   }
   else
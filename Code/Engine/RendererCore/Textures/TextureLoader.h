@@ -2,6 +2,7 @@
 
 #include <Core/ResourceManager/Resource.h>
 #include <Core/ResourceManager/ResourceTypeLoader.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
 #include <RendererCore/RenderContext/Implementation/RenderContextStructs.h>
 #include <RendererCore/RendererCoreDLL.h>
 #include <RendererFoundation/RendererFoundationDLL.h>
@@ -22,6 +23,9 @@ public:
     ezMemoryStreamReader m_Reader;
     ezImage m_Image;
 
+    /// Kept open while m_Image references the memory mapped file, until the texture was uploaded.
+    ezFileReader m_File;
+
     bool m_bIsFallback = false;
     ezTexFormat m_TexFormat;
   };
@@ -30,6 +34,10 @@ public:
   virtual void CloseDataStream(const ezResource* pResource, const ezResourceLoadData& LoaderData) override;
   virtual bool IsResourceOutdated(const ezResource* pResource) const override;
 
-  static ezResult LoadTexFile(ezStreamReader& stream, LoadedData& data);
+  /// \brief Reads an ezTex file into \a data.
+  ///
+  /// If \a bInPlace is set and the stream keeps its data in memory, e.g. a memory mapped file, the image references that memory instead
+  /// of copying it, so the stream must stay valid as long as \a data is used.
+  static ezResult LoadTexFile(ezStreamReader& stream, LoadedData& data, bool bInPlace = false);
   static void WriteTextureLoadStream(ezStreamWriter& stream, const LoadedData& data);
 };
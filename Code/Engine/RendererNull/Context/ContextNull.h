@@ -0,0 +1,170 @@
+#pragma once
+
+#include <RendererFoundation/Context/Context.h>
+#include <RendererNull/Device/DeviceNull.h>
+
+class ezGALShaderNull;
+class ezGALBufferNull;
+
+/// \brief The null implementation of the graphics context.
+///
+/// Keeps track of the bound state to validate draws and dispatches the way a real API would reject them, counts all submitted work on the
+/// device and records it if command recording is enabled.
+class EZ_RENDERERNULL_DLL ezGALContextNull : public ezGALContext
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALContextNull(ezGALDevice* pDevice);
+
+  ~ezGALContextNull();
+
+  // Draw functions
+
+  virtual void ClearPlatform(const ezColor& ClearColor, ezUInt32 uiRenderTargetClearMask, bool bClearDepth, bool bClearStencil, float fDepthClear, ezUInt8 uiStencilClear) override;
+
+  virtual void ClearUnorderedAccessViewPlatform(const ezGALUnorderedAccessView* pUnorderedAccessView, ezVec4 clearValues) override;
+
+  virtual void ClearUnorderedAccessViewPlatform(const ezGALUnorderedAccessView* pUnorderedAccessView, ezVec4U32 clearValues) override;
+
+  virtual void DrawPlatform(ezUInt32 uiVertexCount, ezUInt32 uiStartVertex) override;
+
+  virtual void DrawIndexedPlatform(ezUInt32 uiIndexCount, ezUInt32 uiStartIndex) override;
+
+  virtual void DrawIndexedInstancedPlatform(ezUInt32 uiIndexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartIndex) override;
+
+  virtual void DrawIndexedInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes) override;
+
+  virtual void DrawInstancedPlatform(ezUInt32 uiVertexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartVertex) override;
+
+  virtual void DrawInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes) override;
+
+  virtual void DrawAutoPlatform() override;
+
+  virtual void BeginStreamOutPlatform() override;
+
+  virtual void EndStreamOutPlatform() override;
+
+  // Dispatch
+
+  virtual void DispatchPlatform(ezUInt32 uiThreadGroupCountX, ezUInt32 uiThreadGroupCountY, ezUInt32 uiThreadGroupCountZ) override;
+
+  virtual void DispatchIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes) override;
+
+
+  // State setting functions
+
+  virtual void SetShaderPlatform(const ezGALShader* pShader) override;
+
+  virtual void SetIndexBufferPlatform(const ezGALBuffer* pIndexBuffer) override;
+
+  virtual void SetVertexBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pVertexBuffer) override;
+
+  virtual void SetVertexDeclarationPlatform(const ezGALVertexDeclaration* pVertexDeclaration) override;
+
+  virtual void SetPrimitiveTopologyPlatform(ezGALPrimitiveTopology::Enum Topology) override;
+
+  virtual void SetConstantBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pBuffer) override;
+
+  virtual void SetSamplerStatePlatform(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, const ezGALSamplerState* pSamplerState) override;
+
+  virtual void SetResourceViewPlatform(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, const ezGALResourceView* pResourceView) override;
+
+  virtual void SetRenderTargetSetupPlatform(ezArrayPtr<const ezGALRenderTargetView*> pRenderTargetViews, const ezGALRenderTargetView* pDepthStencilView) override;
+
+  virtual void SetUnorderedAccessViewPlatform(ezUInt32 uiSlot, const ezGALUnorderedAccessView* pUnorderedAccessView) override;
+
+  virtual void SetBlendStatePlatform(const ezGALBlendState* pBlendState, const ezColor& BlendFactor, ezUInt32 uiSampleMask) override;
+
+  virtual void SetDepthStencilStatePlatform(const ezGALDepthStencilState* pDepthStencilState, ezUInt8 uiStencilRefValue) override;
+
+  virtual void SetRasterizerStatePlatform(const ezGALRasterizerState* pRasterizerState) override;
+
+  virtual void SetViewportPlatform(const ezRectFloat& rect, float fMinDepth, float fMaxDepth) override;
+
+  virtual void SetScissorRectPlatform(const ezRectU32& rect) override;
+
+  virtual void SetStreamOutBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pBuffer, ezUInt32 uiOffset) override;
+
+  // Fence & Query functions
+
+  virtual void InsertFencePlatform(const ezGALFence* pFence) override;
+
+  virtual bool IsFenceReachedPlatform(const ezGALFence* pFence) override;
+
+  virtual void WaitForFencePlatform(const ezGALFence* pFence) override;
+
+  virtual void BeginQueryPlatform(const ezGALQuery* pQuery) override;
+
+  virtual void EndQueryPlatform(const ezGALQuery* pQuery) override;
+
+  virtual ezResult GetQueryResultPlatform(const ezGALQuery* pQuery, ezUInt64& uiQueryResult) override;
+
+  // Timestamp functions
+
+  virtual void InsertTimestampPlatform(ezGALTimestampHandle hTimestamp) override;
+
+  // Resource update functions
+
+  virtual void CopyBufferPlatform(const ezGALBuffer* pDestination, const ezGALBuffer* pSource) override;
+
+  virtual void CopyBufferRegionPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, const ezGALBuffer* pSource, ezUInt32 uiSourceOffset, ezUInt32 uiByteCount) override;
+
+  virtual void UpdateBufferPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, ezArrayPtr<const ezUInt8> pSourceData, ezGALUpdateMode::Enum updateMode) override;
+
+  virtual void CopyTexturePlatform(const ezGALTexture* pDestination, const ezGALTexture* pSource) override;
+
+  virtual void CopyTextureRegionPlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource, const ezVec3U32& DestinationPoint, const ezGALTexture* pSource, const ezGALTextureSubresource& SourceSubResource, const ezBoundingBoxu32& Box) override;
+
+  virtual void UpdateTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource, const ezBoundingBoxu32& DestinationBox, const ezGALSystemMemoryDescription& pSourceData) override;
+
+  virtual void ResolveTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource, const ezGALTexture* pSource, const ezGALTextureSubresource& SourceSubResource) override;
+
+  virtual void ReadbackTexturePlatform(const ezGALTexture* pTexture) override;
+
+  virtual void CopyTextureReadbackResultPlatform(const ezGALTexture* pTexture, const ezArrayPtr<ezGALSystemMemoryDescription>* pData) override;
+
+  virtual void GenerateMipMapsPlatform(const ezGALResourceView* pResourceView) override;
+
+  // Misc
+
+  virtual void FlushPlatform() override;
+
+  // Debug helper functions
+
+  virtual void PushMarkerPlatform(const char* szMarker) override;
+
+  virtual void PopMarkerPlatform() override;
+
+  virtual void InsertEventMarkerPlatform(const char* szMarker) override;
+
+private:
+  ezGALDeviceNull* GetNullDevice() const;
+
+  /// \brief Counts a failed validation, the error itself is logged by the caller.
+  void OnValidationError();
+
+  /// \brief Counts the state change and records it if command recording is enabled.
+  void OnStateChanged(ezGALNullCommandType::Enum commandType, ezUInt32 uiArg0 = 0, ezUInt32 uiArg1 = 0);
+
+  /// \brief Validates the bound state for a draw call, e.g. that a vertex shader and an output are bound.
+  bool ValidateDraw(const char* szFunction);
+
+  /// \brief Additionally validates that an index buffer is bound and that the index range is within it.
+  bool ValidateIndexedDraw(const char* szFunction, ezUInt32 uiIndexCount, ezUInt32 uiStartIndex);
+
+  bool ValidateIndirectArguments(const char* szFunction, const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes, ezUInt32 uiArgumentSize);
+
+  void CountDraw(ezGALNullCommandType::Enum commandType, ezUInt32 uiElementCount, ezUInt32 uiInstanceCount);
+
+  const ezGALShaderNull* m_pBoundShader = nullptr;
+  const ezGALBufferNull* m_pBoundIndexBuffer = nullptr;
+  const ezGALVertexDeclaration* m_pBoundVertexDeclaration = nullptr;
+  const ezGALRenderTargetView* m_pBoundDepthStencilView = nullptr;
+  ezUInt32 m_uiBoundVertexBufferMask = 0;
+  ezUInt32 m_uiBoundStreamOutMask = 0;
+  ezUInt32 m_uiBoundRenderTargetCount = 0;
+  ezUInt32 m_uiMarkerDepth = 0;
+  bool m_bStreamOutActive = false;
+};
@@ -0,0 +1,624 @@
+#include <RendererNullPCH.h>
+
+#include <RendererNull/Context/ContextNull.h>
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererNull/Resources/BufferNull.h>
+#include <RendererNull/Resources/QueryNull.h>
+#include <RendererNull/Resources/ResourceViewNull.h>
+#include <RendererNull/Resources/TextureNull.h>
+#include <RendererNull/Shader/ShaderNull.h>
+
+ezGALContextNull::ezGALContextNull(ezGALDevice* pDevice)
+  : ezGALContext(pDevice)
+{
+}
+
+ezGALContextNull::~ezGALContextNull() {}
+
+EZ_ALWAYS_INLINE ezGALDeviceNull* ezGALContextNull::GetNullDevice() const
+{
+  return static_cast<ezGALDeviceNull*>(GetDevice());
+}
+
+void ezGALContextNull::OnValidationError()
+{
+  ++GetNullDevice()->m_FrameStats.m_uiValidationErrors;
+}
+
+EZ_ALWAYS_INLINE void ezGALContextNull::OnStateChanged(ezGALNullCommandType::Enum commandType, ezUInt32 uiArg0, ezUInt32 uiArg1)
+{
+  ezGALDeviceNull* pDevice = GetNullDevice();
+  ++pDevice->m_FrameStats.m_uiStateChanges;
+  pDevice->RecordCommand(commandType, uiArg0, uiArg1);
+}
+
+bool ezGALContextNull::ValidateDraw(const char* szFunction)
+{
+  if (m_pBoundShader == nullptr || !m_pBoundShader->HasStage(ezGALShaderStage::VertexShader))
+  {
+    ezLog::Error("{0}: No shader with a vertex shader stage is bound", szFunction);
+    OnValidationError();
+    return false;
+  }
+
+  if (m_uiBoundRenderTargetCount == 0 && m_pBoundDepthStencilView == nullptr && m_uiBoundStreamOutMask == 0)
+  {
+    ezLog::Error("{0}: Neither a render target, a depth stencil target nor a stream out buffer is bound", szFunction);
+    OnValidationError();
+    return false;
+  }
+
+  if (m_uiBoundVertexBufferMask != 0 && m_pBoundVertexDeclaration == nullptr)
+  {
+    ezLog::Error("{0}: Vertex buffers are bound without a vertex declaration", szFunction);
+    OnValidationError();
+    return false;
+  }
+
+  return true;
+}
+
+bool ezGALContextNull::ValidateIndexedDraw(const char* szFunction, ezUInt32 uiIndexCount, ezUInt32 uiStartIndex)
+{
+  if (!ValidateDraw(szFunction))
+    return false;
+
+  if (m_pBoundIndexBuffer == nullptr)
+  {
+    ezLog::Error("{0}: No index buffer is bound", szFunction);
+    OnValidationError();
+    return false;
+  }
+
+  const ezUInt64 uiEndIndex = (ezUInt64)uiStartIndex + uiIndexCount;
+  if (uiEndIndex > m_pBoundIndexBuffer->GetElementCount())
+  {
+    ezLog::Error("{0}: Indices {1} to {2} are out of bounds, the index buffer only has {3} indices", szFunction, uiStartIndex, uiEndIndex,
+      m_pBoundIndexBuffer->GetElementCount());
+    OnValidationError();
+    return false;
+  }
+
+  return true;
+}
+
+bool ezGALContextNull::ValidateIndirectArguments(const char* szFunction, const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes, ezUInt32 uiArgumentSize)
+{
+  const ezGALBufferCreationDescription& desc = pIndirectArgumentBuffer->GetDescription();
+
+  if (!desc.m_bUseForIndirectArguments)
+  {
+    ezLog::Error("{0}: The argument buffer was not created with m_bUseForIndirectArguments", szFunction);
+    OnValidationError();
+    return false;
+  }
+
+  if ((ezUInt64)uiArgumentOffsetInBytes + uiArgumentSize > desc.m_uiTotalSize)
+  {
+    ezLog::Error("{0}: Arguments at offset {1} exceed the argument buffer size of {2} bytes", szFunction, uiArgumentOffsetInBytes, desc.m_uiTotalSize);
+    OnValidationError();
+    return false;
+  }
+
+  return true;
+}
+
+EZ_ALWAYS_INLINE void ezGALContextNull::CountDraw(ezGALNullCommandType::Enum commandType, ezUInt32 uiElementCount, ezUInt32 uiInstanceCount)
+{
+  ezGALDeviceNull* pDevice = GetNullDevice();
+  ++pDevice->m_FrameStats.m_uiDrawCalls;
+  pDevice->m_FrameStats.m_uiInstances += uiInstanceCount;
+  pDevice->RecordCommand(commandType, uiElementCount, uiInstanceCount);
+}
+
+// Draw functions
+
+void ezGALContextNull::ClearPlatform(const ezColor& ClearColor, ezUInt32 uiRenderTargetClearMask, bool bClearDepth, bool bClearStencil, float fDepthClear, ezUInt8 uiStencilClear)
+{
+  ezGALDeviceNull* pDevice = GetNullDevice();
+  ++pDevice->m_FrameStats.m_uiClears;
+
+  const ezUInt32 uiTargetMask = uiRenderTargetClearMask & ((1u << m_uiBoundRenderTargetCount) - 1);
+  const bool bDepthStencil = (bClearDepth || bClearStencil) && m_pBoundDepthStencilView != nullptr;
+  pDevice->RecordCommand(ezGALNullCommandType::Clear, uiTargetMask, bDepthStencil ? 1 : 0);
+}
+
+void ezGALContextNull::ClearUnorderedAccessViewPlatform(const ezGALUnorderedAccessView* pUnorderedAccessView, ezVec4 clearValues)
+{
+  ezGALDeviceNull* pDevice = GetNullDevice();
+  ++pDevice->m_FrameStats.m_uiClears;
+  pDevice->RecordCommand(ezGALNullCommandType::ClearUnorderedAccessView);
+}
+
+void ezGALContextNull::ClearUnorderedAccessViewPlatform(const ezGALUnorderedAccessView* pUnorderedAccessView, ezVec4U32 clearValues)
+{
+  ezGALDeviceNull* pDevice = GetNullDevice();
+  ++pDevice->m_FrameStats.m_uiClears;
+  pDevice->RecordCommand(ezGALNullCommandType::ClearUnorderedAccessView);
+}
+
+void ezGALContextNull::DrawPlatform(ezUInt32 uiVertexCount, ezUInt32 uiStartVertex)
+{
+  if (ValidateDraw("Draw"))
+  {
+    CountDraw(ezGALNullCommandType::Draw, uiVertexCount, 1);
+  }
+}
+
+void ezGALContextNull::DrawIndexedPlatform(ezUInt32 uiIndexCount, ezUInt32 uiStartIndex)
+{
+  if (ValidateIndexedDraw("DrawIndexed", uiIndexCount, uiStartIndex))
+  {
+    CountDraw(ezGALNullCommandType::DrawIndexed, uiIndexCount, 1);
+  }
+}
+
+void ezGALContextNull::DrawIndexedInstancedPlatform(ezUInt32 uiIndexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartIndex)
+{
+  if (ValidateIndexedDraw("DrawIndexedInstanced", uiIndexCountPerInstance, uiStartIndex))
+  {
+    CountDraw(ezGALNullCommandType::DrawIndexed, uiIndexCountPerInstance, uiInstanceCount);
+  }
+}
+
+void ezGALContextNull::DrawIndexedInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  // IndexCountPerInstance, InstanceCount, StartIndexLocation, BaseVertexLocation, StartInstanceLocation
+  if (ValidateIndexedDraw("DrawIndexedInstancedIndirect", 0, 0) &&
+      ValidateIndirectArguments("DrawIndexedInstancedIndirect", pIndirectArgumentBuffer, uiArgumentOffsetInBytes, 5 * sizeof(ezUInt32)))
+  {
+    CountDraw(ezGALNullCommandType::DrawIndirect, 0, 1);
+  }
+}
+
+void ezGALContextNull::DrawInstancedPlatform(ezUInt32 uiVertexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartVertex)
+{
+  if (ValidateDraw("DrawInstanced"))
+  {
+    CountDraw(ezGALNullCommandType::Draw, uiVertexCountPerInstance, uiInstanceCount);
+  }
+}
+
+void ezGALContextNull::DrawInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  // VertexCountPerInstance, InstanceCount, StartVertexLocation, StartInstanceLocation
+  if (ValidateDraw("DrawInstancedIndirect") &&
+      ValidateIndirectArguments("DrawInstancedIndirect", pIndirectArgumentBuffer, uiArgumentOffsetInBytes, 4 * sizeof(ezUInt32)))
+  {
+    CountDraw(ezGALNullCommandType::DrawIndirect, 0, 1);
+  }
+}
+
+void ezGALContextNull::DrawAutoPlatform()
+{
+  if (ValidateDraw("DrawAuto"))
+  {
+    CountDraw(ezGALNullCommandType::Draw, 0, 1);
+  }
+}
+
+void ezGALContextNull::BeginStreamOutPlatform()
+{
+  if (m_bStreamOutActive)
+  {
+    ezLog::Error("BeginStreamOut: Stream out is already active");
+    OnValidationError();
+  }
+
+  m_bStreamOutActive = true;
+}
+
+void ezGALContextNull::EndStreamOutPlatform()
+{
+  if (!m_bStreamOutActive)
+  {
+    ezLog::Error("EndStreamOut: Stream out is not active");
+    OnValidationError();
+  }
+
+  m_bStreamOutActive = false;
+}
+
+// Dispatch
+
+void ezGALContextNull::DispatchPlatform(ezUInt32 uiThreadGroupCountX, ezUInt32 uiThreadGroupCountY, ezUInt32 uiThreadGroupCountZ)
+{
+  if (m_pBoundShader == nullptr || !m_pBoundShader->HasStage(ezGALShaderStage::ComputeShader))
+  {
+    ezLog::Error("Dispatch: No shader with a compute shader stage is bound");
+    OnValidationError();
+    return;
+  }
+
+  if (uiThreadGroupCountX == 0 || uiThreadGroupCountY == 0 || uiThreadGroupCountZ == 0)
+  {
+    ezLog::Warning("Dispatch: Empty dispatch of {0}x{1}x{2} thread groups", uiThreadGroupCountX, uiThreadGroupCountY, uiThreadGroupCountZ);
+  }
+
+  ezGALDeviceNull* pDevice = GetNullDevice();
+  ++pDevice->m_FrameStats.m_uiDispatchCalls;
+  pDevice->RecordCommand(ezGALNullCommandType::Dispatch, uiThreadGroupCountX * uiThreadGroupCountY * uiThreadGroupCountZ);
+}
+
+void ezGALContextNull::DispatchIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  if (m_pBoundShader == nullptr || !m_pBoundShader->HasStage(ezGALShaderStage::ComputeShader))
+  {
+    ezLog::Error("DispatchIndirect: No shader with a compute shader stage is bound");
+    OnValidationError();
+    return;
+  }
+
+  // ThreadGroupCountX, ThreadGroupCountY, ThreadGroupCountZ
+  if (!ValidateIndirectArguments("DispatchIndirect", pIndirectArgumentBuffer, uiArgumentOffsetInBytes, 3 * sizeof(ezUInt32)))
+    return;
+
+  ezGALDeviceNull* pDevice = GetNullDevice();
+  ++pDevice->m_FrameStats.m_uiDispatchCalls;
+  pDevice->RecordCommand(ezGALNullCommandType::DispatchIndirect);
+}
+
+
+// State settings functions
+
+void ezGALContextNull::SetShaderPlatform(const ezGALShader* pShader)
+{
+  m_pBoundShader = static_cast<const ezGALShaderNull*>(pShader);
+  OnStateChanged(ezGALNullCommandType::SetShader);
+}
+
+void ezGALContextNull::SetIndexBufferPlatform(const ezGALBuffer* pIndexBuffer)
+{
+  if (pIndexBuffer != nullptr && pIndexBuffer->GetDescription().m_BufferType != ezGALBufferType::IndexBuffer)
+  {
+    ezLog::Error("SetIndexBuffer: The buffer is not an index buffer");
+    OnValidationError();
+    pIndexBuffer = nullptr;
+  }
+
+  m_pBoundIndexBuffer = static_cast<const ezGALBufferNull*>(pIndexBuffer);
+  OnStateChanged(ezGALNullCommandType::SetIndexBuffer);
+}
+
+void ezGALContextNull::SetVertexBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pVertexBuffer)
+{
+  if (pVertexBuffer != nullptr)
+  {
+    m_uiBoundVertexBufferMask |= (1u << uiSlot);
+  }
+  else
+  {
+    m_uiBoundVertexBufferMask &= ~(1u << uiSlot);
+  }
+
+  OnStateChanged(ezGALNullCommandType::SetVertexBuffer, uiSlot);
+}
+
+void ezGALContextNull::SetVertexDeclarationPlatform(const ezGALVertexDeclaration* pVertexDeclaration)
+{
+  m_pBoundVertexDeclaration = pVertexDeclaration;
+  OnStateChanged(ezGALNullCommandType::SetVertexDeclaration);
+}
+
+void ezGALContextNull::SetPrimitiveTopologyPlatform(ezGALPrimitiveTopology::Enum Topology)
+{
+  OnStateChanged(ezGALNullCommandType::SetPrimitiveTopology, Topology);
+}
+
+void ezGALContextNull::SetConstantBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pBuffer)
+{
+  if (pBuffer != nullptr && pBuffer->GetDescription().m_BufferType != ezGALBufferType::ConstantBuffer)
+  {
+    ezLog::Error("SetConstantBuffer: The buffer bound to slot {0} is not a constant buffer", uiSlot);
+    OnValidationError();
+  }
+
+  OnStateChanged(ezGALNullCommandType::SetConstantBuffer, uiSlot);
+}
+
+void ezGALContextNull::SetSamplerStatePlatform(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, const ezGALSamplerState* pSamplerState)
+{
+  OnStateChanged(ezGALNullCommandType::SetSamplerState, uiSlot, Stage);
+}
+
+void ezGALContextNull::SetResourceViewPlatform(ezGALShaderStage::Enum Stage, ezUInt32 uiSlot, const ezGALResourceView* pResourceView)
+{
+  OnStateChanged(ezGALNullCommandType::SetResourceView, uiSlot, Stage);
+}
+
+void ezGALContextNull::SetRenderTargetSetupPlatform(ezArrayPtr<const ezGALRenderTargetView*> pRenderTargetViews, const ezGALRenderTargetView* pDepthStencilView)
+{
+  m_uiBoundRenderTargetCount = 0;
+  for (ezUInt32 i = 0; i < pRenderTargetViews.GetCount(); ++i)
+  {
+    if (pRenderTargetViews[i] == nullptr)
+      continue;
+
+    if (static_cast<const ezGALRenderTargetViewNull*>(pRenderTargetViews[i])->IsDepthStencilView())
+    {
+      ezLog::Error("SetRenderTargetSetup: A depth stencil view is bound as render target {0}", i);
+      OnValidationError();
+      continue;
+    }
+
+    m_uiBoundRenderTargetCount = i + 1;
+  }
+
+  m_pBoundDepthStencilView = pDepthStencilView;
+  if (pDepthStencilView != nullptr && !static_cast<const ezGALRenderTargetViewNull*>(pDepthStencilView)->IsDepthStencilView())
+  {
+    ezLog::Error("SetRenderTargetSetup: A color render target view is bound as depth stencil target");
+    OnValidationError();
+    m_pBoundDepthStencilView = nullptr;
+  }
+
+  OnStateChanged(ezGALNullCommandType::SetRenderTargetSetup, m_uiBoundRenderTargetCount, m_pBoundDepthStencilView != nullptr ? 1 : 0);
+}
+
+void ezGALContextNull::SetUnorderedAccessViewPlatform(ezUInt32 uiSlot, const ezGALUnorderedAccessView* pUnorderedAccessView)
+{
+  OnStateChanged(ezGALNullCommandType::SetUnorderedAccessView, uiSlot);
+}
+
+void ezGALContextNull::SetBlendStatePlatform(const ezGALBlendState* pBlendState, const ezColor& BlendFactor, ezUInt32 uiSampleMask)
+{
+  OnStateChanged(ezGALNullCommandType::SetBlendState);
+}
+
+void ezGALContextNull::SetDepthStencilStatePlatform(const ezGALDepthStencilState* pDepthStencilState, ezUInt8 uiStencilRefValue)
+{
+  OnStateChanged(ezGALNullCommandType::SetDepthStencilState);
+}
+
+void ezGALContextNull::SetRasterizerStatePlatform(const ezGALRasterizerState* pRasterizerState)
+{
+  OnStateChanged(ezGALNullCommandType::SetRasterizerState);
+}
+
+void ezGALContextNull::SetViewportPlatform(const ezRectFloat& rect, float fMinDepth, float fMaxDepth)
+{
+  if (rect.width < 0.0f || rect.height < 0.0f || fMinDepth > fMaxDepth)
+  {
+    ezLog::Error("SetViewport: Invalid viewport {0}x{1}, depth range {2} to {3}", rect.width, rect.height, fMinDepth, fMaxDepth);
+    OnValidationError();
+  }
+
+  OnStateChanged(ezGALNullCommandType::SetViewport);
+}
+
+void ezGALContextNull::SetScissorRectPlatform(const ezRectU32& rect)
+{
+  OnStateChanged(ezGALNullCommandType::SetScissorRect);
+}
+
+void ezGALContextNull::SetStreamOutBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pBuffer, ezUInt32 uiOffset)
+{
+  if (pBuffer != nullptr && !pBuffer->GetDescription().m_bStreamOutputTarget)
+  {
+    ezLog::Error("SetStreamOutBuffer: The buffer bound to slot {0} was not created with m_bStreamOutputTarget", uiSlot);
+    OnValidationError();
+    pBuffer = nullptr;
+  }
+
+  if (pBuffer != nullptr)
+  {
+    m_uiBoundStreamOutMask |= (1u << uiSlot);
+  }
+  else
+  {
+    m_uiBoundStreamOutMask &= ~(1u << uiSlot);
+  }
+
+  OnStateChanged(ezGALNullCommandType::SetStreamOutBuffer, uiSlot);
+}
+
+// Fence & Query functions
+
+void ezGALContextNull::InsertFencePlatform(const ezGALFence* pFence)
+{
+  GetNullDevice()->RecordCommand(ezGALNullCommandType::Fence);
+}
+
+bool ezGALContextNull::IsFenceReachedPlatform(const ezGALFence* pFence)
+{
+  return true;
+}
+
+void ezGALContextNull::WaitForFencePlatform(const ezGALFence* pFence) {}
+
+void ezGALContextNull::BeginQueryPlatform(const ezGALQuery* pQuery)
+{
+  const ezGALQueryNull* pQueryNull = static_cast<const ezGALQueryNull*>(pQuery);
+  pQueryNull->m_bActive = true;
+  pQueryNull->m_bHasResult = false;
+
+  GetNullDevice()->RecordCommand(ezGALNullCommandType::Query, 0);
+}
+
+void ezGALContextNull::EndQueryPlatform(const ezGALQuery* pQuery)
+{
+  const ezGALQueryNull* pQueryNull = static_cast<const ezGALQueryNull*>(pQuery);
+  if (!pQueryNull->m_bActive)
+  {
+    ezLog::Error("EndQuery: The query was not begun");
+    OnValidationError();
+  }
+
+  pQueryNull->m_bActive = false;
+  pQueryNull->m_bHasResult = true;
+
+  GetNullDevice()->RecordCommand(ezGALNullCommandType::Query, 1);
+}
+
+ezResult ezGALContextNull::GetQueryResultPlatform(const ezGALQuery* pQuery, ezUInt64& uiQueryResult)
+{
+  const ezGALQueryNull* pQueryNull = static_cast<const ezGALQueryNull*>(pQuery);
+  if (!pQueryNull->m_bHasResult)
+  {
+    return EZ_FAILURE;
+  }
+
+  // nothing was rendered, so no samples passed
+  uiQueryResult = 0;
+  return EZ_SUCCESS;
+}
+
+// Timestamp functions
+
+void ezGALContextNull::InsertTimestampPlatform(ezGALTimestampHandle hTimestamp)
+{
+  ezGALDeviceNull* pDevice = GetNullDevice();
+  pDevice->m_Timestamps[hTimestamp.m_uiIndex] = ezTime::Now();
+  pDevice->RecordCommand(ezGALNullCommandType::Timestamp);
+}
+
+// Resource update functions
+
+void ezGALContextNull::CopyBufferPlatform(const ezGALBuffer* pDestination, const ezGALBuffer* pSource)
+{
+  if (pDestination->GetSize() != pSource->GetSize())
+  {
+    ezLog::Error("CopyBuffer: Source and destination have different sizes ({0} and {1} bytes)", pSource->GetSize(), pDestination->GetSize());
+    OnValidationError();
+    return;
+  }
+
+  ezGALDeviceNull* pDevice = GetNullDevice();
+  ++pDevice->m_FrameStats.m_uiCopies;
+  pDevice->RecordCommand(ezGALNullCommandType::Copy, pSource->GetSize());
+}
+
+void ezGALContextNull::CopyBufferRegionPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, const ezGALBuffer* pSource, ezUInt32 uiSourceOffset, ezUInt32 uiByteCount)
+{
+  if ((ezUInt64)uiDestOffset + uiByteCount > pDestination->GetSize() || (ezUInt64)uiSourceOffset + uiByteCount > pSource->GetSize())
+  {
+    ezLog::Error("CopyBufferRegion: Copying {0} bytes from offset {1} to offset {2} is out of bounds", uiByteCount, uiSourceOffset, uiDestOffset);
+    OnValidationError();
+    return;
+  }
+
+  ezGALDeviceNull* pDevice = GetNullDevice();
+  ++pDevice->m_FrameStats.m_uiCopies;
+  pDevice->RecordCommand(ezGALNullCommandType::Copy, uiByteCount);
+}
+
+void ezGALContextNull::UpdateBufferPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, ezArrayPtr<const ezUInt8> pSourceData, ezGALUpdateMode::Enum updateMode)
+{
+  // size and offset are already verified by ezGALContext::UpdateBuffer
+
+  if (pDestination->GetDescription().m_ResourceAccess.IsImmutable())
+  {
+    ezLog::Error("UpdateBuffer: The buffer is immutable");
+    OnValidationError();
+    return;
+  }
+
+  ezGALDeviceNull* pDevice = GetNullDevice();
+  ++pDevice->m_FrameStats.m_uiBufferUpdates;
+  pDevice->m_FrameStats.m_uiBytesUploaded += pSourceData.GetCount();
+  pDevice->RecordCommand(ezGALNullCommandType::UpdateBuffer, pSourceData.GetCount(), updateMode);
+}
+
+void ezGALContextNull::CopyTexturePlatform(const ezGALTexture* pDestination, const ezGALTexture* pSource)
+{
+  const ezGALTextureCreationDescription& destDesc = pDestination->GetDescription();
+  const ezGALTextureCreationDescription& srcDesc = pSource->GetDescription();
+
+  if (destDesc.m_uiWidth != srcDesc.m_uiWidth || destDesc.m_uiHeight != srcDesc.m_uiHeight || destDesc.m_uiDepth != srcDesc.m_uiDepth)
+  {
+    ezLog::Error("CopyTexture: Source and destination have different sizes");
+    OnValidationError();
+    return;
+  }
+
+  ezGALDeviceNull* pDevice = GetNullDevice();
+  ++pDevice->m_FrameStats.m_uiCopies;
+  pDevice->RecordCommand(ezGALNullCommandType::Copy);
+}
+
+void ezGALContextNull::CopyTextureRegionPlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource, const ezVec3U32& DestinationPoint, const ezGALTexture* pSource, const ezGALTextureSubresource& SourceSubResource, const ezBoundingBoxu32& Box)
+{
+  if (DestinationSubResource.m_uiMipLevel >= pDestination->GetDescription().m_uiMipLevelCount || SourceSubResource.m_uiMipLevel >= pSource->GetDescription().m_uiMipLevelCount)
+  {
+    ezLog::Error("CopyTextureRegion: Invalid mip level");
+    OnValidationError();
+    return;
+  }
+
+  ezGALDeviceNull* pDevice = GetNullDevice();
+  ++pDevice->m_FrameStats.m_uiCopies;
+  pDevice->RecordCommand(ezGALNullCommandType::Copy);
+}
+
+void ezGALContextNull::UpdateTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource, const ezBoundingBoxu32& DestinationBox, const ezGALSystemMemoryDescription& pSourceData)
+{
+  if (DestinationSubResource.m_uiMipLevel >= pDestination->GetDescription().m_uiMipLevelCount)
+  {
+    ezLog::Error("UpdateTexture: Invalid mip level {0}", DestinationSubResource.m_uiMipLevel);
+    OnValidationError();
+    return;
+  }
+
+  const ezUInt32 uiHeight = DestinationBox.m_vMax.y - DestinationBox.m_vMin.y;
+  const ezUInt32 uiDepth = DestinationBox.m_vMax.z - DestinationBox.m_vMin.z;
+  const ezUInt64 uiBytes = pSourceData.m_uiSlicePitch != 0 ? (ezUInt64)pSourceData.m_uiSlicePitch * uiDepth : (ezUInt64)pSourceData.m_uiRowPitch * uiHeight;
+
+  ezGALDeviceNull* pDevice = GetNullDevice();
+  ++pDevice->m_FrameStats.m_uiTextureUpdates;
+  pDevice->m_FrameStats.m_uiBytesUploaded += uiBytes;
+  pDevice->RecordCommand(ezGALNullCommandType::UpdateTexture, static_cast<ezUInt32>(uiBytes), DestinationSubResource.m_uiMipLevel);
+}
+
+void ezGALContextNull::ResolveTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& DestinationSubResource, const ezGALTexture* pSource, const ezGALTextureSubresource& SourceSubResource)
+{
+  if (pSource->GetDescription().m_SampleCount == ezGALMSAASampleCount::None)
+  {
+    ezLog::Error("ResolveTexture: The source texture is not multisampled");
+    OnValidationError();
+    return;
+  }
+
+  ezGALDeviceNull* pDevice = GetNullDevice();
+  ++pDevice->m_FrameStats.m_uiCopies;
+  pDevice->RecordCommand(ezGALNullCommandType::Resolve);
+}
+
+void ezGALContextNull::ReadbackTexturePlatform(const ezGALTexture* pTexture)
+{
+  GetNullDevice()->RecordCommand(ezGALNullCommandType::Readback);
+}
+
+void ezGALContextNull::CopyTextureReadbackResultPlatform(const ezGALTexture* pTexture, const ezArrayPtr<ezGALSystemMemoryDescription>* pData)
+{
+  // there is no GPU data, so the readback result is left untouched
+}
+
+void ezGALContextNull::GenerateMipMapsPlatform(const ezGALResourceView* pResourceView)
+{
+  GetNullDevice()->RecordCommand(ezGALNullCommandType::GenerateMipMaps);
+}
+
+void ezGALContextNull::FlushPlatform() {}
+
+// Debug helper functions
+
+void ezGALContextNull::PushMarkerPlatform(const char* szMarker)
+{
+  ++m_uiMarkerDepth;
+}
+
+void ezGALContextNull::PopMarkerPlatform()
+{
+  if (m_uiMarkerDepth == 0)
+  {
+    ezLog::Error("PopMarker: No marker was pushed");
+    OnValidationError();
+    return;
+  }
+
+  --m_uiMarkerDepth;
+}
+
+void ezGALContextNull::InsertEventMarkerPlatform(const char* szMarker) {}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Context_Implementation_ContextNull);
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <RendererFoundation/Device/Device.h>
+#include <RendererNull/RendererNullDLL.h>
+
+/// \brief Counters of the work that was submitted to an ezGALDeviceNull in one frame.
+struct ezGALNullDeviceStats
+{
+  ezUInt32 m_uiDrawCalls = 0;
+  ezUInt32 m_uiInstances = 0; ///< Number of instances of all draw calls, non-instanced draws count as one.
+  ezUInt32 m_uiDispatchCalls = 0;
+  ezUInt32 m_uiStateChanges = 0; ///< Only non-redundant state changes reach the device, ezGALContext filters the others.
+  ezUInt32 m_uiClears = 0;
+  ezUInt32 m_uiCopies = 0;
+  ezUInt32 m_uiBufferUpdates = 0;
+  ezUInt32 m_uiTextureUpdates = 0;
+  ezUInt32 m_uiResourcesCreated = 0;
+  ezUInt32 m_uiValidationErrors = 0;
+  ezUInt64 m_uiBytesUploaded = 0; ///< Initial data of created resources plus all buffer and texture updates.
+};
+
+struct ezGALNullCommandType
+{
+  enum Enum
+  {
+    Clear,
+    ClearUnorderedAccessView,
+    Draw,
+    DrawIndexed,
+    DrawIndirect,
+    Dispatch,
+    DispatchIndirect,
+    SetShader,
+    SetIndexBuffer,
+    SetVertexBuffer,
+    SetVertexDeclaration,
+    SetPrimitiveTopology,
+    SetConstantBuffer,
+    SetSamplerState,
+    SetResourceView,
+    SetRenderTargetSetup,
+    SetUnorderedAccessView,
+    SetBlendState,
+    SetDepthStencilState,
+    SetRasterizerState,
+    SetViewport,
+    SetScissorRect,
+    SetStreamOutBuffer,
+    UpdateBuffer,
+    UpdateTexture,
+    Copy,
+    Resolve,
+    Readback,
+    GenerateMipMaps,
+    Query,
+    Fence,
+    Timestamp,
+
+    ENUM_COUNT
+  };
+};
+
+/// \brief A command that was recorded by an ezGALDeviceNull. The meaning of the arguments depends on the type, e.g. vertex or index count and
+/// instance count for draws, slot for state changes and byte count for updates.
+struct ezGALNullCommand
+{
+  EZ_DECLARE_POD_TYPE();
+
+  ezGALNullCommandType::Enum m_Type;
+  ezUInt32 m_uiArg0;
+  ezUInt32 m_uiArg1;
+};
+
+/// \brief A device implementation of the graphics abstraction layer that validates all calls like a real backend would, but executes nothing.
+///
+/// This allows to run and profile the CPU side of the renderer on machines without a GPU. All submitted work is counted per frame
+/// and can optionally be recorded as a list of commands, e.g. to compare the command streams of two renderer versions.
+class EZ_RENDERERNULL_DLL ezGALDeviceNull : public ezGALDevice
+{
+public:
+  ezGALDeviceNull(const ezGALDeviceCreationDescription& Description);
+
+  virtual ~ezGALDeviceNull();
+
+  /// \brief Returns the counters of the current frame. They are reset in BeginFrame.
+  EZ_ALWAYS_INLINE const ezGALNullDeviceStats& GetFrameStats() const { return m_FrameStats; }
+
+  /// \brief Returns the counters of the last frame that was ended with EndFrame.
+  EZ_ALWAYS_INLINE const ezGALNullDeviceStats& GetLastFrameStats() const { return m_LastFrameStats; }
+
+  /// \brief Enables recording of all commands that are submitted to the primary context. Disabled by default.
+  void SetCommandRecordingEnabled(bool bEnable);
+
+  /// \brief Returns the commands that were recorded since the last BeginFrame.
+  EZ_ALWAYS_INLINE ezArrayPtr<const ezGALNullCommand> GetRecordedCommands() const { return m_RecordedCommands; }
+
+protected:
+  // Init & shutdown functions
+
+  virtual ezResult InitPlatform() override;
+
+  virtual ezResult ShutdownPlatform() override;
+
+
+  // State creation functions
+
+  virtual ezGALBlendState* CreateBlendStatePlatform(const ezGALBlendStateCreationDescription& Description) override;
+
+  virtual void DestroyBlendStatePlatform(ezGALBlendState* pBlendState) override;
+
+  virtual ezGALDepthStencilState* CreateDepthStencilStatePlatform(const ezGALDepthStencilStateCreationDescription& Description) override;
+
+  virtual void DestroyDepthStencilStatePlatform(ezGALDepthStencilState* pDepthStencilState) override;
+
+  virtual ezGALRasterizerState* CreateRasterizerStatePlatform(const ezGALRasterizerStateCreationDescription& Description) override;
+
+  virtual void DestroyRasterizerStatePlatform(ezGALRasterizerState* pRasterizerState) override;
+
+  virtual ezGALSamplerState* CreateSamplerStatePlatform(const ezGALSamplerStateCreationDescription& Description) override;
+
+  virtual void DestroySamplerStatePlatform(ezGALSamplerState* pSamplerState) override;
+
+
+  // Resource creation functions
+
+  virtual ezGALShader* CreateShaderPlatform(const ezGALShaderCreationDescription& Description) override;
+
+  virtual void DestroyShaderPlatform(ezGALShader* pShader) override;
+
+  virtual ezGALBuffer* CreateBufferPlatform(const ezGALBufferCreationDescription& Description, ezArrayPtr<const ezUInt8> pInitialData) override;
+
+  virtual void DestroyBufferPlatform(ezGALBuffer* pBuffer) override;
+
+  virtual ezGALTexture* CreateTexturePlatform(const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData) override;
+
+  virtual void DestroyTexturePlatform(ezGALTexture* pTexture) override;
+
+  virtual ezGALResourceView* CreateResourceViewPlatform(ezGALResourceBase* pResource, const ezGALResourceViewCreationDescription& Description) override;
+
+  virtual void DestroyResourceViewPlatform(ezGALResourceView* pResourceView) override;
+
+  virtual ezGALRenderTargetView* CreateRenderTargetViewPlatform(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description) override;
+
+  virtual void DestroyRenderTargetViewPlatform(ezGALRenderTargetView* pRenderTargetView) override;
+
+  virtual ezGALUnorderedAccessView* CreateUnorderedAccessViewPlatform(ezGALResourceBase* pResource, const ezGALUnorderedAccessViewCreationDescription& Description) override;
+
+  virtual void DestroyUnorderedAccessViewPlatform(ezGALUnorderedAccessView* pUnorderedAccessView) override;
+
+  // Other rendering creation functions
+
+  virtual ezGALSwapChain* CreateSwapChainPlatform(const ezGALSwapChainCreationDescription& Description) override;
+
+  virtual void DestroySwapChainPlatform(ezGALSwapChain* pSwapChain) override;
+
+  virtual ezGALFence* CreateFencePlatform() override;
+
+  virtual void DestroyFencePlatform(ezGALFence* pFence) override;
+
+  virtual ezGALQuery* CreateQueryPlatform(const ezGALQueryCreationDescription& Description) override;
+
+  virtual void DestroyQueryPlatform(ezGALQuery* pQuery) override;
+
+  virtual ezGALVertexDeclaration* CreateVertexDeclarationPlatform(const ezGALVertexDeclarationCreationDescription& Description) override;
+
+  virtual void DestroyVertexDeclarationPlatform(ezGALVertexDeclaration* pVertexDeclaration) override;
+
+  // Timestamp functions
+
+  virtual ezGALTimestampHandle GetTimestampPlatform() override;
+
+  virtual ezResult GetTimestampResultPlatform(ezGALTimestampHandle hTimestamp, ezTime& result) override;
+
+  // Swap chain functions
+
+  virtual void PresentPlatform(ezGALSwapChain* pSwapChain, bool bVSync) override;
+
+  // Misc functions
+
+  virtual void BeginFramePlatform() override;
+
+  virtual void EndFramePlatform() override;
+
+  virtual void SetPrimarySwapChainPlatform(ezGALSwapChain* pSwapChain) override;
+
+  virtual void FillCapabilitiesPlatform() override;
+
+private:
+  friend class ezGALContextNull;
+  friend class ezGALBufferNull;
+  friend class ezGALTextureNull;
+  friend class ezGALShaderNull;
+  friend class ezGALVertexDeclarationNull;
+  friend class ezGALRenderTargetViewNull;
+  friend class ezGALBlendStateNull;
+  friend class ezGALRasterizerStateNull;
+  friend class ezGALSamplerStateNull;
+  friend class ezGALSwapChainNull;
+
+  void RecordCommand(ezGALNullCommandType::Enum type, ezUInt32 uiArg0 = 0, ezUInt32 uiArg1 = 0);
+
+  ezGALNullDeviceStats m_FrameStats;
+  ezGALNullDeviceStats m_LastFrameStats;
+
+  bool m_bRecordCommands = false;
+  ezDynamicArray<ezGALNullCommand, ezLocalAllocatorWrapper> m_RecordedCommands;
+
+  ezUInt64 m_uiFrameCounter = 0;
+
+  // timestamps are resolved immediately, they only need to stay valid as long as a real device would keep them
+  ezTime m_Timestamps[1024];
+  ezUInt32 m_uiNextTimestamp = 0;
+};
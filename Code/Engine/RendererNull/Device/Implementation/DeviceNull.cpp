@@ -0,0 +1,439 @@
+#include <RendererNullPCH.h>
+
+#include <RendererNull/Context/ContextNull.h>
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererNull/Device/SwapChainNull.h>
+#include <RendererNull/Resources/BufferNull.h>
+#include <RendererNull/Resources/FenceNull.h>
+#include <RendererNull/Resources/QueryNull.h>
+#include <RendererNull/Resources/ResourceViewNull.h>
+#include <RendererNull/Resources/TextureNull.h>
+#include <RendererNull/Shader/ShaderNull.h>
+#include <RendererNull/Shader/VertexDeclarationNull.h>
+#include <RendererNull/State/StateNull.h>
+
+ezGALDeviceNull::ezGALDeviceNull(const ezGALDeviceCreationDescription& Description)
+  : ezGALDevice(Description)
+{
+}
+
+ezGALDeviceNull::~ezGALDeviceNull() = default;
+
+void ezGALDeviceNull::SetCommandRecordingEnabled(bool bEnable)
+{
+  m_bRecordCommands = bEnable;
+
+  if (!bEnable)
+  {
+    m_RecordedCommands.Clear();
+  }
+}
+
+void ezGALDeviceNull::RecordCommand(ezGALNullCommandType::Enum type, ezUInt32 uiArg0, ezUInt32 uiArg1)
+{
+  if (!m_bRecordCommands)
+    return;
+
+  ezGALNullCommand& command = m_RecordedCommands.ExpandAndGetRef();
+  command.m_Type = type;
+  command.m_uiArg0 = uiArg0;
+  command.m_uiArg1 = uiArg1;
+}
+
+// Init & shutdown functions
+
+ezResult ezGALDeviceNull::InitPlatform()
+{
+  EZ_LOG_BLOCK("ezGALDeviceNull::InitPlatform");
+
+  m_pPrimaryContext = EZ_NEW(&m_Allocator, ezGALContextNull, this);
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALDeviceNull::ShutdownPlatform()
+{
+  EZ_DELETE(&m_Allocator, m_pPrimaryContext);
+
+  m_RecordedCommands.Clear();
+  m_RecordedCommands.Compact();
+
+  return EZ_SUCCESS;
+}
+
+// State creation functions
+
+ezGALBlendState* ezGALDeviceNull::CreateBlendStatePlatform(const ezGALBlendStateCreationDescription& Description)
+{
+  ezGALBlendStateNull* pState = EZ_NEW(&m_Allocator, ezGALBlendStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    return pState;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyBlendStatePlatform(ezGALBlendState* pBlendState)
+{
+  ezGALBlendStateNull* pState = static_cast<ezGALBlendStateNull*>(pBlendState);
+  pState->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pState);
+}
+
+ezGALDepthStencilState* ezGALDeviceNull::CreateDepthStencilStatePlatform(const ezGALDepthStencilStateCreationDescription& Description)
+{
+  ezGALDepthStencilStateNull* pState = EZ_NEW(&m_Allocator, ezGALDepthStencilStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    return pState;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyDepthStencilStatePlatform(ezGALDepthStencilState* pDepthStencilState)
+{
+  ezGALDepthStencilStateNull* pState = static_cast<ezGALDepthStencilStateNull*>(pDepthStencilState);
+  pState->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pState);
+}
+
+ezGALRasterizerState* ezGALDeviceNull::CreateRasterizerStatePlatform(const ezGALRasterizerStateCreationDescription& Description)
+{
+  ezGALRasterizerStateNull* pState = EZ_NEW(&m_Allocator, ezGALRasterizerStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    return pState;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyRasterizerStatePlatform(ezGALRasterizerState* pRasterizerState)
+{
+  ezGALRasterizerStateNull* pState = static_cast<ezGALRasterizerStateNull*>(pRasterizerState);
+  pState->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pState);
+}
+
+ezGALSamplerState* ezGALDeviceNull::CreateSamplerStatePlatform(const ezGALSamplerStateCreationDescription& Description)
+{
+  ezGALSamplerStateNull* pState = EZ_NEW(&m_Allocator, ezGALSamplerStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    return pState;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroySamplerStatePlatform(ezGALSamplerState* pSamplerState)
+{
+  ezGALSamplerStateNull* pState = static_cast<ezGALSamplerStateNull*>(pSamplerState);
+  pState->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pState);
+}
+
+
+// Resource creation functions
+
+ezGALShader* ezGALDeviceNull::CreateShaderPlatform(const ezGALShaderCreationDescription& Description)
+{
+  ezGALShaderNull* pShader = EZ_NEW(&m_Allocator, ezGALShaderNull, Description);
+
+  if (!pShader->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pShader);
+    return nullptr;
+  }
+
+  return pShader;
+}
+
+void ezGALDeviceNull::DestroyShaderPlatform(ezGALShader* pShader)
+{
+  ezGALShaderNull* pNullShader = static_cast<ezGALShaderNull*>(pShader);
+  pNullShader->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pNullShader);
+}
+
+ezGALBuffer* ezGALDeviceNull::CreateBufferPlatform(const ezGALBufferCreationDescription& Description, ezArrayPtr<const ezUInt8> pInitialData)
+{
+  ezGALBufferNull* pBuffer = EZ_NEW(&m_Allocator, ezGALBufferNull, Description);
+
+  if (!pBuffer->InitPlatform(this, pInitialData).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pBuffer);
+    return nullptr;
+  }
+
+  return pBuffer;
+}
+
+void ezGALDeviceNull::DestroyBufferPlatform(ezGALBuffer* pBuffer)
+{
+  ezGALBufferNull* pNullBuffer = static_cast<ezGALBufferNull*>(pBuffer);
+  pNullBuffer->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pNullBuffer);
+}
+
+ezGALTexture* ezGALDeviceNull::CreateTexturePlatform(const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData)
+{
+  ezGALTextureNull* pTexture = EZ_NEW(&m_Allocator, ezGALTextureNull, Description);
+
+  if (!pTexture->InitPlatform(this, pInitialData).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pTexture);
+    return nullptr;
+  }
+
+  return pTexture;
+}
+
+void ezGALDeviceNull::DestroyTexturePlatform(ezGALTexture* pTexture)
+{
+  ezGALTextureNull* pNullTexture = static_cast<ezGALTextureNull*>(pTexture);
+  pNullTexture->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pNullTexture);
+}
+
+ezGALResourceView* ezGALDeviceNull::CreateResourceViewPlatform(ezGALResourceBase* pResource, const ezGALResourceViewCreationDescription& Description)
+{
+  ezGALResourceViewNull* pResourceView = EZ_NEW(&m_Allocator, ezGALResourceViewNull, pResource, Description);
+
+  if (!pResourceView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pResourceView);
+    return nullptr;
+  }
+
+  return pResourceView;
+}
+
+void ezGALDeviceNull::DestroyResourceViewPlatform(ezGALResourceView* pResourceView)
+{
+  ezGALResourceViewNull* pNullResourceView = static_cast<ezGALResourceViewNull*>(pResourceView);
+  pNullResourceView->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pNullResourceView);
+}
+
+ezGALRenderTargetView* ezGALDeviceNull::CreateRenderTargetViewPlatform(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description)
+{
+  ezGALRenderTargetViewNull* pRTView = EZ_NEW(&m_Allocator, ezGALRenderTargetViewNull, pTexture, Description);
+
+  if (!pRTView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pRTView);
+    return nullptr;
+  }
+
+  return pRTView;
+}
+
+void ezGALDeviceNull::DestroyRenderTargetViewPlatform(ezGALRenderTargetView* pRenderTargetView)
+{
+  ezGALRenderTargetViewNull* pNullRenderTargetView = static_cast<ezGALRenderTargetViewNull*>(pRenderTargetView);
+  pNullRenderTargetView->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pNullRenderTargetView);
+}
+
+ezGALUnorderedAccessView* ezGALDeviceNull::CreateUnorderedAccessViewPlatform(ezGALResourceBase* pTextureOfBuffer, const ezGALUnorderedAccessViewCreationDescription& Description)
+{
+  ezGALUnorderedAccessViewNull* pUnorderedAccessView = EZ_NEW(&m_Allocator, ezGALUnorderedAccessViewNull, pTextureOfBuffer, Description);
+
+  if (!pUnorderedAccessView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pUnorderedAccessView);
+    return nullptr;
+  }
+
+  return pUnorderedAccessView;
+}
+
+void ezGALDeviceNull::DestroyUnorderedAccessViewPlatform(ezGALUnorderedAccessView* pUnorderedAccessView)
+{
+  ezGALUnorderedAccessViewNull* pUnorderedAccessViewNull = static_cast<ezGALUnorderedAccessViewNull*>(pUnorderedAccessView);
+  pUnorderedAccessViewNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pUnorderedAccessViewNull);
+}
+
+
+// Other rendering creation functions
+
+ezGALSwapChain* ezGALDeviceNull::CreateSwapChainPlatform(const ezGALSwapChainCreationDescription& Description)
+{
+  ezGALSwapChainNull* pSwapChain = EZ_NEW(&m_Allocator, ezGALSwapChainNull, Description);
+
+  if (!pSwapChain->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pSwapChain);
+    return nullptr;
+  }
+
+  return pSwapChain;
+}
+
+void ezGALDeviceNull::DestroySwapChainPlatform(ezGALSwapChain* pSwapChain)
+{
+  ezGALSwapChainNull* pSwapChainNull = static_cast<ezGALSwapChainNull*>(pSwapChain);
+  pSwapChainNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pSwapChainNull);
+}
+
+ezGALFence* ezGALDeviceNull::CreateFencePlatform()
+{
+  ezGALFenceNull* pFence = EZ_NEW(&m_Allocator, ezGALFenceNull);
+
+  if (!pFence->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pFence);
+    return nullptr;
+  }
+
+  return pFence;
+}
+
+void ezGALDeviceNull::DestroyFencePlatform(ezGALFence* pFence)
+{
+  ezGALFenceNull* pFenceNull = static_cast<ezGALFenceNull*>(pFence);
+  pFenceNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pFenceNull);
+}
+
+ezGALQuery* ezGALDeviceNull::CreateQueryPlatform(const ezGALQueryCreationDescription& Description)
+{
+  ezGALQueryNull* pQuery = EZ_NEW(&m_Allocator, ezGALQueryNull, Description);
+
+  if (!pQuery->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pQuery);
+    return nullptr;
+  }
+
+  return pQuery;
+}
+
+void ezGALDeviceNull::DestroyQueryPlatform(ezGALQuery* pQuery)
+{
+  ezGALQueryNull* pQueryNull = static_cast<ezGALQueryNull*>(pQuery);
+  pQueryNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pQueryNull);
+}
+
+ezGALVertexDeclaration* ezGALDeviceNull::CreateVertexDeclarationPlatform(const ezGALVertexDeclarationCreationDescription& Description)
+{
+  ezGALVertexDeclarationNull* pVertexDeclaration = EZ_NEW(&m_Allocator, ezGALVertexDeclarationNull, Description);
+
+  if (pVertexDeclaration->InitPlatform(this).Succeeded())
+  {
+    return pVertexDeclaration;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pVertexDeclaration);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyVertexDeclarationPlatform(ezGALVertexDeclaration* pVertexDeclaration)
+{
+  ezGALVertexDeclarationNull* pVertexDeclarationNull = static_cast<ezGALVertexDeclarationNull*>(pVertexDeclaration);
+  pVertexDeclarationNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pVertexDeclarationNull);
+}
+
+
+// Timestamp functions
+
+ezGALTimestampHandle ezGALDeviceNull::GetTimestampPlatform()
+{
+  ezUInt32 uiIndex = m_uiNextTimestamp;
+  m_uiNextTimestamp = (m_uiNextTimestamp + 1) % EZ_ARRAY_SIZE(m_Timestamps);
+  return {uiIndex, m_uiFrameCounter};
+}
+
+ezResult ezGALDeviceNull::GetTimestampResultPlatform(ezGALTimestampHandle hTimestamp, ezTime& result)
+{
+  if (hTimestamp.m_uiIndex >= EZ_ARRAY_SIZE(m_Timestamps) || hTimestamp.m_uiFrameCounter > m_uiFrameCounter)
+  {
+    return EZ_FAILURE;
+  }
+
+  // the CPU time at which the timestamp was inserted, this is when a GPU without any latency would have reached it
+  result = m_Timestamps[hTimestamp.m_uiIndex];
+  return EZ_SUCCESS;
+}
+
+
+// Swap chain functions
+
+void ezGALDeviceNull::PresentPlatform(ezGALSwapChain* pSwapChain, bool bVSync) {}
+
+
+// Misc functions
+
+void ezGALDeviceNull::BeginFramePlatform()
+{
+  m_FrameStats = ezGALNullDeviceStats();
+  m_RecordedCommands.Clear();
+}
+
+void ezGALDeviceNull::EndFramePlatform()
+{
+  m_LastFrameStats = m_FrameStats;
+
+  ++m_uiFrameCounter;
+}
+
+void ezGALDeviceNull::SetPrimarySwapChainPlatform(ezGALSwapChain* pSwapChain) {}
+
+void ezGALDeviceNull::FillCapabilitiesPlatform()
+{
+  m_Capabilities.m_sAdapterName = "Null Device";
+  m_Capabilities.m_bHardwareAccelerated = false;
+
+  m_Capabilities.m_bMultithreadedResourceCreation = true;
+  m_Capabilities.m_bNoOverwriteBufferUpdate = true;
+
+  // report the feature set of the most capable backend, so that no code path is skipped
+  for (ezUInt32 i = 0; i < ezGALShaderStage::ENUM_COUNT; ++i)
+  {
+    m_Capabilities.m_bShaderStageSupported[i] = true;
+  }
+
+  m_Capabilities.m_bInstancing = true;
+  m_Capabilities.m_b32BitIndices = true;
+  m_Capabilities.m_bIndirectDraw = true;
+  m_Capabilities.m_bStreamOut = true;
+  m_Capabilities.m_bConservativeRasterization = true;
+  m_Capabilities.m_uiMaxConstantBuffers = EZ_GAL_MAX_CONSTANT_BUFFER_COUNT;
+  m_Capabilities.m_bTextureArrays = true;
+  m_Capabilities.m_bCubemapArrays = true;
+  m_Capabilities.m_bB5G6R5Textures = true;
+  m_Capabilities.m_uiMaxTextureDimension = 16384;
+  m_Capabilities.m_uiMaxCubemapDimension = 16384;
+  m_Capabilities.m_uiMax3DTextureDimension = 2048;
+  m_Capabilities.m_uiMaxAnisotropy = 16;
+  m_Capabilities.m_uiMaxRendertargets = EZ_GAL_MAX_RENDERTARGET_COUNT;
+  m_Capabilities.m_uiUAVCount = 64;
+  m_Capabilities.m_bAlphaToCoverage = true;
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Device_Implementation_DeviceNull);
@@ -0,0 +1,43 @@
+#include <RendererNullPCH.h>
+
+#include <Core/System/Window.h>
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererNull/Device/SwapChainNull.h>
+
+ezGALSwapChainNull::ezGALSwapChainNull(const ezGALSwapChainCreationDescription& Description)
+  : ezGALSwapChain(Description)
+{
+}
+
+ezGALSwapChainNull::~ezGALSwapChainNull() {}
+
+ezResult ezGALSwapChainNull::InitPlatform(ezGALDevice* pDevice)
+{
+  if (m_Description.m_pWindow == nullptr)
+  {
+    ezLog::Error("The swap chain needs a window to determine the size of the back buffer");
+    return EZ_FAILURE;
+  }
+
+  ezGALTextureCreationDescription TexDesc;
+  TexDesc.m_uiWidth = m_Description.m_pWindow->GetClientAreaSize().width;
+  TexDesc.m_uiHeight = m_Description.m_pWindow->GetClientAreaSize().height;
+  TexDesc.m_Format = m_Description.m_BackBufferFormat;
+  TexDesc.m_SampleCount = m_Description.m_SampleCount;
+  TexDesc.m_bAllowShaderResourceView = false;
+  TexDesc.m_bCreateRenderTarget = true;
+  TexDesc.m_ResourceAccess.m_bImmutable = true;
+  TexDesc.m_ResourceAccess.m_bReadBack = m_Description.m_bAllowScreenshots;
+
+  m_hBackBufferTexture = pDevice->CreateTexture(TexDesc);
+
+  if (m_hBackBufferTexture.IsInvalidated())
+  {
+    ezLog::Error("Couldn't create the back buffer texture of the swap chain!");
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Device_Implementation_SwapChainNull);
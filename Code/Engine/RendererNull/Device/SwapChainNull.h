@@ -0,0 +1,19 @@
+#pragma once
+
+#include <RendererFoundation/Descriptors/Descriptors.h>
+#include <RendererFoundation/Device/SwapChain.h>
+#include <RendererNull/RendererNullDLL.h>
+
+/// \brief Swap chain of the null device. The back buffer is a regular texture of the window's client area size and Present does nothing.
+class EZ_RENDERERNULL_DLL ezGALSwapChainNull : public ezGALSwapChain
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALSwapChainNull(const ezGALSwapChainCreationDescription& Description);
+
+  virtual ~ezGALSwapChainNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+};
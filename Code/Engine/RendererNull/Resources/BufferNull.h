@@ -0,0 +1,26 @@
+#pragma once
+
+#include <RendererFoundation/Resources/Buffer.h>
+#include <RendererNull/RendererNullDLL.h>
+
+class EZ_RENDERERNULL_DLL ezGALBufferNull : public ezGALBuffer
+{
+public:
+  /// \brief Returns the number of indices for index buffers, otherwise the number of elements of the buffer.
+  EZ_ALWAYS_INLINE ezUInt32 GetElementCount() const;
+
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALBufferNull(const ezGALBufferCreationDescription& Description);
+
+  virtual ~ezGALBufferNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice, ezArrayPtr<const ezUInt8> pInitialData) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+
+  virtual void SetDebugNamePlatform(const char* szName) const override;
+};
+
+#include <RendererNull/Resources/Implementation/BufferNull_inl.h>
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <RendererFoundation/Resources/Fence.h>
+#include <RendererNull/RendererNullDLL.h>
+
+/// \brief Since the null device executes nothing, its fences are always reached.
+class EZ_RENDERERNULL_DLL ezGALFenceNull : public ezGALFence
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALFenceNull();
+
+  virtual ~ezGALFenceNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
@@ -0,0 +1,46 @@
+#include <RendererNullPCH.h>
+
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererNull/Resources/BufferNull.h>
+
+ezGALBufferNull::ezGALBufferNull(const ezGALBufferCreationDescription& Description)
+  : ezGALBuffer(Description)
+{
+}
+
+ezGALBufferNull::~ezGALBufferNull() {}
+
+ezResult ezGALBufferNull::InitPlatform(ezGALDevice* pDevice, ezArrayPtr<const ezUInt8> pInitialData)
+{
+  ezGALDeviceNull* pNullDevice = static_cast<ezGALDeviceNull*>(pDevice);
+
+  // size and immutability are already validated by ezGALDevice::CreateBuffer
+
+  if (m_Description.m_BufferType == ezGALBufferType::IndexBuffer && m_Description.m_uiStructSize != 2 && m_Description.m_uiStructSize != 4)
+  {
+    ezLog::Error("Index buffers need a struct size of 2 or 4 bytes, got {0}", m_Description.m_uiStructSize);
+    ++pNullDevice->m_FrameStats.m_uiValidationErrors;
+    return EZ_FAILURE;
+  }
+
+  if (pInitialData.GetCount() > m_Description.m_uiTotalSize)
+  {
+    ezLog::Error("The initial data of a buffer is larger than the buffer ({0} > {1} bytes)", pInitialData.GetCount(), m_Description.m_uiTotalSize);
+    ++pNullDevice->m_FrameStats.m_uiValidationErrors;
+    return EZ_FAILURE;
+  }
+
+  pNullDevice->m_FrameStats.m_uiBytesUploaded += pInitialData.GetCount();
+  ++pNullDevice->m_FrameStats.m_uiResourcesCreated;
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALBufferNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+void ezGALBufferNull::SetDebugNamePlatform(const char* szName) const {}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Resources_Implementation_BufferNull);
@@ -0,0 +1,4 @@
+EZ_ALWAYS_INLINE ezUInt32 ezGALBufferNull::GetElementCount() const
+{
+  return m_Description.m_uiStructSize > 0 ? m_Description.m_uiTotalSize / m_Description.m_uiStructSize : 0;
+}
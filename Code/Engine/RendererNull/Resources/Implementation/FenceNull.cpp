@@ -0,0 +1,19 @@
+#include <RendererNullPCH.h>
+
+#include <RendererNull/Resources/FenceNull.h>
+
+ezGALFenceNull::ezGALFenceNull() {}
+
+ezGALFenceNull::~ezGALFenceNull() {}
+
+ezResult ezGALFenceNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALFenceNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Resources_Implementation_FenceNull);
@@ -0,0 +1,24 @@
+#include <RendererNullPCH.h>
+
+#include <RendererNull/Resources/QueryNull.h>
+
+ezGALQueryNull::ezGALQueryNull(const ezGALQueryCreationDescription& Description)
+  : ezGALQuery(Description)
+{
+}
+
+ezGALQueryNull::~ezGALQueryNull() {}
+
+ezResult ezGALQueryNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALQueryNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+void ezGALQueryNull::SetDebugNamePlatform(const char* szName) const {}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Resources_Implementation_QueryNull);
@@ -0,0 +1,80 @@
+#include <RendererNullPCH.h>
+
+#include <RendererFoundation/Resources/Texture.h>
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererNull/Resources/ResourceViewNull.h>
+
+// Resource view
+
+ezGALResourceViewNull::ezGALResourceViewNull(ezGALResourceBase* pResource, const ezGALResourceViewCreationDescription& Description)
+  : ezGALResourceView(pResource, Description)
+{
+}
+
+ezGALResourceViewNull::~ezGALResourceViewNull() {}
+
+ezResult ezGALResourceViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALResourceViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+// Render target view
+
+ezGALRenderTargetViewNull::ezGALRenderTargetViewNull(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description)
+  : ezGALRenderTargetView(pTexture, Description)
+{
+}
+
+ezGALRenderTargetViewNull::~ezGALRenderTargetViewNull() {}
+
+ezResult ezGALRenderTargetViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  ezGALDeviceNull* pNullDevice = static_cast<ezGALDeviceNull*>(pDevice);
+  const ezGALTextureCreationDescription& texDesc = m_pTexture->GetDescription();
+
+  if (m_Description.m_uiMipLevel >= texDesc.m_uiMipLevelCount)
+  {
+    ezLog::Error("Render target view mip level {0} is out of range, the texture has {1} mip levels", m_Description.m_uiMipLevel, texDesc.m_uiMipLevelCount);
+    ++pNullDevice->m_FrameStats.m_uiValidationErrors;
+    return EZ_FAILURE;
+  }
+
+  ezGALResourceFormat::Enum viewFormat = texDesc.m_Format;
+  if (m_Description.m_OverrideViewFormat != ezGALResourceFormat::Invalid)
+    viewFormat = m_Description.m_OverrideViewFormat;
+
+  m_bIsDepthStencilView = ezGALResourceFormat::IsDepthFormat(viewFormat);
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALRenderTargetViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+// Unordered access view
+
+ezGALUnorderedAccessViewNull::ezGALUnorderedAccessViewNull(ezGALResourceBase* pResource, const ezGALUnorderedAccessViewCreationDescription& Description)
+  : ezGALUnorderedAccessView(pResource, Description)
+{
+}
+
+ezGALUnorderedAccessViewNull::~ezGALUnorderedAccessViewNull() {}
+
+ezResult ezGALUnorderedAccessViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALUnorderedAccessViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Resources_Implementation_ResourceViewNull);
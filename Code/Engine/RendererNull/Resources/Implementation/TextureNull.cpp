@@ -0,0 +1,82 @@
+#include <RendererNullPCH.h>
+
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererNull/Resources/TextureNull.h>
+
+ezGALTextureNull::ezGALTextureNull(const ezGALTextureCreationDescription& Description)
+  : ezGALTexture(Description)
+  , m_pExisitingNativeObject(Description.m_pExisitingNativeObject)
+{
+}
+
+ezGALTextureNull::~ezGALTextureNull() {}
+
+ezResult ezGALTextureNull::InitPlatform(ezGALDevice* pDevice, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData)
+{
+  ezGALDeviceNull* pNullDevice = static_cast<ezGALDeviceNull*>(pDevice);
+  const ezGALDeviceCapabilities& caps = pNullDevice->GetCapabilities();
+
+  if (m_Description.m_Format == ezGALResourceFormat::Invalid)
+  {
+    ezLog::Error("Trying to create a texture without a format is not possible!");
+    ++pNullDevice->m_FrameStats.m_uiValidationErrors;
+    return EZ_FAILURE;
+  }
+
+  const ezUInt32 uiMaxDimension = m_Description.m_Type == ezGALTextureType::TextureCube
+                                    ? caps.m_uiMaxCubemapDimension
+                                    : (m_Description.m_Type == ezGALTextureType::Texture3D ? caps.m_uiMax3DTextureDimension : caps.m_uiMaxTextureDimension);
+
+  if (m_Description.m_uiWidth > uiMaxDimension || m_Description.m_uiHeight > uiMaxDimension || m_Description.m_uiDepth > uiMaxDimension)
+  {
+    ezLog::Error("Texture size {0}x{1}x{2} exceeds the maximum dimension of {3}", m_Description.m_uiWidth, m_Description.m_uiHeight, m_Description.m_uiDepth,
+      uiMaxDimension);
+    ++pNullDevice->m_FrameStats.m_uiValidationErrors;
+    return EZ_FAILURE;
+  }
+
+  const ezUInt32 uiMaxMipLevels = ezMath::Log2i(ezMath::Max(m_Description.m_uiWidth, ezMath::Max(m_Description.m_uiHeight, m_Description.m_uiDepth))) + 1;
+  if (m_Description.m_uiMipLevelCount == 0 || m_Description.m_uiMipLevelCount > uiMaxMipLevels)
+  {
+    ezLog::Error("Invalid mip level count {0} for a texture of size {1}x{2}x{3}", m_Description.m_uiMipLevelCount, m_Description.m_uiWidth,
+      m_Description.m_uiHeight, m_Description.m_uiDepth);
+    ++pNullDevice->m_FrameStats.m_uiValidationErrors;
+    return EZ_FAILURE;
+  }
+
+  if (m_Description.m_bCreateRenderTarget && m_Description.m_uiMipLevelCount > 1 && !m_Description.m_bAllowDynamicMipGeneration)
+  {
+    ezLog::Warning("Render target texture with {0} mip levels will only ever have its first mip level written", m_Description.m_uiMipLevelCount);
+  }
+
+  // one entry per mip level and array slice, like the other backends expect it
+  for (ezUInt32 i = 0; i < pInitialData.GetCount(); ++i)
+  {
+    const ezUInt32 uiMipLevel = i % m_Description.m_uiMipLevelCount;
+    const ezUInt32 uiMipHeight = ezMath::Max(m_Description.m_uiHeight >> uiMipLevel, 1u);
+    const ezUInt32 uiMipDepth = ezMath::Max(m_Description.m_uiDepth >> uiMipLevel, 1u);
+
+    const ezGALSystemMemoryDescription& data = pInitialData[i];
+    pNullDevice->m_FrameStats.m_uiBytesUploaded += data.m_uiSlicePitch != 0 ? (ezUInt64)data.m_uiSlicePitch * uiMipDepth : (ezUInt64)data.m_uiRowPitch * uiMipHeight;
+  }
+
+  ++pNullDevice->m_FrameStats.m_uiResourcesCreated;
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALTextureNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  m_pExisitingNativeObject = nullptr;
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALTextureNull::ReplaceExisitingNativeObject(void* pExisitingNativeObject)
+{
+  m_pExisitingNativeObject = pExisitingNativeObject;
+  return EZ_SUCCESS;
+}
+
+void ezGALTextureNull::SetDebugNamePlatform(const char* szName) const {}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Resources_Implementation_TextureNull);
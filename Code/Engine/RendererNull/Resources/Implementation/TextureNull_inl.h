@@ -0,0 +1,4 @@
+EZ_ALWAYS_INLINE void* ezGALTextureNull::GetExisitingNativeObject() const
+{
+  return m_pExisitingNativeObject;
+}
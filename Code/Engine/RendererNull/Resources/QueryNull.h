@@ -0,0 +1,27 @@
+#pragma once
+
+#include <RendererFoundation/Resources/Query.h>
+#include <RendererNull/RendererNullDLL.h>
+
+/// \brief Query of the null device. Only tracks whether it is in flight to validate Begin/End pairs and always reports a result of zero.
+class EZ_RENDERERNULL_DLL ezGALQueryNull : public ezGALQuery
+{
+public:
+  EZ_ALWAYS_INLINE bool IsActive() const { return m_bActive; }
+
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezGALContextNull;
+  friend class ezMemoryUtils;
+
+  ezGALQueryNull(const ezGALQueryCreationDescription& Description);
+  ~ezGALQueryNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+
+  virtual void SetDebugNamePlatform(const char* szName) const override;
+
+  mutable bool m_bActive = false;
+  mutable bool m_bHasResult = false;
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <RendererFoundation/Resources/RenderTargetView.h>
+#include <RendererFoundation/Resources/ResourceView.h>
+#include <RendererFoundation/Resources/UnorderedAccesView.h>
+#include <RendererNull/RendererNullDLL.h>
+
+class EZ_RENDERERNULL_DLL ezGALResourceViewNull : public ezGALResourceView
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALResourceViewNull(ezGALResourceBase* pResource, const ezGALResourceViewCreationDescription& Description);
+
+  ~ezGALResourceViewNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
+
+class EZ_RENDERERNULL_DLL ezGALRenderTargetViewNull : public ezGALRenderTargetView
+{
+public:
+  EZ_ALWAYS_INLINE bool IsDepthStencilView() const { return m_bIsDepthStencilView; }
+
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALRenderTargetViewNull(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description);
+
+  virtual ~ezGALRenderTargetViewNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+
+  bool m_bIsDepthStencilView = false;
+};
+
+class EZ_RENDERERNULL_DLL ezGALUnorderedAccessViewNull : public ezGALUnorderedAccessView
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALUnorderedAccessViewNull(ezGALResourceBase* pResource, const ezGALUnorderedAccessViewCreationDescription& Description);
+
+  ~ezGALUnorderedAccessViewNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+};
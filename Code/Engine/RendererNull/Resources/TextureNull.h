@@ -0,0 +1,29 @@
+#pragma once
+
+#include <RendererFoundation/Resources/Texture.h>
+#include <RendererNull/RendererNullDLL.h>
+
+class EZ_RENDERERNULL_DLL ezGALTextureNull : public ezGALTexture
+{
+public:
+  /// \brief The null device does not create native objects, this is only the pointer that was passed in by the user.
+  EZ_ALWAYS_INLINE void* GetExisitingNativeObject() const;
+
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALTextureNull(const ezGALTextureCreationDescription& Description);
+
+  ~ezGALTextureNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult ReplaceExisitingNativeObject(void* pExisitingNativeObject) override;
+
+  virtual void SetDebugNamePlatform(const char* szName) const override;
+
+  void* m_pExisitingNativeObject = nullptr;
+};
+
+#include <RendererNull/Resources/Implementation/TextureNull_inl.h>
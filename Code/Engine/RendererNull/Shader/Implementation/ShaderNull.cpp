@@ -0,0 +1,63 @@
+#include <RendererNullPCH.h>
+
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererNull/Shader/ShaderNull.h>
+
+ezGALShaderNull::ezGALShaderNull(const ezGALShaderCreationDescription& Description)
+  : ezGALShader(Description)
+{
+  for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+  {
+    m_bHasStage[stage] = false;
+  }
+}
+
+ezGALShaderNull::~ezGALShaderNull() {}
+
+void ezGALShaderNull::SetDebugName(const char* szName) const {}
+
+ezResult ezGALShaderNull::InitPlatform(ezGALDevice* pDevice)
+{
+  ezGALDeviceNull* pNullDevice = static_cast<ezGALDeviceNull*>(pDevice);
+
+  bool bAnyStage = false;
+
+  for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+  {
+    if (!m_Description.HasByteCodeForStage((ezGALShaderStage::Enum)stage))
+      continue;
+
+    if (!pNullDevice->GetCapabilities().m_bShaderStageSupported[stage])
+    {
+      ezLog::Error("Shader stage '{0}' is not supported by the device", ezGALShaderStage::Names[stage]);
+      ++pNullDevice->m_FrameStats.m_uiValidationErrors;
+      return EZ_FAILURE;
+    }
+
+    m_bHasStage[stage] = true;
+    bAnyStage = true;
+  }
+
+  if (!bAnyStage)
+  {
+    ezLog::Error("Trying to create a shader without any byte code");
+    ++pNullDevice->m_FrameStats.m_uiValidationErrors;
+    return EZ_FAILURE;
+  }
+
+  if (m_bHasStage[ezGALShaderStage::ComputeShader] && (m_bHasStage[ezGALShaderStage::VertexShader] || m_bHasStage[ezGALShaderStage::PixelShader]))
+  {
+    ezLog::Error("A compute shader can't be combined with graphics shader stages");
+    ++pNullDevice->m_FrameStats.m_uiValidationErrors;
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALShaderNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Shader_Implementation_ShaderNull);
@@ -0,0 +1,4 @@
+EZ_ALWAYS_INLINE bool ezGALShaderNull::HasStage(ezGALShaderStage::Enum stage) const
+{
+  return m_bHasStage[stage];
+}
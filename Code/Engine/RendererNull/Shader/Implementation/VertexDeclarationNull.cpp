@@ -0,0 +1,46 @@
+#include <RendererNullPCH.h>
+
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererNull/Shader/ShaderNull.h>
+#include <RendererNull/Shader/VertexDeclarationNull.h>
+
+ezGALVertexDeclarationNull::ezGALVertexDeclarationNull(const ezGALVertexDeclarationCreationDescription& Description)
+  : ezGALVertexDeclaration(Description)
+{
+}
+
+ezGALVertexDeclarationNull::~ezGALVertexDeclarationNull() = default;
+
+ezResult ezGALVertexDeclarationNull::InitPlatform(ezGALDevice* pDevice)
+{
+  ezGALDeviceNull* pNullDevice = static_cast<ezGALDeviceNull*>(pDevice);
+
+  const ezGALShaderNull* pShader = static_cast<const ezGALShaderNull*>(pDevice->GetShader(m_Description.m_hShader));
+
+  if (pShader == nullptr || !pShader->HasStage(ezGALShaderStage::VertexShader))
+  {
+    ezLog::Error("A vertex declaration needs a shader with a vertex shader stage");
+    ++pNullDevice->m_FrameStats.m_uiValidationErrors;
+    return EZ_FAILURE;
+  }
+
+  for (const ezGALVertexAttribute& attribute : m_Description.m_VertexAttributes)
+  {
+    if (attribute.m_eFormat == ezGALResourceFormat::Invalid || attribute.m_uiVertexBufferSlot >= EZ_GAL_MAX_VERTEX_BUFFER_COUNT)
+    {
+      ezLog::Error("Invalid vertex attribute '{0}' (format {1}, vertex buffer slot {2})", (ezUInt32)attribute.m_eSemantic, (ezUInt32)attribute.m_eFormat,
+        attribute.m_uiVertexBufferSlot);
+      ++pNullDevice->m_FrameStats.m_uiValidationErrors;
+      return EZ_FAILURE;
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALVertexDeclarationNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Shader_Implementation_VertexDeclarationNull);
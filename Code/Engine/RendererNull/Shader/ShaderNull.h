@@ -0,0 +1,30 @@
+#pragma once
+
+#include <RendererFoundation/RendererFoundationDLL.h>
+#include <RendererFoundation/Shader/Shader.h>
+#include <RendererNull/RendererNullDLL.h>
+
+/// \brief The null device accepts any non-empty byte code, so shader stages only need to be present, not valid for any actual API.
+class EZ_RENDERERNULL_DLL ezGALShaderNull : public ezGALShader
+{
+public:
+  void SetDebugName(const char* szName) const override;
+
+  EZ_ALWAYS_INLINE bool HasStage(ezGALShaderStage::Enum stage) const;
+
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALShaderNull(const ezGALShaderCreationDescription& description);
+
+  virtual ~ezGALShaderNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+
+  bool m_bHasStage[ezGALShaderStage::ENUM_COUNT];
+};
+
+#include <RendererNull/Shader/Implementation/ShaderNull_inl.h>
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <RendererFoundation/RendererFoundationDLL.h>
+#include <RendererFoundation/Shader/VertexDeclaration.h>
+#include <RendererNull/RendererNullDLL.h>
+
+class EZ_RENDERERNULL_DLL ezGALVertexDeclarationNull : public ezGALVertexDeclaration
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+
+  ezGALVertexDeclarationNull(const ezGALVertexDeclarationCreationDescription& Description);
+
+  virtual ~ezGALVertexDeclarationNull();
+};
@@ -0,0 +1,109 @@
+#include <RendererNullPCH.h>
+
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererNull/State/StateNull.h>
+
+// Blend state
+
+ezGALBlendStateNull::ezGALBlendStateNull(const ezGALBlendStateCreationDescription& Description)
+  : ezGALBlendState(Description)
+{
+}
+
+ezGALBlendStateNull::~ezGALBlendStateNull() {}
+
+ezResult ezGALBlendStateNull::InitPlatform(ezGALDevice* pDevice)
+{
+  ezGALDeviceNull* pNullDevice = static_cast<ezGALDeviceNull*>(pDevice);
+
+  if (m_Description.m_bAlphaToCoverage && !pNullDevice->GetCapabilities().m_bAlphaToCoverage)
+  {
+    ezLog::Error("Alpha-to-coverage is not supported by the device");
+    ++pNullDevice->m_FrameStats.m_uiValidationErrors;
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALBlendStateNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+// Depth Stencil state
+
+ezGALDepthStencilStateNull::ezGALDepthStencilStateNull(const ezGALDepthStencilStateCreationDescription& Description)
+  : ezGALDepthStencilState(Description)
+{
+}
+
+ezGALDepthStencilStateNull::~ezGALDepthStencilStateNull() {}
+
+ezResult ezGALDepthStencilStateNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALDepthStencilStateNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+// Rasterizer state
+
+ezGALRasterizerStateNull::ezGALRasterizerStateNull(const ezGALRasterizerStateCreationDescription& Description)
+  : ezGALRasterizerState(Description)
+{
+}
+
+ezGALRasterizerStateNull::~ezGALRasterizerStateNull() {}
+
+ezResult ezGALRasterizerStateNull::InitPlatform(ezGALDevice* pDevice)
+{
+  ezGALDeviceNull* pNullDevice = static_cast<ezGALDeviceNull*>(pDevice);
+
+  if (m_Description.m_bConservativeRasterization && !pNullDevice->GetCapabilities().m_bConservativeRasterization)
+  {
+    ezLog::Error("Conservative rasterization is not supported by the device");
+    ++pNullDevice->m_FrameStats.m_uiValidationErrors;
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALRasterizerStateNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+// Sampler state
+
+ezGALSamplerStateNull::ezGALSamplerStateNull(const ezGALSamplerStateCreationDescription& Description)
+  : ezGALSamplerState(Description)
+{
+}
+
+ezGALSamplerStateNull::~ezGALSamplerStateNull() {}
+
+ezResult ezGALSamplerStateNull::InitPlatform(ezGALDevice* pDevice)
+{
+  ezGALDeviceNull* pNullDevice = static_cast<ezGALDeviceNull*>(pDevice);
+
+  if (m_Description.m_uiMaxAnisotropy > pNullDevice->GetCapabilities().m_uiMaxAnisotropy)
+  {
+    ezLog::Error("Sampler anisotropy {0} exceeds the maximum of {1}", m_Description.m_uiMaxAnisotropy, pNullDevice->GetCapabilities().m_uiMaxAnisotropy);
+    ++pNullDevice->m_FrameStats.m_uiValidationErrors;
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALSamplerStateNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_State_Implementation_StateNull);
@@ -122,6 +122,16 @@ static const ezUInt32 ezDdsMagic = 0x20534444;
 static const ezUInt32 ezDdsDxt10FourCc = 0x30315844;
 
 ezResult ezDdsFileFormat::ReadImage(ezStreamReader& stream, ezImage& image, ezLogInterface* pLog, const char* szFileExtension) const
+{
+  return ReadImage(stream, image, pLog, false);
+}
+
+ezResult ezDdsFileFormat::ReadImageInPlace(ezStreamReader& stream, ezImage& image, ezLogInterface* pLog) const
+{
+  return ReadImage(stream, image, pLog, true);
+}
+
+ezResult ezDdsFileFormat::ReadImage(ezStreamReader& stream, ezImage& image, ezLogInterface* pLog, bool bInPlace) const
 {
   ezDdsHeader fileHeader;
   if (stream.ReadBytes(&fileHeader, sizeof(ezDdsHeader)) != sizeof(ezDdsHeader))
@@ -261,7 +271,20 @@ ezResult ezDdsFileFormat::ReadImage(ezStreamReader& stream, ezImage& image, ezLo
     imageHeader.SetDepth(fileHeader.m_uiDepth);
   }
 
-  image.ResetAndAlloc(imageHeader);
+  const ezUInt64 uiDataSize = imageHeader.ComputeDataSize();
+
+  ezArrayPtr<const ezUInt8> streamData;
+  const bool bUseStreamData = bInPlace && stream.GetRemainingContiguousData(streamData) && streamData.GetCount() >= uiDataSize;
+
+  if (bUseStreamData)
+  {
+    // the image is only read, so it can point into read-only memory
+    image.ResetAndUseExternalStorage(imageHeader, ezByteBlobPtr(const_cast<ezUInt8*>(streamData.GetPtr()), uiDataSize));
+  }
+  else
+  {
+    image.ResetAndAlloc(imageHeader);
+  }
 
   // If pitch is specified, it must match the computed value
   if (bPitch && image.GetRowPitch(0) != fileHeader.m_uiPitchOrLinearSize)
@@ -270,7 +293,11 @@ ezResult ezDdsFileFormat::ReadImage(ezStreamReader& stream, ezImage& image, ezLo
     return EZ_FAILURE;
   }
 
-  ezUInt64 uiDataSize = image.GetByteBlobPtr().GetCount();
+  if (bUseStreamData)
+  {
+    stream.SkipBytes(uiDataSize);
+    return EZ_SUCCESS;
+  }
 
   if (stream.ReadBytes(image.GetByteBlobPtr().GetPtr(), uiDataSize) != uiDataSize)
   {
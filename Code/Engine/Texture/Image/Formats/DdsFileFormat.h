@@ -6,6 +6,18 @@ class EZ_TEXTURE_DLL ezDdsFileFormat : public ezImageFileFormat
 {
 public:
   virtual ezResult ReadImage(ezStreamReader& stream, ezImage& image, ezLogInterface* pLog, const char* szFileExtension) const override;
+
+  /// \brief Same as ReadImage(), but if \a stream keeps its data in memory (see ezStreamReader::GetRemainingContiguousData()), \a image
+  /// references the pixel data in that memory instead of copying it.
+  ///
+  /// The memory of the stream must stay valid as long as \a image is used. The image must not be modified, e.g. memory mapped files are
+  /// read-only. Call ezImage::Clear() before reusing it.
+  ezResult ReadImageInPlace(ezStreamReader& stream, ezImage& image, ezLogInterface* pLog) const;
+
+private:
+  ezResult ReadImage(ezStreamReader& stream, ezImage& image, ezLogInterface* pLog, bool bInPlace) const;
+
+public:
   virtual ezResult WriteImage(ezStreamWriter& stream, const ezImageView& image, ezLogInterface* pLog, const char* szFileExtension) const override;
 
   virtual bool CanReadFileType(const char* szExtension) const override;
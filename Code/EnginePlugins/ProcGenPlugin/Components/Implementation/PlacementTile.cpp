@@ -112,46 +112,73 @@ void PlacementTile::PreparePlacementData(const ezPhysicsWorldModuleInterface* pP
 
 ezUInt32 PlacementTile::PlaceObjects(ezWorld& world, ezArrayPtr<const PlacementTransform> objectTransforms)
 {
-  ezGameObjectDesc desc;
   auto& objectsToPlace = m_pOutput->m_ObjectsToPlace;
 
-  ezHybridArray<ezPrefabResource*, 4> prefabs;
-  prefabs.SetCount(objectsToPlace.GetCount());
+  // bucket the transforms by prefab in one pass, each bucket keeps the original order of its transforms
+  ezHybridArray<ezUInt32, 16> bucketOffsets;
+  bucketOffsets.SetCount(objectsToPlace.GetCount() + 1);
 
   for (auto& objectTransform : objectTransforms)
   {
-    const ezUInt32 uiObjectIndex = objectTransform.m_uiObjectIndex;
-    ezPrefabResource* pPrefab = prefabs[uiObjectIndex];
+    ++bucketOffsets[objectTransform.m_uiObjectIndex + 1];
+  }
+
+  for (ezUInt32 uiObjectIndex = 0; uiObjectIndex < objectsToPlace.GetCount(); ++uiObjectIndex)
+  {
+    bucketOffsets[uiObjectIndex + 1] += bucketOffsets[uiObjectIndex];
+  }
+
+  ezDynamicArray<ezTransform> transforms;
+  transforms.SetCountUninitialized(objectTransforms.GetCount());
+  ezDynamicArray<ezColorGammaUB> colors;
+  colors.SetCountUninitialized(objectTransforms.GetCount());
+
+  {
+    ezHybridArray<ezUInt32, 16> writeOffsets;
+    writeOffsets = bucketOffsets.GetArrayPtr().GetSubArray(0, objectsToPlace.GetCount());
+
+    for (auto& objectTransform : objectTransforms)
+    {
+      const ezUInt32 uiTargetIndex = writeOffsets[objectTransform.m_uiObjectIndex]++;
+      transforms[uiTargetIndex] = ezSimdConversion::ToTransform(objectTransform.m_Transform);
+      colors[uiTargetIndex] = objectTransform.m_Color;
+    }
+  }
+
+  ezDynamicArray<ezGameObject*> rootObjects;
+
+  // instantiate all objects of the same prefab in one batch
+  for (ezUInt32 uiObjectIndex = 0; uiObjectIndex < objectsToPlace.GetCount(); ++uiObjectIndex)
+  {
+    const ezUInt32 uiFirstTransform = bucketOffsets[uiObjectIndex];
+    const ezUInt32 uiNumTransforms = bucketOffsets[uiObjectIndex + 1] - uiFirstTransform;
+
+    if (uiNumTransforms == 0)
+      continue;
+
+    rootObjects.Clear();
 
-    if (pPrefab == nullptr)
     {
-      pPrefab = ezResourceManager::BeginAcquireResource(objectsToPlace[uiObjectIndex], ezResourceAcquireMode::BlockTillLoaded);
-      prefabs[uiObjectIndex] = pPrefab;
+      ezResourceLock<ezPrefabResource> pPrefab(objectsToPlace[uiObjectIndex], ezResourceAcquireMode::BlockTillLoaded);
+      pPrefab->InstantiatePrefabs(world, transforms.GetArrayPtr().GetSubArray(uiFirstTransform, uiNumTransforms), ezGameObjectHandle(), &rootObjects, nullptr, false);
     }
 
-    ezTransform transform = ezSimdConversion::ToTransform(objectTransform.m_Transform);
-    ezHybridArray<ezGameObject*, 8> rootObjects;
-    pPrefab->InstantiatePrefab(world, transform, ezGameObjectHandle(), &rootObjects, nullptr, nullptr, false);
+    // every instance creates the same number of root objects
+    const ezUInt32 uiRootObjectsPerInstance = rootObjects.GetCount() / uiNumTransforms;
 
-    for (auto pRootObject : rootObjects)
+    for (ezUInt32 i = 0; i < rootObjects.GetCount(); ++i)
     {
+      ezGameObject* pRootObject = rootObjects[i];
+
       // Set the color
       ezMsgSetColor msg;
-      msg.m_Color = objectTransform.m_Color;
+      msg.m_Color = colors[uiFirstTransform + i / uiRootObjectsPerInstance];
       pRootObject->PostMessageRecursive(msg, ezTime::Zero(), ezObjectMsgQueueType::AfterInitialized);
 
       m_PlacedObjects.PushBack(pRootObject->GetHandle());
     }
   }
 
-  for (auto pPrefab : prefabs)
-  {
-    if (pPrefab != nullptr)
-    {
-      ezResourceManager::EndAcquireResource(pPrefab);
-    }
-  }
-
   m_State = State::Finished;
 
   return m_PlacedObjects.GetCount();
@@ -10,9 +10,27 @@ public:
   ezExpressionCompiler();
   ~ezExpressionCompiler();
 
-  ezResult Compile(ezExpressionAST& ast, ezExpressionByteCode& out_byteCode);
+  /// \brief Compiles the given AST to byte code.
+  ///
+  /// If \a bOptimize is set, constant folding, algebraic simplification and common subexpression elimination are applied
+  /// before the byte code is generated. Nodes that are not reachable from an output are never emitted.
+  /// By default only transformations are applied that give bit identical results to the unoptimized byte code, e.g. x * 1 => x.
+  /// \a bAllowInexactMath additionally enables transformations that may differ in rounding or in the handling of infinity and NaN:
+  /// x / c => (1 / c) * x, reassociation of constants, 0 * x => 0, x + 0 => x and reordering of min/max operands.
+  ///
+  /// \note The optimizations are applied to \a ast in place, the nodes are rewired and new nodes are allocated in it.
+  /// The AST still computes the same outputs afterwards, but it must not be expected to have its original structure.
+  ezResult Compile(ezExpressionAST& ast, ezExpressionByteCode& out_byteCode, bool bOptimize = true, bool bAllowInexactMath = false);
+
+  /// \brief Returns the number of instructions the last compiled AST would have needed without optimizations.
+  ezUInt32 GetNumUnoptimizedInstructions() const { return m_uiNumUnoptimizedInstructions; }
 
 private:
+  void OptimizeAST(ezExpressionAST& ast);
+  ezExpressionAST::Node* OptimizeNode(ezExpressionAST& ast, ezExpressionAST::Node* pNode);
+  ezExpressionAST::Node* SimplifyNode(ezExpressionAST& ast, ezExpressionAST::Node* pNode);
+  ezExpressionAST::Node* FindOrAddUniqueNode(ezExpressionAST::Node* pNode);
+
   ezResult BuildNodeInstructions(const ezExpressionAST& ast);
   ezResult UpdateRegisterLifetime(const ezExpressionAST& ast);
   ezResult AssignRegisters();
@@ -22,6 +40,11 @@ private:
   ezHybridArray<const ezExpressionAST::Node*, 64> m_NodeInstructions;
   ezHashTable<const ezExpressionAST::Node*, ezUInt32> m_NodeToRegisterIndex;
 
+  ezHashTable<ezExpressionAST::Node*, ezExpressionAST::Node*> m_OptimizedNodes;
+  ezHashTable<ezUInt32, ezHybridArray<ezExpressionAST::Node*, 1>> m_UniqueNodes;
+  ezUInt32 m_uiNumUnoptimizedInstructions = 0;
+  bool m_bAllowInexactMath = false;
+
   ezHashTable<ezHashedString, ezUInt32> m_InputToIndex;
   ezHashTable<ezHashedString, ezUInt32> m_OutputToIndex;
   ezHashTable<ezHashedString, ezUInt32> m_FunctionToIndex;
@@ -1,5 +1,7 @@
 #include <ProcGenPluginPCH.h>
 
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/SimdMath/SimdMath.h>
 #include <ProcGenPlugin/VM/ExpressionByteCode.h>
 #include <ProcGenPlugin/VM/ExpressionCompiler.h>
 
@@ -45,16 +47,174 @@ namespace
         return ezExpressionByteCode::OpCode::FirstUnary;
     }
   }
+
+  static float GetConstantValue(const ezExpressionAST::Node* pNode)
+  {
+    return static_cast<const ezExpressionAST::Constant*>(pNode)->m_Value.Get<float>();
+  }
+
+  static ezUInt32 GetConstantBits(const ezExpressionAST::Node* pNode)
+  {
+    float fValue = GetConstantValue(pNode);
+    return *reinterpret_cast<const ezUInt32*>(&fValue);
+  }
+
+  // Constants are folded with the same simd functions as the VM uses, so the result is identical to the unoptimized byte code.
+  static float EvaluateUnary(ezExpressionAST::NodeType::Enum nodeType, float fOperand)
+  {
+    const ezSimdVec4f x(fOperand);
+
+    switch (nodeType)
+    {
+      case ezExpressionAST::NodeType::Negate:
+        return (-x).x();
+      case ezExpressionAST::NodeType::Absolute:
+        return x.Abs().x();
+      case ezExpressionAST::NodeType::Sqrt:
+        return x.GetSqrt().x();
+      case ezExpressionAST::NodeType::Sin:
+        return ezSimdMath::Sin(x).x();
+      case ezExpressionAST::NodeType::Cos:
+        return ezSimdMath::Cos(x).x();
+      case ezExpressionAST::NodeType::Tan:
+        return ezSimdMath::Tan(x).x();
+      case ezExpressionAST::NodeType::ASin:
+        return ezSimdMath::ASin(x).x();
+      case ezExpressionAST::NodeType::ACos:
+        return ezSimdMath::ACos(x).x();
+      case ezExpressionAST::NodeType::ATan:
+        return ezSimdMath::ATan(x).x();
+      default:
+        EZ_ASSERT_NOT_IMPLEMENTED;
+        return 0.0f;
+    }
+  }
+
+  static float EvaluateBinary(ezExpressionAST::NodeType::Enum nodeType, float fLeftOperand, float fRightOperand)
+  {
+    const ezSimdVec4f a(fLeftOperand);
+    const ezSimdVec4f b(fRightOperand);
+
+    switch (nodeType)
+    {
+      case ezExpressionAST::NodeType::Add:
+        return (a + b).x();
+      case ezExpressionAST::NodeType::Subtract:
+        return (a - b).x();
+      case ezExpressionAST::NodeType::Multiply:
+        return a.CompMul(b).x();
+      case ezExpressionAST::NodeType::Divide:
+        return a.CompDiv(b).x();
+      case ezExpressionAST::NodeType::Min:
+        return a.CompMin(b).x();
+      case ezExpressionAST::NodeType::Max:
+        return a.CompMax(b).x();
+      default:
+        EZ_ASSERT_NOT_IMPLEMENTED;
+        return 0.0f;
+    }
+  }
+
+  static bool IsAssociative(ezExpressionAST::NodeType::Enum nodeType)
+  {
+    return nodeType == ezExpressionAST::NodeType::Add || nodeType == ezExpressionAST::NodeType::Multiply ||
+           nodeType == ezExpressionAST::NodeType::Min || nodeType == ezExpressionAST::NodeType::Max;
+  }
+
+  // Add and multiply give bit identical results for swapped operands. Min and max don't, the simd implementation returns the second operand if one of them is NaN.
+  static bool IsExactlyCommutative(ezExpressionAST::NodeType::Enum nodeType)
+  {
+    return nodeType == ezExpressionAST::NodeType::Add || nodeType == ezExpressionAST::NodeType::Multiply;
+  }
+
+  static bool IsNegativeZero(const ezExpressionAST::Node* pNode)
+  {
+    return GetConstantBits(pNode) == 0x80000000u;
+  }
+
+  static ezUInt32 HashNode(const ezExpressionAST::Node* pNode)
+  {
+    const ezExpressionAST::NodeType::Enum nodeType = pNode->m_Type;
+
+    ezHybridArray<ezUInt64, 8> data;
+    data.PushBack(static_cast<ezUInt64>(nodeType));
+    if (ezExpressionAST::NodeType::IsConstant(nodeType))
+    {
+      data.PushBack(GetConstantBits(pNode));
+    }
+    else if (ezExpressionAST::NodeType::IsInput(nodeType))
+    {
+      data.PushBack(static_cast<const ezExpressionAST::Input*>(pNode)->m_sName.GetHash());
+    }
+    else if (nodeType == ezExpressionAST::NodeType::FunctionCall)
+    {
+      data.PushBack(static_cast<const ezExpressionAST::FunctionCall*>(pNode)->m_sName.GetHash());
+    }
+
+    // Children are already unique at this point so comparing their addresses is sufficient
+    for (auto pChild : ezExpressionAST::GetChildren(pNode))
+    {
+      data.PushBack(reinterpret_cast<size_t>(pChild));
+    }
+
+    return ezHashingUtils::xxHash32(data.GetData(), data.GetCount() * sizeof(ezUInt64));
+  }
+
+  static bool IsEqual(const ezExpressionAST::Node* a, const ezExpressionAST::Node* b)
+  {
+    if (a->m_Type != b->m_Type)
+      return false;
+
+    const ezExpressionAST::NodeType::Enum nodeType = a->m_Type;
+    if (ezExpressionAST::NodeType::IsConstant(nodeType))
+    {
+      return GetConstantBits(a) == GetConstantBits(b);
+    }
+    else if (ezExpressionAST::NodeType::IsInput(nodeType))
+    {
+      return static_cast<const ezExpressionAST::Input*>(a)->m_sName == static_cast<const ezExpressionAST::Input*>(b)->m_sName;
+    }
+    else if (nodeType == ezExpressionAST::NodeType::FunctionCall)
+    {
+      if (static_cast<const ezExpressionAST::FunctionCall*>(a)->m_sName != static_cast<const ezExpressionAST::FunctionCall*>(b)->m_sName)
+        return false;
+    }
+
+    auto childrenA = ezExpressionAST::GetChildren(a);
+    auto childrenB = ezExpressionAST::GetChildren(b);
+    if (childrenA.GetCount() != childrenB.GetCount())
+      return false;
+
+    for (ezUInt32 i = 0; i < childrenA.GetCount(); ++i)
+    {
+      if (childrenA[i] != childrenB[i])
+        return false;
+    }
+
+    return true;
+  }
 } // namespace
 
 ezExpressionCompiler::ezExpressionCompiler() = default;
 ezExpressionCompiler::~ezExpressionCompiler() = default;
 
-ezResult ezExpressionCompiler::Compile(ezExpressionAST& ast, ezExpressionByteCode& out_byteCode)
+ezResult ezExpressionCompiler::Compile(ezExpressionAST& ast, ezExpressionByteCode& out_byteCode, bool bOptimize /*= true*/, bool bAllowInexactMath /*= false*/)
 {
+  m_bAllowInexactMath = bAllowInexactMath;
+
   if (BuildNodeInstructions(ast).Failed())
     return EZ_FAILURE;
 
+  m_uiNumUnoptimizedInstructions = m_NodeInstructions.GetCount();
+
+  if (bOptimize)
+  {
+    OptimizeAST(ast);
+
+    if (BuildNodeInstructions(ast).Failed())
+      return EZ_FAILURE;
+  }
+
   if (UpdateRegisterLifetime(ast).Failed())
     return EZ_FAILURE;
 
@@ -67,6 +227,181 @@ ezResult ezExpressionCompiler::Compile(ezExpressionAST& ast, ezExpressionByteCod
   return EZ_SUCCESS;
 }
 
+void ezExpressionCompiler::OptimizeAST(ezExpressionAST& ast)
+{
+  m_OptimizedNodes.Clear();
+  m_UniqueNodes.Clear();
+
+  // Dead code is removed implicitly, only nodes that are reachable from an output end up in the instruction list.
+  for (ezExpressionAST::Output* pOutputNode : ast.m_OutputNodes)
+  {
+    if (pOutputNode == nullptr)
+      continue;
+
+    pOutputNode->m_pExpression = OptimizeNode(ast, pOutputNode->m_pExpression);
+  }
+}
+
+ezExpressionAST::Node* ezExpressionCompiler::OptimizeNode(ezExpressionAST& ast, ezExpressionAST::Node* pNode)
+{
+  // Select has no code generation yet, leave it and null nodes alone so BuildNodeInstructions reports the error.
+  if (pNode == nullptr || pNode->m_Type == ezExpressionAST::NodeType::Select)
+    return pNode;
+
+  ezExpressionAST::Node* pOptimizedNode = nullptr;
+  if (m_OptimizedNodes.TryGetValue(pNode, pOptimizedNode))
+    return pOptimizedNode;
+
+  // Post order, children are folded and unique before their parent is looked at
+  for (auto& pChild : ezExpressionAST::GetChildren(pNode))
+  {
+    pChild = OptimizeNode(ast, pChild);
+    if (pChild == nullptr || pChild->m_Type == ezExpressionAST::NodeType::Select)
+    {
+      m_OptimizedNodes.Insert(pNode, pNode);
+      return pNode;
+    }
+  }
+
+  pOptimizedNode = FindOrAddUniqueNode(SimplifyNode(ast, pNode));
+  m_OptimizedNodes.Insert(pNode, pOptimizedNode);
+
+  return pOptimizedNode;
+}
+
+ezExpressionAST::Node* ezExpressionCompiler::SimplifyNode(ezExpressionAST& ast, ezExpressionAST::Node* pNode)
+{
+  const ezExpressionAST::NodeType::Enum nodeType = pNode->m_Type;
+
+  if (ezExpressionAST::NodeType::IsUnary(nodeType))
+  {
+    auto pUnary = static_cast<ezExpressionAST::UnaryOperator*>(pNode);
+    ezExpressionAST::Node* pOperand = pUnary->m_pOperand;
+
+    if (ezExpressionAST::NodeType::IsConstant(pOperand->m_Type))
+    {
+      return ast.CreateConstant(EvaluateUnary(nodeType, GetConstantValue(pOperand)));
+    }
+
+    if (nodeType == ezExpressionAST::NodeType::Negate)
+    {
+      // There is no negate instruction, -0 - x is an exact negation that maps to a single Sub_CR.
+      return ast.CreateBinaryOperator(ezExpressionAST::NodeType::Subtract, FindOrAddUniqueNode(ast.CreateConstant(-0.0f)), pOperand);
+    }
+
+    if (nodeType == ezExpressionAST::NodeType::Absolute && pOperand->m_Type == ezExpressionAST::NodeType::Absolute)
+    {
+      return pOperand;
+    }
+
+    return pNode;
+  }
+
+  if (ezExpressionAST::NodeType::IsBinary(nodeType))
+  {
+    auto pBinary = static_cast<ezExpressionAST::BinaryOperator*>(pNode);
+    ezExpressionAST::Node* pLeft = pBinary->m_pLeftOperand;
+    ezExpressionAST::Node* pRight = pBinary->m_pRightOperand;
+
+    const bool bLeftIsConstant = ezExpressionAST::NodeType::IsConstant(pLeft->m_Type);
+    const bool bRightIsConstant = ezExpressionAST::NodeType::IsConstant(pRight->m_Type);
+
+    if (bLeftIsConstant && bRightIsConstant)
+    {
+      return ast.CreateConstant(EvaluateBinary(nodeType, GetConstantValue(pLeft), GetConstantValue(pRight)));
+    }
+
+    if (bRightIsConstant)
+    {
+      // Move constants to the left, binary instructions can take a constant as left operand in place
+      // which saves the mov instruction for the constant.
+      const float fValue = GetConstantValue(pRight);
+      bool bMovedConstant = true;
+
+      if (IsExactlyCommutative(nodeType) || (m_bAllowInexactMath && IsAssociative(nodeType)))
+      {
+        pBinary->m_pLeftOperand = pRight;
+        pBinary->m_pRightOperand = pLeft;
+      }
+      else if (nodeType == ezExpressionAST::NodeType::Subtract)
+      {
+        // x - c => -c + x, exact since subtraction is defined as addition of the negated operand
+        pBinary->m_Type = ezExpressionAST::NodeType::Add;
+        pBinary->m_pLeftOperand = FindOrAddUniqueNode(ast.CreateConstant(-fValue));
+        pBinary->m_pRightOperand = pLeft;
+      }
+      else if (nodeType == ezExpressionAST::NodeType::Divide && m_bAllowInexactMath)
+      {
+        // x / c => (1 / c) * x, might differ from the division in the last bit
+        pBinary->m_Type = ezExpressionAST::NodeType::Multiply;
+        pBinary->m_pLeftOperand = FindOrAddUniqueNode(ast.CreateConstant(EvaluateBinary(nodeType, 1.0f, fValue)));
+        pBinary->m_pRightOperand = pLeft;
+      }
+      else
+      {
+        bMovedConstant = false;
+      }
+
+      if (bMovedConstant)
+      {
+        return SimplifyNode(ast, pBinary);
+      }
+    }
+    else if (bLeftIsConstant)
+    {
+      const float fValue = GetConstantValue(pLeft);
+
+      // -0 + x is exactly x, +0 + x turns -0 into +0
+      if ((nodeType == ezExpressionAST::NodeType::Add && (IsNegativeZero(pLeft) || (m_bAllowInexactMath && fValue == 0.0f))) ||
+          (nodeType == ezExpressionAST::NodeType::Multiply && fValue == 1.0f))
+      {
+        return pRight;
+      }
+
+      if (m_bAllowInexactMath && nodeType == ezExpressionAST::NodeType::Multiply && fValue == 0.0f)
+      {
+        // Ignores infinity and NaN in the right operand
+        return pLeft;
+      }
+
+      // c0 op (c1 op x) => (c0 op c1) op x, for add and multiply the result might differ in the last bit
+      if (m_bAllowInexactMath && IsAssociative(nodeType) && pRight->m_Type == nodeType)
+      {
+        auto pInner = static_cast<ezExpressionAST::BinaryOperator*>(pRight);
+        if (ezExpressionAST::NodeType::IsConstant(pInner->m_pLeftOperand->m_Type))
+        {
+          auto pConstant = FindOrAddUniqueNode(ast.CreateConstant(EvaluateBinary(nodeType, fValue, GetConstantValue(pInner->m_pLeftOperand))));
+          return SimplifyNode(ast, ast.CreateBinaryOperator(nodeType, pConstant, pInner->m_pRightOperand));
+        }
+      }
+
+      return pNode;
+    }
+
+    if (pLeft == pRight && (nodeType == ezExpressionAST::NodeType::Min || nodeType == ezExpressionAST::NodeType::Max))
+    {
+      return pLeft;
+    }
+
+    return pNode;
+  }
+
+  return pNode;
+}
+
+ezExpressionAST::Node* ezExpressionCompiler::FindOrAddUniqueNode(ezExpressionAST::Node* pNode)
+{
+  auto& candidates = m_UniqueNodes[HashNode(pNode)];
+  for (auto pCandidate : candidates)
+  {
+    if (IsEqual(pCandidate, pNode))
+      return pCandidate;
+  }
+
+  candidates.PushBack(pNode);
+  return pNode;
+}
+
 ezResult ezExpressionCompiler::BuildNodeInstructions(const ezExpressionAST& ast)
 {
   m_NodeStack.Clear();
@@ -125,6 +125,24 @@ EZ_RESOURCE_IMPLEMENT_CREATEABLE(ezRmlUiResource, ezRmlUiResourceDescriptor)
 
 //////////////////////////////////////////////////////////////////////////
 
+ezResourceLoadData ezRmlUiResourceLoader::OpenDataStream(const ezResource* pResource)
+{
+  ezResourceLoadData res = ezResourceLoaderFromFile::OpenDataStream(pResource);
+
+  // IsResourceOutdated also checks the files in the dependency file, so file watching must not skip this resource
+  res.m_sLoadedFilePath.Clear();
+  return res;
+}
+
+ezResourceLoadData ezRmlUiResourceLoader::OpenDataStreamFromFile(const ezResource* pResource, ezAsyncFileRead& file)
+{
+  ezResourceLoadData res = ezResourceLoaderFromFile::OpenDataStreamFromFile(pResource, file);
+
+  // see OpenDataStream()
+  res.m_sLoadedFilePath.Clear();
+  return res;
+}
+
 bool ezRmlUiResourceLoader::IsResourceOutdated(const ezResource* pResource) const
 {
   if (ezResourceLoaderFromFile::IsResourceOutdated(pResource))
@@ -59,5 +59,7 @@ private:
 class ezRmlUiResourceLoader : public ezResourceLoaderFromFile
 {
 public:
+  virtual ezResourceLoadData OpenDataStream(const ezResource* pResource) override;
+  virtual ezResourceLoadData OpenDataStreamFromFile(const ezResource* pResource, ezAsyncFileRead& file) override;
   virtual bool IsResourceOutdated(const ezResource* pResource) const override;
 };
@@ -275,22 +275,30 @@ void ezTypeScriptComponent::OnSimulationStarted()
   CallTsFunc("OnSimulationStarted");
 }
 
-void ezTypeScriptComponent::Update(ezTypeScriptBinding& binding)
+bool ezTypeScriptComponent::PrepareTick(ezTime tNow)
 {
   if (GetUserFlag(UserFlag::ScriptFailure) || GetUserFlag(UserFlag::NoTsTick))
-    return;
+    return false;
 
   if (m_UpdateInterval.IsNegative())
-    return;
+    return false;
 
-  const ezTime tNow = GetWorld()->GetClock().GetAccumulatedTime();
+  if (!m_ComponentTypeInfo.Value().m_bHasTickFunction)
+  {
+    SetUserFlag(UserFlag::NoTsTick, true);
+    return false;
+  }
 
   if (m_LastUpdate + m_UpdateInterval > tNow)
-    return;
-
-  EZ_PROFILE_SCOPE(GetOwner()->GetName());
+    return false;
 
   m_LastUpdate = tNow;
+  return true;
+}
+
+void ezTypeScriptComponent::Tick(ezTypeScriptBinding& binding)
+{
+  EZ_PROFILE_SCOPE(GetOwner()->GetName());
 
   ezDuktapeHelper duk(binding.GetDukTapeContext());
 
@@ -35,10 +35,17 @@ public:
 
   ezTypeScriptBinding& GetTsBinding() const { return m_TsBinding; }
 
+  /// \brief Returns how many components got ticked during the last update.
+  ezUInt32 GetNumTickedComponents() const { return m_uiNumTickedComponents; }
+
 private:
   void Update(const ezWorldModule::UpdateContext& context);
 
   mutable ezTypeScriptBinding m_TsBinding;
+
+  ezUInt32 m_uiNumTickedComponents = 0;
+  ezDynamicArray<ezTypeScriptComponent*> m_ComponentsToTick;
+  ezDynamicArray<ezUInt32> m_TickGroupEnds;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -94,7 +101,10 @@ private:
   ezHybridArray<EventSender, 2> m_EventSenders;
 
   bool CallTsFunc(const char* szFuncName);
-  void Update(ezTypeScriptBinding& script);
+
+  /// \brief Checks whether the tick interval has passed and if so, stores \a tNow as the time of the last tick.
+  bool PrepareTick(ezTime tNow);
+  void Tick(ezTypeScriptBinding& binding);
   void SetExposedVariables();
 
   ezTypeScriptBinding::TsComponentTypeInfo m_ComponentTypeInfo;
@@ -1,9 +1,12 @@
 #include <TypeScriptPluginPCH.h>
 
 #include <Duktape/duktape.h>
+#include <Foundation/Configuration/CVar.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <TypeScriptPlugin/Components/TypeScriptComponent.h>
 
+ezCVarBool CVarTsBatchTick("ts_BatchTick", true, ezCVarFlags::Default, "Ticks all TypeScript components with a single call into the script per frame");
+
 ezTypeScriptComponentManager::ezTypeScriptComponentManager(ezWorld* pWorld)
   : SUPER(pWorld)
 {
@@ -40,11 +43,57 @@ void ezTypeScriptComponentManager::Update(const ezWorldModule::UpdateContext& co
 
   m_TsBinding.Update();
 
+  const ezTime tNow = GetWorld()->GetClock().GetAccumulatedTime();
+
+  m_ComponentsToTick.Clear();
+
   for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
   {
-    if (it->IsActiveAndSimulating())
+    if (it->IsActiveAndSimulating() && it->PrepareTick(tNow))
+    {
+      m_ComponentsToTick.PushBack(it);
+    }
+  }
+
+  m_uiNumTickedComponents = m_ComponentsToTick.GetCount();
+
+  if (CVarTsBatchTick)
+  {
+    EZ_PROFILE_SCOPE("Tick (batched)");
+
+    // group the components by script type, the dispatcher then only needs to look up 'Tick' once per group
+    // the order only depends on the script type and the component handle, not on where anything was allocated
+    m_ComponentsToTick.Sort([](const ezTypeScriptComponent* a, const ezTypeScriptComponent* b) {
+      const ezUuid& typeA = a->m_ComponentTypeInfo.Key();
+      const ezUuid& typeB = b->m_ComponentTypeInfo.Key();
+
+      if (typeA != typeB)
+        return typeA < typeB;
+
+      return a->GetHandle() < b->GetHandle();
+    });
+
+    m_TickGroupEnds.Clear();
+    for (ezUInt32 i = 1; i < m_ComponentsToTick.GetCount(); ++i)
+    {
+      if (m_ComponentsToTick[i]->m_ComponentTypeInfo.Key() != m_ComponentsToTick[i - 1]->m_ComponentTypeInfo.Key())
+      {
+        m_TickGroupEnds.PushBack(i);
+      }
+    }
+
+    if (!m_ComponentsToTick.IsEmpty())
+    {
+      m_TickGroupEnds.PushBack(m_ComponentsToTick.GetCount());
+    }
+
+    m_TsBinding.TickComponents(m_ComponentsToTick, m_TickGroupEnds);
+  }
+  else
+  {
+    for (ezTypeScriptComponent* pComponent : m_ComponentsToTick)
     {
-      it->Update(m_TsBinding);
+      pComponent->Tick(m_TsBinding);
     }
   }
 
@@ -90,6 +90,7 @@ ezResult ezTypeScriptBinding::Initialize(ezWorld& world)
   SetupRttiPropertyBindings();
 
   EZ_SUCCEED_OR_RETURN(Init_RequireModules());
+  EZ_SUCCEED_OR_RETURN(Init_Math());
   EZ_SUCCEED_OR_RETURN(Init_Log());
   EZ_SUCCEED_OR_RETURN(Init_Utils());
   EZ_SUCCEED_OR_RETURN(Init_Time());
@@ -159,9 +160,36 @@ ezResult ezTypeScriptBinding::LoadComponent(const ezUuid& typeGuid, TsComponentT
 
   m_Duk.PopStack();
 
-  m_TsComponentTypes[typeGuid].m_sComponentTypeName = sComponentName;
+  TsComponentInfo& compInfo = m_TsComponentTypes[typeGuid];
+  compInfo.m_sComponentTypeName = sComponentName;
   RegisterMessageHandlersForComponentType(sComponentName, typeGuid);
 
+  // look up the 'Tick' function only once per type, components without one never need to be ticked
+  {
+    ezDuktapeHelper duk(m_Duk);
+
+    duk.PushGlobalObject();                           // [ global ]
+    if (duk.PushLocalObject(sCompModule).Succeeded()) // [ global __CompModule ]
+    {
+      if (duk.PushLocalObject(sComponentName).Succeeded()) // [ global __CompModule class ]
+      {
+        if (duk.PushLocalObject("prototype").Succeeded()) // [ global __CompModule class prototype ]
+        {
+          compInfo.m_bHasTickFunction = duk_get_prop_string(duk, -1, "Tick") && duk_is_function(duk, -1); // [ global __CompModule class prototype Tick ]
+          duk.PopStack(2);                                                                                 // [ global __CompModule class ]
+        }
+
+        duk.PopStack(); // [ global __CompModule ]
+      }
+
+      duk.PopStack(); // [ global ]
+    }
+
+    duk.PopStack(); // [ ]
+
+    EZ_DUK_VERIFY_STACK(duk, 0);
+  }
+
   bLoaded = true;
 
   out_TypeInfo = m_TsComponentTypes.FindOrAdd(typeGuid, nullptr);
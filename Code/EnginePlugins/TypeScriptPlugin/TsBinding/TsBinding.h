@@ -26,6 +26,28 @@ enum ezTypeScriptBindingIndexProperty
   GameObjectHandle
 };
 
+/// \brief The script types that are instantiated from C++ all the time. Their constructors are cached in the global stash by Init_Math().
+struct ezTypeScriptBindingConstructor
+{
+  enum Enum
+  {
+    Vec2,
+    Vec3,
+    Mat3,
+    Mat4,
+    Quat,
+    Color,
+    Transform,
+    HitResult,
+
+    ENUM_COUNT,
+
+    /// The integer key of the first constructor in the global stash. The keys below 512 are free, stashed messages use the integer keys
+    /// from 512 on and stashed objects the ones from 1024 on.
+    FirstStashIndex = 0
+  };
+};
+
 class EZ_TYPESCRIPTPLUGIN_DLL ezTypeScriptBinding
 {
 public:
@@ -40,6 +62,7 @@ public:
   {
     ezString m_sComponentTypeName;
     ezHybridArray<TsMessageHandler, 4> m_MessageHandlers;
+    bool m_bHasTickFunction = false;
   };
 
   using TsComponentTypeInfo = ezMap<ezUuid, TsComponentInfo>::ConstIterator;
@@ -172,6 +195,7 @@ private:
   ///@{
 private:
   ezResult Init_RequireModules();
+  ezResult Init_Math();
   ezResult Init_Log();
   ezResult Init_Utils();
   ezResult Init_Time();
@@ -217,6 +241,12 @@ public:
   void DukPutComponentObject(ezComponent* pComponent);
   static ezComponentHandle RetrieveComponentHandle(duk_context* pDuk, ezInt32 iObjIdx = 0 /* use 0, if the component is passed in as the 'this' object (first parameter) */);
 
+  /// \brief Calls 'Tick()' on all given TypeScript components with a single call into the script-side dispatcher.
+  ///
+  /// The components must be sorted by their script class. \a groupEnds contains the end index of every run of components of the same class,
+  /// the dispatcher looks up the 'Tick' function only once per run.
+  void TickComponents(ezArrayPtr<ezTypeScriptComponent*> components, ezArrayPtr<const ezUInt32> groupEnds);
+
   template <typename ComponentType>
   static ComponentType* ExpectComponent(duk_context* pDuk, ezInt32 iObjIdx = 0 /* use 0, if the game object is passed in as the 'this' object (first parameter) */);
 
@@ -224,6 +254,14 @@ public:
   /// \name Math
   ///@{
 
+  /// \brief Pushes the constructor of a script type onto the stack, without looking up its module and class by name.
+  static void PushConstructor(duk_context* pDuk, ezTypeScriptBindingConstructor::Enum type);
+
+  /// \brief Returns the Float32Array through which the ez runtime scripts pass vectors and quaternions, instead of creating script objects.
+  ///
+  /// Raises a script error, if the value is not a buffer with room for uiNumFloats values.
+  static float* GetScratchBuffer(duk_context* pDuk, ezInt32 iObjIdx, ezUInt32 uiNumFloats);
+
   static void PushVec2(duk_context* pDuk, const ezVec2& value);
   static void SetVec2(duk_context* pDuk, ezInt32 iObjIdx, const ezVec2& value);
   static void SetVec2Property(duk_context* pDuk, const char* szPropertyName, ezInt32 iObjIdx, const ezVec2& value);
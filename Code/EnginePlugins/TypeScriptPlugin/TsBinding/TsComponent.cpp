@@ -31,6 +31,33 @@ ezResult ezTypeScriptBinding::Init_Component()
   m_Duk.RegisterGlobalFunction("__CPP_TsComponent_BroadcastEvent", __CPP_TsComponent_BroadcastEvent, 4);
   m_Duk.RegisterGlobalFunction("__CPP_TsComponent_SetTickInterval", __CPP_TsComponent_SetTickInterval, 2);
 
+  // ticks runs of components of the same class, so that there is only one transition into the script per frame
+  // an exception only skips the Tick of the component that threw it, components without a script object are skipped
+  const char* szTickDispatcher = R"(
+function __TsComponent_TickAll(components, groupEnds) {
+  var first = 0;
+  for (var g = 0; g < groupEnds.length; ++g) {
+    var end = groupEnds[g];
+    var tick = null;
+    for (var i = first; i < end; ++i) {
+      var comp = components[i];
+      if (comp == null)
+        continue;
+      try {
+        if (tick == null)
+          tick = comp.Tick;
+        tick.call(comp);
+      } catch (e) {
+        __CPP_Log_Error("Tick failed: " + e);
+      }
+    }
+    first = end;
+  }
+}
+)";
+
+  EZ_SUCCEED_OR_RETURN(m_Duk.ExecuteString(szTickDispatcher, "TsComponent_TickAll"));
+
   return EZ_SUCCESS;
 }
 
@@ -121,6 +148,41 @@ void ezTypeScriptBinding::DukPutComponentObject(ezComponent* pComponent)
   }
 }
 
+void ezTypeScriptBinding::TickComponents(ezArrayPtr<ezTypeScriptComponent*> components, ezArrayPtr<const ezUInt32> groupEnds)
+{
+  if (components.IsEmpty())
+    return;
+
+  ezDuktapeHelper duk(m_Duk);
+
+  if (duk.PrepareGlobalFunctionCall("__TsComponent_TickAll").Failed()) // [ func ]
+  {
+    ezLog::Error("TypeScript tick dispatcher is not available.");
+    EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, 0);
+  }
+
+  duk_push_array(duk); // [ func components ]
+  for (ezUInt32 i = 0; i < components.GetCount(); ++i)
+  {
+    DukPutComponentObject(components[i]); // [ func components comp ]
+    duk_put_prop_index(duk, -2, i);       // [ func components ]
+  }
+
+  duk_push_array(duk); // [ func components groupEnds ]
+  for (ezUInt32 i = 0; i < groupEnds.GetCount(); ++i)
+  {
+    duk_push_uint(duk, groupEnds[i]); // [ func components groupEnds end ]
+    duk_put_prop_index(duk, -2, i);   // [ func components groupEnds ]
+  }
+
+  duk.PushCustom(2); // count the two arrays as the function arguments
+
+  duk.CallPreparedFunction().IgnoreResult(); // [ result ]
+  duk.PopStack();                            // [ ]
+
+  EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, 0);
+}
+
 ezComponentHandle ezTypeScriptBinding::RetrieveComponentHandle(duk_context* pDuk, ezInt32 iObjIdx /*= 0 */)
 {
   if (duk_is_null_or_undefined(pDuk, iObjIdx))
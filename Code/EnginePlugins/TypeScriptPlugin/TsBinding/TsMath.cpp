@@ -3,20 +3,88 @@
 #include <Duktape/duktape.h>
 #include <TypeScriptPlugin/TsBinding/TsBinding.h>
 
+// All property names below are passed as string literals on purpose: duk_get_prop_literal / duk_put_prop_literal look up the interned key
+// by the address of the literal, instead of hashing and interning the string on every access.
+
+ezResult ezTypeScriptBinding::Init_Math()
+{
+  // the script types that C++ creates all the time, indexed by ezTypeScriptBindingConstructor
+  static const char* s_ConstructorPaths[ezTypeScriptBindingConstructor::ENUM_COUNT][3] = {
+    {"__Vec2", "Vec2", nullptr},
+    {"__Vec3", "Vec3", nullptr},
+    {"__Mat3", "Mat3", nullptr},
+    {"__Mat4", "Mat4", nullptr},
+    {"__Quat", "Quat", nullptr},
+    {"__Color", "Color", nullptr},
+    {"__Transform", "Transform", nullptr},
+    {"__Physics", "Physics", "HitResult"},
+  };
+
+  ezDuktapeHelper duk(m_Duk);
+
+  duk.PushGlobalStash(); // [ stash ]
+
+  for (ezUInt32 i = 0; i < ezTypeScriptBindingConstructor::ENUM_COUNT; ++i)
+  {
+    duk.PushGlobalObject(); // [ stash global ]
+
+    for (const char* szName : s_ConstructorPaths[i])
+    {
+      if (szName == nullptr)
+        break;
+
+      if (duk.PushLocalObject(szName).Failed()) // [ stash parent obj ]
+      {
+        ezLog::Error("Script type '{}' is not available", szName);
+        duk.PopStack(2); // [ ]
+        EZ_DUK_RETURN_AND_VERIFY_STACK(duk, EZ_FAILURE, 0);
+      }
+
+      duk_remove(duk, -2); // [ stash obj ]
+    }
+
+    duk_put_prop_index(duk, -2, ezTypeScriptBindingConstructor::FirstStashIndex + i); // [ stash ]
+  }
+
+  duk.PopStack(); // [ ]
+
+  EZ_DUK_RETURN_AND_VERIFY_STACK(duk, EZ_SUCCESS, 0);
+}
+
+void ezTypeScriptBinding::PushConstructor(duk_context* pDuk, ezTypeScriptBindingConstructor::Enum type)
+{
+  static_assert(ezTypeScriptBindingConstructor::FirstStashIndex + ezTypeScriptBindingConstructor::ENUM_COUNT <= c_uiFirstStashMsgIdx,
+    "The constructors overlap with the stashed messages");
+
+  duk_push_global_stash(pDuk);                                                        // [ stash ]
+  duk_get_prop_index(pDuk, -1, ezTypeScriptBindingConstructor::FirstStashIndex + type); // [ stash ctor ]
+  duk_remove(pDuk, -2);                                                               // [ ctor ]
+}
+
+float* ezTypeScriptBinding::GetScratchBuffer(duk_context* pDuk, ezInt32 iObjIdx, ezUInt32 uiNumFloats)
+{
+  duk_size_t uiSize = 0;
+  void* pData = duk_get_buffer_data(pDuk, iObjIdx, &uiSize);
+
+  if (pData == nullptr || uiSize < uiNumFloats * sizeof(float))
+  {
+    ezDuktapeHelper duk(pDuk);
+    duk.Error(ezFmt("Expected a scratch buffer for {} values", uiNumFloats));
+  }
+
+  return static_cast<float*>(pData);
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 void ezTypeScriptBinding::PushVec2(duk_context* pDuk, const ezVec2& value)
 {
   ezDuktapeHelper duk(pDuk);
 
-  duk.PushGlobalObject();                                   // [ global ]
-  EZ_VERIFY(duk.PushLocalObject("__Vec2").Succeeded(), ""); // [ global __Vec2 ]
-  duk_get_prop_string(duk, -1, "Vec2");                     // [ global __Vec2 Vec2 ]
-  duk_push_number(duk, value.x);                            // [ global __Vec2 Vec2 x ]
-  duk_push_number(duk, value.y);                            // [ global __Vec2 Vec2 x y ]
-  duk_new(duk, 2);                                          // [ global __Vec2 result ]
-  duk_remove(duk, -2);                                      // [ global result ]
-  duk_remove(duk, -2);                                      // [ result ]
+  PushConstructor(duk, ezTypeScriptBindingConstructor::Vec2); // [ Vec2 ]
+  duk_push_number(duk, value.x);                              // [ Vec2 x ]
+  duk_push_number(duk, value.y);                              // [ Vec2 x y ]
+  duk_new(duk, 2);                                            // [ result ]
 
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, +1);
 }
@@ -25,8 +93,12 @@ void ezTypeScriptBinding::SetVec2(duk_context* pDuk, ezInt32 iObjIdx, const ezVe
 {
   ezDuktapeHelper duk(pDuk);
 
-  duk.SetNumberProperty("x", value.x, iObjIdx);
-  duk.SetNumberProperty("y", value.y, iObjIdx);
+  iObjIdx = duk_normalize_index(duk, iObjIdx);
+
+  duk_push_number(duk, value.x);
+  duk_put_prop_literal(duk, iObjIdx, "x");
+  duk_push_number(duk, value.y);
+  duk_put_prop_literal(duk, iObjIdx, "y");
 
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, 0);
 }
@@ -49,10 +121,10 @@ ezVec2 ezTypeScriptBinding::GetVec2(duk_context* pDuk, ezInt32 iObjIdx, const ez
 
   ezVec2 res;
 
-  EZ_VERIFY(duk_get_prop_string(pDuk, iObjIdx, "x"), "");
+  EZ_VERIFY(duk_get_prop_literal(pDuk, iObjIdx, "x"), "");
   res.x = static_cast<float>(duk_get_number_default(pDuk, -1, fallback.x));
   duk_pop(pDuk);
-  EZ_VERIFY(duk_get_prop_string(pDuk, iObjIdx, "y"), "");
+  EZ_VERIFY(duk_get_prop_literal(pDuk, iObjIdx, "y"), "");
   res.y = static_cast<float>(duk_get_number_default(pDuk, -1, fallback.y));
   duk_pop(pDuk);
 
@@ -80,15 +152,11 @@ void ezTypeScriptBinding::PushVec3(duk_context* pDuk, const ezVec3& value)
 {
   ezDuktapeHelper duk(pDuk);
 
-  duk.PushGlobalObject();                                   // [ global ]
-  EZ_VERIFY(duk.PushLocalObject("__Vec3").Succeeded(), ""); // [ global __Vec3 ]
-  duk_get_prop_string(duk, -1, "Vec3");                     // [ global __Vec3 Vec3 ]
-  duk_push_number(duk, value.x);                            // [ global __Vec3 Vec3 x ]
-  duk_push_number(duk, value.y);                            // [ global __Vec3 Vec3 x y ]
-  duk_push_number(duk, value.z);                            // [ global __Vec3 Vec3 x y z ]
-  duk_new(duk, 3);                                          // [ global __Vec3 result ]
-  duk_remove(duk, -2);                                      // [ global result ]
-  duk_remove(duk, -2);                                      // [ result ]
+  PushConstructor(duk, ezTypeScriptBindingConstructor::Vec3); // [ Vec3 ]
+  duk_push_number(duk, value.x);                              // [ Vec3 x ]
+  duk_push_number(duk, value.y);                              // [ Vec3 x y ]
+  duk_push_number(duk, value.z);                              // [ Vec3 x y z ]
+  duk_new(duk, 3);                                            // [ result ]
 
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, +1);
 }
@@ -97,9 +165,16 @@ void ezTypeScriptBinding::SetVec3(duk_context* pDuk, ezInt32 iObjIdx, const ezVe
 {
   ezDuktapeHelper duk(pDuk);
 
-  duk.SetNumberProperty("x", value.x, iObjIdx);
-  duk.SetNumberProperty("y", value.y, iObjIdx);
-  duk.SetNumberProperty("z", value.z, iObjIdx);
+  iObjIdx = duk_normalize_index(duk, iObjIdx);
+
+  duk_push_number(duk, value.x);
+  duk_put_prop_literal(duk, iObjIdx, "x");
+  duk_push_number(duk, value.y);
+  duk_put_prop_literal(duk, iObjIdx, "y");
+  duk_push_number(duk, value.z);
+  duk_put_prop_literal(duk, iObjIdx, "z");
+
+  EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, 0);
 }
 
 void ezTypeScriptBinding::SetVec3Property(duk_context* pDuk, const char* szPropertyName, ezInt32 iObjIdx, const ezVec3& value)
@@ -120,13 +195,13 @@ ezVec3 ezTypeScriptBinding::GetVec3(duk_context* pDuk, ezInt32 iObjIdx, const ez
 
   ezVec3 res;
 
-  EZ_VERIFY(duk_get_prop_string(pDuk, iObjIdx, "x"), "");
+  EZ_VERIFY(duk_get_prop_literal(pDuk, iObjIdx, "x"), "");
   res.x = static_cast<float>(duk_get_number_default(pDuk, -1, fallback.x));
   duk_pop(pDuk);
-  EZ_VERIFY(duk_get_prop_string(pDuk, iObjIdx, "y"), "");
+  EZ_VERIFY(duk_get_prop_literal(pDuk, iObjIdx, "y"), "");
   res.y = static_cast<float>(duk_get_number_default(pDuk, -1, fallback.y));
   duk_pop(pDuk);
-  EZ_VERIFY(duk_get_prop_string(pDuk, iObjIdx, "z"), "");
+  EZ_VERIFY(duk_get_prop_literal(pDuk, iObjIdx, "z"), "");
   res.z = static_cast<float>(duk_get_number_default(pDuk, -1, fallback.z));
   duk_pop(pDuk);
 
@@ -151,25 +226,22 @@ ezVec3 ezTypeScriptBinding::GetVec3Property(
 
 //////////////////////////////////////////////////////////////////////////
 
+
 void ezTypeScriptBinding::PushMat3(duk_context* pDuk, const ezMat3& value)
 {
   ezDuktapeHelper duk(pDuk);
 
-  duk.PushGlobalObject();                                   // [ global ]
-  EZ_VERIFY(duk.PushLocalObject("__Mat3").Succeeded(), ""); // [ global __Mat3 ]
-  duk_get_prop_string(duk, -1, "Mat3");                     // [ global __Mat3 Mat3 ]
+  PushConstructor(duk, ezTypeScriptBindingConstructor::Mat3); // [ Mat3 ]
 
   float rm[9];
   value.GetAsArray(rm, ezMatrixLayout::RowMajor);
 
   for (ezUInt32 i = 0; i < 9; ++i)
   {
-    duk_push_number(duk, rm[i]); // [ global __Mat3 Mat3 9params ]
+    duk_push_number(duk, rm[i]); // [ Mat3 9params ]
   }
 
-  duk_new(duk, 9);     // [ global __Mat3 result ]
-  duk_remove(duk, -2); // [ global result ]
-  duk_remove(duk, -2); // [ result ]
+  duk_new(duk, 9); // [ result ]
 
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, +1);
 }
@@ -178,17 +250,15 @@ void ezTypeScriptBinding::SetMat3(duk_context* pDuk, ezInt32 iObjIdx, const ezMa
 {
   ezDuktapeHelper duk(pDuk);
 
-  EZ_VERIFY(duk.PushLocalObject("m_ElementsCM", iObjIdx).Succeeded(), "invalid property");
-  duk.SetNumberProperty("0", value.m_fElementsCM[0], -1);
-  duk.SetNumberProperty("1", value.m_fElementsCM[1], -1);
-  duk.SetNumberProperty("2", value.m_fElementsCM[2], -1);
-  duk.SetNumberProperty("3", value.m_fElementsCM[3], -1);
-  duk.SetNumberProperty("4", value.m_fElementsCM[4], -1);
-  duk.SetNumberProperty("5", value.m_fElementsCM[5], -1);
-  duk.SetNumberProperty("6", value.m_fElementsCM[6], -1);
-  duk.SetNumberProperty("7", value.m_fElementsCM[7], -1);
-  duk.SetNumberProperty("8", value.m_fElementsCM[8], -1);
-  duk.PopStack();
+  EZ_VERIFY(duk_get_prop_literal(duk, iObjIdx, "m_ElementsCM"), "invalid property"); // [ elements ]
+
+  for (ezUInt32 i = 0; i < 9; ++i)
+  {
+    duk_push_number(duk, value.m_fElementsCM[i]); // [ elements value ]
+    duk_put_prop_index(duk, -2, i);               // [ elements ]
+  }
+
+  duk.PopStack(); // [ ]
 
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, 0);
 }
@@ -213,19 +283,16 @@ ezMat3 ezTypeScriptBinding::GetMat3(duk_context* pDuk, ezInt32 iObjIdx, const ez
 
   ezDuktapeHelper duk(pDuk);
 
-  EZ_VERIFY(duk.PushLocalObject("m_ElementsCM", iObjIdx).Succeeded(), "invalid property");
+  EZ_VERIFY(duk_get_prop_literal(duk, iObjIdx, "m_ElementsCM"), "invalid property"); // [ elements ]
 
-  res.m_fElementsCM[0] = duk.GetFloatProperty("0", 0.0f);
-  res.m_fElementsCM[1] = duk.GetFloatProperty("1", 0.0f);
-  res.m_fElementsCM[2] = duk.GetFloatProperty("2", 0.0f);
-  res.m_fElementsCM[3] = duk.GetFloatProperty("3", 0.0f);
-  res.m_fElementsCM[4] = duk.GetFloatProperty("4", 0.0f);
-  res.m_fElementsCM[5] = duk.GetFloatProperty("5", 0.0f);
-  res.m_fElementsCM[6] = duk.GetFloatProperty("6", 0.0f);
-  res.m_fElementsCM[7] = duk.GetFloatProperty("7", 0.0f);
-  res.m_fElementsCM[8] = duk.GetFloatProperty("8", 0.0f);
+  for (ezUInt32 i = 0; i < 9; ++i)
+  {
+    duk_get_prop_index(duk, -1, i);                                                 // [ elements value ]
+    res.m_fElementsCM[i] = static_cast<float>(duk_get_number_default(duk, -1, 0.0)); // [ elements value ]
+    duk_pop(duk);                                                                   // [ elements ]
+  }
 
-  duk.PopStack();
+  duk.PopStack(); // [ ]
 
   EZ_DUK_RETURN_AND_VERIFY_STACK(duk, res, 0);
 }
@@ -248,25 +315,22 @@ ezMat3 ezTypeScriptBinding::GetMat3Property(
 
 //////////////////////////////////////////////////////////////////////////
 
+
 void ezTypeScriptBinding::PushMat4(duk_context* pDuk, const ezMat4& value)
 {
   ezDuktapeHelper duk(pDuk);
 
-  duk.PushGlobalObject();                                   // [ global ]
-  EZ_VERIFY(duk.PushLocalObject("__Mat4").Succeeded(), ""); // [ global __Mat4 ]
-  duk_get_prop_string(duk, -1, "Mat4");                     // [ global __Mat4 Mat4 ]
+  PushConstructor(duk, ezTypeScriptBindingConstructor::Mat4); // [ Mat4 ]
 
   float rm[16];
   value.GetAsArray(rm, ezMatrixLayout::RowMajor);
 
   for (ezUInt32 i = 0; i < 16; ++i)
   {
-    duk_push_number(duk, rm[i]); // [ global __Mat4 Mat4 16params ]
+    duk_push_number(duk, rm[i]); // [ Mat4 16params ]
   }
 
-  duk_new(duk, 16);    // [ global __Mat4 result ]
-  duk_remove(duk, -2); // [ global result ]
-  duk_remove(duk, -2); // [ result ]
+  duk_new(duk, 16); // [ result ]
 
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, +1);
 }
@@ -275,24 +339,15 @@ void ezTypeScriptBinding::SetMat4(duk_context* pDuk, ezInt32 iObjIdx, const ezMa
 {
   ezDuktapeHelper duk(pDuk);
 
-  EZ_VERIFY(duk.PushLocalObject("m_ElementsCM", iObjIdx).Succeeded(), "invalid property");
-  duk.SetNumberProperty("0", value.m_fElementsCM[0], -1);
-  duk.SetNumberProperty("1", value.m_fElementsCM[1], -1);
-  duk.SetNumberProperty("2", value.m_fElementsCM[2], -1);
-  duk.SetNumberProperty("3", value.m_fElementsCM[3], -1);
-  duk.SetNumberProperty("4", value.m_fElementsCM[4], -1);
-  duk.SetNumberProperty("5", value.m_fElementsCM[5], -1);
-  duk.SetNumberProperty("6", value.m_fElementsCM[6], -1);
-  duk.SetNumberProperty("7", value.m_fElementsCM[7], -1);
-  duk.SetNumberProperty("8", value.m_fElementsCM[8], -1);
-  duk.SetNumberProperty("9", value.m_fElementsCM[9], -1);
-  duk.SetNumberProperty("10", value.m_fElementsCM[10], -1);
-  duk.SetNumberProperty("11", value.m_fElementsCM[11], -1);
-  duk.SetNumberProperty("12", value.m_fElementsCM[12], -1);
-  duk.SetNumberProperty("13", value.m_fElementsCM[13], -1);
-  duk.SetNumberProperty("14", value.m_fElementsCM[14], -1);
-  duk.SetNumberProperty("15", value.m_fElementsCM[15], -1);
-  duk.PopStack();
+  EZ_VERIFY(duk_get_prop_literal(duk, iObjIdx, "m_ElementsCM"), "invalid property"); // [ elements ]
+
+  for (ezUInt32 i = 0; i < 16; ++i)
+  {
+    duk_push_number(duk, value.m_fElementsCM[i]); // [ elements value ]
+    duk_put_prop_index(duk, -2, i);               // [ elements ]
+  }
+
+  duk.PopStack(); // [ ]
 
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, 0);
 }
@@ -317,26 +372,16 @@ ezMat4 ezTypeScriptBinding::GetMat4(duk_context* pDuk, ezInt32 iObjIdx, const ez
 
   ezDuktapeHelper duk(pDuk);
 
-  EZ_VERIFY(duk.PushLocalObject("m_ElementsCM", iObjIdx).Succeeded(), "invalid property");
+  EZ_VERIFY(duk_get_prop_literal(duk, iObjIdx, "m_ElementsCM"), "invalid property"); // [ elements ]
 
-  res.m_fElementsCM[0] = duk.GetFloatProperty("0", 0.0f);
-  res.m_fElementsCM[1] = duk.GetFloatProperty("1", 0.0f);
-  res.m_fElementsCM[2] = duk.GetFloatProperty("2", 0.0f);
-  res.m_fElementsCM[3] = duk.GetFloatProperty("3", 0.0f);
-  res.m_fElementsCM[4] = duk.GetFloatProperty("4", 0.0f);
-  res.m_fElementsCM[5] = duk.GetFloatProperty("5", 0.0f);
-  res.m_fElementsCM[6] = duk.GetFloatProperty("6", 0.0f);
-  res.m_fElementsCM[7] = duk.GetFloatProperty("7", 0.0f);
-  res.m_fElementsCM[8] = duk.GetFloatProperty("8", 0.0f);
-  res.m_fElementsCM[9] = duk.GetFloatProperty("9", 0.0f);
-  res.m_fElementsCM[10] = duk.GetFloatProperty("10", 0.0f);
-  res.m_fElementsCM[11] = duk.GetFloatProperty("11", 0.0f);
-  res.m_fElementsCM[12] = duk.GetFloatProperty("12", 0.0f);
-  res.m_fElementsCM[13] = duk.GetFloatProperty("13", 0.0f);
-  res.m_fElementsCM[14] = duk.GetFloatProperty("14", 0.0f);
-  res.m_fElementsCM[15] = duk.GetFloatProperty("15", 0.0f);
+  for (ezUInt32 i = 0; i < 16; ++i)
+  {
+    duk_get_prop_index(duk, -1, i);                                                 // [ elements value ]
+    res.m_fElementsCM[i] = static_cast<float>(duk_get_number_default(duk, -1, 0.0)); // [ elements value ]
+    duk_pop(duk);                                                                   // [ elements ]
+  }
 
-  duk.PopStack();
+  duk.PopStack(); // [ ]
 
   EZ_DUK_RETURN_AND_VERIFY_STACK(duk, res, 0);
 }
@@ -359,20 +404,17 @@ ezMat4 ezTypeScriptBinding::GetMat4Property(
 
 //////////////////////////////////////////////////////////////////////////
 
+
 void ezTypeScriptBinding::PushQuat(duk_context* pDuk, const ezQuat& value)
 {
   ezDuktapeHelper duk(pDuk);
 
-  duk.PushGlobalObject();                                   // [ global ]
-  EZ_VERIFY(duk.PushLocalObject("__Quat").Succeeded(), ""); // [ global __Quat ]
-  duk_get_prop_string(duk, -1, "Quat");                     // [ global __Quat Quat ]
-  duk_push_number(duk, value.v.x);                          // [ global __Quat Quat x ]
-  duk_push_number(duk, value.v.y);                          // [ global __Quat Quat x y ]
-  duk_push_number(duk, value.v.z);                          // [ global __Quat Quat x y z ]
-  duk_push_number(duk, value.w);                            // [ global __Quat Quat x y z w ]
-  duk_new(duk, 4);                                          // [ global __Quat result ]
-  duk_remove(duk, -2);                                      // [ global result ]
-  duk_remove(duk, -2);                                      // [ result ]
+  PushConstructor(duk, ezTypeScriptBindingConstructor::Quat); // [ Quat ]
+  duk_push_number(duk, value.v.x);                            // [ Quat x ]
+  duk_push_number(duk, value.v.y);                            // [ Quat x y ]
+  duk_push_number(duk, value.v.z);                            // [ Quat x y z ]
+  duk_push_number(duk, value.w);                              // [ Quat x y z w ]
+  duk_new(duk, 4);                                            // [ result ]
 
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, +1);
 }
@@ -381,10 +423,18 @@ void ezTypeScriptBinding::SetQuat(duk_context* pDuk, ezInt32 iObjIdx, const ezQu
 {
   ezDuktapeHelper duk(pDuk);
 
-  duk.SetNumberProperty("x", value.v.x, iObjIdx);
-  duk.SetNumberProperty("y", value.v.y, iObjIdx);
-  duk.SetNumberProperty("z", value.v.z, iObjIdx);
-  duk.SetNumberProperty("w", value.w, iObjIdx);
+  iObjIdx = duk_normalize_index(duk, iObjIdx);
+
+  duk_push_number(duk, value.v.x);
+  duk_put_prop_literal(duk, iObjIdx, "x");
+  duk_push_number(duk, value.v.y);
+  duk_put_prop_literal(duk, iObjIdx, "y");
+  duk_push_number(duk, value.v.z);
+  duk_put_prop_literal(duk, iObjIdx, "z");
+  duk_push_number(duk, value.w);
+  duk_put_prop_literal(duk, iObjIdx, "w");
+
+  EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, 0);
 }
 
 void ezTypeScriptBinding::SetQuatProperty(duk_context* pDuk, const char* szPropertyName, ezInt32 iObjIdx, const ezQuat& value)
@@ -398,6 +448,7 @@ void ezTypeScriptBinding::SetQuatProperty(duk_context* pDuk, const char* szPrope
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, 0);
 }
 
+
 ezQuat ezTypeScriptBinding::GetQuat(duk_context* pDuk, ezInt32 iObjIdx, ezQuat fallback /*= ezQuat::IdentityQuaternion()*/)
 {
   if (duk_is_null_or_undefined(pDuk, iObjIdx))
@@ -405,16 +456,16 @@ ezQuat ezTypeScriptBinding::GetQuat(duk_context* pDuk, ezInt32 iObjIdx, ezQuat f
 
   ezQuat res;
 
-  EZ_VERIFY(duk_get_prop_string(pDuk, iObjIdx, "x"), "");
+  EZ_VERIFY(duk_get_prop_literal(pDuk, iObjIdx, "x"), "");
   res.v.x = static_cast<float>(duk_get_number_default(pDuk, -1, fallback.v.x));
   duk_pop(pDuk);
-  EZ_VERIFY(duk_get_prop_string(pDuk, iObjIdx, "y"), "");
+  EZ_VERIFY(duk_get_prop_literal(pDuk, iObjIdx, "y"), "");
   res.v.y = static_cast<float>(duk_get_number_default(pDuk, -1, fallback.v.y));
   duk_pop(pDuk);
-  EZ_VERIFY(duk_get_prop_string(pDuk, iObjIdx, "z"), "");
+  EZ_VERIFY(duk_get_prop_literal(pDuk, iObjIdx, "z"), "");
   res.v.z = static_cast<float>(duk_get_number_default(pDuk, -1, fallback.v.z));
   duk_pop(pDuk);
-  EZ_VERIFY(duk_get_prop_string(pDuk, iObjIdx, "w"), "");
+  EZ_VERIFY(duk_get_prop_literal(pDuk, iObjIdx, "w"), "");
   res.w = static_cast<float>(duk_get_number_default(pDuk, -1, fallback.w));
   duk_pop(pDuk);
 
@@ -438,20 +489,17 @@ ezQuat ezTypeScriptBinding::GetQuatProperty(
 
 //////////////////////////////////////////////////////////////////////////
 
+
 void ezTypeScriptBinding::PushColor(duk_context* pDuk, const ezColor& value)
 {
   ezDuktapeHelper duk(pDuk);
 
-  duk.PushGlobalObject();                                    // [ global ]
-  EZ_VERIFY(duk.PushLocalObject("__Color").Succeeded(), ""); // [ global __Color ]
-  duk_get_prop_string(duk, -1, "Color");                     // [ global __Color Color ]
-  duk_push_number(duk, value.r);                             // [ global __Color Color r ]
-  duk_push_number(duk, value.g);                             // [ global __Color Color r g ]
-  duk_push_number(duk, value.b);                             // [ global __Color Color r g b ]
-  duk_push_number(duk, value.a);                             // [ global __Color Color r g b a ]
-  duk_new(duk, 4);                                           // [ global __Color result ]
-  duk_remove(duk, -2);                                       // [ global result ]
-  duk_remove(duk, -2);                                       // [ result ]
+  PushConstructor(duk, ezTypeScriptBindingConstructor::Color); // [ Color ]
+  duk_push_number(duk, value.r);                               // [ Color r ]
+  duk_push_number(duk, value.g);                               // [ Color r g ]
+  duk_push_number(duk, value.b);                               // [ Color r g b ]
+  duk_push_number(duk, value.a);                               // [ Color r g b a ]
+  duk_new(duk, 4);                                             // [ result ]
 
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, +1);
 }
@@ -460,10 +508,16 @@ void ezTypeScriptBinding::SetColor(duk_context* pDuk, ezInt32 iObjIdx, const ezC
 {
   ezDuktapeHelper duk(pDuk);
 
-  duk.SetNumberProperty("r", value.r, iObjIdx);
-  duk.SetNumberProperty("g", value.g, iObjIdx);
-  duk.SetNumberProperty("b", value.b, iObjIdx);
-  duk.SetNumberProperty("a", value.a, iObjIdx);
+  iObjIdx = duk_normalize_index(duk, iObjIdx);
+
+  duk_push_number(duk, value.r);
+  duk_put_prop_literal(duk, iObjIdx, "r");
+  duk_push_number(duk, value.g);
+  duk_put_prop_literal(duk, iObjIdx, "g");
+  duk_push_number(duk, value.b);
+  duk_put_prop_literal(duk, iObjIdx, "b");
+  duk_push_number(duk, value.a);
+  duk_put_prop_literal(duk, iObjIdx, "a");
 
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, 0);
 }
@@ -479,17 +533,25 @@ void ezTypeScriptBinding::SetColorProperty(duk_context* pDuk, const char* szProp
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, 0);
 }
 
+
 ezColor ezTypeScriptBinding::GetColor(duk_context* pDuk, ezInt32 iObjIdx, const ezColor& fallback /*= ezColor::White*/)
 {
-  ezDuktapeHelper duk(pDuk);
-
   ezColor res;
-  res.r = duk.GetFloatProperty("r", fallback.r, iObjIdx);
-  res.g = duk.GetFloatProperty("g", fallback.g, iObjIdx);
-  res.b = duk.GetFloatProperty("b", fallback.b, iObjIdx);
-  res.a = duk.GetFloatProperty("a", fallback.a, iObjIdx);
 
-  EZ_DUK_RETURN_AND_VERIFY_STACK(duk, res, 0);
+  duk_get_prop_literal(pDuk, iObjIdx, "r");
+  res.r = static_cast<float>(duk_get_number_default(pDuk, -1, fallback.r));
+  duk_pop(pDuk);
+  duk_get_prop_literal(pDuk, iObjIdx, "g");
+  res.g = static_cast<float>(duk_get_number_default(pDuk, -1, fallback.g));
+  duk_pop(pDuk);
+  duk_get_prop_literal(pDuk, iObjIdx, "b");
+  res.b = static_cast<float>(duk_get_number_default(pDuk, -1, fallback.b));
+  duk_pop(pDuk);
+  duk_get_prop_literal(pDuk, iObjIdx, "a");
+  res.a = static_cast<float>(duk_get_number_default(pDuk, -1, fallback.a));
+  duk_pop(pDuk);
+
+  return res;
 }
 
 ezColor ezTypeScriptBinding::GetColorProperty(
@@ -509,28 +571,35 @@ ezColor ezTypeScriptBinding::GetColorProperty(
 
 //////////////////////////////////////////////////////////////////////////
 
+
 void ezTypeScriptBinding::PushTransform(duk_context* pDuk, const ezTransform& value)
 {
   ezDuktapeHelper duk(pDuk);
 
-  duk.PushGlobalObject();                                        // [ global ]
-  EZ_VERIFY(duk.PushLocalObject("__Transform").Succeeded(), ""); // [ global __Transform ]
-  duk_get_prop_string(duk, -1, "Transform");                     // [ global __Transform Transform ]
-  duk_new(duk, 0);                                               // [ global __Transform object ]
-  SetVec3Property(pDuk, "position", -1, value.m_vPosition);      // [ global __Transform object ]
-  SetQuatProperty(pDuk, "rotation", -1, value.m_qRotation);      // [ global __Transform object ]
-  SetVec3Property(pDuk, "scale", -1, value.m_vScale);            // [ global __Transform object ]
-  duk_remove(duk, -2);                                           // [ global object ]
-  duk_remove(duk, -2);                                           // [ object ]
+  PushConstructor(duk, ezTypeScriptBindingConstructor::Transform); // [ Transform ]
+  duk_new(duk, 0);                                                 // [ object ]
+  SetTransform(pDuk, -1, value);                                   // [ object ]
 
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, +1);
 }
 
 void ezTypeScriptBinding::SetTransform(duk_context* pDuk, ezInt32 iObjIdx, const ezTransform& value)
 {
-  SetVec3Property(pDuk, "position", iObjIdx, value.m_vPosition);
-  SetQuatProperty(pDuk, "rotation", iObjIdx, value.m_qRotation);
-  SetVec3Property(pDuk, "scale", iObjIdx, value.m_vScale);
+  ezDuktapeHelper duk(pDuk);
+
+  iObjIdx = duk_normalize_index(duk, iObjIdx);
+
+  EZ_VERIFY(duk_get_prop_literal(duk, iObjIdx, "position"), "invalid property"); // [ position ]
+  SetVec3(pDuk, -1, value.m_vPosition);                                           // [ position ]
+  duk_pop(duk);                                                                   // [ ]
+  EZ_VERIFY(duk_get_prop_literal(duk, iObjIdx, "rotation"), "invalid property"); // [ rotation ]
+  SetQuat(pDuk, -1, value.m_qRotation);                                           // [ rotation ]
+  duk_pop(duk);                                                                   // [ ]
+  EZ_VERIFY(duk_get_prop_literal(duk, iObjIdx, "scale"), "invalid property");    // [ scale ]
+  SetVec3(pDuk, -1, value.m_vScale);                                              // [ scale ]
+  duk_pop(duk);                                                                   // [ ]
+
+  EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, 0);
 }
 
 void ezTypeScriptBinding::SetTransformProperty(duk_context* pDuk, const char* szPropertyName, ezInt32 iObjIdx, const ezTransform& value)
@@ -549,11 +618,19 @@ ezTransform ezTypeScriptBinding::GetTransform(duk_context* pDuk, ezInt32 iObjIdx
   if (duk_is_null_or_undefined(pDuk, iObjIdx))
     return fallback;
 
+  iObjIdx = duk_normalize_index(pDuk, iObjIdx);
+
   ezTransform res;
 
-  res.m_vPosition = GetVec3Property(pDuk, "position", iObjIdx, fallback.m_vPosition);
-  res.m_qRotation = GetQuatProperty(pDuk, "rotation", iObjIdx, fallback.m_qRotation);
-  res.m_vScale = GetVec3Property(pDuk, "scale", iObjIdx, fallback.m_vScale);
+  duk_get_prop_literal(pDuk, iObjIdx, "position"); // [ position ]
+  res.m_vPosition = GetVec3(pDuk, -1, fallback.m_vPosition);
+  duk_pop(pDuk); // [ ]
+  duk_get_prop_literal(pDuk, iObjIdx, "rotation"); // [ rotation ]
+  res.m_qRotation = GetQuat(pDuk, -1, fallback.m_qRotation);
+  duk_pop(pDuk); // [ ]
+  duk_get_prop_literal(pDuk, iObjIdx, "scale"); // [ scale ]
+  res.m_vScale = GetVec3(pDuk, -1, fallback.m_vScale);
+  duk_pop(pDuk); // [ ]
 
   return res;
 }
@@ -40,29 +40,25 @@ static void PutHitResult(ezDuktapeHelper& duk, const ezPhysicsCastResult& res)
 {
   ezTypeScriptBinding* pBinding = ezTypeScriptBinding::RetrieveBinding(duk);
 
-  duk.PushGlobalObject();                                 // [ global ]
-  duk.PushLocalObject("__Physics").IgnoreResult();        // [ global __Physics ]
-  duk.PushLocalObject("Physics").IgnoreResult();          // [ global __Physics Physics ]
-  duk_get_prop_string(duk, -1, "HitResult");              // [ global __Physics Physics HitResult ]
-  duk_new(duk, 0);                                        // [ global __Physics Physics HitResultObj ]
-  duk_remove(duk, -2);                                    // [ global __Physics HitResultObj ]
-  duk_remove(duk, -2);                                    // [ global HitResultObj ]
-  duk_remove(duk, -2);                                    // [ HitResultObj ]
-  ;                                                       //
-  duk.SetNumberProperty("distance", res.m_fDistance, -1); // [ HitResultObj ]
-  duk.SetNumberProperty("shapeId", res.m_uiShapeId, -1);  // [ HitResultObj ]
-  ;                                                       //
-  ezTypeScriptBinding::PushVec3(duk, res.m_vPosition);    // [ HitResultObj pos ]
-  duk.SetCustomProperty("position", -1);                  // [ HitResultObj ]
-  ;                                                       //
-  ezTypeScriptBinding::PushVec3(duk, res.m_vNormal);      // [ HitResultObj normal ]
-  duk.SetCustomProperty("normal", -1);                    // [ HitResultObj ]
-  ;                                                       //
-  pBinding->DukPutGameObject(res.m_hShapeObject);         // [ HitResultObj GO ]
-  duk.SetCustomProperty("shapeObject", -1);               // [ HitResultObj ]
-  ;                                                       //
-  pBinding->DukPutGameObject(res.m_hActorObject);         // [ HitResultObj GO ]
-  duk.SetCustomProperty("actorObject", -1);               // [ HitResultObj ]
+  ezTypeScriptBinding::PushConstructor(duk, ezTypeScriptBindingConstructor::HitResult); // [ HitResult ]
+  duk_new(duk, 0);                                                                     // [ HitResultObj ]
+  ;                                                                                    //
+  duk_push_number(duk, res.m_fDistance);                                               // [ HitResultObj distance ]
+  duk_put_prop_literal(duk, -2, "distance");                                           // [ HitResultObj ]
+  duk_push_number(duk, res.m_uiShapeId);                                               // [ HitResultObj shapeId ]
+  duk_put_prop_literal(duk, -2, "shapeId");                                            // [ HitResultObj ]
+  ;                                                                                    //
+  ezTypeScriptBinding::PushVec3(duk, res.m_vPosition);                                 // [ HitResultObj pos ]
+  duk_put_prop_literal(duk, -2, "position");                                           // [ HitResultObj ]
+  ;                                                                                    //
+  ezTypeScriptBinding::PushVec3(duk, res.m_vNormal);                                   // [ HitResultObj normal ]
+  duk_put_prop_literal(duk, -2, "normal");                                             // [ HitResultObj ]
+  ;                                                                                    //
+  pBinding->DukPutGameObject(res.m_hShapeObject);                                      // [ HitResultObj GO ]
+  duk_put_prop_literal(duk, -2, "shapeObject");                                        // [ HitResultObj ]
+  ;                                                                                    //
+  pBinding->DukPutGameObject(res.m_hActorObject);                                      // [ HitResultObj GO ]
+  duk_put_prop_literal(duk, -2, "actorObject");                                        // [ HitResultObj ]
 }
 
 static int __CPP_Physics_Raycast(duk_context* pDuk)
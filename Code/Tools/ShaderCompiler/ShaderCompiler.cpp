@@ -1,6 +1,8 @@
 #include <Foundation/Configuration/Startup.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Stopwatch.h>
 #include <RendererCore/ShaderCompiler/ShaderCompiler.h>
 #include <RendererCore/ShaderCompiler/ShaderManager.h>
 #include <RendererCore/ShaderCompiler/ShaderParser.h>
@@ -81,23 +83,57 @@ ezResult ezShaderCompilerApplication::CompileShader(const char* szShaderFile)
   if (ExtractPermutationVarValues(szShaderFile).Failed())
     return EZ_FAILURE;
 
-  ezHybridArray<ezPermutationVar, 16> PermVars;
-
   const ezUInt32 uiMaxPerms = m_PermutationGenerator.GetPermutationCount();
 
   ezLog::Info("Shader has {0} permutations", uiMaxPerms);
 
+  ezDynamicArray<ezHybridArray<ezPermutationVar, 16>> permutations;
+  permutations.SetCount(uiMaxPerms);
+
   for (ezUInt32 perm = 0; perm < uiMaxPerms; ++perm)
   {
-    EZ_LOG_BLOCK("Compiling Permutation");
-
-    m_PermutationGenerator.GetPermutation(perm, PermVars);
-    ezShaderCompiler sc;
-    if (sc.CompileShaderPermutationForPlatforms(szShaderFile, PermVars, ezLog::GetThreadLocalLogSystem(), m_sPlatforms).Failed())
-      return EZ_FAILURE;
+    m_PermutationGenerator.GetPermutation(perm, permutations[perm]);
   }
 
+  const ezUInt32 uiCacheHitsBefore = m_FileCache.GetNumCacheHits();
+  const ezUInt32 uiCacheMissesBefore = m_FileCache.GetNumCacheMisses();
+
+  ezAtomicInteger32 iFailedPermutations;
+  ezStopwatch sw;
+
+  // every permutation gets its own compiler, only the tokenized include files are shared
+  ezTaskSystem::ParallelForIndexed(
+    0, uiMaxPerms,
+    [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      for (ezUInt32 perm = uiStartIndex; perm < uiEndIndex; ++perm)
+      {
+        // like the sequential compilation, stop at the first failure
+        if (iFailedPermutations > 0)
+          return;
+
+        EZ_LOG_BLOCK("Compiling Permutation");
+
+        ezShaderCompiler sc;
+        sc.SetCustomFileCache(&m_FileCache);
+
+        if (sc.CompileShaderPermutationForPlatforms(szShaderFile, permutations[perm], ezLog::GetThreadLocalLogSystem(), m_sPlatforms).Failed())
+        {
+          iFailedPermutations.Increment();
+        }
+      }
+    },
+    "CompileShaderPermutations");
+
+  if (iFailedPermutations > 0)
+    return EZ_FAILURE;
+
+  const ezUInt32 uiCacheHits = m_FileCache.GetNumCacheHits() - uiCacheHitsBefore;
+  const ezUInt32 uiCacheLookups = uiCacheHits + m_FileCache.GetNumCacheMisses() - uiCacheMissesBefore;
+  const double fCacheHitRate = uiCacheLookups > 0 ? 100.0 * uiCacheHits / uiCacheLookups : 0.0;
+
   ezLog::Success("Compiled Shader '{0}'", szShaderFile);
+  ezLog::Info("{0} permutations took {1} ms, include cache hit rate {2}% ({3} of {4} file lookups)", uiMaxPerms,
+    ezArgF(sw.GetRunningTotal().GetMilliseconds(), 1), ezArgF(fCacheHitRate, 1), uiCacheHits, uiCacheLookups);
   return EZ_SUCCESS;
 }
 
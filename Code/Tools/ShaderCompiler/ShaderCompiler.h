@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Foundation/CodeUtils/Preprocessor.h>
 #include <GameEngine/GameApplication/GameApplication.h>
 #include <RendererCore/ShaderCompiler/PermutationGenerator.h>
 
@@ -30,4 +31,7 @@ private:
   ezString m_sPlatforms;
   ezString m_sShaderFiles;
   ezMap<ezString, ezHybridArray<ezString, 4>> m_FixedPermVars;
+
+  // shared by all permutations, so that every include file is only read and tokenized once
+  ezTokenizedFileCache m_FileCache;
 };
@@ -1,6 +1,11 @@
 #include <CoreTestPCH.h>
 
 #include <Core/ResourceManager/ResourceManager.h>
+#include <Foundation/IO/AsyncFileReader.h>
+#include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Time/Stopwatch.h>
 #include <Foundation/Types/ScopeExit.h>
 
 EZ_CREATE_SIMPLE_TEST_GROUP(ResourceManager);
@@ -126,6 +131,62 @@ namespace
   EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(TestResource, 1, ezRTTIDefaultAllocator<TestResource>)
   EZ_END_DYNAMIC_REFLECTED_TYPE;
 
+  typedef ezTypedResourceHandle<class TestFileResource> TestFileResourceHandle;
+
+  /// Loaded through the default file loader, the content is ignored.
+  class TestFileResource : public ezResource
+  {
+    EZ_ADD_DYNAMIC_REFLECTION(TestFileResource, ezResource);
+    EZ_RESOURCE_DECLARE_COMMON_CODE(TestFileResource);
+
+  public:
+    TestFileResource()
+      : ezResource(ezResource::DoUpdate::OnAnyThread, 1)
+    {
+    }
+
+  protected:
+    virtual ezResourceLoadDesc UnloadData(Unload WhatToUnload) override
+    {
+      ezResourceLoadDesc ld;
+      ld.m_State = ezResourceState::Unloaded;
+      ld.m_uiQualityLevelsDiscardable = 0;
+      ld.m_uiQualityLevelsLoadable = 0;
+
+      return ld;
+    }
+
+    virtual ezResourceLoadDesc UpdateContent(ezStreamReader* Stream) override
+    {
+      ezResourceLoadDesc ld;
+      ld.m_State = Stream != nullptr ? ezResourceState::Loaded : ezResourceState::LoadedResourceMissing;
+      ld.m_uiQualityLevelsDiscardable = 0;
+      ld.m_uiQualityLevelsLoadable = 0;
+
+      return ld;
+    }
+
+    virtual void UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage) override
+    {
+      out_NewMemoryUsage.m_uiMemoryCPU = sizeof(TestFileResource);
+      out_NewMemoryUsage.m_uiMemoryGPU = 0;
+    }
+  };
+
+  EZ_RESOURCE_IMPLEMENT_COMMON_CODE(TestFileResource);
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(TestFileResource, 1, ezRTTIDefaultAllocator<TestFileResource>)
+  EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+  static void WriteTestFile(const char* szFile, ezUInt32 uiContent)
+  {
+    ezOSFile file;
+    if (file.Open(szFile, ezFileOpenMode::Write).Succeeded())
+    {
+      file.Write(&uiContent, sizeof(uiContent)).IgnoreResult();
+      file.Close();
+    }
+  }
+
 } // namespace
 
 EZ_CREATE_SIMPLE_TEST(ResourceManager, Basics)
@@ -286,3 +347,184 @@ EZ_CREATE_SIMPLE_TEST(ResourceManager, NestedLoading)
     EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(ResourceManager, FileWatching)
+{
+  ezStringBuilder sDirectory = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sDirectory.AppendPath("ResourceFileWatching");
+
+  EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sDirectory).Succeeded());
+
+  const ezUInt32 uiNumResources = 2000;
+
+  ezStringBuilder sFile;
+  for (ezUInt32 i = 0; i < uiNumResources; ++i)
+  {
+    sFile.Format("{0}/File{1}.bin", sDirectory, i);
+    WriteTestFile(sFile, i);
+  }
+
+  ezFileSystem::RegisterDataDirectoryFactory(ezDataDirectory::FolderType::Factory);
+  EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sDirectory, "ResourceFileWatching", "watched").Succeeded());
+
+  ezDynamicArray<TestFileResourceHandle> hResources;
+
+  EZ_SCOPE_EXIT(hResources.Clear(); ezResourceManager::SetFileWatchingEnabled(false); ezResourceManager::FreeAllUnusedResources();
+                ezFileSystem::RemoveDataDirectoryGroup("ResourceFileWatching"));
+
+  hResources.Reserve(uiNumResources);
+
+  ezStringBuilder sResourceID;
+  for (ezUInt32 i = 0; i < uiNumResources; ++i)
+  {
+    sResourceID.Format(":watched/File{0}.bin", i);
+    hResources.PushBack(ezResourceManager::LoadResource<TestFileResource>(sResourceID));
+
+    ezResourceManager::ForceLoadResourceNow(hResources.PeekBack());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Check All Files")
+  {
+    ezStopwatch sw;
+    EZ_TEST_INT(ezResourceManager::ReloadAllResources(false), 0);
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Checking %u resources for changes without file watching: %.2fms", uiNumResources, sw.GetRunningTotal().GetMilliseconds());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Check Changed Files")
+  {
+    ezResourceManager::SetFileWatchingEnabled(true);
+    EZ_TEST_BOOL(ezResourceManager::IsFileWatchingEnabled());
+
+    // the first check after a directory started to be watched still has to look at every resource
+    EZ_TEST_INT(ezResourceManager::ReloadAllResources(false), 0);
+
+    ezStopwatch sw;
+    EZ_TEST_INT(ezResourceManager::ReloadAllResources(false), 0);
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Checking %u resources for changes with file watching: %.2fms", uiNumResources, sw.GetRunningTotal().GetMilliseconds());
+  }
+
+#if EZ_ENABLED(EZ_PLATFORM_WINDOWS_DESKTOP) || EZ_ENABLED(EZ_PLATFORM_LINUX)
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Reload Modified File")
+  {
+    // file modification times are compared with a resolution of seconds
+    ezThreadUtils::Sleep(ezTime::Milliseconds(1100));
+
+    sFile.Format("{0}/File{1}.bin", sDirectory, 42);
+    WriteTestFile(sFile, 0);
+
+    // give the OS some time to deliver the change notification
+    ezUInt32 uiNumReloaded = 0;
+    for (ezUInt32 uiTry = 0; uiTry < 50 && uiNumReloaded == 0; ++uiTry)
+    {
+      uiNumReloaded = ezResourceManager::ReloadAllResources(false);
+
+      if (uiNumReloaded == 0)
+        ezThreadUtils::Sleep(ezTime::Milliseconds(20));
+    }
+
+    EZ_TEST_INT(uiNumReloaded, 1);
+  }
+#endif
+}
+
+EZ_CREATE_SIMPLE_TEST(ResourceManager, BatchedFileReads)
+{
+  ezStringBuilder sDirectory = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sDirectory.AppendPath("ResourceBatchedFileReads");
+
+  EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sDirectory).Succeeded());
+
+  ezFileSystem::RegisterDataDirectoryFactory(ezDataDirectory::FolderType::Factory);
+  EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sDirectory, "ResourceBatchedFileReads", "batched").Succeeded());
+
+  const ezUInt32 uiDefaultBatchSize = ezResourceManager::GetFileReadBatchSize();
+
+  EZ_SCOPE_EXIT(ezResourceManager::SetFileReadBatchSize(uiDefaultBatchSize); ezResourceManager::FreeAllUnusedResources();
+                ezFileSystem::RemoveDataDirectoryGroup("ResourceBatchedFileReads"));
+
+  auto LoadAll = [&](ezUInt32 uiNumResources, ezUInt32 uiBatchSize) -> ezTime {
+    ezResourceManager::SetFileReadBatchSize(uiBatchSize);
+
+    ezDynamicArray<TestFileResourceHandle> hResources;
+    hResources.Reserve(uiNumResources);
+
+    ezStopwatch sw;
+
+    ezStringBuilder sResourceID;
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      sResourceID.Format(":batched/File{0}.bin", i);
+      hResources.PushBack(ezResourceManager::LoadResource<TestFileResource>(sResourceID));
+      ezResourceManager::PreloadResource(hResources.PeekBack());
+    }
+
+    // a file that does not exist must not affect the other files in the same batch
+    TestFileResourceHandle hMissing = ezResourceManager::LoadResource<TestFileResource>(":batched/DoesNotExist.bin");
+    ezResourceManager::PreloadResource(hMissing);
+
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      ezResourceLock<TestFileResource> pResource(hResources[i], ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+      EZ_TEST_BOOL(pResource.GetAcquireResult() == ezResourceAcquireResult::Final);
+    }
+
+    const ezTime tLoading = sw.GetRunningTotal();
+
+    {
+      ezResourceLock<TestFileResource> pResource(hMissing, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+      EZ_TEST_BOOL(pResource.GetAcquireResult() == ezResourceAcquireResult::None);
+    }
+
+    EZ_TEST_BOOL(ezResourceManager::GetLoadingState(hMissing) == ezResourceState::LoadedResourceMissing);
+
+    hResources.Clear();
+    hMissing.Invalidate();
+
+    while (ezResourceManager::IsAnyLoadingInProgress())
+    {
+      ezThreadUtils::Sleep(ezTime::Milliseconds(10));
+    }
+
+    ezResourceManager::FreeAllUnusedResources();
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestFileResource>()->GetCount(), 0);
+
+    return tLoading;
+  };
+
+  ezStringBuilder sFile;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Load")
+  {
+    const ezUInt32 uiNumResources = 200;
+
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      sFile.Format("{0}/File{1}.bin", sDirectory, i);
+      WriteTestFile(sFile, i);
+    }
+
+    LoadAll(uiNumResources, 1);
+    LoadAll(uiNumResources, 32);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Performance")
+  {
+    const ezUInt32 uiNumResources = 10000;
+
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      sFile.Format("{0}/File{1}.bin", sDirectory, i);
+      WriteTestFile(sFile, i);
+    }
+
+    for (ezUInt32 uiBatchSize : {1u, 32u})
+    {
+      const ezTime tLoading = LoadAll(uiNumResources, uiBatchSize);
+
+      ezTestFramework::Output(ezTestOutput::Duration, "Loading %u small files, batch size %u (%s): %.2fms", uiNumResources, uiBatchSize,
+        ezAsyncFileReader::IsUsingNativeAsyncIO() ? "io_uring" : "tasks", tLoading.GetMilliseconds());
+    }
+  }
+}
@@ -33,6 +33,13 @@ namespace
     int m_iValue;
   };
 
+  struct TestMessageRepost : public ezMsgTest
+  {
+    EZ_DECLARE_MESSAGE_TYPE(TestMessageRepost, ezMsgTest);
+
+    int m_iRemaining;
+  };
+
   // clang-format off
   EZ_IMPLEMENT_MESSAGE_TYPE(TestMessage1);
   EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(TestMessage1, 1, ezRTTIDefaultAllocator<TestMessage1>)
@@ -41,6 +48,10 @@ namespace
   EZ_IMPLEMENT_MESSAGE_TYPE(TestMessage2);
   EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(TestMessage2, 1, ezRTTIDefaultAllocator<TestMessage2>)
   EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+  EZ_IMPLEMENT_MESSAGE_TYPE(TestMessageRepost);
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(TestMessageRepost, 1, ezRTTIDefaultAllocator<TestMessageRepost>)
+  EZ_END_DYNAMIC_REFLECTED_TYPE;
   // clang-format on
 
   class TestComponentMsg;
@@ -65,8 +76,21 @@ namespace
 
     void OnTestMessage2(TestMessage2& msg) { m_iSomeData2 += 2 * msg.m_iValue; }
 
+    void OnTestMessageRepost(TestMessageRepost& msg)
+    {
+      ++m_iNumReposts;
+
+      if (msg.m_iRemaining > 0)
+      {
+        TestMessageRepost msg2;
+        msg2.m_iRemaining = msg.m_iRemaining - 1;
+        PostMessage(msg2, ezTime::Seconds(1));
+      }
+    }
+
     ezInt32 m_iSomeData;
     ezInt32 m_iSomeData2;
+    ezInt32 m_iNumReposts = 0;
   };
 
   // clang-format off
@@ -76,6 +100,7 @@ namespace
     {
       EZ_MESSAGE_HANDLER(TestMessage1, OnTestMessage),
       EZ_MESSAGE_HANDLER(TestMessage2, OnTestMessage2),
+      EZ_MESSAGE_HANDLER(TestMessageRepost, OnTestMessageRepost),
     }
     EZ_END_MESSAGEHANDLERS;
   }
@@ -89,6 +114,7 @@ namespace
     {
       pComponent->m_iSomeData = 1;
       pComponent->m_iSomeData2 = 2;
+      pComponent->m_iNumReposts = 0;
     }
 
     for (auto it = object.GetChildren(); it.IsValid(); ++it)
@@ -235,4 +261,28 @@ EZ_CREATE_SIMPLE_TEST(World, Messaging)
 
     ezFrameAllocator::Reset();
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Queuing with delay from message handler")
+  {
+    ResetComponents(*pRoot);
+
+    TestMessageRepost msg;
+    msg.m_iRemaining = 5;
+    pRoot->PostMessage(msg, ezTime::Seconds(1));
+
+    world.GetClock().SetFixedTimeStep(ezTime::Seconds(1.001f));
+
+    TestComponentMsg* pComponent2 = nullptr;
+    pRoot->TryGetComponentOfBaseType(pComponent2);
+
+    // every handler posts the next message with a delay, which must neither be lost nor be processed before it is due
+    for (ezInt32 i = 0; i < 8; ++i)
+    {
+      world.Update();
+
+      EZ_TEST_INT(pComponent2->m_iNumReposts, ezMath::Min(i + 1, 6));
+    }
+
+    ezFrameAllocator::Reset();
+  }
 }
@@ -1,6 +1,10 @@
 #include <CoreTestPCH.h>
 
 #include <Core/World/World.h>
+#include <Core/WorldSerializer/WorldReader.h>
+#include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Time/Clock.h>
 #include <Foundation/Time/Stopwatch.h>
 
@@ -11,6 +15,28 @@ namespace
   class ezTestComponent : public ezComponent
   {
     EZ_DECLARE_COMPONENT_TYPE(ezTestComponent, ezComponent, ezTestComponentManager);
+
+  public:
+    virtual void SerializeComponent(ezWorldWriter& stream) const override
+    {
+      SUPER::SerializeComponent(stream);
+      auto& s = stream.GetStream();
+
+      s << m_uiValue;
+      s << m_sName;
+    }
+
+    virtual void DeserializeComponent(ezWorldReader& stream) override
+    {
+      SUPER::DeserializeComponent(stream);
+      auto& s = stream.GetStream();
+
+      s >> m_uiValue;
+      s >> m_sName;
+    }
+
+    ezUInt32 m_uiValue = 0;
+    ezHashedString m_sName;
   };
 
   class ezTestComponentManager : public ezComponentManager<class ezTestComponent, ezBlockStorageType::FreeList>
@@ -51,11 +77,65 @@ namespace
     ezQuat m_qRotation;
   };
 
+  class ezTestValueComponent;
+  using ezTestValueComponentManager = ezComponentManager<class ezTestValueComponent, ezBlockStorageType::Compact>;
+
+  class ezTestValueComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(ezTestValueComponent, ezComponent, ezTestValueComponentManager);
+
+  public:
+    virtual void SerializeComponent(ezWorldWriter& stream) const override
+    {
+      SUPER::SerializeComponent(stream);
+      stream.GetStream() << m_vValue;
+    }
+
+    virtual void DeserializeComponent(ezWorldReader& stream) override
+    {
+      SUPER::DeserializeComponent(stream);
+      stream.GetStream() >> m_vValue;
+    }
+
+    ezVec3 m_vValue = ezVec3::ZeroVector();
+  };
+
   // clang-format off
-  EZ_BEGIN_COMPONENT_TYPE(ezTestComponent, 1, ezComponentMode::Dynamic);
+  EZ_BEGIN_COMPONENT_TYPE(ezTestComponent, 1, ezComponentMode::Dynamic)
+  {
+    EZ_BEGIN_ATTRIBUTES
+    {
+      new ezParallelDeserializationAttribute(),
+    }
+    EZ_END_ATTRIBUTES;
+  }
+  EZ_END_COMPONENT_TYPE;
+
+  EZ_BEGIN_COMPONENT_TYPE(ezTestValueComponent, 1, ezComponentMode::Static)
+  {
+    EZ_BEGIN_ATTRIBUTES
+    {
+      new ezParallelDeserializationAttribute(),
+    }
+    EZ_END_ATTRIBUTES;
+  }
   EZ_END_COMPONENT_TYPE;
   // clang-format on
 
+  /// The deserialized state of one child object of the prefab template, used to compare the serial and the parallel deserialization.
+  struct ezTestObjectState
+  {
+    ezVec3 m_vPosition = ezVec3::ZeroVector();
+    ezHashedString m_sName;
+    ezVec3 m_vValue = ezVec3::ZeroVector();
+    bool m_bHasValueComponent = false;
+
+    bool operator==(const ezTestObjectState& other) const
+    {
+      return m_vPosition == other.m_vPosition && m_sName == other.m_sName && m_vValue == other.m_vValue && m_bHasValueComponent == other.m_bHasValueComponent;
+    }
+  };
+
   void AddObjectsToWorld(ezWorld& world, bool bDynamic, ezUInt32 uiNumObjects, ezUInt32 uiTreeLevelNumNodeDiv, ezUInt32 uiTreeDepth,
     ezInt32 iAttachCompsDepth, ezGameObjectHandle hParent = ezGameObjectHandle())
   {
@@ -115,18 +195,169 @@ namespace
     }
   }
 
-} // namespace
+  void CreatePrefabTemplate(ezWorldReader& reader, ezMemoryStreamStorage& storage, ezUInt32 uiNumChildren)
+  {
+    ezWorldDesc worldDesc("Template");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezTestComponentManager* pMan = world.GetOrCreateComponentManager<ezTestComponentManager>();
+    ezTestValueComponentManager* pValueMan = world.GetOrCreateComponentManager<ezTestValueComponentManager>();
+
+    const char* szNames[] = {"Alpha", "Beta", "Gamma", "Delta"};
+
+    ezGameObjectDesc gd;
+    gd.m_bDynamic = true;
+
+    ezGameObject* pRoot = nullptr;
+    gd.m_hParent = world.CreateObject(gd, pRoot);
+
+    for (ezUInt32 i = 0; i < uiNumChildren; ++i)
+    {
+      gd.m_LocalPosition.Set(i * 2.0f, 0, 0);
+
+      ezGameObject* pChild = nullptr;
+      world.CreateObject(gd, pChild);
+
+      ezTestComponent* pComponent = nullptr;
+      pMan->CreateComponent(pChild, pComponent);
+      pComponent->m_uiValue = i;
+      pComponent->m_sName.Assign(szNames[i % EZ_ARRAY_SIZE(szNames)]);
 
+      // only some objects get a second component, so the component types have different amounts of data
+      if (i % 3 == 0)
+      {
+        ezTestValueComponent* pValueComponent = nullptr;
+        pValueMan->CreateComponent(pChild, pValueComponent);
+        pValueComponent->m_vValue.Set((float)i, (float)i * 0.5f, -(float)i);
+      }
+    }
+
+    const ezGameObject* rootObjects[] = {pRoot};
+
+    ezMemoryStreamWriter writer(&storage);
+    ezWorldWriter worldWriter;
+    worldWriter.WriteObjects(writer, rootObjects);
+
+    ezMemoryStreamReader streamReader(&storage);
+    EZ_TEST_BOOL(reader.ReadWorldDescription(streamReader).Succeeded());
+  }
+
+  void MeasureInstantiationRate(ezWorldReader& reader, ezUInt32 uiNumInstances, bool bBatched)
+  {
+    ezWorldDesc worldDesc("Test");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezDynamicArray<ezTransform> transforms;
+    transforms.SetCountUninitialized(uiNumInstances);
+    for (ezUInt32 i = 0; i < uiNumInstances; ++i)
+    {
+      transforms[i] = ezTransform(ezVec3((float)(i % 100), (float)(i / 100), 0));
+    }
+
+    ezStopwatch sw;
+
+    if (bBatched)
+    {
+      reader.InstantiatePrefabs(world, transforms, ezGameObjectHandle(), nullptr, nullptr, false);
+    }
+    else
+    {
+      for (const ezTransform& transform : transforms)
+      {
+        reader.InstantiatePrefab(world, transform, ezGameObjectHandle(), nullptr, nullptr, nullptr, false);
+      }
+    }
+
+    const ezTime tDiff = sw.Checkpoint();
+
+    EZ_TEST_INT(world.GetObjectCount(), uiNumInstances * (reader.GetRootObjectCount() + reader.GetChildObjectCount()));
+
+    // every instance must have deserialized its own components, each child has a unique value within the prefab
+    const ezTestComponentManager* pMan = world.GetComponentManager<ezTestComponentManager>();
+    if (EZ_TEST_BOOL(pMan != nullptr))
+    {
+      const ezUInt32 uiNumChildren = reader.GetChildObjectCount();
+      EZ_TEST_INT(pMan->GetComponentCount(), uiNumInstances * uiNumChildren);
+
+      ezUInt64 uiValueSum = 0;
+      for (auto it = pMan->GetComponents(); it.IsValid(); ++it)
+      {
+        const ezTestComponent* pComponent = it;
+        uiValueSum += pComponent->m_uiValue;
+      }
+
+      EZ_TEST_INT(uiValueSum, (ezUInt64)uiNumInstances * uiNumChildren * (uiNumChildren - 1) / 2);
+    }
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Instantiating %u prefabs (%s): %.2fms, %.0f instances/sec", uiNumInstances,
+      bBatched ? "batched" : "single", tDiff.GetMilliseconds(), uiNumInstances / tDiff.GetSeconds());
+  }
+
+  void MeasureWorldInstantiation(ezWorldReader& reader, bool bParallel, ezDynamicArray<ezTestObjectState>& out_ObjectStates)
+  {
+    ezCVarBool* pCVar = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("g_ParallelWorldDeserialization"));
+    EZ_TEST_BOOL(pCVar != nullptr);
+
+    const bool bPrevValue = *pCVar;
+    *pCVar = bParallel;
+
+    ezWorldDesc worldDesc("Test");
+    ezWorld world(worldDesc);
+
+    ezStopwatch sw;
+
+    reader.InstantiateWorld(world);
+
+    const ezTime tDiff = sw.Checkpoint();
+
+    *pCVar = bPrevValue;
+
+    EZ_LOCK(world.GetReadMarker());
+    EZ_TEST_INT(world.GetObjectCount(), reader.GetRootObjectCount() + reader.GetChildObjectCount());
+
+    const ezWorldReader::InstantiationStats& stats = reader.GetLastInstantiationStats();
+    EZ_TEST_BOOL(stats.m_bParallelDeserialization == bParallel);
+
+    ezTestFramework::Output(ezTestOutput::Duration,
+      "Instantiating world with %u objects (%s deserialization): %.2fms (objects %.2fms, components %.2fms, deserialize %.2fms, init %.2fms)",
+      world.GetObjectCount(), bParallel ? "parallel" : "serial", tDiff.GetMilliseconds(), stats.m_CreateObjects.GetMilliseconds(),
+      stats.m_CreateComponents.GetMilliseconds(), stats.m_DeserializeComponents.GetMilliseconds(), stats.m_InitComponents.GetMilliseconds());
+
+    // gather the deserialized state indexed by the value of the test component, which is unique per object
+    const ezTestComponentManager* pMan = world.GetComponentManager<ezTestComponentManager>();
+    if (!EZ_TEST_BOOL(pMan != nullptr))
+      return;
+
+    out_ObjectStates.Clear();
+    out_ObjectStates.SetCount(pMan->GetComponentCount());
+
+    for (auto it = pMan->GetComponents(); it.IsValid(); ++it)
+    {
+      const ezTestComponent* pComponent = it;
+      if (!EZ_TEST_BOOL(pComponent->m_uiValue < out_ObjectStates.GetCount()))
+        return;
+
+      ezTestObjectState& state = out_ObjectStates[pComponent->m_uiValue];
+      state.m_vPosition = pComponent->GetOwner()->GetLocalPosition();
+      state.m_sName = pComponent->m_sName;
+
+      const ezTestValueComponent* pValueComponent = nullptr;
+      if (pComponent->GetOwner()->TryGetComponentOfBaseType(pValueComponent))
+      {
+        state.m_vValue = pValueComponent->m_vValue;
+        state.m_bHasValueComponent = true;
+      }
+    }
+  }
+
+} // namespace
 
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
-static const ezTestBlock::Enum EnableInRelease = ezTestBlock::DisabledNoWarning;
-#else
-static const ezTestBlock::Enum EnableInRelease = ezTestBlock::Enabled;
-#endif
 
 EZ_CREATE_SIMPLE_TEST(World, Profile_Creation)
 {
-  EZ_TEST_BLOCK(EnableInRelease, "Create many objects")
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Create many objects")
   {
     // it makes no difference whether we create static or dynamic objects
     static bool bDynamic = true;
@@ -146,7 +377,7 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Creation)
 
 EZ_CREATE_SIMPLE_TEST(World, Profile_Deletion)
 {
-  EZ_TEST_BLOCK(EnableInRelease, "Delete many objects")
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Delete many objects")
   {
     ezWorldDesc worldDesc("Test");
     ezWorld world(worldDesc);
@@ -167,7 +398,7 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Deletion)
 
 EZ_CREATE_SIMPLE_TEST(World, Profile_Update)
 {
-  EZ_TEST_BLOCK(EnableInRelease, "Update 1,000,000 static objects")
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Update 1,000,000 static objects")
   {
     ezWorldDesc worldDesc("Test");
     ezWorld world(worldDesc);
@@ -187,7 +418,7 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Update)
     }
   }
 
-  EZ_TEST_BLOCK(EnableInRelease, "Update 100,000 dynamic objects")
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Update 100,000 dynamic objects")
   {
     ezWorldDesc worldDesc("Test");
     ezWorld world(worldDesc);
@@ -207,7 +438,7 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Update)
     }
   }
 
-  EZ_TEST_BLOCK(EnableInRelease, "Update 100,000 dynamic objects with components")
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Update 100,000 dynamic objects with components")
   {
     ezWorldDesc worldDesc("Test");
     ezWorld world(worldDesc);
@@ -227,7 +458,7 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Update)
     }
   }
 
-  EZ_TEST_BLOCK(EnableInRelease, "Update 250,000 dynamic objects")
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Update 250,000 dynamic objects")
   {
     ezWorldDesc worldDesc("Test");
     ezWorld world(worldDesc);
@@ -247,7 +478,7 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Update)
     }
   }
 
-  EZ_TEST_BLOCK(EnableInRelease, "MT Update 250,000 dynamic objects")
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "MT Update 250,000 dynamic objects")
   {
     ezWorldDesc worldDesc("Test");
     worldDesc.m_bAutoCreateSpatialSystem = false; // allows multi-threaded update
@@ -268,7 +499,7 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Update)
     }
   }
 
-  EZ_TEST_BLOCK(EnableInRelease, "MT Update 1,000,000 dynamic objects")
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "MT Update 1,000,000 dynamic objects")
   {
     ezWorldDesc worldDesc("Test");
     worldDesc.m_bAutoCreateSpatialSystem = false; // allows multi-threaded update
@@ -289,3 +520,56 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Update)
     }
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(World, Profile_Instantiation)
+{
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Instantiate 10,000 prefabs")
+  {
+    ezMemoryStreamStorage storage;
+    ezWorldReader reader;
+    CreatePrefabTemplate(reader, storage, 8);
+
+    MeasureInstantiationRate(reader, 10000, false);
+    MeasureInstantiationRate(reader, 10000, true);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Instantiate world with 100,000 components")
+  {
+    ezMemoryStreamStorage storage;
+    ezWorldReader reader;
+    CreatePrefabTemplate(reader, storage, 100000);
+
+    ezDynamicArray<ezTestObjectState> serialStates;
+    ezDynamicArray<ezTestObjectState> parallelStates;
+
+    MeasureWorldInstantiation(reader, false, serialStates);
+    MeasureWorldInstantiation(reader, true, parallelStates);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parallel deserialization matches serial deserialization")
+  {
+    ezMemoryStreamStorage storage;
+    ezWorldReader reader;
+    CreatePrefabTemplate(reader, storage, 2000);
+
+    ezDynamicArray<ezTestObjectState> serialStates;
+    ezDynamicArray<ezTestObjectState> parallelStates;
+
+    MeasureWorldInstantiation(reader, false, serialStates);
+    MeasureWorldInstantiation(reader, true, parallelStates);
+
+    EZ_TEST_INT(serialStates.GetCount(), 2000);
+    EZ_TEST_INT(parallelStates.GetCount(), serialStates.GetCount());
+
+    ezUInt32 uiNumMismatches = 0;
+    for (ezUInt32 i = 0; i < ezMath::Min(serialStates.GetCount(), parallelStates.GetCount()); ++i)
+    {
+      if (!(serialStates[i] == parallelStates[i]))
+        ++uiNumMismatches;
+    }
+
+    EZ_TEST_INT(uiNumMismatches, 0);
+    EZ_TEST_BOOL(serialStates[3].m_bHasValueComponent && serialStates[3].m_vValue == ezVec3(3.0f, 1.5f, -3.0f));
+    EZ_TEST_BOOL(serialStates[5].m_sName == ezTempHashedString("Beta"));
+  }
+}
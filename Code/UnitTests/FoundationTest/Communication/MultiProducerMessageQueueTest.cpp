@@ -0,0 +1,208 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Communication/MultiProducerMessageQueue.h>
+#include <Foundation/System/SystemInformation.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Foundation/Types/UniquePtr.h>
+
+namespace
+{
+  struct ezMsgMultiProducerTest : public ezMessage
+  {
+    EZ_DECLARE_MESSAGE_TYPE(ezMsgMultiProducerTest, ezMessage);
+  };
+
+  EZ_IMPLEMENT_MESSAGE_TYPE(ezMsgMultiProducerTest);
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezMsgMultiProducerTest, 1, ezRTTIDefaultAllocator<ezMsgMultiProducerTest>)
+  EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+  struct MetaData
+  {
+    ezUInt32 m_uiThread;
+    ezUInt32 m_uiIndex;
+  };
+
+  typedef ezMessageQueue<MetaData> TestMessageQueue;
+  typedef ezMultiProducerMessageQueue<MetaData> TestMultiProducerMessageQueue;
+
+  struct MetaDataComparer
+  {
+    template <typename Entry>
+    bool Less(const Entry& a, const Entry& b) const
+    {
+      if (a.m_MetaData.m_uiThread != b.m_MetaData.m_uiThread)
+        return a.m_MetaData.m_uiThread < b.m_MetaData.m_uiThread;
+
+      return a.m_MetaData.m_uiIndex < b.m_MetaData.m_uiIndex;
+    }
+  };
+
+  template <typename Queue>
+  class EnqueueThread : public ezThread
+  {
+  public:
+    EnqueueThread(Queue* pQueue, ezMessage* pMessage, ezUInt32 uiThread, ezUInt32 uiNumMessages)
+      : ezThread("Enqueue Thread")
+      , m_pQueue(pQueue)
+      , m_pMessage(pMessage)
+      , m_uiThread(uiThread)
+      , m_uiNumMessages(uiNumMessages)
+    {
+    }
+
+    virtual ezUInt32 Run() override
+    {
+      MetaData md;
+      md.m_uiThread = m_uiThread;
+
+      for (ezUInt32 i = 0; i < m_uiNumMessages; ++i)
+      {
+        md.m_uiIndex = i;
+        m_pQueue->Enqueue(m_pMessage, md);
+      }
+
+      return 0;
+    }
+
+  private:
+    Queue* m_pQueue;
+    ezMessage* m_pMessage;
+    ezUInt32 m_uiThread;
+    ezUInt32 m_uiNumMessages;
+  };
+
+  template <typename Queue>
+  ezTime RunEnqueueThreads(Queue* pQueue, ezMessage* pMessage, ezUInt32 uiNumThreads, ezUInt32 uiNumMessagesPerThread)
+  {
+    ezDynamicArray<ezUniquePtr<EnqueueThread<Queue>>> threads;
+
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      threads.PushBack(EZ_DEFAULT_NEW(EnqueueThread<Queue>, pQueue, pMessage, i, uiNumMessagesPerThread));
+      threads.PeekBack()->Start();
+    }
+
+    for (auto& pThread : threads)
+    {
+      pThread->Join();
+    }
+
+    return sw.GetRunningTotal();
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Communication, MultiProducerMessageQueue)
+{
+  ezMsgMultiProducerTest msg;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Enqueue / Merge")
+  {
+    TestMultiProducerMessageQueue q;
+
+    MetaData md;
+    md.m_uiThread = 0;
+
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      md.m_uiIndex = i;
+      q.Enqueue(&msg, md);
+    }
+
+    // entries are only visible after merging
+    EZ_TEST_INT(q.GetCount(), 0);
+    EZ_TEST_BOOL(q.Merge());
+    EZ_TEST_INT(q.GetCount(), 1000);
+    EZ_TEST_BOOL(!q.Merge());
+
+    // entries of a single thread keep their order
+    for (ezUInt32 i = 0; i < q.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(q[i].m_pMessage == &msg);
+      EZ_TEST_INT(q[i].m_MetaData.m_uiIndex, i);
+    }
+
+    md.m_uiIndex = 1000;
+    q.Enqueue(&msg, md);
+    EZ_TEST_BOOL(q.Merge());
+    EZ_TEST_INT(q.GetCount(), 1001);
+
+    q.Dequeue();
+    EZ_TEST_INT(q.Peek().m_MetaData.m_uiIndex, 1);
+
+    q.Clear();
+    EZ_TEST_BOOL(q.IsEmpty());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Clear")
+  {
+    TestMultiProducerMessageQueue q;
+
+    MetaData md = {0, 0};
+    q.Enqueue(&msg, md);
+    q.Merge();
+    q.Enqueue(&msg, md);
+
+    // pending entries are kept
+    q.Clear();
+    EZ_TEST_BOOL(q.IsEmpty());
+    EZ_TEST_BOOL(q.Merge());
+    EZ_TEST_INT(q.GetCount(), 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Multiple Threads")
+  {
+    const ezUInt32 uiNumThreads = 8;
+    const ezUInt32 uiNumMessagesPerThread = 10000;
+
+    TestMultiProducerMessageQueue q;
+
+    // run twice, so that the second batch of threads reuses the slots of the first one
+    for (ezUInt32 uiRun = 0; uiRun < 2; ++uiRun)
+    {
+      RunEnqueueThreads(&q, &msg, uiNumThreads, uiNumMessagesPerThread);
+
+      q.Merge();
+      EZ_TEST_INT(q.GetCount(), uiNumThreads * uiNumMessagesPerThread);
+
+      // sorting results in the same order regardless of thread timing
+      q.Sort(MetaDataComparer());
+
+      bool bAllFound = true;
+      for (ezUInt32 i = 0; i < q.GetCount(); ++i)
+      {
+        bAllFound &= q[i].m_MetaData.m_uiThread == i / uiNumMessagesPerThread;
+        bAllFound &= q[i].m_MetaData.m_uiIndex == i % uiNumMessagesPerThread;
+      }
+
+      EZ_TEST_BOOL(bAllFound);
+
+      q.Clear();
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Performance")
+  {
+    const ezUInt32 uiNumThreads = ezMath::Max(ezSystemInformation::Get().GetCPUCoreCount(), 2u);
+    const ezUInt32 uiNumMessagesPerThread = (4 * 1024 * 1024) / uiNumThreads;
+    const double fNumMessages = uiNumThreads * uiNumMessagesPerThread;
+
+    TestMessageQueue mutexQueue;
+    const ezTime tMutex = RunEnqueueThreads(&mutexQueue, &msg, uiNumThreads, uiNumMessagesPerThread);
+    mutexQueue.Clear();
+
+    TestMultiProducerMessageQueue multiProducerQueue;
+    const ezTime tMultiProducer = RunEnqueueThreads(&multiProducerQueue, &msg, uiNumThreads, uiNumMessagesPerThread);
+
+    ezStopwatch sw;
+    multiProducerQueue.Merge();
+    const ezTime tMerge = sw.GetRunningTotal();
+
+    EZ_TEST_INT(multiProducerQueue.GetCount(), uiNumThreads * uiNumMessagesPerThread);
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Enqueued %.0f messages on %u threads: %.1f M/s ezMessageQueue, %.1f M/s ezMultiProducerMessageQueue (%.2f ms merge)", fNumMessages,
+      uiNumThreads, fNumMessages / tMutex.GetMicroseconds(), fNumMessages / tMultiProducer.GetMicroseconds(), tMerge.GetMilliseconds());
+  }
+}
@@ -0,0 +1,139 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/AsyncFileReader.h>
+#include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Types/ScopeExit.h>
+
+namespace
+{
+  // the sizes vary a lot, some of the files are empty
+  static ezUInt32 GetTestFileSize(ezUInt32 uiFile) { return (uiFile % 7) * 1013 * (uiFile % 3); }
+
+  static ezUInt8 GetTestFileByte(ezUInt32 uiFile, ezUInt32 uiByte) { return static_cast<ezUInt8>(uiFile * 31 + uiByte); }
+
+  static ezAtomicInteger32 s_iNumFinished;
+
+  static void OnFileRead(ezAsyncFileRead& request)
+  {
+    s_iNumFinished.Increment();
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(IO, AsyncFileReader)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.MakeCleanPath();
+  sOutputFolder.AppendPath("IO", "AsyncFileReader");
+
+  EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sOutputFolder).Succeeded());
+
+  const ezUInt32 uiNumFiles = 300;
+
+  ezStringBuilder sFile;
+  ezDynamicArray<ezUInt8> content;
+
+  for (ezUInt32 i = 0; i < uiNumFiles; ++i)
+  {
+    content.SetCountUninitialized(GetTestFileSize(i));
+    for (ezUInt32 b = 0; b < content.GetCount(); ++b)
+    {
+      content[b] = GetTestFileByte(i, b);
+    }
+
+    sFile.Format("{0}/File{1}.bin", sOutputFolder, i);
+
+    ezOSFile file;
+    if (!EZ_TEST_BOOL(file.Open(sFile, ezFileOpenMode::Write).Succeeded()))
+      return;
+
+    file.Write(content.GetData(), content.GetCount()).IgnoreResult();
+    file.Close();
+  }
+
+  ezFileSystem::RegisterDataDirectoryFactory(ezDataDirectory::FolderType::Factory);
+  EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "AsyncFileReaderTest", "async").Succeeded());
+
+  EZ_SCOPE_EXIT(ezAsyncFileReader::SetNativeAsyncIOEnabled(true); ezFileSystem::RemoveDataDirectoryGroup("AsyncFileReaderTest"));
+
+  for (ezUInt32 uiPass = 0; uiPass < 2; ++uiPass)
+  {
+    const bool bNative = uiPass == 0;
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, bNative ? "Read (native)" : "Read (tasks)")
+    {
+      ezAsyncFileReader::SetNativeAsyncIOEnabled(bNative);
+
+      if (!bNative)
+      {
+        EZ_TEST_BOOL(!ezAsyncFileReader::IsUsingNativeAsyncIO());
+      }
+
+      ezDynamicArray<ezAsyncFileRead> requests;
+      requests.SetCount(uiNumFiles + 1);
+
+      for (ezUInt32 i = 0; i < uiNumFiles; ++i)
+      {
+        // mix rooted and relative paths
+        sFile.Format(i % 2 == 0 ? ":async/File{0}.bin" : "File{0}.bin", i);
+        requests[i].m_sFile = sFile;
+        requests[i].m_OnFinished = &OnFileRead;
+      }
+
+      requests[uiNumFiles].m_sFile = ":async/DoesNotExist.bin";
+      requests[uiNumFiles].m_OnFinished = &OnFileRead;
+
+      // file 1 is not empty
+      requests[1].m_uiMaxFileSize = GetTestFileSize(1) - 1;
+
+      s_iNumFinished = 0;
+
+      ezTaskSystem::WaitForGroup(ezAsyncFileReader::ReadFiles(requests));
+
+      EZ_TEST_INT(s_iNumFinished, uiNumFiles + 1);
+
+      EZ_TEST_BOOL(requests[1].m_Result.Failed());
+      EZ_TEST_BOOL(requests[1].m_bExceededMaxFileSize);
+      EZ_TEST_BOOL(requests[1].m_Data.IsEmpty());
+
+      for (ezUInt32 i = 0; i < uiNumFiles; ++i)
+      {
+        const ezAsyncFileRead& request = requests[i];
+
+        if (i == 1)
+          continue;
+
+        if (!EZ_TEST_BOOL(request.m_Result.Succeeded()))
+          continue;
+
+        EZ_TEST_BOOL(!request.m_bExceededMaxFileSize);
+        EZ_TEST_BOOL(!request.m_sAbsolutePath.IsEmpty());
+
+        sFile.Format("File{0}.bin", i);
+        EZ_TEST_STRING(request.m_sDataDirRelativePath, sFile);
+
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_STATS)
+        EZ_TEST_BOOL(request.m_LastModificationTime.IsValid());
+#endif
+
+        if (!EZ_TEST_INT(request.m_Data.GetCount(), GetTestFileSize(i)))
+          continue;
+
+        for (ezUInt32 b = 0; b < request.m_Data.GetCount(); ++b)
+        {
+          if (request.m_Data[b] != GetTestFileByte(i, b))
+          {
+            EZ_TEST_FAILURE("Wrong file content", "File {0} differs at byte {1}", i, b);
+            break;
+          }
+        }
+      }
+
+      EZ_TEST_BOOL(requests[uiNumFiles].m_Result.Failed());
+      EZ_TEST_BOOL(!requests[uiNumFiles].m_bExceededMaxFileSize);
+      EZ_TEST_BOOL(requests[uiNumFiles].m_Data.IsEmpty());
+    }
+  }
+}
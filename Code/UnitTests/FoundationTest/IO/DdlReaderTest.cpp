@@ -6,6 +6,7 @@
 #include <Foundation/IO/OpenDdlUtils.h>
 #include <Foundation/IO/OpenDdlWriter.h>
 #include <Foundation/Strings/StringUtils.h>
+#include <Foundation/Time/Stopwatch.h>
 #include <FoundationTest/IO/JSONTestHelpers.h>
 #include <TestFramework/Utilities/TestLogInterface.h>
 
@@ -178,6 +179,11 @@ static void TestDoc(const ezOpenDdlReader& doc, const char* szOriginal)
   TestEqual(szOriginal, recreation);
 }
 
+static ezArrayPtr<const ezUInt8> ToBuffer(const char* szData)
+{
+  return ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(szData), ezStringUtils::GetStringElementCount(szData));
+}
+
 EZ_CREATE_SIMPLE_TEST(IO, DdlReader)
 {
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Basics and Comments")
@@ -331,4 +337,91 @@ string{\"s\\2\",\"bla\"}\n\
     ezOpenDdlReader doc;
     EZ_TEST_BOOL(doc.ParseDocument(stream).Failed());
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Buffer")
+  {
+    const char* szTestData = "\
+// comment\n\
+Node\n\
+{\n\
+	/* block\n\
+	comment */ string{\"ConstantColor with a longer text\",\"esc\\\\aped\\\"\\n\",\"\"}\n\
+	float{1.2,3,40,0.5,60}\n\
+	int8{0,127,32,-127,-127}\n\
+	bool{true,false}\n\
+}\n\
+";
+
+    StringStream stream(szTestData);
+    ezOpenDdlReader docStream;
+    EZ_TEST_BOOL(docStream.ParseDocument(stream).Succeeded());
+
+    ezOpenDdlReader docBuffer;
+    EZ_TEST_BOOL(docBuffer.ParseDocument(ToBuffer(szTestData)).Succeeded());
+    EZ_TEST_BOOL(!docBuffer.HadFatalParsingError());
+
+    ezStringBuilder sFromStream, sFromBuffer;
+    WriteToString(docStream, sFromStream);
+    WriteToString(docBuffer, sFromBuffer);
+    TestEqual(sFromStream, sFromBuffer);
+
+    const ezOpenDdlReaderElement* pStrings = docBuffer.GetRootElement()->GetFirstChild()->GetFirstChild();
+    if (EZ_TEST_BOOL(pStrings != nullptr && pStrings->HasPrimitives(ezOpenDdlPrimitiveType::String, 3)))
+    {
+      EZ_TEST_BOOL(pStrings->GetPrimitivesString()[0] == "ConstantColor with a longer text");
+      EZ_TEST_BOOL(pStrings->GetPrimitivesString()[1] == "esc\\aped\"\n");
+      EZ_TEST_BOOL(pStrings->GetPrimitivesString()[2].IsEmpty());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Buffer Fatal Errors")
+  {
+    // the same line and column must be reported as when reading from a stream
+    const char* szTestData = "\
+string{\"s1\",\"back\\slash\"\n\
+string{\"s\\2\",\"bla\"}\n\
+";
+
+    ezTestLogInterface log;
+    ezTestLogSystemScope logSystemScope(&log);
+
+    log.ExpectMessage("Unknown escape-sequence '\\s'", ezLogMsgType::WarningMsg);
+    log.ExpectMessage("Line 2 (2): Expected , or } or a \"", ezLogMsgType::ErrorMsg);
+
+    ezOpenDdlReader doc;
+    EZ_TEST_BOOL(doc.ParseDocument(ToBuffer(szTestData)).Failed());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Performance")
+  {
+    ezStringBuilder sDocument;
+    for (ezUInt32 i = 0; i < 20000; ++i)
+    {
+      sDocument.AppendFormat("Object %Obj{0}\n{\n\t// some comment\n\tName{string{\"Object number {0} with some text\"}}\n\tfloat{1.5,-2.25,3.125,{0}}\n\tint32{1,2,3,{0}}\n}\n", i);
+    }
+
+    const double fMegaBytes = sDocument.GetElementCount() / (1024.0 * 1024.0);
+
+    ezStopwatch sw;
+
+    {
+      StringStream stream(sDocument.GetData());
+      ezOpenDdlReader doc;
+      EZ_TEST_BOOL(doc.ParseDocument(stream).Succeeded());
+      EZ_TEST_INT(doc.GetRootElement()->GetNumChildObjects(), 20000);
+    }
+
+    const ezTime tStream = sw.Checkpoint();
+
+    {
+      ezOpenDdlReader doc;
+      EZ_TEST_BOOL(doc.ParseDocument(ToBuffer(sDocument)).Succeeded());
+      EZ_TEST_INT(doc.GetRootElement()->GetNumChildObjects(), 20000);
+    }
+
+    const ezTime tBuffer = sw.Checkpoint();
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Parsing %.1f MB of DDL: stream %.1f MB/s, buffer %.1f MB/s", fMegaBytes,
+      fMegaBytes / tStream.GetSeconds(), fMegaBytes / tBuffer.GetSeconds());
+  }
 }
@@ -0,0 +1,231 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/DirectoryWatcher.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Utilities/ConversionUtils.h>
+
+#if EZ_ENABLED(EZ_PLATFORM_WINDOWS_DESKTOP) || EZ_ENABLED(EZ_PLATFORM_LINUX)
+
+#  include <stdio.h>
+
+namespace
+{
+  struct ezTestFileChange
+  {
+    ezString m_sFile;
+    ezDirectoryWatcherAction m_Action;
+  };
+
+  void WriteTestFile(const char* szFile)
+  {
+    ezOSFile file;
+    if (EZ_TEST_BOOL(file.Open(szFile, ezFileOpenMode::Write).Succeeded()))
+    {
+      EZ_TEST_BOOL(file.Write("test", 4).Succeeded());
+    }
+  }
+
+  void CollectChanges(ezDirectoryWatcher& watcher, ezDynamicArray<ezTestFileChange>& out_Changes, bool* out_pMissedChanges = nullptr)
+  {
+    out_Changes.Clear();
+
+    if (out_pMissedChanges)
+      *out_pMissedChanges = false;
+
+    // some platforms deliver the events asynchronously
+    for (ezUInt32 i = 0; i < 5; ++i)
+    {
+      ezThreadUtils::Sleep(ezTime::Milliseconds(20));
+
+      watcher.EnumerateChanges([&](const char* szFile, ezDirectoryWatcherAction action) {
+        ezStringBuilder sFile = szFile;
+        sFile.MakeCleanPath();
+
+        auto& change = out_Changes.ExpandAndGetRef();
+        change.m_sFile = sFile;
+        change.m_Action = action;
+      });
+
+      if (out_pMissedChanges)
+        *out_pMissedChanges |= watcher.HasMissedChanges();
+    }
+  }
+
+  bool HasChange(const ezDynamicArray<ezTestFileChange>& changes, const char* szFile, ezDirectoryWatcherAction action)
+  {
+    for (const auto& change : changes)
+    {
+      if (change.m_sFile == szFile && change.m_Action == action)
+        return true;
+    }
+
+    return false;
+  }
+
+  bool HasChangeInDirectory(const ezDynamicArray<ezTestFileChange>& changes, const char* szDirectory)
+  {
+    for (const auto& change : changes)
+    {
+      if (change.m_sFile.StartsWith(szDirectory))
+        return true;
+    }
+
+    return false;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(IO, DirectoryWatcher)
+{
+  // folders can't be deleted on every platform, so every run uses its own ones
+  ezStringBuilder sRunID;
+  sRunID.Format("{0}", static_cast<ezUInt64>(ezTime::Now().GetMicroseconds()));
+
+  ezStringBuilder sRoot = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sRoot.MakeCleanPath();
+  sRoot.AppendPath("IO", "DirectoryWatcher", sRunID, "Watched");
+
+  ezStringBuilder sOutside = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutside.MakeCleanPath();
+  sOutside.AppendPath("IO", "DirectoryWatcher", sRunID, "Outside");
+
+  EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sRoot).Succeeded());
+  EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sOutside).Succeeded());
+
+  ezStringBuilder sPath, sPath2;
+  ezDynamicArray<ezTestFileChange> changes;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "New Directories")
+  {
+    ezDirectoryWatcher watcher;
+    if (!EZ_TEST_BOOL(watcher.OpenDirectory(sRoot, ezDirectoryWatcher::Watch::Creates | ezDirectoryWatcher::Watch::Writes | ezDirectoryWatcher::Watch::Renames | ezDirectoryWatcher::Watch::Subdirectories).Succeeded()))
+      return;
+
+    // the file is created before the watcher had a chance to see the new directories
+    sPath.Set(sRoot, "/NewDir/Sub");
+    EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sPath).Succeeded());
+    sPath.Set(sRoot, "/NewDir/Sub/File.txt");
+    WriteTestFile(sPath);
+
+    CollectChanges(watcher, changes);
+    EZ_TEST_BOOL(HasChange(changes, "NewDir/Sub/File.txt", ezDirectoryWatcherAction::Added));
+
+    // the new directories are watched from now on
+    sPath.Set(sRoot, "/NewDir/Sub/Later.txt");
+    WriteTestFile(sPath);
+
+    CollectChanges(watcher, changes);
+    EZ_TEST_BOOL(HasChange(changes, "NewDir/Sub/Later.txt", ezDirectoryWatcherAction::Added));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Moved Directories")
+  {
+    sPath.Set(sRoot, "/MoveSrc/Inner");
+    EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sPath).Succeeded());
+    sPath.Set(sRoot, "/MoveSrc/Inner/File.txt");
+    WriteTestFile(sPath);
+
+    ezDirectoryWatcher watcher;
+    if (!EZ_TEST_BOOL(watcher.OpenDirectory(sRoot, ezDirectoryWatcher::Watch::Creates | ezDirectoryWatcher::Watch::Writes | ezDirectoryWatcher::Watch::Renames | ezDirectoryWatcher::Watch::Subdirectories).Succeeded()))
+      return;
+
+    // move inside of the watched directory
+    sPath.Set(sRoot, "/MoveSrc");
+    sPath2.Set(sRoot, "/MoveDst");
+    EZ_TEST_INT(rename(sPath, sPath2), 0);
+
+    CollectChanges(watcher, changes);
+    EZ_TEST_BOOL(HasChange(changes, "MoveSrc", ezDirectoryWatcherAction::RenamedOldName));
+    EZ_TEST_BOOL(HasChange(changes, "MoveDst", ezDirectoryWatcherAction::RenamedNewName));
+
+    // changes in the moved directory are reported with the new path
+    sPath.Set(sRoot, "/MoveDst/Inner/File.txt");
+    WriteTestFile(sPath);
+
+    CollectChanges(watcher, changes);
+    EZ_TEST_BOOL(HasChange(changes, "MoveDst/Inner/File.txt", ezDirectoryWatcherAction::Modified));
+    EZ_TEST_BOOL(!HasChangeInDirectory(changes, "MoveSrc"));
+
+    // move out of the watched directory
+    sPath.Set(sRoot, "/MoveDst");
+    sPath2.Set(sOutside, "/MoveDst");
+    EZ_TEST_INT(rename(sPath, sPath2), 0);
+
+    // some platforms report this as a removal
+    CollectChanges(watcher, changes);
+    EZ_TEST_BOOL(HasChange(changes, "MoveDst", ezDirectoryWatcherAction::RenamedOldName) || HasChange(changes, "MoveDst", ezDirectoryWatcherAction::Removed));
+
+    // the directory is not watched anymore
+    sPath.Set(sOutside, "/MoveDst/Inner/File.txt");
+    WriteTestFile(sPath);
+
+    CollectChanges(watcher, changes);
+    EZ_TEST_BOOL(changes.IsEmpty());
+  }
+
+#  if EZ_ENABLED(EZ_PLATFORM_LINUX)
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Overflow")
+  {
+    ezUInt32 uiMaxQueuedEvents = 0;
+
+    {
+      char szContent[32] = {};
+
+      ezOSFile file;
+      if (file.Open("/proc/sys/fs/inotify/max_queued_events", ezFileOpenMode::Read).Succeeded())
+      {
+        file.Read(szContent, sizeof(szContent) - 1);
+      }
+
+      ezConversionUtils::StringToUInt(szContent, uiMaxQueuedEvents).IgnoreResult();
+    }
+
+    // overflowing a large queue would take too long
+    if (uiMaxQueuedEvents > 0 && uiMaxQueuedEvents <= 64 * 1024)
+    {
+      ezDirectoryWatcher watcher;
+      if (!EZ_TEST_BOOL(watcher.OpenDirectory(sRoot, ezDirectoryWatcher::Watch::Creates | ezDirectoryWatcher::Watch::Subdirectories).Succeeded()))
+        return;
+
+      sPath.Set(sRoot, "/Overflow");
+      EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sPath).Succeeded());
+
+      for (ezUInt32 i = 0; i <= uiMaxQueuedEvents; ++i)
+      {
+        sPath.Format("{0}/Overflow/File{1}.txt", sRoot, i);
+
+        ezOSFile file;
+        file.Open(sPath, ezFileOpenMode::Write).IgnoreResult();
+      }
+
+      // the event for this directory is lost, it still has to be watched afterwards
+      sPath.Set(sRoot, "/LostDir");
+      EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sPath).Succeeded());
+
+      bool bMissedChanges = false;
+      CollectChanges(watcher, changes, &bMissedChanges);
+      EZ_TEST_BOOL(bMissedChanges);
+
+      sPath.Set(sRoot, "/LostDir/File.txt");
+      WriteTestFile(sPath);
+
+      CollectChanges(watcher, changes, &bMissedChanges);
+      EZ_TEST_BOOL(!bMissedChanges);
+      EZ_TEST_BOOL(HasChange(changes, "LostDir/File.txt", ezDirectoryWatcherAction::Added));
+
+      for (ezUInt32 i = 0; i <= uiMaxQueuedEvents; ++i)
+      {
+        sPath.Format("{0}/Overflow/File{1}.txt", sRoot, i);
+        ezOSFile::DeleteFile(sPath).IgnoreResult();
+      }
+    }
+  }
+#  endif
+
+#  if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS)
+  ezOSFile::DeleteFolder(sRoot).IgnoreResult();
+  ezOSFile::DeleteFolder(sOutside).IgnoreResult();
+#  endif
+}
+
+#endif
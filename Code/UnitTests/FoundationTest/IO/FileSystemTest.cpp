@@ -4,6 +4,10 @@
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Foundation/Types/ScopeExit.h>
 
 #if EZ_ENABLED(EZ_SUPPORTS_LONG_PATHS)
 #  define LongPath                                                                                                                                   \
@@ -364,3 +368,291 @@ Only concrete and clocks.\n\
     ezFileSystem::RemoveDataDirectoryGroup("remove");
   }
 }
+
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS)
+
+EZ_CREATE_SIMPLE_TEST(IO, FileSystemIndex)
+{
+  constexpr ezUInt32 uiNumDataDirs = 8;
+
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("IO", "FileIndex");
+  sOutputFolder.MakeCleanPath();
+
+  ezStringBuilder sOutputFolderResolved;
+  ezFileSystem::ResolveSpecialDirectory(sOutputFolder, sOutputFolderResolved).IgnoreResult();
+
+  ezStringBuilder sPath, sDataDir, sRoot;
+
+  // every data directory contains one file that only exists there
+  for (ezUInt32 i = 0; i < uiNumDataDirs; ++i)
+  {
+    sPath.Format("{0}/Dir{1}/Sub/File{1}.txt", sOutputFolderResolved, i);
+
+    ezOSFile file;
+    EZ_TEST_BOOL(file.Open(sPath, ezFileOpenMode::Write).Succeeded());
+    EZ_TEST_BOOL(file.Write("Test", 4).Succeeded());
+    file.Close();
+  }
+
+  auto MountDataDirs = [&](bool bIndexed) {
+    ezDataDirectory::FolderType::s_bEnableFileIndex = bIndexed;
+
+    for (ezUInt32 i = 0; i < uiNumDataDirs; ++i)
+    {
+      sDataDir.Format("{0}/Dir{1}", sOutputFolder, i);
+      sRoot.Format("index{0}", i);
+      EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sDataDir, "FileIndex", sRoot, ezFileSystem::AllowWrites).Succeeded());
+    }
+
+    ezDataDirectory::FolderType::s_bEnableFileIndex = false;
+  };
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Lookup")
+  {
+    MountDataDirs(true);
+
+    for (ezUInt32 i = 0; i < uiNumDataDirs; ++i)
+    {
+      const ezDataDirectory::FolderType* pDataDir = static_cast<const ezDataDirectory::FolderType*>(ezFileSystem::GetDataDirectory(ezFileSystem::GetNumDataDirectories() - 1 - i));
+
+      EZ_TEST_BOOL(pDataDir->HasFileIndex());
+
+      sPath.Format("Sub/File{0}.txt", i);
+      EZ_TEST_BOOL(ezFileSystem::ExistsFile(sPath));
+
+      ezFileStats stats;
+      EZ_TEST_BOOL(ezFileSystem::GetFileStats(sPath, stats).Succeeded());
+      EZ_TEST_INT(stats.m_uiFileSize, 4);
+      EZ_TEST_BOOL(ezFileSystem::GetFileStats("Sub", stats).Succeeded());
+      EZ_TEST_BOOL(stats.m_bIsDirectory);
+
+      ezStringBuilder sAbsPath;
+      ezDataDirectoryType* pFoundDir = nullptr;
+      EZ_TEST_BOOL(ezFileSystem::ResolvePath(sPath, &sAbsPath, nullptr, &pFoundDir).Succeeded());
+      EZ_TEST_BOOL(pFoundDir == pDataDir);
+
+      sPath.Format("Sub/DoesNotExist{0}.txt", i);
+      EZ_TEST_BOOL(!ezFileSystem::ExistsFile(sPath));
+
+      // paths that leave the data directory are not in the index, but still work
+      sPath.Format("../Dir{0}/Sub/File{0}.txt", i);
+      EZ_TEST_BOOL(ezFileSystem::ExistsFile(sPath));
+
+      ezFileReader file;
+      EZ_TEST_BOOL(file.Open(sPath).Succeeded());
+    }
+
+    // files written through the file system are added to the index right away
+    {
+      ezFileWriter file;
+      EZ_TEST_BOOL(file.Open(":index3/Written/NewFile.txt").Succeeded());
+    }
+
+    EZ_TEST_BOOL(ezFileSystem::ExistsFile("Written/NewFile.txt"));
+    EZ_TEST_BOOL(ezFileSystem::ExistsFile(":index3/Written/NewFile.txt"));
+    EZ_TEST_BOOL(!ezFileSystem::ExistsFile(":index4/Written/NewFile.txt"));
+
+    ezFileSystem::DeleteFile(":index3/Written/NewFile.txt");
+    EZ_TEST_BOOL(!ezFileSystem::ExistsFile("Written/NewFile.txt"));
+
+    // files that are created behind the back of the file system are picked up by the directory watcher, even if they were missing before
+    EZ_TEST_BOOL(!ezFileSystem::ExistsFile("External/ExternalFile.txt"));
+
+    {
+      sPath.Format("{0}/Dir5/External/ExternalFile.txt", sOutputFolderResolved);
+
+      ezOSFile file;
+      EZ_TEST_BOOL(file.Open(sPath, ezFileOpenMode::Write).Succeeded());
+      file.Close();
+    }
+
+    // on some platforms change notifications arrive asynchronously
+    bool bFound = false;
+    for (ezUInt32 uiTry = 0; uiTry < 50 && !bFound; ++uiTry)
+    {
+      bFound = ezFileSystem::ExistsFile("External/ExternalFile.txt");
+
+      if (!bFound)
+        ezThreadUtils::Sleep(ezTime::Milliseconds(20));
+    }
+    EZ_TEST_BOOL(bFound);
+
+    ezOSFile::DeleteFile(sPath).IgnoreResult();
+
+    ezFileSystem::RemoveDataDirectoryGroup("FileIndex");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Performance")
+  {
+    const ezUInt32 uiNumLookups = 10000;
+
+    for (ezUInt32 uiPass = 0; uiPass < 2; ++uiPass)
+    {
+      const bool bIndexed = uiPass == 1;
+      MountDataDirs(bIndexed);
+
+      ezStopwatch sw;
+
+      // the file only exists in the data directory with the lowest priority, all others have to be searched first
+      for (ezUInt32 i = 0; i < uiNumLookups; ++i)
+      {
+        ezFileReader file;
+        EZ_TEST_BOOL(file.Open("Sub/File0.txt").Succeeded());
+      }
+
+      const ezTime tOpen = sw.Checkpoint();
+
+      for (ezUInt32 i = 0; i < uiNumLookups; ++i)
+      {
+        EZ_TEST_BOOL(!ezFileSystem::ExistsFile("Sub/Missing.txt"));
+      }
+
+      const ezTime tMissing = sw.Checkpoint();
+
+      ezTestFramework::Output(ezTestOutput::Duration, "%s: %u x open through %u data dirs: %.2fms, %u x missing file: %.2fms", bIndexed ? "Indexed" : "Not indexed", uiNumLookups,
+        uiNumDataDirs, tOpen.GetMilliseconds(), uiNumLookups, tMissing.GetMilliseconds());
+
+      ezFileSystem::RemoveDataDirectoryGroup("FileIndex");
+    }
+  }
+}
+
+#endif
+
+#if EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE)
+
+EZ_CREATE_SIMPLE_TEST(IO, FileSystemMemoryMapped)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.MakeCleanPath();
+  sOutputFolder.AppendPath("IO", "MemoryMapped");
+
+  const ezUInt32 uiLargeFileSize = 1024 * 1024;
+
+  {
+    ezDynamicArray<ezUInt8> content;
+    content.SetCountUninitialized(uiLargeFileSize);
+
+    for (ezUInt32 i = 0; i < uiLargeFileSize; ++i)
+    {
+      content[i] = static_cast<ezUInt8>(i * 7);
+    }
+
+    ezOSFile file;
+    ezStringBuilder sFile = sOutputFolder;
+    sFile.AppendPath("Large.bin");
+    EZ_TEST_BOOL(file.Open(sFile, ezFileOpenMode::Write).Succeeded());
+    file.Write(content.GetData(), content.GetCount()).IgnoreResult();
+    file.Close();
+
+    sFile = sOutputFolder;
+    sFile.AppendPath("Small.bin");
+    EZ_TEST_BOOL(file.Open(sFile, ezFileOpenMode::Write).Succeeded());
+    file.Write(content.GetData(), 100).IgnoreResult();
+    file.Close();
+  }
+
+  EZ_SCOPE_EXIT(ezDataDirectory::FolderType::s_bMemoryMapFiles = false; ezFileSystem::RemoveDataDirectoryGroup("MemoryMapped"));
+
+  ezFileSystem::RegisterDataDirectoryFactory(ezDataDirectory::FolderType::Factory);
+
+  ezDataDirectory::FolderType::s_bMemoryMapFiles = true;
+  EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "MemoryMapped", "mapped").Succeeded());
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Read In Place")
+  {
+    ezFileReader file;
+    if (!EZ_TEST_BOOL(file.Open(":mapped/Large.bin").Succeeded()))
+      return;
+
+    ezArrayPtr<const ezUInt8> data;
+    EZ_TEST_BOOL(file.GetRemainingContiguousData(data));
+    EZ_TEST_INT(data.GetCount(), uiLargeFileSize);
+
+    ezUInt8 buffer[16];
+    EZ_TEST_INT(file.ReadBytes(buffer, 16), 16);
+    EZ_TEST_INT(file.SkipBytes(1000), 1000);
+
+    for (ezUInt32 i = 0; i < 16; ++i)
+    {
+      EZ_TEST_INT(buffer[i], static_cast<ezUInt8>(i * 7));
+    }
+
+    ezArrayPtr<const ezUInt8> remaining;
+    EZ_TEST_BOOL(file.GetRemainingContiguousData(remaining));
+    EZ_TEST_BOOL(remaining.GetPtr() == data.GetPtr() + 1016);
+    EZ_TEST_INT(remaining.GetCount(), uiLargeFileSize - 1016);
+    EZ_TEST_INT(remaining[0], static_cast<ezUInt8>(1016 * 7));
+
+    EZ_TEST_INT(file.SkipBytes(uiLargeFileSize), uiLargeFileSize - 1016);
+    EZ_TEST_INT(file.ReadBytes(buffer, 16), 0);
+
+    // the memory was handed out, so it stays mapped
+    EZ_TEST_BOOL(file.GetRemainingContiguousData(remaining));
+    EZ_TEST_INT(remaining.GetCount(), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Release Mapping After Streamed Read")
+  {
+    ezFileReader file;
+    if (!EZ_TEST_BOOL(file.Open(":mapped/Large.bin").Succeeded()))
+      return;
+
+    ezDynamicArray<ezUInt8> content;
+    content.SetCountUninitialized(uiLargeFileSize);
+    EZ_TEST_INT(file.ReadBytes(content.GetData(), uiLargeFileSize - 16), uiLargeFileSize - 16);
+    EZ_TEST_INT(file.ReadBytes(content.GetData() + uiLargeFileSize - 16, 32), 16);
+    EZ_TEST_INT(content[uiLargeFileSize - 1], static_cast<ezUInt8>((uiLargeFileSize - 1) * 7));
+
+    // read to the end without looking at the memory directly, the mapping is gone
+    ezArrayPtr<const ezUInt8> remaining;
+    EZ_TEST_BOOL(!file.GetRemainingContiguousData(remaining));
+    EZ_TEST_INT(file.ReadBytes(content.GetData(), 16), 0);
+    EZ_TEST_INT(file.SkipBytes(16), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Small Files Are Not Mapped")
+  {
+    ezFileReader file;
+    if (!EZ_TEST_BOOL(file.Open(":mapped/Small.bin").Succeeded()))
+      return;
+
+    ezArrayPtr<const ezUInt8> data;
+    EZ_TEST_BOOL(!file.GetRemainingContiguousData(data));
+    EZ_TEST_BOOL(!ezDataDirectory::FolderType::IsMemoryMappedFileSize(file.GetFileSize()));
+
+    ezUInt8 buffer[128];
+    EZ_TEST_INT(file.ReadBytes(buffer, 128), 100);
+    EZ_TEST_INT(buffer[99], static_cast<ezUInt8>(99 * 7));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Performance")
+  {
+    ezDynamicArray<ezUInt8> target;
+    target.SetCountUninitialized(uiLargeFileSize);
+
+    const ezUInt32 uiNumReads = 200;
+
+    for (ezUInt32 uiPass = 0; uiPass < 2; ++uiPass)
+    {
+      const bool bMapped = uiPass == 0;
+
+      // only affects readers that are opened afterwards
+      ezDataDirectory::FolderType::s_bMemoryMapFiles = bMapped;
+
+      ezStopwatch sw;
+
+      for (ezUInt32 i = 0; i < uiNumReads; ++i)
+      {
+        ezFileReader file;
+        EZ_TEST_BOOL(file.Open(":mapped/Large.bin").Succeeded());
+        EZ_TEST_INT(file.ReadBytes(target.GetData(), uiLargeFileSize), uiLargeFileSize);
+      }
+
+      ezTestFramework::Output(ezTestOutput::Duration, "Reading a 1MB file %u times (%s): %.2fms", uiNumReads, bMapped ? "memory mapped" : "cached reads", sw.GetRunningTotal().GetMilliseconds());
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,305 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/IO/JSONPullParser.h>
+#include <Foundation/IO/JSONReader.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
+
+namespace
+{
+  ezArrayPtr<const ezUInt8> ToBuffer(const char* szText)
+  {
+    return ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(szText), ezStringUtils::GetStringElementCount(szText));
+  }
+
+  /// \brief Writes every token as one line, names are written as 'name=' in front of the value.
+  ezString TokensToString(ezJSONPullParser& parser)
+  {
+    ezStringBuilder sResult;
+
+    while (true)
+    {
+      const ezJSONPullParser::Token token = parser.ReadNext();
+
+      if (!parser.GetName().IsEmpty())
+        sResult.AppendFormat("{}=", parser.GetName());
+
+      switch (token)
+      {
+        case ezJSONPullParser::Token::EndOfDocument:
+          return sResult;
+        case ezJSONPullParser::Token::Error:
+          sResult.Append("<error>");
+          return sResult;
+        case ezJSONPullParser::Token::BeginObject:
+          sResult.Append("{\n");
+          break;
+        case ezJSONPullParser::Token::EndObject:
+          sResult.Append("}\n");
+          break;
+        case ezJSONPullParser::Token::BeginArray:
+          sResult.Append("[\n");
+          break;
+        case ezJSONPullParser::Token::EndArray:
+          sResult.Append("]\n");
+          break;
+        case ezJSONPullParser::Token::String:
+          sResult.AppendFormat("'{}'\n", parser.GetString());
+          break;
+        case ezJSONPullParser::Token::Number:
+          sResult.AppendFormat("{}\n", ezArgF(parser.GetNumber(), 2));
+          break;
+        case ezJSONPullParser::Token::Bool:
+          sResult.Append(parser.GetBool() ? "true\n" : "false\n");
+          break;
+        case ezJSONPullParser::Token::Null:
+          sResult.Append("null\n");
+          break;
+      }
+    }
+  }
+
+  ezString ParseToString(const char* szText)
+  {
+    ezJSONPullParser parser;
+    parser.SetInputBuffer(ToBuffer(szText));
+    return TokensToString(parser);
+  }
+
+  /// \brief Creates a document that resembles a profiling capture.
+  void CreateLargeDocument(ezStringBuilder& sDocument, ezUInt32 uiNumEvents)
+  {
+    sDocument = "{\n  \"traceEvents\": [\n";
+
+    for (ezUInt32 i = 0; i < uiNumEvents; ++i)
+    {
+      sDocument.AppendFormat("    {\"name\": \"Scope{}\", \"cat\": \"Frame\", \"ph\": \"X\", \"ts\": {}.125, \"dur\": {}, \"pid\": 0, \"tid\": {}, "
+                             "\"args\": {\"path\": \"Data/Base/Scope\\\\{}\", \"valid\": true, \"parent\": null}},\n",
+        i % 100, i * 16, i % 1000, i % 8, i);
+    }
+
+    sDocument.Append("  ],\n  \"displayTimeUnit\": \"ms\"\n}\n");
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(IO, JSONPullParser)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "All Features")
+  {
+    const char* szTestData = "{ \"a\" : 1, \"b\" : \"text\", \"c\" : [ true, false, null, -2.5 ], \"d\" : { \"e\" : { } , \"f\" : [] }, \"\" : 3 }";
+
+    EZ_TEST_STRING(ParseToString(szTestData), "{\na=1.00\nb='text'\nc=[\ntrue\nfalse\nnull\n-2.50\n]\nd={\ne={\n}\nf=[\n]\n}\n3.00\n}\n");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Empty Document")
+  {
+    EZ_TEST_STRING(ParseToString(""), "");
+    EZ_TEST_STRING(ParseToString(" \n\t "), "");
+    EZ_TEST_STRING(ParseToString("/* nothing */ // here"), "");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Top-level Values")
+  {
+    EZ_TEST_STRING(ParseToString("[1,2]"), "[\n1.00\n2.00\n]\n");
+    EZ_TEST_STRING(ParseToString("\"text\""), "'text'\n");
+    EZ_TEST_STRING(ParseToString("42 // the answer"), "42.00\n");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Superfluous separators")
+  {
+    EZ_TEST_STRING(ParseToString("{\"a\":{,},,\"b\":[3.],\"c\":[.5,],\"d\":{},}"), "{\na={\n}\nb=[\n3.00\n]\nc=[\n0.50\n]\nd={\n}\n}\n");
+    EZ_TEST_STRING(ParseToString("{\"a\":[,]}"), "{\na=[\n<error>");
+    EZ_TEST_STRING(ParseToString("{\"a\":[1,,]}"), "{\na=[\n1.00\n<error>");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Comments")
+  {
+    EZ_TEST_STRING(ParseToString("/**/{//\n\"a\"/* x */:/***/true/* */, \"b\" : 23456//78\n}"), "{\na=true\nb=23456.00\n}\n");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Strings")
+  {
+    const char* szTestData = "{\"plain\":\"no escapes\",\"esc\\\"aped\":\"bla\\\\\\\"\\/\\r\\f\\n\\b\\t\"}";
+
+    ezJSONPullParser parser;
+    parser.SetInputBuffer(ToBuffer(szTestData));
+
+    EZ_TEST_BOOL(parser.ReadNext() == ezJSONPullParser::Token::BeginObject);
+
+    // strings without escape sequences point into the buffer
+    EZ_TEST_BOOL(parser.ReadNext() == ezJSONPullParser::Token::String);
+    EZ_TEST_BOOL(parser.GetName() == "plain");
+    EZ_TEST_BOOL(parser.GetString() == "no escapes");
+    EZ_TEST_BOOL(parser.GetString().GetStartPointer() == szTestData + 10);
+
+    EZ_TEST_BOOL(parser.ReadNext() == ezJSONPullParser::Token::String);
+    EZ_TEST_BOOL(parser.GetName() == "esc\"aped");
+    EZ_TEST_BOOL(parser.GetString() == "bla\\\"/\r\f\n\b\t");
+
+    EZ_TEST_BOOL(parser.ReadNext() == ezJSONPullParser::Token::EndObject);
+    EZ_TEST_BOOL(parser.ReadNext() == ezJSONPullParser::Token::EndOfDocument);
+    EZ_TEST_BOOL(!parser.HadFatalParsingError());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Unicode escape sequence")
+  {
+    const char* szTestData = "{\"a\":\"\\u0061\",\"b\":\"\\u03f6\",\"c\":\"a\\u2AD7z\",\"d\":\"\\ud83e\\uDD86\\uD83D\\uDC96\"}";
+
+    EZ_TEST_STRING(ParseToString(szTestData), "{\na='a'\nb='\xCF\xB6'\nc='a\xE2\xAB\x97z'\nd='\xF0\x9F\xA6\x86\xF0\x9F\x92\x96'\n}\n");
+
+    EZ_TEST_STRING(ParseToString("{\"a\":\"\\u006G\"}"), "{\n<error>");
+    EZ_TEST_STRING(ParseToString("{\"a\":\"\\u03f\"}"), "{\n<error>");
+    EZ_TEST_STRING(ParseToString("{\"a\":\"a\\ud83ez\"}"), "{\n<error>");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Numbers")
+  {
+    struct Number
+    {
+      const char* m_szText;
+      double m_fValue;
+    };
+
+    const Number numbers[] = {{"0", 0.0}, {"-0", -0.0}, {"+7", 7.0}, {"123456789", 123456789.0}, {"-12.75", -12.75}, {".5", 0.5}, {"3.", 3.0},
+      {"1e3", 1000.0}, {"2.5E+2", 250.0}, {"-4375e-3", -4.375}, {"0.1", 0.1}, {"0.000001", 0.000001}, {"9007199254740993", 9007199254740992.0},
+      {"123456789012345678901234", 1.2345678901234568e23}, {"1e-300", 1e-300}};
+
+    for (const Number& number : numbers)
+    {
+      ezJSONPullParser parser;
+      parser.SetInputBuffer(ToBuffer(number.m_szText));
+
+      if (EZ_TEST_BOOL(parser.ReadNext() == ezJSONPullParser::Token::Number))
+      {
+        EZ_TEST_DOUBLE(parser.GetNumber(), number.m_fValue, ezMath::Abs(number.m_fValue) * 1e-15);
+      }
+    }
+
+    // converted exactly, without rounding errors
+    {
+      ezJSONPullParser parser;
+      parser.SetInputBuffer(ToBuffer("[0.1, 2.2, 3.3, 123.456]"));
+      parser.ReadNext();
+
+      for (double fExpected : {0.1, 2.2, 3.3, 123.456})
+      {
+        parser.ReadNext();
+        EZ_TEST_BOOL(parser.GetNumber() == fExpected);
+      }
+    }
+
+    EZ_TEST_STRING(ParseToString("[-]"), "[\n<error>");
+    EZ_TEST_STRING(ParseToString("[1e]"), "[\n<error>");
+    EZ_TEST_STRING(ParseToString("[1x]"), "[\n1.00\n<error>");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Skip Value")
+  {
+    const char* szTestData = "{ \"skip_obj\" : { \"a\" : 1, \"c\" : [ { }, { \"e\" : { } } ] }, \"d\" : 3, \"skip_array\" : [ \"a\", [ 1, { } ] ], "
+                             "\"f\" : { \"g\" : 4 } }";
+
+    ezJSONPullParser parser;
+    parser.SetInputBuffer(ToBuffer(szTestData));
+
+    ezStringBuilder sResult;
+    while (true)
+    {
+      const ezJSONPullParser::Token token = parser.ReadNext();
+      if (token == ezJSONPullParser::Token::EndOfDocument || token == ezJSONPullParser::Token::Error)
+        break;
+
+      sResult.AppendFormat("{}:{} ", parser.GetName(), (ezUInt32)token);
+
+      if (parser.GetName().StartsWith("skip"))
+        parser.SkipValue();
+    }
+
+    EZ_TEST_STRING(sResult, ":1 skip_obj:1 d:6 skip_array:3 f:1 g:6 :2 :2 ");
+    EZ_TEST_BOOL(!parser.HadFatalParsingError());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Errors")
+  {
+    ezJSONPullParser parser;
+
+    {
+      ezTestLogInterface log;
+      ezTestLogSystemScope logSystemScope(&log);
+      log.ExpectMessage("Expected : to separate variable and value", ezLogMsgType::ErrorMsg);
+
+      parser.SetLogInterface(&log);
+      parser.SetInputBuffer(ToBuffer("{\n  \"a\" : 1,\n  \"b\" 2\n}"), 10);
+
+      EZ_TEST_STRING(TokensToString(parser), "{\na=1.00\n<error>");
+      EZ_TEST_BOOL(parser.HadFatalParsingError());
+      EZ_TEST_INT(parser.GetErrorLine(), 13);
+      EZ_TEST_INT(parser.GetErrorColumn(), 7);
+      EZ_TEST_BOOL(parser.ReadNext() == ezJSONPullParser::Token::Error);
+    }
+
+    parser.SetLogInterface(nullptr);
+
+    const char* szErrors[] = {"{", "{\"a\":1", "{\"a", "{\"a\":\"abc", "{\"a\":tru}", "{\"a\":NULL}", "{\"a\":\"\\x\"}", "{\"a\":1 \"b\":2}", "{1:2}", "[}"};
+
+    for (const char* szError : szErrors)
+    {
+      parser.SetInputBuffer(ToBuffer(szError));
+
+      while (parser.ReadNext() != ezJSONPullParser::Token::Error)
+      {
+        if (!EZ_TEST_BOOL_MSG(!parser.HadFatalParsingError() && parser.GetDepth() > 0, "'%s' should fail to parse", szError))
+          break;
+      }
+
+      EZ_TEST_BOOL(parser.HadFatalParsingError());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Performance")
+  {
+    ezStringBuilder sDocument;
+    CreateLargeDocument(sDocument, 100000);
+
+    const ezArrayPtr<const ezUInt8> buffer = ToBuffer(sDocument.GetData());
+    const double fMegaBytes = buffer.GetCount() / (1024.0 * 1024.0);
+
+    ezStopwatch sw;
+
+    ezUInt32 uiNumValues = 0;
+    {
+      ezJSONPullParser parser;
+      parser.SetInputBuffer(buffer);
+
+      ezJSONPullParser::Token token;
+      while ((token = parser.ReadNext()) != ezJSONPullParser::Token::EndOfDocument && token != ezJSONPullParser::Token::Error)
+      {
+        ++uiNumValues;
+      }
+
+      EZ_TEST_BOOL(!parser.HadFatalParsingError());
+    }
+
+    const ezTime tPull = sw.Checkpoint();
+
+    ezJSONReader bufferReader;
+    EZ_TEST_BOOL(bufferReader.Parse(buffer).Succeeded());
+
+    const ezTime tBufferReader = sw.Checkpoint();
+
+    ezRawMemoryStreamReader stream(buffer.GetPtr(), buffer.GetCount());
+    ezJSONReader streamReader;
+    EZ_TEST_BOOL(streamReader.Parse(stream).Succeeded());
+
+    const ezTime tStreamReader = sw.Checkpoint();
+
+    EZ_TEST_INT(uiNumValues, 100000 * 14 + 5);
+    EZ_TEST_BOOL(bufferReader.GetTopLevelObject() == streamReader.GetTopLevelObject());
+
+    ezTestFramework::Output(ezTestOutput::Duration, "ezJSONPullParser: %.2fms (%.1f MB/s)", tPull.GetMilliseconds(), fMegaBytes / tPull.GetSeconds());
+    ezTestFramework::Output(ezTestOutput::Duration, "ezJSONReader from buffer: %.2fms (%.1f MB/s)", tBufferReader.GetMilliseconds(),
+      fMegaBytes / tBufferReader.GetSeconds());
+    ezTestFramework::Output(ezTestOutput::Duration, "ezJSONReader from stream: %.2fms (%.1f MB/s)", tStreamReader.GetMilliseconds(),
+      fMegaBytes / tStreamReader.GetSeconds());
+  }
+}
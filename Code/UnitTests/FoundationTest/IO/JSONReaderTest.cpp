@@ -466,4 +466,41 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONReader)
 
     EZ_TEST_BOOL(sCompare.IsEmpty());
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Buffer")
+  {
+    // comments are only supported between values when parsing from a buffer
+    // the numbers are exactly representable, ezJSONParser converts other numbers less precisely
+    ezStringUtf8 sTD(L"{\n\
+\"myarray\" : [1, 2.5, 3.25, false, \"ende\", ],\n\
+\"String\"/**/ : \"testvälue\",\n\
+\"double\"/***/ : -4375e-3,//comment\n\
+\"bool\" : true,\n\
+\"MyNüll\" : null,,\n\
+\"object\" : /* comment */ {\n\
+  \"variable in object\" : \"bla\\\\\\\"\\/\\u03f6\",\n\
+  \"Subobject\" : { \"array in sub\" : [ { \"obj var\" : 234 }, {}, [], true, 4, false ] }\n\
+}\n\
+}");
+
+    JSONReaderTestDetail::StringStream stream(sTD.GetData());
+
+    ezJSONReader streamReader;
+    EZ_TEST_BOOL(streamReader.Parse(stream).Succeeded());
+
+    ezJSONReader bufferReader;
+    EZ_TEST_BOOL(bufferReader.Parse(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(sTD.GetData()), sTD.GetElementCount())).Succeeded());
+
+    EZ_TEST_INT(bufferReader.GetTopLevelObject().GetCount(), 6);
+    EZ_TEST_BOOL(bufferReader.GetTopLevelObject() == streamReader.GetTopLevelObject());
+
+    ezJSONReader emptyReader;
+    EZ_TEST_BOOL(emptyReader.Parse(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(" // nothing "), 12)).Succeeded());
+    EZ_TEST_INT(emptyReader.GetTopLevelObject().GetCount(), 0);
+
+    ezJSONReader errorReader;
+    EZ_TEST_BOOL(errorReader.Parse(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>("[ 1, 2 ]"), 8)).Failed());
+    EZ_TEST_BOOL(errorReader.Parse(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>("{ \"a\" : [ 1, 2 }"), 16)).Failed());
+    EZ_TEST_INT(errorReader.GetTopLevelObject().GetCount(), 0);
+  }
 }
@@ -149,6 +149,50 @@ EZ_CREATE_SIMPLE_TEST(IO, MemoryStream)
     }
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Remaining Contiguous Data")
+  {
+    ezDynamicArray<ezUInt8> OrigStorage;
+    OrigStorage.SetCountUninitialized(1000);
+
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      OrigStorage[i] = i % 256;
+    }
+
+    {
+      ezRawMemoryStreamReader reader(OrigStorage);
+      reader.SkipBytes(300);
+
+      ezArrayPtr<const ezUInt8> data;
+      EZ_TEST_BOOL(reader.GetRemainingContiguousData(data));
+      EZ_TEST_BOOL(data.GetPtr() == OrigStorage.GetData() + 300);
+      EZ_TEST_INT(data.GetCount(), 700);
+
+      // the view does not advance the read position
+      ezUInt8 uiValue = 0;
+      reader.ReadBytes(&uiValue, 1);
+      EZ_TEST_INT(uiValue, 300 % 256);
+
+      reader.SkipBytes(1000);
+      EZ_TEST_BOOL(reader.GetRemainingContiguousData(data));
+      EZ_TEST_BOOL(data.IsEmpty());
+    }
+
+    {
+      ezMemoryStreamStorage storage;
+      ezMemoryStreamWriter writer(&storage);
+      writer.WriteBytes(OrigStorage.GetData(), OrigStorage.GetCount()).IgnoreResult();
+
+      ezMemoryStreamReader reader(&storage);
+      reader.SkipBytes(999);
+
+      ezArrayPtr<const ezUInt8> data;
+      EZ_TEST_BOOL(reader.GetRemainingContiguousData(data));
+      EZ_TEST_INT(data.GetCount(), 1);
+      EZ_TEST_INT(data[0], 999 % 256);
+    }
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Raw Memory Stream Writing")
   {
     ezDynamicArray<ezUInt8> OrigStorage;
@@ -0,0 +1,265 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Memory/FrameAllocator.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Foundation/Types/UniquePtr.h>
+
+namespace
+{
+  struct DestructorCounter
+  {
+    DestructorCounter(ezUInt32* pCounter)
+      : m_pCounter(pCounter)
+    {
+    }
+
+    ~DestructorCounter() { ++(*m_pCounter); }
+
+    ezUInt32* m_pCounter;
+  };
+
+  const ezFrameAllocatorThreadStats* FindStats(const ezDynamicArray<ezFrameAllocatorThreadStats>& stats, ezThreadID threadID)
+  {
+    for (const ezFrameAllocatorThreadStats& threadStats : stats)
+    {
+      if (threadStats.m_ThreadID == threadID)
+        return &threadStats;
+    }
+
+    return nullptr;
+  }
+
+  /// Fills allocations from the frame allocator with the index of the thread, so that overlapping allocations are detected.
+  class FrameAllocationThread : public ezThread
+  {
+  public:
+    FrameAllocationThread(bool bUseThreadAllocator, ezUInt32 uiThreadIndex, ezUInt32 uiNumAllocations)
+      : ezThread("Frame Allocation Thread")
+      , m_bUseThreadAllocator(bUseThreadAllocator)
+      , m_uiThreadIndex(uiThreadIndex)
+      , m_uiNumAllocations(uiNumAllocations)
+    {
+    }
+
+    virtual ezUInt32 Run() override
+    {
+      m_Allocations.Reserve(m_uiNumAllocations);
+
+      for (ezUInt32 i = 0; i < m_uiNumAllocations; ++i)
+      {
+        ezAllocatorBase* pAllocator = m_bUseThreadAllocator ? ezFrameAllocator::GetThreadAllocator() : ezFrameAllocator::GetCurrentAllocator();
+
+        ezUInt32* pData = static_cast<ezUInt32*>(pAllocator->Allocate(4 * sizeof(ezUInt32), EZ_ALIGNMENT_OF(ezUInt32)));
+        for (ezUInt32 j = 0; j < 4; ++j)
+        {
+          pData[j] = m_uiThreadIndex;
+        }
+
+        m_Allocations.PushBack(pData);
+      }
+
+      return 0;
+    }
+
+    bool CheckAllocations() const
+    {
+      for (const ezUInt32* pData : m_Allocations)
+      {
+        for (ezUInt32 j = 0; j < 4; ++j)
+        {
+          if (pData[j] != m_uiThreadIndex)
+            return false;
+        }
+      }
+
+      return true;
+    }
+
+  private:
+    bool m_bUseThreadAllocator;
+    ezUInt32 m_uiThreadIndex;
+    ezUInt32 m_uiNumAllocations;
+    ezDynamicArray<ezUInt32*> m_Allocations;
+  };
+
+  ezTime RunFrameAllocationThreads(bool bUseThreadAllocator, ezUInt32 uiNumThreads, ezUInt32 uiNumAllocationsPerThread, bool* out_pValid = nullptr)
+  {
+    ezDynamicArray<ezUniquePtr<FrameAllocationThread>> threads;
+
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      threads.PushBack(EZ_DEFAULT_NEW(FrameAllocationThread, bUseThreadAllocator, i, uiNumAllocationsPerThread));
+      threads.PeekBack()->Start();
+    }
+
+    for (auto& pThread : threads)
+    {
+      pThread->Join();
+    }
+
+    const ezTime tDuration = sw.GetRunningTotal();
+
+    if (out_pValid != nullptr)
+    {
+      *out_pValid = true;
+      for (auto& pThread : threads)
+      {
+        *out_pValid &= pThread->CheckAllocations();
+      }
+    }
+
+    return tDuration;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Memory, FrameAllocator)
+{
+  ezDynamicArray<ezFrameAllocatorThreadStats> stats;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "GetThreadAllocator")
+  {
+    const ezThreadID mainThreadID = ezThreadUtils::GetCurrentThreadID();
+
+    ezAllocatorBase* pAllocator = ezFrameAllocator::GetThreadAllocator();
+    EZ_TEST_BOOL(pAllocator == ezFrameAllocator::GetThreadAllocator());
+
+    ezUInt32* pData = EZ_NEW_RAW_BUFFER(pAllocator, ezUInt32, 100);
+    pData[99] = 42;
+
+    ezFrameAllocator::GetThreadStats(stats);
+
+    const ezFrameAllocatorThreadStats* pStats = FindStats(stats, mainThreadID);
+    if (EZ_TEST_BOOL(pStats != nullptr))
+    {
+      EZ_TEST_BOOL(pStats->m_bIsMainThread);
+      EZ_TEST_INT(pStats->m_uiFrameBytes, 400);
+      EZ_TEST_INT(pStats->m_uiPeakFrameBytes, 400);
+      EZ_TEST_BOOL(pStats->m_uiReservedBytes >= 400);
+    }
+
+    // the data stays valid for one more frame
+    ezFrameAllocator::Swap();
+
+    ezAllocatorBase* pNextAllocator = ezFrameAllocator::GetThreadAllocator();
+    EZ_TEST_BOOL(pNextAllocator != pAllocator);
+
+    pNextAllocator->Allocate(32, EZ_ALIGNMENT_MINIMUM);
+    EZ_TEST_INT(pData[99], 42);
+
+    ezFrameAllocator::GetThreadStats(stats);
+
+    pStats = FindStats(stats, mainThreadID);
+    if (EZ_TEST_BOOL(pStats != nullptr))
+    {
+      EZ_TEST_INT(pStats->m_uiFrameBytes, 32);
+      EZ_TEST_INT(pStats->m_uiPeakFrameBytes, 400);
+    }
+
+    // the arena is reset once it is used again
+    ezFrameAllocator::Swap();
+
+    EZ_TEST_BOOL(ezFrameAllocator::GetThreadAllocator() == pAllocator);
+    EZ_TEST_BOOL(ezFrameAllocator::GetThreadAllocator()->Allocate(16, EZ_ALIGNMENT_MINIMUM) == pData);
+
+    // destructors are called on reset
+    ezUInt32 uiNumDestructed = 0;
+    EZ_NEW(ezFrameAllocator::GetThreadAllocator(), DestructorCounter, &uiNumDestructed);
+    DestructorCounter* pDeleted = EZ_NEW(ezFrameAllocator::GetThreadAllocator(), DestructorCounter, &uiNumDestructed);
+
+    ezAllocatorBase* pDeleteAllocator = ezFrameAllocator::GetThreadAllocator();
+    EZ_DELETE(pDeleteAllocator, pDeleted);
+    EZ_TEST_INT(uiNumDestructed, 1);
+
+    ezFrameAllocator::Reset();
+    EZ_TEST_INT(uiNumDestructed, 2);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Multiple Threads")
+  {
+    // run twice, so that the second batch of threads reuses the arenas of the first one
+    for (ezUInt32 uiRun = 0; uiRun < 2; ++uiRun)
+    {
+      bool bValid = false;
+      RunFrameAllocationThreads(true, 8, 10000, &bValid);
+      EZ_TEST_BOOL(bValid);
+
+      ezFrameAllocator::GetThreadStats(stats);
+      EZ_TEST_INT(stats.GetCount(), 8 + 1);
+
+      ezUInt32 uiNumWorkerStats = 0;
+      for (const ezFrameAllocatorThreadStats& threadStats : stats)
+      {
+        if (!threadStats.m_bIsMainThread)
+        {
+          ++uiNumWorkerStats;
+          EZ_TEST_INT(threadStats.m_uiFrameBytes, 16 * 10000);
+        }
+      }
+
+      EZ_TEST_INT(uiNumWorkerStats, 8);
+
+      // the next batch of threads starts with empty arenas
+      ezFrameAllocator::Swap();
+      ezFrameAllocator::Swap();
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezTempAllocatorScope")
+  {
+    ezUInt32 uiNumDestructed = 0;
+
+    {
+      ezTempAllocatorScope scope;
+      void* pOuter = scope.GetAllocator()->Allocate(64, EZ_ALIGNMENT_MINIMUM);
+      EZ_NEW(scope.GetAllocator(), DestructorCounter, &uiNumDestructed);
+
+      void* pInner = nullptr;
+      {
+        ezTempAllocatorScope innerScope;
+        EZ_TEST_BOOL(innerScope.GetAllocator() == scope.GetAllocator());
+
+        pInner = innerScope.GetAllocator()->Allocate(1000, EZ_ALIGNMENT_MINIMUM);
+        EZ_TEST_BOOL(pInner != pOuter);
+
+        EZ_NEW(innerScope.GetAllocator(), DestructorCounter, &uiNumDestructed);
+        EZ_NEW(innerScope.GetAllocator(), DestructorCounter, &uiNumDestructed);
+      }
+
+      // only the inner scope was freed
+      EZ_TEST_INT(uiNumDestructed, 2);
+      EZ_TEST_BOOL(scope.GetAllocator()->Allocate(1000, EZ_ALIGNMENT_MINIMUM) == pInner);
+    }
+
+    EZ_TEST_INT(uiNumDestructed, 3);
+
+    ezFrameAllocator::GetThreadStats(stats);
+
+    const ezFrameAllocatorThreadStats* pStats = FindStats(stats, ezThreadUtils::GetCurrentThreadID());
+    if (EZ_TEST_BOOL(pStats != nullptr))
+    {
+      EZ_TEST_BOOL(pStats->m_uiPeakTempBytes >= 64 + 1000 + 3 * sizeof(DestructorCounter));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Performance")
+  {
+    const ezUInt32 uiNumAllocationsPerThread = 100000;
+
+    for (ezUInt32 uiNumThreads : {1u, 4u, 16u})
+    {
+      const double fNumAllocations = uiNumThreads * uiNumAllocationsPerThread;
+
+      const ezTime tShared = RunFrameAllocationThreads(false, uiNumThreads, uiNumAllocationsPerThread);
+      ezFrameAllocator::Reset();
+
+      const ezTime tThread = RunFrameAllocationThreads(true, uiNumThreads, uiNumAllocationsPerThread);
+      ezFrameAllocator::Reset();
+
+      ezTestFramework::Output(ezTestOutput::Duration, "Frame allocations on %u threads: %.1f ns shared allocator, %.1f ns thread allocator", uiNumThreads,
+        tShared.GetNanoseconds() / fNumAllocations, tThread.GetNanoseconds() / fNumAllocations);
+    }
+  }
+}
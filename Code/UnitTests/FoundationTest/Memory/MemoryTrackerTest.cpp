@@ -0,0 +1,199 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Memory/CommonAllocators.h>
+#include <Foundation/Memory/MemoryTracker.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Foundation/Types/ScopeExit.h>
+#include <Foundation/Types/UniquePtr.h>
+
+namespace
+{
+  typedef ezAllocator<ezMemoryPolicies::ezHeapAllocation, ezMemoryTrackingFlags::RegisterAllocator | ezMemoryTrackingFlags::EnableAllocationTracking> TrackedAllocator;
+  typedef ezAllocator<ezMemoryPolicies::ezHeapAllocation, ezMemoryTrackingFlags::RegisterAllocator> UntrackedAllocator;
+
+  class AllocationThread : public ezThread
+  {
+  public:
+    AllocationThread(ezAllocatorBase* pAllocator, ezUInt32 uiNumAllocations)
+      : ezThread("Allocation Thread")
+      , m_pAllocator(pAllocator)
+      , m_uiNumAllocations(uiNumAllocations)
+    {
+    }
+
+    virtual ezUInt32 Run() override
+    {
+      void* pAllocations[16] = {};
+
+      for (ezUInt32 i = 0; i < m_uiNumAllocations; ++i)
+      {
+        void*& pSlot = pAllocations[i % EZ_ARRAY_SIZE(pAllocations)];
+
+        if (pSlot != nullptr)
+        {
+          m_pAllocator->Deallocate(pSlot);
+        }
+
+        pSlot = m_pAllocator->Allocate(16 + (i % 7) * 16, EZ_ALIGNMENT_MINIMUM);
+      }
+
+      for (void* pAllocation : pAllocations)
+      {
+        m_pAllocator->Deallocate(pAllocation);
+      }
+
+      return 0;
+    }
+
+  private:
+    ezAllocatorBase* m_pAllocator;
+    ezUInt32 m_uiNumAllocations;
+  };
+
+  ezTime RunAllocationThreads(ezAllocatorBase* pAllocator, ezUInt32 uiNumThreads, ezUInt32 uiNumAllocationsPerThread)
+  {
+    ezDynamicArray<ezUniquePtr<AllocationThread>> threads;
+
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      threads.PushBack(EZ_DEFAULT_NEW(AllocationThread, pAllocator, uiNumAllocationsPerThread));
+      threads.PeekBack()->Start();
+    }
+
+    for (auto& pThread : threads)
+    {
+      pThread->Join();
+    }
+
+    return sw.GetRunningTotal();
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Memory, MemoryTracker)
+{
+  EZ_SCOPE_EXIT(ezMemoryTracker::SetSamplingInterval(0));
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Tracking")
+  {
+    TrackedAllocator allocator("MemoryTrackerTest");
+
+    ezHybridArray<void*, 64> allocations;
+    for (ezUInt32 i = 0; i < 64; ++i)
+    {
+      allocations.PushBack(allocator.Allocate(100 + i, EZ_ALIGNMENT_MINIMUM));
+    }
+
+    ezAllocatorBase::Stats stats = allocator.GetStats();
+    EZ_TEST_INT(stats.m_uiNumAllocations, 64);
+    EZ_TEST_INT(stats.m_uiNumDeallocations, 0);
+    EZ_TEST_INT(stats.m_uiAllocationSize, 64 * 100 + 63 * 64 / 2);
+
+    for (ezUInt32 i = 0; i < 64; ++i)
+    {
+      EZ_TEST_INT(allocator.AllocatedSize(allocations[i]), 100 + i);
+    }
+
+    for (void* pAllocation : allocations)
+    {
+      allocator.Deallocate(pAllocation);
+    }
+
+    stats = allocator.GetStats();
+    EZ_TEST_INT(stats.m_uiNumAllocations, 64);
+    EZ_TEST_INT(stats.m_uiNumDeallocations, 64);
+    EZ_TEST_INT(stats.m_uiAllocationSize, 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Multiple Threads")
+  {
+    TrackedAllocator allocator("MemoryTrackerTest");
+
+    RunAllocationThreads(&allocator, 8, 10000);
+
+    const ezAllocatorBase::Stats stats = allocator.GetStats();
+    EZ_TEST_INT(stats.m_uiNumAllocations, 8 * 10000);
+    EZ_TEST_INT(stats.m_uiNumDeallocations, 8 * 10000);
+    EZ_TEST_INT(stats.m_uiAllocationSize, 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Sampling")
+  {
+    TrackedAllocator allocator("MemoryTrackerTest");
+
+    const ezUInt32 uiSamplingInterval = 4096;
+    const ezUInt32 uiNumAllocations = 4096;
+    const ezUInt32 uiAllocationSize = 64;
+
+    ezMemoryTracker::SetSamplingInterval(uiSamplingInterval);
+    EZ_TEST_INT(ezMemoryTracker::GetSamplingInterval(), uiSamplingInterval);
+
+    ezDynamicArray<void*> allocations;
+    allocations.Reserve(uiNumAllocations);
+
+    for (ezUInt32 i = 0; i < uiNumAllocations; ++i)
+    {
+      allocations.PushBack(allocator.Allocate(uiAllocationSize, EZ_ALIGNMENT_MINIMUM));
+    }
+
+    // an allocation that is larger than the interval is always sampled
+    void* pLargeAllocation = allocator.Allocate(uiSamplingInterval * 4, EZ_ALIGNMENT_MINIMUM);
+    EZ_TEST_INT(allocator.AllocatedSize(pLargeAllocation), uiSamplingInterval * 4);
+
+    ezUInt32 uiNumSampled = 0;
+    for (void* pAllocation : allocations)
+    {
+      const ezMemoryTracker::AllocationInfo& info = ezMemoryTracker::GetAllocationInfo(allocator.GetId(), pAllocation);
+      if (info.m_uiSize != 0)
+      {
+        ++uiNumSampled;
+        EZ_TEST_INT(info.m_uiSize, uiAllocationSize);
+        EZ_TEST_INT(info.m_uiSamplingInterval, uiSamplingInterval);
+        EZ_TEST_BOOL(info.m_pStackTrace != nullptr);
+      }
+    }
+
+    // 256KB allocated in total, on average every 4KB are sampled
+    EZ_TEST_BOOL(uiNumSampled >= 16 && uiNumSampled <= 256);
+
+    ezAllocatorBase::Stats stats = allocator.GetStats();
+    EZ_TEST_INT(stats.m_uiNumAllocations, uiNumAllocations + 1);
+    EZ_TEST_INT(stats.m_uiAllocationSize, uiNumSampled * uiSamplingInterval + uiSamplingInterval * 4);
+
+    ezMemoryTracker::SetSamplingInterval(0);
+
+    // allocations that were not sampled can still be freed
+    for (void* pAllocation : allocations)
+    {
+      allocator.Deallocate(pAllocation);
+    }
+
+    allocator.Deallocate(pLargeAllocation);
+
+    stats = allocator.GetStats();
+    EZ_TEST_INT(stats.m_uiNumDeallocations, uiNumAllocations + 1);
+    EZ_TEST_INT(stats.m_uiAllocationSize, 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Overhead")
+  {
+    const ezUInt32 uiNumThreads = 8;
+    const ezUInt32 uiNumAllocationsPerThread = 100000;
+    const double fNumAllocations = uiNumThreads * uiNumAllocationsPerThread;
+
+    UntrackedAllocator untrackedAllocator("MemoryTrackerTest Untracked");
+    TrackedAllocator trackedAllocator("MemoryTrackerTest Tracked");
+
+    const ezTime tUntracked = RunAllocationThreads(&untrackedAllocator, uiNumThreads, uiNumAllocationsPerThread);
+    const ezTime tTracked = RunAllocationThreads(&trackedAllocator, uiNumThreads, uiNumAllocationsPerThread);
+
+    ezMemoryTracker::SetSamplingInterval(512 * 1024);
+    const ezTime tSampled = RunAllocationThreads(&trackedAllocator, uiNumThreads, uiNumAllocationsPerThread);
+    ezMemoryTracker::SetSamplingInterval(0);
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Allocation + deallocation on %u threads: %.1f ns untracked, %.1f ns tracked, %.1f ns sampled (512KB)", uiNumThreads,
+      tUntracked.GetNanoseconds() / fNumAllocations, tTracked.GetNanoseconds() / fNumAllocations, tSampled.GetNanoseconds() / fNumAllocations);
+  }
+}
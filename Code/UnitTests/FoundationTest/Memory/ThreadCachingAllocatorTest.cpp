@@ -0,0 +1,242 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Memory/CommonAllocators.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Foundation/Types/UniquePtr.h>
+
+namespace
+{
+  typedef ezAllocator<ezMemoryPolicies::ezThreadCachingHeapAllocation, ezMemoryTrackingFlags::RegisterAllocator | ezMemoryTrackingFlags::EnableAllocationTracking> ThreadCachingAllocator;
+
+  // without allocation tracking for the benchmark
+  typedef ezAllocator<ezMemoryPolicies::ezHeapAllocation, ezMemoryTrackingFlags::RegisterAllocator> UntrackedHeapAllocator;
+  typedef ezAllocator<ezMemoryPolicies::ezThreadCachingHeapAllocation, ezMemoryTrackingFlags::RegisterAllocator> UntrackedThreadCachingAllocator;
+
+  static void FillAllocation(void* ptr, size_t uiSize, ezUInt8 uiValue) { ezMemoryUtils::PatternFill(static_cast<ezUInt8*>(ptr), uiValue, uiSize); }
+
+  static bool CheckAllocation(const void* ptr, size_t uiSize, ezUInt8 uiValue)
+  {
+    const ezUInt8* pBytes = static_cast<const ezUInt8*>(ptr);
+    for (size_t i = 0; i < uiSize; ++i)
+    {
+      if (pBytes[i] != uiValue)
+        return false;
+    }
+
+    return true;
+  }
+
+  /// Allocates and frees a mix of sizes like growing containers do, keeps a window of allocations alive.
+  class AllocationThread : public ezThread
+  {
+  public:
+    AllocationThread(ezAllocatorBase* pAllocator, ezUInt32 uiNumAllocations)
+      : ezThread("Allocation Thread")
+      , m_pAllocator(pAllocator)
+      , m_uiNumAllocations(uiNumAllocations)
+    {
+    }
+
+    virtual ezUInt32 Run() override
+    {
+      void* pAllocations[64] = {};
+
+      for (ezUInt32 i = 0; i < m_uiNumAllocations; ++i)
+      {
+        void*& pSlot = pAllocations[(i * 7) % EZ_ARRAY_SIZE(pAllocations)];
+
+        if (pSlot != nullptr)
+        {
+          m_pAllocator->Deallocate(pSlot);
+        }
+
+        pSlot = m_pAllocator->Allocate(16 << (i % 8), EZ_ALIGNMENT_MINIMUM);
+      }
+
+      for (void* pAllocation : pAllocations)
+      {
+        m_pAllocator->Deallocate(pAllocation);
+      }
+
+      return 0;
+    }
+
+  private:
+    ezAllocatorBase* m_pAllocator;
+    ezUInt32 m_uiNumAllocations;
+  };
+
+  /// Frees allocations that were made on another thread.
+  class DeallocationThread : public ezThread
+  {
+  public:
+    DeallocationThread(ezAllocatorBase* pAllocator, ezArrayPtr<void*> allocations)
+      : ezThread("Deallocation Thread")
+      , m_pAllocator(pAllocator)
+      , m_Allocations(allocations)
+    {
+    }
+
+    virtual ezUInt32 Run() override
+    {
+      for (void* pAllocation : m_Allocations)
+      {
+        m_pAllocator->Deallocate(pAllocation);
+      }
+
+      return 0;
+    }
+
+  private:
+    ezAllocatorBase* m_pAllocator;
+    ezArrayPtr<void*> m_Allocations;
+  };
+
+  ezTime RunAllocationThreads(ezAllocatorBase* pAllocator, ezUInt32 uiNumThreads, ezUInt32 uiNumAllocationsPerThread)
+  {
+    ezDynamicArray<ezUniquePtr<AllocationThread>> threads;
+
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      threads.PushBack(EZ_DEFAULT_NEW(AllocationThread, pAllocator, uiNumAllocationsPerThread));
+      threads.PeekBack()->Start();
+    }
+
+    for (auto& pThread : threads)
+    {
+      pThread->Join();
+    }
+
+    return sw.GetRunningTotal();
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Memory, ThreadCachingAllocator)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Allocate / Deallocate")
+  {
+    ThreadCachingAllocator allocator("ThreadCachingAllocatorTest");
+
+    ezDynamicArray<void*> allocations;
+
+    // covers all size classes and large allocations
+    for (ezUInt32 uiSize = 1; uiSize <= 20000; uiSize += 37)
+    {
+      void* ptr = allocator.Allocate(uiSize, EZ_ALIGNMENT_MINIMUM);
+      EZ_TEST_BOOL(ptr != nullptr);
+      EZ_TEST_BOOL(ezMemoryUtils::IsAligned(ptr, EZ_ALIGNMENT_MINIMUM));
+
+      FillAllocation(ptr, uiSize, static_cast<ezUInt8>(uiSize));
+      allocations.PushBack(ptr);
+    }
+
+    ezUInt32 uiIndex = 0;
+    for (ezUInt32 uiSize = 1; uiSize <= 20000; uiSize += 37, ++uiIndex)
+    {
+      EZ_TEST_BOOL(CheckAllocation(allocations[uiIndex], uiSize, static_cast<ezUInt8>(uiSize)));
+      allocator.Deallocate(allocations[uiIndex]);
+    }
+
+    // alignments above 16 bytes are supported as well
+    void* pAligned = allocator.Allocate(64, 64);
+    EZ_TEST_BOOL(ezMemoryUtils::IsAligned(pAligned, 64));
+    allocator.Deallocate(pAligned);
+
+    // freed blocks are reused
+    void* ptr1 = allocator.Allocate(48, EZ_ALIGNMENT_MINIMUM);
+    allocator.Deallocate(ptr1);
+    void* ptr2 = allocator.Allocate(48, EZ_ALIGNMENT_MINIMUM);
+    EZ_TEST_BOOL(ptr1 == ptr2);
+    allocator.Deallocate(ptr2);
+
+    const ezAllocatorBase::Stats stats = allocator.GetStats();
+    EZ_TEST_INT(stats.m_uiNumAllocations, stats.m_uiNumDeallocations);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Reallocate")
+  {
+    ThreadCachingAllocator allocator("ThreadCachingAllocatorTest");
+
+    void* ptr = allocator.Allocate(100, EZ_ALIGNMENT_MINIMUM);
+    FillAllocation(ptr, 100, 0xAB);
+
+    // the same size class keeps the allocation in place
+    void* pSameClass = allocator.Reallocate(ptr, 100, 110, EZ_ALIGNMENT_MINIMUM);
+    EZ_TEST_BOOL(pSameClass == ptr);
+
+    void* pLarger = allocator.Reallocate(pSameClass, 110, 5000, EZ_ALIGNMENT_MINIMUM);
+    EZ_TEST_BOOL(CheckAllocation(pLarger, 100, 0xAB));
+
+    void* pLarge = allocator.Reallocate(pLarger, 5000, 50000, EZ_ALIGNMENT_MINIMUM);
+    EZ_TEST_BOOL(CheckAllocation(pLarge, 100, 0xAB));
+
+    void* pSmall = allocator.Reallocate(pLarge, 50000, 32, EZ_ALIGNMENT_MINIMUM);
+    EZ_TEST_BOOL(CheckAllocation(pSmall, 32, 0xAB));
+
+    allocator.Deallocate(pSmall);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Cross-thread deallocation")
+  {
+    ThreadCachingAllocator allocator("ThreadCachingAllocatorTest");
+
+    // a 64 KB slab has room for 7 blocks of the largest size class, so all slabs are full afterwards
+    const ezUInt32 uiNumAllocations = 7 * 20;
+    const ezUInt32 uiSize = ezMemoryPolicies::ezThreadCachingHeapAllocation::MaxSmallAllocationSize;
+
+    ezDynamicArray<void*> allocations;
+    allocations.Reserve(uiNumAllocations);
+
+    for (ezUInt32 i = 0; i < uiNumAllocations; ++i)
+    {
+      allocations.PushBack(allocator.Allocate(uiSize, EZ_ALIGNMENT_MINIMUM));
+    }
+
+    DeallocationThread thread(&allocator, allocations.GetArrayPtr());
+    thread.Start();
+    thread.Join();
+
+    // the blocks that the other thread freed are handed out again once this thread picks them up
+    void* pReused = allocator.Allocate(uiSize, EZ_ALIGNMENT_MINIMUM);
+    EZ_TEST_BOOL(allocations.Contains(pReused));
+    allocator.Deallocate(pReused);
+
+    const ezAllocatorBase::Stats stats = allocator.GetStats();
+    EZ_TEST_INT(stats.m_uiNumAllocations, stats.m_uiNumDeallocations);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Multiple Threads")
+  {
+    ThreadCachingAllocator allocator("ThreadCachingAllocatorTest");
+
+    // run twice, so that the second batch of threads takes over the caches of the first one
+    RunAllocationThreads(&allocator, 8, 10000);
+    RunAllocationThreads(&allocator, 8, 10000);
+
+    const ezAllocatorBase::Stats stats = allocator.GetStats();
+    EZ_TEST_INT(stats.m_uiNumAllocations, 2 * 8 * 10000);
+    EZ_TEST_INT(stats.m_uiNumDeallocations, 2 * 8 * 10000);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Performance")
+  {
+    const ezUInt32 uiNumAllocationsPerThread = 200000;
+
+    UntrackedHeapAllocator heapAllocator("ThreadCachingAllocatorTest Heap");
+    UntrackedThreadCachingAllocator threadCachingAllocator("ThreadCachingAllocatorTest ThreadCaching");
+
+    for (ezUInt32 uiNumThreads : {1u, 4u, 16u})
+    {
+      const double fNumAllocations = uiNumThreads * uiNumAllocationsPerThread;
+
+      const ezTime tHeap = RunAllocationThreads(&heapAllocator, uiNumThreads, uiNumAllocationsPerThread);
+      const ezTime tThreadCaching = RunAllocationThreads(&threadCachingAllocator, uiNumThreads, uiNumAllocationsPerThread);
+
+      ezTestFramework::Output(ezTestOutput::Duration, "Allocation + deallocation on %u threads: %.1f ns malloc, %.1f ns thread caching", uiNumThreads,
+        tHeap.GetNanoseconds() / fNumAllocations, tThreadCaching.GetNanoseconds() / fNumAllocations);
+    }
+  }
+}
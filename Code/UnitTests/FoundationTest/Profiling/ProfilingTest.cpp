@@ -1,9 +1,15 @@
 #include <FoundationTestPCH.h>
 
+#include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/DelegateTask.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Foundation/Types/ScopeExit.h>
 
 namespace
 {
@@ -53,3 +59,173 @@ EZ_CREATE_SIMPLE_TEST(Profiling, Profiling)
     WriteOutProfilingCapture(":output/profilingScopes.json");
   }
 }
+
+#if EZ_ENABLED(EZ_USE_PROFILING)
+
+EZ_CREATE_SIMPLE_TEST(Profiling, StreamingCapture)
+{
+  ezStringBuilder outputPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(outputPath.GetData(), "StreamingCaptureTest", "stream", ezFileSystem::AllowWrites) == EZ_SUCCESS);
+
+  const ezTime discardThreshold = ezTime::Milliseconds(0.1);
+  ezProfilingSystem::SetDiscardThreshold(ezTime::Zero());
+
+  EZ_SCOPE_EXIT(ezProfilingSystem::StopStreamingCapture(); ezProfilingSystem::SetDiscardThreshold(discardThreshold); ezFileSystem::RemoveDataDirectoryGroup("StreamingCaptureTest"));
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Write and Read")
+  {
+    EZ_TEST_BOOL(!ezProfilingSystem::IsStreamingCaptureActive());
+    EZ_TEST_BOOL(ezProfilingSystem::StartStreamingCapture(":stream/profilingStream.ezProfiling").Succeeded());
+    EZ_TEST_BOOL(ezProfilingSystem::IsStreamingCaptureActive());
+
+    const ezUInt32 uiNumFrames = 20;
+    const ezUInt32 uiScopesPerFrame = 100;
+
+    for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+    {
+      ezProfilingSystem::StartNewFrame();
+
+      for (ezUInt32 i = 0; i < uiScopesPerFrame; ++i)
+      {
+        EZ_PROFILE_SCOPE("Streamed Outer");
+        EZ_PROFILE_SCOPE("Streamed Inner");
+      }
+
+      // scopes from another thread
+      ezSharedPtr<ezTask> pTask = EZ_DEFAULT_NEW(ezDelegateTask<void>, "Streamed Task", []() { EZ_PROFILE_SCOPE("Streamed Task Scope"); });
+      ezTaskSystem::WaitForGroup(ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::ThisFrame));
+
+      // give the writer thread a chance to write some of the data while the capture is running
+      if (uiFrame == uiNumFrames / 2)
+      {
+        ezThreadUtils::Sleep(ezTime::Milliseconds(100));
+      }
+    }
+
+    ezProfilingSystem::StopStreamingCapture();
+    EZ_TEST_BOOL(!ezProfilingSystem::IsStreamingCaptureActive());
+
+    const ezProfilingSystem::StreamingCaptureStats stats = ezProfilingSystem::GetStreamingCaptureStats();
+    EZ_TEST_INT(stats.m_uiNumFrames, uiNumFrames);
+    EZ_TEST_BOOL(stats.m_uiNumCPUScopes >= uiNumFrames * (uiScopesPerFrame * 2 + 1));
+    EZ_TEST_INT(stats.m_uiNumDroppedScopes, 0);
+    EZ_TEST_BOOL(stats.m_uiBytesWritten > 0);
+
+    ezFileReader file;
+    if (!EZ_TEST_BOOL(file.Open(":stream/profilingStream.ezProfiling").Succeeded()))
+      return;
+
+    // the binary format is a lot smaller than the 64 bytes per scope in memory
+    EZ_TEST_BOOL(file.GetFileSize() < stats.m_uiNumCPUScopes * 16);
+
+    ezProfilingSystem::ProfilingData profilingData;
+    if (!EZ_TEST_BOOL(profilingData.ReadStreamingCapture(file).Succeeded()))
+      return;
+
+    EZ_TEST_INT(profilingData.m_FrameStartTimes.GetCount(), uiNumFrames);
+
+    for (ezUInt32 i = 1; i < profilingData.m_FrameStartTimes.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(profilingData.m_FrameStartTimes[i - 1] <= profilingData.m_FrameStartTimes[i]);
+    }
+
+    ezUInt32 uiNumOuter = 0;
+    ezUInt32 uiNumInner = 0;
+    ezUInt32 uiNumTask = 0;
+    ezUInt64 uiNumScopes = 0;
+
+    for (const auto& eventBuffer : profilingData.m_AllEventBuffers)
+    {
+      uiNumScopes += eventBuffer.m_Data.GetCount();
+
+      for (const ezProfilingSystem::CPUScope& scope : eventBuffer.m_Data)
+      {
+        EZ_TEST_BOOL(scope.m_BeginTime <= scope.m_EndTime);
+
+        if (ezStringUtils::IsEqual(scope.m_szName, "Streamed Outer"))
+        {
+          ++uiNumOuter;
+          EZ_TEST_BOOL(scope.m_szFunctionName != nullptr && !ezStringUtils::IsNullOrEmpty(scope.m_szFunctionName));
+        }
+        else if (ezStringUtils::IsEqual(scope.m_szName, "Streamed Inner"))
+        {
+          ++uiNumInner;
+        }
+        else if (ezStringUtils::IsEqual(scope.m_szName, "Streamed Task Scope"))
+        {
+          ++uiNumTask;
+        }
+      }
+    }
+
+    EZ_TEST_INT(uiNumScopes, stats.m_uiNumCPUScopes);
+    EZ_TEST_INT(uiNumOuter, uiNumFrames * uiScopesPerFrame);
+    EZ_TEST_INT(uiNumInner, uiNumFrames * uiScopesPerFrame);
+    EZ_TEST_INT(uiNumTask, uiNumFrames);
+
+    // the converted capture can be written as JSON, like a regular capture
+    ezFileWriter jsonFile;
+    if (EZ_TEST_BOOL(jsonFile.Open(":stream/profilingStream.json").Succeeded()))
+    {
+      EZ_TEST_BOOL(profilingData.Write(jsonFile).Succeeded());
+    }
+
+    // merged data shares the string storage, so the function names stay valid after the source is cleared
+    {
+      ezProfilingSystem::ProfilingData merged;
+      const ezProfilingSystem::ProfilingData* inputs[] = {&profilingData};
+      ezProfilingSystem::ProfilingData::Merge(merged, inputs);
+      profilingData.Clear();
+
+      ezUInt32 uiNumFunctionNames = 0;
+      for (const auto& eventBuffer : merged.m_AllEventBuffers)
+      {
+        for (const ezProfilingSystem::CPUScope& scope : eventBuffer.m_Data)
+        {
+          if (ezStringUtils::IsEqual(scope.m_szName, "Streamed Outer") && !ezStringUtils::IsNullOrEmpty(scope.m_szFunctionName))
+            ++uiNumFunctionNames;
+        }
+      }
+
+      EZ_TEST_INT(uiNumFunctionNames, uiNumFrames * uiScopesPerFrame);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Invalid Data")
+  {
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    writer << ezUInt32(42);
+
+    ezMemoryStreamReader reader(&storage);
+    ezProfilingSystem::ProfilingData profilingData;
+    EZ_TEST_BOOL(profilingData.ReadStreamingCapture(reader).Failed());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Overhead")
+  {
+    const ezUInt32 uiNumScopes = 100000;
+
+    auto MeasureScopes = [&]() {
+      ezStopwatch sw;
+      for (ezUInt32 i = 0; i < uiNumScopes; ++i)
+      {
+        EZ_PROFILE_SCOPE("Overhead");
+      }
+      return sw.GetRunningTotal();
+    };
+
+    const ezTime tRingBufferOnly = MeasureScopes();
+
+    EZ_TEST_BOOL(ezProfilingSystem::StartStreamingCapture(":stream/profilingOverhead.ezProfiling").Succeeded());
+    const ezTime tStreaming = MeasureScopes();
+    ezProfilingSystem::StopStreamingCapture();
+
+    const ezProfilingSystem::StreamingCaptureStats stats = ezProfilingSystem::GetStreamingCaptureStats();
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Profiling scope overhead: %.1f ns (ring buffer only), %.1f ns (streaming), %.2f bytes per scope in the file",
+      tRingBufferOnly.GetNanoseconds() / uiNumScopes, tStreaming.GetNanoseconds() / uiNumScopes, static_cast<double>(stats.m_uiBytesWritten) / ezMath::Max<ezUInt64>(stats.m_uiNumCPUScopes, 1));
+  }
+}
+
+#endif
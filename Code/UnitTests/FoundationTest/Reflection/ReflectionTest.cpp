@@ -2,7 +2,10 @@
 
 #include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Reflection/ReflectionUtils.h>
+#include <Foundation/Serialization/BinarySerializer.h>
 #include <Foundation/Serialization/ReflectionSerializer.h>
+#include <Foundation/Serialization/RttiConverter.h>
+#include <Foundation/Time/Stopwatch.h>
 #include <FoundationTest/Reflection/ReflectionTestClasses.h>
 
 
@@ -96,6 +99,64 @@ void TestSerialization(const T& source)
   }
 }
 
+template <typename T>
+void PlainDataSerializationPerformance(const char* szName, const T& source)
+{
+  const ezUInt32 uiNumIterations = 10000;
+  const ezRTTI* pRtti = ezGetStaticRTTI<T>();
+
+  ezMemoryStreamStorage storage;
+  ezStopwatch sw;
+
+  // the graph based path, which was used for all types before
+  for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+  {
+    storage.Clear();
+
+    ezAbstractObjectGraph graph;
+    ezRttiConverterContext context;
+    ezRttiConverterWriter conv(&graph, &context, false, true);
+
+    ezUuid guid;
+    guid.CreateNewUuid();
+    context.RegisterObject(guid, pRtti, const_cast<T*>(&source));
+    conv.AddObjectToGraph(pRtti, const_cast<T*>(&source), "root");
+
+    ezMemoryStreamWriter writer(&storage);
+    ezAbstractGraphBinarySerializer::Write(writer, &graph);
+
+    ezMemoryStreamReader reader(&storage);
+    T data;
+    ezReflectionSerializer::ReadObjectPropertiesFromBinary(reader, *pRtti, &data);
+  }
+
+  const ezTime tGraph = sw.Checkpoint();
+
+  for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+  {
+    storage.Clear();
+
+    ezMemoryStreamWriter writer(&storage);
+    ezReflectionSerializer::WriteObjectToBinary(writer, pRtti, &source);
+
+    ezMemoryStreamReader reader(&storage);
+    T data;
+    ezReflectionSerializer::ReadObjectPropertiesFromBinary(reader, *pRtti, &data);
+  }
+
+  const ezTime tSerializer = sw.Checkpoint();
+
+  for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+  {
+    T clone;
+    ezReflectionSerializer::Clone(&source, &clone, pRtti);
+  }
+
+  const ezTime tClone = sw.Checkpoint();
+
+  ezTestFramework::Output(ezTestOutput::Duration, "%s, %u binary round trips: graph %.2f ms, ezReflectionSerializer %.2f ms, %u clones %.2f ms",
+    szName, uiNumIterations, tGraph.GetMilliseconds(), tSerializer.GetMilliseconds(), uiNumIterations, tClone.GetMilliseconds());
+}
 
 EZ_CREATE_SIMPLE_TEST_GROUP(Reflection);
 
@@ -539,6 +600,78 @@ EZ_CREATE_SIMPLE_TEST(Reflection, MemberProperties)
   }
 }
 
+EZ_CREATE_SIMPLE_TEST(Reflection, PlainDataSerialization)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezTestStruct3")
+  {
+    TestSerialization<ezTestStruct3>(ezTestStruct3(3.3, 27));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Graph data")
+  {
+    // data written in the graph format before plain data was supported must stay readable
+    ezTestStruct3 source(4.4, 42);
+
+    ezMemoryStreamStorage storage;
+    {
+      ezAbstractObjectGraph graph;
+      ezRttiConverterContext context;
+      ezRttiConverterWriter conv(&graph, &context, false, true);
+
+      ezUuid guid;
+      guid.CreateNewUuid();
+      context.RegisterObject(guid, ezGetStaticRTTI<ezTestStruct3>(), &source);
+      conv.AddObjectToGraph(ezGetStaticRTTI<ezTestStruct3>(), &source, "root");
+
+      ezMemoryStreamWriter writer(&storage);
+      ezAbstractGraphBinarySerializer::Write(writer, &graph);
+    }
+
+    {
+      ezMemoryStreamReader reader(&storage);
+      ezTestStruct3 data;
+      ezReflectionSerializer::ReadObjectPropertiesFromBinary(reader, *ezGetStaticRTTI<ezTestStruct3>(), &data);
+      EZ_TEST_BOOL(data == source);
+    }
+
+    {
+      ezMemoryStreamReader reader(&storage);
+      const ezRTTI* pRtti = nullptr;
+      void* pObject = ezReflectionSerializer::ReadObjectFromBinary(reader, pRtti);
+      EZ_TEST_BOOL(pRtti == ezGetStaticRTTI<ezTestStruct3>());
+      EZ_TEST_BOOL(*static_cast<ezTestStruct3*>(pObject) == source);
+      pRtti->GetAllocator()->Deallocate(pObject);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Different schema")
+  {
+    // same property names but a different type and layout, the properties are matched by name
+    ezTypedObjectStruct source(5.5, 13);
+    source.m_iInt32 = 77;
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    ezReflectionSerializer::WriteObjectToBinary(writer, ezGetStaticRTTI<ezTypedObjectStruct>(), &source);
+
+    ezMemoryStreamReader reader(&storage);
+    ezTestStruct3 data;
+    ezReflectionSerializer::ReadObjectPropertiesFromBinary(reader, *ezGetStaticRTTI<ezTestStruct3>(), &data);
+
+    EZ_TEST_DOUBLE(data.m_fFloat1, 5.5, 0.0);
+    EZ_TEST_INT(data.m_UInt8, 13);
+    EZ_TEST_INT(data.GetIntPublic(), 77);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Performance")
+  {
+    ezTestStruct3 plainData(6.6, 99);
+    ezTestStruct descriptor;
+
+    PlainDataSerializationPerformance("ezTestStruct3", plainData);
+    PlainDataSerializationPerformance("ezTestStruct", descriptor);
+  }
+}
 
 EZ_CREATE_SIMPLE_TEST(Reflection, Enum)
 {
@@ -7,6 +7,7 @@
 #include <Foundation/Serialization/DdlSerializer.h>
 #include <Foundation/Serialization/ReflectionSerializer.h>
 #include <Foundation/Serialization/RttiConverter.h>
+#include <Foundation/Time/Stopwatch.h>
 #include <FoundationTest/Reflection/ReflectionTestClasses.h>
 
 EZ_CREATE_SIMPLE_TEST_GROUP(Serialization);
@@ -331,3 +332,370 @@ EZ_CREATE_SIMPLE_TEST(Serialization, RttiConverter)
     }
   }
 }
+
+namespace
+{
+  void CreateBinaryGraphTestData(ezAbstractObjectGraph& graph, ezUInt32 uiNumNodes)
+  {
+    ezStringBuilder sName;
+    for (ezUInt32 i = 0; i < uiNumNodes; ++i)
+    {
+      ezUuid guid;
+      guid.CreateNewUuid();
+      sName.Format("Node{0}", i);
+
+      ezAbstractObjectNode* pNode = graph.AddNode(guid, (i % 2) == 0 ? "ezTestStruct" : "ezTestClass1", i % 3, sName);
+      pNode->AddProperty("Float", (float)i);
+      pNode->AddProperty("Int", (ezInt32)i);
+      pNode->AddProperty("Material", "{ 6b6c3a2e-0b7d-4c4b-a1d3-5a8a1b5e1c2f }");
+      pNode->AddProperty("Position", ezVec3(1.0f, 2.0f, (float)i));
+      pNode->AddProperty("Self", guid);
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Serialization, BinaryGraph)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "View")
+  {
+    ezAbstractObjectGraph graph;
+    CreateBinaryGraphTestData(graph, 100);
+
+    ezAbstractObjectGraph typesGraph;
+    typesGraph.AddNode(ezUuid::StableUuidForString("ezTestStruct"), "ezReflectedTypeDescriptor", 1, "ezTestStruct");
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    ezMemoryStreamReader reader(&storage);
+    ezAbstractGraphBinarySerializer::Write(writer, &graph, &typesGraph);
+
+    ezAbstractGraphBinaryView view;
+    ezAbstractGraphBinaryView typesView;
+    EZ_TEST_BOOL(view.Read(reader, &typesView).Succeeded());
+
+    // 2 types, 100 node names, 5 property names and one string value
+    EZ_TEST_INT(view.GetStringCount(), 108);
+    EZ_TEST_INT(view.GetNodes().GetCount(), 100);
+    EZ_TEST_INT(typesView.GetNodes().GetCount(), 1);
+    EZ_TEST_BOOL(view.GetNodeByName("Node100") == nullptr);
+
+    const ezAbstractGraphBinaryView::Node* pNode = view.GetNodeByName("Node41");
+    if (EZ_TEST_BOOL(pNode != nullptr))
+    {
+      EZ_TEST_BOOL(view.GetString(pNode->m_uiType) == "ezTestClass1");
+      EZ_TEST_INT(pNode->m_uiTypeVersion, 2);
+      EZ_TEST_INT(view.GetProperties(*pNode).GetCount(), 5);
+      EZ_TEST_BOOL(view.GetNodeByGuid(pNode->m_Guid) == pNode);
+      EZ_TEST_INT(view.FindProperty(*pNode, "Missing"), ezInvalidIndex);
+
+      const ezAbstractObjectNode* pGraphNode = graph.GetNodeByName("Node41");
+      for (const ezAbstractObjectNode::Property& prop : pGraphNode->GetProperties())
+      {
+        const ezUInt32 uiProperty = view.FindProperty(*pNode, prop.m_szPropertyName);
+        if (EZ_TEST_BOOL(uiProperty != ezInvalidIndex))
+        {
+          EZ_TEST_BOOL(view.GetPropertyValue(uiProperty) == prop.m_Value);
+        }
+      }
+    }
+
+    const ezAbstractGraphBinaryView::Node* pTypeNode = typesView.GetNodeByName("ezTestStruct");
+    if (EZ_TEST_BOOL(pTypeNode != nullptr))
+    {
+      EZ_TEST_BOOL(typesView.GetString(pTypeNode->m_uiType) == "ezReflectedTypeDescriptor");
+      EZ_TEST_INT(typesView.GetProperties(*pTypeNode).GetCount(), 0);
+    }
+
+    ezAbstractObjectGraph graph2;
+    view.CreateGraph(&graph2);
+    EZ_TEST_INT(graph2.GetAllNodes().GetCount(), 100);
+
+    const ezAbstractObjectNode* pGraphNode = graph.GetNodeByName("Node41");
+    const ezAbstractObjectNode* pGraphNode2 = graph2.GetNodeByName("Node41");
+    if (EZ_TEST_BOOL(pGraphNode2 != nullptr))
+    {
+      EZ_TEST_BOOL(pGraphNode2->GetGuid() == pGraphNode->GetGuid());
+      EZ_TEST_INT(pGraphNode2->GetProperties().GetCount(), pGraphNode->GetProperties().GetCount());
+
+      for (const ezAbstractObjectNode::Property& prop : pGraphNode->GetProperties())
+      {
+        EZ_TEST_BOOL(pGraphNode2->FindProperty(prop.m_szPropertyName)->m_Value == prop.m_Value);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Version1")
+  {
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    ezMemoryStreamReader reader(&storage);
+
+    ezUuid guid;
+    guid.CreateNewUuid();
+
+    writer << (ezUInt32)1; // version
+    writer << (ezUInt32)1; // nodes
+    writer << guid;
+    writer << "ezTestStruct";
+    writer << (ezUInt32)2;
+    writer << "root";
+    writer << (ezUInt32)2; // properties
+    writer << "Float";
+    writer << ezVariant(1.5f);
+    writer << "Name";
+    writer << ezVariant("Test");
+
+    ezAbstractObjectGraph graph;
+    ezAbstractGraphBinarySerializer::Read(reader, &graph);
+
+    const ezAbstractObjectNode* pNode = graph.GetNodeByName("root");
+    if (EZ_TEST_BOOL(pNode != nullptr))
+    {
+      EZ_TEST_BOOL(pNode->GetGuid() == guid);
+      EZ_TEST_STRING(pNode->GetType(), "ezTestStruct");
+      EZ_TEST_INT(pNode->GetTypeVersion(), 2);
+      EZ_TEST_BOOL(pNode->FindProperty("Float")->m_Value == ezVariant(1.5f));
+      EZ_TEST_BOOL(pNode->FindProperty("Name")->m_Value == ezVariant("Test"));
+    }
+
+    // the view only supports the current version
+    ezMemoryStreamReader reader2(&storage);
+    ezAbstractGraphBinaryView view;
+    EZ_TEST_BOOL(view.Read(reader2).Failed());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Invalid Data")
+  {
+    ezAbstractGraphBinaryView view;
+
+    {
+      // a count that is not backed by data
+      ezMemoryStreamStorage storage;
+      ezMemoryStreamWriter writer(&storage);
+      ezMemoryStreamReader reader(&storage);
+
+      writer << (ezUInt32)2;          // version
+      writer << (ezUInt32)0xFFFFFFFF; // string data
+      writer << (ezUInt32)0;
+
+      EZ_TEST_BOOL(view.Read(reader).Failed());
+    }
+
+    {
+      // a node name that is not in the string table
+      ezMemoryStreamStorage storage;
+      ezMemoryStreamWriter writer(&storage);
+      ezMemoryStreamReader reader(&storage);
+
+      ezAbstractGraphBinaryView::Node node;
+      node.m_uiNodeName = 1;
+
+      writer << (ezUInt32)2; // version
+      writer << (ezUInt32)2; // string data
+      writer.WriteBytes("a", 2).IgnoreResult();
+      writer << (ezUInt32)1; // string offsets
+      writer << (ezUInt32)0;
+      writer << (ezUInt32)1; // nodes
+      writer.WriteBytes(&node, sizeof(node)).IgnoreResult();
+      writer << (ezUInt32)0; // properties
+
+      EZ_TEST_BOOL(view.Read(reader).Failed());
+      EZ_TEST_INT(view.GetNodes().GetCount(), 0);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Size and Performance")
+  {
+    ezAbstractObjectGraph graph;
+    CreateBinaryGraphTestData(graph, 10000);
+
+    ezMemoryStreamStorage ddlStorage;
+    ezMemoryStreamWriter ddlWriter(&ddlStorage);
+    ezAbstractGraphDdlSerializer::Write(ddlWriter, &graph);
+
+    ezMemoryStreamStorage binaryStorage;
+    ezMemoryStreamWriter binaryWriter(&binaryStorage);
+    ezAbstractGraphBinarySerializer::Write(binaryWriter, &graph);
+
+    ezStopwatch sw;
+
+    {
+      ezMemoryStreamReader reader(&ddlStorage);
+      ezAbstractObjectGraph graph2;
+      EZ_TEST_BOOL(ezAbstractGraphDdlSerializer::Read(reader, &graph2).Succeeded());
+      EZ_TEST_INT(graph2.GetAllNodes().GetCount(), 10000);
+    }
+
+    const ezTime tDdl = sw.Checkpoint();
+
+    {
+      ezMemoryStreamReader reader(&binaryStorage);
+      ezAbstractObjectGraph graph2;
+      ezAbstractGraphBinarySerializer::Read(reader, &graph2);
+      EZ_TEST_INT(graph2.GetAllNodes().GetCount(), 10000);
+    }
+
+    const ezTime tBinary = sw.Checkpoint();
+
+    {
+      ezMemoryStreamReader reader(&binaryStorage);
+      ezAbstractGraphBinaryView view;
+      EZ_TEST_BOOL(view.Read(reader).Succeeded());
+      EZ_TEST_INT(view.GetNodes().GetCount(), 10000);
+    }
+
+    const ezTime tView = sw.Checkpoint();
+
+    ezTestFramework::Output(ezTestOutput::Duration, "DDL: %u KB, read in %.2fms", ddlStorage.GetStorageSize() / 1024, tDdl.GetMilliseconds());
+    ezTestFramework::Output(ezTestOutput::Duration, "Binary: %u KB, read in %.2fms, view read in %.2fms", binaryStorage.GetStorageSize() / 1024,
+      tBinary.GetMilliseconds(), tView.GetMilliseconds());
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(Serialization, AbstractObjectGraph)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Nodes")
+  {
+    ezAbstractObjectGraph graph;
+
+    ezStringBuilder sType = "ezTestStruct";
+    const char* szType = graph.RegisterString(sType);
+    EZ_TEST_BOOL(szType != sType.GetData());
+    EZ_TEST_STRING(szType, "ezTestStruct");
+    EZ_TEST_BOOL(graph.RegisterString("ezTestStruct") == szType);
+
+    ezUuid guid1, guid2;
+    guid1.CreateNewUuid();
+    guid2.CreateNewUuid();
+
+    ezAbstractObjectNode* pNode1 = graph.AddNode(guid1, sType, 1, "Node1");
+    pNode1->AddProperty("Float", 1.5f);
+    pNode1->AddProperty("Int", 3);
+    ezAbstractObjectNode* pNode2 = graph.AddNode(guid2, "ezTestClass1", 2);
+
+    EZ_TEST_BOOL(pNode1->GetType() == szType);
+    EZ_TEST_BOOL(graph.GetNode(guid1) == pNode1);
+    EZ_TEST_BOOL(graph.GetNode(guid2) == pNode2);
+    EZ_TEST_BOOL(graph.GetNodeByName("Node1") == pNode1);
+    EZ_TEST_BOOL(graph.GetNodeByName("Node2") == nullptr);
+    EZ_TEST_BOOL(pNode1->FindProperty("Int")->m_Value == ezVariant(3));
+    EZ_TEST_BOOL(pNode1->FindProperty("Missing") == nullptr);
+
+    pNode1->RenameProperty("Int", "Integer");
+    EZ_TEST_BOOL(pNode1->FindProperty("Int") == nullptr);
+    EZ_TEST_BOOL(pNode1->FindProperty("Integer")->m_Value == ezVariant(3));
+
+    graph.RemoveNode(guid1);
+    EZ_TEST_BOOL(graph.GetNode(guid1) == nullptr);
+    EZ_TEST_BOOL(graph.GetNodeByName("Node1") == nullptr);
+    EZ_TEST_INT(graph.GetAllNodes().GetCount(), 1);
+
+    // removed nodes are reused, but must not keep any of their previous data
+    ezAbstractObjectNode* pNode3 = graph.AddNode(guid1, "ezTestClass1", 3, "Node3");
+    EZ_TEST_BOOL(graph.GetNode(guid1) == pNode3);
+    EZ_TEST_BOOL(graph.GetNodeByName("Node3") == pNode3);
+    EZ_TEST_INT(pNode3->GetTypeVersion(), 3);
+    EZ_TEST_INT(pNode3->GetProperties().GetCount(), 0);
+
+    ezDynamicArray<const ezAbstractObjectNode*> sortedNodes;
+    graph.GetNodesSortedByGuid(sortedNodes);
+    if (EZ_TEST_INT(sortedNodes.GetCount(), 2))
+    {
+      EZ_TEST_BOOL(sortedNodes[0]->GetGuid() < sortedNodes[1]->GetGuid());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Diff")
+  {
+    ezAbstractObjectGraph base;
+    CreateBinaryGraphTestData(base, 100);
+
+    ezAbstractObjectGraph graph;
+    base.Clone(graph);
+
+    ezDeque<ezAbstractGraphDiffOperation> diff;
+    graph.CreateDiffWithBaseGraph(base, diff);
+    EZ_TEST_INT(diff.GetCount(), 0);
+
+    ezUuid newGuid;
+    newGuid.CreateNewUuid();
+    graph.AddNode(newGuid, "ezTestStruct", 5, "NewNode")->AddProperty("Float", 2.0f);
+    graph.RemoveNode(graph.GetNodeByName("Node10")->GetGuid());
+    graph.GetNodeByName("Node20")->ChangeProperty("Int", 42);
+    graph.GetNodeByName("Node30")->AddProperty("Extra", "extra");
+
+    // added node and its property, removed node, changed property and added property
+    graph.CreateDiffWithBaseGraph(base, diff);
+    EZ_TEST_INT(diff.GetCount(), 5);
+
+    base.ApplyDiff(diff);
+    EZ_TEST_INT(base.GetAllNodes().GetCount(), 100);
+    EZ_TEST_BOOL(base.GetNodeByName("Node10") == nullptr);
+    EZ_TEST_BOOL(base.GetNodeByName("Node20")->FindProperty("Int")->m_Value == ezVariant(42));
+
+    const ezAbstractObjectNode* pNewNode = base.GetNode(newGuid);
+    if (EZ_TEST_BOOL(pNewNode != nullptr))
+    {
+      EZ_TEST_STRING(pNewNode->GetNodeName(), "NewNode");
+      EZ_TEST_INT(pNewNode->GetTypeVersion(), 5);
+    }
+
+    graph.CreateDiffWithBaseGraph(base, diff);
+    EZ_TEST_INT(diff.GetCount(), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ReMapNodeGuids")
+  {
+    ezAbstractObjectGraph graph;
+    CreateBinaryGraphTestData(graph, 100);
+
+    const ezUuid guid = graph.GetNodeByName("Node50")->GetGuid();
+
+    ezUuid seed;
+    seed.CreateNewUuid();
+    graph.ReMapNodeGuids(seed);
+
+    const ezAbstractObjectNode* pNode = graph.GetNodeByName("Node50");
+    EZ_TEST_BOOL(pNode->GetGuid() != guid);
+    EZ_TEST_BOOL(graph.GetNode(pNode->GetGuid()) == pNode);
+    EZ_TEST_BOOL(pNode->FindProperty("Self")->m_Value == pNode->GetGuid());
+
+    graph.ReMapNodeGuids(seed, true);
+    EZ_TEST_BOOL(pNode->GetGuid() == guid);
+    EZ_TEST_BOOL(graph.GetNode(guid) == pNode);
+    EZ_TEST_INT(graph.GetAllNodes().GetCount(), 100);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Performance")
+  {
+    const ezUInt32 uiNumNodes = 100000;
+
+    ezStopwatch sw;
+
+    ezAbstractObjectGraph base;
+    CreateBinaryGraphTestData(base, uiNumNodes);
+
+    const ezTime tBuild = sw.Checkpoint();
+
+    ezAbstractObjectGraph graph;
+    base.Clone(graph);
+    EZ_TEST_INT(graph.GetAllNodes().GetCount(), uiNumNodes);
+
+    const ezTime tClone = sw.Checkpoint();
+
+    ezDeque<ezAbstractGraphDiffOperation> diff;
+    graph.CreateDiffWithBaseGraph(base, diff);
+    EZ_TEST_INT(diff.GetCount(), 0);
+
+    const ezTime tDiff = sw.Checkpoint();
+
+    ezUuid seed;
+    seed.CreateNewUuid();
+    graph.ReMapNodeGuids(seed);
+
+    const ezTime tReMap = sw.Checkpoint();
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%u nodes: build %.2fms, clone %.2fms, diff %.2fms, remap guids %.2fms", uiNumNodes,
+      tBuild.GetMilliseconds(), tClone.GetMilliseconds(), tDiff.GetMilliseconds(), tReMap.GetMilliseconds());
+  }
+}
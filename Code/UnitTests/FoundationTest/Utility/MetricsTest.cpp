@@ -0,0 +1,281 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Foundation/Types/UniquePtr.h>
+#include <Foundation/Utilities/Metrics.h>
+#include <Foundation/Utilities/Stats.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiNumThreads = 8;
+  constexpr ezUInt32 s_uiNumIterations = 10000;
+
+  class MetricsTestThread : public ezThread
+  {
+  public:
+    MetricsTestThread(ezMetricCounter counter, ezMetricHistogram histogram)
+      : ezThread("Metrics Test Thread")
+      , m_Counter(counter)
+      , m_Histogram(histogram)
+    {
+    }
+
+    virtual ezUInt32 Run() override
+    {
+      for (ezUInt32 i = 0; i < s_uiNumIterations; ++i)
+      {
+        m_Counter.Add(2);
+        m_Histogram.Record(static_cast<double>(i % 4));
+      }
+
+      return 0;
+    }
+
+  private:
+    ezMetricCounter m_Counter;
+    ezMetricHistogram m_Histogram;
+  };
+
+  const ezMetricSnapshot* FindSnapshot(const ezDynamicArray<ezMetricSnapshot>& snapshots, const char* szName)
+  {
+    for (const ezMetricSnapshot& snapshot : snapshots)
+    {
+      if (snapshot.m_sName == szName)
+        return &snapshot;
+    }
+
+    return nullptr;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Utility, Metrics)
+{
+  ezDynamicArray<ezMetricSnapshot> snapshots;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Register")
+  {
+    const ezUInt32 uiUsedSlots = ezMetrics::GetNumUsedSlots();
+
+    ezMetricCounter counter = ezMetrics::RegisterCounter("MetricsTest/Register");
+    EZ_TEST_BOOL(counter.IsValid());
+    EZ_TEST_INT(ezMetrics::GetNumUsedSlots(), uiUsedSlots + 1);
+
+    // the same name returns the same metric
+    ezMetricCounter counter2 = ezMetrics::RegisterCounter("MetricsTest/Register");
+    EZ_TEST_BOOL(counter2.IsValid());
+    EZ_TEST_INT(ezMetrics::GetNumUsedSlots(), uiUsedSlots + 1);
+
+    counter.Add(3);
+    counter2.Add(4);
+
+    // gauges don't use any slots
+    ezMetricGauge gauge = ezMetrics::RegisterGauge("MetricsTest/RegisterGauge");
+    EZ_TEST_BOOL(gauge.IsValid());
+    EZ_TEST_INT(ezMetrics::GetNumUsedSlots(), uiUsedSlots + 1);
+
+    // a name can't be reused for a different type
+    ezMetricGauge gauge2 = ezMetrics::RegisterGauge("MetricsTest/Register");
+    EZ_TEST_BOOL(!gauge2.IsValid());
+    gauge2.Set(1.0);
+
+    ezMetrics::Update();
+    ezMetrics::GetSnapshots(snapshots);
+
+    const ezMetricSnapshot* pSnapshot = FindSnapshot(snapshots, "MetricsTest/Register");
+    if (EZ_TEST_BOOL(pSnapshot != nullptr))
+    {
+      EZ_TEST_BOOL(pSnapshot->m_Type == ezMetricType::Counter);
+      EZ_TEST_DOUBLE(pSnapshot->m_fValue, 7.0, 0.0);
+      EZ_TEST_INT(pSnapshot->m_iTotal, 7);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Counter")
+  {
+    ezMetricCounter counter = ezMetrics::RegisterCounter("MetricsTest/Counter");
+
+    counter.Add();
+    counter.Add(10);
+
+    ezMetrics::Update();
+    ezMetrics::GetSnapshots(snapshots);
+
+    const ezMetricSnapshot* pSnapshot = FindSnapshot(snapshots, "MetricsTest/Counter");
+    if (EZ_TEST_BOOL(pSnapshot != nullptr))
+    {
+      EZ_TEST_DOUBLE(pSnapshot->m_fValue, 11.0, 0.0);
+      EZ_TEST_INT(pSnapshot->m_iTotal, 11);
+    }
+
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Counter").ConvertTo<ezInt64>(), 11);
+
+    // the value is reported per frame
+    counter.Add(5);
+
+    ezMetrics::Update();
+    ezMetrics::GetSnapshots(snapshots);
+
+    pSnapshot = FindSnapshot(snapshots, "MetricsTest/Counter");
+    if (EZ_TEST_BOOL(pSnapshot != nullptr))
+    {
+      EZ_TEST_DOUBLE(pSnapshot->m_fValue, 5.0, 0.0);
+      EZ_TEST_INT(pSnapshot->m_iTotal, 16);
+    }
+
+    ezMetrics::SetExportToStats(false);
+    counter.Add(1);
+    ezMetrics::Update();
+    ezMetrics::SetExportToStats(true);
+
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Counter").ConvertTo<ezInt64>(), 5);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Gauge")
+  {
+    ezMetricGauge gauge = ezMetrics::RegisterGauge("MetricsTest/Gauge");
+
+    gauge.Set(1.5);
+    gauge.Set(-2.25);
+
+    ezMetrics::Update();
+    ezMetrics::GetSnapshots(snapshots);
+
+    const ezMetricSnapshot* pSnapshot = FindSnapshot(snapshots, "MetricsTest/Gauge");
+    if (EZ_TEST_BOOL(pSnapshot != nullptr))
+    {
+      EZ_TEST_BOOL(pSnapshot->m_Type == ezMetricType::Gauge);
+      EZ_TEST_DOUBLE(pSnapshot->m_fValue, -2.25, 0.0);
+    }
+
+    EZ_TEST_DOUBLE(ezStats::GetStat("MetricsTest/Gauge").ConvertTo<double>(), -2.25, 0.0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Histogram")
+  {
+    const double bounds[] = {1.0, 10.0, 100.0};
+    ezMetricHistogram histogram = ezMetrics::RegisterHistogram("MetricsTest/Histogram", ezMakeArrayPtr(bounds));
+    EZ_TEST_BOOL(histogram.IsValid());
+
+    histogram.Record(0.5);
+    histogram.Record(1.0);
+    histogram.Record(5.0);
+    histogram.Record(50.0);
+    histogram.Record(500.0);
+    histogram.Record(1000.0);
+
+    ezMetrics::Update();
+    ezMetrics::GetSnapshots(snapshots);
+
+    const ezMetricSnapshot* pSnapshot = FindSnapshot(snapshots, "MetricsTest/Histogram");
+    if (EZ_TEST_BOOL(pSnapshot != nullptr) && EZ_TEST_INT(pSnapshot->m_BucketCounts.GetCount(), 4))
+    {
+      EZ_TEST_BOOL(pSnapshot->m_Type == ezMetricType::Histogram);
+      EZ_TEST_INT(pSnapshot->m_BucketUpperBounds.GetCount(), 3);
+      EZ_TEST_INT(pSnapshot->m_BucketCounts[0], 2);
+      EZ_TEST_INT(pSnapshot->m_BucketCounts[1], 1);
+      EZ_TEST_INT(pSnapshot->m_BucketCounts[2], 1);
+      EZ_TEST_INT(pSnapshot->m_BucketCounts[3], 2);
+      EZ_TEST_INT(pSnapshot->m_iTotal, 6);
+      EZ_TEST_DOUBLE(pSnapshot->m_fValue, 1556.5 / 6.0, 0.0001);
+    }
+
+    EZ_TEST_INT(ezStats::GetStat("MetricsTest/Histogram/Count").ConvertTo<ezInt64>(), 6);
+
+    // no samples in this frame
+    ezMetrics::Update();
+    ezMetrics::GetSnapshots(snapshots);
+
+    pSnapshot = FindSnapshot(snapshots, "MetricsTest/Histogram");
+    if (EZ_TEST_BOOL(pSnapshot != nullptr))
+    {
+      EZ_TEST_INT(pSnapshot->m_BucketCounts[0], 0);
+      EZ_TEST_INT(pSnapshot->m_iTotal, 6);
+      EZ_TEST_DOUBLE(pSnapshot->m_fValue, 0.0, 0.0);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Multiple Threads")
+  {
+    const double bounds[] = {0.0, 1.0, 2.0};
+    ezMetricCounter counter = ezMetrics::RegisterCounter("MetricsTest/Threads");
+    ezMetricHistogram histogram = ezMetrics::RegisterHistogram("MetricsTest/ThreadsHistogram", ezMakeArrayPtr(bounds));
+
+    // run twice, so that the second batch of threads reuses the slots of the first one
+    for (ezUInt32 uiRun = 0; uiRun < 2; ++uiRun)
+    {
+      ezDynamicArray<ezUniquePtr<MetricsTestThread>> threads;
+
+      for (ezUInt32 i = 0; i < s_uiNumThreads; ++i)
+      {
+        threads.PushBack(EZ_DEFAULT_NEW(MetricsTestThread, counter, histogram));
+        threads.PeekBack()->Start();
+      }
+
+      for (auto& pThread : threads)
+      {
+        pThread->Join();
+      }
+
+      ezMetrics::Update();
+      ezMetrics::GetSnapshots(snapshots);
+
+      const ezMetricSnapshot* pCounter = FindSnapshot(snapshots, "MetricsTest/Threads");
+      if (EZ_TEST_BOOL(pCounter != nullptr))
+      {
+        EZ_TEST_DOUBLE(pCounter->m_fValue, 2.0 * s_uiNumThreads * s_uiNumIterations, 0.0);
+        EZ_TEST_INT(pCounter->m_iTotal, 2 * s_uiNumThreads * s_uiNumIterations * (uiRun + 1));
+      }
+
+      const ezMetricSnapshot* pHistogram = FindSnapshot(snapshots, "MetricsTest/ThreadsHistogram");
+      if (EZ_TEST_BOOL(pHistogram != nullptr))
+      {
+        for (ezUInt32 b = 0; b < 4; ++b)
+        {
+          EZ_TEST_INT(pHistogram->m_BucketCounts[b], s_uiNumThreads * s_uiNumIterations / 4);
+        }
+
+        EZ_TEST_DOUBLE(pHistogram->m_fValue, 1.5, 0.0001);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Performance")
+  {
+    const ezUInt32 uiNumUpdates = 1000000;
+
+    ezMetricCounter counter = ezMetrics::RegisterCounter("MetricsTest/Performance");
+
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < uiNumUpdates; ++i)
+    {
+      counter.Add();
+    }
+
+    const ezTime tMetric = sw.GetRunningTotal();
+
+    sw.StopAndReset();
+    sw.Resume();
+
+    for (ezUInt32 i = 0; i < uiNumUpdates; ++i)
+    {
+      ezStats::SetStat("MetricsTest/PerformanceStat", i);
+    }
+
+    const ezTime tStats = sw.GetRunningTotal();
+
+    ezStats::RemoveStat("MetricsTest/PerformanceStat");
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%u counter updates: ezMetricCounter %.2f ms, ezStats::SetStat %.2f ms", uiNumUpdates, tMetric.GetMilliseconds(), tStats.GetMilliseconds());
+
+    ezMetrics::Update();
+    ezMetrics::GetSnapshots(snapshots);
+
+    const ezMetricSnapshot* pSnapshot = FindSnapshot(snapshots, "MetricsTest/Performance");
+    if (EZ_TEST_BOOL(pSnapshot != nullptr))
+    {
+      EZ_TEST_INT(pSnapshot->m_iTotal, uiNumUpdates);
+    }
+  }
+}
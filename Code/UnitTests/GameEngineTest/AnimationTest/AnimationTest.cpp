@@ -0,0 +1,274 @@
+#include <GameEngineTestPCH.h>
+
+#include <Core/ResourceManager/ResourceManager.h>
+#include <Core/World/World.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <GameEngine/Animation/Skeletal/SimpleAnimationComponent.h>
+#include <RendererCore/AnimationSystem/AnimationClipResource.h>
+#include <RendererCore/AnimationSystem/AnimationLod.h>
+#include <RendererCore/AnimationSystem/SkeletonBuilder.h>
+#include <RendererCore/AnimationSystem/SkeletonComponent.h>
+#include <RendererCore/AnimationSystem/SkeletonResource.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Animation);
+
+namespace
+{
+  const char* s_szJointNames[] = {"Root", "Spine", "Head"};
+
+  ezSkeletonResourceHandle CreateSkeleton(const char* szResourceID)
+  {
+    ezSkeletonBuilder builder;
+
+    ezUInt32 uiParent = ezInvalidIndex;
+    for (const char* szJoint : s_szJointNames)
+    {
+      uiParent = builder.AddJoint(szJoint, ezTransform(ezVec3(0, 0, 1)), uiParent);
+    }
+
+    ezSkeletonResourceDescriptor desc;
+    builder.BuildSkeleton(desc.m_Skeleton);
+
+    return ezResourceManager::CreateResource<ezSkeletonResource>(szResourceID, std::move(desc));
+  }
+
+  /// Creates a one second clip that moves every joint along the x axis.
+  ezAnimationClipResourceHandle CreateAnimationClip(const char* szResourceID)
+  {
+    ezAnimationClipResourceDescriptor desc;
+
+    ezHashedString sJointName;
+    for (const char* szJoint : s_szJointNames)
+    {
+      sJointName.Assign(szJoint);
+      desc.CreateJoint(sJointName, 2, 1, 1);
+    }
+
+    desc.AllocateJointTransforms();
+
+    for (const char* szJoint : s_szJointNames)
+    {
+      const ezAnimationClipResourceDescriptor::JointInfo* pJoint = desc.GetJointInfo(ezTempHashedString(szJoint));
+
+      ezArrayPtr<ezAnimationClipResourceDescriptor::KeyframeVec3> positions = desc.GetPositionKeyframes(*pJoint);
+      positions[0].m_fTimeInSec = 0.0f;
+      positions[0].m_Value.Set(0, 0, 1);
+      positions[1].m_fTimeInSec = 1.0f;
+      positions[1].m_Value.Set(1, 0, 1);
+
+      ezArrayPtr<ezAnimationClipResourceDescriptor::KeyframeQuat> rotations = desc.GetRotationKeyframes(*pJoint);
+      rotations[0].m_fTimeInSec = 0.0f;
+      rotations[0].m_Value.SetIdentity();
+
+      ezArrayPtr<ezAnimationClipResourceDescriptor::KeyframeVec3> scales = desc.GetScaleKeyframes(*pJoint);
+      scales[0].m_fTimeInSec = 0.0f;
+      scales[0].m_Value.Set(1.0f);
+    }
+
+    desc.SetDuration(ezTime::Seconds(1.0));
+
+    return ezResourceManager::CreateResource<ezAnimationClipResource>(szResourceID, std::move(desc));
+  }
+
+  /// Creates a local space pose in which the root joint is rotated by the given angle around the z axis.
+  ozz::math::SoaTransform CreateLocalPose(ezAngle rootRotation)
+  {
+    const float fSin = ezMath::Sin(rootRotation * 0.5f);
+    const float fCos = ezMath::Cos(rootRotation * 0.5f);
+
+    ozz::math::SoaTransform pose;
+    pose.translation = ozz::math::SoaFloat3::Load(ozz::math::simd_float4::zero(), ozz::math::simd_float4::zero(), ozz::math::simd_float4::Load(0, 1, 1, 0));
+    pose.rotation = ozz::math::SoaQuaternion::Load(ozz::math::simd_float4::zero(), ozz::math::simd_float4::zero(), ozz::math::simd_float4::Load(fSin, 0, 0, 0), ozz::math::simd_float4::Load(fCos, 1, 1, 1));
+    pose.scale = ozz::math::SoaFloat3::one();
+    return pose;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Animation, ParallelUpdates)
+{
+  ezSkeletonResourceHandle hSkeleton = CreateSkeleton("AnimationTest_Skeleton");
+  ezAnimationClipResourceHandle hAnimationClip = CreateAnimationClip("AnimationTest_Clip");
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "GetMappedOzzAnimation")
+  {
+    ezResourceLock<ezSkeletonResource> pSkeleton(hSkeleton, ezResourceAcquireMode::BlockTillLoaded);
+    ezResourceLock<ezAnimationClipResource> pAnimationClip(hAnimationClip, ezResourceAcquireMode::BlockTillLoaded);
+
+    const ezSkeletonResource* pSkeletonResource = pSkeleton.GetPointer();
+    const ezAnimationClipResourceDescriptor* pClipDesc = &pAnimationClip->GetDescriptor();
+
+    // all threads map the animation at the same time, they must all end up with the same one
+    ezDynamicArray<const ozz::animation::Animation*> mappedAnimations;
+    mappedAnimations.SetCount(256);
+
+    ezTaskSystem::ParallelForIndexed(
+      0, mappedAnimations.GetCount(),
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          mappedAnimations[i] = &pClipDesc->GetMappedOzzAnimation(*pSkeletonResource);
+        }
+      },
+      "GetMappedOzzAnimation");
+
+    for (const ozz::animation::Animation* pAnimation : mappedAnimations)
+    {
+      EZ_TEST_BOOL(pAnimation == mappedAnimations[0]);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Update Components")
+  {
+    ezWorldDesc worldDesc("AnimationTest");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    world.GetClock().SetFixedTimeStep(ezTime::Seconds(0.1));
+    world.SetWorldSimulationEnabled(true);
+
+    // more components than the granularity of the async update, so they are distributed over several worker threads
+    const ezUInt32 uiNumComponents = 256;
+
+    ezDynamicArray<ezSimpleAnimationComponent*> components;
+
+    for (ezUInt32 i = 0; i < uiNumComponents; ++i)
+    {
+      ezGameObjectDesc objectDesc;
+      objectDesc.m_LocalPosition.Set((float)i, 0, 0);
+
+      ezGameObject* pObject = nullptr;
+      world.CreateObject(objectDesc, pObject);
+
+      ezSkeletonComponent* pSkeletonComponent = nullptr;
+      ezSkeletonComponent::CreateComponent(pObject, pSkeletonComponent);
+      pSkeletonComponent->SetSkeleton(hSkeleton);
+      pSkeletonComponent->m_bVisualizeSkeleton = false;
+
+      ezSimpleAnimationComponent* pAnimationComponent = nullptr;
+      ezSimpleAnimationComponent::CreateComponent(pObject, pAnimationComponent);
+      pAnimationComponent->SetAnimationClip(hAnimationClip);
+      pAnimationComponent->m_AnimationMode = ezPropertyAnimMode::Loop;
+
+      components.PushBack(pAnimationComponent);
+    }
+
+    for (ezUInt32 i = 0; i < 5; ++i)
+    {
+      world.Update();
+    }
+
+    // all components started at the same time and advanced with the same time step
+    const float fExpectedPosition = components[0]->GetNormalizedPlaybackPosition();
+    EZ_TEST_BOOL(fExpectedPosition > 0.0f);
+
+    for (const ezSimpleAnimationComponent* pComponent : components)
+    {
+      EZ_TEST_FLOAT(pComponent->GetNormalizedPlaybackPosition(), fExpectedPosition, 0.0f);
+    }
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(Animation, LodTransitions)
+{
+  ezSkeletonResourceHandle hSkeleton = CreateSkeleton("AnimationTest_LodSkeleton");
+  ezResourceLock<ezSkeletonResource> pSkeleton(hSkeleton, ezResourceAcquireMode::BlockTillLoaded);
+  const ozz::animation::Skeleton& ozzSkeleton = pSkeleton->GetDescriptor().m_Skeleton.GetOzzSkeleton();
+
+  const ozz::math::SoaTransform poseFrom = CreateLocalPose(ezAngle::Degree(0));
+  const ozz::math::SoaTransform poseTo = CreateLocalPose(ezAngle::Degree(90));
+
+  ezMat4 modelPose[EZ_ARRAY_SIZE(s_szJointNames)];
+
+  ezCVarFloat* pLodDistance1 = static_cast<ezCVarFloat*>(ezCVar::FindCVarByName("a_LodDistance1"));
+  ezCVarInt* pLodInterval1 = static_cast<ezCVarInt*>(ezCVar::FindCVarByName("a_LodInterval1"));
+  if (!EZ_TEST_BOOL(pLodDistance1 != nullptr && pLodInterval1 != nullptr))
+    return;
+
+  ezAnimationLodReference reference;
+  reference.m_bValid = true;
+  reference.m_uiFrameCounter = 100;
+
+  ezAnimationLod lod;
+  lod.SetStaggerOffset(0);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Full")
+  {
+    lod.UpdateLevel(reference, ezVec3(1, 0, 0));
+    EZ_TEST_INT(lod.GetLevel(), ezAnimationLodLevel::Full);
+
+    ezTime tStep;
+    EZ_TEST_BOOL(lod.ShouldUpdate(ezTime::Seconds(0.1), tStep));
+    EZ_TEST_BOOL(tStep == ezTime::Seconds(0.1));
+
+    lod.SetComputedPose(ozzSkeleton, ezMakeArrayPtr(&poseFrom, 1), ezMakeArrayPtr(modelPose));
+    EZ_TEST_BOOL(!lod.InterpolatePose(ozzSkeleton, ezMakeArrayPtr(modelPose)));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Reduced")
+  {
+    lod.UpdateLevel(reference, ezVec3(pLodDistance1->GetValue() + 1.0f, 0, 0));
+    EZ_TEST_INT(lod.GetLevel(), ezAnimationLodLevel::Reduced);
+
+    const ezUInt32 uiInterval = ezMath::Clamp(pLodInterval1->GetValue(), 1, 255);
+    EZ_TEST_BOOL(uiInterval > 1);
+
+    lod.SetComputedPose(ozzSkeleton, ezMakeArrayPtr(&poseFrom, 1), ezMakeArrayPtr(modelPose));
+    lod.SetComputedPose(ozzSkeleton, ezMakeArrayPtr(&poseTo, 1), ezMakeArrayPtr(modelPose));
+
+    // the first interpolation step is a rotation around z, not a lerp of the matrix elements that would shrink the bones
+    const ezAngle expectedRotation = ezAngle::Degree(90.0f / uiInterval);
+    EZ_TEST_VEC3(modelPose[0].TransformDirection(ezVec3(1, 0, 0)), ezVec3(ezMath::Cos(expectedRotation), ezMath::Sin(expectedRotation), 0), 0.001f);
+    EZ_TEST_FLOAT(modelPose[1].TransformDirection(ezVec3(0, 1, 0)).GetLength(), 1.0f, 0.001f);
+    EZ_TEST_VEC3(modelPose[2].GetTranslationVector(), ezVec3(0, 0, 2), 0.001f);
+
+    ezTime tStep;
+    for (ezUInt32 i = 1; i < uiInterval; ++i)
+    {
+      EZ_TEST_BOOL(!lod.ShouldUpdate(ezTime::Seconds(0.1), tStep));
+      EZ_TEST_BOOL(lod.InterpolatePose(ozzSkeleton, ezMakeArrayPtr(modelPose)));
+    }
+
+    // the target pose is reached in the last frame before the next update
+    EZ_TEST_VEC3(modelPose[0].TransformDirection(ezVec3(1, 0, 0)), ezVec3(0, 1, 0), 0.001f);
+
+    EZ_TEST_BOOL(lod.ShouldUpdate(ezTime::Seconds(0.1), tStep));
+    EZ_TEST_BOOL(tStep == ezTime::Seconds(0.1 * uiInterval));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Back to Full")
+  {
+    lod.UpdateLevel(reference, ezVec3(1, 0, 0));
+    EZ_TEST_INT(lod.GetLevel(), ezAnimationLodLevel::Full);
+
+    // the interpolation of the reduced level must not leak into the full level
+    EZ_TEST_BOOL(!lod.InterpolatePose(ozzSkeleton, ezMakeArrayPtr(modelPose)));
+
+    ezTime tStep;
+    EZ_TEST_BOOL(lod.ShouldUpdate(ezTime::Seconds(0.1), tStep));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Invisible")
+  {
+    lod.SetVisible();
+    reference.m_uiFrameCounter = static_cast<ezUInt32>(ezRenderWorld::GetFrameCounter()) + 100;
+
+    lod.UpdateLevel(reference, ezVec3(1, 0, 0));
+    EZ_TEST_INT(lod.GetLevel(), ezAnimationLodLevel::Invisible);
+    EZ_TEST_BOOL(lod.IsPaused());
+
+    ezTime tStep;
+    EZ_TEST_BOOL(!lod.ShouldUpdate(ezTime::Seconds(0.1), tStep));
+    EZ_TEST_BOOL(!lod.InterpolatePose(ozzSkeleton, ezMakeArrayPtr(modelPose)));
+
+    // once it is visible again, all the skipped time is applied at once
+    reference.m_uiFrameCounter = static_cast<ezUInt32>(ezRenderWorld::GetFrameCounter());
+    lod.UpdateLevel(reference, ezVec3(1, 0, 0));
+    EZ_TEST_INT(lod.GetLevel(), ezAnimationLodLevel::Full);
+    EZ_TEST_BOOL(!lod.IsPaused());
+
+    EZ_TEST_BOOL(lod.ShouldUpdate(ezTime::Seconds(0.1), tStep));
+    EZ_TEST_BOOL(tStep == ezTime::Seconds(0.2));
+  }
+}
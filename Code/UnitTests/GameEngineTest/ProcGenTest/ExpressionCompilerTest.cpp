@@ -0,0 +1,199 @@
+#include <GameEngineTestPCH.h>
+
+#include <Foundation/Time/Stopwatch.h>
+#include <ProcGenPlugin/VM/ExpressionByteCode.h>
+#include <ProcGenPlugin/VM/ExpressionCompiler.h>
+#include <ProcGenPlugin/VM/ExpressionVM.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(ProcGen);
+
+namespace
+{
+  static ezHashedString s_sInputA = ezMakeHashedString("a");
+  static ezHashedString s_sInputB = ezMakeHashedString("b");
+  static ezHashedString s_sOutput0 = ezMakeHashedString("out0");
+  static ezHashedString s_sOutput1 = ezMakeHashedString("out1");
+
+  static ezExpressionAST::Node* Const(ezExpressionAST& ast, float fValue) { return ast.CreateConstant(fValue); }
+
+  static ezExpressionAST::Node* Op(ezExpressionAST& ast, ezExpressionAST::NodeType::Enum type, ezExpressionAST::Node* pLeft, ezExpressionAST::Node* pRight)
+  {
+    return ast.CreateBinaryOperator(type, pLeft, pRight);
+  }
+
+  // Contains redundant sub expressions, foldable constants and identities like a typical graph coming out of the editor does.
+  static void BuildTestAST(ezExpressionAST& ast)
+  {
+    using NT = ezExpressionAST::NodeType;
+
+    ezExpressionAST::Node* a0 = ast.CreateInput(s_sInputA);
+    ezExpressionAST::Node* a1 = ast.CreateInput(s_sInputA);
+    ezExpressionAST::Node* b = ast.CreateInput(s_sInputB);
+
+    ezExpressionAST::Node* pTwiceA = Op(ast, NT::Add, Op(ast, NT::Multiply, a0, Const(ast, 2.0f)), Op(ast, NT::Multiply, a1, Const(ast, 2.0f)));
+    ezExpressionAST::Node* pZero = Op(ast, NT::Multiply, Op(ast, NT::Subtract, Const(ast, 3.0f), Const(ast, 1.0f)), ast.CreateUnaryOperator(NT::Sin, Const(ast, 0.0f)));
+    ezExpressionAST::Node* pSum = Op(ast, NT::Add, Op(ast, NT::Add, pTwiceA, pZero), Op(ast, NT::Divide, b, Const(ast, 4.0f)));
+    ezExpressionAST::Node* pResult0 = Op(ast, NT::Add, Op(ast, NT::Subtract, pSum, Const(ast, 1.0f)), Op(ast, NT::Max, b, b));
+
+    ezExpressionAST::Node* pClamped = Op(ast, NT::Min, Op(ast, NT::Min, Op(ast, NT::Multiply, Const(ast, 1.0f), b), Const(ast, 2.0f)), Const(ast, 1.0f));
+    ezExpressionAST::Node* pResult1 = Op(ast, NT::Max, Const(ast, 0.0f), ast.CreateUnaryOperator(NT::Absolute, ast.CreateUnaryOperator(NT::Absolute, pClamped)));
+
+    ast.m_OutputNodes.PushBack(ast.CreateOutput(s_sOutput0, pResult0));
+    ast.m_OutputNodes.PushBack(ast.CreateOutput(s_sOutput1, pResult1));
+  }
+
+  static void Execute(ezExpressionVM& vm, const ezExpressionByteCode& byteCode, ezDynamicArray<float>& a, ezDynamicArray<float>& b, ezDynamicArray<float>& out0, ezDynamicArray<float>& out1)
+  {
+    ezHybridArray<ezExpression::Stream, 2> inputs;
+    inputs.PushBack(ezExpression::MakeStream(a.GetArrayPtr(), 0, s_sInputA));
+    inputs.PushBack(ezExpression::MakeStream(b.GetArrayPtr(), 0, s_sInputB));
+
+    ezHybridArray<ezExpression::Stream, 2> outputs;
+    outputs.PushBack(ezExpression::MakeStream(out0.GetArrayPtr(), 0, s_sOutput0));
+    outputs.PushBack(ezExpression::MakeStream(out1.GetArrayPtr(), 0, s_sOutput1));
+
+    EZ_TEST_BOOL(vm.Execute(byteCode, inputs, outputs, a.GetCount()).Succeeded());
+  }
+
+  static ezUInt32 CountBitMismatches(const ezDynamicArray<float>& a, const ezDynamicArray<float>& b)
+  {
+    ezUInt32 uiNumMismatches = 0;
+    for (ezUInt32 i = 0; i < a.GetCount(); ++i)
+    {
+      if (ezMemoryUtils::RawByteCompare(&a[i], &b[i], sizeof(float)) != 0)
+        ++uiNumMismatches;
+    }
+
+    return uiNumMismatches;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(ProcGen, ExpressionCompiler)
+{
+  ezExpressionByteCode unoptimizedByteCode;
+  ezExpressionByteCode optimizedByteCode;
+  ezExpressionByteCode inexactByteCode;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Optimize")
+  {
+    ezExpressionCompiler compiler;
+
+    ezExpressionAST unoptimizedAst;
+    BuildTestAST(unoptimizedAst);
+    EZ_TEST_BOOL(compiler.Compile(unoptimizedAst, unoptimizedByteCode, false).Succeeded());
+    EZ_TEST_INT(compiler.GetNumUnoptimizedInstructions(), unoptimizedByteCode.GetNumInstructions());
+
+    ezExpressionAST optimizedAst;
+    BuildTestAST(optimizedAst);
+    EZ_TEST_BOOL(compiler.Compile(optimizedAst, optimizedByteCode).Succeeded());
+    EZ_TEST_INT(compiler.GetNumUnoptimizedInstructions(), unoptimizedByteCode.GetNumInstructions());
+    EZ_TEST_BOOL(optimizedByteCode.GetNumInstructions() < unoptimizedByteCode.GetNumInstructions());
+
+    ezExpressionAST inexactAst;
+    BuildTestAST(inexactAst);
+    EZ_TEST_BOOL(compiler.Compile(inexactAst, inexactByteCode, true, true).Succeeded());
+    EZ_TEST_BOOL(inexactByteCode.GetNumInstructions() <= optimizedByteCode.GetNumInstructions());
+
+    ezTestFramework::Output(ezTestOutput::Details, "Instructions: %u before optimization, %u after, %u with inexact math", unoptimizedByteCode.GetNumInstructions(),
+      optimizedByteCode.GetNumInstructions(), inexactByteCode.GetNumInstructions());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Negate")
+  {
+    // There is no negate instruction, the optimizer has to lower it
+    ezExpressionAST ast;
+    ast.m_OutputNodes.PushBack(ast.CreateOutput(s_sOutput0, ast.CreateUnaryOperator(ezExpressionAST::NodeType::Negate, ast.CreateInput(s_sInputA))));
+    ast.m_OutputNodes.PushBack(ast.CreateOutput(s_sOutput1, ast.CreateUnaryOperator(ezExpressionAST::NodeType::Negate, Const(ast, 3.0f))));
+
+    ezExpressionByteCode byteCode;
+    ezExpressionCompiler compiler;
+    EZ_TEST_BOOL(compiler.Compile(ast, byteCode).Succeeded());
+
+    ezDynamicArray<float> a, b, out0, out1;
+    a.PushBack(1.0f);
+    a.PushBack(-2.0f);
+    a.PushBack(0.0f);
+    a.PushBack(5.5f);
+    b.SetCount(a.GetCount());
+    out0.SetCount(a.GetCount());
+    out1.SetCount(a.GetCount());
+
+    ezExpressionVM vm;
+    Execute(vm, byteCode, a, b, out0, out1);
+
+    for (ezUInt32 i = 0; i < a.GetCount(); ++i)
+    {
+      EZ_TEST_FLOAT(out0[i], -a[i], 0.0f);
+      EZ_TEST_FLOAT(out1[i], -3.0f, 0.0f);
+    }
+  }
+
+  const ezUInt32 uiNumInstances = 64 * 1024;
+  ezDynamicArray<float> a, b;
+  a.SetCountUninitialized(uiNumInstances);
+  b.SetCountUninitialized(uiNumInstances);
+
+  for (ezUInt32 i = 0; i < uiNumInstances; ++i)
+  {
+    a[i] = (static_cast<float>(i) - 1000.0f) * 0.01f;
+    b[i] = ezMath::Sin(ezAngle::Radian(static_cast<float>(i))) * 3.0f;
+  }
+
+  ezExpressionVM vm;
+  ezDynamicArray<float> unoptimizedOut0, unoptimizedOut1, optimizedOut0, optimizedOut1;
+  unoptimizedOut0.SetCount(uiNumInstances);
+  unoptimizedOut1.SetCount(uiNumInstances);
+  optimizedOut0.SetCount(uiNumInstances);
+  optimizedOut1.SetCount(uiNumInstances);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Same Results")
+  {
+    Execute(vm, unoptimizedByteCode, a, b, unoptimizedOut0, unoptimizedOut1);
+    Execute(vm, optimizedByteCode, a, b, optimizedOut0, optimizedOut1);
+
+    EZ_TEST_INT(CountBitMismatches(optimizedOut0, unoptimizedOut0), 0);
+    EZ_TEST_INT(CountBitMismatches(optimizedOut1, unoptimizedOut1), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Inexact Math")
+  {
+    ezDynamicArray<float> inexactOut0, inexactOut1;
+    inexactOut0.SetCount(uiNumInstances);
+    inexactOut1.SetCount(uiNumInstances);
+
+    Execute(vm, inexactByteCode, a, b, inexactOut0, inexactOut1);
+
+    for (ezUInt32 i = 0; i < uiNumInstances; ++i)
+    {
+      // b / 4 becomes 0.25 * b and additions are reassociated, so only allow for rounding differences
+      EZ_TEST_FLOAT(inexactOut0[i], unoptimizedOut0[i], ezMath::Max(ezMath::Abs(unoptimizedOut0[i]), 1.0f) * 1e-5f);
+      EZ_TEST_FLOAT(inexactOut1[i], unoptimizedOut1[i], 0.0f);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Throughput")
+  {
+    const ezUInt32 uiNumIterations = 100;
+
+    for (ezUInt32 uiPass = 0; uiPass < 2; ++uiPass)
+    {
+      const bool bOptimized = uiPass == 1;
+      const ezExpressionByteCode& byteCode = bOptimized ? optimizedByteCode : unoptimizedByteCode;
+      ezDynamicArray<float>& out0 = bOptimized ? optimizedOut0 : unoptimizedOut0;
+      ezDynamicArray<float>& out1 = bOptimized ? optimizedOut1 : unoptimizedOut1;
+
+      ezStopwatch sw;
+
+      for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+      {
+        Execute(vm, byteCode, a, b, out0, out1);
+      }
+
+      const ezTime tDiff = sw.Checkpoint();
+      const double fPointsPerSec = (double)uiNumInstances * uiNumIterations / tDiff.GetSeconds();
+
+      ezTestFramework::Output(ezTestOutput::Duration, "Evaluating %u points x %u (%s, %u instructions): %.2fms, %.1f million points/sec", uiNumInstances, uiNumIterations,
+        bOptimized ? "optimized" : "unoptimized", byteCode.GetNumInstructions(), tDiff.GetMilliseconds(), fPointsPerSec / 1000000.0);
+    }
+  }
+}
@@ -8,7 +8,9 @@
 #  include <Core/Scripting/DuktapeFunction.h>
 #  include <Core/Scripting/DuktapeHelper.h>
 #  include <Core/WorldSerializer/WorldReader.h>
+#  include <Foundation/Configuration/CVar.h>
 #  include <Foundation/IO/FileSystem/FileReader.h>
+#  include <Foundation/Time/Stopwatch.h>
 #  include <TypeScriptPlugin/Components/TypeScriptComponent.h>
 
 static ezGameEngineTestTypeScript s_GameEngineTestTypeScript;
@@ -40,6 +42,8 @@ void ezGameEngineTestTypeScript::SetupSubTests()
   AddSubTest("Messaging", SubTests::Messaging);
   AddSubTest("World", SubTests::World);
   AddSubTest("Utils", SubTests::Utils);
+  AddSubTest("TickBenchmark", SubTests::TickBenchmark);
+  AddSubTest("MarshallingBenchmark", SubTests::MarshallingBenchmark);
 }
 
 ezResult ezGameEngineTestTypeScript::InitializeSubTest(ezInt32 iIdentifier)
@@ -50,6 +54,12 @@ ezResult ezGameEngineTestTypeScript::InitializeSubTest(ezInt32 iIdentifier)
 
 ezTestAppRun ezGameEngineTestTypeScript::RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount)
 {
+  if (iIdentifier == SubTests::TickBenchmark)
+    return m_pOwnApplication->SubTestTickBenchmarkExec();
+
+  if (iIdentifier == SubTests::MarshallingBenchmark)
+    return m_pOwnApplication->SubTestMarshallingBenchmarkExec();
+
   return m_pOwnApplication->SubTestBasisExec(GetSubTestName(iIdentifier));
 }
 
@@ -114,4 +124,116 @@ ezTestAppRun ezGameEngineTestApplication_TypeScript::SubTestBasisExec(const char
   return ezTestAppRun::Quit;
 }
 
+ezTestAppRun ezGameEngineTestApplication_TypeScript::SubTestTickBenchmarkExec()
+{
+  const ezUInt32 uiNumComponents = 2000;
+  const ezUInt32 uiNumFrames = 20;
+
+  // 'Scripts/HelperComponent.ts', which ticks every frame and does nothing else
+  const ezUuid helperComponentGuid(1933856411826999952ull, 5013643632336318617ull);
+
+  ezCVarBool* pBatchTick = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("ts_BatchTick"));
+  if (!EZ_TEST_BOOL(pBatchTick != nullptr))
+    return ezTestAppRun::Quit;
+
+  EZ_LOCK(m_pWorld->GetWriteMarker());
+
+  ezTypeScriptComponentManager* pMan = m_pWorld->GetOrCreateComponentManager<ezTypeScriptComponentManager>();
+
+  for (ezUInt32 i = 0; i < uiNumComponents; ++i)
+  {
+    ezGameObjectDesc desc;
+    ezGameObject* pObject = nullptr;
+    m_pWorld->CreateObject(desc, pObject);
+
+    ezTypeScriptComponent* pComponent = nullptr;
+    pMan->CreateComponent(pObject, pComponent);
+    pComponent->SetTypeScriptComponentGuid(helperComponentGuid);
+  }
+
+  // initialize the new components and let them set their tick interval
+  m_pWorld->Update();
+  m_pWorld->Update();
+
+  const bool bPrevBatchTick = *pBatchTick;
+
+  for (ezUInt32 uiPass = 0; uiPass < 2; ++uiPass)
+  {
+    const bool bBatched = uiPass == 1;
+    *pBatchTick = bBatched;
+
+    ezUInt32 uiNumTicks = 0;
+    ezStopwatch sw;
+
+    for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+    {
+      m_pWorld->Update();
+      uiNumTicks += pMan->GetNumTickedComponents();
+    }
+
+    const ezTime tDiff = sw.Checkpoint();
+
+    EZ_TEST_BOOL(uiNumTicks >= uiNumComponents * uiNumFrames);
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%s tick: %u ticks in %.2fms, %.1f ticks/ms", bBatched ? "Batched" : "Per component",
+      uiNumTicks, tDiff.GetMilliseconds(), uiNumTicks / tDiff.GetMilliseconds());
+  }
+
+  *pBatchTick = bPrevBatchTick;
+
+  return ezTestAppRun::Quit;
+}
+
+ezTestAppRun ezGameEngineTestApplication_TypeScript::SubTestMarshallingBenchmarkExec()
+{
+  const ezUInt32 uiNumCalls = 100000;
+
+  EZ_LOCK(m_pWorld->GetWriteMarker());
+
+  ezTypeScriptBinding& binding = m_pWorld->GetOrCreateComponentManager<ezTypeScriptComponentManager>()->GetTsBinding();
+  ezDuktapeContext& duk = binding.GetDukTapeContext();
+
+  const char* szBenchmarkCode = "function __Test_SetGlobalPosition(go, num) {\n"
+                                "  var pos = new __Vec3.Vec3(0, 2, 3);\n"
+                                "  for (var i = 0; i < num; ++i) { pos.x = i; go.SetGlobalPosition(pos); }\n"
+                                "}\n"
+                                "function __Test_GetGlobalPosition(go, num) {\n"
+                                "  var sum = 0;\n"
+                                "  for (var i = 0; i < num; ++i) { sum += go.GetGlobalPosition().x; }\n"
+                                "  return sum;\n"
+                                "}\n";
+
+  if (!EZ_TEST_BOOL(duk.ExecuteString(szBenchmarkCode).Succeeded()))
+    return ezTestAppRun::Quit;
+
+  ezGameObjectDesc desc;
+  desc.m_bDynamic = true;
+  ezGameObject* pObject = nullptr;
+  m_pWorld->CreateObject(desc, pObject);
+
+  const char* szFunctions[] = {"__Test_SetGlobalPosition", "__Test_GetGlobalPosition"};
+
+  for (const char* szFunction : szFunctions)
+  {
+    ezStopwatch sw;
+
+    if (!EZ_TEST_BOOL(duk.PrepareGlobalFunctionCall(szFunction).Succeeded())) // [ func ]
+      return ezTestAppRun::Quit;
+
+    binding.DukPutGameObject(pObject);                    // [ func go ]
+    duk.PushUInt(uiNumCalls);                             // [ func go num ]
+    EZ_TEST_BOOL(duk.CallPreparedFunction().Succeeded()); // [ result ]
+    duk.PopStack();                                       // [ ]
+
+    const ezTime tDiff = sw.Checkpoint();
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%s: %u calls in %.2fms, %.1f calls/ms", szFunction + 7, uiNumCalls, tDiff.GetMilliseconds(),
+      uiNumCalls / tDiff.GetMilliseconds());
+  }
+
+  EZ_TEST_VEC3(pObject->GetGlobalPosition(), ezVec3(static_cast<float>(uiNumCalls - 1), 2, 3), 0.0f);
+
+  return ezTestAppRun::Quit;
+}
+
 #endif
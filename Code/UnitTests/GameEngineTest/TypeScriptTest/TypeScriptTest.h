@@ -11,6 +11,8 @@ public:
 
   void SubTestBasicsSetup();
   ezTestAppRun SubTestBasisExec(const char* szSubTestName);
+  ezTestAppRun SubTestTickBenchmarkExec();
+  ezTestAppRun SubTestMarshallingBenchmarkExec();
 };
 
 class ezGameEngineTestTypeScript : public ezGameEngineTest
@@ -37,6 +39,8 @@ public:
     Messaging,
     World,
     Utils,
+    TickBenchmark,
+    MarshallingBenchmark,
   };
 
 private:
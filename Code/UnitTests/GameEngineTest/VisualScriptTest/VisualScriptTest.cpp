@@ -0,0 +1,183 @@
+#include <GameEngineTestPCH.h>
+
+#include <Core/Messages/CommonMessages.h>
+#include <Core/ResourceManager/ResourceManager.h>
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <GameEngine/VisualScript/Nodes/VisualScriptMathNodes.h>
+#include <GameEngine/VisualScript/Nodes/VisualScriptMessageNodes.h>
+#include <GameEngine/VisualScript/Nodes/VisualScriptVariableNodes.h>
+#include <GameEngine/VisualScript/VisualScriptInstance.h>
+#include <GameEngine/VisualScript/VisualScriptResource.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(VisualScript);
+
+namespace
+{
+  void AddNode(ezVisualScriptResourceDescriptor& desc, const ezRTTI* pType, const char* szProperty, const ezVariant& value)
+  {
+    auto& node = desc.m_Nodes.ExpandAndGetRef();
+    node.m_pType = pType;
+    node.m_sTypeName = pType->GetTypeName();
+    node.m_uiFirstProperty = static_cast<ezUInt16>(desc.m_Properties.GetCount());
+    node.m_uiNumProperties = 1;
+
+    auto& prop = desc.m_Properties.ExpandAndGetRef();
+    prop.m_sName = szProperty;
+    prop.m_Value = value;
+  }
+
+  void AddDataPath(ezVisualScriptResourceDescriptor& desc, ezUInt16 uiSourceNode, ezUInt8 uiOutputPin, ezUInt16 uiTargetNode, ezUInt8 uiInputPin)
+  {
+    auto& con = desc.m_DataPaths.ExpandAndGetRef();
+    con.m_uiSourceNode = uiSourceNode;
+    con.m_uiOutputPin = uiOutputPin;
+    con.m_uiOutputPinType = ezVisualScriptDataPinType::Number;
+    con.m_uiTargetNode = uiTargetNode;
+    con.m_uiInputPin = uiInputPin;
+    con.m_uiInputPinType = ezVisualScriptDataPinType::Number;
+  }
+
+  /// Builds a script that increments the local variable 'Counter' whenever the generic event 'Count' is received.
+  ezVisualScriptResourceHandle CreateCounterScript(const char* szResourceID)
+  {
+    ezVisualScriptResourceDescriptor desc;
+
+    AddNode(desc, ezGetStaticRTTI<ezVisualScriptNode_SimpleUserEvent>(), "Message", "Count"); // 0
+    AddNode(desc, ezGetStaticRTTI<ezVisualScriptNode_Number>(), "Name", "Counter");           // 1
+    AddNode(desc, ezGetStaticRTTI<ezVisualScriptNode_StoreNumber>(), "Name", "Counter");      // 2
+    AddNode(desc, ezGetStaticRTTI<ezVisualScriptNode_MultiplyAdd>(), "b1", 1.0);              // 3
+
+    auto& exec = desc.m_ExecutionPaths.ExpandAndGetRef();
+    exec.m_uiSourceNode = 0;
+    exec.m_uiOutputPin = 0;
+    exec.m_uiTargetNode = 2;
+    exec.m_uiInputPin = 0;
+
+    // Counter * 1 + 1 * 1 -> Counter
+    AddDataPath(desc, 1, 0, 3, 0);
+    AddDataPath(desc, 3, 0, 2, 0);
+
+    desc.PrecomputeMessageHandlers();
+
+    return ezResourceManager::CreateResource<ezVisualScriptResource>(szResourceID, std::move(desc));
+  }
+
+  double GetCounter(ezVisualScriptInstance& instance)
+  {
+    double fValue = -1.0;
+    instance.GetLocalVariables().RetrieveDouble("Counter", fValue, -1.0);
+    return fValue;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(VisualScript, SharedProgram)
+{
+  ezVisualScriptResourceHandle hScript = CreateCounterScript("VisualScriptTest_Counter");
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Program")
+  {
+    ezResourceLock<ezVisualScriptResource> pScript(hScript, ezResourceAcquireMode::BlockTillLoaded);
+    const ezVisualScriptProgram& program = *pScript->GetProgram();
+
+    EZ_TEST_INT(program.GetNodeCount(), 4);
+    EZ_TEST_BOOL(program.IsManuallyStepped(0));
+    EZ_TEST_BOOL(!program.IsManuallyStepped(1));
+    EZ_TEST_BOOL(program.IsManuallyStepped(2));
+    EZ_TEST_BOOL(!program.IsManuallyStepped(3));
+
+    const ezVisualScriptProgram::ExecPinConnection* pExec = program.GetExecConnection(0, 0);
+    if (EZ_TEST_BOOL(pExec != nullptr))
+    {
+      EZ_TEST_INT(pExec->m_uiTargetNode, 2);
+      EZ_TEST_INT(pExec->m_uiTargetPin, 0);
+    }
+    EZ_TEST_BOOL(program.GetExecConnection(0, 1) == nullptr);
+    EZ_TEST_BOOL(program.GetExecConnection(2, 0) == nullptr);
+
+    EZ_TEST_INT(program.GetDataConnectionCount(), 2);
+    EZ_TEST_INT(program.GetDataConnections(1, 0).m_uiCount, 1);
+    EZ_TEST_INT(program.GetDataConnections(3, 0).m_uiCount, 1);
+    EZ_TEST_INT(program.GetDataConnections(2, 0).m_uiCount, 0);
+    EZ_TEST_BOOL(program.GetDataConnection(program.GetDataConnections(1, 0).m_uiFirst).m_AssignFunc != nullptr);
+
+    EZ_TEST_INT(program.GetDependencies(2).GetCount(), 1);
+    EZ_TEST_INT(program.GetDependencies(2)[0], 3);
+    EZ_TEST_INT(program.GetDependencies(3).GetCount(), 1);
+    EZ_TEST_INT(program.GetDependencies(3)[0], 1);
+    EZ_TEST_INT(program.GetDependencies(1).GetCount(), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Execute")
+  {
+    ezVisualScriptInstance instances[3];
+    for (auto& instance : instances)
+    {
+      instance.Configure(hScript, nullptr);
+    }
+
+    ezMsgGenericEvent msg;
+    msg.m_sMessage = "Count";
+
+    ezMsgGenericEvent otherMsg;
+    otherMsg.m_sMessage = "Other";
+
+    // every instance keeps its own state even though they share the program
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(instances); ++i)
+    {
+      for (ezUInt32 j = 0; j <= i; ++j)
+      {
+        EZ_TEST_BOOL(instances[i].HandleMessage(msg));
+        instances[i].ExecuteScript();
+      }
+
+      EZ_TEST_BOOL(instances[i].HandleMessage(otherMsg));
+      instances[i].ExecuteScript();
+    }
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(instances); ++i)
+    {
+      EZ_TEST_DOUBLE(GetCounter(instances[i]), i + 1.0, 0.0);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::EnabledInRelease, "Throughput")
+  {
+    const ezUInt32 uiNumInstances = 4096;
+    const ezUInt32 uiNumIterations = 100;
+
+    ezDeque<ezVisualScriptInstance> instances;
+    instances.SetCount(uiNumInstances);
+
+    ezStopwatch sw;
+
+    for (auto& instance : instances)
+    {
+      instance.Configure(hScript, nullptr);
+    }
+
+    const ezTime tCreate = sw.Checkpoint();
+
+    ezMsgGenericEvent msg;
+    msg.m_sMessage = "Count";
+
+    for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+    {
+      for (auto& instance : instances)
+      {
+        instance.HandleMessage(msg);
+        instance.ExecuteScript();
+      }
+    }
+
+    const ezTime tExecute = sw.Checkpoint();
+
+    EZ_TEST_DOUBLE(GetCounter(instances[0]), (double)uiNumIterations, 0.0);
+    EZ_TEST_DOUBLE(GetCounter(instances[uiNumInstances - 1]), (double)uiNumIterations, 0.0);
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Configuring %u instances: %.2fms (%.2fus per instance)", uiNumInstances,
+      tCreate.GetMilliseconds(), tCreate.GetMicroseconds() / uiNumInstances);
+    ezTestFramework::Output(ezTestOutput::Duration, "Handling and executing %u x %u messages: %.2fms (%.1f million messages/sec)", uiNumInstances,
+      uiNumIterations, tExecute.GetMilliseconds(), (double)uiNumInstances * uiNumIterations / tExecute.GetSeconds() / 1000000.0);
+  }
+}
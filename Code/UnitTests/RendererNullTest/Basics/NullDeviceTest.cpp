@@ -0,0 +1,754 @@
+#include <RendererNullTestPCH.h>
+
+#include <Core/Graphics/Camera.h>
+#include <Core/Graphics/Geometry.h>
+#include <Core/ResourceManager/ResourceManager.h>
+#include <Core/World/World.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Serialization/BinarySerializer.h>
+#include <Foundation/Serialization/DdlSerializer.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Foundation/Types/ScopeExit.h>
+#include <RendererCore/Lights/DirectionalLightComponent.h>
+#include <RendererCore/Lights/PointLightComponent.h>
+#include <RendererCore/Material/MaterialResource.h>
+#include <RendererCore/Meshes/MeshComponent.h>
+#include <RendererCore/Meshes/MeshResource.h>
+#include <RendererCore/Pipeline/RenderPipeline.h>
+#include <RendererCore/Pipeline/RenderPipelinePass.h>
+#include <RendererCore/Pipeline/RenderPipelineResource.h>
+#include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderContext/RenderContext.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+#include <RendererCore/Shader/ShaderPermutationResource.h>
+#include <RendererCore/Shader/ShaderResource.h>
+#include <RendererCore/ShaderCompiler/ShaderManager.h>
+#include <RendererFoundation/Resources/RenderTargetSetup.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
+
+namespace
+{
+  struct ObjectCB
+  {
+    ezMat4 m_ObjectToWorld;
+    ezColor m_Color;
+  };
+
+  /// Creates a null device as the default device and starts the high level systems, so that RendererCore can be used on top of it.
+  class NullRendererSetup
+  {
+  public:
+    NullRendererSetup()
+    {
+      ezGALDeviceCreationDescription desc;
+      desc.m_bCreatePrimarySwapChain = false;
+
+      m_pDevice = EZ_DEFAULT_NEW(ezGALDeviceNull, desc);
+      EZ_VERIFY(m_pDevice->Init().Succeeded(), "Failed to initialize the null device");
+
+      ezGALDevice::SetDefaultDevice(m_pDevice);
+
+      ezStartup::StartupHighLevelSystems();
+
+      m_hShader = CreateShader(false);
+
+      ezGALVertexDeclarationCreationDescription vertexDeclDesc;
+      vertexDeclDesc.m_hShader = m_hShader;
+      vertexDeclDesc.m_VertexAttributes.PushBack(ezGALVertexAttribute(ezGALVertexAttributeSemantic::Position, ezGALResourceFormat::XYZFloat, 0, 0, false));
+      vertexDeclDesc.m_VertexAttributes.PushBack(ezGALVertexAttribute(ezGALVertexAttributeSemantic::TexCoord0, ezGALResourceFormat::UVFloat, 12, 0, false));
+      m_hVertexDeclaration = m_pDevice->CreateVertexDeclaration(vertexDeclDesc);
+
+      m_hVertexBuffer = m_pDevice->CreateVertexBuffer(sizeof(float) * 5, 1024);
+      m_hIndexBuffer = m_pDevice->CreateIndexBuffer(ezGALIndexType::UInt, 3 * 1024);
+
+      ezGALTextureCreationDescription texDesc;
+      texDesc.SetAsRenderTarget(320, 240, ezGALResourceFormat::RGBAUByteNormalizedsRGB);
+      m_hColorTarget = m_pDevice->CreateTexture(texDesc);
+
+      texDesc.SetAsRenderTarget(320, 240, ezGALResourceFormat::D24S8);
+      m_hDepthTarget = m_pDevice->CreateTexture(texDesc);
+    }
+
+    ~NullRendererSetup()
+    {
+      m_pDevice->DestroyTexture(m_hDepthTarget);
+      m_pDevice->DestroyTexture(m_hColorTarget);
+      m_pDevice->DestroyBuffer(m_hIndexBuffer);
+      m_pDevice->DestroyBuffer(m_hVertexBuffer);
+      m_pDevice->DestroyVertexDeclaration(m_hVertexDeclaration);
+      m_pDevice->DestroyShader(m_hShader);
+
+      ezStartup::ShutdownHighLevelSystems();
+
+      m_pDevice->Shutdown().IgnoreResult();
+      EZ_DEFAULT_DELETE(m_pDevice);
+    }
+
+    ezGALShaderHandle CreateShader(bool bCompute)
+    {
+      // the null device accepts any byte code
+      const ezUInt8 byteCode[] = {0xDE, 0xAD, 0xBE, 0xEF};
+
+      ezGALShaderCreationDescription desc;
+      if (bCompute)
+      {
+        desc.m_ByteCodes[ezGALShaderStage::ComputeShader] = EZ_DEFAULT_NEW(ezGALShaderByteCode, ezMakeArrayPtr(byteCode));
+      }
+      else
+      {
+        desc.m_ByteCodes[ezGALShaderStage::VertexShader] = EZ_DEFAULT_NEW(ezGALShaderByteCode, ezMakeArrayPtr(byteCode));
+        desc.m_ByteCodes[ezGALShaderStage::PixelShader] = EZ_DEFAULT_NEW(ezGALShaderByteCode, ezMakeArrayPtr(byteCode));
+      }
+
+      return m_pDevice->CreateShader(desc);
+    }
+
+    void BindGeometry(ezGALContext* pContext)
+    {
+      pContext->SetShader(m_hShader);
+      pContext->SetVertexDeclaration(m_hVertexDeclaration);
+      pContext->SetVertexBuffer(0, m_hVertexBuffer);
+      pContext->SetIndexBuffer(m_hIndexBuffer);
+      pContext->SetPrimitiveTopology(ezGALPrimitiveTopology::Triangles);
+    }
+
+    void BindTargets(ezGALContext* pContext)
+    {
+      ezGALRenderTargetSetup renderTargetSetup;
+      renderTargetSetup.SetRenderTarget(0, m_pDevice->GetDefaultRenderTargetView(m_hColorTarget))
+        .SetDepthStencilTarget(m_pDevice->GetDefaultRenderTargetView(m_hDepthTarget));
+
+      pContext->SetRenderTargetSetup(renderTargetSetup);
+    }
+
+    ezGALDeviceNull* m_pDevice = nullptr;
+
+    ezGALShaderHandle m_hShader;
+    ezGALVertexDeclarationHandle m_hVertexDeclaration;
+    ezGALBufferHandle m_hVertexBuffer;
+    ezGALBufferHandle m_hIndexBuffer;
+    ezGALTextureHandle m_hColorTarget;
+    ezGALTextureHandle m_hDepthTarget;
+  };
+
+  struct NullShaderBinding
+  {
+    const char* m_szName;
+    ezInt32 m_iSlot;
+    ezShaderResourceBinding::ResourceType m_Type;
+  };
+
+  /// Writes a shader stage binary in the format ezShaderStageBinary reads. The byte code is only accepted by the null device.
+  ezResult WriteNullShaderStage(ezGALShaderStage::Enum stage, ezUInt32 uiHash, ezArrayPtr<const NullShaderBinding> bindings)
+  {
+    ezStringBuilder sFile = ezShaderManager::GetCacheDirectory();
+    sFile.AppendPath(ezShaderManager::GetActivePlatform().GetData());
+    sFile.AppendFormat("/{0}_{1}.ezShaderStage", ezGALShaderStage::Names[stage], ezArgU(uiHash, 8, true, 16, true));
+
+    ezFileWriter file;
+    EZ_SUCCEED_OR_RETURN(file.Open(sFile));
+
+    const ezUInt8 byteCode[] = {0xDE, 0xAD, 0xBE, 0xEF};
+
+    file << (ezUInt8)ezShaderStageBinary::VersionCurrent;
+    file << (ezUInt32)0; // source hash
+    file << (ezUInt8)stage;
+    file << (ezUInt32)sizeof(byteCode);
+    EZ_SUCCEED_OR_RETURN(file.WriteBytes(byteCode, sizeof(byteCode)));
+
+    file << (ezUInt16)bindings.GetCount();
+
+    for (const NullShaderBinding& binding : bindings)
+    {
+      file << binding.m_szName;
+      file << binding.m_iSlot;
+      file << (ezUInt8)binding.m_Type;
+
+      if (binding.m_Type == ezShaderResourceBinding::ConstantBuffer)
+      {
+        // an empty constant buffer layout, only materials need the constants
+        file << (ezUInt32)0;
+        file << (ezUInt16)0;
+      }
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  /// Provides the shader and all of its permutations from memory, so that no shader compiler is needed.
+  class NullShaderLoader : public ezResourceTypeLoader
+  {
+  public:
+    struct LoadedData
+    {
+      ezMemoryStreamStorage m_StreamData;
+      ezMemoryStreamReader m_Reader;
+    };
+
+    virtual ezResourceLoadData OpenDataStream(const ezResource* pResource) override
+    {
+      LoadedData* pData = EZ_DEFAULT_NEW(LoadedData);
+
+      ezMemoryStreamWriter writer(&pData->m_StreamData);
+      pData->m_Reader.SetStorage(&pData->m_StreamData);
+
+      if (pResource->GetDynamicRTTI()->IsDerivedFrom<ezShaderPermutationResource>())
+      {
+        // the permutation files are named after their shader, the materials use the mesh shader and all passes of the pipeline share the other stages
+        const bool bMeshShader = ezPathUtils::GetFileName(pResource->GetResourceID().GetData()).StartsWith("NullMeshShader_");
+
+        ezShaderPermutationBinary permutation;
+        permutation.m_uiShaderStageHashes[ezGALShaderStage::VertexShader] = bMeshShader ? m_uiMeshVertexShaderHash : m_uiPassVertexShaderHash;
+        permutation.m_uiShaderStageHashes[ezGALShaderStage::PixelShader] = bMeshShader ? m_uiMeshPixelShaderHash : m_uiPassPixelShaderHash;
+        permutation.Write(writer).IgnoreResult();
+      }
+      else
+      {
+        // the same layout ezResourceLoaderFromFile produces, the shader doesn't use any permutation variables
+        const char* szShader = "[PLATFORMS]\nALL\n\n[PERMUTATIONS]\n\n[VERTEXSHADER]\n\n[PIXELSHADER]\n";
+
+        writer << pResource->GetResourceID();
+        writer.WriteBytes(szShader, ezStringUtils::GetStringElementCount(szShader)).IgnoreResult();
+      }
+
+      ezResourceLoadData ld;
+      ld.m_pCustomLoaderData = pData;
+      ld.m_pDataStream = &pData->m_Reader;
+      ld.m_sResourceDescription = pResource->GetResourceID();
+
+      return ld;
+    }
+
+    virtual void CloseDataStream(const ezResource* pResource, const ezResourceLoadData& LoaderData) override
+    {
+      LoadedData* pData = static_cast<LoadedData*>(LoaderData.m_pCustomLoaderData);
+      EZ_DEFAULT_DELETE(pData);
+    }
+
+    ezUInt32 m_uiMeshVertexShaderHash = 0;
+    ezUInt32 m_uiMeshPixelShaderHash = 0;
+    ezUInt32 m_uiPassVertexShaderHash = 0;
+    ezUInt32 m_uiPassPixelShaderHash = 0;
+  };
+
+  /// Converts a render pipeline asset document into a render pipeline resource, without the editor.
+  ///
+  /// The document stores the passes, the extractors, their pins and the connections between the passes in the same layout that the asset
+  /// transform writes, so the object graph only needs to be stored in the binary format.
+  ezRenderPipelineResourceHandle LoadRenderPipelineAsset(const char* szFile)
+  {
+    ezFileReader file;
+    if (file.Open(szFile).Failed())
+      return ezRenderPipelineResourceHandle();
+
+    ezUniquePtr<ezAbstractObjectGraph> pHeader;
+    ezUniquePtr<ezAbstractObjectGraph> pGraph;
+    ezUniquePtr<ezAbstractObjectGraph> pTypes;
+    if (ezAbstractGraphDdlSerializer::ReadDocument(file, pHeader, pGraph, pTypes).Failed())
+      return ezRenderPipelineResourceHandle();
+
+    ezRenderPipelineResourceDescriptor desc;
+    {
+      ezMemoryStreamContainerWrapperStorage<ezDynamicArray<ezUInt8>> storage(&desc.m_SerializedPipeline);
+      ezMemoryStreamWriter writer(&storage);
+      ezAbstractGraphBinarySerializer::Write(writer, pGraph.Borrow());
+    }
+
+    return ezResourceManager::CreateResource<ezRenderPipelineResource>(szFile, std::move(desc), szFile);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Basics, NullDevice)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Resource Creation")
+  {
+    NullRendererSetup setup;
+    ezGALDeviceNull* pDevice = setup.m_pDevice;
+
+    EZ_TEST_STRING(pDevice->GetCapabilities().m_sAdapterName, "Null Device");
+    EZ_TEST_BOOL(!setup.m_hShader.IsInvalidated());
+    EZ_TEST_BOOL(!setup.m_hVertexDeclaration.IsInvalidated());
+    EZ_TEST_BOOL(!setup.m_hColorTarget.IsInvalidated());
+    EZ_TEST_BOOL(!setup.m_hDepthTarget.IsInvalidated());
+
+    ezGALShaderHandle hComputeShader = setup.CreateShader(true);
+    EZ_TEST_BOOL(!hComputeShader.IsInvalidated());
+    pDevice->DestroyShader(hComputeShader);
+
+    ezTestLogInterface log;
+    ezTestLogSystemScope logSystemScope(&log);
+
+    // compute and graphics stages can't be combined
+    {
+      log.ExpectMessage("A compute shader can't be combined with graphics shader stages", ezLogMsgType::ErrorMsg);
+
+      const ezUInt8 byteCode[] = {1, 2, 3, 4};
+      ezGALShaderCreationDescription desc;
+      desc.m_ByteCodes[ezGALShaderStage::VertexShader] = EZ_DEFAULT_NEW(ezGALShaderByteCode, ezMakeArrayPtr(byteCode));
+      desc.m_ByteCodes[ezGALShaderStage::ComputeShader] = EZ_DEFAULT_NEW(ezGALShaderByteCode, ezMakeArrayPtr(byteCode));
+      EZ_TEST_BOOL(pDevice->CreateShader(desc).IsInvalidated());
+    }
+
+    // more mip levels than the size allows
+    {
+      log.ExpectMessage("Invalid mip level count", ezLogMsgType::ErrorMsg);
+
+      ezGALTextureCreationDescription desc;
+      desc.m_uiWidth = 16;
+      desc.m_uiHeight = 16;
+      desc.m_uiMipLevelCount = 8;
+      desc.m_ResourceAccess.m_bImmutable = false;
+      EZ_TEST_BOOL(pDevice->CreateTexture(desc).IsInvalidated());
+    }
+
+    EZ_TEST_INT(pDevice->GetFrameStats().m_uiValidationErrors, 2);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Draw Validation")
+  {
+    NullRendererSetup setup;
+    ezGALDeviceNull* pDevice = setup.m_pDevice;
+    ezGALContext* pContext = pDevice->GetPrimaryContext();
+
+    pDevice->BeginFrame();
+
+    ezTestLogInterface log;
+    ezTestLogSystemScope logSystemScope(&log);
+
+    log.ExpectMessage("No shader with a vertex shader stage is bound", ezLogMsgType::ErrorMsg);
+    pContext->DrawIndexed(3, 0);
+
+    setup.BindGeometry(pContext);
+
+    log.ExpectMessage("Neither a render target, a depth stencil target nor a stream out buffer is bound", ezLogMsgType::ErrorMsg);
+    pContext->DrawIndexed(3, 0);
+
+    setup.BindTargets(pContext);
+
+    log.ExpectMessage("are out of bounds", ezLogMsgType::ErrorMsg);
+    pContext->DrawIndexed(6, 3 * 1024 - 3);
+
+    pContext->DrawIndexed(3 * 1024, 0);
+    pContext->DrawIndexedInstanced(6, 10, 0);
+
+    EZ_TEST_INT(pDevice->GetFrameStats().m_uiValidationErrors, 3);
+    EZ_TEST_INT(pDevice->GetFrameStats().m_uiDrawCalls, 2);
+    EZ_TEST_INT(pDevice->GetFrameStats().m_uiInstances, 11);
+
+    log.ExpectMessage("No shader with a compute shader stage is bound", ezLogMsgType::ErrorMsg);
+    pContext->Dispatch(1, 1, 1);
+
+    ezGALShaderHandle hComputeShader = setup.CreateShader(true);
+    pContext->SetShader(hComputeShader);
+    pContext->Dispatch(8, 8, 1);
+    pContext->SetShader(setup.m_hShader);
+    pDevice->DestroyShader(hComputeShader);
+
+    EZ_TEST_INT(pDevice->GetFrameStats().m_uiDispatchCalls, 1);
+    EZ_TEST_INT(pDevice->GetFrameStats().m_uiValidationErrors, 4);
+
+    pDevice->EndFrame();
+
+    // the counters of the ended frame are kept while the next frame starts from zero
+    pDevice->BeginFrame();
+    EZ_TEST_INT(pDevice->GetLastFrameStats().m_uiDrawCalls, 2);
+    EZ_TEST_INT(pDevice->GetFrameStats().m_uiDrawCalls, 0);
+    pDevice->EndFrame();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Command Recording")
+  {
+    NullRendererSetup setup;
+    ezGALDeviceNull* pDevice = setup.m_pDevice;
+    ezGALContext* pContext = pDevice->GetPrimaryContext();
+
+    pDevice->SetCommandRecordingEnabled(true);
+    pDevice->BeginFrame();
+
+    setup.BindTargets(pContext);
+    pContext->Clear(ezColor::Black);
+    setup.BindGeometry(pContext);
+
+    const ezUInt32 uiStateChanges = pDevice->GetFrameStats().m_uiStateChanges;
+
+    // redundant state changes are filtered by ezGALContext and never reach the device
+    setup.BindGeometry(pContext);
+    EZ_TEST_INT(pDevice->GetFrameStats().m_uiStateChanges, uiStateChanges);
+
+    pContext->DrawIndexedInstanced(36, 4, 0);
+
+    ezArrayPtr<const ezGALNullCommand> commands = pDevice->GetRecordedCommands();
+    EZ_TEST_INT(commands.GetCount(), uiStateChanges + 2);
+
+    if (EZ_TEST_BOOL(commands.GetCount() >= 3))
+    {
+      EZ_TEST_INT(commands[0].m_Type, ezGALNullCommandType::SetRenderTargetSetup);
+      EZ_TEST_INT(commands[0].m_uiArg0, 1);
+      EZ_TEST_INT(commands[0].m_uiArg1, 1);
+
+      EZ_TEST_INT(commands[1].m_Type, ezGALNullCommandType::Clear);
+
+      const ezGALNullCommand& draw = commands[commands.GetCount() - 1];
+      EZ_TEST_INT(draw.m_Type, ezGALNullCommandType::DrawIndexed);
+      EZ_TEST_INT(draw.m_uiArg0, 36);
+      EZ_TEST_INT(draw.m_uiArg1, 4);
+    }
+
+    pDevice->EndFrame();
+
+    pDevice->BeginFrame();
+    EZ_TEST_BOOL(pDevice->GetRecordedCommands().IsEmpty());
+    pDevice->EndFrame();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Constant Buffer Upload")
+  {
+    NullRendererSetup setup;
+    ezGALDeviceNull* pDevice = setup.m_pDevice;
+    ezGALContext* pContext = pDevice->GetPrimaryContext();
+
+    ezConstantBufferStorage<ObjectCB>* pStorage = nullptr;
+    ezConstantBufferStorageHandle hStorage = ezRenderContext::CreateConstantBufferStorage(pStorage);
+
+    pDevice->BeginFrame();
+
+    pStorage->GetDataForWriting().m_Color = ezColor::Red;
+    pStorage->UploadData(pContext);
+
+    EZ_TEST_INT(pDevice->GetFrameStats().m_uiBufferUpdates, 1);
+    EZ_TEST_INT(pDevice->GetFrameStats().m_uiBytesUploaded, sizeof(ObjectCB));
+
+    // unchanged data is not uploaded again
+    pStorage->GetDataForWriting().m_Color = ezColor::Red;
+    pStorage->UploadData(pContext);
+    EZ_TEST_INT(pDevice->GetFrameStats().m_uiBufferUpdates, 1);
+
+    pDevice->EndFrame();
+
+    ezRenderContext::DeleteConstantBufferStorage(hStorage);
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(Basics, NullRendererBenchmark)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Large Scene")
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    // debug builds render the same scene with fewer objects, so the benchmark still runs as part of every test run
+    const ezUInt32 uiNumObjects = 2000;
+#else
+    const ezUInt32 uiNumObjects = 20000;
+#endif
+    const ezUInt32 uiNumMaterials = 64;
+    const ezUInt32 uiNumPointLights = 32;
+    const ezUInt32 uiNumFrames = 20;
+
+    NullRendererSetup setup;
+    ezGALDeviceNull* pDevice = setup.m_pDevice;
+
+    // the shader stages are read from the shader cache, the shaders and their permutations come from the null shader loader
+    ezStringBuilder sDirectory = ezTestFramework::GetInstance()->GetAbsOutputPath();
+    sDirectory.AppendPath("NullRendererBenchmark");
+
+    EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sDirectory).Succeeded());
+    EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sDirectory, "NullRendererBenchmark", "nullshaders", ezFileSystem::AllowWrites).Succeeded());
+
+    // the render pipeline asset and the textures that its passes load
+    EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(">sdk/Data/Base", "NullRendererBenchmark", "base").Succeeded());
+
+    ezShaderManager::Configure("NULL", false, ":nullshaders/ShaderCache");
+
+    NullShaderLoader shaderLoader;
+    shaderLoader.m_uiMeshVertexShaderHash = 0x4E554C4C;
+    shaderLoader.m_uiMeshPixelShaderHash = 0x4E554C4D;
+    shaderLoader.m_uiPassVertexShaderHash = 0x4E554C4E;
+    shaderLoader.m_uiPassPixelShaderHash = 0x4E554C4F;
+
+    ezResourceManager::SetResourceTypeLoader<ezShaderResource>(&shaderLoader);
+    ezResourceManager::SetResourceTypeLoader<ezShaderPermutationResource>(&shaderLoader);
+
+    ezCVarBool* pMultithreadedRendering = (ezCVarBool*)ezCVar::FindCVarByName("r_Multithreading");
+    const bool bMultithreadedRendering = pMultithreadedRendering != nullptr && pMultithreadedRendering->GetValue();
+
+    // extraction and rendering of a frame are timed separately, so both happen on this thread
+    if (pMultithreadedRendering != nullptr)
+      *pMultithreadedRendering = false;
+
+    // the per pass timings are taken from the profiling scopes of the passes, which are shorter than the default threshold
+    ezProfilingSystem::SetDiscardThreshold(ezTime::Zero());
+
+    EZ_SCOPE_EXIT(if (pMultithreadedRendering != nullptr) { *pMultithreadedRendering = bMultithreadedRendering; } ezProfilingSystem::SetDiscardThreshold(ezTime::Milliseconds(0.1));
+                  ezResourceManager::FreeAllUnusedResources(); ezResourceManager::SetResourceTypeLoader<ezShaderResource>(nullptr);
+                  ezResourceManager::SetResourceTypeLoader<ezShaderPermutationResource>(nullptr); ezFileSystem::RemoveDataDirectoryGroup("NullRendererBenchmark"));
+
+    {
+      // the mesh shader declares the resources that mesh rendering binds, the passes of the pipeline bind different resources per pass
+      const NullShaderBinding meshVertexShaderBindings[] = {
+        {"ezGlobalConstants", 0, ezShaderResourceBinding::ConstantBuffer},
+        {"ezObjectConstants", 2, ezShaderResourceBinding::ConstantBuffer},
+        {"perInstanceData", 0, ezShaderResourceBinding::GenericBuffer},
+      };
+
+      const NullShaderBinding meshPixelShaderBindings[] = {
+        {"ezGlobalConstants", 0, ezShaderResourceBinding::ConstantBuffer},
+        {"ezObjectConstants", 2, ezShaderResourceBinding::ConstantBuffer},
+        {"perInstanceData", 0, ezShaderResourceBinding::GenericBuffer},
+        {"perLightDataBuffer", 1, ezShaderResourceBinding::GenericBuffer},
+        {"perClusterDataBuffer", 2, ezShaderResourceBinding::GenericBuffer},
+        {"clusterItemBuffer", 3, ezShaderResourceBinding::GenericBuffer},
+        {"BaseTexture", 4, ezShaderResourceBinding::Texture2D},
+        {"SSAOTexture", 5, ezShaderResourceBinding::Texture2D},
+        {"BaseTexture_AutoSampler", 0, ezShaderResourceBinding::Sampler},
+      };
+
+      const NullShaderBinding passShaderBindings[] = {
+        {"ezGlobalConstants", 0, ezShaderResourceBinding::ConstantBuffer},
+      };
+
+      EZ_TEST_BOOL(WriteNullShaderStage(ezGALShaderStage::VertexShader, shaderLoader.m_uiMeshVertexShaderHash, ezMakeArrayPtr(meshVertexShaderBindings)).Succeeded());
+      EZ_TEST_BOOL(WriteNullShaderStage(ezGALShaderStage::PixelShader, shaderLoader.m_uiMeshPixelShaderHash, ezMakeArrayPtr(meshPixelShaderBindings)).Succeeded());
+      EZ_TEST_BOOL(WriteNullShaderStage(ezGALShaderStage::VertexShader, shaderLoader.m_uiPassVertexShaderHash, ezMakeArrayPtr(passShaderBindings)).Succeeded());
+      EZ_TEST_BOOL(WriteNullShaderStage(ezGALShaderStage::PixelShader, shaderLoader.m_uiPassPixelShaderHash, ezMakeArrayPtr(passShaderBindings)).Succeeded());
+    }
+
+    ezRenderPipelineResourceHandle hRenderPipeline = LoadRenderPipelineAsset(":base/RenderPipelines/MainRenderPipeline.ezRenderPipelineAsset");
+    if (!EZ_TEST_BOOL(hRenderPipeline.IsValid()))
+      return;
+
+    ezShaderResourceHandle hMeshShader = ezResourceManager::LoadResource<ezShaderResource>("NullMeshShader.ezShader");
+
+    ezDynamicArray<ezMaterialResourceHandle> materials;
+    {
+      const char* szTextureColors[] = {"White", "Red", "Green", "Blue", "Yellow", "Cyan", "Magenta", "Orange"};
+
+      ezStringBuilder sName;
+      for (ezUInt32 i = 0; i < uiNumMaterials; ++i)
+      {
+        ezMaterialResourceDescriptor desc;
+        desc.m_hShader = hMeshShader;
+
+        ezMaterialResourceDescriptor::Texture2DBinding& texture = desc.m_Texture2DBindings.ExpandAndGetRef();
+        texture.m_Name.Assign("BaseTexture");
+        sName.Format("{0}.color", szTextureColors[i % EZ_ARRAY_SIZE(szTextureColors)]);
+        texture.m_Value = ezResourceManager::LoadResource<ezTexture2DResource>(sName);
+
+        sName.Format("NullRendererBenchmarkMaterial{0}", i);
+        materials.PushBack(ezResourceManager::CreateResource<ezMaterialResource>(sName, std::move(desc), sName));
+      }
+    }
+
+    ezMeshResourceHandle hMesh;
+    {
+      ezGeometry geom;
+      geom.AddBox(ezVec3(0.5f), ezColor::White);
+
+      ezMeshResourceDescriptor desc;
+      desc.MeshBufferDesc().AddCommonStreams();
+      desc.MeshBufferDesc().AllocateStreamsFromGeometry(geom, ezGALPrimitiveTopology::Triangles);
+      desc.AddSubMesh(desc.MeshBufferDesc().GetPrimitiveCount(), 0, 0);
+      desc.SetMaterial(0, "NullRendererBenchmarkMaterial0");
+      desc.ComputeBounds();
+
+      hMesh = ezResourceManager::CreateResource<ezMeshResource>("NullRendererBenchmarkMesh", std::move(desc), "NullRendererBenchmarkMesh");
+    }
+
+    ezWorldDesc worldDesc("NullRendererBenchmark");
+    ezWorld world(worldDesc);
+
+    ezDynamicArray<ezGameObjectHandle> pointLights;
+    {
+      EZ_LOCK(world.GetWriteMarker());
+
+      // a block of objects in front of the camera, all of them are visible, neighboring objects share their material
+      ezMeshComponentManager* pMeshManager = world.GetOrCreateComponentManager<ezMeshComponentManager>();
+      for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+      {
+        ezGameObjectDesc desc;
+        desc.m_LocalPosition.Set(20.0f + (i % 20) * 2.0f, ((i / 20) % 25) * 2.0f - 24.0f, (float)(i / 500) - 20.0f);
+
+        ezGameObject* pObject = nullptr;
+        world.CreateObject(desc, pObject);
+
+        ezMeshComponent* pMesh = nullptr;
+        pMeshManager->CreateComponent(pObject, pMesh);
+        pMesh->SetMesh(hMesh);
+        pMesh->SetMaterial(0, materials[i * uiNumMaterials / uiNumObjects]);
+      }
+
+      {
+        ezGameObjectDesc desc;
+        desc.m_LocalRotation.SetFromAxisAndAngle(ezVec3(0.0f, 1.0f, 0.0f), ezAngle::Degree(60.0f));
+
+        ezGameObject* pObject = nullptr;
+        world.CreateObject(desc, pObject);
+
+        ezDirectionalLightComponent* pLight = nullptr;
+        world.GetOrCreateComponentManager<ezDirectionalLightComponentManager>()->CreateComponent(pObject, pLight);
+        pLight->SetCastShadows(false);
+      }
+
+      ezPointLightComponentManager* pPointLightManager = world.GetOrCreateComponentManager<ezPointLightComponentManager>();
+      for (ezUInt32 i = 0; i < uiNumPointLights; ++i)
+      {
+        ezGameObjectDesc desc;
+        desc.m_bDynamic = true;
+        desc.m_LocalPosition.Set(20.0f + (i % 4) * 10.0f, ((i / 4) % 4) * 12.0f - 18.0f, (i / 16) * 10.0f - 15.0f);
+
+        ezGameObject* pObject = nullptr;
+        pointLights.PushBack(world.CreateObject(desc, pObject));
+
+        ezPointLightComponent* pLight = nullptr;
+        pPointLightManager->CreateComponent(pObject, pLight);
+        pLight->SetRange(12.0f);
+        pLight->SetCastShadows(false);
+      }
+    }
+
+    ezCamera camera;
+    camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovX, 90.0f, 0.1f, 1000.0f);
+    camera.LookAt(ezVec3(-10.0f, 0.0f, 0.0f), ezVec3::ZeroVector(), ezVec3(0.0f, 0.0f, 1.0f));
+
+    ezGALRenderTargetSetup renderTargetSetup;
+    renderTargetSetup.SetRenderTarget(0, pDevice->GetDefaultRenderTargetView(setup.m_hColorTarget))
+      .SetDepthStencilTarget(pDevice->GetDefaultRenderTargetView(setup.m_hDepthTarget));
+
+    ezView* pView = nullptr;
+    ezViewHandle hView = ezRenderWorld::CreateView("NullRendererBenchmark", pView);
+    pView->SetCameraUsageHint(ezCameraUsageHint::MainView);
+    pView->SetWorld(&world);
+    pView->SetCamera(&camera);
+    pView->SetViewport(ezRectFloat(0.0f, 0.0f, 320.0f, 240.0f));
+    pView->SetRenderTargetSetup(renderTargetSetup);
+    pView->SetRenderPipelineResource(hRenderPipeline);
+    ezRenderWorld::AddMainView(hView);
+
+    // the profiling scopes of the passes are named after the passes
+    struct PassTiming
+    {
+      ezString m_sName;
+      ezTime m_Duration;
+    };
+
+    ezHybridArray<PassTiming, 16> passTimings;
+    {
+      ezResourceLock<ezRenderPipelineResource> pPipelineResource(hRenderPipeline, ezResourceAcquireMode::BlockTillLoaded);
+
+      ezSharedPtr<ezRenderPipeline> pPipeline;
+      pPipeline = pPipelineResource->CreateRenderPipeline();
+
+      ezHybridArray<ezRenderPipelinePass*, 16> passes;
+      pPipeline->GetPasses(passes);
+
+      for (const ezRenderPipelinePass* pPass : passes)
+      {
+        passTimings.ExpandAndGetRef().m_sName = pPass->GetName();
+      }
+    }
+
+    ezRenderContext* pRenderContext = ezRenderContext::GetDefaultInstance();
+    pRenderContext->GetAndResetStatistics();
+
+    ezProfilingSystem::ProfilingData profilingData;
+    ezTime tUpdate, tExtraction, tRender, tFrame;
+
+    for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+    {
+      ezProfilingSystem::Clear();
+
+      ezStopwatch sw;
+
+      {
+        EZ_LOCK(world.GetWriteMarker());
+
+        // the point lights move, so the lights are assigned to different clusters every frame
+        const ezVec3 vOffset(0.0f, (uiFrame % 2) == 0 ? 1.0f : -1.0f, 0.0f);
+        for (const ezGameObjectHandle& hLight : pointLights)
+        {
+          ezGameObject* pObject = nullptr;
+          if (world.TryGetObject(hLight, pObject))
+          {
+            pObject->SetLocalPosition(pObject->GetLocalPosition() + vOffset);
+          }
+        }
+
+        world.Update();
+      }
+
+      tUpdate += sw.Checkpoint();
+
+      ezRenderWorld::BeginFrame();
+      pDevice->BeginFrame();
+
+      ezRenderWorld::ExtractMainViews();
+
+      tExtraction += sw.Checkpoint();
+
+      ezRenderWorld::Render(pRenderContext);
+
+      tRender += sw.Checkpoint();
+
+      pDevice->EndFrame();
+      ezRenderWorld::EndFrame();
+
+      tFrame += sw.Checkpoint();
+
+#if EZ_ENABLED(EZ_USE_PROFILING)
+      ezProfilingSystem::Capture(profilingData);
+
+      for (const ezProfilingSystem::CPUScopesBufferFlat& eventBuffer : profilingData.m_AllEventBuffers)
+      {
+        for (const ezProfilingSystem::CPUScope& scope : eventBuffer.m_Data)
+        {
+          for (PassTiming& timing : passTimings)
+          {
+            if (timing.m_sName == scope.m_szName)
+            {
+              timing.m_Duration += scope.m_EndTime - scope.m_BeginTime;
+              break;
+            }
+          }
+        }
+      }
+#endif
+    }
+
+    const ezGALNullDeviceStats& stats = pDevice->GetLastFrameStats();
+
+    // every object is drawn by the depth pre-pass and the opaque pass, mesh rendering batches them into instanced draws
+    EZ_TEST_BOOL(stats.m_uiInstances >= uiNumObjects);
+    EZ_TEST_BOOL(stats.m_uiDrawCalls < uiNumObjects);
+    EZ_TEST_INT(stats.m_uiValidationErrors, 0);
+    EZ_TEST_INT(pRenderContext->GetAndResetStatistics().m_uiFailedDrawcalls, 0);
+
+    const double fInvFrames = 1.0 / uiNumFrames;
+    ezTestFramework::Output(ezTestOutput::Duration, "%u objects, %u point lights, CPU ms per frame: %.3f world update, %.3f extraction, %.3f render pipeline, %.3f frame end",
+      uiNumObjects, uiNumPointLights, tUpdate.GetMilliseconds() * fInvFrames, tExtraction.GetMilliseconds() * fInvFrames, tRender.GetMilliseconds() * fInvFrames,
+      tFrame.GetMilliseconds() * fInvFrames);
+    ezTestFramework::Output(ezTestOutput::Details, "Per frame: %u draws, %u instances, %u state changes, %u buffer updates, %.1f KB uploaded", stats.m_uiDrawCalls,
+      stats.m_uiInstances, stats.m_uiStateChanges, stats.m_uiBufferUpdates, stats.m_uiBytesUploaded / 1024.0);
+
+#if EZ_ENABLED(EZ_USE_PROFILING)
+    for (const PassTiming& timing : passTimings)
+    {
+      ezTestFramework::Output(ezTestOutput::Details, "Pass '%s': %.3f ms per frame", timing.m_sName.GetData(), timing.m_Duration.GetMilliseconds() * fInvFrames);
+    }
+#endif
+
+    ezRenderWorld::DeleteView(hView);
+
+    // the render context keeps the last bound state, it must not reference the destroyed resources
+    pRenderContext->ResetContextState();
+
+    hMesh.Invalidate();
+    materials.Clear();
+    hMeshShader.Invalidate();
+    hRenderPipeline.Invalidate();
+  }
+}
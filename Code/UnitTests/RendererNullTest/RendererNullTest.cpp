@@ -0,0 +1,6 @@
+#include <RendererNullTestPCH.h>
+
+#include <TestFramework/Framework/TestFramework.h>
+#include <TestFramework/Utilities/TestSetup.h>
+
+EZ_TESTFRAMEWORK_ENTRY_POINT("RendererNullTest", "Null Renderer Tests")
@@ -0,0 +1 @@
+#include <RendererNullTestPCH.h>
@@ -0,0 +1,9 @@
+#include <TestFramework/Framework/TestFramework.h>
+
+#include <Foundation/Basics.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Strings/StringBuilder.h>
+
+#include <RendererFoundation/Context/Context.h>
+#include <RendererFoundation/Device/Device.h>
+#include <RendererNull/Device/DeviceNull.h>
@@ -314,6 +314,13 @@ struct ezTestBlock
     Disabled,          ///< The test block will be skipped. The test framework will print a warning message, that some block is deactivated.
     DisabledNoWarning, ///< The test block will be skipped, but no warning printed. Used to deactivate 'on demand/optional' tests.
   };
+
+  /// \brief For test blocks that measure performance. They are skipped without a warning in debug builds, where the timings are meaningless.
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  static constexpr Enum EnabledInRelease = DisabledNoWarning;
+#else
+  static constexpr Enum EnabledInRelease = Enabled;
+#endif
 };
 
 #define safeprintf ezStringUtils::snprintf
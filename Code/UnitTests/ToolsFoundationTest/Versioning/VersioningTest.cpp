@@ -139,6 +139,26 @@ namespace
   };
   ezPatchTestCB g_ezPatchTestCB;
 
+  /// Remove nodes while the graph is patched
+  class ezPatchTestRM : public ezGraphPatch
+  {
+  public:
+    ezPatchTestRM()
+      : ezGraphPatch("ezPatchTestRM", 2)
+    {
+    }
+    virtual void Patch(ezGraphPatchContext& context, ezAbstractObjectGraph* pGraph, ezAbstractObjectNode* pNode) const override
+    {
+      // like ezAbstractObjectNode::InlineProperty, which removes the inlined node
+      if (auto* pProp = pNode->FindProperty("Partner"))
+      {
+        pGraph->RemoveNode(pProp->m_Value.Get<ezUuid>());
+        pNode->RemoveProperty("Partner");
+      }
+    }
+  };
+  ezPatchTestRM g_ezPatchTestRM;
+
   void ReplaceTypeName(ezAbstractObjectGraph& graph, ezAbstractObjectGraph& typesGraph, const char* szOldName, const char* szNewName)
   {
     for (auto it : graph.GetAllNodes())
@@ -265,4 +285,35 @@ EZ_CREATE_SIMPLE_TEST(Versioning, GraphPatch)
     ezAbstractObjectNode::Property* pString2 = pNode->FindProperty("String2");
     EZ_TEST_STRING(pString2->m_Value.Get<ezString>(), "ChangedBase");
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "RemoveNodes")
+  {
+    ezAbstractObjectGraph graph;
+    ezAbstractObjectGraph typesGraph;
+
+    ezAbstractObjectNode* pTypeNode = typesGraph.AddNode(ezUuid::StableUuidForString("ezPatchTestRM"), "ezReflectedTypeDescriptor", 1);
+    pTypeNode->AddProperty("TypeName", "ezPatchTestRM");
+    pTypeNode->AddProperty("ParentTypeName", "");
+    pTypeNode->AddProperty("TypeVersion", (ezUInt32)1);
+
+    // whichever node of a pair is patched first removes the other one
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      ezUuid guid1, guid2;
+      guid1.CreateNewUuid();
+      guid2.CreateNewUuid();
+
+      graph.AddNode(guid1, "ezPatchTestRM", 1)->AddProperty("Partner", guid2);
+      graph.AddNode(guid2, "ezPatchTestRM", 1)->AddProperty("Partner", guid1);
+    }
+
+    ezGraphVersioning::GetSingleton()->PatchGraph(&graph, &typesGraph);
+
+    EZ_TEST_INT(graph.GetAllNodes().GetCount(), 100);
+    for (auto it : graph.GetAllNodes())
+    {
+      EZ_TEST_INT(it.Value()->GetTypeVersion(), 2);
+      EZ_TEST_BOOL(it.Value()->FindProperty("Partner") == nullptr);
+    }
+  }
 }
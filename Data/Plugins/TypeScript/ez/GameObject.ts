@@ -20,28 +20,28 @@ export import TypescriptComponent = __Component.TypescriptComponent;
 
 declare function __CPP_GameObject_IsValid(_this: GameObject): boolean;
 
-declare function __CPP_GameObject_SetLocalPosition(_this: GameObject, pos: Vec3): void;
-declare function __CPP_GameObject_GetLocalPosition(_this: GameObject): Vec3;
-declare function __CPP_GameObject_SetLocalScaling(_this: GameObject, scale: Vec3): void;
-declare function __CPP_GameObject_GetLocalScaling(_this: GameObject): Vec3;
+declare function __CPP_GameObject_SetLocalPosition(_this: GameObject, scratch: Float32Array): void;
+declare function __CPP_GameObject_GetLocalPosition(_this: GameObject, scratch: Float32Array): void;
+declare function __CPP_GameObject_SetLocalScaling(_this: GameObject, scratch: Float32Array): void;
+declare function __CPP_GameObject_GetLocalScaling(_this: GameObject, scratch: Float32Array): void;
 declare function __CPP_GameObject_SetLocalUniformScaling(_this: GameObject, scale: number): void;
 declare function __CPP_GameObject_GetLocalUniformScaling(_this: GameObject): number;
-declare function __CPP_GameObject_SetLocalRotation(_this: GameObject, rot: Quat): void;
-declare function __CPP_GameObject_GetLocalRotation(_this: GameObject): Quat;
+declare function __CPP_GameObject_SetLocalRotation(_this: GameObject, scratch: Float32Array): void;
+declare function __CPP_GameObject_GetLocalRotation(_this: GameObject, scratch: Float32Array): void;
 
-declare function __CPP_GameObject_SetGlobalPosition(_this: GameObject, pos: Vec3): void;
-declare function __CPP_GameObject_GetGlobalPosition(_this: GameObject): Vec3;
-declare function __CPP_GameObject_SetGlobalScaling(_this: GameObject, scale: Vec3): void;
-declare function __CPP_GameObject_GetGlobalScaling(_this: GameObject): Vec3;
-declare function __CPP_GameObject_SetGlobalRotation(_this: GameObject, rot: Quat): void;
-declare function __CPP_GameObject_GetGlobalRotation(_this: GameObject): Quat;
+declare function __CPP_GameObject_SetGlobalPosition(_this: GameObject, scratch: Float32Array): void;
+declare function __CPP_GameObject_GetGlobalPosition(_this: GameObject, scratch: Float32Array): void;
+declare function __CPP_GameObject_SetGlobalScaling(_this: GameObject, scratch: Float32Array): void;
+declare function __CPP_GameObject_GetGlobalScaling(_this: GameObject, scratch: Float32Array): void;
+declare function __CPP_GameObject_SetGlobalRotation(_this: GameObject, scratch: Float32Array): void;
+declare function __CPP_GameObject_GetGlobalRotation(_this: GameObject, scratch: Float32Array): void;
 
-declare function __CPP_GameObject_GetGlobalDirForwards(_this: GameObject): Vec3;
-declare function __CPP_GameObject_GetGlobalDirRight(_this: GameObject): Vec3;
-declare function __CPP_GameObject_GetGlobalDirUp(_this: GameObject): Vec3;
+declare function __CPP_GameObject_GetGlobalDirForwards(_this: GameObject, scratch: Float32Array): void;
+declare function __CPP_GameObject_GetGlobalDirRight(_this: GameObject, scratch: Float32Array): void;
+declare function __CPP_GameObject_GetGlobalDirUp(_this: GameObject, scratch: Float32Array): void;
 
-declare function __CPP_GameObject_SetVelocity(_this: GameObject, value: Vec3): void;
-declare function __CPP_GameObject_GetVelocity(_this: GameObject): Vec3;
+declare function __CPP_GameObject_SetVelocity(_this: GameObject, scratch: Float32Array): void;
+declare function __CPP_GameObject_GetVelocity(_this: GameObject, scratch: Float32Array): void;
 
 declare function __CPP_GameObject_SetActiveFlag(_this: GameObject, active: boolean): void;
 declare function __CPP_GameObject_GetActiveFlag(_this: GameObject): boolean;
@@ -83,6 +83,32 @@ declare function __CPP_GameObject_DetachChild(_this: GameObject, child: GameObje
 declare function __CPP_GameObject_GetChildCount(_this: GameObject): number;
 declare function __CPP_GameObject_GetChildren(__this: GameObject): GameObject[];
 
+// vectors and quaternions are passed to and from C++ through this buffer, so that the binding does not need to create or inspect script objects
+let __scratch = new Float32Array(4);
+
+function WriteVec3(value: Vec3): Float32Array {
+    __scratch[0] = value.x;
+    __scratch[1] = value.y;
+    __scratch[2] = value.z;
+    return __scratch;
+}
+
+function ReadVec3(): Vec3 {
+    return new Vec3(__scratch[0], __scratch[1], __scratch[2]);
+}
+
+function WriteQuat(value: Quat): Float32Array {
+    __scratch[0] = value.x;
+    __scratch[1] = value.y;
+    __scratch[2] = value.z;
+    __scratch[3] = value.w;
+    return __scratch;
+}
+
+function ReadQuat(): Quat {
+    return new Quat(__scratch[0], __scratch[1], __scratch[2], __scratch[3]);
+}
+
 /**
  * Represents a C++ ezGameObject on the TypeScript side.
  * 
@@ -153,7 +179,7 @@ export class GameObject {
      * until the next frame.
      */
     SetLocalPosition(pos: Vec3): void { // [tested]
-        __CPP_GameObject_SetLocalPosition(this, pos);
+        __CPP_GameObject_SetLocalPosition(this, WriteVec3(pos));
     }
 
     /**
@@ -161,7 +187,8 @@ export class GameObject {
      * If the object has no parent, this is the same as the global position.
      */
     GetLocalPosition(): Vec3 { // [tested]
-        return __CPP_GameObject_GetLocalPosition(this);
+        __CPP_GameObject_GetLocalPosition(this, __scratch);
+        return ReadVec3();
     }
 
     /**
@@ -171,7 +198,7 @@ export class GameObject {
      * until the next frame.
      */
     SetLocalRotation(rot: Quat): void { // [tested]
-        __CPP_GameObject_SetLocalRotation(this, rot);
+        __CPP_GameObject_SetLocalRotation(this, WriteQuat(rot));
     }
 
     /**
@@ -179,7 +206,8 @@ export class GameObject {
      * If the object has no parent, this is the same as the global rotation.
      */
     GetLocalRotation(): Quat { // [tested]
-        return __CPP_GameObject_GetLocalRotation(this);
+        __CPP_GameObject_GetLocalRotation(this, __scratch);
+        return ReadQuat();
     }
 
     /**
@@ -189,7 +217,7 @@ export class GameObject {
      * until the next frame.
      */
     SetLocalScaling(scaling: Vec3): void { // [tested]
-        __CPP_GameObject_SetLocalScaling(this, scaling);
+        __CPP_GameObject_SetLocalScaling(this, WriteVec3(scaling));
     }
 
     /**
@@ -197,7 +225,8 @@ export class GameObject {
      * If the object has no parent, this is the same as the global scaling.
      */
     GetLocalScaling(): Vec3 { // [tested]
-        return __CPP_GameObject_GetLocalScaling(this);
+        __CPP_GameObject_GetLocalScaling(this, __scratch);
+        return ReadVec3();
     }
 
     /**
@@ -223,14 +252,15 @@ export class GameObject {
      * Internally this will set the local position such that the desired global position is reached.
      */
     SetGlobalPosition(pos: Vec3): void { // [tested]
-        __CPP_GameObject_SetGlobalPosition(this, pos);
+        __CPP_GameObject_SetGlobalPosition(this, WriteVec3(pos));
     }
 
     /**
      * Returns the current global position as computed from the local transforms.
      */
     GetGlobalPosition(): Vec3 { // [tested]
-        return __CPP_GameObject_GetGlobalPosition(this);
+        __CPP_GameObject_GetGlobalPosition(this, __scratch);
+        return ReadVec3();
     }
 
     /**
@@ -238,14 +268,15 @@ export class GameObject {
      * Internally this will set the local rotation such that the desired global rotation is reached.
      */
     SetGlobalRotation(rot: Quat): void { // [tested]
-        __CPP_GameObject_SetGlobalRotation(this, rot);
+        __CPP_GameObject_SetGlobalRotation(this, WriteQuat(rot));
     }
 
     /**
      * Returns the current global rotation as computed from the local transforms.
      */
     GetGlobalRotation(): Quat { // [tested]
-        return __CPP_GameObject_GetGlobalRotation(this);
+        __CPP_GameObject_GetGlobalRotation(this, __scratch);
+        return ReadQuat();
     }
 
     /**
@@ -253,7 +284,7 @@ export class GameObject {
      * Internally this will set the local scaling such that the desired global scaling is reached.
      */
     SetGlobalScaling(scaling: Vec3): void { // [tested]
-        __CPP_GameObject_SetGlobalScaling(this, scaling);
+        __CPP_GameObject_SetGlobalScaling(this, WriteVec3(scaling));
     }
 
     /**
@@ -262,28 +293,32 @@ export class GameObject {
      * combined into the global scaling.
      */
     GetGlobalScaling(): Vec3 { // [tested]
-        return __CPP_GameObject_GetGlobalScaling(this);
+        __CPP_GameObject_GetGlobalScaling(this, __scratch);
+        return ReadVec3();
     }
 
     /**
      * Returns the vector representing the logical 'forward' direction of the GameObject in global space.
      */
     GetGlobalDirForwards(): Vec3 { // [tested]
-        return __CPP_GameObject_GetGlobalDirForwards(this);
+        __CPP_GameObject_GetGlobalDirForwards(this, __scratch);
+        return ReadVec3();
     }
 
     /**
      * Returns the vector representing the logical 'right' direction of the GameObject in global space.
      */
     GetGlobalDirRight(): Vec3 { // [tested]
-        return __CPP_GameObject_GetGlobalDirRight(this);
+        __CPP_GameObject_GetGlobalDirRight(this, __scratch);
+        return ReadVec3();
     }
 
     /**
      * Returns the vector representing the logical 'up' direction of the GameObject in global space.
      */
     GetGlobalDirUp(): Vec3 { // [tested]
-        return __CPP_GameObject_GetGlobalDirUp(this);
+        __CPP_GameObject_GetGlobalDirUp(this, __scratch);
+        return ReadVec3();
     }
 
     /**
@@ -293,14 +328,15 @@ export class GameObject {
      * By default this value is computed out of position changes.
      */
     SetVelocity(velocity: Vec3): void { // [tested]
-        __CPP_GameObject_SetVelocity(this, velocity);
+        __CPP_GameObject_SetVelocity(this, WriteVec3(velocity));
     }
 
     /**
      * Returns the velocity of the object over the last two world updates.
      */
     GetVelocity(): Vec3 { // [tested]
-        return __CPP_GameObject_GetVelocity(this);
+        __CPP_GameObject_GetVelocity(this, __scratch);
+        return ReadVec3();
     }
 
     /**